@@ -21,6 +21,9 @@
 #define REAL_CODE 8
 #define OPCODE 3
 #define CHUNK_16K 16384
+#define GZIP_TRAILER_SIZE 8
+#define GZIP_TRAILER_PAD 5
+#define DEC_OUT_ALIGN 64
 
 uint32_t get_file_size(std::ifstream& file) {
     file.seekg(0, file.end);
@@ -29,6 +32,30 @@ uint32_t get_file_size(std::ifstream& file) {
     return file_size;
 }
 
+uint32_t get_gzip_isize(std::ifstream& file, uint64_t file_size) {
+    uint8_t tail[GZIP_TRAILER_SIZE + GZIP_TRAILER_PAD] = {0};
+    if (file_size < sizeof(tail)) return 0;
+
+    file.seekg(file_size - sizeof(tail), file.beg);
+    file.read((char*)tail, sizeof(tail));
+    file.seekg(0, file.beg);
+
+    // zip() below appends GZIP_TRAILER_PAD zero bytes after the standard
+    // CRC32/ISIZE trailer, standard gzip files end with ISIZE
+    bool padded = true;
+    for (int i = GZIP_TRAILER_SIZE; i < GZIP_TRAILER_SIZE + GZIP_TRAILER_PAD; i++) {
+        if (tail[i] != 0) padded = false;
+    }
+    uint8_t* isize = padded ? &tail[GZIP_TRAILER_SIZE - 4] : &tail[GZIP_TRAILER_PAD + GZIP_TRAILER_SIZE - 4];
+
+    uint32_t original_size = 0;
+    for (int i = 3; i >= 0; i--) {
+        original_size <<= 8;
+        original_size |= isize[i];
+    }
+    return original_size;
+}
+
 void zip(std::string& inFile_name, std::ofstream& outFile, uint8_t* zip_out, uint32_t enbytes) {
     // 2 bytes of magic header
     outFile.put(FORMAT_0);
@@ -240,8 +267,6 @@ xil_gzip::xil_gzip(const std::string& binaryFileName) {
     }
 
     for (int i = 0; i < MAX_DDCOMP_UNITS; i++) {
-        h_dbuf_in[i].resize(PARALLEL_ENGINES * HOST_BUFFER_SIZE);
-        h_dbuf_gzipout[i].resize(PARALLEL_ENGINES * HOST_BUFFER_SIZE * 10);
         h_dcompressSize[i].resize(MAX_NUMBER_BLOCKS);
     }
 }
@@ -358,12 +383,16 @@ uint32_t xil_gzip::decompress_file(std::string& inFile_name, std::string& outFil
         exit(1);
     }
 
-    std::vector<uint8_t, aligned_allocator<uint8_t> > in(input_size);
+    // Kernel reads whole memory words, pad input to the word width
+    std::vector<uint8_t, aligned_allocator<uint8_t> > in(((input_size - 1) / DEC_OUT_ALIGN + 1) * DEC_OUT_ALIGN);
 
-    // Allocat output size
-    // 8 - Max CR per file expected, if this size is big
-    // Decompression crashes
-    std::vector<uint8_t, aligned_allocator<uint8_t> > out(input_size * 10);
+    // Size output exactly from the ISIZE trailer, rounded up to the
+    // kernel write width. Fall back to the max expected CR if the
+    // trailer is missing.
+    uint64_t original_size = get_gzip_isize(inFile, input_size);
+    if (original_size == 0) original_size = input_size * 10;
+    uint64_t out_size = ((original_size - 1) / DEC_OUT_ALIGN + 1) * DEC_OUT_ALIGN;
+    std::vector<uint8_t, aligned_allocator<uint8_t> > out(out_size);
     uint32_t debytes = 0;
     int infile_cntr = 0;
 
@@ -402,7 +431,7 @@ uint32_t xil_gzip::decompress_file(std::string& inFile_name, std::string& outFil
 
     // Call decompress
     auto decompress_API_start = std::chrono::high_resolution_clock::now();
-    debytes = decompress(in.data(), out.data(), input_size, cu);
+    debytes = decompress(in.data(), out.data(), input_size, out_size, cu);
     auto decompress_API_end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration<double, std::nano>(decompress_API_end - decompress_API_start);
     decompress_API_time_ns_1 += duration;
@@ -419,7 +448,7 @@ uint32_t xil_gzip::decompress_file(std::string& inFile_name, std::string& outFil
     return debytes;
 }
 
-uint32_t xil_gzip::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, int cu) {
+uint32_t xil_gzip::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, uint32_t out_size, int cu) {
     bool flag = false;
     if (input_size > 128 * 1024 * 1024) flag = true;
     // printme("Entered gzip decop \n");
@@ -435,30 +464,28 @@ uint32_t xil_gzip::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, in
     if (flag) {
         // printme("before buffer creation \n");
         buffer_in = new cl::Buffer(*m_context, CL_MEM_READ_ONLY, input_size);
-        buffer_out = new cl::Buffer(*m_context, CL_MEM_READ_WRITE, input_size * 10);
+        buffer_out = new cl::Buffer(*m_context, CL_MEM_READ_WRITE, out_size);
         buffer_size = new cl::Buffer(*m_context, CL_MEM_READ_WRITE, 10 * sizeof(uint32_t));
         inP = (uint8_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_in), CL_TRUE, CL_MAP_READ, 0, input_size);
-        outP = (uint8_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_out), CL_TRUE, CL_MAP_WRITE, 0, input_size * 10);
+        outP = (uint8_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_out), CL_TRUE, CL_MAP_WRITE, 0, out_size);
         outSize =
             (uint32_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_size), CL_TRUE, CL_MAP_WRITE, 0, 10 * sizeof(uint32_t));
+
+        // Copy compressed input to mapped device buffer
+        std::memcpy(inP, &in[0], input_size);
     } else {
         // printme("before buffer creation \n");
-        buffer_in =
-            new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, input_size, h_dbuf_in[cu].data());
+        // Caller buffers are page aligned, kernel reads/writes them in place
+        uint32_t in_size = ((input_size - 1) / DEC_OUT_ALIGN + 1) * DEC_OUT_ALIGN;
+        buffer_in = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, in_size, in);
 
-        buffer_out = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, input_size * 10,
-                                    h_dbuf_gzipout[cu].data());
+        buffer_out = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, out_size, out);
 
         buffer_size = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, 10 * sizeof(uint32_t),
                                      h_dcompressSize[cu].data());
 
-        inP = h_dbuf_in[cu].data();
-        outP = h_dbuf_gzipout[cu].data();
         outSize = h_dcompressSize[cu].data();
     }
-    // printme("Entered incopy \n");
-    // Copy compressed input to h_buf_in
-    std::memcpy(inP, &in[0], input_size);
 
     int narg = 0;
     // Set Kernel Args
@@ -482,11 +509,18 @@ uint32_t xil_gzip::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, in
 
     uint32_t raw_size = *outSize;
 
-    // If raw size is greater than 3GB
-    // Limit it to 3GB
-    if (raw_size > 3U << (3 * 10)) raw_size = 3U << (3 * 10);
+    if (raw_size > out_size) {
+        std::cout << "Decompressed size " << raw_size << " exceeds output buffer size " << out_size << std::endl;
+        raw_size = 0;
+    }
 
-    m_q_dec[cu]->enqueueReadBuffer(*(buffer_out), CL_TRUE, 0, raw_size * sizeof(uint8_t), &out[0]);
+    if (flag) {
+        m_q_dec[cu]->enqueueReadBuffer(*(buffer_out), CL_TRUE, 0, raw_size * sizeof(uint8_t), &out[0]);
+    } else if (raw_size) {
+        // Output already lives in caller memory, only sync it back
+        m_q_dec[cu]->enqueueMigrateMemObjects({*(buffer_out)}, CL_MIGRATE_MEM_OBJECT_HOST);
+        m_q_dec[cu]->finish();
+    }
 
     if (flag) {
         m_q_dec[cu]->enqueueUnmapMemObject(*buffer_in, inP, nullptr, nullptr);
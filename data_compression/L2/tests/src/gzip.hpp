@@ -55,12 +55,17 @@ int validate(std::string& inFile_name, std::string& outFile_name);
 
 uint32_t get_file_size(std::ifstream& file);
 
+// Returns the original size stored in the gzip trailer, 0 if not available
+uint32_t get_gzip_isize(std::ifstream& file, uint64_t file_size);
+
 class xil_gzip {
    public:
     int init(const std::string& binaryFile);
     int release();
     uint32_t compress(uint8_t* in, uint8_t* out, uint32_t actual_size, uint32_t host_buffer_size);
-    uint32_t decompress(uint8_t* in, uint8_t* out, uint32_t actual_size, int cu_run);
+    // in/out must be page aligned and padded to the 64B kernel word,
+    // out_size is the exact output capacity
+    uint32_t decompress(uint8_t* in, uint8_t* out, uint32_t actual_size, uint32_t out_size, int cu_run);
     uint32_t compress_file(std::string& inFile_name, std::string& outFile_name, uint64_t input_size);
     uint32_t decompress_file(std::string& inFile_name, std::string& outFile_name, uint64_t input_size, int cu_run);
     uint64_t get_event_duration_ns(const cl::Event& event);
@@ -88,8 +93,6 @@ class xil_gzip {
     std::vector<uint32_t, aligned_allocator<uint32_t> > h_compressSize[MAX_CCOMP_UNITS][OVERLAP_BUF_COUNT];
 
     // Decompression Related
-    std::vector<uint8_t, aligned_allocator<uint8_t> > h_dbuf_in[MAX_DDCOMP_UNITS];
-    std::vector<uint8_t, aligned_allocator<uint8_t> > h_dbuf_gzipout[MAX_DDCOMP_UNITS];
     std::vector<uint32_t, aligned_allocator<uint32_t> > h_dcompressSize[MAX_DDCOMP_UNITS];
 
     // Buffers related to Dynamic Huffman
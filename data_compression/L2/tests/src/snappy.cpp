@@ -15,6 +15,7 @@
  *
  */
 #include "snappy.hpp"
+#include "snappy_frame.hpp"
 #define BLOCK_SIZE 64
 #define KB 1024
 #define MAGIC_HEADER_SIZE 4
@@ -107,7 +108,6 @@ uint64_t xilSnappy::decompressFile(std::string& inFile_name, std::string& outFil
         }
 
         std::vector<uint8_t, aligned_allocator<uint8_t> > in(input_size);
-        std::vector<uint8_t, aligned_allocator<uint8_t> > out(6 * input_size);
 
         char c = 0;
 
@@ -125,6 +125,9 @@ uint64_t xilSnappy::decompressFile(std::string& inFile_name, std::string& outFil
         // Read block data from compressed stream .snappy
         inFile.read((char*)in.data(), (input_size - 10));
 
+        // Size output exactly from the chunk preambles
+        std::vector<uint8_t, aligned_allocator<uint8_t> > out(getSnappyDecompressedSize(in.data(), (input_size - 10)));
+
         // Decompression Sequential multiple cus.
         uint64_t debytes = decompressSequential(in.data(), out.data(), (input_size - 10));
         outFile.write((char*)out.data(), debytes);
@@ -187,6 +190,9 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
     uint16_t stride_cidsize = 4;
     bool blkDecomExist = false;
     uint32_t blkUnComp = 0;
+    bool brickUnComp = false;
+    uint32_t brickOutSize = 0;
+    cl::Buffer* buffer_direct = nullptr;
 
     // Go over overall input size
     for (uint32_t idxSize = 0; idxSize < input_size; idxSize += stride_cidsize, chunk_cntr++) {
@@ -245,6 +251,7 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
             h_compressSize.data()[bufblocks] = chunk_size - 4;
             h_blksize.data()[bufblocks] = block_size;
             bufblocks++;
+            brickOutSize += block_size;
 
             // Copy data
             std::memcpy(&(h_buf_in.data()[block_cntr * buf_size]), &in[idxSize + 8], chunk_size - 4);
@@ -255,6 +262,7 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
             m_blkSize.data()[over_block_cntr] = chunk_size - 4;
             std::memcpy(&out[brick * HOST_BUFFER_SIZE + over_block_cntr * buf_size], &in[idxSize + 8], chunk_size - 4);
             blkUnComp += chunk_size - 4;
+            brickUnComp = true;
         }
 
         over_block_cntr++;
@@ -272,6 +280,17 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
             // In case of left over set kernel arg to no blocks
             decompress_kernel_snappy->setArg(5, block_cntr);
 
+            // A brick of compressed blocks only decodes to one contiguous range
+            // of the caller buffer, so let the kernel write it in place
+            bool direct = !brickUnComp && ((uintptr_t)&out[output_idx] % 4096) == 0;
+            if (direct) {
+                buffer_direct = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, brickOutSize,
+                                               &out[output_idx]);
+                decompress_kernel_snappy->setArg(1, *(buffer_direct));
+            } else {
+                decompress_kernel_snappy->setArg(1, *(buffer_output));
+            }
+
             // For big files go ahead do it here
             std::vector<cl::Memory> inBufVec;
             inBufVec.push_back(*(buffer_input));
@@ -294,7 +313,7 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
             kernel_time_ns_1 += duration;
 
             std::vector<cl::Memory> outBufVec;
-            outBufVec.push_back(*(buffer_output));
+            outBufVec.push_back(direct ? *(buffer_direct) : *(buffer_output));
 
             // Migrate memory - Map device to host buffers
             m_q->enqueueMigrateMemObjects(outBufVec, CL_MIGRATE_MEM_OBJECT_HOST);
@@ -306,7 +325,7 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
                 uint32_t block_size = m_blkSize.data()[bIdx];
                 uint32_t compressed_size = m_compressSize.data()[bIdx];
                 if (compressed_size < block_size) {
-                    std::memcpy(&out[output_idx], &h_buf_out.data()[bufIdx], block_size);
+                    if (!direct) std::memcpy(&out[output_idx], &h_buf_out.data()[bufIdx], block_size);
                     output_idx += block_size;
                     bufIdx += block_size;
                 } else if (compressed_size == block_size) {
@@ -314,14 +333,19 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
                     blkUnComp -= block_size;
                 }
             }
+            if (direct) delete (buffer_direct);
             block_cntr = 0;
             bufblocks = 0;
             over_block_cntr = 0;
+            brickUnComp = false;
+            brickOutSize = 0;
         } else if (over_block_cntr == blocksPerChunk) {
             over_block_cntr = 0;
             brick++;
             bufblocks = 0;
             block_cntr = 0;
+            brickUnComp = false;
+            brickOutSize = 0;
         }
     }
 
@@ -329,6 +353,17 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
         // In case of left over set kernel arg to no blocks
         decompress_kernel_snappy->setArg(5, block_cntr);
 
+        // A brick of compressed blocks only decodes to one contiguous range
+        // of the caller buffer, so let the kernel write it in place
+        bool direct = !brickUnComp && ((uintptr_t)&out[output_idx] % 4096) == 0;
+        if (direct) {
+            buffer_direct = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, brickOutSize,
+                                           &out[output_idx]);
+            decompress_kernel_snappy->setArg(1, *(buffer_direct));
+        } else {
+            decompress_kernel_snappy->setArg(1, *(buffer_output));
+        }
+
         std::vector<cl::Memory> inBufVec;
         inBufVec.push_back(*(buffer_input));
         inBufVec.push_back(*(buffer_block_size));
@@ -350,7 +385,7 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
         kernel_time_ns_1 += duration;
 
         std::vector<cl::Memory> outBufVec;
-        outBufVec.push_back(*(buffer_output));
+        outBufVec.push_back(direct ? *(buffer_direct) : *(buffer_output));
 
         // Migrate memory - Map device to host buffers
         m_q->enqueueMigrateMemObjects(outBufVec, CL_MIGRATE_MEM_OBJECT_HOST);
@@ -363,7 +398,7 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
             uint32_t block_size = m_blkSize.data()[bIdx];
             uint32_t compressed_size = m_compressSize.data()[bIdx];
             if (compressed_size < block_size) {
-                std::memcpy(&out[output_idx], &h_buf_out.data()[bufIdx], block_size);
+                if (!direct) std::memcpy(&out[output_idx], &h_buf_out.data()[bufIdx], block_size);
                 output_idx += block_size;
                 bufIdx += block_size;
             } else if (compressed_size == block_size) {
@@ -371,6 +406,7 @@ uint64_t xilSnappy::decompressSequential(uint8_t* in, uint8_t* out, uint64_t inp
                 blkUnComp -= block_size;
             }
         }
+        if (direct) delete (buffer_direct);
 
     } // If to see if tehr eare some blocks to be processed
 
@@ -0,0 +1,66 @@
+/*
+ * (c) Copyright 2019 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * @file snappy_frame.hpp
+ * @brief Helpers for parsing the framed snappy stream on the host
+ *
+ * This file is part of Vitis Data Compression Library host code for snappy compression.
+ */
+
+#ifndef _XFCOMPRESSION_SNAPPY_FRAME_HPP_
+#define _XFCOMPRESSION_SNAPPY_FRAME_HPP_
+
+#include <stdint.h>
+
+/**
+ * @brief Get the decompressed size by scanning the chunk headers
+ * and varint preambles of a framed snappy stream.
+ *
+ * @param in input byte sequence without stream identifier
+ * @param input_size input size
+ */
+inline uint64_t getSnappyDecompressedSize(const uint8_t* in, uint64_t input_size) {
+    uint64_t original_size = 0;
+    uint16_t stride_cidsize = 4;
+
+    for (uint64_t idxSize = 0; idxSize + stride_cidsize <= input_size; idxSize += stride_cidsize) {
+        uint8_t chunk_idx = in[idxSize];
+        uint32_t chunk_size = in[idxSize + 1] | (in[idxSize + 2] << 8) | (in[idxSize + 3] << 16);
+
+        if (chunk_idx == 0x00) {
+            // Compressed chunk: 4 byte CRC followed by varint
+            // uncompressed length preamble
+            uint32_t block_size = 0;
+            uint64_t vIdx = idxSize + 8;
+            for (uint32_t shift = 0; vIdx < input_size && shift < 32; shift += 7, vIdx++) {
+                uint8_t bval = in[vIdx];
+                block_size |= (uint32_t)(bval & 0x7F) << shift;
+                if ((bval >> 7) == 0) break;
+            }
+            original_size += block_size;
+        } else if (chunk_idx == 0x01) {
+            // Uncompressed chunk: data follows 4 byte CRC
+            original_size += chunk_size - 4;
+        }
+
+        idxSize += chunk_size;
+    }
+
+    return original_size;
+}
+
+#endif // _XFCOMPRESSION_SNAPPY_FRAME_HPP_
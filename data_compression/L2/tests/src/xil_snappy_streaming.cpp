@@ -15,6 +15,7 @@
  *
  */
 #include "xil_snappy_streaming.hpp"
+#include "snappy_frame.hpp"
 #define BLOCK_SIZE 64
 #define KB 1024
 #define MAGIC_HEADER_SIZE 4
@@ -286,7 +287,6 @@ uint64_t xfSnappyStreaming::decompressFile(std::string& inFile_name, std::string
         }
 
         std::vector<uint8_t, aligned_allocator<uint8_t> > in(input_size);
-        std::vector<uint8_t, aligned_allocator<uint8_t> > out(6 * input_size);
 
         char c = 0;
 
@@ -304,6 +304,9 @@ uint64_t xfSnappyStreaming::decompressFile(std::string& inFile_name, std::string
         // Read block data from compressed stream .snappy
         inFile.read((char*)in.data(), (input_size - 10));
 
+        // Size output exactly from the chunk preambles
+        std::vector<uint8_t, aligned_allocator<uint8_t> > out(getSnappyDecompressedSize(in.data(), (input_size - 10)));
+
         // Decompression Sequential multiple cus.
         uint64_t debytes = decompress(in.data(), out.data(), (input_size - 10));
         outFile.write((char*)out.data(), debytes);
@@ -400,8 +403,12 @@ uint64_t xfSnappyStreaming::decompress(uint8_t* in, uint8_t* out, uint64_t input
             buffer_input =
                 new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, compSize, h_buf_in.data());
 
-            buffer_output =
-                new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, decompSize, h_buf_out.data());
+            // Decode straight into the caller buffer when it is page aligned,
+            // otherwise stage the block through h_buf_out
+            uint8_t* dst = out + bufIdx;
+            bool direct = ((uintptr_t)dst % 4096) == 0;
+            buffer_output = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, decompSize,
+                                           direct ? dst : h_buf_out.data());
 
             // set kernel arguments
             int narg = 0;
@@ -432,12 +439,16 @@ uint64_t xfSnappyStreaming::decompress(uint8_t* in, uint8_t* out, uint64_t input
             m_q->enqueueMigrateMemObjects({*(buffer_output)}, CL_MIGRATE_MEM_OBJECT_HOST);
             m_q->finish();
 
-            std::memcpy(out + bufIdx, h_buf_out.data(), decompSize);
+            if (!direct) std::memcpy(dst, h_buf_out.data(), decompSize);
             bufIdx += decompSize;
+
+            delete (buffer_input);
+            delete (buffer_output);
         } else if (chunk_idx == 0x01) {
             compSize = chunk_size - 4;
             decompSize = chunk_size - 4;
             std::memcpy(out + bufIdx, in + cIdx + 8, compSize);
+            bufIdx += decompSize;
         }
 
         cIdx += chunk_size;
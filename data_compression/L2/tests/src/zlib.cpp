@@ -21,6 +21,7 @@
 #define REAL_CODE 8
 #define OPCODE 3
 #define CHUNK_16K 16384
+#define DEC_OUT_ALIGN 64
 
 uint32_t get_file_size(std::ifstream& file) {
     file.seekg(0, file.end);
@@ -178,8 +179,6 @@ xil_zlib::xil_zlib(const std::string& binaryFileName, uint8_t flow) {
     }
 
     for (int i = 0; i < MAX_DDCOMP_UNITS; i++) {
-        h_dbuf_in[i].resize(PARALLEL_ENGINES * HOST_BUFFER_SIZE);
-        h_dbuf_zlibout[i].resize(PARALLEL_ENGINES * HOST_BUFFER_SIZE * 10);
         h_dcompressSize[i].resize(MAX_NUMBER_BLOCKS);
     }
 }
@@ -300,19 +299,20 @@ uint32_t xil_zlib::decompress_file(std::string& inFile_name, std::string& outFil
         exit(1);
     }
 
-    std::vector<uint8_t, aligned_allocator<uint8_t> > in(input_size);
+    // Kernel reads whole memory words, pad input to the word width
+    std::vector<uint8_t, aligned_allocator<uint8_t> > in(((input_size - 1) / DEC_OUT_ALIGN + 1) * DEC_OUT_ALIGN);
 
-    // Allocat output size
-    // 8 - Max CR per file expected, if this size is big
-    // Decompression crashes
-    std::vector<uint8_t, aligned_allocator<uint8_t> > out(input_size * 10);
+    // zlib container carries no original size, allocate
+    // for the max CR expected, rounded up to the kernel write width
+    uint64_t out_size = ((input_size * 10 - 1) / DEC_OUT_ALIGN + 1) * DEC_OUT_ALIGN;
+    std::vector<uint8_t, aligned_allocator<uint8_t> > out(out_size);
     uint32_t debytes = 0;
     // READ ZLIB header 2 bytes
     inFile.read((char*)in.data(), input_size);
     // printme("Call to zlib_decompress \n");
     // Call decompress
     auto decompress_API_start = std::chrono::high_resolution_clock::now();
-    debytes = decompress(in.data(), out.data(), input_size, cu);
+    debytes = decompress(in.data(), out.data(), input_size, out_size, cu);
     auto decompress_API_end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration<double, std::nano>(decompress_API_end - decompress_API_start);
     decompress_API_time_ns_1 += duration;
@@ -329,7 +329,7 @@ uint32_t xil_zlib::decompress_file(std::string& inFile_name, std::string& outFil
     return debytes;
 }
 
-uint32_t xil_zlib::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, int cu) {
+uint32_t xil_zlib::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, uint32_t out_size, int cu) {
     bool flag = false;
     if (input_size > 128 * 1024 * 1024) flag = true;
     // printme("Entered zlib decop \n");
@@ -345,30 +345,28 @@ uint32_t xil_zlib::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, in
     if (flag) {
         // printme("before buffer creation \n");
         buffer_in = new cl::Buffer(*m_context, CL_MEM_READ_ONLY, input_size);
-        buffer_out = new cl::Buffer(*m_context, CL_MEM_READ_WRITE, input_size * 10);
+        buffer_out = new cl::Buffer(*m_context, CL_MEM_READ_WRITE, out_size);
         buffer_size = new cl::Buffer(*m_context, CL_MEM_READ_WRITE, 10 * sizeof(uint32_t));
         inP = (uint8_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_in), CL_TRUE, CL_MAP_READ, 0, input_size);
-        outP = (uint8_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_out), CL_TRUE, CL_MAP_WRITE, 0, input_size * 10);
+        outP = (uint8_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_out), CL_TRUE, CL_MAP_WRITE, 0, out_size);
         outSize =
             (uint32_t*)m_q_dec[cu]->enqueueMapBuffer(*(buffer_size), CL_TRUE, CL_MAP_WRITE, 0, 10 * sizeof(uint32_t));
+
+        // Copy compressed input to mapped device buffer
+        std::memcpy(inP, &in[0], input_size);
     } else {
         // printme("before buffer creation \n");
-        buffer_in =
-            new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, input_size, h_dbuf_in[cu].data());
+        // Caller buffers are page aligned, kernel reads/writes them in place
+        uint32_t in_size = ((input_size - 1) / DEC_OUT_ALIGN + 1) * DEC_OUT_ALIGN;
+        buffer_in = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, in_size, in);
 
-        buffer_out = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, input_size * 10,
-                                    h_dbuf_zlibout[cu].data());
+        buffer_out = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, out_size, out);
 
         buffer_size = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, 10 * sizeof(uint32_t),
                                      h_dcompressSize[cu].data());
 
-        inP = h_dbuf_in[cu].data();
-        outP = h_dbuf_zlibout[cu].data();
         outSize = h_dcompressSize[cu].data();
     }
-    // printme("Entered incopy \n");
-    // Copy compressed input to h_buf_in
-    std::memcpy(inP, &in[0], input_size);
 
     int narg = 0;
     // Set Kernel Args
@@ -392,11 +390,18 @@ uint32_t xil_zlib::decompress(uint8_t* in, uint8_t* out, uint32_t input_size, in
 
     uint32_t raw_size = *outSize;
 
-    // If raw size is greater than 3GB
-    // Limit it to 3GB
-    if (raw_size > 3U << (3 * 10)) raw_size = 3U << (3 * 10);
+    if (raw_size > out_size) {
+        std::cout << "Decompressed size " << raw_size << " exceeds output buffer size " << out_size << std::endl;
+        raw_size = 0;
+    }
 
-    m_q_dec[cu]->enqueueReadBuffer(*(buffer_out), CL_TRUE, 0, raw_size * sizeof(uint8_t), &out[0]);
+    if (flag) {
+        m_q_dec[cu]->enqueueReadBuffer(*(buffer_out), CL_TRUE, 0, raw_size * sizeof(uint8_t), &out[0]);
+    } else if (raw_size) {
+        // Output already lives in caller memory, only sync it back
+        m_q_dec[cu]->enqueueMigrateMemObjects({*(buffer_out)}, CL_MIGRATE_MEM_OBJECT_HOST);
+        m_q_dec[cu]->finish();
+    }
 
     if (flag) {
         m_q_dec[cu]->enqueueUnmapMemObject(*buffer_in, inP, nullptr, nullptr);
@@ -59,7 +59,9 @@ class xil_zlib {
     int init(const std::string& binaryFile, uint8_t flow);
     int release();
     uint32_t compress(uint8_t* in, uint8_t* out, uint32_t actual_size, uint32_t host_buffer_size);
-    uint32_t decompress(uint8_t* in, uint8_t* out, uint32_t actual_size, int cu_run);
+    // in/out must be page aligned and padded to the 64B kernel word,
+    // out_size is the exact output capacity
+    uint32_t decompress(uint8_t* in, uint8_t* out, uint32_t actual_size, uint32_t out_size, int cu_run);
     uint32_t compress_file(std::string& inFile_name, std::string& outFile_name, uint64_t input_size);
     uint32_t decompress_file(std::string& inFile_name, std::string& outFile_name, uint64_t input_size, int cu_run);
     uint64_t get_event_duration_ns(const cl::Event& event);
@@ -88,8 +90,6 @@ class xil_zlib {
     std::vector<uint32_t, aligned_allocator<uint32_t> > h_compressSize[MAX_CCOMP_UNITS][OVERLAP_BUF_COUNT];
 
     // Decompression Related
-    std::vector<uint8_t, aligned_allocator<uint8_t> > h_dbuf_in[MAX_DDCOMP_UNITS];
-    std::vector<uint8_t, aligned_allocator<uint8_t> > h_dbuf_zlibout[MAX_DDCOMP_UNITS];
     std::vector<uint32_t, aligned_allocator<uint32_t> > h_dcompressSize[MAX_DDCOMP_UNITS];
 
     // Buffers related to Dynamic Huffman
@@ -47,7 +47,6 @@ uint32_t get_file_size(std::ifstream& file) {
 // Constructor
 xfZlibStream::xfZlibStream() {
     h_dbuf_in.resize(PARALLEL_ENGINES * HOST_BUFFER_SIZE);
-    h_dbuf_gzipout.resize(PARALLEL_ENGINES * HOST_BUFFER_SIZE * 10);
     h_dcompressSize.resize(MAX_NUMBER_BLOCKS);
 }
 
@@ -113,10 +112,9 @@ uint32_t xfZlibStream::decompress_file(std::string& inFile_name, std::string& ou
 
     std::vector<uint8_t, aligned_allocator<uint8_t> > in(input_size);
 
-    // Allocat output size
-    // 8 - Max CR per file expected, if this size is big
-    // Decompression crashes
-    std::vector<uint8_t, aligned_allocator<uint8_t> > out(input_size * 10);
+    // The zlib container carries no original size, decompress grows
+    // the output as decoded chunks arrive
+    std::vector<uint8_t, aligned_allocator<uint8_t> > out(input_size);
     uint32_t debytes = 0;
 #ifdef GZIP_FLOW
     ////printme("In GZIP_flow");
@@ -169,7 +167,7 @@ uint32_t xfZlibStream::decompress_file(std::string& inFile_name, std::string& ou
     inFile.read((char*)in.data(), (input_size - d_cntr));
 
     // Call decompress
-    debytes = decompress(in.data(), out.data(), (input_size - d_cntr));
+    debytes = decompress(in.data(), out, (input_size - d_cntr));
 
 #else
     // READ ZLIB header 2 bytes
@@ -177,7 +175,7 @@ uint32_t xfZlibStream::decompress_file(std::string& inFile_name, std::string& ou
     // printme("Call to zlib_decompress \n");
     // Call decompress
     auto decompress_API_start = std::chrono::high_resolution_clock::now();
-    debytes = decompress(in.data(), out.data(), input_size);
+    debytes = decompress(in.data(), out, input_size);
     auto decompress_API_end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration<double, std::nano>(decompress_API_end - decompress_API_start);
     decompress_API_time_ns_1 += duration;
@@ -196,16 +194,22 @@ uint32_t xfZlibStream::decompress_file(std::string& inFile_name, std::string& ou
     return debytes;
 }
 
-uint32_t xfZlibStream::decompress(uint8_t* in, uint8_t* out, uint32_t input_size) {
+uint32_t xfZlibStream::decompress(uint8_t* in,
+                                  std::vector<uint8_t, aligned_allocator<uint8_t> >& out,
+                                  uint32_t input_size) {
     // cl_int err;
-    uint32_t inBufferSize = 2 * 1024 * 1024;
+    uint32_t inBufferSize = STREAM_IN_CHUNK_SIZE;
     uint32_t bufferCount = 1 + (input_size - 1) / inBufferSize;
 
-    // if input_size if greater than 2 MB, then buffer size must be 2MB
+    // if input_size is greater than the chunk size, then feed it in chunks
     if (input_size < inBufferSize) inBufferSize = input_size;
 
+    // Deflate cannot expand a chunk beyond MAX_DEFLATE_CR, so this bounds
+    // the data mover output per invocation for any input
+    uint32_t outBufferSize = inBufferSize * MAX_DEFLATE_CR;
+
     h_dbuf_in.resize(inBufferSize);
-    h_dbuf_gzipout.resize(inBufferSize * 10);
+    h_dbuf_gzipout.resize(outBufferSize);
     h_dcompressSize.resize(10);
 
     uint8_t* inP = nullptr;
@@ -218,7 +222,7 @@ uint32_t xfZlibStream::decompress(uint8_t* in, uint8_t* out, uint32_t input_size
     buffer_in = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, inBufferSize, h_dbuf_in.data());
 
     buffer_out =
-        new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, inBufferSize * 10, h_dbuf_gzipout.data());
+        new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, outBufferSize, h_dbuf_gzipout.data());
 
     buffer_size = new cl::Buffer(*m_context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, 10 * sizeof(uint32_t),
                                  h_dcompressSize.data());
@@ -265,7 +269,15 @@ uint32_t xfZlibStream::decompress(uint8_t* in, uint8_t* out, uint32_t input_size
         m_q_dm->finish();
 
         uint32_t raw_size = *outSize;
-        std::memcpy(out, outP + decmpSizeIdx, raw_size);
+        if (raw_size > outBufferSize) {
+            std::cout << "Decompressed chunk of " << raw_size << " bytes exceeds the output buffer" << std::endl;
+            decmpSizeIdx = 0;
+            break;
+        }
+
+        // Grow the caller buffer geometrically as chunks arrive
+        if (decmpSizeIdx + raw_size > out.size()) out.resize(std::max<size_t>(2 * out.size(), decmpSizeIdx + raw_size));
+        std::memcpy(out.data() + decmpSizeIdx, outP, raw_size);
         decmpSizeIdx += raw_size;
     }
     // wait for decompression kernel
@@ -16,6 +16,7 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <stdint.h>
@@ -50,6 +51,12 @@
 // Maximum number of blocks based on host buffer size
 #define MAX_NUMBER_BLOCKS (HOST_BUFFER_SIZE / (BLOCK_SIZE_IN_KB * 1024))
 
+// Compressed input fed to the data mover per invocation
+#define STREAM_IN_CHUNK_SIZE (64 * 1024)
+
+// Worst case deflate expansion: a 258 byte match per 2 bits of input
+#define MAX_DEFLATE_CR 1032
+
 int validate(std::string& inFile_name, std::string& outFile_name);
 
 uint32_t get_file_size(std::ifstream& file);
@@ -58,7 +65,7 @@ class xfZlibStream {
    public:
     int init(const std::string& binaryFile);
     int release();
-    uint32_t decompress(uint8_t* in, uint8_t* out, uint32_t actual_size);
+    uint32_t decompress(uint8_t* in, std::vector<uint8_t, aligned_allocator<uint8_t> >& out, uint32_t actual_size);
     uint32_t decompress_file(std::string& inFile_name, std::string& outFile_name, uint64_t input_size);
     uint64_t get_event_duration_ns(const cl::Event& event);
 
@@ -449,6 +449,105 @@ ALU_Processing:
     strm_out_end.write(1);
 }
 
+//------------------Decimal Extension------------------
+
+// signed type of the same width, decimal columns are stored in two's complement
+template <typename T>
+struct alu_signed {
+    typedef T type;
+};
+template <int W>
+struct alu_signed<ap_uint<W> > {
+    typedef ap_int<W> type;
+};
+
+// 10^k, k up to 38
+template <typename T>
+T alu_pow10(ap_uint<6> k) {
+    T p = 1;
+    for (int i = 0; i < 38; ++i) {
+        if (i < k) p = p * 10;
+    }
+    return p;
+}
+
+// v * up / den, rounded half away from zero, 0 when den is 0
+template <typename T>
+T alu_rescale(T v, T up, T den) {
+#pragma HLS INLINE
+    T num = v * up;
+    if (den == 0) return 0;
+    T q = num / den;
+    T r = num - q * den;
+    T ar = r < 0 ? (T)-r : r;
+    T ad = den < 0 ? (T)-den : den;
+    // ar >= ad - ar instead of 2 * ar >= ad, which may overflow
+    if (ar != 0 && ar >= ad - ar) {
+        if ((num < 0) != (den < 0)) {
+            q = q - 1;
+        } else {
+            q = q + 1;
+        }
+    }
+    return q;
+}
+
+// sign-extend the 4 inputs to the compute type, keep the 4th one as divisor
+template <typename TStrm1, typename TStrm2, typename TStrm3, typename TStrm4, typename TOut>
+void dec_extend(hls::stream<TStrm1>& strm_in1,
+                hls::stream<TStrm2>& strm_in2,
+                hls::stream<TStrm3>& strm_in3,
+                hls::stream<TStrm4>& strm_in4,
+                hls::stream<bool>& strm_in_end,
+                hls::stream<TOut>& strm_out1,
+                hls::stream<TOut>& strm_out2,
+                hls::stream<TOut>& strm_out3,
+                hls::stream<TOut>& strm_out4,
+                hls::stream<TOut>& strm_div,
+                hls::stream<bool>& strm_out_end) {
+    bool end = strm_in_end.read();
+    while (!end) {
+#pragma HLS PIPELINE II = 1
+        strm_out1.write((typename alu_signed<TStrm1>::type)strm_in1.read());
+        strm_out2.write((typename alu_signed<TStrm2>::type)strm_in2.read());
+        strm_out3.write((typename alu_signed<TStrm3>::type)strm_in3.read());
+        TOut in4 = (typename alu_signed<TStrm4>::type)strm_in4.read();
+        strm_out4.write(in4);
+        strm_div.write(in4);
+        strm_out_end.write(0);
+        end = strm_in_end.read();
+    }
+    strm_out_end.write(1);
+}
+
+// scale the ALU result by 10^e, and divide it by the 4th input when asked
+template <typename TOut>
+void dec_rescale(ap_uint<32> dec_cfg,
+                 hls::stream<TOut>& strm_in,
+                 hls::stream<TOut>& strm_div,
+                 hls::stream<bool>& strm_in_end,
+                 hls::stream<TOut>& strm_out,
+                 hls::stream<bool>& strm_out_end) {
+    ap_int<8> e = dec_cfg(7, 0);
+    bool div = dec_cfg[8];
+    ap_uint<6> k = e < 0 ? (ap_uint<6>)(-e) : (ap_uint<6>)e;
+    TOut p = alu_pow10<TOut>(k);
+    TOut up = e > 0 ? p : (TOut)1;
+    TOut down = e < 0 ? p : (TOut)1;
+
+    bool end = strm_in_end.read();
+    while (!end) {
+#pragma HLS PIPELINE II = 1
+        TOut v = strm_in.read();
+        TOut d = strm_div.read();
+        TOut den = div ? (TOut)(d * down) : down;
+        strm_out.write(alu_rescale<TOut>(v, up, den));
+        strm_out_end.write(0);
+        end = strm_in_end.read();
+    }
+    strm_out_end.write(1);
+}
+
 } // namespace details end
 
 // clang-format off
@@ -731,6 +830,88 @@ void dynamicEval(ap_uint<289> config,
         strm_out, strm_out_end);
 }
 
+/**
+ * @brief Dynamic expression evaluation of fixed-point decimals, with scale-aware multiply and divide.
+ *
+ * Inputs are decimal values stored as two's complement integers of their unscaled value, such as ``DECIMAL(18,2)``
+ * in 64 bits or ``DECIMAL(38,4)`` in 128 bits. They are sign-extended to ``TOut`` and evaluated with the same
+ * operators as the other ``dynamicEval``, constants are taken as signed 64-bit. The result is then multiplied by
+ * ``10^e``, or divided by ``10^-e`` when ``e`` is negative, and divided by input Stream4 when division is on,
+ * with quotients rounded half away from zero. Division by zero gives zero.
+ *
+ * So ``e`` is the target scale minus the scale of the expression. ``a * b`` with scales 2 and 2 has scale 4,
+ * and ``e = -2`` brings it back to 2. ``(a * c) / b`` with division on and scales 2, 0 and 2 needs
+ * ``e = 2``, as dividing by ``b`` takes 2 off the scale.
+ *
+ * ``TOut`` must be a signed type wide enough for the unrescaled result, ``ap_int<64>`` is enough for products of
+ * two 32-bit inputs and ``ap_int<128>`` for those of two ``DECIMAL(18,s)``. The divider of ``TOut`` width is the
+ * largest part of this primitive, even when division is off.
+ *
+ * @tparam TStrm1 Type of input Stream1
+ * @tparam TStrm2 Type of input Stream2
+ * @tparam TStrm3 Type of input Stream3
+ * @tparam TStrm4 Type of input Stream4, also the divisor
+ * @tparam TOut Signed type of Compute Result
+ *
+ * @param config configuration bits of ops and constants, as the other ``dynamicEval``.
+ * @param dec_cfg signed exponent ``e`` of 10 in bits 7:0, division by Stream4 in bit 8.
+ *
+ * @param strm_in1 input Stream1
+ * @param strm_in2 input Stream2
+ * @param strm_in3 input Stream3
+ * @param strm_in4 input Stream4
+ * @param strm_in_end end flag of input stream
+ *
+ * @param strm_out output Stream
+ * @param strm_out_end end flag of output stream
+ */
+template <typename TStrm1, typename TStrm2, typename TStrm3, typename TStrm4, typename TOut>
+void dynamicEval(ap_uint<289> config,
+                 ap_uint<32> dec_cfg,
+
+                 hls::stream<TStrm1>& strm_in1,
+                 hls::stream<TStrm2>& strm_in2,
+                 hls::stream<TStrm3>& strm_in3,
+                 hls::stream<TStrm4>& strm_in4,
+                 hls::stream<bool>& strm_in_end,
+
+                 hls::stream<TOut>& strm_out,
+                 hls::stream<bool>& strm_out_end) {
+#pragma HLS dataflow
+
+    hls::stream<TOut> ext_strm[4];
+#pragma HLS stream variable = ext_strm depth = 8
+#pragma HLS array_partition variable = ext_strm complete
+    hls::stream<TOut> div_strm;
+#pragma HLS stream variable = div_strm depth = 32
+    hls::stream<bool> e_ext_strm;
+#pragma HLS stream variable = e_ext_strm depth = 8
+    hls::stream<TOut> alu_strm;
+#pragma HLS stream variable = alu_strm depth = 8
+    hls::stream<bool> e_alu_strm;
+#pragma HLS stream variable = e_alu_strm depth = 8
+
+    ap_uint<33> Operator = config(288, 256);
+
+    TOut c1 = (ap_int<64>)config(255, 192);
+    TOut c2 = (ap_int<64>)config(191, 128);
+    TOut c3 = (ap_int<64>)config(127, 64);
+    TOut c4 = (ap_int<64>)config(63, 0);
+
+    details::dec_extend<TStrm1, TStrm2, TStrm3, TStrm4, TOut>(strm_in1, strm_in2, strm_in3, strm_in4, strm_in_end,
+                                                              ext_strm[0], ext_strm[1], ext_strm[2], ext_strm[3],
+                                                              div_strm, e_ext_strm);
+
+    details::dynamic_ALU_top<TOut, TOut, TOut, TOut, TOut, TOut, TOut, TOut, TOut>(
+        Operator,
+
+        ext_strm[0], c1, ext_strm[1], c2, ext_strm[2], c3, ext_strm[3], c4, e_ext_strm,
+
+        alu_strm, e_alu_strm);
+
+    details::dec_rescale<TOut>(dec_cfg, alu_strm, div_strm, e_alu_strm, strm_out, strm_out_end);
+}
+
 } // namespace database end
 } // namespace xf end
 
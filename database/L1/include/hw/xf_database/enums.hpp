@@ -70,8 +70,12 @@ enum FilterOp {
  * @brief JoinType operators
  *
  * CAUTION: hash-multi-cond-join only supports first three operators.
+ * ``hashMultiJoin`` also supports the outer joins, which keep unmatched rows with the other side's payload
+ * zero-filled. ``JT_LEFT`` keeps the outer (probe) table, ``JT_RIGHT`` keeps the inner (build) table and
+ * ``JT_FULL`` keeps both. Value 3 is reserved, ``hashMultiJoin`` uses it for a semi-join that also requires
+ * the first payload column to differ.
  */
-enum JoinType { JT_INNER, JT_SEMI, JT_ANTI, JT_LEFT, JT_RIGHT };
+enum JoinType { JT_INNER, JT_SEMI, JT_ANTI, JT_LEFT = 4, JT_RIGHT, JT_FULL };
 
 /// @brief width of comparison operator in bits.
 enum { FilterOpWidth = 4 };
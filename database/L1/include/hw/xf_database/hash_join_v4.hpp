@@ -581,6 +581,223 @@ void dispatch_wrapper(hls::stream<ap_uint<KEYW> >& i_key_strm,
     }
 }
 
+//------------------------------------------skew--------------------------------------
+
+// read hot keys behind depth and join number, hand them to the dispatcher of every channel once per round.
+template <int KEYW, int HH_NM, int CH_NM>
+void read_hot_key(hls::stream<ap_uint<32> >& pu_begin_status_strms,
+
+                  hls::stream<ap_uint<32> >& o_status_strm,
+                  hls::stream<ap_uint<KEYW> > o_hot_key_strm[CH_NM]) {
+#pragma HLS INLINE off
+
+    const int KW = (KEYW + 31) / 32;
+
+    ap_uint<KEYW> hot_key[HH_NM];
+#pragma HLS array_partition variable = hot_key complete
+
+    // depth and join number are consumed by read_status
+    o_status_strm.write(pu_begin_status_strms.read());
+    o_status_strm.write(pu_begin_status_strms.read());
+
+    ap_uint<32> hot_nm = pu_begin_status_strms.read();
+    if (hot_nm > HH_NM) hot_nm = HH_NM;
+
+    for (int i = 0; i < HH_NM; i++) {
+        ap_uint<KW * 32> key = 0;
+        for (int w = 0; w < KW; w++) {
+#pragma HLS pipeline II = 1
+            key(32 * w + 31, 32 * w) = pu_begin_status_strms.read();
+        }
+        hot_key[i] = key(KEYW - 1, 0);
+    }
+
+    // 1st:build
+    // 2nd:probe
+    for (int r = 0; r < 2; r++) {
+        for (int c = 0; c < CH_NM; c++) {
+            o_hot_key_strm[c].write(hot_nm);
+            for (int i = 0; i < HH_NM; i++) {
+#pragma HLS pipeline II = 1
+                o_hot_key_strm[c].write(hot_key[i]);
+            }
+        }
+    }
+}
+
+// dispatch like dispatch(), except for hot keys: their build rows are copied into every PU and their probe rows
+// are spread round-robin, so a hot key no longer piles onto the PU selected by its hash.
+template <int KEYW, int PW, int HASHWH, int HASHWL, int BF_HASH_NM, int BFW, int PU, int HH_NM>
+void dispatch_skew(bool build,
+                   hls::stream<ap_uint<KEYW> >& i_hot_key_strm,
+
+                   hls::stream<ap_uint<KEYW> >& i_key_strm,
+                   hls::stream<ap_uint<PW> >& i_pld_strm,
+                   hls::stream<ap_uint<HASHWH + HASHWL + BF_HASH_NM * BFW> >& i_hash_strm,
+                   hls::stream<bool>& i_e_strm,
+
+                   hls::stream<ap_uint<KEYW> > o_key_strm[PU],
+                   hls::stream<ap_uint<PW> > o_pld_strm[PU],
+                   hls::stream<ap_uint<HASHWL + BF_HASH_NM * BFW> > o_hash_strm[PU],
+                   hls::stream<bool> o_e_strm[PU],
+
+                   hls::stream<ap_uint<32> >& o_load_strm) {
+#pragma HLS INLINE off
+
+    ap_uint<KEYW> hot_key[HH_NM];
+#pragma HLS array_partition variable = hot_key complete
+    ap_uint<32> load[PU];
+#pragma HLS array_partition variable = load complete
+
+    ap_uint<32> hot_nm = i_hot_key_strm.read();
+    for (int i = 0; i < HH_NM; i++) {
+#pragma HLS pipeline II = 1
+        hot_key[i] = i_hot_key_strm.read();
+    }
+    for (int p = 0; p < PU; p++) {
+#pragma HLS unroll
+        load[p] = 0;
+    }
+    ap_uint<HASHWH> rr = 0;
+
+    bool last = i_e_strm.read();
+LOOP_DISPATCH_SKEW:
+    while (!last) {
+#pragma HLS pipeline II = 1
+
+        ap_uint<HASHWH + HASHWL + BF_HASH_NM* BFW> hash_val = i_hash_strm.read();
+        ap_uint<HASHWH> idx = hash_val(HASHWH + HASHWL + BF_HASH_NM * BFW - 1, HASHWL + BF_HASH_NM * BFW);
+        ap_uint<HASHWL + BF_HASH_NM* BFW> hash_out = hash_val(HASHWL + BF_HASH_NM * BFW - 1, 0);
+
+        ap_uint<KEYW> key = i_key_strm.read();
+        ap_uint<PW> pld = i_pld_strm.read();
+        last = i_e_strm.read();
+
+        bool hot = false;
+        for (int i = 0; i < HH_NM; i++) {
+#pragma HLS unroll
+            if (i < hot_nm && key == hot_key[i]) hot = true;
+        }
+        if (hot && !build) {
+            idx = rr;
+            rr++;
+        }
+
+        for (int p = 0; p < PU; p++) {
+#pragma HLS unroll
+            if (p == idx || (hot && build)) {
+                o_key_strm[p].write(key);
+                o_pld_strm[p].write(pld);
+                o_hash_strm[p].write(hash_out);
+                o_e_strm[p].write(false);
+                load[p]++;
+            }
+        }
+    }
+
+    for (int i = 0; i < PU; i++) {
+#pragma HLS unroll
+        o_key_strm[i].write(0);
+        o_pld_strm[i].write(0);
+        o_hash_strm[i].write(0);
+        o_e_strm[i].write(true);
+    }
+
+    for (int p = 0; p < PU; p++) {
+#pragma HLS pipeline II = 1
+        o_load_strm.write(load[p]);
+    }
+}
+
+// dispatch data based on hash value and hot keys to multiple PU.
+template <int KEYW, int PW, int HASHWH, int HASHWL, int BF_HASH_NM, int BFW, int PU, int HH_NM>
+void dispatch_skew_unit(bool build,
+                        hls::stream<ap_uint<KEYW> >& i_hot_key_strm,
+
+                        hls::stream<ap_uint<KEYW> >& i_key_strm,
+                        hls::stream<ap_uint<PW> >& i_pld_strm,
+                        hls::stream<bool>& i_e_strm,
+
+                        hls::stream<ap_uint<KEYW> > o_key_strm[PU],
+                        hls::stream<ap_uint<PW> > o_pld_strm[PU],
+                        hls::stream<ap_uint<HASHWL + BF_HASH_NM * BFW> > o_hash_strm[PU],
+                        hls::stream<bool> o_e_strm[PU],
+
+                        hls::stream<ap_uint<32> >& o_load_strm) {
+#pragma HLS DATAFLOW
+
+    hls::stream<ap_uint<HASHWH + HASHWL + BF_HASH_NM * BFW> > hash_strm;
+#pragma HLS STREAM variable = hash_strm depth = 8
+#pragma HLS resource variable = hash_strm core = FIFO_SRL
+    hls::stream<ap_uint<KEYW> > key_strm;
+#pragma HLS STREAM variable = key_strm depth = 8
+#pragma HLS resource variable = key_strm core = FIFO_SRL
+    hls::stream<bool> e_strm;
+#pragma HLS STREAM variable = e_strm depth = 8
+
+    hash_wrapper<KEYW, HASHWH + HASHWL, BF_HASH_NM, BFW>(i_key_strm, i_e_strm, hash_strm, key_strm, e_strm);
+
+    dispatch_skew<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU, HH_NM>(build, i_hot_key_strm, key_strm, i_pld_strm,
+                                                                        hash_strm, e_strm, o_key_strm, o_pld_strm,
+                                                                        o_hash_strm, o_e_strm, o_load_strm);
+}
+
+// dispatch data based on hash value and hot keys to multiple PU, rows sent to each PU are counted per round.
+template <int KEYW, int PW, int HASHWH, int HASHWL, int BF_HASH_NM, int BFW, int PU, int HH_NM>
+void dispatch_skew_wrapper(hls::stream<ap_uint<KEYW> >& i_hot_key_strm,
+
+                           hls::stream<ap_uint<KEYW> >& i_key_strm,
+                           hls::stream<ap_uint<PW> >& i_pld_strm,
+                           hls::stream<bool>& i_e_strm,
+
+                           hls::stream<ap_uint<KEYW> > o_key_strm[PU],
+                           hls::stream<ap_uint<PW> > o_pld_strm[PU],
+                           hls::stream<ap_uint<HASHWL + BF_HASH_NM * BFW> > o_hash_strm[PU],
+                           hls::stream<bool> o_e_strm[PU],
+
+                           hls::stream<ap_uint<32> >& o_load_strm) {
+    // 1st:build
+    // 2nd:probe
+    for (int i = 0; i < 2; i++) {
+        dispatch_skew_unit<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU, HH_NM>(
+            i == 0, i_hot_key_strm, i_key_strm, i_pld_strm, i_e_strm, o_key_strm, o_pld_strm, o_hash_strm, o_e_strm,
+            o_load_strm);
+    }
+}
+
+// write back depth and join number, followed by the build rows and the probe rows dispatched to each PU.
+template <int PU, int CH_NM>
+void write_skew_status(hls::stream<ap_uint<32> >& pu_end_status_strms,
+                       ap_uint<32> depth,
+                       ap_uint<32> join_num,
+                       hls::stream<ap_uint<32> > i_load_strm[CH_NM]) {
+    pu_end_status_strms.write(depth);
+    pu_end_status_strms.write(join_num);
+
+    for (int r = 0; r < 2; r++) {
+        ap_uint<32> load[PU];
+#pragma HLS array_partition variable = load complete
+        for (int p = 0; p < PU; p++) {
+#pragma HLS unroll
+            load[p] = 0;
+        }
+        for (int c = 0; c < CH_NM; c++) {
+            for (int p = 0; p < PU; p++) {
+#pragma HLS pipeline II = 1
+                load[p] += i_load_strm[c].read();
+            }
+        }
+        for (int p = 0; p < PU; p++) {
+#pragma HLS pipeline II = 1
+            pu_end_status_strms.write(load[p]);
+#ifndef __SYNTHESIS__
+            std::cout << std::dec << (r == 0 ? "build" : "probe") << " load of PU" << p << ": " << load[p]
+                      << std::endl;
+#endif
+        }
+    }
+}
+
 // -------------------------------------build------------------------------------------
 
 // scan small table to count hash collision
@@ -4103,6 +4320,138 @@ void join_unit(
 
 namespace xf {
 namespace database {
+/**
+ * @brief Count-min sketch based detection of heavy-hitter keys, to feed the hot keys of ``hashJoinV4``.
+ *
+ * Every key updates two rows of counters indexed by Jenkin's Lookup3 hash, the smaller of the two counters
+ * estimates the key frequency. A small candidate table keeps the HH_NM keys with the highest estimate, a key
+ * replaces the weakest candidate once its estimate reaches the threshold and passes that candidate.
+ * Usually run on a sample of the big table, with the threshold set to a fraction of the rows one PU should see.
+ *
+ * @tparam KEYW width of key, in bit.
+ * @tparam HH_NM number of candidate keys kept.
+ * @tparam CMS_W log2 of counters per sketch row.
+ *
+ * @param i_key_strm input of keys.
+ * @param i_e_strm end flag of input keys.
+ * @param thres minimal estimated count of a hot key.
+ * @param o_key_strm output of hot keys.
+ * @param o_cnt_strm estimated count of each hot key.
+ * @param o_e_strm end flag of hot keys.
+ */
+template <int KEYW, int HH_NM, int CMS_W>
+static void hotKeyDetect(hls::stream<ap_uint<KEYW> >& i_key_strm,
+                         hls::stream<bool>& i_e_strm,
+                         ap_uint<32> thres,
+                         hls::stream<ap_uint<KEYW> >& o_key_strm,
+                         hls::stream<ap_uint<32> >& o_cnt_strm,
+                         hls::stream<bool>& o_e_strm) {
+    ap_uint<32> cms0[1 << CMS_W];
+#pragma HLS resource variable = cms0 core = RAM_S2P_BRAM
+    ap_uint<32> cms1[1 << CMS_W];
+#pragma HLS resource variable = cms1 core = RAM_S2P_BRAM
+
+    ap_uint<KEYW> cand_key[HH_NM];
+#pragma HLS array_partition variable = cand_key complete
+    ap_uint<32> cand_cnt[HH_NM];
+#pragma HLS array_partition variable = cand_cnt complete
+
+    for (int i = 0; i < HH_NM; i++) {
+#pragma HLS unroll
+        cand_key[i] = 0;
+        cand_cnt[i] = 0;
+    }
+
+CMS_INIT_LOOP:
+    for (int i = 0; i < (1 << CMS_W); i++) {
+#pragma HLS pipeline II = 1
+        cms0[i] = 0;
+        cms1[i] = 0;
+    }
+
+    // latest updates, newest first, cover the read-after-write distance of the counters
+    ap_uint<CMS_W> idx0_temp[4] = {0, 0, 0, 0};
+    ap_uint<CMS_W> idx1_temp[4] = {0, 0, 0, 0};
+    ap_uint<32> cnt0_temp[4] = {0, 0, 0, 0};
+    ap_uint<32> cnt1_temp[4] = {0, 0, 0, 0};
+#pragma HLS array_partition variable = idx0_temp complete
+#pragma HLS array_partition variable = idx1_temp complete
+#pragma HLS array_partition variable = cnt0_temp complete
+#pragma HLS array_partition variable = cnt1_temp complete
+
+    bool last = i_e_strm.read();
+CMS_UPDATE_LOOP:
+    while (!last) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = cms0 inter false
+#pragma HLS dependence variable = cms1 inter false
+
+        ap_uint<KEYW> key = i_key_strm.read();
+        last = i_e_strm.read();
+
+        ap_uint<64> hash;
+        details::hashlookup3_core<KEYW>(key, hash);
+        ap_uint<CMS_W> idx0 = hash(CMS_W - 1, 0);
+        ap_uint<CMS_W> idx1 = hash(32 + CMS_W - 1, 32);
+
+        ap_uint<32> cnt0 = cms0[idx0];
+        ap_uint<32> cnt1 = cms1[idx1];
+        for (int i = 3; i >= 0; i--) {
+#pragma HLS unroll
+            if (idx0 == idx0_temp[i]) cnt0 = cnt0_temp[i];
+            if (idx1 == idx1_temp[i]) cnt1 = cnt1_temp[i];
+        }
+        cnt0++;
+        cnt1++;
+        cms0[idx0] = cnt0;
+        cms1[idx1] = cnt1;
+
+        for (int i = 3; i > 0; i--) {
+#pragma HLS unroll
+            idx0_temp[i] = idx0_temp[i - 1];
+            idx1_temp[i] = idx1_temp[i - 1];
+            cnt0_temp[i] = cnt0_temp[i - 1];
+            cnt1_temp[i] = cnt1_temp[i - 1];
+        }
+        idx0_temp[0] = idx0;
+        idx1_temp[0] = idx1;
+        cnt0_temp[0] = cnt0;
+        cnt1_temp[0] = cnt1;
+
+        ap_uint<32> est = cnt0 < cnt1 ? cnt0 : cnt1;
+
+        // refresh a known candidate, otherwise replace the weakest one
+        bool found = false;
+        int min_id = 0;
+        ap_uint<32> min_cnt = cand_cnt[0];
+        for (int i = 0; i < HH_NM; i++) {
+#pragma HLS unroll
+            if (cand_cnt[i] != 0 && cand_key[i] == key) {
+                cand_cnt[i] = est;
+                found = true;
+            }
+            if (i > 0 && cand_cnt[i] < min_cnt) {
+                min_cnt = cand_cnt[i];
+                min_id = i;
+            }
+        }
+        if (!found && est >= thres && est > min_cnt) {
+            cand_key[min_id] = key;
+            cand_cnt[min_id] = est;
+        }
+    }
+
+    for (int i = 0; i < HH_NM; i++) {
+#pragma HLS pipeline II = 1
+        if (cand_cnt[i] != 0 && cand_cnt[i] >= thres) {
+            o_key_strm.write(cand_key[i]);
+            o_cnt_strm.write(cand_cnt[i]);
+            o_e_strm.write(false);
+        }
+    }
+    o_e_strm.write(true);
+}
+
 /**
  * @brief Hash-Join v4 primitive, using bloom filter to enhance performance of hash join.
  *
@@ -4130,6 +4479,7 @@ namespace database {
  * @tparam BF_HASH_NM number of bloom filter, 1,2,3.
  * @tparam BF_W bloom-filter hash width.
  * @tparam EN_BF bloom-filter switch, 0 for off, 1 for on.
+ * @tparam HH_NM number of hot keys handled apart from hash dispatch, 0 to turn skew handling off, at most 8.
  *
  * @param k0_strm_arry input of key columns of both tables.
  * @param p0_strm_arry input of payload columns of both tables.
@@ -4158,6 +4508,13 @@ namespace database {
  *
  * @param j_strm output of joined result
  * @param j_e_strm end flag of joined result
+ *
+ * When HH_NM is not 0, ``pu_begin_status_strms`` carries the number of hot keys and HH_NM key slots after
+ * the hash depth and join number, each key split into (KEYW + 31) / 32 little-end 32-bit words.
+ * Build rows of a hot key are copied into every PU and its probe rows are spread round-robin over the PUs,
+ * so a few heavy keys no longer serialize one PU. ``pu_end_status_strms`` then also returns the number of build
+ * rows and of probe rows dispatched to each PU. Hot keys can be found on a sample of the big table with
+ * ``hotKeyDetect``.
  */
 template <int HASH_MODE,
           int KEYW,
@@ -4170,7 +4527,8 @@ template <int HASH_MODE,
           int CH_NM,
           int BF_HASH_NM,
           int BFW,
-          bool EN_BF>
+          bool EN_BF,
+          int HH_NM = 0>
 static void hashJoinV4(
     // input
     hls::stream<ap_uint<KEYW> > k0_strm_arry[CH_NM],
@@ -4203,9 +4561,24 @@ static void hashJoinV4(
     hls::stream<ap_uint<KEYW + S_PW + B_PW> >& j_strm,
     hls::stream<bool>& j_e_strm) {
     enum { PU = (1 << HASHWH) }; // high hash for distribution.
+    enum { HH = HH_NM > 0 ? HH_NM : 1 };
 
 #pragma HLS DATAFLOW
 
+    // skew handling
+    hls::stream<ap_uint<32> > status_strm;
+#pragma HLS stream variable = status_strm depth = 4
+    hls::stream<ap_uint<KEYW> > hot_key_strm[CH_NM];
+#pragma HLS stream variable = hot_key_strm depth = 32
+#pragma HLS array_partition variable = hot_key_strm dim = 1
+    hls::stream<ap_uint<32> > load_strm[CH_NM];
+#pragma HLS stream variable = load_strm depth = 16
+#pragma HLS array_partition variable = load_strm dim = 1
+
+    if (HH_NM > 0) {
+        details::join_v4::sc::read_hot_key<KEYW, HH, CH_NM>(pu_begin_status_strms, status_strm, hot_key_strm);
+    }
+
     // dispatch k0_strm_arry, p0_strm_arry, e0strm_arry to channel1-4
     // Channel1
     hls::stream<ap_uint<KEYW> > k1_strm_arry_c0[PU];
@@ -4343,25 +4716,49 @@ static void hashJoinV4(
 
     //---------------------------------dispatch PU-------------------------------
     if (CH_NM >= 1) {
-        details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
-            k0_strm_arry[0], p0_strm_arry[0], e0_strm_arry[0], k1_strm_arry_c0, p1_strm_arry_c0, hash_strm_arry_c0,
-            e1_strm_arry_c0);
+        if (HH_NM > 0) {
+            details::join_v4::sc::dispatch_skew_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU, HH>(
+                hot_key_strm[0], k0_strm_arry[0], p0_strm_arry[0], e0_strm_arry[0], k1_strm_arry_c0, p1_strm_arry_c0,
+                hash_strm_arry_c0, e1_strm_arry_c0, load_strm[0]);
+        } else {
+            details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
+                k0_strm_arry[0], p0_strm_arry[0], e0_strm_arry[0], k1_strm_arry_c0, p1_strm_arry_c0,
+                hash_strm_arry_c0, e1_strm_arry_c0);
+        }
     }
 
     if (CH_NM >= 2) {
-        details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
-            k0_strm_arry[1], p0_strm_arry[1], e0_strm_arry[1], k1_strm_arry_c1, p1_strm_arry_c1, hash_strm_arry_c1,
-            e1_strm_arry_c1);
+        if (HH_NM > 0) {
+            details::join_v4::sc::dispatch_skew_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU, HH>(
+                hot_key_strm[1], k0_strm_arry[1], p0_strm_arry[1], e0_strm_arry[1], k1_strm_arry_c1, p1_strm_arry_c1,
+                hash_strm_arry_c1, e1_strm_arry_c1, load_strm[1]);
+        } else {
+            details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
+                k0_strm_arry[1], p0_strm_arry[1], e0_strm_arry[1], k1_strm_arry_c1, p1_strm_arry_c1,
+                hash_strm_arry_c1, e1_strm_arry_c1);
+        }
     }
 
     if (CH_NM >= 4) {
-        details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
-            k0_strm_arry[2], p0_strm_arry[2], e0_strm_arry[2], k1_strm_arry_c2, p1_strm_arry_c2, hash_strm_arry_c2,
-            e1_strm_arry_c2);
+        if (HH_NM > 0) {
+            details::join_v4::sc::dispatch_skew_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU, HH>(
+                hot_key_strm[2], k0_strm_arry[2], p0_strm_arry[2], e0_strm_arry[2], k1_strm_arry_c2, p1_strm_arry_c2,
+                hash_strm_arry_c2, e1_strm_arry_c2, load_strm[2]);
+        } else {
+            details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
+                k0_strm_arry[2], p0_strm_arry[2], e0_strm_arry[2], k1_strm_arry_c2, p1_strm_arry_c2,
+                hash_strm_arry_c2, e1_strm_arry_c2);
+        }
 
-        details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
-            k0_strm_arry[3], p0_strm_arry[3], e0_strm_arry[3], k1_strm_arry_c3, p1_strm_arry_c3, hash_strm_arry_c3,
-            e1_strm_arry_c3);
+        if (HH_NM > 0) {
+            details::join_v4::sc::dispatch_skew_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU, HH>(
+                hot_key_strm[3], k0_strm_arry[3], p0_strm_arry[3], e0_strm_arry[3], k1_strm_arry_c3, p1_strm_arry_c3,
+                hash_strm_arry_c3, e1_strm_arry_c3, load_strm[3]);
+        } else {
+            details::join_v4::sc::dispatch_wrapper<KEYW, PW, HASHWH, HASHWL, BF_HASH_NM, BFW, PU>(
+                k0_strm_arry[3], p0_strm_arry[3], e0_strm_arry[3], k1_strm_arry_c3, p1_strm_arry_c3,
+                hash_strm_arry_c3, e1_strm_arry_c3);
+        }
     }
 
     //---------------------------------merge PU---------------------------------
@@ -4402,7 +4799,11 @@ static void hashJoinV4(
     std::cout << "------------read status---------------" << std::endl;
 #endif
 #endif
-    details::join_v3::sc::read_status<PU>(pu_begin_status_strms, depth);
+    if (HH_NM > 0) {
+        details::join_v3::sc::read_status<PU>(status_strm, depth);
+    } else {
+        details::join_v3::sc::read_status<PU>(pu_begin_status_strms, depth);
+    }
 
     //-------------------------------build----------------------------------------
     if (PU >= 1) {
@@ -4581,7 +4982,11 @@ static void hashJoinV4(
     details::join_v3::sc::collect_unit<PU, KEYW + S_PW + B_PW>(j0_strm_arry, e3_strm_arry, join_num, j_strm, j_e_strm);
 
     //------------------------------Write status-----------------------------------
-    details::join_v3::sc::write_status<PU>(pu_end_status_strms, depth, join_num);
+    if (HH_NM > 0) {
+        details::join_v4::sc::write_skew_status<PU, CH_NM>(pu_end_status_strms, depth, join_num, load_strm);
+    } else {
+        details::join_v3::sc::write_status<PU>(pu_end_status_strms, depth, join_num);
+    }
 
 } // hash_join_v4
 
@@ -101,6 +101,7 @@ void multi_probe_htb(ap_uint<32>& depth,
                      hls::stream<ap_uint<KEYW> >& o_key_strm,
                      hls::stream<ap_uint<B_PW> >& o_pld_strm,
                      hls::stream<ap_uint<ARW> >& o_nm2_strm,
+                     hls::stream<ap_uint<2 * ARW> >& o_addr_strm,
                      hls::stream<bool>& o_e2_strm,
 
                      ap_uint<72>* bit_vector0,
@@ -223,6 +224,7 @@ LOOP_PROBE:
             o_key_strm.write(key);
             o_pld_strm.write(pld);
             o_nm2_strm.write(nm);
+            o_addr_strm.write((overflow_ht_addr, base_ht_addr));
             o_e2_strm.write(false);
         }
     }
@@ -255,6 +257,7 @@ void multi_probe_wrapper(ap_uint<32>& depth,
                          hls::stream<ap_uint<KEYW> >& o_t_key_strm,
                          hls::stream<ap_uint<T_PW> >& o_t_pld_strm,
                          hls::stream<ap_uint<ARW> >& o_nm_strm,
+                         hls::stream<ap_uint<2 * ARW> >& o_addr_strm,
                          hls::stream<bool>& o_e0_strm,
 
                          hls::stream<ap_uint<KEYW> >& o_base_s_key_strm,
@@ -294,7 +297,8 @@ void multi_probe_wrapper(ap_uint<32>& depth,
     multi_probe_htb<HASHW, KEYW, PW, T_PW, ARW>(depth, i_hash_strm, i_key_strm, i_pld_strm, i_e_strm,
 
                                                 base_addr_strm, nm0_strm, e0_strm, overflow_addr_strm, nm1_strm,
-                                                e1_strm, o_t_key_strm, o_t_pld_strm, o_nm_strm, o_e0_strm,
+                                                e1_strm, o_t_key_strm, o_t_pld_strm, o_nm_strm, o_addr_strm,
+                                                o_e0_strm,
 
                                                 bit_vector0, bit_vector1);
 
@@ -311,13 +315,242 @@ void multi_probe_wrapper(ap_uint<32>& depth,
                                                      htb_buf);
 }
 
+//----------------------------------------------flush------------------------------------------------
+
+/// @brief Generate stb addr of build rows kept in base area, slot by slot
+template <int HASHW, int ARW>
+void flush_base_addr_gen(bool flush_on,
+                         ap_uint<32>& depth,
+
+                         hls::stream<ap_uint<ARW> >& o_addr_strm,
+                         hls::stream<ap_uint<ARW> >& o_idx_strm,
+                         hls::stream<bool>& o_e_strm,
+
+                         ap_uint<72>* bit_vector0) {
+#pragma HLS INLINE off
+
+    const int HASH_NUMBER = 1 << HASHW;
+
+    if (flush_on) {
+    FLUSH_SLOT_LOOP:
+        for (int h = 0; h < HASH_NUMBER; h++) {
+            ap_uint<HASHW> array_idx = h / 3;
+            ap_uint<2> bit_idx = h - array_idx * 3;
+
+            ap_uint<72> elem;
+            read_bit_vector0(array_idx, elem);
+
+            ap_uint<ARW> nm;
+            if (bit_idx == 0) {
+                nm = elem(23, 0);
+            } else if (bit_idx == 1) {
+                nm = elem(47, 24);
+            } else {
+                nm = elem(71, 48);
+            }
+            if (nm > depth) nm = depth;
+
+            ap_uint<ARW> addr = h * depth;
+        FLUSH_ROW_LOOP:
+            for (ap_uint<ARW> i = 0; i < nm; i++) {
+#pragma HLS PIPELINE II = 1
+                o_addr_strm.write(addr);
+                o_idx_strm.write(addr);
+                o_e_strm.write(false);
+                addr++;
+            }
+        }
+    }
+    o_e_strm.write(true);
+}
+
+/// @brief Generate htb addr of build rows merged into overflow area
+template <int ARW>
+void flush_overflow_addr_gen(ap_uint<ARW> idx_base,
+                             ap_uint<32> length,
+
+                             hls::stream<ap_uint<ARW> >& o_addr_strm,
+                             hls::stream<ap_uint<ARW> >& o_idx_strm,
+                             hls::stream<bool>& o_e_strm) {
+#pragma HLS INLINE off
+
+FLUSH_OVERFLOW_LOOP:
+    for (ap_uint<32> i = 0; i < length; i++) {
+#pragma HLS PIPELINE II = 1
+        o_addr_strm.write(i);
+        o_idx_strm.write(idx_base + i);
+        o_e_strm.write(false);
+    }
+    o_e_strm.write(true);
+}
+
+/// @brief Attach row index to build rows read back from HBM/DDR
+template <int KEYW, int S_PW, int ARW>
+void flush_row(hls::stream<ap_uint<ARW> >& i_idx_strm,
+               hls::stream<ap_uint<KEYW + S_PW> >& i_row_strm,
+               hls::stream<bool>& i_e_strm,
+
+               hls::stream<ap_uint<ARW> >& o_idx_strm,
+               hls::stream<ap_uint<KEYW> >& o_key_strm,
+               hls::stream<ap_uint<S_PW> >& o_pld_strm,
+               hls::stream<bool>& o_e_strm) {
+#pragma HLS INLINE off
+
+    bool last = i_e_strm.read();
+FLUSH_ROW_LOOP:
+    while (!last) {
+#pragma HLS PIPELINE II = 1
+        ap_uint<KEYW + S_PW> row = i_row_strm.read();
+        last = i_e_strm.read();
+
+        o_idx_strm.write(i_idx_strm.read());
+        o_key_strm.write(row(KEYW + S_PW - 1, S_PW));
+        o_pld_strm.write(row(S_PW - 1, 0));
+        o_e_strm.write(false);
+    }
+}
+
+/// @brief Read back build rows of base area
+template <int HASHW, int KEYW, int S_PW, int ARW>
+void flush_base_stb(bool flush_on,
+                    ap_uint<32>& depth,
+
+                    hls::stream<ap_uint<ARW> >& o_idx_strm,
+                    hls::stream<ap_uint<KEYW> >& o_key_strm,
+                    hls::stream<ap_uint<S_PW> >& o_pld_strm,
+                    hls::stream<bool>& o_e_strm,
+
+                    ap_uint<64>* stb_buf,
+                    ap_uint<72>* bit_vector0) {
+#pragma HLS INLINE off
+#pragma HLS DATAFLOW
+
+    hls::stream<ap_uint<ARW> > addr_strm;
+#pragma HLS stream variable = addr_strm depth = 8
+#pragma HLS resource variable = addr_strm core = FIFO_SRL
+    hls::stream<ap_uint<ARW> > idx_strm;
+#pragma HLS stream variable = idx_strm depth = 512
+#pragma HLS resource variable = idx_strm core = FIFO_BRAM
+    hls::stream<bool> e0_strm;
+#pragma HLS stream variable = e0_strm depth = 8
+    hls::stream<ap_uint<KEYW + S_PW> > row_strm;
+#pragma HLS stream variable = row_strm depth = 8
+#pragma HLS resource variable = row_strm core = FIFO_SRL
+    hls::stream<bool> e1_strm;
+#pragma HLS stream variable = e1_strm depth = 8
+
+    flush_base_addr_gen<HASHW, ARW>(flush_on, depth, addr_strm, idx_strm, e0_strm, bit_vector0);
+
+    join_v3::sc::read_stb<ARW, KEYW + S_PW>(stb_buf, addr_strm, e0_strm, row_strm, e1_strm);
+
+    flush_row<KEYW, S_PW, ARW>(idx_strm, row_strm, e1_strm, o_idx_strm, o_key_strm, o_pld_strm, o_e_strm);
+}
+
+/// @brief Read back build rows of overflow area
+template <int KEYW, int S_PW, int ARW>
+void flush_overflow_stb(ap_uint<ARW> idx_base,
+                        ap_uint<32> length,
+
+                        hls::stream<ap_uint<ARW> >& o_idx_strm,
+                        hls::stream<ap_uint<KEYW> >& o_key_strm,
+                        hls::stream<ap_uint<S_PW> >& o_pld_strm,
+                        hls::stream<bool>& o_e_strm,
+
+                        ap_uint<64>* htb_buf) {
+#pragma HLS INLINE off
+#pragma HLS DATAFLOW
+
+    hls::stream<ap_uint<ARW> > addr_strm;
+#pragma HLS stream variable = addr_strm depth = 8
+#pragma HLS resource variable = addr_strm core = FIFO_SRL
+    hls::stream<ap_uint<ARW> > idx_strm;
+#pragma HLS stream variable = idx_strm depth = 512
+#pragma HLS resource variable = idx_strm core = FIFO_BRAM
+    hls::stream<bool> e0_strm;
+#pragma HLS stream variable = e0_strm depth = 8
+    hls::stream<ap_uint<KEYW + S_PW> > row_strm;
+#pragma HLS stream variable = row_strm depth = 8
+#pragma HLS resource variable = row_strm core = FIFO_SRL
+    hls::stream<bool> e1_strm;
+#pragma HLS stream variable = e1_strm depth = 8
+
+    flush_overflow_addr_gen<ARW>(idx_base, length, addr_strm, idx_strm, e0_strm);
+
+    join_v3::sc::read_stb<ARW, KEYW + S_PW>(htb_buf, addr_strm, e0_strm, row_strm, e1_strm);
+
+    flush_row<KEYW, S_PW, ARW>(idx_strm, row_strm, e1_strm, o_idx_strm, o_key_strm, o_pld_strm, o_e_strm);
+}
+
+/// @brief Stream every stored build row with its index after probe, for build side outer join.
+/// Index is the stb addr for base rows, and HASH_NUMBER * depth plus the htb addr for overflow rows,
+/// the same index join unit computes when the row is probed.
+template <int HASHW, int KEYW, int S_PW, int ARW>
+void flush_build_rows(bool flush_on,
+                      ap_uint<32>& depth,
+                      ap_uint<32>& overflow_length,
+
+                      hls::stream<ap_uint<ARW> >& o_idx_strm,
+                      hls::stream<ap_uint<KEYW> >& o_key_strm,
+                      hls::stream<ap_uint<S_PW> >& o_pld_strm,
+                      hls::stream<bool>& o_e_strm,
+
+                      ap_uint<64>* htb_buf,
+                      ap_uint<64>* stb_buf,
+                      ap_uint<72>* bit_vector0) {
+#pragma HLS INLINE off
+
+    const int HASH_NUMBER = 1 << HASHW;
+
+    flush_base_stb<HASHW, KEYW, S_PW, ARW>(flush_on, depth, o_idx_strm, o_key_strm, o_pld_strm, o_e_strm, stb_buf,
+                                           bit_vector0);
+
+    ap_uint<32> length = flush_on ? overflow_length : (ap_uint<32>)0;
+    flush_overflow_stb<KEYW, S_PW, ARW>(HASH_NUMBER * depth, length, o_idx_strm, o_key_strm, o_pld_strm, o_e_strm,
+                                        htb_buf);
+
+    o_e_strm.write(true);
+}
+
 //----------------------------------------------build+merge+probe------------------------------------------------
 
+// drop the build table of a probe-only call, the hash table is reloaded instead
+template <int HASHW, int KEYW, int PW>
+void skip_build_rows(hls::stream<ap_uint<HASHW> >& i_hash_strm,
+                     hls::stream<ap_uint<KEYW> >& i_key_strm,
+                     hls::stream<ap_uint<PW> >& i_pld_strm,
+                     hls::stream<bool>& i_e_strm) {
+#pragma HLS INLINE off
+
+#ifndef __SYNTHESIS__
+    unsigned int cnt = 0;
+#endif
+
+    bool last = i_e_strm.read();
+SKIP_BUILD_LOOP:
+    while (!last) {
+#pragma HLS pipeline II = 1
+        i_hash_strm.read();
+        i_key_strm.read();
+        i_pld_strm.read();
+        last = i_e_strm.read();
+#ifndef __SYNTHESIS__
+        cnt++;
+#endif
+    }
+
+#ifndef __SYNTHESIS__
+    if (cnt) std::cout << "WARNING: " << cnt << " build rows dropped in probe-only mode" << std::endl;
+#endif
+}
+
 /// @brief Top function of hash multi join PU
-template <int HASH_MODE, int HASHWH, int HASHWL, int KEYW, int S_PW, int T_PW, int ARW>
+template <int HASH_MODE, int HASHWH, int HASHWL, int KEYW, int S_PW, int T_PW, int ARW, bool EN_STAT>
 void build_merge_multi_probe_wrapper(
     // input status
     ap_uint<32>& depth,
+    ap_uint<32>& ht_cfg,
+    hls::stream<ap_uint<3> >& join_flag_strm,
+    hls::stream<ap_uint<32> >& o_stat_strm,
 
     // input table
     hls::stream<ap_uint<HASHWL> >& i_hash_strm,
@@ -329,6 +562,7 @@ void build_merge_multi_probe_wrapper(
     hls::stream<ap_uint<KEYW> >& o_t_key_strm,
     hls::stream<ap_uint<T_PW> >& o_t_pld_strm,
     hls::stream<ap_uint<ARW> >& o_nm_strm,
+    hls::stream<ap_uint<2 * ARW> >& o_addr_strm,
     hls::stream<bool>& o_e_strm,
 
     hls::stream<ap_uint<KEYW> >& o_base_s_key_strm,
@@ -336,6 +570,12 @@ void build_merge_multi_probe_wrapper(
     hls::stream<ap_uint<KEYW> >& o_overflow_s_key_strm,
     hls::stream<ap_uint<S_PW> >& o_overflow_s_pld_strm,
 
+    // build rows for outer join
+    hls::stream<ap_uint<ARW> >& o_f_idx_strm,
+    hls::stream<ap_uint<KEYW> >& o_f_key_strm,
+    hls::stream<ap_uint<S_PW> >& o_f_pld_strm,
+    hls::stream<bool>& o_f_e_strm,
+
     ap_uint<64>* htb_buf,
     ap_uint<64>* stb_buf) {
 #pragma HLS INLINE off
@@ -364,36 +604,101 @@ void build_merge_multi_probe_wrapper(
 
     ap_uint<32> overflow_length = 0;
 
-    // initilize uram by previous hash build or probe
-    join_v3::sc::initiate_uram<HASHWL, ARW>(bit_vector0, bit_vector1);
+    ap_uint<3> join_flag = join_flag_strm.read();
+    bool build_outer = join_flag == xf::database::enums::JT_RIGHT || join_flag == xf::database::enums::JT_FULL;
+
+    // hash table kept in htb_buf from save_addr on, as base counters, merged overflow heads and overflow length
+    bool probe_only = ht_cfg[31];
+    ap_uint<64> save_addr = ht_cfg.range(29, 0);
+    bool unsaved = false;
+
+    if (probe_only) {
+#ifndef __SYNTHESIS__
+        std::cout << "----------------------reload-----------------------" << std::endl;
+#endif
+        // rows of stb_buf and htb_buf are left by the call which saved the hash table
+        join_v3::sc::read_htb<HASHWL, ARW>(htb_buf, save_addr, bit_vector0);
+        join_v3::sc::read_htb<HASHWL, ARW>(htb_buf, save_addr + HASH_DEPTH, bit_vector1);
+        overflow_length = htb_buf[(save_addr + 2 * HASH_DEPTH) << 1].range(31, 0);
+
+        skip_build_rows<HASHWL, KEYW, T_PW>(i_hash_strm, i_key_strm, i_pld_strm, i_e_strm);
+    } else {
+        // initilize uram by previous hash build or probe
+        join_v3::sc::initiate_uram<HASHWL, ARW>(bit_vector0, bit_vector1);
 
 #ifndef __SYNTHESIS__
-    std::cout << "----------------------build------------------------" << std::endl;
+        std::cout << "----------------------build------------------------" << std::endl;
 #endif
 
-    // build
-    join_v3::sc::build_wrapper<HASHWL, KEYW, PW, S_PW, ARW>(
-        // input status
-        depth, overflow_length,
+        // build
+        join_v3::sc::build_wrapper<HASHWL, KEYW, PW, S_PW, ARW>(
+            // input status
+            depth, overflow_length,
 
-        // input s-table
-        i_hash_strm, i_key_strm, i_pld_strm, i_e_strm,
+            // input s-table
+            i_hash_strm, i_key_strm, i_pld_strm, i_e_strm,
 
-        // HBM/DDR
-        stb_buf, bit_vector0, bit_vector1);
+            // HBM/DDR
+            stb_buf, bit_vector0, bit_vector1);
 
-    // merge
-    if (overflow_length > 0) {
+        // merge
+        if (overflow_length > 0) {
 // the first time to probe, need to fully build bitmap
 #ifndef __SYNTHESIS__
-        std::cout << "----------------------merge------------------------" << std::endl;
+            std::cout << "----------------------merge------------------------" << std::endl;
 #endif
 
-        join_v3::sc::merge_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, ARW>(
-            // input status
-            depth, overflow_length,
+            join_v3::sc::merge_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, ARW>(
+                // input status
+                depth, overflow_length,
+
+                htb_buf, stb_buf, bit_vector1);
+        }
 
-            htb_buf, stb_buf, bit_vector1);
+        // keep the hash table for later probe-only calls, unless the overflow rows merged into the start of
+        // htb_buf reach its lines, which would corrupt the rows probed next
+        const int ROW_WORDS = (KEYW + S_PW + 63) / 64;
+        unsaved = save_addr != 0 && (ap_uint<64>)overflow_length * ROW_WORDS > (save_addr << 1);
+        if (save_addr != 0 && !unsaved) {
+            join_v3::sc::write_htb<HASHWL, ARW>(htb_buf, save_addr, bit_vector0);
+            join_v3::sc::write_htb<HASHWL, ARW>(htb_buf, save_addr + HASH_DEPTH, bit_vector1);
+            htb_buf[(save_addr + 2 * HASH_DEPTH) << 1] = overflow_length;
+        }
+#ifndef __SYNTHESIS__
+        if (unsaved)
+            std::cout << "ERROR: " << overflow_length << " overflow rows reach the hash table save address "
+                      << save_addr << ", the hash table is not saved" << std::endl;
+#endif
+    }
+
+    // the matched bitmap of join unit has a bit for each of the first 2^(HASHWL + 5) build row indexes, outer
+    // join is refused when rows of this PU go beyond, rather than emitting a partial result
+    bool untracked = build_outer && (ap_uint<64>)(1 << HASHWL) * depth + overflow_length > (1 << (HASHWL + 5));
+    ap_uint<32> flags = 0;
+    flags[0] = untracked;
+    flags[1] = unsaved;
+    o_stat_strm.write(flags);
+#ifndef __SYNTHESIS__
+    if (untracked)
+        std::cout << "ERROR: " << (1 << HASHWL) * depth + overflow_length << " build row indexes exceed "
+                  << (1 << (HASHWL + 5)) << " tracked by outer join, small table rows without match are dropped"
+                  << std::endl;
+#endif
+
+    // rows beyond depth and the longest chain, which is the largest base counter
+    if (EN_STAT) {
+        ap_uint<24> max_chain = 0;
+    HASH_STAT_LOOP:
+        for (int i = 0; i < HASH_DEPTH; i++) {
+#pragma HLS pipeline II = 1
+            ap_uint<72> elem = bit_vector0[i];
+            for (int k = 0; k < 3; k++) {
+                ap_uint<24> v = elem.range(24 * k + 23, 24 * k);
+                if (v > max_chain) max_chain = v;
+            }
+        }
+        o_stat_strm.write(overflow_length);
+        o_stat_strm.write(max_chain);
     }
 
 // probe
@@ -408,13 +713,17 @@ void build_merge_multi_probe_wrapper(
                                                            i_hash_strm, i_key_strm, i_pld_strm, i_e_strm,
 
                                                            // output for join
-                                                           o_t_key_strm, o_t_pld_strm, o_nm_strm, o_e_strm,
+                                                           o_t_key_strm, o_t_pld_strm, o_nm_strm, o_addr_strm, o_e_strm,
                                                            o_base_s_key_strm, o_base_s_pld_strm, o_overflow_s_key_strm,
                                                            o_overflow_s_pld_strm,
                                                            // join_flag_strm_o,
 
                                                            htb_buf, stb_buf, bit_vector0, bit_vector1);
 
+    // read back build rows for outer join, otherwise only the end flag is sent
+    flush_build_rows<HASHWL, KEYW, S_PW, ARW>(build_outer && !untracked, depth, overflow_length, o_f_idx_strm,
+                                              o_f_key_strm, o_f_pld_strm, o_f_e_strm, htb_buf, stb_buf, bit_vector0);
+
 #ifndef __SYNTHESIS__
 
     free(bit_vector0);
@@ -426,7 +735,7 @@ void build_merge_multi_probe_wrapper(
 //-----------------------------------------------join-----------------------------------------------
 
 /// @brief hash hit branch of t_strm
-template <int KEYW, int S_PW, int T_PW, int ARW>
+template <int HASHWL, int KEYW, int S_PW, int T_PW, int ARW>
 void join_unit_1(
 
     ap_uint<32>& join_depth,
@@ -435,6 +744,7 @@ void join_unit_1(
     hls::stream<ap_uint<KEYW> >& i1_t_key_strm,
     hls::stream<ap_uint<T_PW> >& i1_t_pld_strm,
     hls::stream<ap_uint<ARW> >& i1_nm_strm,
+    hls::stream<ap_uint<2 * ARW> >& i1_addr_strm,
     hls::stream<bool>& i1_e0_strm,
 
     // input small table
@@ -443,21 +753,57 @@ void join_unit_1(
     hls::stream<ap_uint<KEYW> >& i_overflow_s_key_strm,
     hls::stream<ap_uint<S_PW> >& i_overflow_s_pld_strm,
 
+    // input small table read back after probe
+    hls::stream<ap_uint<ARW> >& i_f_idx_strm,
+    hls::stream<ap_uint<KEYW> >& i_f_key_strm,
+    hls::stream<ap_uint<S_PW> >& i_f_pld_strm,
+    hls::stream<bool>& i_f_e_strm,
+
     // output join result
     hls::stream<ap_uint<KEYW + S_PW + T_PW> >& o_j_strm,
     hls::stream<bool>& o_e_strm) {
 #pragma HLS INLINE off
 
+    // one bit per build row index, base rows take 2^HASHWL * depth of them and overflow rows follow,
+    // the PU refuses to flush its rows when they do not fit
+    const int MATCH_DEPTH = 1 << (HASHWL - 1);
+
+#ifndef __SYNTHESIS__
+    ap_uint<64>* matched = (ap_uint<64>*)malloc(MATCH_DEPTH * sizeof(ap_uint<64>));
+    unsigned int untracked = 0;
+#else
+    ap_uint<64> matched[MATCH_DEPTH];
+#pragma HLS resource variable = matched core = XPM_MEMORY uram
+#endif
+
     ap_uint<KEYW> s1_key;
     ap_uint<S_PW> s1_pld;
     ap_uint<KEYW> t1_key;
     ap_uint<T_PW> t1_pld;
     ap_uint<KEYW + S_PW + T_PW> j;
     ap_uint<ARW> depth = join_depth;
+    ap_uint<ARW> overflow_base = (1 << HASHWL) * join_depth;
 
     ap_uint<3> join_flag_t = join_flag_strm_o.read();
     int join_flag_i = join_flag_t;
     xf::database::enums::JoinType join_flag = static_cast<xf::database::enums::JoinType>(join_flag_i);
+    bool probe_outer = join_flag == xf::database::enums::JT_LEFT || join_flag == xf::database::enums::JT_FULL;
+    bool build_outer = join_flag == xf::database::enums::JT_RIGHT || join_flag == xf::database::enums::JT_FULL;
+    bool emit_match = join_flag == xf::database::enums::JT_INNER || probe_outer || build_outer;
+
+    if (build_outer) {
+    CLEAR_MATCH_LOOP:
+        for (int i = 0; i < MATCH_DEPTH; i++) {
+#pragma HLS PIPELINE II = 1
+            matched[i] = 0;
+        }
+    }
+
+    // current word of matched bitmap and two last written back, newest first
+    ap_uint<ARW> cur_w = 0;
+    ap_uint<64> cur_word = 0;
+    ap_uint<ARW> w_temp[2] = {0, 0};
+    ap_uint<64> word_temp[2] = {0, 0};
 
     bool t1_last = i1_e0_strm.read();
 JOIN_LOOP_1:
@@ -465,6 +811,7 @@ JOIN_LOOP_1:
         t1_key = i1_t_key_strm.read();
         t1_pld = i1_t_pld_strm.read();
         ap_uint<ARW> nm_1 = i1_nm_strm.read();
+        ap_uint<2 * ARW> addr_1 = i1_addr_strm.read();
         t1_last = i1_e0_strm.read();
         bool flag = 0;
         ap_uint<ARW> base1_nm, overflow1_nm;
@@ -475,29 +822,66 @@ JOIN_LOOP_1:
             base1_nm = nm_1;
             overflow1_nm = 0;
         }
+        ap_uint<ARW> base_idx = addr_1(ARW - 1, 0);
+        ap_uint<ARW> overflow_idx = overflow_base + addr_1(2 * ARW - 1, ARW);
+
         j(KEYW + S_PW + T_PW - 1, S_PW + T_PW) = t1_key;
         if (T_PW > 0) j(T_PW - 1, 0) = t1_pld;
     JOIN_COMPARE_LOOP:
         while (base1_nm > 0 || overflow1_nm > 0) {
 #pragma HLS PIPELINE II = 1
+#pragma HLS dependence variable = matched inter false
 
+            ap_uint<ARW> s1_idx;
             if (base1_nm > 0) {
                 s1_key = i_base_s_key_strm.read();
                 s1_pld = i_base_s_pld_strm.read();
+                s1_idx = base_idx++;
                 base1_nm--;
             } else if (overflow1_nm > 0) {
                 s1_key = i_overflow_s_key_strm.read();
                 s1_pld = i_overflow_s_pld_strm.read();
+                s1_idx = overflow_idx++;
                 overflow1_nm--;
             }
 
             if (S_PW > 0) j(S_PW + T_PW - 1, T_PW) = s1_pld;
 
-            if (join_flag == xf::database::enums::JT_INNER && s1_key == t1_key) {
+            if (emit_match && s1_key == t1_key) {
                 o_j_strm.write(j);
                 o_e_strm.write(false);
             }
 
+            // mark small table row as matched
+            ap_uint<ARW> w = s1_idx >> 6;
+            if (build_outer && s1_key == t1_key) {
+                if (w < MATCH_DEPTH) {
+                    if (w != cur_w) {
+                        matched[cur_w] = cur_word;
+                        ap_uint<64> word;
+                        if (w == w_temp[0]) {
+                            word = word_temp[0];
+                        } else if (w == w_temp[1]) {
+                            word = word_temp[1];
+                        } else {
+                            word = matched[w];
+                        }
+                        w_temp[1] = w_temp[0];
+                        word_temp[1] = word_temp[0];
+                        w_temp[0] = cur_w;
+                        word_temp[0] = cur_word;
+                        cur_w = w;
+                        cur_word = word;
+                    }
+                    cur_word[s1_idx(5, 0)] = 1;
+                }
+#ifndef __SYNTHESIS__
+                else {
+                    untracked++;
+                }
+#endif
+            }
+
             flag = flag || (join_flag == 3 && s1_key == t1_key && s1_pld.range(31, 0) != t1_pld.range(31, 0)) ||
                    (join_flag != 3 && s1_key == t1_key);
         }
@@ -508,8 +892,44 @@ JOIN_LOOP_1:
         } else if ((join_flag == xf::database::enums::JT_SEMI || join_flag == 3) && flag) {
             o_j_strm.write(j);
             o_e_strm.write(false);
+        } else if (probe_outer && !flag) {
+            if (S_PW > 0) j(S_PW + T_PW - 1, T_PW) = 0;
+            o_j_strm.write(j);
+            o_e_strm.write(false);
         }
     }
+
+    // emit small table rows never matched
+    if (build_outer) matched[cur_w] = cur_word;
+
+    bool f_last = i_f_e_strm.read();
+JOIN_FLUSH_LOOP:
+    while (!f_last) {
+#pragma HLS PIPELINE II = 1
+        ap_uint<ARW> f_idx = i_f_idx_strm.read();
+        ap_uint<KEYW> f_key = i_f_key_strm.read();
+        ap_uint<S_PW> f_pld = i_f_pld_strm.read();
+        f_last = i_f_e_strm.read();
+
+        ap_uint<ARW> w = f_idx >> 6;
+        ap_uint<64> word = matched[w < MATCH_DEPTH ? w : (ap_uint<ARW>)0];
+        if (w < MATCH_DEPTH && !word[f_idx(5, 0)]) {
+            j(KEYW + S_PW + T_PW - 1, S_PW + T_PW) = f_key;
+            if (S_PW > 0) j(S_PW + T_PW - 1, T_PW) = f_pld;
+            if (T_PW > 0) j(T_PW - 1, 0) = 0;
+            o_j_strm.write(j);
+            o_e_strm.write(false);
+        }
+    }
+
+#ifndef __SYNTHESIS__
+    if (untracked > 0) {
+        std::cout << "WARNING: " << untracked << " matches beyond index " << MATCH_DEPTH * 64
+                  << " are not tracked by outer join." << std::endl;
+    }
+    free(matched);
+#endif
+
     o_j_strm.write(0);
     o_e_strm.write(true);
 }
@@ -547,7 +967,8 @@ JOIN_LOOP_2:
         ap_uint<ARW> nm_2 = i2_nm_strm.read();
         t2_last = i2_e0_strm.read();
 
-        if (join_flag == xf::database::enums::JT_ANTI) {
+        if (join_flag == xf::database::enums::JT_ANTI || join_flag == xf::database::enums::JT_LEFT ||
+            join_flag == xf::database::enums::JT_FULL) {
             if (nm_2 == 0) {
                 j2(KEYW + S_PW + T_PW - 1, S_PW + T_PW) = t2_key;
                 if (S_PW > 0) {
@@ -577,6 +998,7 @@ void split_stream(
     hls::stream<ap_uint<KEYW> >& i_t_key_strm,
     hls::stream<ap_uint<T_PW> >& i_t_pld_strm,
     hls::stream<ap_uint<ARW> >& i_nm_strm,
+    hls::stream<ap_uint<2 * ARW> >& i_addr_strm,
     hls::stream<bool>& i_e0_strm,
 
     // output
@@ -584,6 +1006,7 @@ void split_stream(
     hls::stream<ap_uint<KEYW> >& i1_t_key_strm,
     hls::stream<ap_uint<T_PW> >& i1_t_pld_strm,
     hls::stream<ap_uint<ARW> >& i1_nm_strm,
+    hls::stream<ap_uint<2 * ARW> >& i1_addr_strm,
     hls::stream<bool>& i1_e0_strm,
 
     hls::stream<ap_uint<3> >& join2_flag_strm,
@@ -607,11 +1030,13 @@ DIVIDE_LOOP:
         t_key = i_t_key_strm.read();
         t_pld = i_t_pld_strm.read();
         ap_uint<ARW> nm = i_nm_strm.read();
+        ap_uint<2 * ARW> addr = i_addr_strm.read();
         t_last = i_e0_strm.read();
         if (nm > 0) {
             i1_t_key_strm.write(t_key);
             i1_t_pld_strm.write(t_pld);
             i1_nm_strm.write(nm);
+            i1_addr_strm.write(addr);
             i1_e0_strm.write(false);
 
         } else if (nm == 0) {
@@ -682,7 +1107,7 @@ void combine_stream(
 }
 
 /// @brief top function of multi join
-template <int KEYW, int S_PW, int T_PW, int ARW>
+template <int HASHWL, int KEYW, int S_PW, int T_PW, int ARW>
 void multi_join_unit(
 #ifndef __SYNTHESIS__
     int pu_id,
@@ -694,6 +1119,7 @@ void multi_join_unit(
     hls::stream<ap_uint<KEYW> >& i_t_key_strm,
     hls::stream<ap_uint<T_PW> >& i_t_pld_strm,
     hls::stream<ap_uint<ARW> >& i_nm_strm,
+    hls::stream<ap_uint<2 * ARW> >& i_addr_strm,
     hls::stream<bool>& i_e0_strm,
 
     // input small table
@@ -702,6 +1128,11 @@ void multi_join_unit(
     hls::stream<ap_uint<KEYW> >& i_overflow_s_key_strm,
     hls::stream<ap_uint<S_PW> >& i_overflow_s_pld_strm,
 
+    hls::stream<ap_uint<ARW> >& i_f_idx_strm,
+    hls::stream<ap_uint<KEYW> >& i_f_key_strm,
+    hls::stream<ap_uint<S_PW> >& i_f_pld_strm,
+    hls::stream<bool>& i_f_e_strm,
+
     // output join result
     hls::stream<ap_uint<KEYW + S_PW + T_PW> >& o_j_strm,
     hls::stream<bool>& o_e_strm) {
@@ -727,6 +1158,9 @@ void multi_join_unit(
     hls::stream<ap_uint<ARW> > i1_nm_strm;
 #pragma HLS STREAM variable = i1_nm_strm depth = 1024
 #pragma HLS resource variable = i1_nm_strm core = FIFO_BRAM
+    hls::stream<ap_uint<2 * ARW> > i1_addr_strm;
+#pragma HLS STREAM variable = i1_addr_strm depth = 1024
+#pragma HLS resource variable = i1_addr_strm core = FIFO_BRAM
     hls::stream<ap_uint<3> > join1_flag_strm;
 #pragma HLS STREAM variable = join1_flag_strm depth = 16
 #pragma HLS resource variable = join1_flag_strm core = FIFO_SRL
@@ -758,9 +1192,10 @@ void multi_join_unit(
 #pragma HLS array_partition variable = i_e_strm dim = 0
 #pragma HLS resource variable = i_e_strm core = FIFO_SRL
 
-    split_stream<KEYW, S_PW, T_PW, ARW>(join_flag_strm, i_t_key_strm, i_t_pld_strm, i_nm_strm, i_e0_strm,
-                                        join1_flag_strm, i1_t_key_strm, i1_t_pld_strm, i1_nm_strm, i1_e0_strm,
-                                        join2_flag_strm, i2_t_key_strm, i2_t_pld_strm, i2_nm_strm, i2_e0_strm);
+    split_stream<KEYW, S_PW, T_PW, ARW>(join_flag_strm, i_t_key_strm, i_t_pld_strm, i_nm_strm, i_addr_strm, i_e0_strm,
+                                        join1_flag_strm, i1_t_key_strm, i1_t_pld_strm, i1_nm_strm, i1_addr_strm,
+                                        i1_e0_strm, join2_flag_strm, i2_t_key_strm, i2_t_pld_strm, i2_nm_strm,
+                                        i2_e0_strm);
 
 #ifndef __SYNTHESIS__
 #ifdef DEBUG
@@ -769,9 +1204,10 @@ void multi_join_unit(
 #endif
 #endif
 
-    join_unit_1<KEYW, S_PW, T_PW, ARW>(depth, join1_flag_strm, i1_t_key_strm, i1_t_pld_strm, i1_nm_strm, i1_e0_strm,
-                                       i_base_s_key_strm, i_base_s_pld_strm, i_overflow_s_key_strm,
-                                       i_overflow_s_pld_strm, i_j_strm[0], i_e_strm[0]);
+    join_unit_1<HASHWL, KEYW, S_PW, T_PW, ARW>(depth, join1_flag_strm, i1_t_key_strm, i1_t_pld_strm, i1_nm_strm,
+                                               i1_addr_strm, i1_e0_strm, i_base_s_key_strm, i_base_s_pld_strm,
+                                               i_overflow_s_key_strm, i_overflow_s_pld_strm, i_f_idx_strm,
+                                               i_f_key_strm, i_f_pld_strm, i_f_e_strm, i_j_strm[0], i_e_strm[0]);
 
     join_unit_2<KEYW, S_PW, T_PW, ARW>(join2_flag_strm, i2_t_key_strm, i2_t_pld_strm, i2_nm_strm, i2_e0_strm,
                                        i_j_strm[1], i_e_strm[1]);
@@ -791,6 +1227,44 @@ void multi_join_unit(
 #endif
 }
 
+// read depth and hash table reuse config from begin status
+template <int PU>
+void read_status(hls::stream<ap_uint<32> >& pu_begin_status_strms, ap_uint<32>& depth, ap_uint<32>& ht_cfg) {
+    // get depth
+    depth = pu_begin_status_strms.read();
+    // probe-only flag and saved hash table address
+    ht_cfg = pu_begin_status_strms.read();
+}
+
+// write depth and join number to end status, followed by hash table stats of all PUs when built with EN_STAT,
+// bit 31 of join number tells a PU refused outer join of its build rows, bit 30 that a PU did not save the
+// hash table asked for
+template <int PU, bool EN_STAT>
+void write_status(hls::stream<ap_uint<32> >& pu_end_status_strms,
+                  ap_uint<32> depth,
+                  ap_uint<32> join_num,
+                  hls::stream<ap_uint<32> > stat_strms[PU]) {
+    ap_uint<32> flags = 0;
+    for (int i = 0; i < PU; i++) {
+        flags |= stat_strms[i].read();
+    }
+    join_num[31] = flags[0];
+    join_num[30] = flags[1];
+    pu_end_status_strms.write(depth);
+    pu_end_status_strms.write(join_num);
+    if (EN_STAT) {
+        ap_uint<32> overflow = 0;
+        ap_uint<32> max_chain = 0;
+        for (int i = 0; i < PU; i++) {
+            overflow += stat_strms[i].read();
+            ap_uint<32> m = stat_strms[i].read();
+            if (m > max_chain) max_chain = m;
+        }
+        pu_end_status_strms.write(overflow);
+        pu_end_status_strms.write(max_chain);
+    }
+}
+
 template <int _NOut>
 void dup_join_flag(hls::stream<ap_uint<3> >& join_flag_strm, hls::stream<ap_uint<3> > join_flags[_NOut]) {
     ap_uint<3> flag = join_flag_strm.read();
@@ -822,8 +1296,16 @@ namespace database {
  * @tparam HASHWL number of hash bits used for hash-table in PU.
  * @tparam ARW width of address, larger than 24 is suggested.
  * @tparam CH_NM number of input channels, 1,2,4.
+ * @tparam EN_STAT true to scan the hash counters of each PU after build and report hash table stats in end
+ * status, which costs a pass over the counters per call.
  *
- * @param join_flag_strm specifies the join type, this flag is only read once.
+ * @param join_flag_strm specifies the join type, this flag is only read once. Besides inner, semi and anti
+ * join, ``JT_LEFT``, ``JT_RIGHT`` and ``JT_FULL`` give outer join. Outer table rows without match are emitted
+ * inline with zero small table payload, small table rows without match are emitted after probe with zero outer
+ * table payload. Matches are tracked in an on-chip bitmap with one bit per build row index of a PU, base rows
+ * take ``2^HASHWL * depth`` indexes and overflow rows follow, so ``2^HASHWL * depth`` plus the overflow rows of
+ * each PU must stay within ``2^(HASHWL + 5)``. A PU beyond it does not emit its small table rows and sets bit 31
+ * of the join number in end status.
  *
  * @param k0_strm_arry input of key columns of both tables.
  * @param p0_strm_arry input of payload columns of both tables.
@@ -847,13 +1329,29 @@ namespace database {
  * @param stb6_buf HBM/DDR buffer of PU6
  * @param stb7_buf HBM/DDR buffer of PU7
  *
- * @param pu_begin_status_strms constains depth of hash, row number of join result
- * @param pu_end_status_strms constains depth of hash, row number of join result
+ * @param pu_begin_status_strms constains depth of hash and hash table reuse config. When bits 29:0 of the
+ * config are not zero, each PU saves its hash table in its htb buffer from that address on, counted in 128-bit
+ * lines, and ``2 * ((1 << HASHWL) / 3 + 1) + 1`` lines long. When bit 31 is set, the build phase is skipped, the
+ * saved hash table is reloaded and rows of the small table are dropped, so it should be fed with no row. The
+ * address must lie beyond the overflow rows kept in htb buffer, and stb and htb buffers must be left as the saving
+ * call did. Bit 30 is reserved.
+ * @param pu_end_status_strms constains depth of hash, row number of join result with bit 31 set when outer join
+ * of small table rows was refused and bit 30 set when the hash table was not saved, and with EN_STAT, the number
+ * of small table rows beyond depth summed over PUs and the longest chain of one hash value among PUs.
  *
  * @param j_strm output of joined result
  * @param j_e_strm end flag of joined result
  */
-template <int HASH_MODE, int KEYW, int PW, int S_PW, int B_PW, int HASHWH, int HASHWL, int ARW, int CH_NM>
+template <int HASH_MODE,
+          int KEYW,
+          int PW,
+          int S_PW,
+          int B_PW,
+          int HASHWH,
+          int HASHWL,
+          int ARW,
+          int CH_NM,
+          bool EN_STAT = false>
 void hashMultiJoin(
     // type
     hls::stream<ap_uint<3> >& join_flag_strm,
@@ -891,12 +1389,19 @@ void hashMultiJoin(
 
 #pragma HLS DATAFLOW
 
-    hls::stream<ap_uint<3> > join_flag_strms[8];
-    details::hash_multi_join::dup_join_flag<8>(join_flag_strm, join_flag_strms);
+    // 0~7 for join units, 8~15 for PUs
+    hls::stream<ap_uint<3> > join_flag_strms[16];
+    details::hash_multi_join::dup_join_flag<16>(join_flag_strm, join_flag_strms);
 
     ap_uint<32> depth;
+    ap_uint<32> ht_cfg;
     ap_uint<32> join_num;
 
+    // outer join refused, overflow length and longest chain of each PU
+    hls::stream<ap_uint<32> > stat_strms[PU];
+#pragma HLS stream variable = stat_strms depth = 4
+#pragma HLS array_partition variable = stat_strms dim = 1
+
     // dispatch k0_strm_arry, p0_strm_arry, e0strm_arry to channel1-4
     // Channel1
     hls::stream<ap_uint<KEYW> > k1_strm_arry_c0[PU];
@@ -995,6 +1500,10 @@ void hashMultiJoin(
 #pragma HLS stream variable = nm_strm_arry depth = 16
 #pragma HLS array_partition variable = nm_strm_arry dim = 1
 #pragma HLS resource variable = nm_strm_arry core = FIFO_SRL
+    hls::stream<ap_uint<2 * ARW> > addr_strm_arry[PU];
+#pragma HLS stream variable = addr_strm_arry depth = 16
+#pragma HLS array_partition variable = addr_strm_arry dim = 1
+#pragma HLS resource variable = addr_strm_arry core = FIFO_SRL
     hls::stream<bool> e2_strm_arry[PU];
 #pragma HLS stream variable = e2_strm_arry depth = 16
 #pragma HLS array_partition variable = e2_strm_arry dim = 1
@@ -1017,6 +1526,24 @@ void hashMultiJoin(
 #pragma HLS array_partition variable = s_overflow_pld_strm_arry dim = 1
 #pragma HLS resource variable = s_overflow_pld_strm_arry core = FIFO_BRAM
 
+    // small table rows read back after probe for outer join
+    hls::stream<ap_uint<ARW> > f_idx_strm_arry[PU];
+#pragma HLS stream variable = f_idx_strm_arry depth = 16
+#pragma HLS array_partition variable = f_idx_strm_arry dim = 1
+#pragma HLS resource variable = f_idx_strm_arry core = FIFO_SRL
+    hls::stream<ap_uint<KEYW> > f_key_strm_arry[PU];
+#pragma HLS stream variable = f_key_strm_arry depth = 16
+#pragma HLS array_partition variable = f_key_strm_arry dim = 1
+#pragma HLS resource variable = f_key_strm_arry core = FIFO_SRL
+    hls::stream<ap_uint<S_PW> > f_pld_strm_arry[PU];
+#pragma HLS stream variable = f_pld_strm_arry depth = 16
+#pragma HLS array_partition variable = f_pld_strm_arry dim = 1
+#pragma HLS resource variable = f_pld_strm_arry core = FIFO_SRL
+    hls::stream<bool> f_e_strm_arry[PU];
+#pragma HLS stream variable = f_e_strm_arry depth = 16
+#pragma HLS array_partition variable = f_e_strm_arry dim = 1
+#pragma HLS resource variable = f_e_strm_arry core = FIFO_SRL
+
     // output of join for collect
     hls::stream<ap_uint<KEYW + S_PW + B_PW> > j0_strm_arry[PU];
 #pragma HLS stream variable = j0_strm_arry depth = 512
@@ -1033,7 +1560,7 @@ void hashMultiJoin(
     std::cout << "------------------------read status------------------------" << std::endl;
 #endif
 #endif
-    details::join_v3::sc::read_status<PU>(pu_begin_status_strms, depth);
+    details::hash_multi_join::read_status<PU>(pu_begin_status_strms, depth, ht_cfg);
 
 //---------------------------------dispatch PU-------------------------------
 #ifndef __SYNTHESIS__
@@ -1109,16 +1636,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU0------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 0], stat_strms[0],
 
             // input table
             hash_strm_arry[0], k1_strm_arry[0], p1_strm_arry[0], e1_strm_arry[0],
 
             // output for join
-            t_key_strm_arry[0], t_pld_strm_arry[0], nm_strm_arry[0], e2_strm_arry[0], s_base_key_strm_arry[0],
-            s_base_pld_strm_arry[0], s_overflow_key_strm_arry[0], s_overflow_pld_strm_arry[0],
+            t_key_strm_arry[0], t_pld_strm_arry[0], nm_strm_arry[0], addr_strm_arry[0], e2_strm_arry[0],
+            s_base_key_strm_arry[0], s_base_pld_strm_arry[0], s_overflow_key_strm_arry[0],
+            s_overflow_pld_strm_arry[0],
+
+            // small table for outer join
+            f_idx_strm_arry[0], f_key_strm_arry[0], f_pld_strm_arry[0], f_e_strm_arry[0],
 
             // HBM/DDR
             htb0_buf, stb0_buf);
@@ -1130,16 +1661,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU1------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 1], stat_strms[1],
 
             // input t-table
             hash_strm_arry[1], k1_strm_arry[1], p1_strm_arry[1], e1_strm_arry[1],
 
             // output for join
-            t_key_strm_arry[1], t_pld_strm_arry[1], nm_strm_arry[1], e2_strm_arry[1], s_base_key_strm_arry[1],
-            s_base_pld_strm_arry[1], s_overflow_key_strm_arry[1], s_overflow_pld_strm_arry[1],
+            t_key_strm_arry[1], t_pld_strm_arry[1], nm_strm_arry[1], addr_strm_arry[1], e2_strm_arry[1],
+            s_base_key_strm_arry[1], s_base_pld_strm_arry[1], s_overflow_key_strm_arry[1],
+            s_overflow_pld_strm_arry[1],
+
+            // small table for outer join
+            f_idx_strm_arry[1], f_key_strm_arry[1], f_pld_strm_arry[1], f_e_strm_arry[1],
 
             // HBM/DDR
             htb1_buf, stb1_buf);
@@ -1151,16 +1686,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU2------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 2], stat_strms[2],
 
             // input t-table
             hash_strm_arry[2], k1_strm_arry[2], p1_strm_arry[2], e1_strm_arry[2],
 
             // output for join
-            t_key_strm_arry[2], t_pld_strm_arry[2], nm_strm_arry[2], e2_strm_arry[2], s_base_key_strm_arry[2],
-            s_base_pld_strm_arry[2], s_overflow_key_strm_arry[2], s_overflow_pld_strm_arry[2],
+            t_key_strm_arry[2], t_pld_strm_arry[2], nm_strm_arry[2], addr_strm_arry[2], e2_strm_arry[2],
+            s_base_key_strm_arry[2], s_base_pld_strm_arry[2], s_overflow_key_strm_arry[2],
+            s_overflow_pld_strm_arry[2],
+
+            // small table for outer join
+            f_idx_strm_arry[2], f_key_strm_arry[2], f_pld_strm_arry[2], f_e_strm_arry[2],
 
             // HBM/DDR
             htb2_buf, stb2_buf);
@@ -1170,16 +1709,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU3------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 3], stat_strms[3],
 
             // input t-table
             hash_strm_arry[3], k1_strm_arry[3], p1_strm_arry[3], e1_strm_arry[3],
 
             // output for join
-            t_key_strm_arry[3], t_pld_strm_arry[3], nm_strm_arry[3], e2_strm_arry[3], s_base_key_strm_arry[3],
-            s_base_pld_strm_arry[3], s_overflow_key_strm_arry[3], s_overflow_pld_strm_arry[3],
+            t_key_strm_arry[3], t_pld_strm_arry[3], nm_strm_arry[3], addr_strm_arry[3], e2_strm_arry[3],
+            s_base_key_strm_arry[3], s_base_pld_strm_arry[3], s_overflow_key_strm_arry[3],
+            s_overflow_pld_strm_arry[3],
+
+            // small table for outer join
+            f_idx_strm_arry[3], f_key_strm_arry[3], f_pld_strm_arry[3], f_e_strm_arry[3],
 
             // HBM/DDR
             htb3_buf, stb3_buf);
@@ -1191,16 +1734,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU4------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 4], stat_strms[4],
 
             // input t-table
             hash_strm_arry[4], k1_strm_arry[4], p1_strm_arry[4], e1_strm_arry[4],
 
             // output for join
-            t_key_strm_arry[4], t_pld_strm_arry[4], nm_strm_arry[4], e2_strm_arry[4], s_base_key_strm_arry[4],
-            s_base_pld_strm_arry[4], s_overflow_key_strm_arry[4], s_overflow_pld_strm_arry[4],
+            t_key_strm_arry[4], t_pld_strm_arry[4], nm_strm_arry[4], addr_strm_arry[4], e2_strm_arry[4],
+            s_base_key_strm_arry[4], s_base_pld_strm_arry[4], s_overflow_key_strm_arry[4],
+            s_overflow_pld_strm_arry[4],
+
+            // small table for outer join
+            f_idx_strm_arry[4], f_key_strm_arry[4], f_pld_strm_arry[4], f_e_strm_arry[4],
 
             // HBM/DDR
             htb4_buf, stb4_buf);
@@ -1210,16 +1757,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU5------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 5], stat_strms[5],
 
             // input t-table
             hash_strm_arry[5], k1_strm_arry[5], p1_strm_arry[5], e1_strm_arry[5],
 
             // output for join
-            t_key_strm_arry[5], t_pld_strm_arry[5], nm_strm_arry[5], e2_strm_arry[5], s_base_key_strm_arry[5],
-            s_base_pld_strm_arry[5], s_overflow_key_strm_arry[5], s_overflow_pld_strm_arry[5],
+            t_key_strm_arry[5], t_pld_strm_arry[5], nm_strm_arry[5], addr_strm_arry[5], e2_strm_arry[5],
+            s_base_key_strm_arry[5], s_base_pld_strm_arry[5], s_overflow_key_strm_arry[5],
+            s_overflow_pld_strm_arry[5],
+
+            // small table for outer join
+            f_idx_strm_arry[5], f_key_strm_arry[5], f_pld_strm_arry[5], f_e_strm_arry[5],
 
             // HBM/DDR
             htb5_buf, stb5_buf);
@@ -1229,16 +1780,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU6------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 6], stat_strms[6],
 
             // input t-table
             hash_strm_arry[6], k1_strm_arry[6], p1_strm_arry[6], e1_strm_arry[6],
 
             // output for join
-            t_key_strm_arry[6], t_pld_strm_arry[6], nm_strm_arry[6], e2_strm_arry[6], s_base_key_strm_arry[6],
-            s_base_pld_strm_arry[6], s_overflow_key_strm_arry[6], s_overflow_pld_strm_arry[6],
+            t_key_strm_arry[6], t_pld_strm_arry[6], nm_strm_arry[6], addr_strm_arry[6], e2_strm_arry[6],
+            s_base_key_strm_arry[6], s_base_pld_strm_arry[6], s_overflow_key_strm_arry[6],
+            s_overflow_pld_strm_arry[6],
+
+            // small table for outer join
+            f_idx_strm_arry[6], f_key_strm_arry[6], f_pld_strm_arry[6], f_e_strm_arry[6],
 
             // HBM/DDR
             htb6_buf, stb6_buf);
@@ -1248,16 +1803,20 @@ void hashMultiJoin(
         std::cout << "------------------------PU7------------------------" << std::endl;
 #endif
 #endif
-        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::build_merge_multi_probe_wrapper<HASH_MODE, HASHWH, HASHWL, KEYW, S_PW, B_PW, ARW, EN_STAT>(
             // input status
-            depth,
+            depth, ht_cfg, join_flag_strms[8 + 7], stat_strms[7],
 
             // input t-table
             hash_strm_arry[7], k1_strm_arry[7], p1_strm_arry[7], e1_strm_arry[7],
 
             // output for join
-            t_key_strm_arry[7], t_pld_strm_arry[7], nm_strm_arry[7], e2_strm_arry[7], s_base_key_strm_arry[7],
-            s_base_pld_strm_arry[7], s_overflow_key_strm_arry[7], s_overflow_pld_strm_arry[7],
+            t_key_strm_arry[7], t_pld_strm_arry[7], nm_strm_arry[7], addr_strm_arry[7], e2_strm_arry[7],
+            s_base_key_strm_arry[7], s_base_pld_strm_arry[7], s_overflow_key_strm_arry[7],
+            s_overflow_pld_strm_arry[7],
+
+            // small table for outer join
+            f_idx_strm_arry[7], f_key_strm_arry[7], f_pld_strm_arry[7], f_e_strm_arry[7],
 
             // HBM/DDR
             htb7_buf, stb7_buf);
@@ -1266,13 +1825,14 @@ void hashMultiJoin(
     //-----------------------------------join--------------------------------------
     for (int i = 0; i < PU; i++) {
 #pragma HLS unroll
-        details::hash_multi_join::multi_join_unit<KEYW, S_PW, B_PW, ARW>(
+        details::hash_multi_join::multi_join_unit<HASHWL, KEYW, S_PW, B_PW, ARW>(
 #ifndef __SYNTHESIS__
             i,
 #endif
 
-            depth, join_flag_strms[i], t_key_strm_arry[i], t_pld_strm_arry[i], nm_strm_arry[i], e2_strm_arry[i],
-            s_base_key_strm_arry[i], s_base_pld_strm_arry[i], s_overflow_key_strm_arry[i], s_overflow_pld_strm_arry[i],
+            depth, join_flag_strms[i], t_key_strm_arry[i], t_pld_strm_arry[i], nm_strm_arry[i], addr_strm_arry[i],
+            e2_strm_arry[i], s_base_key_strm_arry[i], s_base_pld_strm_arry[i], s_overflow_key_strm_arry[i],
+            s_overflow_pld_strm_arry[i], f_idx_strm_arry[i], f_key_strm_arry[i], f_pld_strm_arry[i], f_e_strm_arry[i],
             j0_strm_arry[i], e3_strm_arry[i]);
     }
 
@@ -1280,7 +1840,7 @@ void hashMultiJoin(
     details::join_v3::sc::collect_unit<PU, KEYW + S_PW + B_PW>(j0_strm_arry, e3_strm_arry, join_num, j_strm, j_e_strm);
 
     //------------------------------Write Status-----------------------------------
-    details::join_v3::sc::write_status<PU>(pu_end_status_strms, depth, join_num);
+    details::hash_multi_join::write_status<PU, EN_STAT>(pu_end_status_strms, depth, join_num, stat_strms);
 
 } // hash_multi_join
 
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file str_key_map.hpp
+ * @brief mapping of variable-length string keys to fixed-width ids, template implementation.
+ *
+ * This file is part of Vitis Database Library.
+ */
+
+#ifndef XF_DATABASE_STR_KEY_MAP_H
+#define XF_DATABASE_STR_KEY_MAP_H
+
+#ifndef __cplusplus
+#error "Vitis Database Library only works with C++."
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+#include "xf_database/hash_lookup3.hpp"
+
+namespace xf {
+namespace database {
+namespace details {
+
+// hashes the length and then every word of a string, bytes beyond the length are cleared
+template <int MAX_WORD>
+void str_key_hash(hls::stream<ap_uint<64> >& str_strm,
+                  hls::stream<ap_uint<16> >& len_strm,
+                  hls::stream<bool>& e_strm,
+                  hls::stream<ap_uint<64> >& word_strm,
+                  hls::stream<ap_uint<16> >& o_len_strm,
+                  hls::stream<ap_uint<64> >& hash_strm,
+                  hls::stream<bool>& e_o_strm) {
+    bool e = e_strm.read();
+    while (!e) {
+        ap_uint<16> len = len_strm.read();
+        int nw = (len + 7) / 8;
+        ap_uint<64> h;
+        hashlookup3_seed_core<64>((ap_uint<64>)len, 0, h);
+    STR_KEY_HASH_LOOP:
+        for (int i = 0; i < nw; ++i) {
+#pragma HLS loop_tripcount min = 1 max = MAX_WORD avg = 4
+#pragma HLS pipeline
+            ap_uint<64> w = str_strm.read();
+            int tail = len - 8 * i;
+            if (tail < 8) w = w & (~ap_uint<64>(0) >> (64 - 8 * tail));
+            hashlookup3_seed_core<64>(w, h.range(31, 0) ^ h.range(63, 32), h);
+            word_strm.write(w);
+        }
+        o_len_strm.write(len);
+        hash_strm.write(h);
+        e_o_strm.write(false);
+        e = e_strm.read();
+    }
+    e_o_strm.write(true);
+}
+
+// linear probing of the hash table, compares full strings when the upper half of the hash matches
+template <int HTW, int MAX_WORD>
+void str_key_probe(bool insert,
+                   ap_uint<64>* htb,
+                   ap_uint<64>* body,
+                   ap_uint<32> body_depth,
+                   hls::stream<ap_uint<64> >& word_strm,
+                   hls::stream<ap_uint<16> >& len_strm,
+                   hls::stream<ap_uint<64> >& hash_strm,
+                   hls::stream<bool>& e_strm,
+                   hls::stream<ap_uint<32> >& id_strm,
+                   hls::stream<bool>& e_id_strm) {
+    ap_uint<64> key[MAX_WORD];
+    // next free word of body, kept in word 0 from one call to the next
+    ap_uint<32> top = body[0].range(31, 0);
+    if (top == 0) top = 1;
+#ifndef __SYNTHESIS__
+    int cnt = 0, long_cnt = 0, full_cnt = 0;
+#endif
+    bool e = e_strm.read();
+    while (!e) {
+        ap_uint<16> len = len_strm.read();
+        ap_uint<64> h = hash_strm.read();
+        int nw = (len + 7) / 8;
+    STR_KEY_READ_LOOP:
+        for (int i = 0; i < nw; ++i) {
+#pragma HLS loop_tripcount min = 1 max = MAX_WORD avg = 4
+#pragma HLS pipeline II = 1
+            ap_uint<64> w = word_strm.read();
+            if (i < MAX_WORD) key[i] = w;
+        }
+        // a prefix cannot tell long strings apart, so they get no id
+        bool too_long = nw > MAX_WORD;
+#ifndef __SYNTHESIS__
+        if (too_long) long_cnt++;
+#endif
+
+        ap_uint<32> tag = h.range(63, 32);
+        ap_uint<64> head = 0;
+        head.range(15, 0) = len;
+        head.range(63, 32) = tag;
+        ap_uint<HTW> slot = h.range(HTW - 1, 0);
+        ap_uint<32> id = 0;
+        bool done = too_long;
+        int p = 0;
+    STR_KEY_PROBE_LOOP:
+        while (!done && p < (1 << HTW)) {
+#pragma HLS loop_tripcount min = 1 max = 4 avg = 1
+            ap_uint<64> s = htb[slot];
+            ap_uint<32> off = s.range(31, 0);
+            if (off == 0) {
+                bool fit = top + 1 + nw <= body_depth;
+                if (insert && fit) {
+                    body[top] = head;
+                STR_KEY_STORE_LOOP:
+                    for (int i = 0; i < nw; ++i) {
+#pragma HLS loop_tripcount min = 1 max = MAX_WORD avg = 4
+#pragma HLS pipeline II = 1
+                        body[top + 1 + i] = key[i];
+                    }
+                    s.range(31, 0) = top;
+                    s.range(63, 32) = tag;
+                    htb[slot] = s;
+                    id = top;
+                    top += 1 + nw;
+                }
+#ifndef __SYNTHESIS__
+                if (insert && !fit) full_cnt++;
+#endif
+                done = true;
+            } else if (s.range(63, 32) == tag && body[off] == head) {
+                bool eq = true;
+            STR_KEY_CMP_LOOP:
+                for (int i = 0; i < nw; ++i) {
+#pragma HLS loop_tripcount min = 1 max = MAX_WORD avg = 4
+#pragma HLS pipeline II = 1
+                    if (body[off + 1 + i] != key[i]) eq = false;
+                }
+                if (eq) {
+                    id = off;
+                    done = true;
+                }
+            }
+            slot++;
+            p++;
+        }
+#ifndef __SYNTHESIS__
+        if (!done) full_cnt++;
+        cnt++;
+#endif
+        id_strm.write(id);
+        e_id_strm.write(false);
+        e = e_strm.read();
+    }
+    body[0] = top;
+    e_id_strm.write(true);
+#ifndef __SYNTHESIS__
+    std::cout << "strKeyMap: " << cnt << " keys, " << top << " body words used" << std::endl;
+    if (long_cnt)
+        std::cout << "WARNING: " << long_cnt << " keys longer than " << 8 * MAX_WORD << " bytes got id 0" << std::endl;
+    if (full_cnt) std::cout << "WARNING: hash table or body full, " << full_cnt << " keys got id 0" << std::endl;
+#endif
+}
+
+// pairs each id with the payload of its row and drops the rows with id 0
+template <int PW>
+void str_key_pld_filter(hls::stream<ap_uint<32> >& id_strm,
+                        hls::stream<bool>& e_id_strm,
+                        hls::stream<ap_uint<PW> >& pld_strm,
+                        hls::stream<ap_uint<32> >& key_strm,
+                        hls::stream<ap_uint<PW> >& o_pld_strm,
+                        hls::stream<bool>& e_o_strm) {
+    bool e = e_id_strm.read();
+STR_KEY_PLD_LOOP:
+    while (!e) {
+#pragma HLS pipeline II = 1
+        ap_uint<32> id = id_strm.read();
+        ap_uint<PW> pld = pld_strm.read();
+        if (id != 0) {
+            key_strm.write(id);
+            o_pld_strm.write(pld);
+            e_o_strm.write(false);
+        }
+        e = e_id_strm.read();
+    }
+    e_o_strm.write(true);
+}
+
+} // namespace details
+
+/**
+ * @brief Maps variable-length string keys to 32-bit ids, equal exactly when the strings are equal.
+ *
+ * This lets the hash join and group-by primitives, which take fixed-width keys, work on string keys such as
+ * SKUs or emails: map the build side and group-by keys with ``insert`` set, map the probe side without it and
+ * drop the rows with id 0, then join or group on the ids.
+ *
+ * Strings are hashed with lookup3 over their 64-bit words. The hash table and the string bodies live in device
+ * memory. Each slot holds the upper half of the hash and the offset of a body, and each body is one word with
+ * the length and the upper half of the hash, followed by the characters. On a collision of the upper half, the
+ * full string is compared, so different strings never share an id. The id of a string is the offset of its body.
+ * Strings longer than MAX_WORD words are not mapped and get id 0, as do new strings once the hash table or body
+ * is full.
+ *
+ * Before the first call, the hash table and the first word of body must be zeroed. Later calls with the same
+ * buffers see all strings inserted before, which is how the probe side is mapped after the build side.
+ *
+ * @tparam HTW log2 of the number of slots in hash table.
+ * @tparam MAX_WORD max number of 64-bit words in one string.
+ *
+ * @param insert true to add strings not found, false to give them id 0.
+ * @param str_strm characters of each string, 8 in one word with the first one in the lowest byte.
+ * @param len_strm byte length of each string.
+ * @param e_strm end flag of strings.
+ * @param htb hash table of (1 << HTW) 64-bit slots.
+ * @param body string bodies, word 0 keeps the next free word.
+ * @param body_depth number of 64-bit words in body.
+ * @param id_strm id of each string, 0 when not found without insert.
+ * @param e_id_strm end flag of ids.
+ */
+template <int HTW, int MAX_WORD>
+void strKeyMap(bool insert,
+               hls::stream<ap_uint<64> >& str_strm,
+               hls::stream<ap_uint<16> >& len_strm,
+               hls::stream<bool>& e_strm,
+               ap_uint<64>* htb,
+               ap_uint<64>* body,
+               ap_uint<32> body_depth,
+               hls::stream<ap_uint<32> >& id_strm,
+               hls::stream<bool>& e_id_strm) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<64> > word_strm;
+#pragma HLS stream variable = word_strm depth = MAX_WORD * 2
+    hls::stream<ap_uint<16> > h_len_strm;
+#pragma HLS stream variable = h_len_strm depth = 8
+    hls::stream<ap_uint<64> > hash_strm;
+#pragma HLS stream variable = hash_strm depth = 8
+    hls::stream<bool> e_h_strm;
+#pragma HLS stream variable = e_h_strm depth = 8
+
+    details::str_key_hash<MAX_WORD>(str_strm, len_strm, e_strm, word_strm, h_len_strm, hash_strm, e_h_strm);
+    details::str_key_probe<HTW, MAX_WORD>(insert, htb, body, body_depth, word_strm, h_len_strm, hash_strm, e_h_strm,
+                                          id_strm, e_id_strm);
+}
+
+/**
+ * @brief Maps the string key of each row like strKeyMap and passes its payload along, in the key, payload and
+ * end-flag streams the hash join and group-by primitives take.
+ *
+ * Rows whose string gets id 0 are dropped: with ``insert`` unset these are the probe rows without a match on the
+ * build side, which an inner join drops anyway. The build side is mapped with ``insert`` set, and runs into id 0
+ * only for strings longer than MAX_WORD words or when the buffers are full, see strKeyMap.
+ *
+ * @tparam HTW log2 of the number of slots in hash table.
+ * @tparam MAX_WORD max number of 64-bit words in one string.
+ * @tparam PW width of payload.
+ *
+ * @param insert true to add strings not found, false to drop their rows.
+ * @param str_strm characters of each string, 8 in one word with the first one in the lowest byte.
+ * @param len_strm byte length of each string.
+ * @param pld_strm payload of each row.
+ * @param e_strm end flag of rows.
+ * @param htb hash table of (1 << HTW) 64-bit slots.
+ * @param body string bodies, word 0 keeps the next free word.
+ * @param body_depth number of 64-bit words in body.
+ * @param key_strm id of the string of each row kept.
+ * @param o_pld_strm payload of each row kept.
+ * @param e_o_strm end flag of rows kept.
+ */
+template <int HTW, int MAX_WORD, int PW>
+void strKeyMapPld(bool insert,
+                  hls::stream<ap_uint<64> >& str_strm,
+                  hls::stream<ap_uint<16> >& len_strm,
+                  hls::stream<ap_uint<PW> >& pld_strm,
+                  hls::stream<bool>& e_strm,
+                  ap_uint<64>* htb,
+                  ap_uint<64>* body,
+                  ap_uint<32> body_depth,
+                  hls::stream<ap_uint<32> >& key_strm,
+                  hls::stream<ap_uint<PW> >& o_pld_strm,
+                  hls::stream<bool>& e_o_strm) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<64> > word_strm;
+#pragma HLS stream variable = word_strm depth = MAX_WORD * 2
+    hls::stream<ap_uint<16> > h_len_strm;
+#pragma HLS stream variable = h_len_strm depth = 8
+    hls::stream<ap_uint<64> > hash_strm;
+#pragma HLS stream variable = hash_strm depth = 8
+    hls::stream<bool> e_h_strm;
+#pragma HLS stream variable = e_h_strm depth = 8
+    hls::stream<ap_uint<32> > id_strm;
+#pragma HLS stream variable = id_strm depth = 8
+    hls::stream<bool> e_id_strm;
+#pragma HLS stream variable = e_id_strm depth = 8
+
+    details::str_key_hash<MAX_WORD>(str_strm, len_strm, e_strm, word_strm, h_len_strm, hash_strm, e_h_strm);
+    details::str_key_probe<HTW, MAX_WORD>(insert, htb, body, body_depth, word_strm, h_len_strm, hash_strm, e_h_strm,
+                                          id_strm, e_id_strm);
+    details::str_key_pld_filter<PW>(id_strm, e_id_strm, pld_strm, key_strm, o_pld_strm, e_o_strm);
+}
+
+} // namespace database
+} // namespace xf
+
+#endif // XF_DATABASE_STR_KEY_MAP_H
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file str_like.hpp
+ * @brief LIKE pattern matching of string columns, template implementation.
+ * This is an L1 primitive, the GQE kernels do not take string columns.
+ *
+ * This file is part of Vitis Database Library.
+ */
+
+#ifndef XF_DATABASE_STR_LIKE_H
+#define XF_DATABASE_STR_LIKE_H
+
+#ifndef __cplusplus
+#error "Vitis Database Library only works with C++."
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+#include "xf_database/scan_cmp_str_col.hpp"
+
+namespace xf {
+namespace database {
+
+/// @brief Static information of the config of strLike.
+template <int PAT_NM, int SEG_NM, int SEG_LEN>
+struct StrLikeInfo {
+    typedef ap_uint<32> cfg_type;
+    /// words of one segment, length, care mask and characters.
+    static const int seg_dwords = 2 + (SEG_LEN + 3) / 4;
+    /// words of the whole config.
+    static const int dwords_num = PAT_NM * (1 + SEG_NM * seg_dwords);
+};
+
+namespace details {
+
+// max characters of a string in heading-length and padding-zero format
+static const int STR_LIKE_MAX_LEN = 63;
+
+// character i of a string in heading-length and padding-zero format
+inline ap_uint<8> str_like_char(const ap_uint<512>& str, int i) {
+#pragma HLS inline
+    return str.range(503 - 8 * i, 496 - 8 * i);
+}
+
+// bit i set when the segment matches the string from character i on
+template <int SEG_LEN>
+ap_uint<STR_LIKE_MAX_LEN> str_like_seg_match(const ap_uint<512>& str,
+                                             ap_uint<8> slen,
+                                             ap_uint<8> seg[SEG_LEN],
+                                             ap_uint<SEG_LEN> care,
+                                             ap_uint<8> len) {
+#pragma HLS inline
+    ap_uint<STR_LIKE_MAX_LEN> m = 0;
+    for (int i = 0; i < STR_LIKE_MAX_LEN; ++i) {
+#pragma HLS unroll
+        bool ok = (i + len <= slen);
+        for (int j = 0; j < SEG_LEN; ++j) {
+#pragma HLS unroll
+            if (j < len && care[j]) {
+                ap_uint<8> c = (i + j < STR_LIKE_MAX_LEN) ? str_like_char(str, i + j) : (ap_uint<8>)0;
+                if (c != seg[j]) ok = false;
+            }
+        }
+        m[i] = ok;
+    }
+    return m;
+}
+
+// index of the first set bit not below pos, STR_LIKE_MAX_LEN when there is none
+inline int str_like_first(ap_uint<STR_LIKE_MAX_LEN> m, int pos) {
+#pragma HLS inline
+    int first = STR_LIKE_MAX_LEN;
+    for (int i = STR_LIKE_MAX_LEN - 1; i >= 0; --i) {
+#pragma HLS unroll
+        if (m[i] && i >= pos) first = i;
+    }
+    return first;
+}
+
+} // namespace details
+
+/**
+ * @brief Matches each string against multiple LIKE patterns, one string per cycle.
+ *
+ * A pattern is a list of segments separated by ``%``, where the first segment may be anchored at the start of
+ * the string and the last one at its end. Segments are matched leftmost-first in order, which is the semantic
+ * of ``%`` between them, and a character not cared in a segment stands for ``_``. So ``'PROMO%'`` is one segment
+ * anchored at start, ``'%BRASS'`` one anchored at end, ``'%green%'`` one not anchored and
+ * ``'%special%requests%'`` two not anchored.
+ *
+ * Bit p of the output bitmap tells whether the string matches pattern p, and can be fed to dynamicFilter
+ * as a condition column to be combined with other predicates.
+ *
+ * The config holds, for each pattern, one word with the start anchor in bit 0, end anchor in bit 1,
+ * inversion for ``NOT LIKE`` in bit 2 and number of segments in bits 15:8, followed by SEG_NM segments,
+ * each in one word of length, one word of care mask and the characters, 4 in a word with the first one in the
+ * lowest byte. See ``StrLikeInfo`` for the number of words.
+ *
+ * @tparam PAT_NM number of patterns.
+ * @tparam SEG_NM max number of segments in one pattern.
+ * @tparam SEG_LEN max number of characters in one segment, up to 32.
+ *
+ * @param cfg_strm config of patterns, read once.
+ * @param str_strm input strings in heading-length and padding-zero format.
+ * @param e_str_strm end flag of input strings.
+ * @param bmp_strm bitmap of matched patterns of each string.
+ * @param e_bmp_strm end flag of bitmaps.
+ */
+template <int PAT_NM, int SEG_NM, int SEG_LEN>
+void strLike(hls::stream<ap_uint<32> >& cfg_strm,
+             hls::stream<ap_uint<512> >& str_strm,
+             hls::stream<bool>& e_str_strm,
+             hls::stream<ap_uint<PAT_NM> >& bmp_strm,
+             hls::stream<bool>& e_bmp_strm) {
+    bool anchor_s[PAT_NM];
+    bool anchor_e[PAT_NM];
+    bool inv[PAT_NM];
+    ap_uint<8> seg_nm[PAT_NM];
+    ap_uint<8> len[PAT_NM][SEG_NM];
+    ap_uint<SEG_LEN> care[PAT_NM][SEG_NM];
+    ap_uint<8> seg[PAT_NM][SEG_NM][SEG_LEN];
+#pragma HLS array_partition variable = anchor_s complete
+#pragma HLS array_partition variable = anchor_e complete
+#pragma HLS array_partition variable = inv complete
+#pragma HLS array_partition variable = seg_nm complete
+#pragma HLS array_partition variable = len complete dim = 0
+#pragma HLS array_partition variable = care complete dim = 0
+#pragma HLS array_partition variable = seg complete dim = 0
+
+    for (int p = 0; p < PAT_NM; ++p) {
+        ap_uint<32> w = cfg_strm.read();
+        anchor_s[p] = w[0];
+        anchor_e[p] = w[1];
+        inv[p] = w[2];
+        seg_nm[p] = w.range(15, 8);
+        for (int k = 0; k < SEG_NM; ++k) {
+            len[p][k] = cfg_strm.read().range(7, 0);
+            care[p][k] = cfg_strm.read();
+            for (int j = 0; j < SEG_LEN; j += 4) {
+                ap_uint<32> c = cfg_strm.read();
+                for (int b = 0; b < 4; ++b) {
+                    if (j + b < SEG_LEN) seg[p][k][j + b] = c.range(8 * b + 7, 8 * b);
+                }
+            }
+        }
+    }
+
+    bool e = e_str_strm.read();
+STR_LIKE_LOOP:
+    while (!e) {
+#pragma HLS pipeline II = 1
+        ap_uint<512> str = str_strm.read();
+        ap_uint<8> slen = str.range(511, 504);
+        ap_uint<PAT_NM> bmp = 0;
+        for (int p = 0; p < PAT_NM; ++p) {
+#pragma HLS unroll
+            bool ok = true;
+            int pos = 0;
+            for (int k = 0; k < SEG_NM; ++k) {
+#pragma HLS unroll
+                if (k < seg_nm[p]) {
+                    ap_uint<details::STR_LIKE_MAX_LEN> m =
+                        details::str_like_seg_match<SEG_LEN>(str, slen, seg[p][k], care[p][k], len[p][k]);
+                    if (k == 0 && anchor_s[p]) {
+                        ok = ok && m[0];
+                        pos = len[p][k];
+                    } else if (k == seg_nm[p] - 1 && anchor_e[p]) {
+                        int st = slen - len[p][k];
+                        ok = ok && st >= pos && m[st < 0 ? 0 : st];
+                        pos = slen;
+                    } else {
+                        int first = details::str_like_first(m, pos);
+                        ok = ok && first < details::STR_LIKE_MAX_LEN;
+                        pos = first + len[p][k];
+                    }
+                }
+            }
+            // a pattern anchored at both ends must cover the whole string
+            if (anchor_e[p] && pos != slen) ok = false;
+            if (seg_nm[p] == 0 && !(anchor_s[p] && anchor_e[p])) ok = true;
+            bmp[p] = ok ^ inv[p];
+        }
+        bmp_strm.write(bmp);
+        e_bmp_strm.write(false);
+        e = e_str_strm.read();
+    }
+    e_bmp_strm.write(true);
+}
+
+/**
+ * @brief Scans a string column in global memory and matches each string against multiple LIKE patterns.
+ *
+ * @tparam PAT_NM number of patterns.
+ * @tparam SEG_NM max number of segments in one pattern.
+ * @tparam SEG_LEN max number of characters in one segment, up to 32.
+ *
+ * @param ddr_ptr input string array stored in global memory, in semi-pact format as ``scanCmpStrCol``.
+ * @param size the number of words to read from global memory.
+ * @param num_str the number of actual strings.
+ * @param cfg_strm config of patterns, see ``strLike``.
+ * @param bmp_strm bitmap of matched patterns of each string.
+ * @param e_bmp_strm end flag of bitmaps.
+ */
+template <int PAT_NM, int SEG_NM, int SEG_LEN>
+void scanStrLikeCol(ap_uint<512>* ddr_ptr,
+                    hls::stream<int>& size,
+                    hls::stream<int>& num_str,
+                    hls::stream<ap_uint<32> >& cfg_strm,
+                    hls::stream<ap_uint<PAT_NM> >& bmp_strm,
+                    hls::stream<bool>& e_bmp_strm) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<512> > stream_t1, stream_t2;
+#pragma HLS STREAM variable = stream_t1 depth = 8 dim = 1
+#pragma HLS STREAM variable = stream_t2 depth = 8 dim = 1
+
+    hls::stream<bool> stream_f1, stream_f2;
+#pragma HLS STREAM variable = stream_f1 depth = 8 dim = 1
+#pragma HLS STREAM variable = stream_f2 depth = 8 dim = 1
+
+    details::read_ddr(ddr_ptr, size, stream_t1, stream_f1);
+    details::padding_stream_out(stream_t1, stream_f1, num_str, stream_t2, stream_f2);
+    strLike<PAT_NM, SEG_NM, SEG_LEN>(cfg_strm, stream_t2, stream_f2, bmp_strm, e_bmp_strm);
+}
+
+} // namespace database
+} // namespace xf
+
+#endif // XF_DATABASE_STR_LIKE_H
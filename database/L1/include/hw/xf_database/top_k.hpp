@@ -0,0 +1,207 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file top_k.hpp
+ * @brief TOP-K template function implementation.
+ *
+ * This file is part of Vitis Database Library.
+ */
+
+#ifndef XF_DATABASE_TOP_K_H
+#define XF_DATABASE_TOP_K_H
+
+#ifndef __cplusplus
+#error "Vitis Database Library only works with C++."
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+#include "xf_database/enums.hpp"
+
+namespace xf {
+namespace database {
+namespace details {
+
+// maps the key columns to one unsigned word whose ascending order is the requested order:
+// column 0 is most significant, the sign bit is flipped, descending columns are inverted
+template <int KEYW, int KEY_NM>
+inline ap_uint<KEYW * KEY_NM> top_k_norm_key(ap_uint<KEYW> key[KEY_NM], ap_uint<KEY_NM> order) {
+#pragma HLS inline
+    ap_uint<KEYW* KEY_NM> nk;
+    for (int c = 0; c < KEY_NM; ++c) {
+#pragma HLS unroll
+        ap_uint<KEYW> v = key[c];
+        v[KEYW - 1] = !v[KEYW - 1];
+        if (order[c] == SORT_DESCENDING) v = ~v;
+        nk.range(KEYW * (KEY_NM - c) - 1, KEYW * (KEY_NM - c - 1)) = v;
+    }
+    return nk;
+}
+
+template <int KEYW, int KEY_NM>
+inline void top_k_denorm_key(ap_uint<KEYW * KEY_NM> nk, ap_uint<KEY_NM> order, ap_uint<KEYW> key[KEY_NM]) {
+#pragma HLS inline
+    for (int c = 0; c < KEY_NM; ++c) {
+#pragma HLS unroll
+        ap_uint<KEYW> v = nk.range(KEYW * (KEY_NM - c) - 1, KEYW * (KEY_NM - c - 1));
+        if (order[c] == SORT_DESCENDING) v = ~v;
+        v[KEYW - 1] = !v[KEYW - 1];
+        key[c] = v;
+    }
+}
+
+template <int KEYW, int KEY_NM, int PW, int MAX_K>
+void top_k_core(hls::stream<ap_uint<KEYW> > kin_strm[KEY_NM],
+                hls::stream<ap_uint<PW> >& pin_strm,
+                hls::stream<bool>& e_in_strm,
+                hls::stream<ap_uint<KEYW> > kout_strm[KEY_NM],
+                hls::stream<ap_uint<PW> >& pout_strm,
+                hls::stream<bool>& e_out_strm,
+                ap_uint<KEY_NM> order,
+                int k) {
+    // cell i holds the i-th best row seen so far, kept sorted ascending by normalized key
+    ap_uint<KEYW* KEY_NM> cell_key[MAX_K];
+#pragma HLS array_partition variable = cell_key complete
+    ap_uint<PW> cell_pld[MAX_K];
+#pragma HLS array_partition variable = cell_pld complete
+    bool cell_vld[MAX_K];
+#pragma HLS array_partition variable = cell_vld complete
+
+    for (int i = 0; i < MAX_K; ++i) {
+#pragma HLS unroll
+        cell_vld[i] = false;
+    }
+
+    bool e = e_in_strm.read();
+TOP_K_INSERT_LOOP:
+    while (!e) {
+#pragma HLS pipeline II = 1
+        ap_uint<KEYW> key[KEY_NM];
+#pragma HLS array_partition variable = key complete
+        for (int c = 0; c < KEY_NM; ++c) {
+#pragma HLS unroll
+            key[c] = kin_strm[c].read();
+        }
+        ap_uint<PW> pld = pin_strm.read();
+        e = e_in_strm.read();
+
+        ap_uint<KEYW* KEY_NM> nk = top_k_norm_key<KEYW, KEY_NM>(key, order);
+
+        // the new row goes before cell i, ties keep the earlier row first
+        bool before[MAX_K];
+#pragma HLS array_partition variable = before complete
+        for (int i = 0; i < MAX_K; ++i) {
+#pragma HLS unroll
+            before[i] = (i < k) && (!cell_vld[i] || nk < cell_key[i]);
+        }
+
+        // shift the cells behind the insert point by one, the cell at the insert point takes the new row
+        for (int i = MAX_K - 1; i > 0; --i) {
+#pragma HLS unroll
+            if (before[i - 1]) {
+                cell_key[i] = cell_key[i - 1];
+                cell_pld[i] = cell_pld[i - 1];
+                cell_vld[i] = cell_vld[i - 1] && (i < k);
+            } else if (before[i]) {
+                cell_key[i] = nk;
+                cell_pld[i] = pld;
+                cell_vld[i] = true;
+            }
+        }
+        if (before[0]) {
+            cell_key[0] = nk;
+            cell_pld[0] = pld;
+            cell_vld[0] = true;
+        }
+    }
+
+TOP_K_OUTPUT_LOOP:
+    for (int i = 0; i < MAX_K; ++i) {
+#pragma HLS pipeline II = 1
+        if (cell_vld[i]) {
+            ap_uint<KEYW> key[KEY_NM];
+#pragma HLS array_partition variable = key complete
+            top_k_denorm_key<KEYW, KEY_NM>(cell_key[i], order, key);
+            for (int c = 0; c < KEY_NM; ++c) {
+#pragma HLS unroll
+                kout_strm[c].write(key[c]);
+            }
+            pout_strm.write(cell_pld[i]);
+            e_out_strm.write(false);
+        }
+    }
+    e_out_strm.write(true);
+}
+
+} // namespace details
+} // namespace database
+} // namespace xf
+
+namespace xf {
+namespace database {
+
+/**
+ * @brief Streaming top-k, emits the first k rows of the input in the order of a multi-column key.
+ *
+ * Rows are inserted into a systolic array of MAX_K sorted cells at one row per cycle, every cell compares with the
+ * incoming key in parallel, the cells behind the insert point shift by one and the last one drops out. After the
+ * end of input the kept rows are emitted in order, so an ``ORDER BY ... LIMIT k`` costs MAX_K cells of storage
+ * regardless of the input size.
+ *
+ * Key columns are compared as signed integers, column 0 first. Rows with equal keys keep their input order.
+ *
+ * @tparam KEYW width of one key column, in bit.
+ * @tparam KEY_NM number of key columns.
+ * @tparam PW width of payload, in bit.
+ * @tparam MAX_K max number of rows kept.
+ *
+ * @param kin_strm input of key columns.
+ * @param pin_strm input of payload.
+ * @param e_in_strm end flag of input.
+ * @param kout_strm output of key columns, in order.
+ * @param pout_strm output of payload.
+ * @param e_out_strm end flag of output.
+ * @param order bit c is the order of key column c, ``SORT_ASCENDING`` or ``SORT_DESCENDING``.
+ * @param k number of rows to keep, no more than MAX_K.
+ */
+template <int KEYW, int KEY_NM, int PW, int MAX_K>
+void topK(hls::stream<ap_uint<KEYW> > kin_strm[KEY_NM],
+          hls::stream<ap_uint<PW> >& pin_strm,
+          hls::stream<bool>& e_in_strm,
+          hls::stream<ap_uint<KEYW> > kout_strm[KEY_NM],
+          hls::stream<ap_uint<PW> >& pout_strm,
+          hls::stream<bool>& e_out_strm,
+          ap_uint<KEY_NM> order,
+          int k) {
+#ifndef __SYNTHESIS__
+    if (k > MAX_K) {
+        std::cout << "WARNING: topK keeps at most " << MAX_K << " rows, " << k << " requested" << std::endl;
+    }
+#endif
+    details::top_k_core<KEYW, KEY_NM, PW, MAX_K>(kin_strm, pin_strm, e_in_strm, kout_strm, pout_strm, e_out_strm,
+                                                  order, k > MAX_K ? MAX_K : k);
+}
+
+} // namespace database
+} // namespace xf
+
+#endif // XF_DATABASE_TOP_K_H
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "xf_database/dynamic_eval.hpp"
+
+// DECIMAL(18,s) columns
+typedef ap_uint<64> stream_t;
+// wide enough for the product of two DECIMAL(18,s)
+typedef ap_int<128> stream_out_t;
+
+#define TestNumber 1000
+
+/// strm1*(constant2-strm2)
+#define OP_REVENUE 0x039200409
+/// strm1*strm2
+#define OP_MUL 0x039900409
+
+void dynamic_eval_decimal_dut(ap_uint<289> config,
+                              ap_uint<32> dec_cfg,
+                              hls::stream<stream_t>& strm_in1,
+                              hls::stream<stream_t>& strm_in2,
+                              hls::stream<stream_t>& strm_in3,
+                              hls::stream<stream_t>& strm_in4,
+                              hls::stream<bool>& strm_in_end,
+                              hls::stream<stream_out_t>& strm_out,
+                              hls::stream<bool>& strm_out_end) {
+    xf::database::dynamicEval<stream_t, stream_t, stream_t, stream_t, stream_out_t>(
+        config, dec_cfg, strm_in1, strm_in2, strm_in3, strm_in4, strm_in_end, strm_out, strm_out_end);
+}
+
+// money-like values with cents, about a third negative, some beyond 32 bits
+int64_t gen_value() {
+    int64_t v = (int64_t)(rand() % 1000000) * (rand() % 4 == 0 ? 100000 : 1);
+    return rand() % 3 == 0 ? -v : v;
+}
+
+// v * 10^e, or divided by 10^-e and by d, rounded half away from zero
+__int128 reference(__int128 v, int e, bool div, int64_t d) {
+    __int128 p = 1;
+    for (int i = 0; i < (e < 0 ? -e : e); i++) p *= 10;
+    __int128 num = e > 0 ? v * p : v;
+    __int128 den = e < 0 ? p : 1;
+    if (div) den *= d;
+    if (den == 0) return 0;
+    __int128 q = num / den;
+    __int128 r = num - q * den;
+    if (r < 0) r = -r;
+    if (r != 0 && 2 * r >= (den < 0 ? -den : den)) q += ((num < 0) != (den < 0)) ? -1 : 1;
+    return q;
+}
+
+int run(const char* name, ap_uint<33> op, int64_t c2, int e, bool div) {
+    hls::stream<stream_t> strm_in1, strm_in2, strm_in3, strm_in4;
+    hls::stream<bool> strm_in_end;
+    hls::stream<stream_out_t> strm_out;
+    hls::stream<bool> strm_out_end;
+
+    ap_uint<289> config = 0;
+    config(288, 256) = op;
+    config(191, 128) = (ap_uint<64>)c2;
+    ap_uint<32> dec_cfg = 0;
+    dec_cfg(7, 0) = (ap_uint<8>)e;
+    dec_cfg[8] = div;
+
+    std::vector<__int128> golden;
+    for (int i = 0; i < TestNumber; i++) {
+        int64_t a = gen_value();
+        int64_t b = op == OP_REVENUE ? rand() % 11 : gen_value();
+        int64_t d = i % 100 == 0 ? 0 : gen_value();
+        strm_in1.write((ap_int<64>)a);
+        strm_in2.write((ap_int<64>)b);
+        strm_in3.write(0);
+        strm_in4.write((ap_int<64>)d);
+        strm_in_end.write(false);
+        __int128 v = op == OP_REVENUE ? (__int128)a * (c2 - b) : (__int128)a * b;
+        golden.push_back(reference(v, e, div, d));
+    }
+    strm_in_end.write(true);
+
+    dynamic_eval_decimal_dut(config, dec_cfg, strm_in1, strm_in2, strm_in3, strm_in4, strm_in_end, strm_out,
+                             strm_out_end);
+
+    int nerror = 0;
+    for (int i = 0; i < TestNumber; i++) {
+        if (strm_out_end.read()) {
+            nerror++;
+            break;
+        }
+        stream_out_t r = strm_out.read();
+        ap_int<128> g = 0;
+        g(63, 0) = (uint64_t)golden[i];
+        g(127, 64) = (uint64_t)(golden[i] >> 64);
+        if (r != g) {
+            if (nerror < 10) std::cout << name << " row " << i << ": " << r << " should be " << g << std::endl;
+            nerror++;
+        }
+    }
+    if (!strm_out_end.read()) nerror++;
+    std::cout << name << ": " << nerror << " errors" << std::endl;
+    return nerror;
+}
+
+int main() {
+    srand(1);
+    int nerror = 0;
+    // l_extendedprice * (1 - l_discount), DECIMAL(18,2) * (1.00 - DECIMAL(18,2)) back to scale 2
+    nerror += run("revenue", OP_REVENUE, 100, -2, false);
+    // a * b / d, scale 2 * scale 0 / scale 2 to scale 2
+    nerror += run("divide", OP_MUL, 0, 2, true);
+    // a * b kept at scale 4 and at scale 6
+    nerror += run("keep", OP_MUL, 0, 0, false);
+    nerror += run("upscale", OP_MUL, 0, 2, false);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: all decimal results match." << std::endl;
+    }
+    return nerror;
+}
@@ -21,8 +21,8 @@ void read_status(ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH], hls::stream<ap_ui
     for (int i = 0; i < BUILD_CFG_DEPTH; i++) pu_begin_status_strms.write(hj_begin_status[i]);
 }
 
-void write_status(ap_uint<32> hj_end_status[BUILD_CFG_DEPTH], hls::stream<ap_uint<32> >& pu_end_status_strms) {
-    for (int i = 0; i < BUILD_CFG_DEPTH; i++) hj_end_status[i] = pu_end_status_strms.read();
+void write_status(ap_uint<32> hj_end_status[END_CFG_DEPTH], hls::stream<ap_uint<32> >& pu_end_status_strms) {
+    for (int i = 0; i < END_CFG_DEPTH; i++) hj_end_status[i] = pu_end_status_strms.read();
 }
 
 //--------------------------------------scan----------------------------------------
@@ -141,7 +141,7 @@ extern "C" void hjkernel(
 
     // output join result
     ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH], // status. DDR
-    ap_uint<32> hj_end_status[BUILD_CFG_DEPTH],   // status. DDR
+    ap_uint<32> hj_end_status[END_CFG_DEPTH],     // status. DDR
 
     ap_uint<512> j_res[J_MAX_DEPTH] // output. DDR
     ) {
@@ -226,9 +226,9 @@ extern "C" void hjkernel(
 
     // status
     hls::stream<ap_uint<32> > pu_begin_status_strms;
-#pragma HLS stream variable = pu_begin_status_strms depth = 8
+#pragma HLS stream variable = pu_begin_status_strms depth = 32
     hls::stream<ap_uint<32> > pu_end_status_strms;
-#pragma HLS stream variable = pu_end_status_strms depth = 8
+#pragma HLS stream variable = pu_end_status_strms depth = 32
 
     read_status(hj_begin_status, pu_begin_status_strms);
 
@@ -268,7 +268,8 @@ extern "C" void hjkernel(
                              VEC_LEN,     // channel number
                              BF_HASH_NUM, // hash number of bloom filter
                              BF_VEC_LEN,  // bloom filter hash width
-                             true>(
+                             true,        // enable bloom filter
+                             HOT_KEY_NM>( // number of hot keys
         // input
         k_strms, p_strms, e_strms,
 
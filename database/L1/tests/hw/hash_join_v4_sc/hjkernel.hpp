@@ -32,7 +32,17 @@
 #define NPU (1 << WPUHASH)
 #define PU_HT_DEPTH (30 << 10) // 30M is suggested in hardware
 #define PU_S_DEPTH (30 << 10)  // 30M is suggested in hardware
-#define BUILD_CFG_DEPTH (2)    // depth, join_number
+#ifndef HOT_KEY_NM
+#define HOT_KEY_NM 4 // hot keys spread over all PUs, 0 turns skew handling off
+#endif
+
+#if HOT_KEY_NM > 0
+#define BUILD_CFG_DEPTH (3 + HOT_KEY_NM * ((WKEY + 31) / 32)) // depth, join_number, hot key number, hot keys
+#define END_CFG_DEPTH (2 + 2 * NPU)                           // depth, join_number, build and probe rows per PU
+#else
+#define BUILD_CFG_DEPTH (2) // depth, join_number
+#define END_CFG_DEPTH (2)   // depth, join_number
+#endif
 
 #define S_MAX_DEPTH ((1 << 14) / 4) // 1M row / 4 row per vec is suggeted in hardware
 #define T_MAX_DEPTH ((1 << 14) / 4) // 1M row / 4 row per vec is suggested in hardware
@@ -67,7 +77,7 @@ extern "C" void hjkernel(
 
     // output join result
     ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH], // status. DDR
-    ap_uint<32> hj_end_status[BUILD_CFG_DEPTH],   // status. DDR
+    ap_uint<32> hj_end_status[END_CFG_DEPTH],     // status. DDR
     ap_uint<512> j_res[J_MAX_DEPTH]               // output. DDR
     );
 
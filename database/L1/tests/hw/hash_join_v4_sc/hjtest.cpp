@@ -66,15 +66,18 @@ void generate_data(
     hls::stream<ap_uint<WKEY> >& o_t_key_strm,
     hls::stream<ap_uint<WPAY> >& o_t_pld_strm,
     hls::stream<bool>& o_e1_strm) {
-    // generate s&t unit
+    // generate s&t unit, half of the t rows hit one of two hot keys taken from the first s rows
+    ap_uint<WKEY> hot_key[2];
     for (int i = 0; i < num; i++) {
         for (int j = 0; j < VEC_LEN; j++) {
             ap_uint<WKEY> key = rand();
             ap_uint<WPAY> s_pld = rand();
             ap_uint<WPAY> t_pld = rand();
+            if (i == 0 && j < 2) hot_key[j] = key;
+            ap_uint<WKEY> t_key = (i > 0 && j < 2) ? hot_key[(i + j) % 2] : key;
 
             ap_uint<WKEY + WPAY> srow = (key, s_pld);
-            ap_uint<WKEY + WPAY> trow = (key, t_pld);
+            ap_uint<WKEY + WPAY> trow = (t_key, t_pld);
 
             s_unit[i]((j + 1) * (WKEY + WPAY) - 1, j * (WKEY + WPAY)) = srow;
             t_unit[i]((j + 1) * (WKEY + WPAY) - 1, j * (WKEY + WPAY)) = trow;
@@ -207,11 +210,36 @@ int main() {
 
     // status
     ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH]; // status. DDR
-    ap_uint<32> hj_end_status[BUILD_CFG_DEPTH];   // status. DDR
+    ap_uint<32> hj_end_status[END_CFG_DEPTH];     // status. DDR
 
     hj_begin_status[0] = 4; // depth
     hj_begin_status[1] = 0; // join_number
 
+#if HOT_KEY_NM > 0
+    // find hot keys of t-table, a key is hot once it takes more than half of the rows one PU should see
+    hls::stream<ap_uint<WKEY> > d_key_strm;
+    hls::stream<ap_uint<WPAY> > d_pld_strm;
+    hls::stream<bool> d_e_strm;
+    hls::stream<ap_uint<WKEY> > hot_key_strm;
+    hls::stream<ap_uint<32> > hot_cnt_strm;
+    hls::stream<bool> hot_e_strm;
+
+    scan(t_unit, nrow, d_key_strm, d_pld_strm, d_e_strm);
+    xf::database::hotKeyDetect<WKEY, HOT_KEY_NM, 10>(d_key_strm, d_e_strm, nrow * VEC_LEN / PU_NM / 2, hot_key_strm,
+                                                     hot_cnt_strm, hot_e_strm);
+
+    const int kw = (WKEY + 31) / 32;
+    int hot_nm = 0;
+    for (int i = 3; i < BUILD_CFG_DEPTH; i++) hj_begin_status[i] = 0;
+    while (!hot_e_strm.read()) {
+        ap_uint<WKEY> key = hot_key_strm.read();
+        std::cout << std::hex << "hot key " << key << std::dec << " count " << hot_cnt_strm.read() << std::endl;
+        for (int w = 0; w < kw; w++) hj_begin_status[3 + hot_nm * kw + w] = key(32 * w + 31, 32 * w);
+        hot_nm++;
+    }
+    hj_begin_status[2] = hot_nm; // hot key number
+#endif
+
     // call build
     std::cout << "------------------------kernel start--------------------------" << std::endl;
 
@@ -244,6 +272,24 @@ int main() {
         // join result
         hj_begin_status, hj_end_status, j_res0);
 
+    int nerror = 0;
+#if HOT_KEY_NM > 0
+    // build and probe rows of each PU, half of the probe rows hit two keys so hash dispatch alone would give
+    // two PUs at least twice their share
+    unsigned probe_sum = 0, probe_max = 0;
+    for (int i = 0; i < PU_NM; i++) {
+        unsigned probe = hj_end_status[2 + PU_NM + i];
+        std::cout << std::dec << "PU" << i << ": build " << hj_end_status[2 + i] << " probe " << probe << std::endl;
+        probe_sum += probe;
+        probe_max = std::max(probe_max, probe);
+    }
+    if (probe_sum != nrow * VEC_LEN || 2 * probe_max * PU_NM > 3 * probe_sum) {
+        std::cout << "ERROR: probe rows " << probe_sum << " of " << nrow * VEC_LEN << ", busiest PU " << probe_max
+                  << ", hot keys are not spread" << std::endl;
+        nerror++;
+    }
+#endif
+
     // generate golden data
     hls::stream<ap_uint<WKEY + 2 * WPAY> > j_strm;
     hls::stream<bool> j_e_strm;
@@ -251,8 +297,7 @@ int main() {
     hash_join_golden<nrow>(s_key_strm, s_pld_strm, s_e_strm, t_key_strm, t_pld_strm, t_e_strm, j_strm, j_e_strm);
 
     // check
-    int nerror;
-    nerror = check_data<nrow>(j_strm, j_e_strm, j_res0);
+    nerror += check_data<nrow>(j_strm, j_e_strm, j_res0);
 
     for (int i = 0; i < PU_NM; i++) {
         free(pu_ht[i]);
@@ -269,5 +314,5 @@ int main() {
     } else {
         std::cout << "\nPASS: no error found.\n";
     }
-    return 0;
+    return nerror;
 }
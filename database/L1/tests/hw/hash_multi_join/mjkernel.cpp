@@ -22,8 +22,8 @@ void read_status(ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH], hls::stream<ap_ui
     for (int i = 0; i < BUILD_CFG_DEPTH; i++) pu_begin_status_strms.write(hj_begin_status[i]);
 }
 
-void write_status(ap_uint<32> hj_end_status[BUILD_CFG_DEPTH], hls::stream<ap_uint<32> >& pu_end_status_strms) {
-    for (int i = 0; i < BUILD_CFG_DEPTH; i++) hj_end_status[i] = pu_end_status_strms.read();
+void write_status(ap_uint<32> hj_end_status[END_STATUS_DEPTH], hls::stream<ap_uint<32> >& pu_end_status_strms) {
+    for (int i = 0; i < END_STATUS_DEPTH; i++) hj_end_status[i] = pu_end_status_strms.read();
 }
 
 //--------------------------------------scan----------------------------------------
@@ -148,7 +148,7 @@ extern "C" void mjkernel(
 
     // output join result
     ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH], // status. DDR
-    ap_uint<32> hj_end_status[BUILD_CFG_DEPTH],   // status. DDR
+    ap_uint<32> hj_end_status[END_STATUS_DEPTH],  // status. DDR
 
     ap_uint<512> j_res[J_MAX_DEPTH] // output. DDR
     ) {
@@ -275,7 +275,8 @@ extern "C" void mjkernel(
                                 WPUHASH, // PU number=1<<WPUHASH
                                 WHASH,   // width of lower hash value
                                 24,      // addr width
-                                VEC_LEN  // channel number
+                                VEC_LEN, // channel number
+                                true     // hash table stats in end status
                                 >(
         // input
         join_flag_strm, k_strms, p_strms, e_strms,
@@ -33,7 +33,8 @@
 #define N_S_MAX (128)          // 16MB per unit, 2MB per PU, 256MB HBM / 2MB
 #define PU_HT_DEPTH (30 << 10) // 30M
 #define PU_S_DEPTH (30 << 10)  // 30M
-#define BUILD_CFG_DEPTH (2)    // depth, join_number
+#define BUILD_CFG_DEPTH (2)    // depth, hash table config
+#define END_STATUS_DEPTH (4)   // depth, join_number, overflow rows, longest chain
 
 #define S_MAX_DEPTH ((1 << 14) / 4) // 1M row / 4 row per vec
 #define T_MAX_DEPTH ((1 << 14) / 4) // 1M row / 4 row per vec
@@ -69,7 +70,7 @@ extern "C" void mjkernel(
 
     // output join result
     ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH], // status. DDR
-    ap_uint<32> hj_end_status[BUILD_CFG_DEPTH],   // status. DDR
+    ap_uint<32> hj_end_status[END_STATUS_DEPTH],  // status. DDR
     ap_uint<512> j_res[J_MAX_DEPTH]               // output. DDR
     );
 
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <algorithm>
+#include <map>
 
 #include "hls_stream.h"
 
@@ -30,6 +31,14 @@
 #define TEST_LENGTH_S 100
 #define TEST_LENGTH_T 100
 #define ANTI_RATE 0.9
+// hash table saved by the first call for the second, probe-only one, in 128-bit lines of each htb buffer
+#define HT_SAVE_ADDR (PU_HT_DEPTH / 2 - 1024)
+// save address right after the first overflow row, refused by a PU with more overflow rows
+#define HT_LOW_SAVE_ADDR ((WKEY + WPAY) / 128)
+// JT_INNER, JT_SEMI, JT_ANTI, JT_LEFT, JT_RIGHT or JT_FULL
+#ifndef TEST_JOIN_TYPE
+#define TEST_JOIN_TYPE JT_INNER
+#endif
 #ifndef __SYNTHESIS__
 //--------------------------------scan-----------------------------------
 static void scan(ap_uint<(WKEY + WPAY) * VEC_LEN> unit[T_MAX_DEPTH],
@@ -119,8 +128,14 @@ void hash_join_golden(xf::database::enums::JoinType join_flag,
 
     ap_uint<WKEY + WPAY> row_temp;
     ap_uint<WKEY + WPAY> srow_table[test_num * VEC_LEN];
+    bool smatch_table[test_num * VEC_LEN] = {0};
     ap_uint<WKEY + 2 * WPAY> j_temp;
 
+    bool inner = join_flag == xf::database::enums::JT_INNER || join_flag == xf::database::enums::JT_LEFT ||
+                 join_flag == xf::database::enums::JT_RIGHT || join_flag == xf::database::enums::JT_FULL;
+    bool t_outer = join_flag == xf::database::enums::JT_LEFT || join_flag == xf::database::enums::JT_FULL;
+    bool s_outer = join_flag == xf::database::enums::JT_RIGHT || join_flag == xf::database::enums::JT_FULL;
+
     // generate s-table
     slast = i_e0_strm.read();
     while (!slast) {
@@ -143,7 +158,8 @@ void hash_join_golden(xf::database::enums::JoinType join_flag,
             ap_uint<WPAY> s_pld = srow_table[i](WPAY - 1, 0);
 
             if (s_key == t_key) {
-                if (join_flag == xf::database::enums::JT_INNER) {
+                smatch_table[i] = 1;
+                if (inner) {
                     j_temp(WKEY + 2 * WPAY - 1, 2 * WPAY) = t_key;
                     j_temp(2 * WPAY - 1, WPAY) = s_pld;
                     j_temp(WPAY - 1, 0) = t_pld;
@@ -164,7 +180,7 @@ void hash_join_golden(xf::database::enums::JoinType join_flag,
                 flag = 1;
             }
         }
-        if (join_flag == xf::database::enums::JT_ANTI) {
+        if (join_flag == xf::database::enums::JT_ANTI || t_outer) {
             if (flag == 0) {
                 j_temp(WKEY + 2 * WPAY - 1, 2 * WPAY) = t_key;
                 j_temp(2 * WPAY - 1, WPAY) = 0;
@@ -176,6 +192,16 @@ void hash_join_golden(xf::database::enums::JoinType join_flag,
             }
         }
     }
+    for (int i = 0; s_outer && i < cnt; i++) {
+        if (!smatch_table[i]) {
+            j_temp(WKEY + 2 * WPAY - 1, WPAY) = srow_table[i];
+            j_temp(WPAY - 1, 0) = 0;
+            std::cout << std::hex << "Golden Data:" << j_temp << std::dec << " " << ++datacount << std::endl;
+
+            o_j_strm.write(j_temp);
+            o_e_strm.write(false);
+        }
+    }
     o_e_strm.write(true);
 }
 
@@ -185,9 +211,10 @@ int check_data(xf::database::enums::JoinType join_type,
                hls::stream<ap_uint<WKEY + 2 * WPAY> >& o_j_strm,
                hls::stream<bool>& o_e_strm,
 
-               ap_uint<512> j_res[J_MAX_DEPTH]) {
-    int nerror;
-    int error;
+               ap_uint<512> j_res[J_MAX_DEPTH],
+               int j_nm) {
+    int nerror = 0;
+    int error = 0;
     ap_uint<512> j_temp;
     int datacount = 0;
     bool last = o_e_strm.read();
@@ -204,6 +231,8 @@ int check_data(xf::database::enums::JoinType join_type,
                     std::cout << std::hex << "Anti-Join:" << j_res[i] << " " << std::dec << ++datacount << std::endl;
                 if (join_type == xf::database::enums::JT_SEMI)
                     std::cout << std::hex << "Semi-Join:" << j_res[i] << " " << std::dec << ++datacount << std::endl;
+                if (join_type >= xf::database::enums::JT_LEFT)
+                    std::cout << std::hex << "Outer-Join:" << j_res[i] << " " << std::dec << ++datacount << std::endl;
                 break;
             } else {
                 error = 1;
@@ -213,7 +242,11 @@ int check_data(xf::database::enums::JoinType join_type,
 
         if (error) std::cout << std::hex << "Unit Not Found: " << j_temp << std::endl;
     }
-    return error;
+    if (datacount != j_nm) {
+        std::cout << std::dec << "Golden has " << datacount << " rows, kernel joined " << j_nm << std::endl;
+        nerror++;
+    }
+    return nerror;
 }
 
 int main() {
@@ -235,7 +268,7 @@ int main() {
     hls::stream<ap_uint<WPAY> > t_pld_strm;
     hls::stream<bool> t_e_strm;
 
-    xf::database::enums::JoinType join_type = xf::database::enums::JT_INNER;
+    xf::database::enums::JoinType join_type = xf::database::enums::TEST_JOIN_TYPE;
 
     generate_data(s_unit, t_unit, nrow_s, nrow_t, s_key_strm, s_pld_strm, s_e_strm, t_key_strm, t_pld_strm, t_e_strm);
 
@@ -253,10 +286,10 @@ int main() {
 
     // status
     ap_uint<32> hj_begin_status[BUILD_CFG_DEPTH]; // status. DDR
-    ap_uint<32> hj_end_status[BUILD_CFG_DEPTH];   // status. DDR
+    ap_uint<32> hj_end_status[END_STATUS_DEPTH];  // status. DDR
 
-    hj_begin_status[0] = 4; // depth
-    hj_begin_status[1] = 0; // join_number
+    hj_begin_status[0] = 4;                        // depth
+    hj_begin_status[1] = HT_SAVE_ADDR; // save hash table
 
     // call build
     std::cout << "------------------------kernel start--------------------------" << std::endl;
@@ -300,7 +333,61 @@ int main() {
 
     // check
     int nerror;
-    nerror = check_data<nrow_s>(join_type, j_strm, j_e_strm, j_res0);
+    nerror = check_data<nrow_s>(join_type, j_strm, j_e_strm, j_res0, hj_end_status[1]);
+
+    // rows of one key share a chain, so stats are at least what key multiplicities give
+    std::map<uint64_t, int> key_cnt;
+    for (int i = 0; i < nrow_s; i++) {
+        for (int j = 0; j < VEC_LEN; j++) key_cnt[s_unit[i]((j + 1) * (WKEY + WPAY) - 1, j * (WKEY + WPAY) + WPAY)]++;
+    }
+    int min_overflow = 0, min_chain = 0;
+    for (std::map<uint64_t, int>::iterator it = key_cnt.begin(); it != key_cnt.end(); ++it) {
+        if (it->second > (int)hj_begin_status[0]) min_overflow += it->second - hj_begin_status[0];
+        min_chain = std::max(min_chain, it->second);
+    }
+    ap_uint<32> overflow = hj_end_status[2];
+    ap_uint<32> max_chain = hj_end_status[3];
+    std::cout << std::dec << "overflow rows " << overflow << ", longest chain " << max_chain << std::endl;
+    if (overflow < min_overflow || max_chain < min_chain) {
+        std::cout << "Stats below " << min_overflow << " overflow rows and chain of " << min_chain << std::endl;
+        nerror++;
+    }
+
+    // probe again without the small table, reusing the saved hash table
+    std::cout << "------------------------probe-only start----------------------" << std::endl;
+    hj_begin_status[1] = (1U << 31) | HT_SAVE_ADDR;
+    mjkernel((uint32_t)join_type, 0, s_unit, nrow_t, t_unit, pu_ht[0], pu_ht[1], pu_ht[2], pu_ht[3], pu_ht[4],
+             pu_ht[5], pu_ht[6], pu_ht[7], pu_s[0], pu_s[1], pu_s[2], pu_s[3], pu_s[4], pu_s[5], pu_s[6], pu_s[7],
+             hj_begin_status, hj_end_status, j_res0);
+
+    scan(s_unit, nrow_s, s_key_strm, s_pld_strm, s_e_strm);
+    scan(t_unit, nrow_t, t_key_strm, t_pld_strm, t_e_strm);
+    hash_join_golden<nrow_s>(join_type, s_key_strm, s_pld_strm, s_e_strm, t_key_strm, t_pld_strm, t_e_strm, j_strm,
+                             j_e_strm);
+    nerror += check_data<nrow_s>(join_type, j_strm, j_e_strm, j_res0, hj_end_status[1]);
+    if (hj_end_status[2] != overflow || hj_end_status[3] != max_chain) {
+        std::cout << "Stats of reloaded hash table differ" << std::endl;
+        nerror++;
+    }
+
+    // build again with the save address inside the overflow rows, which must be left as they are
+    std::cout << "------------------------low save address----------------------" << std::endl;
+    hj_begin_status[1] = HT_LOW_SAVE_ADDR;
+    mjkernel((uint32_t)join_type, nrow_s, s_unit, nrow_t, t_unit, pu_ht[0], pu_ht[1], pu_ht[2], pu_ht[3], pu_ht[4],
+             pu_ht[5], pu_ht[6], pu_ht[7], pu_s[0], pu_s[1], pu_s[2], pu_s[3], pu_s[4], pu_s[5], pu_s[6], pu_s[7],
+             hj_begin_status, hj_end_status, j_res0);
+
+    scan(s_unit, nrow_s, s_key_strm, s_pld_strm, s_e_strm);
+    scan(t_unit, nrow_t, t_key_strm, t_pld_strm, t_e_strm);
+    hash_join_golden<nrow_s>(join_type, s_key_strm, s_pld_strm, s_e_strm, t_key_strm, t_pld_strm, t_e_strm, j_strm,
+                             j_e_strm);
+    ap_uint<32> join_num = hj_end_status[1];
+    if (!join_num[30]) {
+        std::cout << "Hash table saved over " << overflow << " overflow rows" << std::endl;
+        nerror++;
+    }
+    join_num[30] = 0;
+    nerror += check_data<nrow_s>(join_type, j_strm, j_e_strm, j_res0, join_num);
 
     for (int i = 0; i < PU_NM; i++) {
         free(pu_ht[i]);
@@ -317,6 +404,6 @@ int main() {
     } else {
         std::cout << "\nPASS: no error found.\n";
     }
-    return 0;
+    return nerror;
 }
 #endif
@@ -0,0 +1,58 @@
+#
+# Copyright 2019 Xilinx, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+source settings.tcl
+
+set PROJ "multijoin_outer"
+set SOLN "solution_OCL_REGION_0"
+set CLKP 300MHz
+
+# kernel and test of hash_multi_join, run once per build side outer join type
+set SRC_DIR "${XF_PROJ_ROOT}/L1/tests/hw/hash_multi_join"
+
+foreach JOIN_TYPE {JT_RIGHT JT_FULL} {
+  open_project -reset "${PROJ}_${JOIN_TYPE}.prj"
+  config_debug
+
+  add_files ${SRC_DIR}/mjkernel.cpp -cflags "-I${XF_PROJ_ROOT}/L1/include/hw -I${SRC_DIR}"
+  add_files -tb ${SRC_DIR}/mjtest.cpp -cflags "-I${XF_PROJ_ROOT}/L1/include/hw -I${SRC_DIR} -DTEST_JOIN_TYPE=${JOIN_TYPE}"
+  set_top mjkernel
+
+  open_solution -reset $SOLN
+
+  set_part $XPART
+  create_clock -period $CLKP -name default
+  config_rtl -register_reset
+  config_rtl -stall_sig_gen
+  config_interface -m_axi_addr64
+  config_compile -name_max_length 256
+
+  if {$CSIM == 1} {
+    csim_design
+  }
+
+  if {$CSYNTH == 1} {
+    csynth_design
+  }
+
+  if {$COSIM == 1} {
+    cosim_design
+  }
+
+  close_project
+}
+
+exit
@@ -0,0 +1,331 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xf_database/str_key_map.hpp"
+#include "xf_database/direct_group_aggregate.hpp"
+#include "xf_database/hash_join_v2.hpp"
+
+#define HTW 10
+#define MAX_WORD 8
+#define BODY_DEPTH (1 << 14)
+
+#define DistinctNumber 700
+#define BuildNumber 2000
+#define ProbeNumber 2000
+#define LongNumber 20
+
+// ids are body offsets below BODY_DEPTH, so group-by can address them directly
+#define DIRECTW 14
+// hash join of the ids, as in the hash_join_v2 test
+#define HJ_HW_P 3
+#define HJ_HW_J 10
+#define HJ_AW 19
+#define HJ_CH_NM 4
+#define HJ_DEPTH (1 << 20)
+
+void str_key_map_dut(bool insert,
+                     hls::stream<ap_uint<64> >& str_strm,
+                     hls::stream<ap_uint<16> >& len_strm,
+                     hls::stream<bool>& e_strm,
+                     ap_uint<64> htb[1 << HTW],
+                     ap_uint<64> body[BODY_DEPTH],
+                     hls::stream<ap_uint<32> >& id_strm,
+                     hls::stream<bool>& e_id_strm) {
+// clang-format off
+#pragma HLS INTERFACE m_axi port = htb bundle = gmem0 depth = 1024 \
+    num_write_outstanding = 16 num_read_outstanding = 16 max_read_burst_length = 8 latency = 64
+#pragma HLS INTERFACE m_axi port = body bundle = gmem1 depth = 16384 \
+    num_write_outstanding = 16 num_read_outstanding = 16 max_read_burst_length = 8 latency = 64
+    // clang-format on
+    xf::database::strKeyMap<HTW, MAX_WORD>(insert, str_strm, len_strm, e_strm, htb, body, BODY_DEPTH, id_strm,
+                                           e_id_strm);
+}
+
+// random strings of 0 to 40 characters from a small alphabet, so short ones repeat
+std::string gen_str() {
+    int len = rand() % 41;
+    std::string s;
+    for (int i = 0; i < len; i++) s.push_back('a' + rand() % 4);
+    return s;
+}
+
+void feed(const std::vector<std::string>& keys,
+          hls::stream<ap_uint<64> >& str_strm,
+          hls::stream<ap_uint<16> >& len_strm,
+          hls::stream<bool>& e_strm) {
+    for (size_t k = 0; k < keys.size(); k++) {
+        const std::string& s = keys[k];
+        for (size_t i = 0; i < s.size(); i += 8) {
+            uint64_t w = 0;
+            memcpy(&w, s.data() + i, s.size() - i < 8 ? s.size() - i : 8);
+            // garbage beyond the end of string must not matter
+            if (s.size() - i < 8) w |= 0xcc00000000000000ULL;
+            str_strm.write(w);
+        }
+        len_strm.write(s.size());
+        e_strm.write(false);
+    }
+    e_strm.write(true);
+}
+
+// maps the keys of rows with payload pld, ids and payloads of the rows kept are appended to k_strm and p_strm
+void map_rows(bool insert,
+              const std::vector<std::string>& keys,
+              const std::vector<unsigned>& pld,
+              ap_uint<64>* htb,
+              ap_uint<64>* body,
+              hls::stream<ap_uint<32> >& k_strm,
+              hls::stream<ap_uint<32> >& p_strm,
+              hls::stream<bool>& e_strm) {
+    hls::stream<ap_uint<64> > str_strm;
+    hls::stream<ap_uint<16> > len_strm;
+    hls::stream<ap_uint<32> > pld_strm;
+    hls::stream<bool> e_in_strm;
+    feed(keys, str_strm, len_strm, e_in_strm);
+    for (size_t i = 0; i < pld.size(); i++) pld_strm.write(pld[i]);
+    xf::database::strKeyMapPld<HTW, MAX_WORD, 32>(insert, str_strm, len_strm, pld_strm, e_in_strm, htb, body,
+                                                  BODY_DEPTH, k_strm, p_strm, e_strm);
+}
+
+// SUM(pld) GROUP BY key and an inner join on key, both run on the ids, checked against the strings
+int check_ops(const std::vector<std::string>& pool) {
+    static ap_uint<64> htb[1 << HTW];
+    static ap_uint<64> body[BODY_DEPTH];
+    for (int i = 0; i < (1 << HTW); i++) htb[i] = 0;
+    body[0] = 0;
+    int nerror = 0;
+
+    std::vector<std::string> build, probe;
+    std::vector<unsigned> build_pld, probe_pld;
+    for (int i = 0; i < BuildNumber; i++) {
+        build.push_back(pool[rand() % (DistinctNumber / 2)]);
+        build_pld.push_back(rand() % 1000);
+    }
+    for (int i = 0; i < ProbeNumber; i++) {
+        probe.push_back(pool[rand() % DistinctNumber]);
+        probe_pld.push_back(rand() % 1000);
+    }
+
+    // group-by
+    hls::stream<ap_uint<32> > k_strm, p_strm;
+    hls::stream<bool> e_strm;
+    map_rows(true, build, build_pld, htb, body, k_strm, p_strm, e_strm);
+    hls::stream<ap_uint<DIRECTW> > gk_strm, gk_out_strm;
+    hls::stream<ap_uint<64> > sum_strm;
+    hls::stream<bool> e_sum_strm;
+    // every build row is kept, so row i has the i-th id
+    std::map<std::string, unsigned> str_id;
+    for (int i = 0; !k_strm.empty(); i++) {
+        ap_uint<32> id = k_strm.read();
+        if (str_id.count(build[i]) && str_id[build[i]] != id) nerror++;
+        str_id[build[i]] = id;
+        gk_strm.write(id);
+    }
+    xf::database::directGroupAggregate<xf::database::AOP_SUM, 32, 64, DIRECTW>(p_strm, e_strm, sum_strm, e_sum_strm,
+                                                                               gk_strm, gk_out_strm);
+    std::map<unsigned, long long> golden_sum;
+    for (int i = 0; i < BuildNumber; i++) golden_sum[str_id[build[i]]] += build_pld[i];
+    std::map<unsigned, long long> got_sum;
+    while (!e_sum_strm.read()) {
+        unsigned id = gk_out_strm.read();
+        got_sum[id] = sum_strm.read();
+    }
+    if (got_sum != golden_sum || str_id.size() != golden_sum.size()) {
+        std::cout << "group-by on ids: " << got_sum.size() << " groups, " << golden_sum.size() << " expected"
+                  << std::endl;
+        nerror++;
+    }
+
+    // join, the build side is read twice and the probe rows without a match are dropped by strKeyMapPld
+    hls::stream<ap_uint<32> > jk_strm[HJ_CH_NM], jp_strm[HJ_CH_NM];
+    hls::stream<bool> je_strm[HJ_CH_NM];
+    for (int r = 0; r < 3; r++) {
+        map_rows(r < 2, r < 2 ? build : probe, r < 2 ? build_pld : probe_pld, htb, body, k_strm, p_strm, e_strm);
+        for (int i = 0; !e_strm.read(); i++) {
+            jk_strm[i % HJ_CH_NM].write(k_strm.read());
+            jp_strm[i % HJ_CH_NM].write(p_strm.read());
+            je_strm[i % HJ_CH_NM].write(false);
+        }
+        for (int ch = 0; ch < HJ_CH_NM; ch++) je_strm[ch].write(true);
+    }
+    std::vector<ap_uint<64>*> ht(1 << HJ_HW_P);
+    for (size_t i = 0; i < ht.size(); i++) ht[i] = (ap_uint<64>*)malloc(sizeof(ap_uint<64>) * HJ_DEPTH);
+    hls::stream<ap_uint<64> > j_strm;
+    hls::stream<bool> e_j_strm;
+    xf::database::hashJoinMPU<1, 32, 32, 32, 32, HJ_HW_P, HJ_HW_J, HJ_AW, 64, HJ_CH_NM, 24, 0>(
+        jk_strm, jp_strm, je_strm, ht[0], ht[1], ht[2], ht[3], ht[4], ht[5], ht[6], ht[7], j_strm, e_j_strm);
+    for (size_t i = 0; i < ht.size(); i++) free(ht[i]);
+    long long cnt = 0, sum = 0;
+    while (!e_j_strm.read()) {
+        ap_uint<64> j = j_strm.read();
+        cnt++;
+        sum += (long long)j.range(31, 0).to_uint() * j.range(63, 32).to_uint();
+    }
+    std::multimap<std::string, unsigned> ht_golden;
+    for (int i = 0; i < BuildNumber; i++) ht_golden.insert(std::make_pair(build[i], build_pld[i]));
+    long long golden_cnt = 0, golden_s = 0;
+    for (int i = 0; i < ProbeNumber; i++) {
+        auto its = ht_golden.equal_range(probe[i]);
+        for (auto it = its.first; it != its.second; ++it) {
+            golden_cnt++;
+            golden_s += (long long)it->second * probe_pld[i];
+        }
+    }
+    std::cout << "join on ids: " << cnt << " rows, sum " << sum << ", expected " << golden_cnt << " rows, sum "
+              << golden_s << std::endl;
+    if (cnt != golden_cnt || sum != golden_s) nerror++;
+    return nerror;
+}
+
+// strings longer than MAX_WORD words and strings past the end of body get id 0, body is not written beyond
+int check_limits(const std::vector<std::string>& pool) {
+    const int depth = 64;
+    static ap_uint<64> htb[1 << HTW];
+    static ap_uint<64> body[depth + 16];
+    for (int i = 0; i < (1 << HTW); i++) htb[i] = 0;
+    for (int i = 0; i < depth + 16; i++) body[i] = 0xdeadbeef;
+    body[0] = 0;
+    int nerror = 0;
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < LongNumber; i++) {
+        // same prefix of MAX_WORD words, different tails
+        keys.push_back(std::string(8 * MAX_WORD, 'x') + std::to_string(i));
+    }
+    for (int i = 0; i < DistinctNumber; i++) keys.push_back(pool[i]);
+    hls::stream<ap_uint<64> > str_strm;
+    hls::stream<ap_uint<16> > len_strm;
+    hls::stream<bool> e_strm;
+    hls::stream<ap_uint<32> > id_strm;
+    hls::stream<bool> e_id_strm;
+    feed(keys, str_strm, len_strm, e_strm);
+    xf::database::strKeyMap<HTW, MAX_WORD>(true, str_strm, len_strm, e_strm, htb, body, depth, id_strm, e_id_strm);
+    int nid = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        e_id_strm.read();
+        unsigned id = id_strm.read();
+        if (i < LongNumber && id != 0) {
+            std::cout << "long key " << i << " got id " << id << std::endl;
+            nerror++;
+        }
+        if (id >= depth) {
+            std::cout << "id " << id << " is past the end of body" << std::endl;
+            nerror++;
+        }
+        if (id) nid++;
+    }
+    e_id_strm.read();
+    for (int i = depth; i < depth + 16; i++) {
+        if (body[i] != 0xdeadbeef) {
+            std::cout << "body word " << i << " written past the end" << std::endl;
+            nerror++;
+        }
+    }
+    std::cout << nid << " keys fit " << depth << " body words" << std::endl;
+    if (nid == 0) nerror++;
+    return nerror;
+}
+
+int main() {
+    std::vector<std::string> pool;
+    std::map<std::string, int> in_pool;
+    while (pool.size() < DistinctNumber) {
+        std::string s = gen_str();
+        if (in_pool.count(s) == 0) {
+            in_pool[s] = 1;
+            pool.push_back(s);
+        }
+    }
+
+    static ap_uint<64> htb[1 << HTW];
+    static ap_uint<64> body[BODY_DEPTH];
+    for (int i = 0; i < (1 << HTW); i++) htb[i] = 0;
+    body[0] = 0;
+
+    hls::stream<ap_uint<64> > str_strm;
+    hls::stream<ap_uint<16> > len_strm;
+    hls::stream<bool> e_strm;
+    hls::stream<ap_uint<32> > id_strm;
+    hls::stream<bool> e_id_strm;
+
+    // build side, each string of the first half of the pool shows up a few times
+    std::vector<std::string> build;
+    for (int i = 0; i < BuildNumber; i++) build.push_back(pool[rand() % (DistinctNumber / 2)]);
+    feed(build, str_strm, len_strm, e_strm);
+    str_key_map_dut(true, str_strm, len_strm, e_strm, htb, body, id_strm, e_id_strm);
+
+    int nerror = 0;
+    std::map<std::string, unsigned> str_id;
+    std::map<unsigned, std::string> id_str;
+    for (int i = 0; i < BuildNumber; i++) {
+        bool e = e_id_strm.read();
+        unsigned id = id_strm.read();
+        if (e || id == 0) {
+            nerror++;
+            continue;
+        }
+        if (str_id.count(build[i]) && str_id[build[i]] != id) {
+            std::cout << "\"" << build[i] << "\" has ids " << str_id[build[i]] << " and " << id << std::endl;
+            nerror++;
+        }
+        if (id_str.count(id) && id_str[id] != build[i]) {
+            std::cout << "\"" << build[i] << "\" and \"" << id_str[id] << "\" share id " << id << std::endl;
+            nerror++;
+        }
+        str_id[build[i]] = id;
+        id_str[id] = build[i];
+    }
+    if (!e_id_strm.read()) nerror++;
+
+    // probe side, strings of the whole pool, so about half of them are not found
+    std::vector<std::string> probe;
+    for (int i = 0; i < ProbeNumber; i++) probe.push_back(pool[rand() % DistinctNumber]);
+    feed(probe, str_strm, len_strm, e_strm);
+    str_key_map_dut(false, str_strm, len_strm, e_strm, htb, body, id_strm, e_id_strm);
+
+    int nhit = 0;
+    for (int i = 0; i < ProbeNumber; i++) {
+        e_id_strm.read();
+        unsigned id = id_strm.read();
+        unsigned golden = str_id.count(probe[i]) ? str_id[probe[i]] : 0;
+        if (id != golden) {
+            std::cout << "probe \"" << probe[i] << "\" got id " << id << ", expected " << golden << std::endl;
+            nerror++;
+        }
+        if (golden) nhit++;
+    }
+    if (!e_id_strm.read()) nerror++;
+
+    std::cout << str_id.size() << " distinct build keys, " << nhit << " of " << ProbeNumber << " probe keys found"
+              << std::endl;
+
+    nerror += check_ops(pool);
+    nerror += check_limits(pool);
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: all ids match." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "xf_database/str_like.hpp"
+
+#define PAT_NM 8
+#define SEG_NM 2
+#define SEG_LEN 16
+
+#define TestNumber 5000
+
+typedef xf::database::StrLikeInfo<PAT_NM, SEG_NM, SEG_LEN> Info;
+
+void str_like_dut(hls::stream<ap_uint<32> >& cfg_strm,
+                  hls::stream<ap_uint<512> >& str_strm,
+                  hls::stream<bool>& e_str_strm,
+                  hls::stream<ap_uint<PAT_NM> >& bmp_strm,
+                  hls::stream<bool>& e_bmp_strm) {
+    xf::database::strLike<PAT_NM, SEG_NM, SEG_LEN>(cfg_strm, str_strm, e_str_strm, bmp_strm, e_bmp_strm);
+}
+
+const char* patterns[PAT_NM] = {"PROMO%", "%BRASS", "%green%", "%special%requests%", "MEDIUM POLISHED%", "s_e%",
+                                "%re%sts", "PRO%ASS"};
+const bool negate[PAT_NM] = {false, false, false, true, true, false, false, false};
+
+// reference LIKE, % for any sequence and _ for any character
+bool like(const char* s, const char* p) {
+    if (*p == '\0') return *s == '\0';
+    if (*p == '%') return like(s, p + 1) || (*s != '\0' && like(s + 1, p));
+    if (*s == '\0') return false;
+    return (*p == '_' || *p == *s) && like(s + 1, p + 1);
+}
+
+// cut a LIKE pattern into config words of strLike
+void gen_cfg(const char* pat, bool inv, std::vector<ap_uint<32> >& cfg) {
+    std::string p(pat);
+    std::vector<std::string> segs;
+    size_t b = 0;
+    while (b <= p.size()) {
+        size_t e = p.find('%', b);
+        if (e == std::string::npos) e = p.size();
+        if (e > b) segs.push_back(p.substr(b, e - b));
+        b = e + 1;
+    }
+    ap_uint<32> w = 0;
+    w[0] = p.empty() || p[0] != '%';
+    w[1] = p.empty() || p[p.size() - 1] != '%';
+    w[2] = inv;
+    w.range(15, 8) = segs.size();
+    cfg.push_back(w);
+    for (int k = 0; k < SEG_NM; k++) {
+        std::string s = k < (int)segs.size() ? segs[k] : "";
+        ap_uint<32> care = 0;
+        ap_uint<32> c[(SEG_LEN + 3) / 4];
+        for (int j = 0; j < (SEG_LEN + 3) / 4; j++) c[j] = 0;
+        for (size_t j = 0; j < s.size(); j++) {
+            if (s[j] != '_') {
+                care[j] = 1;
+                c[j / 4].range(8 * (j % 4) + 7, 8 * (j % 4)) = (unsigned char)s[j];
+            }
+        }
+        cfg.push_back(s.size());
+        cfg.push_back(care);
+        for (int j = 0; j < (SEG_LEN + 3) / 4; j++) cfg.push_back(c[j]);
+    }
+}
+
+// strings of random words, so that every pattern matches some of them
+std::string gen_str() {
+    const char* words[] = {"PROMO", "BRASS", "green", "special", "requests", "MEDIUM", "POLISHED",
+                           "STANDARD", "a", "sse", "she", "forest", " ", "gre", "PRO"};
+    std::string s;
+    int n = rand() % 6;
+    for (int i = 0; i < n; i++) {
+        std::string w = words[rand() % 15];
+        if (s.size() + w.size() > 63) break;
+        s += w;
+    }
+    return s;
+}
+
+int main() {
+    std::vector<ap_uint<32> > cfg;
+    for (int p = 0; p < PAT_NM; p++) gen_cfg(patterns[p], negate[p], cfg);
+    if ((int)cfg.size() != Info::dwords_num) {
+        std::cout << "FAIL: " << cfg.size() << " config words, " << Info::dwords_num << " expected." << std::endl;
+        return 1;
+    }
+
+    hls::stream<ap_uint<32> > cfg_strm;
+    hls::stream<ap_uint<512> > str_strm;
+    hls::stream<bool> e_str_strm;
+    hls::stream<ap_uint<PAT_NM> > bmp_strm;
+    hls::stream<bool> e_bmp_strm;
+
+    for (size_t i = 0; i < cfg.size(); i++) cfg_strm.write(cfg[i]);
+    std::vector<std::string> strs;
+    for (int i = 0; i < TestNumber; i++) {
+        std::string s = gen_str();
+        ap_uint<512> t = 0;
+        t.range(511, 504) = s.size();
+        for (size_t j = 0; j < s.size(); j++) t.range(503 - 8 * j, 496 - 8 * j) = (unsigned char)s[j];
+        str_strm.write(t);
+        e_str_strm.write(false);
+        strs.push_back(s);
+    }
+    e_str_strm.write(true);
+
+    str_like_dut(cfg_strm, str_strm, e_str_strm, bmp_strm, e_bmp_strm);
+
+    int nerror = 0;
+    int nmatch[PAT_NM] = {0};
+    for (int i = 0; i < TestNumber; i++) {
+        if (e_bmp_strm.read()) {
+            nerror++;
+            break;
+        }
+        ap_uint<PAT_NM> bmp = bmp_strm.read();
+        for (int p = 0; p < PAT_NM; p++) {
+            bool golden = like(strs[i].c_str(), patterns[p]) != negate[p];
+            if (bmp[p] != golden) {
+                if (nerror < 10)
+                    std::cout << "\"" << strs[i] << "\" " << (negate[p] ? "NOT LIKE" : "LIKE") << " '" << patterns[p]
+                              << "' should be " << golden << std::endl;
+                nerror++;
+            }
+            nmatch[p] += bmp[p];
+        }
+    }
+    if (!e_bmp_strm.read()) nerror++;
+
+    for (int p = 0; p < PAT_NM; p++) {
+        std::cout << (negate[p] ? "NOT LIKE '" : "LIKE '") << patterns[p] << "': " << nmatch[p] << " rows" << std::endl;
+    }
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << TestNumber << " strings matched." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <algorithm>
+
+#include "xf_database/top_k.hpp"
+
+#define KEYW 32
+#define KEY_NM 2
+#define PW 32
+#define MAX_K 64
+
+#define TestNumber 5000
+#define TestK 50
+
+struct Row {
+    int32_t key[KEY_NM];
+    uint32_t pld;
+};
+
+// ORDER BY key0 DESC, key1 ASC
+const int order_bits = (xf::database::SORT_DESCENDING << 0) | (xf::database::SORT_ASCENDING << 1);
+
+bool row_before(const Row& a, const Row& b) {
+    for (int c = 0; c < KEY_NM; c++) {
+        if (a.key[c] != b.key[c]) {
+            bool asc = (order_bits >> c) & 1;
+            return asc ? a.key[c] < b.key[c] : a.key[c] > b.key[c];
+        }
+    }
+    return false;
+}
+
+void top_k_dut(hls::stream<ap_uint<KEYW> > kin_strm[KEY_NM],
+               hls::stream<ap_uint<PW> >& pin_strm,
+               hls::stream<bool>& e_in_strm,
+               hls::stream<ap_uint<KEYW> > kout_strm[KEY_NM],
+               hls::stream<ap_uint<PW> >& pout_strm,
+               hls::stream<bool>& e_out_strm,
+               ap_uint<KEY_NM> order,
+               int k) {
+    xf::database::topK<KEYW, KEY_NM, PW, MAX_K>(kin_strm, pin_strm, e_in_strm, kout_strm, pout_strm, e_out_strm,
+                                                order, k);
+}
+
+int main() {
+    std::vector<Row> rows;
+    srand(1);
+    for (int i = 0; i < TestNumber; i++) {
+        Row r;
+        // small ranges so that ties on key0 and on both keys happen
+        r.key[0] = (rand() % 200) - 100;
+        r.key[1] = (rand() % 20) - 10;
+        r.pld = i;
+        rows.push_back(r);
+    }
+
+    hls::stream<ap_uint<KEYW> > kin_strm[KEY_NM];
+    hls::stream<ap_uint<PW> > pin_strm("pin_strm");
+    hls::stream<bool> e_in_strm("e_in_strm");
+    hls::stream<ap_uint<KEYW> > kout_strm[KEY_NM];
+    hls::stream<ap_uint<PW> > pout_strm("pout_strm");
+    hls::stream<bool> e_out_strm("e_out_strm");
+
+    for (int i = 0; i < TestNumber; i++) {
+        for (int c = 0; c < KEY_NM; c++) {
+            kin_strm[c].write((ap_uint<KEYW>)(uint32_t)rows[i].key[c]);
+        }
+        pin_strm.write(rows[i].pld);
+        e_in_strm.write(false);
+    }
+    e_in_strm.write(true);
+
+    top_k_dut(kin_strm, pin_strm, e_in_strm, kout_strm, pout_strm, e_out_strm, order_bits, TestK);
+
+    // stable sort keeps input order among equal keys, as topK does
+    std::vector<Row> golden = rows;
+    std::stable_sort(golden.begin(), golden.end(), row_before);
+
+    int nerror = 0;
+    int n = 0;
+    while (!e_out_strm.read()) {
+        int32_t key[KEY_NM];
+        for (int c = 0; c < KEY_NM; c++) {
+            key[c] = (int32_t)kout_strm[c].read().to_uint();
+        }
+        uint32_t pld = pout_strm.read();
+        if (n < TestK) {
+            if (key[0] != golden[n].key[0] || key[1] != golden[n].key[1] || pld != golden[n].pld) {
+                if (nerror < 10) {
+                    std::cout << "row " << n << ": got (" << key[0] << ", " << key[1] << ", " << pld
+                              << "), expect (" << golden[n].key[0] << ", " << golden[n].key[1] << ", "
+                              << golden[n].pld << ")" << std::endl;
+                }
+                nerror++;
+            }
+        }
+        n++;
+    }
+    if (n != TestK) {
+        std::cout << "output " << n << " rows, expect " << TestK << std::endl;
+        nerror++;
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: top " << TestK << " of " << TestNumber << " rows verified." << std::endl;
+    }
+    return nerror;
+}
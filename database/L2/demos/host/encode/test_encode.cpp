@@ -0,0 +1,165 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "table_dt.hpp"
+#include "utils.hpp"
+#include "gqe_api.hpp"
+#include "gqe_blocks/scan_to_channel.hpp"
+
+/* Encodes tables with Table::encode and reads them back with the scanner of the kernels, in C simulation.
+ *
+ * Every column has to come back as it was loaded, whatever order the scan asks for the columns in, and each
+ * encoded column has to take only its own size. Descriptors the scanner cannot decode have to stop the scan.
+ * */
+
+const int COL_NM = 8;
+const int CH_NM = 4;
+
+typedef std::vector<std::vector<int32_t> > Rows;
+
+// rows of the scanned columns cids, in row order, row r leaves on channel r % CH_NM
+static Rows scan(Table& t, const std::vector<int>& cids) {
+    hls::stream<int8_t> cid_strm;
+    for (int c = 0; c < COL_NM; c++) cid_strm.write(c < (int)cids.size() ? cids[c] : -1);
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strms[CH_NM][COL_NM];
+    hls::stream<bool> e_strms[CH_NM];
+    xf::database::gqe::scan_to_channel<COL_NM, CH_NM>(t.data, cid_strm, out_strms, e_strms);
+
+    Rows rows;
+    for (int ch = 0; !e_strms[ch].read(); ch = (ch + 1) % CH_NM) {
+        std::vector<int32_t> r;
+        for (int c = 0; c < COL_NM; c++) {
+            int32_t v = out_strms[ch][c].read();
+            if (c < (int)cids.size()) r.push_back(v);
+        }
+        rows.push_back(r);
+    }
+    // the other channels are at their end flags
+    for (int ch = 0; ch < CH_NM; ch++) {
+        while (!e_strms[ch].empty()) e_strms[ch].read();
+    }
+    return rows;
+}
+
+static void fill(Table& t, const std::vector<std::vector<int32_t> >& cols) {
+    t.allocateHost();
+    for (size_t c = 0; c < cols.size(); c++) {
+        for (size_t r = 0; r < cols[c].size(); r++) t.setInt32(r, c, cols[c][r]);
+    }
+    t.setNumRow(cols[0].size());
+}
+
+static int check(const std::string& name, Table& t, const Rows& cols, const std::vector<int>& cids) {
+    Rows got = scan(t, cids);
+    size_t n = cols[0].size();
+    if (got.size() != n) {
+        std::cout << name << ": " << got.size() << " rows scanned, " << n << " expected" << std::endl;
+        return 1;
+    }
+    int nerror = 0;
+    for (size_t r = 0; r < n; r++) {
+        for (size_t c = 0; c < cids.size(); c++) {
+            if (got[r][c] != cols[cids[c]][r] && nerror++ < 10) {
+                std::cout << name << ": row " << r << " column " << cids[c] << " is " << got[r][c] << ", expected "
+                          << cols[cids[c]][r] << std::endl;
+            }
+        }
+    }
+    return nerror;
+}
+
+int main(int argc, const char* argv[]) {
+    std::cout << "\n------------ Table::encode -------------\n";
+    const int n = 10000;
+    Rows cols(4, std::vector<int32_t>(n));
+    for (int r = 0; r < n; r++) {
+        cols[0][r] = (r * 7 % 37) * 1000 - 5000; // 37 values, dictionary
+        cols[1][r] = r / 100;                    // runs of 100 rows
+        cols[2][r] = 1000000 + r * 13 % 3000;    // 12-bit offsets, frame-of-reference
+        cols[3][r] = r * 2654435761u;            // nothing to gain
+    }
+    int nerror = 0;
+
+    // every encoding, columns scanned out of order
+    Table t("t", n, 4, "");
+    fill(t, cols);
+    size_t plain = t.size512.back();
+    t.encode({GQE_COL_DICT, GQE_COL_RLE, GQE_COL_FOR, GQE_COL_DICT});
+    size_t col_words = (n + VEC_LEN - 1) / VEC_LEN;
+    // plain column 3, RLE 1 + 100 / 8 words, FOR 16-bit offsets, 8-bit codes after 3 words of dictionary
+    size_t expect = 2 + (1 + 3 + (n + 63) / 64) + (1 + 13) + (1 + (n + 31) / 32) + col_words;
+    if (t.size512.back() != expect) {
+        std::cout << "encoded size " << t.size512.back() << " words, expected " << expect << std::endl;
+        nerror++;
+    }
+    std::cout << "encoded " << t.size512.back() << " of " << plain << " words" << std::endl;
+    nerror += check("all", t, cols, {0, 1, 2, 3});
+    nerror += check("reordered", t, cols, {3, 2, 0, 1});
+    nerror += check("subset", t, cols, {2, 1});
+
+    // one column encoded, the others stay as large as before
+    Table t1("t1", n, 4, "");
+    fill(t1, cols);
+    t1.encode({GQE_COL_PLAIN, GQE_COL_RLE});
+    if (t1.size512.back() != 2 + 3 * col_words + 1 + 13) {
+        std::cout << "t1 encoded to " << t1.size512.back() << " words" << std::endl;
+        nerror++;
+    }
+    nerror += check("one encoded", t1, cols, {1, 0, 3, 2});
+
+    // dictionary codes
+    Table t2("t2", n, 4, "");
+    fill(t2, cols);
+    t2.encode({GQE_COL_DICT | GQE_COL_KEEP_CODE});
+    Rows codes = cols;
+    for (int r = 0; r < n; r++) {
+        codes[0][r] = std::lower_bound(t2.dicts[0].begin(), t2.dicts[0].end(), cols[0][r]) - t2.dicts[0].begin();
+    }
+    nerror += check("codes", t2, codes, {0, 1});
+
+    // descriptors out of bounds, offsets from the word after the header
+    ap_uint<512> offs = t.data[1];
+    ap_uint<512>& desc_dict = t.data[offs.range(31, 0).to_int()];
+    ap_uint<512>& desc_for = t.data[offs.range(95, 64).to_int()];
+    ap_uint<512> keep = desc_for;
+    desc_for.range(7, 0) = 12;
+    if (scan(t, {2}).size() != 0) {
+        std::cout << "a 12-bit frame-of-reference column is scanned" << std::endl;
+        nerror++;
+    }
+    desc_for = keep;
+    keep = desc_dict;
+    desc_dict.range(95, 64) = 300;
+    if (scan(t, {0, 1}).size() != 0) {
+        std::cout << "a dictionary of 300 entries is scanned" << std::endl;
+        nerror++;
+    }
+    desc_dict = keep;
+    desc_dict.range(7, 0) = 16;
+    if (scan(t, {1, 0}).size() != 0) {
+        std::cout << "a dictionary of 16-bit codes is scanned" << std::endl;
+        nerror++;
+    }
+    desc_dict = keep;
+    nerror += check("restored", t, cols, {0, 1, 2, 3});
+
+    std::cout << (nerror ? "FAIL" : "PASS") << ": " << nerror << " errors" << std::endl;
+    return nerror;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "table_dt.hpp"
+#include "utils.hpp"
+#include "gqe_api.hpp"
+
+/* Sorts tables with ExtSort, gqeSort runs in C simulation.
+ *
+ * Tables are cut into several chunks, sorted by run generation and merge passes and merged by the heap on host,
+ * or are below one run and sorted on host. Keys repeat, in both orders. The keys have to come out in the order of
+ * std::sort, and every row exactly once, with its own payload.
+ * */
+
+struct Case {
+    const char* name;
+    size_t nrow;
+    size_t chunk_rows;
+    int key_range;
+    bool desc0;
+    bool use_key1;
+    bool desc1;
+};
+
+static int check(const Case& cs) {
+    cl::Context ctx;
+    cl::Program prg;
+    cl::CommandQueue q;
+
+    // columns: key0, key1, payload, around zero so that signed compare matters
+    Table tin(cs.name, cs.nrow, 3, "");
+    tin.allocateHost();
+    for (size_t r = 0; r < cs.nrow; r++) {
+        tin.setInt32(r, 0, rand() % cs.key_range - cs.key_range / 2);
+        tin.setInt32(r, 1, rand() % cs.key_range - cs.key_range / 2);
+        tin.setInt32(r, 2, rand());
+    }
+    Table tout("out", cs.nrow, 4, "");
+    tout.allocateHost();
+
+    ExtSort srt(ctx, prg, q, 2, 0, 1, cs.chunk_rows);
+    srt.setKey(0, cs.desc0, cs.use_key1 ? 1 : -1, cs.desc1);
+    srt.setPayload(2);
+    srt.sort(tin, tout);
+
+    std::vector<std::pair<int32_t, int32_t> > golden(cs.nrow);
+    for (size_t r = 0; r < cs.nrow; r++) {
+        golden[r] = std::make_pair(tin.getInt32(r, 0), cs.use_key1 ? tin.getInt32(r, 1) : 0);
+    }
+    std::sort(golden.begin(), golden.end(),
+              [&cs](const std::pair<int32_t, int32_t>& a, const std::pair<int32_t, int32_t>& b) {
+                  if (a.first != b.first) return cs.desc0 ? a.first > b.first : a.first < b.first;
+                  return cs.desc1 ? a.second > b.second : a.second < b.second;
+              });
+
+    int nerror = 0;
+    if ((size_t)tout.getNumRow() != cs.nrow) {
+        std::cout << cs.name << ": " << tout.getNumRow() << " rows, " << cs.nrow << " expected" << std::endl;
+        nerror++;
+    }
+    std::vector<char> seen(cs.nrow, 0);
+    for (size_t r = 0; r < std::min(cs.nrow, (size_t)tout.getNumRow()); r++) {
+        int32_t k0 = tout.getInt32(r, 0);
+        int32_t k1 = tout.getInt32(r, 1);
+        size_t rid = (uint32_t)tout.getInt32(r, 3);
+        if (k0 != golden[r].first || k1 != golden[r].second) {
+            if (nerror++ < 10)
+                std::cout << cs.name << ": row " << r << " has key " << k0 << "," << k1 << ", " << golden[r].first
+                          << "," << golden[r].second << " expected" << std::endl;
+            continue;
+        }
+        if (rid >= cs.nrow || seen[rid]++ || tin.getInt32(rid, 0) != k0 ||
+            (cs.use_key1 && tin.getInt32(rid, 1) != k1) || tin.getInt32(rid, 2) != tout.getInt32(r, 2)) {
+            if (nerror++ < 10) std::cout << cs.name << ": row " << r << " has a wrong row id " << rid << std::endl;
+        }
+    }
+    free(tin.data);
+    free(tout.data);
+    std::cout << cs.name << ": " << cs.nrow << " rows, " << nerror << " errors" << std::endl;
+    return nerror;
+}
+
+int main() {
+    std::cout << "\n------------ ExtSort -------------\n";
+    srand(1);
+    // 5 chunks of 4000 rows, 8 runs and one merge pass each; 1 chunk of 5000 rows, 10 runs and two merge passes;
+    // 300 rows, below one run
+    Case cases[] = {{"chunks_asc_desc", 20000, 4096, 100, false, true, true},
+                    {"chunks_desc_asc", 20000, 4096, 100, true, true, false},
+                    {"chunks_one_key_desc", 20000, 4096, 1000, true, false, false},
+                    {"one_chunk_two_passes", 5000, 8192, 50, false, true, false},
+                    {"below_run_desc", 300, 4096, 20, true, true, true}};
+    int nerror = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) nerror += check(cases[i]);
+    std::cout << (nerror ? "FAIL" : "PASS") << ": " << nerror << " errors" << std::endl;
+    return nerror;
+}
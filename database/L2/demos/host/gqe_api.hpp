@@ -27,6 +27,18 @@
 #include <CL/cl_ext_xilinx.h>
 #include <xcl2.hpp>
 
+#include "tpch_mmap_read.hpp"
+#ifdef HLS_TEST
+#include "gqe_sort.hpp"
+#endif
+
+#include <cmath>
+#include <queue>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
 #define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
 
 #define XCL_BANK0 XCL_BANK(0)
@@ -46,6 +58,35 @@
 #define XCL_BANK14 XCL_BANK(14)
 #define XCL_BANK15 XCL_BANK(15)
 
+// distinct groups gqeAggr keeps on chip in one pass, 4 PU x 2^17 hash slots
+#define GQE_AGGR_PASS_GROUPS (1 << 19)
+// log2 of the max partition number of gqePart
+#define GQE_PART_MAX_BITS 8
+// same as SORT_RUN_LEN and SORT_MERGE_WAY of gqeSort
+#define GQE_SORT_RUN_LEN 512
+#define GQE_SORT_MERGE_WAY 8
+// rows sorted on device in one go, 128 MByte of 16-byte records in each of the ping and pong buffers
+#define GQE_SORT_CHUNK_ROWS (1 << 23)
+// how MultiCard::mergeAggr combines a column of partial aggregates
+#define GQE_MERGE_NONE 0
+#define GQE_MERGE_KEY 1
+#define GQE_MERGE_SUM 2
+#define GQE_MERGE_MIN 3
+#define GQE_MERGE_MAX 4
+#define GQE_MERGE_SUM64 5
+// same as the COL_* encodings and SCAN_DICT_SZ of the scanners
+#define GQE_COL_PLAIN 0
+#define GQE_COL_DICT 1
+#define GQE_COL_RLE 2
+#define GQE_COL_FOR 3
+#define GQE_COL_KEEP_CODE 8
+#define GQE_DICT_SZ 256
+// hash table saved by gqeJoin for probe-only joins, kept at the end of each htb buffer, in 128-bit lines
+#define GQE_HT_PROBE_ONLY (1U << 31)
+#define GQE_HT_SAVE_LINES (2 * ((1 << 17) / 3 + 1) + 1)
+// build row of key and payload merged into the start of htb buffers as an overflow row, in 64-bit words
+#define GQE_HT_ROW_WORDS ((64 + 192) / 64)
+
 long getkrltime(cl::Event e1, cl::Event e2) {
     cl_ulong start, end;
     e1.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
@@ -141,6 +182,83 @@ void load_dat(T* data, const std::string& name, const std::string& dir, size_t n
     load_dat(data, name, dir, n, sizeof(T));
 };
 
+//! Encode one column into the words behind its header, see scan_decode.hpp for the layout,
+//! returns false when the encoding does not apply or does not make the column smaller
+bool encodeCol(const std::vector<int32_t>& v,
+               int enc,
+               std::vector<ap_uint<512> >& words,
+               std::vector<int32_t>& dict) {
+    const size_t n = v.size();
+    const size_t plain_words = (n + VEC_LEN - 1) / VEC_LEN;
+    ap_uint<512> desc = 0;
+    words.clear();
+    dict.clear();
+    if (enc == GQE_COL_RLE) {
+        std::vector<std::pair<int32_t, uint32_t> > runs;
+        for (size_t r = 0; r < n; r++) {
+            if (runs.empty() || runs.back().first != v[r])
+                runs.push_back(std::make_pair(v[r], 1u));
+            else
+                runs.back().second++;
+        }
+        if (1 + (runs.size() + 7) / 8 >= plain_words) return false;
+        desc.range(127, 96) = runs.size();
+        words.assign(1 + (runs.size() + 7) / 8, 0);
+        for (size_t k = 0; k < runs.size(); k++) {
+            words[1 + k / 8].range(64 * (k % 8) + 31, 64 * (k % 8)) = (uint32_t)runs[k].first;
+            words[1 + k / 8].range(64 * (k % 8) + 63, 64 * (k % 8) + 32) = runs[k].second;
+        }
+        words[0] = desc;
+        return true;
+    }
+    if (enc != GQE_COL_DICT && enc != GQE_COL_FOR) return false;
+
+    // bit-packed codes of dictionary or offsets from base of frame-of-reference
+    std::vector<uint32_t> code(n);
+    uint64_t max_code = 0;
+    size_t head = 1;
+    if (enc == GQE_COL_DICT) {
+        dict = v;
+        std::sort(dict.begin(), dict.end());
+        dict.erase(std::unique(dict.begin(), dict.end()), dict.end());
+        if (dict.size() > GQE_DICT_SZ) {
+            dict.clear();
+            return false;
+        }
+        for (size_t r = 0; r < n; r++) {
+            code[r] = std::lower_bound(dict.begin(), dict.end(), v[r]) - dict.begin();
+        }
+        max_code = dict.empty() ? 0 : dict.size() - 1;
+        desc.range(95, 64) = dict.size();
+        head += (dict.size() + VEC_LEN - 1) / VEC_LEN;
+    } else {
+        int32_t base = n ? *std::min_element(v.begin(), v.end()) : 0;
+        for (size_t r = 0; r < n; r++) {
+            code[r] = (uint32_t)((int64_t)v[r] - base);
+            max_code = std::max<uint64_t>(max_code, code[r]);
+        }
+        desc.range(63, 32) = (uint32_t)base;
+    }
+    int w = 1;
+    while (w < 32 && (max_code >> w)) w *= 2;
+    const size_t per_word = 512 / w;
+    if (w == 32 || head + (n + per_word - 1) / per_word >= plain_words) {
+        dict.clear();
+        return false;
+    }
+    desc.range(7, 0) = w;
+    words.assign(head + (n + per_word - 1) / per_word, 0);
+    words[0] = desc;
+    for (size_t k = 0; k < dict.size(); k++) {
+        words[1 + k / VEC_LEN].range(32 * (k % VEC_LEN) + 31, 32 * (k % VEC_LEN)) = (uint32_t)dict[k];
+    }
+    for (size_t r = 0; r < n; r++) {
+        size_t b = (r % per_word) * w;
+        words[head + r / per_word].range(b + w - 1, b) = code[r];
+    }
+    return true;
+}
+
 class Table {
    public:
     std::string name;
@@ -160,6 +278,10 @@ class Table {
     ap_uint<512>* data;
     ap_uint<512>* datak;
     cl::Buffer buffer;
+    // sorted dictionary of each column encoded by encode()
+    std::vector<std::vector<int32_t> > dicts;
+    // bumped by the owner whenever the data changes, so that hash tables cached for older data are not used
+    uint64_t version = 0;
 
     Table(){};
 
@@ -210,6 +332,46 @@ class Table {
         };
     };
 
+    //! Load table to CPU memory from .tbl, fields/types give one entry per non-rowid column,
+    //! parsed columns are cached as .dat in dir. Returns the number of rows loaded, or -1 on error
+    long loadHostTbl(const std::string& tbl_path, const std::vector<int>& fields, const std::vector<TblColType>& types) {
+        std::vector<std::string> names;
+        std::vector<TblCol> cols;
+        for (size_t i = 0, k = 0; i < ncol; i++) {
+            if (isrowid[i] == 0) {
+                if (k >= fields.size() || k >= types.size()) {
+                    std::cout << "ERROR: " << name << " needs a field and a type for every non-rowid column"
+                              << std::endl;
+                    return -1;
+                }
+                names.push_back(colsname[i]);
+                cols.push_back(TblCol(fields[k], types[k], data + size512[i] + 1, colswidth[i]));
+                k++;
+            }
+        }
+        if (cols.size() != fields.size() || cols.size() != types.size()) {
+            std::cout << "ERROR: " << name << " has " << cols.size() << " non-rowid columns, got " << fields.size()
+                      << " fields and " << types.size() << " types" << std::endl;
+            return -1;
+        }
+        long n = load_tbl_cached(tbl_path, dir, names, cols, nrow);
+        if (n < 0) {
+            std::cout << "ERROR loading table from " << tbl_path << std::endl;
+            return -1;
+        }
+        // header holds the rows actually loaded, nrow is only the capacity
+        int32_t nm = n;
+        for (size_t i = 0; i < ncol; i++) {
+            if (isrowid[i] != 0) {
+                for (long j = 0; j < n; j++) {
+                    setInt32(j, i, j);
+                }
+            }
+            memcpy(data + size512[i], &nm, 4);
+        };
+        return n;
+    };
+
     //! CPU memory allocation
     void allocateHost() { // col added manually
         if (mode == 1) {
@@ -257,6 +419,108 @@ class Table {
         }
     };
 
+    //! Encode loaded columns in place, enc gives GQE_COL_PLAIN, GQE_COL_DICT, GQE_COL_RLE or GQE_COL_FOR for each
+    //! column, or'ed with GQE_COL_KEEP_CODE to scan dictionary codes. A column stays plain when its encoding does not
+    //! apply. Columns are laid out back to back after the word of column offsets, so each one takes only its own
+    //! size. Call it before allocateDevBuffer, getInt32 and friends do not work on encoded columns.
+    void encode(const std::vector<int>& enc) {
+        if (ncol > 16) {
+            std::cout << "ERROR: the column offsets of " << name << " do not fit one word, it is kept plain"
+                      << std::endl;
+            return;
+        }
+        if (ncol > 8) {
+            std::cout << "WARNING: only the first 8 columns can be encoded" << std::endl;
+        }
+        const int n = getNumRow();
+        std::vector<std::vector<ap_uint<512> > > words(ncol);
+        dicts.assign(ncol, std::vector<int32_t>());
+        ap_uint<32> encs = 0;
+        for (size_t i = 0; i < ncol; i++) {
+            std::vector<int32_t> v(n);
+            for (int r = 0; r < n; r++) v[r] = getInt32(r, i);
+            int e = (i < enc.size() && i < 8) ? enc[i] : GQE_COL_PLAIN;
+            if ((e & 7) != GQE_COL_PLAIN && !encodeCol(v, e & 7, words[i], dicts[i])) {
+                std::cout << "WARNING: column " << i << " of " << name << " is kept plain" << std::endl;
+                e = GQE_COL_PLAIN;
+            }
+            if ((e & 7) == GQE_COL_PLAIN) {
+                words[i].assign((n + VEC_LEN - 1) / VEC_LEN, 0);
+                if (n) memcpy(words[i].data(), v.data(), sizeof(int32_t) * n);
+            } else {
+                encs.range(4 * i + 3, 4 * i) = e;
+            }
+        }
+        if (encs == 0) return;
+        // table header, word of column offsets, then the columns
+        std::vector<size_t> offs(1, 2);
+        for (size_t i = 0; i < ncol; i++) offs.push_back(offs.back() + words[i].size());
+        ap_uint<512>* encoded = aligned_alloc<ap_uint<512> >(offs.back());
+        memset(encoded, 0, 64 * offs.back());
+        for (size_t i = 0; i < ncol; i++) {
+            encoded[1].range(32 * i + 31, 32 * i) = offs[i];
+            std::copy(words[i].begin(), words[i].end(), encoded + offs[i]);
+        }
+        // no common column stride
+        encoded[0] = get_table_header(0, n);
+        encoded[0].range(287, 256) = encs;
+        std::cout << name << " encoded from " << size512.back() << " to " << offs.back() << " words" << std::endl;
+        free(data);
+        data = encoded;
+        // column i ends at size512[i + 1], column 0 also holds both header words
+        size512.assign(1, 0);
+        for (size_t i = 0; i < ncol; i++) size512.push_back(offs[i + 1]);
+        iskdata.assign(ncol, 1);
+    };
+
+    //! Translate filter condition "col op v" on a column scanned as dictionary codes into a condition on codes,
+    //! the dictionary is sorted so range conditions keep their meaning. Returns false when op cannot be translated.
+    bool dictCond(int col, int op, int32_t v, int& code_op, uint32_t& code_v) {
+        const std::vector<int32_t>& dict = dicts[col];
+        if (op >= xf::database::FOP_GTU) {
+            // codes follow the signed order, which is the unsigned order only without negative values
+            if (v < 0 || (!dict.empty() && dict.front() < 0)) return false;
+            op = op - xf::database::FOP_GTU + xf::database::FOP_GT;
+        }
+        uint32_t lb = std::lower_bound(dict.begin(), dict.end(), v) - dict.begin();
+        uint32_t ub = std::upper_bound(dict.begin(), dict.end(), v) - dict.begin();
+        // no code equals dict.size()
+        uint32_t eq = (lb < ub) ? lb : dict.size();
+        switch (op) {
+            case xf::database::FOP_DC:
+                code_op = op;
+                code_v = 0;
+                break;
+            case xf::database::FOP_EQ:
+            case xf::database::FOP_NE:
+                code_op = op;
+                code_v = eq;
+                break;
+            case xf::database::FOP_LT:
+                code_op = xf::database::FOP_LT;
+                code_v = lb;
+                break;
+            case xf::database::FOP_LE:
+                code_op = xf::database::FOP_LT;
+                code_v = ub;
+                break;
+            case xf::database::FOP_GT:
+                code_op = xf::database::FOP_GE;
+                code_v = ub;
+                break;
+            case xf::database::FOP_GE:
+                code_op = xf::database::FOP_GE;
+                code_v = lb;
+                break;
+            default:
+                return false;
+        }
+        return true;
+    };
+
+    //! Value of a code scanned out of a dictionary column
+    int32_t dictValue(int col, uint32_t code) { return dicts[col][code]; };
+
     int getNumRow() {
         int nm = *(data);
         return nm;
@@ -266,6 +530,20 @@ class Table {
         data[0].range(31, 0) = n; // TO CHECK
     };
 
+    // bloom-filter statistics left in bits 511:384 of the header by gqeJoin, all zero when pushdown is off
+    unsigned getBloomSetBits() { return data[0].range(415, 384).to_uint(); };
+    unsigned getBloomTotalBits() { return data[0].range(447, 416).to_uint(); };
+    unsigned getBloomProbeRow() { return data[0].range(479, 448).to_uint(); };
+    unsigned getBloomDropRow() { return data[0].range(511, 480).to_uint(); };
+    double getBloomFillRate() {
+        unsigned total = getBloomTotalBits();
+        return total == 0 ? 0.0 : (double)getBloomSetBits() / total;
+    };
+    void printBloomInfo() {
+        std::cout << "Bloom filter fill rate " << getBloomFillRate() * 100 << "%, dropped " << getBloomDropRow()
+                  << " of " << getBloomProbeRow() << " probe rows" << std::endl;
+    };
+
     template <class T, int N>
     void setcharN(int r, int l, std::array<T, N> array_) {
         long offset = (long)r * N * sizeof(T);
@@ -317,6 +595,14 @@ class Table {
 
         return d;
     };
+    // min (row 0) or max (row 1) of a pair of columns l and l + 1 aggregated as one 64-bit value,
+    // see cfgCmd::setAggrPairs.
+    int64_t getAggrInt64(int r, int l) { return combineInt64(r, l + 1, l); };
+    // 128-bit sum of a pair of columns l and l + 1 aggregated as one 64-bit value, as hi:lo.
+    void getAggrSum128(int l, int64_t& hi, uint64_t& lo) {
+        lo = (uint64_t)(uint32_t)getInt32(3, l) << 32 | (uint32_t)getInt32(2, l);
+        hi = (int64_t)((uint64_t)(uint32_t)getInt32(3, l + 1) << 32 | (uint32_t)getInt32(2, l + 1));
+    };
 
     int64_t mergeInt64(int32_t l, int32_t h) {
         int64_t h_ = (int64_t)h;
@@ -377,6 +663,58 @@ class Table {
         }
     };
 
+    //! Device-only allocation for an intermediate passed from one kernel to the next,
+    //! only the header is kept on host, initBuffer writes it and readHeader fetches the row number back
+    void allocateDevOnly(cl::Context& context, int bank) {
+        if (mode != 2) {
+            std::cout << "ERROR: Table mode not supported" << std::endl;
+            return;
+        }
+        size_t depth = nrow + VEC_LEN;
+        size_t sizeonecol = size_t((4 * depth + 64 - 1) / 64);
+        for (size_t i = 0; i < ncol; i++) {
+            size512.push_back(size512.back() + sizeonecol);
+            iskdata.push_back(1);
+        };
+        data = aligned_alloc<ap_uint<512> >(1);
+        data[0] = get_table_header(size512[1], 0);
+        mext = {XCL_MEM_TOPOLOGY | (unsigned int)(bank), nullptr, 0};
+        buffer = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_READ_WRITE, (size_t)(64 * size512.back()), &mext);
+        std::cout << name << " DBuffer size: " << (64 * size512.back() / (1024 * 1024)) << " MByte " << std::endl;
+    };
+
+    //! Device-only allocation of a partitioned intermediate, same layout as allocateHost(f, p_num),
+    //! the first header carries the partition size for gqePart, which writes all partition headers
+    void allocateDevOnly(cl::Context& context, int bank, float f, int p_num) {
+        if ((f == 0) || (p_num == 0) || (mode != 2)) {
+            std::cout << "ERROR: Table mode not supported, or p_num (" << p_num << ") f (" << f << ") is 0"
+                      << std::endl;
+            return;
+        }
+        npart = p_num;
+        size_t depth = nrow + VEC_LEN;
+        size_t sizeonecol = size_t((4 * depth + 64 - 1) / 64);
+        size_t alignedSizeOneCol = (f * sizeonecol + p_num - 1) / p_num;
+        for (int j = 0; j < p_num; j++) {
+            for (size_t i = 0; i < ncol; i++) {
+                size512.push_back(size512.back() + alignedSizeOneCol);
+                iskdata.push_back(1);
+            };
+        }
+        data = aligned_alloc<ap_uint<512> >(1);
+        data[0] = get_table_header(size512[ncol], alignedSizeOneCol, 0);
+        mext = {XCL_MEM_TOPOLOGY | (unsigned int)(bank), nullptr, 0};
+        buffer = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_READ_WRITE, (size_t)(64 * size512.back()), &mext);
+        std::cout << name << " DBuffer size: " << (64 * size512.back() / (1024 * 1024)) << " MByte " << std::endl;
+    };
+
+    //! Sub-buffer of one partition, for tables allocated by allocateHost(f, p_num) or allocateDevOnly(.., f, p_num)
+    cl::Buffer createSubBuffer(int index) {
+        cl_buffer_region region{64 * index * size512[ncol], 64 * size512[ncol]};
+        return buffer.createSubBuffer(CL_MEM_READ_WRITE | CL_MEM_EXT_PTR_XILINX, CL_BUFFER_CREATE_TYPE_REGION,
+                                      &region);
+    };
+
     void initBuffer(cl::CommandQueue clq) {
         std::vector<cl::Memory> tb;
         tb.push_back(buffer);
@@ -384,6 +722,8 @@ class Table {
         clq.enqueueWriteBuffer(buffer, CL_TRUE, 0, 64, data, nullptr, nullptr);
     }
 
+    void readHeader(cl::CommandQueue clq) { clq.enqueueReadBuffer(buffer, CL_TRUE, 0, 64, data, nullptr, nullptr); }
+
     void getPartDevBuffer(cl::Buffer* subBuf, int p_num, size_t size) {
         cl_buffer_region sub_region[2];
         for (int i = 0; i < p_num; i++) {
@@ -509,6 +849,37 @@ void gatherTable_row(Table& tin1, Table& tin2, Table& tout) {
     tout.setNumRow(nrow1 + nrow2);
 }
 
+// top-k config of gqeJoin and gqeAggr, the kernels keep at most GQE_TOP_K_MAX rows, and have no top-k stage when
+// built with GQE_TOP_K_MAX 0, the host has to be built with the same value.
+#ifndef GQE_TOP_K_MAX
+#define GQE_TOP_K_MAX 128
+#endif
+// decimal eval and 128-bit sums of gqeJoin, left out of kernels built with GQE_DECIMAL 0
+#ifndef GQE_DECIMAL
+#define GQE_DECIMAL 1
+#endif
+inline ap_uint<64> topKCfg(int k, int key0, bool desc0, int key1, bool desc1) {
+    if (GQE_TOP_K_MAX == 0) {
+        std::cout << "ERROR: the kernels are built without top-k, it stays off" << std::endl;
+        return 0;
+    }
+    if (k > GQE_TOP_K_MAX) {
+        std::cout << "WARNING: top-k keeps at most " << GQE_TOP_K_MAX << " rows, " << k << " requested" << std::endl;
+        k = GQE_TOP_K_MAX;
+    }
+    ap_uint<64> c = 0;
+    c.range(15, 0) = k;
+    c[31] = 1;
+    c.range(35, 32) = key0;
+    if (key1 >= 0) {
+        c.range(39, 36) = key1;
+        c[40] = 1;
+    }
+    c[41] = desc0 ? xf::database::SORT_DESCENDING : xf::database::SORT_ASCENDING;
+    c[42] = desc1 ? xf::database::SORT_DESCENDING : xf::database::SORT_ASCENDING;
+    return c;
+}
+
 class cfgCmd {
    public:
     ap_uint<512>* cmd;
@@ -527,6 +898,60 @@ class cfgCmd {
                             &mext);
     };
 
+    // keep only the first k output rows ordered by column key0 (then key1 when it is not -1),
+    // columns are counted in the output row and compared as signed 32-bit integers.
+    void setTopK(int k, int key0, bool desc0, int key1 = -1, bool desc1 = false) {
+        cmd[8].range(511, 448) = topKCfg(k, key0, desc0, key1, desc1);
+    };
+
+    // overflow rows one PU can merge into htb buffers of ht_depth words before they reach the saved hash table
+    static size_t htSaveRows(size_t ht_depth) {
+        if (ht_depth / 2 <= GQE_HT_SAVE_LINES) return 0;
+        return 2 * (ht_depth / 2 - GQE_HT_SAVE_LINES) / GQE_HT_ROW_WORDS;
+    };
+
+    // save the hash table at the end of htb buffers of ht_depth words, or skip the build and probe the one saved
+    // there before when probe_only, table A should then have no row, see HashTableCache.
+    // returns -1 and leaves the hash table unsaved when the buffers have no room for it.
+    int setHashTable(bool save, bool probe_only, size_t ht_depth = HT_BUFF_DEPTH) {
+        ap_uint<32> c = 0;
+        cmd[8].range(447, 416) = c;
+        if (!save && !probe_only) return 0;
+        if (htSaveRows(ht_depth) == 0) {
+            std::cout << "ERROR: htb buffers of " << ht_depth << " words cannot keep a hash table of "
+                      << 2 * GQE_HT_SAVE_LINES << " words" << std::endl;
+            return -1;
+        }
+        c.range(29, 0) = ht_depth / 2 - GQE_HT_SAVE_LINES;
+        c[31] = probe_only;
+        cmd[8].range(447, 416) = c;
+        return 0;
+    };
+
+    // evaluate expression eval (1 or 2) on signed decimals into a 64-bit value, with its lower word in the eval
+    // column (8 of the shuffle input) and its upper word in column 9, dec_cfg from dynamicALUDecimalConfig.
+    // Returns -1 when the kernel is built with GQE_DECIMAL 0, the host has to be built with the same value.
+    int setDecimalEval(int eval, ap_uint<32> dec_cfg) {
+        if (GQE_DECIMAL == 0) {
+            std::cout << "ERROR: gqeJoin is built without decimal eval" << std::endl;
+            return -1;
+        }
+        dec_cfg[9] = 1;
+        cmd[eval].range(351, 320) = dec_cfg;
+        return 0;
+    };
+
+    // aggregate columns 2k and 2k + 1 of the output row as the lower and upper words of one 64-bit value into a
+    // 128-bit sum when bit k of pairs is set, see Table::getAggrSum128. Returns -1 with GQE_DECIMAL 0.
+    int setAggrPairs(ap_uint<4> pairs) {
+        if (GQE_DECIMAL == 0 && pairs != 0) {
+            std::cout << "ERROR: gqeJoin is built without 128-bit sums" << std::endl;
+            return -1;
+        }
+        cmd[2].range(383, 352) = pairs;
+        return 0;
+    };
+
     void setup(){}; // TODO
 };
 
@@ -549,6 +974,13 @@ class AggrCfgCmd {
                             &mext);
     };
 
+    // same as cfgCmd::setTopK, columns are counted in the 16-column output row.
+    void setTopK(int k, int key0, bool desc0, int key1 = -1, bool desc1 = false) {
+        ap_uint<64> c = topKCfg(k, key0, desc0, key1, desc1);
+        cmd[83] = c.range(31, 0);
+        cmd[84] = c.range(63, 32);
+    };
+
     void setup(){}; // TODO
 };
 
@@ -557,13 +989,17 @@ class bufferTmp {
     cl_mem_ext_ptr_t memExt[16];
     ap_uint<64>* tb_buf[16];
     cl::Buffer buffer[16];
+    size_t ht_depth;
+    size_t s_depth;
 
-    bufferTmp(cl::Context& context) {
+    bufferTmp(cl::Context& context, size_t ht_depth_ = HT_BUFF_DEPTH, size_t s_depth_ = S_BUFF_DEPTH) {
+        ht_depth = ht_depth_;
+        s_depth = s_depth_;
         for (int i = 0; i < 8; i++) {
-            tb_buf[i] = aligned_alloc<ap_uint<64> >(HT_BUFF_DEPTH);
+            tb_buf[i] = aligned_alloc<ap_uint<64> >(ht_depth);
         };
         for (int i = 8; i < 16; i++) {
-            tb_buf[i] = aligned_alloc<ap_uint<64> >(S_BUFF_DEPTH);
+            tb_buf[i] = aligned_alloc<ap_uint<64> >(s_depth);
         };
 
 #ifdef USE_DDR
@@ -609,11 +1045,11 @@ class bufferTmp {
         // Map buffers
         for (int i = 0; i < 8; i++) {
             buffer[i] = cl::Buffer(context, CL_MEM_READ_WRITE | CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR,
-                                   (size_t)(8 * HT_BUFF_DEPTH), &memExt[i]);
+                                   (size_t)(8 * ht_depth), &memExt[i]);
         };
         for (int i = 8; i < 16; i++) {
             buffer[i] = cl::Buffer(context, CL_MEM_READ_WRITE | CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR,
-                                   (size_t)(8 * S_BUFF_DEPTH), &memExt[i]);
+                                   (size_t)(8 * s_depth), &memExt[i]);
         };
     };
 
@@ -680,6 +1116,70 @@ class AggrBufferTmp {
 
 }; // end of class
 
+#ifdef GQE_PROFILE
+// operators followed by a counter tap in gqeJoin, in the order of their lines in profile buffer
+#define GQE_PROF_TAP_NM 7
+static const char* gqe_prof_tap_name[GQE_PROF_TAP_NM] = {"scan", "filter", "bloom_filter", "hash_join",
+                                                         "eval",  "aggr",   "top_k"};
+
+// counters of one gqeJoin run, written by the kernel into a small device buffer, see perf_counter.hpp
+class GqeProfile {
+   public:
+    ap_uint<512>* data;
+    cl::Buffer buffer;
+
+    GqeProfile(){};
+
+    void allocateHost() {
+        data = aligned_alloc<ap_uint<512> >(1 + GQE_PROF_TAP_NM);
+        memset(data, 0, 64 * (1 + GQE_PROF_TAP_NM));
+    };
+
+    void allocateDevBuffer(cl::Context& context, int bank) {
+        cl_mem_ext_ptr_t mext = {XCL_MEM_TOPOLOGY | (unsigned int)(bank), data, 0};
+        buffer = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                            (size_t)(64 * (1 + GQE_PROF_TAP_NM)), &mext);
+    };
+
+    // counter w of round r of tap t, w is 0 for rows, 1 for input stall, 2 for output stall and 3 for cycles
+    uint32_t counter(int t, int r, int w) const {
+        return data[1 + t].range(128 * r + 32 * w + 31, 128 * r + 32 * w).to_uint();
+    };
+
+    // per-query profile, rows in of an operator are rows out of the one before, round 0 is the small table and
+    // round 1 the big one when join is on. Hit rate is joined rows over probe rows, exact for unique build keys.
+    std::string toJson(const std::string& query) const {
+        bool join_on = counter(2, 1, 3) != 0;
+        std::ostringstream os;
+        os << "{\"query\": \"" << query << "\", \"join_on\": " << (join_on ? "true" : "false") << ", \"operators\": [";
+        for (int t = 0; t < GQE_PROF_TAP_NM; ++t) {
+            os << (t ? ", " : "") << "{\"name\": \"" << gqe_prof_tap_name[t] << "\", \"rounds\": [";
+            int nr = (join_on && t < 3) ? 2 : 1;
+            for (int r = 0; r < nr; ++r) {
+                os << (r ? ", " : "") << "{";
+                // the join and everything after take the rows of the last round before it
+                if (t > 0) os << "\"rows_in\": " << counter(t - 1, (join_on && t == 3) ? 1 : r, 0) << ", ";
+                os << "\"rows_out\": " << counter(t, r, 0) << ", \"input_stall_cycles\": " << counter(t, r, 1)
+                   << ", \"output_stall_cycles\": " << counter(t, r, 2) << ", \"cycles\": " << counter(t, r, 3)
+                   << "}";
+            }
+            os << "]}";
+        }
+        os << "]";
+        if (join_on) {
+            uint32_t probe = counter(2, 1, 0);
+            uint32_t hit = counter(3, 0, 0);
+            os << ", \"hash_join\": {\"build_rows\": " << counter(2, 0, 0) << ", \"probe_rows\": " << probe
+               << ", \"overflow_rows\": " << data[0].range(63, 32).to_uint()
+               << ", \"max_chain\": " << data[0].range(95, 64).to_uint()
+               << ", \"hit_rate\": " << (probe ? (double)hit / probe : 0.0) << "}";
+        }
+        os << "}";
+        return os.str();
+    };
+};
+#endif
+
 class krnlEngine {
     Table* in1;
     Table* in2;
@@ -744,6 +1244,11 @@ class krnlEngine {
         krnl.setArg(j++, (cfgcmd->buffer));
     };
 
+#ifdef GQE_PROFILE
+    // gqeJoin built with GQE_PROFILE takes the profile buffer after the 16 temporal buffers
+    void setProfile(GqeProfile& prof) { krnl.setArg(20, prof.buffer); };
+#endif
+
     void run(int rc, std::vector<cl::Event>* waitevt, cl::Event* outevt) { clq.enqueueTask(krnl, waitevt, outevt); };
 };
 
@@ -840,4 +1345,1078 @@ class transEngine {
     };
 };
 
+/**
+ * @brief event DAG of transfers and kernel runs for pipelined query execution.
+ *
+ * Each node waits on the events of its deps, which must be added before it, so the node ids are already in
+ * topological order and run() enqueues the whole graph without host synchronization. A node with a dep not added
+ * before it is refused with id -1, and run() then enqueues nothing. Intermediates allocated
+ * by Table::allocateDevOnly are passed from kernel to kernel in device memory, only the tables added to h2d and
+ * d2h nodes cross PCIe.
+ */
+class PipeGraph {
+    enum NodeType { NODE_H2D, NODE_D2H, NODE_JOIN, NODE_AGGR };
+    struct Node {
+        NodeType type;
+        transEngine* trans;
+        krnlEngine* krnl;
+        AggrKrnlEngine* aggr;
+        std::vector<int> deps;
+        std::string info;
+    };
+    std::vector<Node> nodes;
+    std::vector<cl::Event> events;
+    int nerror;
+
+    int add(Node nd, const std::vector<int>& deps, const std::string& info) {
+        int id = nodes.size();
+        for (size_t i = 0; i < deps.size(); i++) {
+            if (deps[i] < 0 || deps[i] >= id) {
+                std::cout << "ERROR: " << info << " depends on node " << deps[i] << ", not added before it"
+                          << std::endl;
+                nerror++;
+                return -1;
+            }
+        }
+        nd.deps = deps;
+        nd.info = info;
+        nodes.push_back(nd);
+        return id;
+    };
+
+   public:
+    PipeGraph() : nerror(0){};
+
+    int h2d(transEngine& te, const std::vector<int>& deps, const std::string info = "h2d") {
+        Node nd = {NODE_H2D, &te, nullptr, nullptr};
+        return add(nd, deps, info);
+    };
+    int d2h(transEngine& te, const std::vector<int>& deps, const std::string info = "d2h") {
+        Node nd = {NODE_D2H, &te, nullptr, nullptr};
+        return add(nd, deps, info);
+    };
+    int kernel(krnlEngine& ke, const std::vector<int>& deps, const std::string info = "kernel") {
+        Node nd = {NODE_JOIN, nullptr, &ke, nullptr};
+        return add(nd, deps, info);
+    };
+    int kernel(AggrKrnlEngine& ke, const std::vector<int>& deps, const std::string info = "kernel") {
+        Node nd = {NODE_AGGR, nullptr, nullptr, &ke};
+        return add(nd, deps, info);
+    };
+
+    //! enqueue all nodes, returns at once, or -1 without enqueuing when a node was refused
+    int run() {
+        if (nerror) {
+            std::cout << "ERROR: " << nerror << " nodes refused, the graph is not run" << std::endl;
+            return -1;
+        }
+        events.clear();
+        events.resize(nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++) {
+            std::vector<cl::Event> waitevt;
+            for (size_t d = 0; d < nodes[i].deps.size(); d++) waitevt.push_back(events[nodes[i].deps[d]]);
+            std::vector<cl::Event>* w = waitevt.empty() ? nullptr : &waitevt;
+            switch (nodes[i].type) {
+                case NODE_H2D:
+                    nodes[i].trans->host2dev(0, w, &events[i]);
+                    break;
+                case NODE_D2H:
+                    nodes[i].trans->dev2host(0, w, &events[i]);
+                    break;
+                case NODE_JOIN:
+                    nodes[i].krnl->run(0, w, &events[i]);
+                    break;
+                case NODE_AGGR:
+                    nodes[i].aggr->run(0, w, &events[i]);
+                    break;
+            }
+        }
+        return 0;
+    };
+
+    //! block until every node has finished
+    void wait() {
+        if (!events.empty()) cl::WaitForEvents(events);
+    };
+
+    cl::Event& event(int id) { return events[id]; };
+
+    //! device time of every node, relative to the start of the first one
+    void printTime(int64_t offset = 0) {
+        if (events.empty()) return;
+        cl_ulong base;
+        events[0].getProfilingInfo(CL_PROFILING_COMMAND_START, &base);
+        print_d_time(events[0], events.back(), base, "pipeline", offset);
+        for (size_t i = 0; i < nodes.size(); i++) print_d_time(events[i], events[i], base, nodes[i].info, offset);
+    };
+};
+
+/**
+ * @brief HyperLogLog sketch of the distinct group keys, 2^p one-byte registers, about 1.04 / sqrt(2^p) error.
+ */
+class GroupSketch {
+    int p;
+    std::vector<uint8_t> reg;
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    };
+
+   public:
+    GroupSketch(int p_ = 14) : p(p_), reg(1 << p_, 0){};
+
+    void add(uint64_t key) {
+        uint64_t h = mix(key);
+        size_t idx = h >> (64 - p);
+        uint64_t w = h << p;
+        uint8_t rho = 1;
+        while (rho <= 64 - p && !(w >> 63)) {
+            rho++;
+            w <<= 1;
+        }
+        if (rho > reg[idx]) reg[idx] = rho;
+    };
+
+    //! add the rows of a table in CPU memory, the group key is columns 0 to key_nm - 1
+    void add(Table& tb, int key_nm) {
+        int n = tb.getNumRow();
+        for (int r = 0; r < n; r++) {
+            uint64_t k = (uint32_t)tb.getInt32(r, 0);
+            for (int c = 1; c < key_nm; c++) k = mix(k) ^ (uint32_t)tb.getInt32(r, c);
+            add(k);
+        }
+    };
+
+    double estimate() {
+        double m = reg.size();
+        double sum = 0;
+        int zeros = 0;
+        for (size_t i = 0; i < reg.size(); i++) {
+            sum += std::ldexp(1.0, -reg[i]);
+            if (reg[i] == 0) zeros++;
+        }
+        double e = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+        // linear counting for small cardinalities
+        if (e <= 2.5 * m && zeros > 0) e = m * std::log(m / zeros);
+        return e;
+    };
+};
+
+//! gqePart config, partition key at column 0 (and 1), columns passed in order, filter passes all
+inline void genPartCfg(cfgCmd& hpcfg, int ncol, bool dual_key) {
+    ap_uint<512>* b = hpcfg.cmd;
+    memset(b, 0, sizeof(ap_uint<512>) * 9);
+    ap_uint<512> t = 1;
+    t.set_bit(2, dual_key);
+    for (int c = 0; c < 8; ++c) {
+        signed char id = c < ncol ? c : -1;
+        t.range(56 + 8 * c + 7, 56 + 8 * c) = id;
+    }
+    b[0] = t;
+    uint32_t cfg[45];
+    int n = 0;
+    for (int i = 0; i < 4; i++) {
+        cfg[n++] = 0;
+        cfg[n++] = 0;
+        cfg[n++] = 0UL | (xf::database::FOP_DC << xf::database::FilterOpWidth) | (xf::database::FOP_DC);
+    }
+    cfg[n++] = 0;
+    for (int i = 0; i < 31; i++) {
+        cfg[n++] = 0;
+    }
+    cfg[n++] = (uint32_t)(1UL << 31);
+    memcpy(&b[3], cfg, sizeof(uint32_t) * 45);
+}
+
+//! partition number so that each partition keeps its groups within one gqeAggr pass, a power of 2 for gqePart
+inline int aggrSpillPartNum(double groups) {
+    int bits = 0;
+    while (bits < GQE_PART_MAX_BITS && (double)((long long)GQE_AGGR_PASS_GROUPS << bits) < groups) bits++;
+    if ((double)((long long)GQE_AGGR_PASS_GROUPS << bits) < groups)
+        std::cout << "WARNING: " << (long long)groups << " groups exceed " << (1 << bits)
+                  << " partitions, gqeAggr takes more than one pass on each" << std::endl;
+    return 1 << bits;
+}
+
+/**
+ * @brief group aggregate that spills into hash partitions when the groups do not fit one gqeAggr pass.
+ *
+ * The partition number comes from the estimated group number, see GroupSketch. With one partition the input goes
+ * straight to gqeAggr. Otherwise gqePart hash-partitions the input by the group key into a device-only table, each
+ * partition is aggregated by its own gqeAggr run into a partition of the output, and merge() concatenates the
+ * partitions once they are back in CPU memory. A group never spans two partitions, so no re-aggregation is needed.
+ *
+ * gqePart hashes column 0, or columns 0 and 1 with dual_key, so the group key must lead the input table, and the
+ * input has at most 8 columns, otherwise nothing is set up and add() returns -1. The output table is allocated
+ * here, its nrow sets the capacity of the result.
+ *
+ * gqeAggr keeps the groups of a pass in its ping-pong buffers, so two runs must not share an AggrBufferTmp at the
+ * same time. Partition i runs on bufs[i % bufs.size()] after the run of partition i - bufs.size(), so as many runs
+ * overlap as buffers are given. One AggrBufferTmp takes 2GB in fixed banks, so a second one only fits when those
+ * banks have room for it.
+ */
+class AggrSpill {
+    Table* tout;
+    cfgCmd hpcfg;
+    std::vector<AggrCfgCmd> cfgout;
+    AggrKrnlEngine hpkrnl;
+    std::vector<AggrKrnlEngine> aggrkrnl;
+    transEngine transin;
+    transEngine transout;
+    int nbuf;
+    int err;
+
+   public:
+    int part_num;
+    Table part;
+    std::vector<Table> part_in;
+    std::vector<Table> part_out;
+
+    AggrSpill(cl::Context& context,
+              cl::Program& program,
+              cl::CommandQueue& q,
+              Table& tin,
+              Table& tout_,
+              AggrCfgCmd& cfgin,
+              AggrBufferTmp& buf,
+              double groups,
+              bool dual_key = false,
+              float f = 1.2,
+              int bank = 32)
+        : AggrSpill(context,
+                    program,
+                    q,
+                    tin,
+                    tout_,
+                    cfgin,
+                    std::vector<AggrBufferTmp*>(1, &buf),
+                    groups,
+                    dual_key,
+                    f,
+                    bank){};
+
+    AggrSpill(cl::Context& context,
+              cl::Program& program,
+              cl::CommandQueue& q,
+              Table& tin,
+              Table& tout_,
+              AggrCfgCmd& cfgin,
+              const std::vector<AggrBufferTmp*>& bufs,
+              double groups,
+              bool dual_key = false,
+              float f = 1.2,
+              int bank = 32) {
+        tout = &tout_;
+        nbuf = bufs.size();
+        part_num = aggrSpillPartNum(groups);
+        err = 0;
+        if (nbuf == 0) {
+            std::cout << "ERROR: aggr spill needs an aggregation buffer" << std::endl;
+            err = -1;
+            return;
+        }
+        if (part_num > 1 && tin.ncol > 8) {
+            std::cout << "ERROR: gqePart takes at most 8 columns, " << tin.ncol << " given" << std::endl;
+            err = -1;
+            return;
+        }
+        std::cout << "Aggr spill: " << (long long)groups << " estimated groups, " << part_num << " partitions, "
+                  << std::min(nbuf, part_num) << " run at once" << std::endl;
+        transin.setq(q);
+        transout.setq(q);
+        transin.add(&cfgin);
+        cfgout.resize(part_num);
+        aggrkrnl.resize(part_num);
+        for (int i = 0; i < part_num; i++) {
+            cfgout[i].allocateHost();
+            cfgout[i].allocateDevBuffer(context, bank);
+            transin.add(&cfgout[i]);
+            aggrkrnl[i] = AggrKrnlEngine(program, q, "gqeAggr");
+        }
+        if (part_num == 1) {
+            tout->allocateHost();
+            tout->allocateDevBuffer(context, bank);
+            aggrkrnl[0].setup(tin, *tout, cfgin, cfgout[0], *bufs[0]);
+            transout.add(tout);
+            return;
+        }
+        int bits = 0;
+        while ((1 << bits) < part_num) bits++;
+        hpcfg.allocateHost();
+        genPartCfg(hpcfg, tin.ncol, dual_key);
+        hpcfg.allocateDevBuffer(context, bank);
+        transin.add(&hpcfg);
+
+        part = Table(tin.name + "_part", tin.nrow, tin.ncol, "");
+        part.allocateDevOnly(context, bank, f, part_num);
+        tout->allocateHost(f, part_num);
+        tout->allocateDevBuffer(context, bank);
+
+        hpkrnl = AggrKrnlEngine(program, q, "gqePart");
+        hpkrnl.setup_hp(512, 0, bits, tin, part, hpcfg);
+        part_in.resize(part_num);
+        part_out.resize(part_num);
+        for (int i = 0; i < part_num; i++) {
+            part_in[i].buffer = part.createSubBuffer(i);
+            part_out[i] = tout->createSubTable(i);
+            aggrkrnl[i].setup(part_in[i], part_out[i], cfgin, cfgout[i], *bufs[i % nbuf]);
+        }
+        transout.add(tout);
+    };
+
+    //! write the table headers, which carry the column block size the kernels read
+    void initBuffer(cl::CommandQueue& q) {
+        if (err) return;
+        if (part_num == 1) {
+            tout->initBuffer(q);
+            return;
+        }
+        part.initBuffer(q);
+        std::vector<cl::Memory> tb;
+        tb.push_back(tout->buffer);
+        q.enqueueMigrateMemObjects(tb, CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED, nullptr, nullptr);
+        for (int i = 0; i < part_num; i++) {
+            size_t offset = tout->size512[tout->ncol] * i;
+            q.enqueueWriteBuffer(tout->buffer, CL_TRUE, 64 * offset, 64, tout->data + offset, nullptr, nullptr);
+        }
+    };
+
+    //! add config transfer, partition, aggregation and result transfer to the graph, returns the last node,
+    //! or -1 when the spill could not be set up
+    int add(PipeGraph& pipe, const std::vector<int>& deps) {
+        if (err) return err;
+        std::vector<int> wait = deps;
+        wait.push_back(pipe.h2d(transin, deps, "aggr spill config"));
+        if (part_num > 1) wait = {pipe.kernel(hpkrnl, wait, "gqePart")};
+        std::vector<int> done;
+        for (int i = 0; i < part_num; i++) {
+            // the run before on the same buffer has to finish first
+            std::vector<int> w = wait;
+            if (i >= nbuf) w.push_back(done[i - nbuf]);
+            done.push_back(pipe.kernel(aggrkrnl[i], w, "gqeAggr p" + std::to_string(i)));
+        }
+        return pipe.d2h(transout, done, "aggr spill result");
+    };
+
+    //! concatenate the partition results into the output table, after the graph has finished
+    void merge() {
+        if (!err && part_num > 1) tout->mergeSubTable(part_out.data(), part_num);
+    };
+};
+
+/**
+ * @brief LRU cache of the hash tables built by gqeJoin, so that a build table joined again is only probed.
+ *
+ * Each slot is one set of htb/stb buffers, which keeps the hash table built into it until the slot is given to
+ * another build table. A slot is keyed by the name, version and row number of the build table, and a fingerprint
+ * of the config that shapes the hash table: join type, dual key, columns scanned from table A, filter A and the
+ * shuffle after it. The number of slots is the memory budget over the device memory of one set, and the least
+ * recently used slot is evicted when another build table needs one, so the budget should fit the banks connected
+ * to the htb and stb ports of the kernel.
+ *
+ * Before each join, prepare() picks the slot and sets the config to save the hash table, or to probe-only on hit,
+ * and returns the table to pass as table A, which is an empty table on hit. The kernel is then set up with the
+ * buffers() of that slot. Bloom-filter pushdown is off for probe-only joins, since table A is not scanned.
+ *
+ * The hash table is saved behind the overflow rows gqeJoin merges into the start of the htb buffers. A build
+ * table with more rows than cfgCmd::htSaveRows() of the buffer depth could reach it, so it is joined without
+ * caching, in the least recently used slot, which then holds no hash table.
+ */
+class HashTableCache {
+    struct Slot {
+        bufferTmp* buf;
+        std::string name;
+        uint64_t version;
+        size_t nrow;
+        uint64_t fp;
+        uint64_t stamp;
+        bool valid;
+    };
+    std::vector<Slot> slots;
+    Table empty;
+    uint64_t clock;
+    int cur;
+    size_t nhit;
+    size_t nmiss;
+    size_t nevict;
+
+    static uint64_t fnv(uint64_t h, ap_uint<512> v, int hi, int lo) {
+        for (int i = lo; i <= hi; i += 8) {
+            int e = (i + 7 < hi) ? i + 7 : hi;
+            h = (h ^ v.range(e, i).to_uint64()) * 0x100000001b3ULL;
+        }
+        return h;
+    };
+
+    // config bits of gqeJoin that change the rows or layout of the hash table
+    static uint64_t fingerprint(cfgCmd& cmd) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        h = fnv(h, cmd.cmd[0], 5, 0);
+        h = fnv(h, cmd.cmd[0], 119, 56);
+        h = fnv(h, cmd.cmd[0], 255, 192);
+        for (int i = 3; i < 6; i++) h = fnv(h, cmd.cmd[i], 511, 0);
+        return h;
+    };
+
+   public:
+    HashTableCache(cl::Context& context,
+                   size_t budget,
+                   int bank,
+                   size_t ht_depth = HT_BUFF_DEPTH,
+                   size_t s_depth = S_BUFF_DEPTH) {
+        size_t set_size = 8 * 8 * (ht_depth + s_depth);
+        size_t n = budget / set_size;
+        if (n == 0) {
+            std::cout << "WARNING: hash table cache budget " << budget << " is below one buffer set of " << set_size
+                      << " bytes, one slot is used" << std::endl;
+            n = 1;
+        }
+        for (size_t i = 0; i < n; i++) {
+            Slot s;
+            s.buf = new bufferTmp(context, ht_depth, s_depth);
+            s.version = 0;
+            s.nrow = 0;
+            s.fp = 0;
+            s.stamp = 0;
+            s.valid = false;
+            slots.push_back(s);
+        }
+        empty = Table("ht_cache_empty", 0, 8, "");
+        empty.allocateDevOnly(context, bank);
+        clock = 0;
+        cur = 0;
+        nhit = 0;
+        nmiss = 0;
+        nevict = 0;
+    };
+
+    ~HashTableCache() {
+        for (size_t i = 0; i < slots.size(); i++) delete slots[i].buf;
+    };
+
+    void initBuffer(cl::CommandQueue& q) {
+        empty.initBuffer(q);
+        for (size_t i = 0; i < slots.size(); i++) slots[i].buf->initBuffer(q);
+    };
+
+    //! picks the slot for joining with build table tb and sets cmd, returns the table to pass as table A
+    Table& prepare(Table& tb, cfgCmd& cmd) {
+        uint64_t fp = fingerprint(cmd);
+        clock++;
+        // all rows may land in the overflow area of one PU
+        bool cacheable = tb.nrow <= cfgCmd::htSaveRows(slots[0].buf->ht_depth);
+        int lru = 0;
+        for (size_t i = 0; i < slots.size(); i++) {
+            Slot& s = slots[i];
+            // hash tables of older data are dropped first
+            if (s.valid && s.name == tb.name && (s.version != tb.version || s.nrow != tb.nrow)) {
+                s.valid = false;
+                s.stamp = 0;
+            }
+            if (s.valid && s.name == tb.name && s.fp == fp) {
+                s.stamp = clock;
+                cur = i;
+                nhit++;
+                cmd.setHashTable(false, true, s.buf->ht_depth);
+                return empty;
+            }
+            if (s.stamp < slots[lru].stamp) lru = i;
+        }
+        Slot& s = slots[lru];
+        cur = lru;
+        nmiss++;
+        if (!cacheable) {
+            std::cout << "WARNING: " << tb.name << " has " << tb.nrow << " rows, more than "
+                      << cfgCmd::htSaveRows(s.buf->ht_depth) << " kept with a cached hash table, it is not cached"
+                      << std::endl;
+            // the overflow rows of this join overwrite the hash table kept in the slot
+            s.valid = false;
+            s.stamp = 0;
+            cmd.setHashTable(false, false);
+            return tb;
+        }
+        if (s.valid) {
+            std::cout << "Hash table cache evicts " << s.name << " v" << s.version << " for " << tb.name << std::endl;
+            nevict++;
+        }
+        s.name = tb.name;
+        s.version = tb.version;
+        s.nrow = tb.nrow;
+        s.fp = fp;
+        s.stamp = clock;
+        s.valid = true;
+        cmd.setHashTable(true, false, s.buf->ht_depth);
+        return tb;
+    };
+
+    //! htb/stb buffers of the slot picked by the last prepare()
+    bufferTmp& buffers() { return *slots[cur].buf; };
+
+    //! drops the hash tables of build table tb, when its data changes without a new version
+    void invalidate(Table& tb) {
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].name == tb.name) {
+                slots[i].valid = false;
+                slots[i].stamp = 0;
+            }
+        }
+    };
+
+    void printStats() {
+        std::cout << "Hash table cache: " << slots.size() << " slots, " << nhit << " hits, " << nmiss << " misses, "
+                  << nevict << " evictions" << std::endl;
+    };
+};
+
+/**
+ * @brief sorts a table by one or two key columns with gqeSort, carrying the row id and one payload column along.
+ *
+ * The table is cut into chunks of at most chunk_rows rows. Each chunk is sorted on device by one run generation
+ * pass and merge passes, which go back and forth between a ping and a pong buffer on two banks, so only the input
+ * chunk and the sorted records cross PCIe. More than one sorted chunk are merged on host.
+ */
+class ExtSort {
+    cl::Context ctx;
+    cl::Program prg;
+    cl::CommandQueue clq;
+    int bank_in;
+    int bank_ping;
+    int bank_pong;
+    size_t chunk_rows;
+
+    int key0;
+    int key1;
+    bool desc0;
+    bool desc1;
+    int pld;
+
+    static uint32_t normCol(int32_t v, bool desc) {
+        uint32_t u = (uint32_t)v ^ 0x80000000u;
+        return desc ? ~u : u;
+    };
+    static int32_t denormCol(uint32_t u, bool desc) { return (int32_t)((desc ? ~u : u) ^ 0x80000000u); };
+
+    int sortCfg() const {
+        ap_uint<32> cfg = 0;
+        cfg.range(7, 0) = (signed char)0;
+        cfg.range(15, 8) = (signed char)(key1 >= 0 ? 1 : -1);
+        cfg.range(23, 16) = (signed char)(pld >= 0 ? 2 : -1);
+        cfg[24] = desc0 ? xf::database::SORT_DESCENDING : xf::database::SORT_ASCENDING;
+        cfg[25] = desc1 ? xf::database::SORT_DESCENDING : xf::database::SORT_ASCENDING;
+        return cfg.to_int();
+    };
+
+    // copies rows [r0, r0 + n) of one column, zero when the column is not used
+    static void copyCol(Table& tin, int col, size_t r0, size_t n, ap_uint<512>* dst) {
+        if (col < 0) {
+            memset(dst, 0, 4 * n);
+        } else {
+            memcpy(dst, (char*)(tin.data + tin.size512[col] + 1) + 4 * r0, 4 * n);
+        }
+    };
+
+    // sorts one chunk into 16-byte records: key in bits 63:0, chunk row id in bits 95:64, payload in bits 127:96
+    void sortChunk(Table& tin, size_t r0, size_t n, ap_uint<128>* rec) {
+        size_t col512 = (4 * (n + VEC_LEN) + 63) / 64;
+        ap_uint<512>* tb = aligned_alloc<ap_uint<512> >(1 + 3 * col512);
+        tb[0] = 0;
+        tb[0].range(31, 0) = n;
+        tb[0].range(63, 32) = col512;
+        copyCol(tin, key0, r0, n, tb + 1);
+        copyCol(tin, key1, r0, n, tb + 1 + col512);
+        copyCol(tin, pld, r0, n, tb + 1 + 2 * col512);
+
+        if (n < GQE_SORT_RUN_LEN) {
+            // less than one run, insert sort on chip needs a full run
+            for (size_t i = 0; i < n; i++) {
+                int32_t* c = (int32_t*)(tb + 1);
+                ap_uint<128> r = 0;
+                r.range(63, 32) = normCol(c[i], desc0);
+                r.range(31, 0) = normCol(((int32_t*)(tb + 1 + col512))[i], desc1);
+                r.range(95, 64) = i;
+                r.range(127, 96) = ((int32_t*)(tb + 1 + 2 * col512))[i];
+                rec[i] = r;
+            }
+            std::stable_sort(rec, rec + n, [](const ap_uint<128>& a, const ap_uint<128>& b) {
+                return a.range(63, 0) < b.range(63, 0);
+            });
+            free(tb);
+            return;
+        }
+
+#ifdef HLS_TEST
+        // gqeSort in C simulation, on host buffers
+        size_t rec512 = (n + 3) / 4;
+        ap_uint<512>* buf_rec[2] = {aligned_alloc<ap_uint<512> >(rec512), aligned_alloc<ap_uint<512> >(rec512)};
+        int pass = 0;
+        for (size_t run_len = 0; run_len < n; run_len = run_len ? run_len * GQE_SORT_MERGE_WAY : GQE_SORT_RUN_LEN) {
+            ap_uint<512>* in = run_len ? buf_rec[(pass + 1) % 2] : tb;
+            gqeSort(run_len ? 1 : 0, n, run_len, sortCfg(), in, in, in, in, in, in, in, in, buf_rec[pass % 2]);
+            pass++;
+        }
+        memcpy(rec, buf_rec[(pass + 1) % 2], 16 * n);
+        std::cout << "Sort: chunk of " << n << " rows, " << pass - 1 << " merge passes" << std::endl;
+        free(buf_rec[0]);
+        free(buf_rec[1]);
+#else
+        cl_mem_ext_ptr_t mext_in = {XCL_MEM_TOPOLOGY | (unsigned int)(bank_in), tb, 0};
+        cl::Buffer buf_in(ctx, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                          (size_t)(64 * (1 + 3 * col512)), &mext_in);
+        size_t rec512 = (n + 3) / 4;
+        cl_mem_ext_ptr_t mext_ping = {XCL_MEM_TOPOLOGY | (unsigned int)(bank_ping), nullptr, 0};
+        cl_mem_ext_ptr_t mext_pong = {XCL_MEM_TOPOLOGY | (unsigned int)(bank_pong), nullptr, 0};
+        cl::Buffer buf_rec[2] = {
+            cl::Buffer(ctx, CL_MEM_EXT_PTR_XILINX | CL_MEM_READ_WRITE, (size_t)(64 * rec512), &mext_ping),
+            cl::Buffer(ctx, CL_MEM_EXT_PTR_XILINX | CL_MEM_READ_WRITE, (size_t)(64 * rec512), &mext_pong)};
+
+        std::vector<cl::Memory> ib;
+        ib.push_back(buf_in);
+        std::vector<cl::Event> evt(1);
+        clq.enqueueMigrateMemObjects(ib, 0, nullptr, &evt[0]);
+
+        // one kernel object per pass, as passes differ in args and are all in flight
+        std::vector<cl::Kernel> krnl;
+        int pass = 0;
+        for (size_t run_len = 0; run_len < n; run_len = run_len ? run_len * GQE_SORT_MERGE_WAY : GQE_SORT_RUN_LEN) {
+            cl::Kernel k(prg, "gqeSort");
+            cl::Buffer& in = run_len ? buf_rec[(pass + 1) % 2] : buf_in;
+            int j = 0;
+            k.setArg(j++, run_len ? 1 : 0);
+            k.setArg(j++, (int)n);
+            k.setArg(j++, (int)run_len);
+            k.setArg(j++, sortCfg());
+            for (int w = 0; w < GQE_SORT_MERGE_WAY; w++) k.setArg(j++, in);
+            k.setArg(j++, buf_rec[pass % 2]);
+            krnl.push_back(k);
+            std::vector<cl::Event> wait = {evt.back()};
+            evt.push_back(cl::Event());
+            clq.enqueueTask(k, &wait, &evt.back());
+            pass++;
+        }
+        std::vector<cl::Event> wait = {evt.back()};
+        clq.enqueueReadBuffer(buf_rec[(pass + 1) % 2], CL_TRUE, 0, 16 * n, rec, &wait, nullptr);
+        std::cout << "Sort: chunk of " << n << " rows, " << pass - 1 << " merge passes" << std::endl;
+        printkrlTime(evt[1], evt.back(), "gqeSort");
+#endif // HLS_TEST
+        free(tb);
+    };
+
+   public:
+    ExtSort(cl::Context& context,
+            cl::Program& program,
+            cl::CommandQueue& q,
+            int bank_in_ = 2,
+            int bank_ping_ = 0,
+            int bank_pong_ = 1,
+            size_t chunk_rows_ = GQE_SORT_CHUNK_ROWS) {
+        ctx = context;
+        prg = program;
+        clq = q;
+        bank_in = bank_in_;
+        bank_ping = bank_ping_;
+        bank_pong = bank_pong_;
+        chunk_rows = chunk_rows_;
+        if (chunk_rows < 2 * GQE_SORT_RUN_LEN) {
+            std::cout << "WARNING: sort chunk of " << chunk_rows << " rows raised to " << 2 * GQE_SORT_RUN_LEN
+                      << std::endl;
+            chunk_rows = 2 * GQE_SORT_RUN_LEN;
+        }
+        key0 = 0;
+        key1 = -1;
+        desc0 = false;
+        desc1 = false;
+        pld = -1;
+    };
+
+    //! ORDER BY key0, key1, columns are compared as signed 32-bit integers, key1 is not used when -1
+    void setKey(int key0_, bool desc0_, int key1_ = -1, bool desc1_ = false) {
+        key0 = key0_;
+        desc0 = desc0_;
+        key1 = key1_;
+        desc1 = desc1_;
+    };
+
+    //! 32-bit column carried along with the row id, -1 for none
+    void setPayload(int col) { pld = col; };
+
+    //! sorts tin, tout gets 4 columns: key0, key1, payload and row id in tin, tout should be allocated for tin.nrow
+    void sort(Table& tin, Table& tout) {
+        size_t nrow = tin.nrow;
+        // balanced chunks, so that all of them hold at least one full run
+        size_t nchunk = (nrow + chunk_rows - 1) / chunk_rows;
+        if (nchunk == 0) nchunk = 1;
+        size_t csize = (nrow + nchunk - 1) / nchunk;
+
+        std::vector<ap_uint<128>*> rec(nchunk);
+        std::vector<size_t> r0(nchunk);
+        std::vector<size_t> len(nchunk);
+        for (size_t c = 0; c < nchunk; c++) {
+            r0[c] = c * csize;
+            len[c] = std::min(csize, nrow - r0[c]);
+            rec[c] = aligned_alloc<ap_uint<128> >(len[c] + 4);
+            sortChunk(tin, r0[c], len[c], rec[c]);
+        }
+
+        // k-way merge of the sorted chunks, the earlier chunk first on equal keys
+        typedef std::pair<uint64_t, size_t> HeapItem;
+        std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem> > heap;
+        std::vector<size_t> pos(nchunk, 0);
+        for (size_t c = 0; c < nchunk; c++) {
+            if (len[c]) heap.push(HeapItem(rec[c][0].range(63, 0).to_uint64(), c));
+        }
+        size_t r = 0;
+        while (!heap.empty()) {
+            size_t c = heap.top().second;
+            heap.pop();
+            ap_uint<128> t = rec[c][pos[c]];
+            tout.setInt32(r, 0, denormCol(t.range(63, 32).to_uint(), desc0));
+            tout.setInt32(r, 1, key1 >= 0 ? denormCol(t.range(31, 0).to_uint(), desc1) : 0);
+            tout.setInt32(r, 2, t.range(127, 96).to_uint());
+            tout.setInt32(r, 3, r0[c] + t.range(95, 64).to_uint());
+            r++;
+            if (++pos[c] < len[c]) heap.push(HeapItem(rec[c][pos[c]].range(63, 0).to_uint64(), c));
+        }
+        tout.setNumRow(r);
+        for (size_t c = 0; c < nchunk; c++) free(rec[c]);
+        std::cout << "Sort: " << nrow << " rows in " << nchunk << " chunks" << std::endl;
+    };
+};
+
+/**
+ * @brief runs one query over several cards, for data sets beyond the device memory of one card.
+ *
+ * Each card gets its own context, command queue, program and PipeGraph. The fact table is hash-partitioned across
+ * the cards by scatter() on the host, which reads it once and writes each row straight into the share of its card,
+ * so the fact table crosses PCIe once, when the shares are sent to their cards, and the host holds it only twice,
+ * as the fact table and the shares. The small dimension tables are copied to every card by broadcast(). The plan
+ * of each card is built on its own pipe, in the same way as on one card, and run() starts all of them together.
+ * Partial aggregates read back from the cards are combined by mergeAggr(), which splits the rows by the hash of
+ * their group key in one pass and then merges each split on its own thread.
+ *
+ * Rows of equal key go to the same card, the plans may also group on the partition key without any merge.
+ */
+class MultiCard {
+   public:
+    struct Card {
+        cl::Device device;
+        cl::Context context;
+        cl::CommandQueue q;
+        cl::Program program;
+    };
+    // how a column of partial aggregates is merged, col_l is the column of the low 32 bits of GQE_MERGE_SUM64
+    struct MergeOp {
+        int op;
+        int col_l;
+    };
+
+    std::vector<Card> cards;
+    std::vector<PipeGraph> pipes;
+
+   private:
+    static int32_t* col(Table& tb, size_t k) { return (int32_t*)(tb.data + tb.size512[k] + 1); };
+
+    // card of a row, by the key in column 0 and column 1 with dual_key, the same for every table
+    static int cardOf(Table& tb, size_t r, bool dual_key, int n) {
+        uint64_t h = (uint32_t)col(tb, 0)[r];
+        if (dual_key) h |= (uint64_t)(uint32_t)col(tb, 1)[r] << 32;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h % n;
+    };
+
+    static int threadNum(int nthread) {
+        if (nthread > 0) return nthread;
+        int hw = std::thread::hardware_concurrency();
+        return hw > 0 ? hw : 1;
+    };
+
+   public:
+    //! opens card_nm cards, all Xilinx devices found when 0, and loads the same xclbin on each
+    MultiCard(const std::string& xclbin_path, int card_nm = 0) {
+        std::vector<cl::Device> devices = xcl::get_xil_devices();
+        if (card_nm <= 0 || card_nm > (int)devices.size()) {
+            if (card_nm > (int)devices.size())
+                std::cout << "WARNING: " << card_nm << " cards asked, " << devices.size() << " found" << std::endl;
+            card_nm = devices.size();
+        }
+        cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+        cards.resize(card_nm);
+        pipes.resize(card_nm);
+        for (int d = 0; d < card_nm; d++) {
+            Card& c = cards[d];
+            c.device = devices[d];
+            c.context = cl::Context(c.device);
+            c.q = cl::CommandQueue(c.context, c.device,
+                                   CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+            std::vector<cl::Device> devs(1, c.device);
+            c.program = cl::Program(c.context, devs, xclBins);
+            std::cout << "Card " << d << ": " << c.device.getInfo<CL_DEVICE_NAME>() << std::endl;
+        }
+    };
+
+    int size() { return cards.size(); };
+
+    /**
+     * @brief hash-partitions the rows of the fact table slices by column 0 (and 1 with dual_key) into n shares,
+     * on the host.
+     *
+     * One pass counts the rows of each share, the shares are allocated at their size, and a second pass copies
+     * every row into its share, each of nthread threads over its own range of every slice. Rows keep the order of
+     * the slices and of their rows within each share. The slices must have the same columns, all of 32 bits.
+     *
+     * @return 0, or -1 when the slices cannot be partitioned and no share is built.
+     */
+    static int partition(std::vector<Table*>& facts,
+                         int n,
+                         bool dual_key,
+                         const std::string& name,
+                         std::vector<Table>& shares,
+                         int nthread = 0) {
+        if (facts.empty() || n <= 0) {
+            std::cout << "ERROR: nothing to partition for " << name << std::endl;
+            return -1;
+        }
+        const size_t ncol = facts[0]->ncol;
+        for (size_t i = 0; i < facts.size(); i++) {
+            Table& tb = *facts[i];
+            if (tb.ncol != ncol || (dual_key && ncol < 2)) {
+                std::cout << "ERROR: " << tb.name << " has " << tb.ncol << " columns, " << ncol << " expected"
+                          << std::endl;
+                return -1;
+            }
+            for (size_t k = 0; k < tb.colswidth.size(); k++) {
+                if (tb.colswidth[k] != 4) {
+                    std::cout << "ERROR: column " << k << " of " << tb.name << " is " << tb.colswidth[k]
+                              << " bytes wide, only 32-bit columns are partitioned" << std::endl;
+                    return -1;
+                }
+            }
+        }
+        const int nt = threadNum(nthread);
+        const size_t nslice = facts.size();
+        // rows of slice i from thread t to share d start at off[(i * nt + t) * n + d] of the share
+        std::vector<size_t> off(nslice * nt * n, 0);
+        std::vector<std::thread> th;
+        for (int t = 0; t < nt; t++) {
+            th.push_back(std::thread([&, t]() {
+                for (size_t i = 0; i < nslice; i++) {
+                    Table& tb = *facts[i];
+                    size_t nr = tb.getNumRow();
+                    size_t* cnt = &off[(i * nt + t) * n];
+                    for (size_t r = nr * t / nt; r < nr * (t + 1) / nt; r++) cnt[cardOf(tb, r, dual_key, n)]++;
+                }
+            }));
+        }
+        for (int t = 0; t < nt; t++) th[t].join();
+        std::vector<size_t> nrow(n, 0);
+        for (size_t j = 0; j < nslice * nt; j++) {
+            for (int d = 0; d < n; d++) {
+                size_t c = off[j * n + d];
+                off[j * n + d] = nrow[d];
+                nrow[d] += c;
+            }
+        }
+
+        shares.resize(n);
+        for (int d = 0; d < n; d++) {
+            shares[d] = Table(name + "_c" + std::to_string(d), nrow[d], ncol, "");
+            shares[d].allocateHost();
+            shares[d].setNumRow(nrow[d]);
+        }
+        th.clear();
+        for (int t = 0; t < nt; t++) {
+            th.push_back(std::thread([&, t]() {
+                std::vector<int32_t*> dst(n * ncol);
+                for (size_t i = 0; i < nslice; i++) {
+                    Table& tb = *facts[i];
+                    size_t nr = tb.getNumRow();
+                    for (int d = 0; d < n; d++) {
+                        size_t o = off[(i * nt + t) * n + d];
+                        for (size_t k = 0; k < ncol; k++) dst[d * ncol + k] = col(shares[d], k) + o;
+                    }
+                    for (size_t r = nr * t / nt; r < nr * (t + 1) / nt; r++) {
+                        int32_t** p = &dst[cardOf(tb, r, dual_key, n) * ncol];
+                        for (size_t k = 0; k < ncol; k++) *(p[k]++) = col(tb, k)[r];
+                    }
+                }
+            }));
+        }
+        for (int t = 0; t < nt; t++) th[t].join();
+        return 0;
+    };
+
+    //! hash-partitions the fact table slices across the cards, see partition(), and allocates each share on its
+    //! card. The slices may be released once this returns.
+    int scatter(std::vector<Table*>& facts,
+                std::vector<Table>& shares,
+                const std::string& name,
+                bool dual_key = false,
+                int bank = 32) {
+        const int n = cards.size();
+        if (partition(facts, n, dual_key, name, shares) != 0) return -1;
+        size_t nrow = 0;
+        for (int d = 0; d < n; d++) {
+            shares[d].allocateDevBuffer(cards[d].context, bank);
+            std::cout << "Card " << d << ": " << shares[d].nrow << " rows of " << name << std::endl;
+            nrow += shares[d].nrow;
+        }
+        std::cout << "Scatter: " << nrow << " rows of " << name << " on " << n << " cards" << std::endl;
+        return 0;
+    };
+
+    int scatter(
+        Table& fact, std::vector<Table>& shares, const std::string& name, bool dual_key = false, int bank = 32) {
+        std::vector<Table*> facts(1, &fact);
+        return scatter(facts, shares, name, dual_key, bank);
+    };
+
+    //! copies a read-only dimension table to every card, the copies share the host data of dim
+    void broadcast(Table& dim, std::vector<Table>& copies, int bank = 32) {
+        const int n = cards.size();
+        copies.resize(n);
+        for (int d = 0; d < n; d++) {
+            copies[d] = dim;
+            copies[d].name = dim.name + "_c" + std::to_string(d);
+            copies[d].allocateDevBuffer(cards[d].context, bank);
+        }
+    };
+
+    //! enqueues the pipes of all cards, then blocks until every one has finished
+    void run() {
+        for (size_t d = 0; d < pipes.size(); d++) pipes[d].run();
+        for (size_t d = 0; d < pipes.size(); d++) pipes[d].wait();
+    };
+
+    void printTime(int64_t offset = 0) {
+        for (size_t d = 0; d < pipes.size(); d++) {
+            std::cout << "Card " << d << ":" << std::endl;
+            pipes[d].printTime(offset);
+        }
+    };
+
+    /**
+     * @brief merges the partial aggregates read back from the cards into one row per group.
+     *
+     * ops gives one MergeOp per column, the GQE_MERGE_KEY columns together form the group key, GQE_MERGE_SUM64
+     * adds the 64-bit value of its high column and the low column col_l as gqeAggr writes them, and the low
+     * columns are GQE_MERGE_NONE. Averages must be merged as a sum and a count. The output table is allocated
+     * here.
+     *
+     * The rows are split by the hash of their key into nthread sets, in one pass with each thread over its own
+     * range of every table, then each thread merges one set, so every row is hashed once. Groups come out by set,
+     * each set in the order its first row arrives.
+     */
+    static void mergeAggr(std::vector<Table*>& parts, const std::vector<MergeOp>& ops, Table& tout, int nthread) {
+        const int n = threadNum(nthread);
+        const size_t ncol = ops.size();
+        const size_t npart = parts.size();
+        std::vector<int> keys;
+        for (size_t c = 0; c < ncol; c++) {
+            if (ops[c].op == GQE_MERGE_KEY) keys.push_back(c);
+        }
+        // rows of table i read by thread t for set o, in split[(i * n + t) * n + o]
+        std::vector<std::vector<int> > split(npart * n * n);
+        std::vector<std::thread> th;
+        for (int t = 0; t < n; t++) {
+            th.push_back(std::thread([&, t]() {
+                std::hash<std::string> hasher;
+                std::string key(4 * keys.size(), 0);
+                for (size_t i = 0; i < npart; i++) {
+                    Table& tb = *parts[i];
+                    int nr = tb.getNumRow();
+                    for (int r = (int64_t)nr * t / n; r < (int64_t)nr * (t + 1) / n; r++) {
+                        for (size_t k = 0; k < keys.size(); k++) {
+                            int32_t v = tb.getInt32(r, keys[k]);
+                            memcpy(&key[4 * k], &v, 4);
+                        }
+                        split[(i * n + t) * n + hasher(key) % n].push_back(r);
+                    }
+                }
+            }));
+        }
+        for (int t = 0; t < n; t++) th[t].join();
+
+        typedef std::unordered_map<std::string, size_t> GroupMap;
+        std::vector<std::vector<std::vector<int64_t> > > acc(n);
+        th.clear();
+        for (int o = 0; o < n; o++) {
+            th.push_back(std::thread([&, o]() {
+                GroupMap groups;
+                std::vector<std::vector<int64_t> >& rows = acc[o];
+                std::string key(4 * keys.size(), 0);
+                for (size_t j = 0; j < npart * n; j++) {
+                    Table& tb = *parts[j / n];
+                    const std::vector<int>& rs = split[j * n + o];
+                    for (size_t x = 0; x < rs.size(); x++) {
+                        int r = rs[x];
+                        for (size_t k = 0; k < keys.size(); k++) {
+                            int32_t v = tb.getInt32(r, keys[k]);
+                            memcpy(&key[4 * k], &v, 4);
+                        }
+                        std::pair<GroupMap::iterator, bool> it = groups.insert(std::make_pair(key, rows.size()));
+                        if (it.second) rows.push_back(std::vector<int64_t>(ncol, 0));
+                        std::vector<int64_t>& row = rows[it.first->second];
+                        for (size_t c = 0; c < ncol; c++) {
+                            int64_t v = ops[c].op == GQE_MERGE_SUM64 ? tb.combineInt64(r, c, ops[c].col_l)
+                                                                     : (int64_t)tb.getInt32(r, c);
+                            switch (ops[c].op) {
+                                case GQE_MERGE_KEY:
+                                    row[c] = v;
+                                    break;
+                                case GQE_MERGE_SUM:
+                                case GQE_MERGE_SUM64:
+                                    row[c] += v;
+                                    break;
+                                case GQE_MERGE_MIN:
+                                    row[c] = it.second ? v : std::min(row[c], v);
+                                    break;
+                                case GQE_MERGE_MAX:
+                                    row[c] = it.second ? v : std::max(row[c], v);
+                                    break;
+                                default:
+                                    break;
+                            }
+                        }
+                    }
+                }
+            }));
+        }
+        for (int t = 0; t < n; t++) th[t].join();
+
+        size_t total = 0;
+        for (int t = 0; t < n; t++) total += acc[t].size();
+        tout = Table(tout.name, total, ncol, "");
+        tout.allocateHost();
+        size_t r = 0;
+        for (int t = 0; t < n; t++) {
+            for (size_t i = 0; i < acc[t].size(); i++, r++) {
+                for (size_t c = 0; c < ncol; c++) {
+                    int64_t v = acc[t][i][c];
+                    if (ops[c].op == GQE_MERGE_SUM64) {
+                        tout.setInt32(r, c, (int32_t)((uint64_t)v >> 32));
+                        tout.setInt32(r, ops[c].col_l, (int32_t)(v & 0xffffffff));
+                    } else if (ops[c].op != GQE_MERGE_NONE) {
+                        tout.setInt32(r, c, (int32_t)v);
+                    }
+                }
+            }
+        }
+        tout.setNumRow(total);
+        std::cout << "Merge: " << total << " groups from " << parts.size() << " partial aggregates" << std::endl;
+    };
+
+    //! merges the partial aggregates of the cards, see the static mergeAggr(), on one thread per card
+    void mergeAggr(std::vector<Table*>& parts, const std::vector<MergeOp>& ops, Table& tout) {
+        mergeAggr(parts, ops, tout, cards.size());
+    };
+};
+
 #endif
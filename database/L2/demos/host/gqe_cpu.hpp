@@ -0,0 +1,1093 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _GQE_CPU_H
+#define _GQE_CPU_H
+
+#include "gqe_plan.hpp"
+#include "xf_database/hash_lookup3.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/* gqe_cpu.hpp runs a QueryPlan on the host, with the semantics of the GQE kernels.
+ *
+ * It is the CPU side of the same plan description compile() lowers to gqeJoin and gqeAggr, so a query can be
+ * measured against a fair baseline, or served on the host when it is small or the card is busy.
+ *
+ * Data is columnar, 32-bit columns as in the kernels. Each operator splits its input into morsels of CPU_MORSEL
+ * rows, worker threads take the next morsel from a shared counter until all are done, and every per-row step is a
+ * loop over a column of the morsel with the operator selected outside the loop. Filter compares and the direct
+ * aggregate run 8 rows per AVX2 instruction when built with -mavx2 (or a -march that has it), the other loops are
+ * plain C++ left to the compiler.
+ *
+ *   filter:    FOP_* as the dynamic filter, lo and hi bounds or a column compare, signed and unsigned.
+ *   join:      hash join on 1 or 2 keys, JT_INNER, JT_SEMI, JT_ANTI, JT_LEFT, JT_RIGHT and JT_FULL,
+ *              the missing side of an outer join reads as zero. The build side is one lock-free chained table.
+ *   project:   the formula is compiled by dynamicALUOPCompiler and the 7 ALU cells run column by column,
+ *              32-bit unsigned arithmetic as the dynamic eval of gqeJoin.
+ *   groupBy:   AOP_MIN, AOP_MAX and AOP_COUNTNONZEROS on unsigned 32-bit payloads, AOP_SUM and AOP_MEAN in
+ *              64 bits, mean is sum / count, as hash group aggregate of gqeAggr. Each worker aggregates its
+ *              morsels into a private open-addressing table, the tables are merged at the end.
+ *   aggregate: signed min, max, 64-bit sum, count and count non-zero of each column, 6 rows per column as the
+ *              direct aggregate of gqeJoin, no row at all when the input is empty.
+ *   partition: lookup3 with seed 13 of the 1 or 2 key columns, same partition id as gqePart.
+ *
+ * Results of 64-bit aggregates keep the high half in CpuTable::hi. Errors are reported as "ERROR:" lines and the
+ * call returns -1.
+ * */
+
+#define CPU_MORSEL 16384 // rows a worker takes at a time, a morsel of a few columns stays in L2
+
+// a columnar table, hi[c] holds the high 32 bits of a 64-bit column and is empty otherwise
+struct CpuTable {
+    std::vector<std::string> cols;
+    std::vector<std::vector<int32_t> > data;
+    std::vector<std::vector<int32_t> > hi;
+    size_t nrow;
+
+    CpuTable() : nrow(0){};
+
+    int col(const std::string& name) const {
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (cols[i] == name) return i;
+        }
+        return -1;
+    };
+
+    void addCol(const std::string& name, bool wide = false) {
+        cols.push_back(name);
+        data.push_back(std::vector<int32_t>(nrow));
+        hi.push_back(std::vector<int32_t>(wide ? nrow : 0));
+    };
+
+    int32_t getInt32(size_t r, int c) const { return data[c][r]; };
+
+    int64_t getInt64(size_t r, int c) const {
+        if (hi[c].empty()) return data[c][r];
+        return (int64_t)(((uint64_t)(uint32_t)hi[c][r] << 32) | (uint32_t)data[c][r]);
+    };
+
+    // copy the named columns of a host Table, column l of t is t.colsname[l]
+    template <typename T>
+    int load(T& t, const std::vector<std::string>& names) {
+        cols.clear();
+        data.clear();
+        hi.clear();
+        nrow = t.getNumRow();
+        for (size_t i = 0; i < names.size(); i++) {
+            int l = -1;
+            for (size_t j = 0; j < t.colsname.size(); j++) {
+                if (t.colsname[j] == names[i]) l = j;
+            }
+            if (l < 0) {
+                std::cerr << "ERROR: column " << names[i] << " is not in table " << t.name << "." << std::endl;
+                return -1;
+            }
+            addCol(names[i]);
+            for (size_t r = 0; r < nrow; r++) data[i][r] = t.getInt32(r, l);
+        }
+        return 0;
+    };
+
+    // write the low 32 bits of each column into a host Table with the same column order
+    template <typename T>
+    void store(T& t) const {
+        t.setNumRow(nrow);
+        for (size_t c = 0; c < cols.size(); c++) {
+            for (size_t r = 0; r < nrow; r++) t.setInt32(r, c, data[c][r]);
+        }
+    };
+};
+
+class CpuEngine {
+   public:
+    // nthread 0 uses all hardware threads
+    explicit CpuEngine(int nthread = 0) {
+        nth = nthread > 0 ? nthread : std::thread::hardware_concurrency();
+        if (nth < 1) nth = 1;
+    };
+
+    int threads() const { return nth; };
+
+    // a base table scanned by name in a plan, t must outlive the engine calls
+    void addTable(const std::string& name, const CpuTable& t) { tables[name] = &t; };
+
+    // run the plan under root, out gets the columns of the root node in order
+    int run(const QueryPlan& plan, int root, CpuTable& out) {
+        if (root < 0 || root >= (int)plan.nodes.size()) {
+            std::cerr << "ERROR: plan node " << root << " does not exist." << std::endl;
+            return -1;
+        }
+        std::map<int, CpuCols> done;
+        CpuCols res;
+        if (eval(plan, root, done, res)) return -1;
+        materialize(res, out);
+        return 0;
+    };
+
+    // split in into 2^bit_num tables by the hash of 1 or 2 key columns, as gqePart does
+    int partition(const CpuTable& in, const std::vector<std::string>& keys, int bit_num, std::vector<CpuTable>& parts) {
+        if (keys.empty() || keys.size() > 2 || bit_num < 0 || bit_num > 16) {
+            std::cerr << "ERROR: partition needs 1 or 2 key columns and at most 2^16 partitions." << std::endl;
+            return -1;
+        }
+        const int32_t* k[2] = {0, 0};
+        for (size_t i = 0; i < keys.size(); i++) {
+            int c = in.col(keys[i]);
+            if (c < 0) {
+                std::cerr << "ERROR: partition key " << keys[i] << " is not in the table." << std::endl;
+                return -1;
+            }
+            k[i] = in.data[c].data();
+        }
+        const size_t n = in.nrow;
+        const int np = 1 << bit_num;
+        const size_t nm = morsels(n);
+        std::vector<uint16_t> pid(n);
+        std::vector<size_t> hist(nm * np, 0);
+        parallel(n, [&](int, size_t m, size_t b, size_t e) {
+            size_t* h = &hist[m * np];
+            for (size_t i = b; i < e; i++) {
+                uint64_t key = (uint32_t)k[0][i];
+                if (k[1]) key |= (uint64_t)(uint32_t)k[1][i] << 32;
+                ap_uint<64> hv;
+                xf::database::details::hashlookup3_seed_core<64>(ap_uint<64>(key), 13, hv);
+                pid[i] = (uint32_t)hv.range(31, 0) & (np - 1);
+                h[pid[i]]++;
+            }
+        });
+        // rows of a partition keep the input order, morsel m writes after morsels before it
+        parts.assign(np, CpuTable());
+        std::vector<size_t> off(nm * np);
+        for (int p = 0; p < np; p++) {
+            size_t s = 0;
+            for (size_t m = 0; m < nm; m++) {
+                off[m * np + p] = s;
+                s += hist[m * np + p];
+            }
+            parts[p].nrow = s;
+            for (size_t c = 0; c < in.cols.size(); c++) parts[p].addCol(in.cols[c], !in.hi[c].empty());
+        }
+        parallel(n, [&](int, size_t m, size_t b, size_t e) {
+            std::vector<size_t> o(off.begin() + m * np, off.begin() + (m + 1) * np);
+            for (size_t i = b; i < e; i++) {
+                CpuTable& t = parts[pid[i]];
+                size_t r = o[pid[i]]++;
+                for (size_t c = 0; c < in.cols.size(); c++) {
+                    t.data[c][r] = in.data[c][i];
+                    if (!in.hi[c].empty()) t.hi[c][r] = in.hi[c][i];
+                }
+            }
+        });
+        return 0;
+    };
+
+   private:
+    // column view of a node result, columns point into base tables or into tables held by the view
+    struct CpuCols {
+        std::vector<std::string> names;
+        std::vector<const int32_t*> lo;
+        std::vector<const int32_t*> hi;
+        size_t nrow;
+        std::vector<std::shared_ptr<CpuTable> > hold;
+
+        CpuCols() : nrow(0){};
+
+        int col(const std::string& name) const {
+            for (size_t i = 0; i < names.size(); i++) {
+                if (names[i] == name) return i;
+            }
+            return -1;
+        };
+
+        void add(const std::string& name, const int32_t* l, const int32_t* h) {
+            names.push_back(name);
+            lo.push_back(l);
+            hi.push_back(h);
+        };
+
+        // view all columns of a new table t
+        void own(std::shared_ptr<CpuTable> t) {
+            nrow = t->nrow;
+            hold.push_back(t);
+            for (size_t c = 0; c < t->cols.size(); c++) {
+                add(t->cols[c], t->data[c].data(), t->hi[c].empty() ? 0 : t->hi[c].data());
+            }
+        };
+    };
+
+    enum : uint32_t { NONE = 0xffffffff }; // row id of a missing side
+
+    int nth;
+    std::map<std::string, const CpuTable*> tables;
+
+    static size_t morsels(size_t n) { return (n + CPU_MORSEL - 1) / CPU_MORSEL; };
+
+    // f(worker, morsel, begin, end) on every morsel of n rows, workers pull morsels until none is left
+    template <typename F>
+    void parallel(size_t n, F f) const {
+        const size_t nm = morsels(n);
+        std::atomic<size_t> next(0);
+        auto work = [&](int w) {
+            for (size_t m = next.fetch_add(1); m < nm; m = next.fetch_add(1)) {
+                f(w, m, m * CPU_MORSEL, std::min(n, (m + 1) * CPU_MORSEL));
+            }
+        };
+        int nt = (int)std::min<size_t>(nth, nm);
+        if (nt <= 1) {
+            work(0);
+            return;
+        }
+        std::vector<std::thread> ts;
+        for (int w = 1; w < nt; w++) ts.push_back(std::thread(work, w));
+        work(0);
+        for (size_t i = 0; i < ts.size(); i++) ts[i].join();
+    };
+
+    int eval(const QueryPlan& plan, int id, std::map<int, CpuCols>& done, CpuCols& res) {
+        std::map<int, CpuCols>::iterator it = done.find(id);
+        if (it != done.end()) {
+            res = it->second;
+            return 0;
+        }
+        const PlanNode& n = plan.nodes[id];
+        CpuCols in[2];
+        for (size_t i = 0; i < n.in.size() && i < 2; i++) {
+            if (eval(plan, n.in[i], done, in[i])) return -1;
+        }
+        int ret = -1;
+        switch (n.type) {
+            case PLAN_SCAN:
+                ret = scan(n, res);
+                break;
+            case PLAN_FILTER:
+                ret = filter(n, in[0], res);
+                break;
+            case PLAN_JOIN:
+                ret = join(n, in[0], in[1], res);
+                break;
+            case PLAN_PROJECT:
+                ret = project(n, in[0], res);
+                break;
+            case PLAN_GROUPBY:
+                ret = groupBy(n, in[0], res);
+                break;
+            case PLAN_AGGREGATE:
+                ret = aggregate(n, in[0], res);
+                break;
+        }
+        if (ret == 0) done[id] = res;
+        return ret;
+    };
+
+    static int need(const CpuCols& in, const std::string& name) {
+        int c = in.col(name);
+        if (c < 0) std::cerr << "ERROR: column " << name << " is not in the operator input." << std::endl;
+        return c;
+    };
+
+    void materialize(const CpuCols& in, CpuTable& out) const {
+        out = CpuTable();
+        out.nrow = in.nrow;
+        for (size_t c = 0; c < in.names.size(); c++) out.addCol(in.names[c], in.hi[c] != 0);
+        parallel(in.nrow, [&](int, size_t, size_t b, size_t e) {
+            for (size_t c = 0; c < in.names.size(); c++) {
+                std::copy(in.lo[c] + b, in.lo[c] + e, out.data[c].begin() + b);
+                if (in.hi[c]) std::copy(in.hi[c] + b, in.hi[c] + e, out.hi[c].begin() + b);
+            }
+        });
+    };
+
+    // --------------------------------- scan ---------------------------------
+
+    int scan(const PlanNode& n, CpuCols& res) const {
+        std::map<std::string, const CpuTable*>::const_iterator it = tables.find(n.table);
+        if (it == tables.end()) {
+            std::cerr << "ERROR: table " << n.table << " is not added to the CPU engine." << std::endl;
+            return -1;
+        }
+        const CpuTable& t = *it->second;
+        res = CpuCols();
+        res.nrow = t.nrow;
+        for (size_t i = 0; i < n.cols.size(); i++) {
+            int c = t.col(n.cols[i]);
+            if (c < 0) {
+                std::cerr << "ERROR: column " << n.cols[i] << " is not in table " << n.table << "." << std::endl;
+                return -1;
+            }
+            res.add(n.cols[i], t.data[c].data(), t.hi[c].empty() ? 0 : t.hi[c].data());
+        }
+        return 0;
+    };
+
+    // -------------------------------- filter --------------------------------
+
+    struct ColArg {
+        const int32_t* p;
+        int32_t operator[](size_t i) const { return p[i]; };
+    };
+    struct ConstArg {
+        int32_t v;
+        int32_t operator[](size_t) const { return v; };
+    };
+
+#ifdef __AVX2__
+    static __m256i vec8(const ColArg& a, size_t i) { return _mm256_loadu_si256((const __m256i*)(a.p + i)); };
+    static __m256i vec8(const ConstArg& a, size_t) { return _mm256_set1_epi32(a.v); };
+
+    // m[i] &= x[i] <op> y[i] on 32 rows at a time, returns the number of rows done
+    template <typename Y>
+    static size_t cmpMaskAvx2(int op, const int32_t* x, Y y, size_t n, uint8_t* m) {
+        using namespace xf::database;
+        if (op == FOP_DC) return n;
+        // unsigned compares flip the sign bit of both sides, x < y is y > x, and ne, ge and le are negated
+        const bool u = op == FOP_GTU || op == FOP_LTU || op == FOP_GEU || op == FOP_LEU;
+        const bool eq = op == FOP_EQ || op == FOP_NE;
+        const bool swap = op == FOP_LT || op == FOP_GE || op == FOP_LTU || op == FOP_GEU;
+        const bool neg = op == FOP_NE || op == FOP_GE || op == FOP_LE || op == FOP_GEU || op == FOP_LEU;
+        const __m256i flip = _mm256_set1_epi32(u ? INT32_MIN : 0);
+        const __m256i ones = _mm256_set1_epi32(-1);
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i c[4];
+            for (int j = 0; j < 4; j++) {
+                __m256i a = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(x + i + 8 * j)), flip);
+                __m256i b = _mm256_xor_si256(vec8(y, i + 8 * j), flip);
+                if (swap) std::swap(a, b);
+                c[j] = eq ? _mm256_cmpeq_epi32(a, b) : _mm256_cmpgt_epi32(a, b);
+                if (neg) c[j] = _mm256_xor_si256(c[j], ones);
+            }
+            // 0 or -1 of 32 rows packed to bytes, the packs interleave 128-bit lanes and the permute puts them back
+            __m256i p = _mm256_packs_epi16(_mm256_packs_epi32(c[0], c[1]), _mm256_packs_epi32(c[2], c[3]));
+            p = _mm256_permutevar8x32_epi32(p, order);
+            __m256i* mp = (__m256i*)(m + i);
+            _mm256_storeu_si256(mp, _mm256_and_si256(_mm256_loadu_si256(mp), p));
+        }
+        return i;
+    };
+#endif
+
+    // m[i] &= x[i] <op> y[i], signed or unsigned as the FOP
+    template <typename Y>
+    static void cmpMask(int op, const int32_t* x, Y y, size_t n, uint8_t* m) {
+        using namespace xf::database;
+        const uint32_t* u = (const uint32_t*)x;
+#ifdef __AVX2__
+        const size_t i0 = cmpMaskAvx2(op, x, y, n, m);
+#else
+        const size_t i0 = 0;
+#endif
+        switch (op) {
+            case FOP_DC:
+                break;
+            case FOP_EQ:
+                for (size_t i = i0; i < n; i++) m[i] &= x[i] == y[i];
+                break;
+            case FOP_NE:
+                for (size_t i = i0; i < n; i++) m[i] &= x[i] != y[i];
+                break;
+            case FOP_GT:
+                for (size_t i = i0; i < n; i++) m[i] &= x[i] > y[i];
+                break;
+            case FOP_LT:
+                for (size_t i = i0; i < n; i++) m[i] &= x[i] < y[i];
+                break;
+            case FOP_GE:
+                for (size_t i = i0; i < n; i++) m[i] &= x[i] >= y[i];
+                break;
+            case FOP_LE:
+                for (size_t i = i0; i < n; i++) m[i] &= x[i] <= y[i];
+                break;
+            case FOP_GTU:
+                for (size_t i = i0; i < n; i++) m[i] &= u[i] > (uint32_t)y[i];
+                break;
+            case FOP_LTU:
+                for (size_t i = i0; i < n; i++) m[i] &= u[i] < (uint32_t)y[i];
+                break;
+            case FOP_GEU:
+                for (size_t i = i0; i < n; i++) m[i] &= u[i] >= (uint32_t)y[i];
+                break;
+            case FOP_LEU:
+                for (size_t i = i0; i < n; i++) m[i] &= u[i] <= (uint32_t)y[i];
+                break;
+        }
+    };
+
+    int filter(const PlanNode& n, const CpuCols& in, CpuCols& res) {
+        using namespace xf::database;
+        std::vector<int> x(n.conds.size()), y(n.conds.size(), -1);
+        for (size_t i = 0; i < n.conds.size(); i++) {
+            const PlanCond& c = n.conds[i];
+            if ((x[i] = need(in, c.col)) < 0) return -1;
+            if (!c.col2.empty() && (y[i] = need(in, c.col2)) < 0) return -1;
+            if (c.lop < FOP_DC || c.lop > FOP_LEU || c.rop < FOP_DC || c.rop > FOP_LEU) {
+                std::cerr << "ERROR: filter on " << c.col << " uses an unknown FOP." << std::endl;
+                return -1;
+            }
+        }
+        std::vector<std::vector<uint32_t> > sel(morsels(in.nrow));
+        parallel(in.nrow, [&](int, size_t m, size_t b, size_t e) {
+            std::vector<uint8_t> keep(e - b, 1);
+            for (size_t i = 0; i < n.conds.size(); i++) {
+                const PlanCond& c = n.conds[i];
+                const int32_t* v = in.lo[x[i]] + b;
+                if (y[i] >= 0) {
+                    ColArg a = {in.lo[y[i]] + b};
+                    cmpMask(c.lop, v, a, e - b, keep.data());
+                } else {
+                    ConstArg l = {(int32_t)c.lo};
+                    ConstArg h = {(int32_t)c.hi};
+                    cmpMask(c.lop, v, l, e - b, keep.data());
+                    cmpMask(c.rop, v, h, e - b, keep.data());
+                }
+            }
+            for (size_t i = 0; i < e - b; i++) {
+                if (keep[i]) sel[m].push_back(b + i);
+            }
+        });
+        std::vector<uint32_t> rows;
+        concat(sel, rows);
+        std::vector<uint32_t> none;
+        gather(in, rows, none, in.names, std::vector<int>(in.names.size(), 0), res);
+        return 0;
+    };
+
+    template <typename T>
+    static void concat(std::vector<std::vector<T> >& parts, std::vector<T>& out) {
+        size_t s = 0;
+        for (size_t i = 0; i < parts.size(); i++) s += parts[i].size();
+        out.reserve(out.size() + s);
+        for (size_t i = 0; i < parts.size(); i++) {
+            out.insert(out.end(), parts[i].begin(), parts[i].end());
+            std::vector<T>().swap(parts[i]);
+        }
+    };
+
+    /* new table of cols, column c is taken from input side[c] (0: a, 1: b) at row ra[i] or rb[i].
+     * A row id of NONE reads as zero, a key column present on both sides takes side a unless its row is NONE. */
+    void gather(const CpuCols& a,
+                const std::vector<uint32_t>& ra,
+                const std::vector<uint32_t>& rb,
+                const std::vector<std::string>& cols,
+                const std::vector<int>& side,
+                CpuCols& res,
+                const CpuCols* b = 0) const {
+        std::shared_ptr<CpuTable> t(new CpuTable());
+        t->nrow = ra.size();
+        std::vector<int> ca(cols.size()), cb(cols.size());
+        for (size_t c = 0; c < cols.size(); c++) {
+            ca[c] = side[c] == 0 || side[c] == 2 ? a.col(cols[c]) : -1;
+            cb[c] = b && (side[c] == 1 || side[c] == 2) ? b->col(cols[c]) : -1;
+            bool wide = (ca[c] >= 0 && a.hi[ca[c]]) || (cb[c] >= 0 && b->hi[cb[c]]);
+            t->addCol(cols[c], wide);
+        }
+        parallel(t->nrow, [&](int, size_t, size_t s, size_t e) {
+            for (size_t c = 0; c < cols.size(); c++) {
+                int32_t* lo = t->data[c].data();
+                int32_t* hi = t->hi[c].empty() ? 0 : t->hi[c].data();
+                const int32_t* al = ca[c] >= 0 ? a.lo[ca[c]] : 0;
+                const int32_t* ah = ca[c] >= 0 ? a.hi[ca[c]] : 0;
+                const int32_t* bl = cb[c] >= 0 ? b->lo[cb[c]] : 0;
+                const int32_t* bh = cb[c] >= 0 ? b->hi[cb[c]] : 0;
+                if (al && !bl && rb.empty()) {
+                    // plain selection, the common case of filter
+                    for (size_t i = s; i < e; i++) lo[i] = al[ra[i]];
+                    if (hi) {
+                        for (size_t i = s; i < e; i++) hi[i] = ah ? ah[ra[i]] : 0;
+                    }
+                    continue;
+                }
+                for (size_t i = s; i < e; i++) {
+                    uint32_t r0 = ra[i];
+                    uint32_t r1 = rb.empty() ? NONE : rb[i];
+                    if (al && r0 != NONE) {
+                        lo[i] = al[r0];
+                        if (hi) hi[i] = ah ? ah[r0] : 0;
+                    } else if (bl && r1 != NONE) {
+                        lo[i] = bl[r1];
+                        if (hi) hi[i] = bh ? bh[r1] : 0;
+                    } else {
+                        lo[i] = 0;
+                        if (hi) hi[i] = 0;
+                    }
+                }
+            }
+        });
+        res = CpuCols();
+        res.own(t);
+    };
+
+    // --------------------------------- join ---------------------------------
+
+    static uint64_t joinKey(const int32_t* const k[2], size_t i) {
+        uint64_t v = (uint32_t)k[0][i];
+        if (k[1]) v |= (uint64_t)(uint32_t)k[1][i] << 32;
+        return v;
+    };
+
+    static uint64_t joinHash(uint64_t k, int bits) { return (k * 0x9e3779b97f4a7c15ULL) >> (64 - bits); };
+
+    // build is input 0 and probe input 1, as the plan names them
+    int join(const PlanNode& n, const CpuCols& build, const CpuCols& probe, CpuCols& res) {
+        using namespace xf::database;
+        const int32_t* bk[2] = {0, 0};
+        const int32_t* pk[2] = {0, 0};
+        for (size_t k = 0; k < n.keys[0].size() && k < 2; k++) {
+            int b = need(build, n.keys[0][k]);
+            int p = need(probe, n.keys[1][k]);
+            if (b < 0 || p < 0) return -1;
+            bk[k] = build.lo[b];
+            pk[k] = probe.lo[p];
+        }
+        const int type = n.join_type;
+        const bool keep_b = type == JT_RIGHT || type == JT_FULL;
+        const bool keep_p = type == JT_LEFT || type == JT_FULL;
+
+        // build: one chained table, each build row is pushed to the head of its bucket
+        const size_t nb = build.nrow;
+        int bits = 4;
+        while (((size_t)1 << bits) < 2 * nb && bits < 32) bits++;
+        const size_t nbk = (size_t)1 << bits;
+        std::unique_ptr<std::atomic<uint32_t>[]> head(new std::atomic<uint32_t>[nbk]);
+        std::vector<uint32_t> next(nb);
+        parallel(nbk, [&](int, size_t, size_t b, size_t e) {
+            for (size_t i = b; i < e; i++) head[i].store(NONE, std::memory_order_relaxed);
+        });
+        parallel(nb, [&](int, size_t, size_t b, size_t e) {
+            for (size_t i = b; i < e; i++) {
+                uint64_t h = joinHash(joinKey(bk, i), bits);
+                next[i] = head[h].exchange(i, std::memory_order_relaxed);
+            }
+        });
+        std::unique_ptr<std::atomic<uint8_t>[]> hit(keep_b ? new std::atomic<uint8_t>[nb] : 0);
+        if (keep_b) {
+            parallel(nb, [&](int, size_t, size_t b, size_t e) {
+                for (size_t i = b; i < e; i++) hit[i].store(0, std::memory_order_relaxed);
+            });
+        }
+
+        // probe: rows of a morsel are hashed column-at-a-time, then the chains are walked
+        const size_t nm = morsels(probe.nrow);
+        std::vector<std::vector<uint32_t> > pr(nm), br(nm);
+        parallel(probe.nrow, [&](int, size_t m, size_t b, size_t e) {
+            std::vector<uint64_t> key(e - b);
+            std::vector<uint32_t> bucket(e - b);
+            for (size_t i = b; i < e; i++) key[i - b] = joinKey(pk, i);
+            for (size_t i = 0; i < e - b; i++) bucket[i] = joinHash(key[i], bits);
+            for (size_t i = 0; i < e - b; i++) {
+                bool matched = false;
+                for (uint32_t r = head[bucket[i]].load(std::memory_order_relaxed); r != NONE; r = next[r]) {
+                    if (joinKey(bk, r) != key[i]) continue;
+                    matched = true;
+                    if (type == JT_SEMI || type == JT_ANTI) break;
+                    pr[m].push_back(b + i);
+                    br[m].push_back(r);
+                    if (keep_b) hit[r].store(1, std::memory_order_relaxed);
+                }
+                if ((type == JT_SEMI && matched) || ((type == JT_ANTI || keep_p) && !matched)) {
+                    pr[m].push_back(b + i);
+                    br[m].push_back(NONE);
+                }
+            }
+        });
+        if (keep_b) {
+            std::vector<std::vector<uint32_t> > bp(morsels(nb)), bb(morsels(nb));
+            parallel(nb, [&](int, size_t m, size_t b, size_t e) {
+                for (size_t i = b; i < e; i++) {
+                    if (!hit[i].load(std::memory_order_relaxed)) {
+                        bp[m].push_back(NONE);
+                        bb[m].push_back(i);
+                    }
+                }
+            });
+            pr.insert(pr.end(), bp.begin(), bp.end());
+            br.insert(br.end(), bb.begin(), bb.end());
+        }
+        std::vector<uint32_t> rp, rb;
+        concat(pr, rp);
+        concat(br, rb);
+
+        // a column on both sides is a key, it comes from the probe row unless that is missing
+        std::vector<int> side(n.cols.size());
+        for (size_t c = 0; c < n.cols.size(); c++) {
+            bool in_p = probe.col(n.cols[c]) >= 0;
+            bool in_b = build.col(n.cols[c]) >= 0;
+            if (!in_p && !in_b) {
+                std::cerr << "ERROR: column " << n.cols[c] << " is on neither side of the join." << std::endl;
+                return -1;
+            }
+            side[c] = in_p && in_b ? 2 : (in_p ? 0 : 1);
+        }
+        gather(probe, rp, rb, n.cols, side, res, &build);
+        return 0;
+    };
+
+    // -------------------------------- project -------------------------------
+
+    // one ALU cell over n rows, a mux/boolean cell when op[3] is set, otherwise add/mul and compare
+    static void aluCell(int op,
+                        const uint32_t* a,
+                        const uint32_t* b,
+                        const uint8_t* ba,
+                        const uint8_t* bb,
+                        size_t n,
+                        uint32_t* v,
+                        uint8_t* r) {
+        if (op & 8) {
+            std::copy(op & 1 ? a : b, (op & 1 ? a : b) + n, v);
+            switch (op & 7) {
+                case 0:
+                    std::copy(bb, bb + n, r);
+                    break;
+                case 1:
+                    std::copy(ba, ba + n, r);
+                    break;
+                case 2:
+                    std::fill(r, r + n, 1);
+                    break;
+                case 3:
+                    std::fill(r, r + n, 0);
+                    break;
+                case 4:
+                    for (size_t i = 0; i < n; i++) r[i] = ba[i] & bb[i];
+                    break;
+                case 5:
+                    for (size_t i = 0; i < n; i++) r[i] = ba[i] | bb[i];
+                    break;
+                case 6:
+                    for (size_t i = 0; i < n; i++) r[i] = ba[i] ^ bb[i];
+                    break;
+                case 7:
+                    for (size_t i = 0; i < n; i++) r[i] = ba[i] == bb[i];
+                    break;
+            }
+            return;
+        }
+        // negation as a multiply by -1, all 32-bit unsigned as ap_uint<32> in gqeJoin
+        const uint32_t sa = op & 2 ? 0xffffffffu : 1u;
+        const uint32_t sb = op & 1 ? 0xffffffffu : 1u;
+        if (op & 4) {
+            for (size_t i = 0; i < n; i++) v[i] = (a[i] * sa) * (b[i] * sb);
+        } else {
+            for (size_t i = 0; i < n; i++) v[i] = a[i] * sa + b[i] * sb;
+        }
+        switch (op & 7) {
+            case 0:
+                for (size_t i = 0; i < n; i++) r[i] = a[i] > b[i];
+                break;
+            case 1:
+                for (size_t i = 0; i < n; i++) r[i] = a[i] >= b[i];
+                break;
+            case 2:
+                for (size_t i = 0; i < n; i++) r[i] = a[i] == b[i];
+                break;
+            case 3:
+                for (size_t i = 0; i < n; i++) r[i] = a[i] != b[i];
+                break;
+            case 4:
+                for (size_t i = 0; i < n; i++) r[i] = a[i] <= b[i];
+                break;
+            case 5:
+                for (size_t i = 0; i < n; i++) r[i] = a[i] < b[i];
+                break;
+            default:
+                std::fill(r, r + n, 0);
+                break;
+        }
+    };
+
+    // evaluate a compiled 289-bit dynamic ALU config on n rows, operands not bound read as zero
+    static void alu(const ap_uint<289>& cfg, const uint32_t* const in[4], size_t n, uint32_t* out) {
+        const ap_uint<33> op = cfg.range(288, 256);
+        const int cop[7] = {(int)op.range(27, 24), (int)op.range(23, 20), (int)op.range(19, 16),
+                            (int)op.range(15, 12), (int)op.range(11, 8),  (int)op.range(7, 4),
+                            (int)op.range(3, 0)};
+        uint32_t c[4];
+        for (int i = 0; i < 4; i++) c[i] = (uint32_t)cfg.range(223 - 64 * i, 192 - 64 * i);
+
+        std::vector<uint32_t> zero(n, 0), cv(n), v[8];
+        std::vector<uint8_t> ba(n), bc(n), r[8];
+        for (int i = 0; i < 8; i++) {
+            v[i].resize(n);
+            r[i].resize(n);
+        }
+        // level 1, operand k against constant k
+        for (int k = 0; k < 4; k++) {
+            const uint32_t* a = in[k] ? in[k] : zero.data();
+            std::fill(cv.begin(), cv.end(), c[k]);
+            std::fill(bc.begin(), bc.end(), c[k] != 0);
+            for (size_t i = 0; i < n; i++) ba[i] = a[i] != 0;
+            aluCell(cop[k], a, cv.data(), ba.data(), bc.data(), n, v[k].data(), r[k].data());
+        }
+        // level 2, cell 6 muxes per row on the boolean of cell 5 when it is a mux
+        aluCell(cop[4], v[0].data(), v[1].data(), r[0].data(), r[1].data(), n, v[4].data(), r[4].data());
+        int op6 = cop[5] & 0xe;
+        if ((op6 & 8) && (op6 & 2)) {
+            aluCell(op6, v[2].data(), v[3].data(), r[2].data(), r[3].data(), n, v[5].data(), r[5].data());
+            aluCell(op6 | 1, v[2].data(), v[3].data(), r[2].data(), r[3].data(), n, v[7].data(), r[7].data());
+            for (size_t i = 0; i < n; i++) {
+                v[5][i] = r[4][i] ? v[7][i] : v[5][i];
+                r[5][i] = r[4][i] ? r[7][i] : r[5][i];
+            }
+        } else {
+            aluCell(cop[5], v[2].data(), v[3].data(), r[2].data(), r[3].data(), n, v[5].data(), r[5].data());
+        }
+        // level 3
+        aluCell(cop[6], v[4].data(), v[5].data(), r[4].data(), r[5].data(), n, v[6].data(), r[6].data());
+        if (op[32]) {
+            for (size_t i = 0; i < n; i++) out[i] = r[6][i];
+        } else {
+            std::copy(v[6].begin(), v[6].end(), out);
+        }
+    };
+
+    int project(const PlanNode& n, const CpuCols& in, CpuCols& res) {
+        res = CpuCols();
+        res.nrow = in.nrow;
+        res.hold = in.hold;
+        const size_t npass = n.cols.size() - n.exprs.size();
+        for (size_t i = 0; i < npass; i++) {
+            int c = need(in, n.cols[i]);
+            if (c < 0) return -1;
+            res.add(n.cols[i], in.lo[c], in.hi[c]);
+        }
+        if (n.exprs.empty()) return 0;
+
+        std::shared_ptr<CpuTable> t(new CpuTable());
+        t->nrow = in.nrow;
+        std::vector<ap_uint<289> > cfg(n.exprs.size());
+        std::vector<std::vector<int> > strm(n.exprs.size());
+        for (size_t e = 0; e < n.exprs.size(); e++) {
+            const PlanExpr& x = n.exprs[e];
+            if (!xf::database::dynamicALUOPCompiler<uint32_t, uint32_t, uint32_t, uint32_t>(
+                    x.formula.c_str(), x.c[0], x.c[1], x.c[2], x.c[3], cfg[e])) {
+                std::cerr << "ERROR: dynamic ALU cannot compile " << x.formula << "." << std::endl;
+                return -1;
+            }
+            for (size_t s = 0; s < x.strm.size(); s++) {
+                int c = need(in, x.strm[s]);
+                if (c < 0) return -1;
+                strm[e].push_back(c);
+            }
+            t->addCol(x.name);
+        }
+        parallel(in.nrow, [&](int, size_t, size_t b, size_t e) {
+            for (size_t x = 0; x < n.exprs.size(); x++) {
+                const uint32_t* ops[4] = {0, 0, 0, 0};
+                for (size_t s = 0; s < strm[x].size(); s++) ops[s] = (const uint32_t*)in.lo[strm[x][s]] + b;
+                alu(cfg[x], ops, e - b, (uint32_t*)t->data[x].data() + b);
+            }
+        });
+        res.hold.push_back(t);
+        for (size_t x = 0; x < n.exprs.size(); x++) res.add(n.exprs[x].name, t->data[x].data(), 0);
+        return 0;
+    };
+
+    // ------------------------------- group by -------------------------------
+
+    static uint64_t groupMix(uint64_t h) {
+        h ^= h >> 29;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        return h ^ (h >> 32);
+    };
+
+    static uint64_t aggrInit(int op) { return op == xf::database::AOP_MIN ? 0xffffffffULL : 0; };
+
+    /* groups of one worker in an open-addressing table with linear probing, slot holds group id + 1 and 0 when
+     * empty. keys[g * nk + k] is key k of group g and acc[g * na + a] its aggregate a. */
+    struct GroupPart {
+        size_t nk, na;
+        const std::vector<PlanAggr>* aggrs;
+        std::vector<uint32_t> slot;
+        std::vector<uint64_t> hash;
+        std::vector<uint32_t> keys;
+        std::vector<uint64_t> cnt;
+        std::vector<uint64_t> acc;
+
+        GroupPart() : nk(0), na(0), aggrs(0), slot(1024, 0){};
+
+        // id of the group of key hash h, key(k) gives key k, a new group is added with initial aggregates
+        template <typename K>
+        uint32_t group(uint64_t h, K key) {
+            const size_t mask = slot.size() - 1;
+            size_t s = h & mask;
+            for (; slot[s] != 0; s = (s + 1) & mask) {
+                uint32_t g = slot[s] - 1;
+                if (hash[g] != h) continue;
+                size_t k = 0;
+                while (k < nk && keys[g * nk + k] == key(k)) k++;
+                if (k == nk) return g;
+            }
+            uint32_t g = hash.size();
+            hash.push_back(h);
+            for (size_t k = 0; k < nk; k++) keys.push_back(key(k));
+            cnt.push_back(0);
+            for (size_t a = 0; a < na; a++) acc.push_back(aggrInit((*aggrs)[a].op));
+            slot[s] = g + 1;
+            // keep the load under a half
+            if (2 * hash.size() > slot.size()) {
+                std::vector<uint32_t>(2 * slot.size(), 0).swap(slot);
+                const size_t m = slot.size() - 1;
+                for (size_t i = 0; i < hash.size(); i++) {
+                    size_t t = hash[i] & m;
+                    while (slot[t] != 0) t = (t + 1) & m;
+                    slot[t] = i + 1;
+                }
+            }
+            return g;
+        };
+    };
+
+    // fold value x into acc, min and max compare unsigned as the hash group aggregate does
+    static void aggrMerge(int op, uint64_t& acc, uint64_t x) {
+        using namespace xf::database;
+        if (op == AOP_MIN) {
+            acc = std::min(acc, x);
+        } else if (op == AOP_MAX) {
+            acc = std::max(acc, x);
+        } else if (op == AOP_SUM || op == AOP_MEAN || op == AOP_COUNTNONZEROS) {
+            acc += x;
+        }
+    };
+
+    int groupBy(const PlanNode& n, const CpuCols& in, CpuCols& res) {
+        using namespace xf::database;
+        const size_t nk = n.cols.size() - n.aggrs.size();
+        const size_t na = n.aggrs.size();
+        if (nk > PLAN_MAX_COL) {
+            std::cerr << "ERROR: group by on " << nk << " keys, at most " << PLAN_MAX_COL << " are supported."
+                      << std::endl;
+            return -1;
+        }
+        std::vector<const int32_t*> kc(nk), ac(na, (const int32_t*)0);
+        for (size_t k = 0; k < nk; k++) {
+            int c = need(in, n.cols[k]);
+            if (c < 0) return -1;
+            kc[k] = in.lo[c];
+        }
+        for (size_t a = 0; a < na; a++) {
+            if (n.aggrs[a].op < AOP_MIN || n.aggrs[a].op > AOP_MEAN) {
+                std::cerr << "ERROR: aggregate " << n.aggrs[a].name << " uses an unsupported op." << std::endl;
+                return -1;
+            }
+            if (n.aggrs[a].col.empty()) continue;
+            int c = need(in, n.aggrs[a].col);
+            if (c < 0) return -1;
+            ac[a] = in.lo[c];
+        }
+
+        std::vector<GroupPart> part(nth);
+        for (int w = 0; w < nth; w++) {
+            part[w].nk = nk;
+            part[w].na = na;
+            part[w].aggrs = &n.aggrs;
+        }
+        parallel(in.nrow, [&](int w, size_t, size_t b, size_t e) {
+            GroupPart& p = part[w];
+            // keys are hashed one column at a time, then each row finds its group, a run of one key probes once
+            std::vector<uint64_t> h(e - b, 0);
+            for (size_t k = 0; k < nk; k++) {
+                const int32_t* x = kc[k] + b;
+                for (size_t i = 0; i < e - b; i++) h[i] = (h[i] ^ (uint32_t)x[i]) * 0x100000001b3ULL;
+            }
+            for (size_t i = 0; i < e - b; i++) h[i] = groupMix(h[i]);
+            std::vector<uint32_t> gid(e - b);
+            for (size_t i = 0; i < e - b; i++) {
+                const size_t r = b + i;
+                bool same = i > 0 && h[i] == h[i - 1];
+                for (size_t k = 0; same && k < nk; k++) same = kc[k][r] == kc[k][r - 1];
+                gid[i] = same ? gid[i - 1] : p.group(h[i], [&](size_t c) { return (uint32_t)kc[c][r]; });
+                p.cnt[gid[i]]++;
+            }
+            // one aggregate at a time over the morsel
+            for (size_t a = 0; a < na; a++) {
+                const uint32_t* x = (const uint32_t*)ac[a];
+                uint64_t* acc = p.acc.data() + a;
+                switch (n.aggrs[a].op) {
+                    case AOP_MIN:
+                        for (size_t i = b; i < e; i++) {
+                            uint64_t& s = acc[gid[i - b] * na];
+                            s = std::min<uint64_t>(s, x[i]);
+                        }
+                        break;
+                    case AOP_MAX:
+                        for (size_t i = b; i < e; i++) {
+                            uint64_t& s = acc[gid[i - b] * na];
+                            s = std::max<uint64_t>(s, x[i]);
+                        }
+                        break;
+                    case AOP_SUM:
+                    case AOP_MEAN:
+                        for (size_t i = b; i < e; i++) acc[gid[i - b] * na] += x[i];
+                        break;
+                    case AOP_COUNTNONZEROS:
+                        for (size_t i = b; i < e; i++) acc[gid[i - b] * na] += x[i] != 0;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        });
+
+        // merge worker tables into the first one
+        GroupPart& g = part[0];
+        for (int w = 1; w < nth; w++) {
+            GroupPart& p = part[w];
+            for (size_t i = 0; i < p.hash.size(); i++) {
+                const uint32_t* key = &p.keys[i * nk];
+                uint32_t d = g.group(p.hash[i], [&](size_t c) { return key[c]; });
+                g.cnt[d] += p.cnt[i];
+                for (size_t a = 0; a < na; a++) aggrMerge(n.aggrs[a].op, g.acc[d * na + a], p.acc[i * na + a]);
+            }
+            GroupPart().slot.swap(p.slot);
+        }
+
+        std::shared_ptr<CpuTable> t(new CpuTable());
+        t->nrow = g.hash.size();
+        for (size_t k = 0; k < nk; k++) t->addCol(n.cols[k]);
+        for (size_t a = 0; a < na; a++) {
+            int op = n.aggrs[a].op;
+            t->addCol(n.aggrs[a].name, op == AOP_SUM || op == AOP_MEAN);
+        }
+        for (size_t r = 0; r < t->nrow; r++) {
+            for (size_t k = 0; k < nk; k++) t->data[k][r] = g.keys[r * nk + k];
+            for (size_t a = 0; a < na; a++) {
+                int op = n.aggrs[a].op;
+                uint64_t v = g.acc[r * na + a];
+                if (op == AOP_COUNT) v = g.cnt[r];
+                if (op == AOP_MEAN) v = g.cnt[r] ? v / g.cnt[r] : (uint64_t)-1;
+                t->data[nk + a][r] = (uint32_t)v;
+                if (!t->hi[nk + a].empty()) t->hi[nk + a][r] = (uint32_t)(v >> 32);
+            }
+        }
+        res = CpuCols();
+        res.own(t);
+        return 0;
+    };
+
+    // ------------------------------- aggregate ------------------------------
+
+#ifdef __AVX2__
+    // min, max, sum and non-zero count of v[b, e) 8 rows at a time, returns the first row left for the scalar loop
+    static size_t aggrAvx2(const int32_t* v, size_t b, size_t e, int32_t& mn, int32_t& mx, int64_t& sum, int64_t& nz) {
+        __m256i vmn = _mm256_set1_epi32(mn);
+        __m256i vmx = _mm256_set1_epi32(mx);
+        __m256i s0 = _mm256_setzero_si256();
+        __m256i s1 = _mm256_setzero_si256();
+        __m256i z = _mm256_setzero_si256(); // zeros per lane, as subtracting -1 of each zero
+        size_t i = b;
+        for (; i + 8 <= e; i += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(v + i));
+            vmn = _mm256_min_epi32(vmn, x);
+            vmx = _mm256_max_epi32(vmx, x);
+            s0 = _mm256_add_epi64(s0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+            s1 = _mm256_add_epi64(s1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+            z = _mm256_sub_epi32(z, _mm256_cmpeq_epi32(x, _mm256_setzero_si256()));
+        }
+        int32_t lmn[8], lmx[8], lz[8];
+        int64_t ls[8];
+        _mm256_storeu_si256((__m256i*)lmn, vmn);
+        _mm256_storeu_si256((__m256i*)lmx, vmx);
+        _mm256_storeu_si256((__m256i*)lz, z);
+        _mm256_storeu_si256((__m256i*)ls, s0);
+        _mm256_storeu_si256((__m256i*)(ls + 4), s1);
+        nz += i - b;
+        for (int l = 0; l < 8; l++) {
+            mn = std::min(mn, lmn[l]);
+            mx = std::max(mx, lmx[l]);
+            sum += ls[l];
+            nz -= lz[l];
+        }
+        return i;
+    };
+#endif
+
+    int aggregate(const PlanNode& n, const CpuCols& in, CpuCols& res) {
+        const size_t nc = n.cols.size();
+        std::vector<const int32_t*> x(nc);
+        for (size_t c = 0; c < nc; c++) {
+            int i = need(in, n.cols[c]);
+            if (i < 0) return -1;
+            x[c] = in.lo[i];
+        }
+        // per worker and column: min, max, sum, count non-zero
+        std::vector<int64_t> acc(nth * nc * 4);
+        for (int w = 0; w < nth; w++) {
+            for (size_t c = 0; c < nc; c++) {
+                int64_t* s = &acc[(w * nc + c) * 4];
+                s[0] = INT32_MAX;
+                s[1] = INT32_MIN;
+                s[2] = 0;
+                s[3] = 0;
+            }
+        }
+        parallel(in.nrow, [&](int w, size_t, size_t b, size_t e) {
+            for (size_t c = 0; c < nc; c++) {
+                const int32_t* v = x[c];
+                int32_t mn = INT32_MAX, mx = INT32_MIN;
+                int64_t sum = 0, nz = 0;
+#ifdef __AVX2__
+                const size_t i0 = aggrAvx2(v, b, e, mn, mx, sum, nz);
+#else
+                const size_t i0 = b;
+#endif
+                for (size_t i = i0; i < e; i++) {
+                    mn = std::min(mn, v[i]);
+                    mx = std::max(mx, v[i]);
+                    sum += v[i];
+                    nz += v[i] != 0;
+                }
+                int64_t* s = &acc[(w * nc + c) * 4];
+                s[0] = std::min<int64_t>(s[0], mn);
+                s[1] = std::max<int64_t>(s[1], mx);
+                s[2] += sum;
+                s[3] += nz;
+            }
+        });
+        std::shared_ptr<CpuTable> t(new CpuTable());
+        t->nrow = in.nrow ? 6 : 0;
+        for (size_t c = 0; c < nc; c++) t->addCol(n.cols[c]);
+        for (size_t c = 0; c < nc && in.nrow; c++) {
+            int64_t s[4] = {INT32_MAX, INT32_MIN, 0, 0};
+            for (int w = 0; w < nth; w++) {
+                const int64_t* p = &acc[(w * nc + c) * 4];
+                s[0] = std::min(s[0], p[0]);
+                s[1] = std::max(s[1], p[1]);
+                s[2] += p[2];
+                s[3] += p[3];
+            }
+            int32_t* o = t->data[c].data();
+            o[0] = (int32_t)s[0];
+            o[1] = (int32_t)s[1];
+            o[2] = (int32_t)(uint32_t)s[2];
+            o[3] = (int32_t)(s[2] >> 32);
+            o[4] = (int32_t)in.nrow;
+            o[5] = (int32_t)s[3];
+        }
+        res = CpuCols();
+        res.own(t);
+        return 0;
+    };
+};
+
+#endif // _GQE_CPU_H
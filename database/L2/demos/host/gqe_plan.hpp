@@ -0,0 +1,1019 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _GQE_PLAN_H
+#define _GQE_PLAN_H
+
+#include "ap_int.h"
+#include "xf_database/dynamic_alu_host.hpp"
+#include "xf_database/enums.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/* gqe_plan.hpp compiles a relational plan over named columns into GQE kernel configurations.
+ *
+ * A QueryPlan is built bottom-up with scan(), filter(), join(), project(), groupBy() and aggregate(),
+ * every builder returns the id of the new node or -1 when a referenced column does not exist.
+ * compile() cuts the plan into kernel steps, each one run of
+ *
+ *   gqeJoin: scan A,B -> filter A,B -> shuffle1a,1b -> hash join -> shuffle2 -> eval1 -> shuffle3 -> eval2
+ *            -> shuffle4 -> aggregate -> write, with the join off only table A is scanned and shuffle2 is skipped.
+ *   gqeAggr: scan -> eval1 -> shuffle1 -> eval2 -> shuffle2 -> filter -> shuffle3 (key), shuffle4 (pld)
+ *            -> group aggregate -> merge -> write.
+ *
+ * and packs the 9 x 512-bit cfgCmd or the 128 x 32-bit AggrCfgCmd words of the step, the same words the
+ * hand-written get_cfg_dat_N() functions produce. Operators are fused into a step as long as the kernel can hold
+ * them, whatever does not fit is lowered into an earlier step and read back as an intermediate table.
+ * Kernel limits are checked during lowering, violations are reported as "ERROR:" lines and compile() returns -1.
+ *
+ * The PlanSchedule lists the steps in dependency order. Each step names the base table or earlier step feeding
+ * its input ports, the steps it waits on and the column held by each output slot, which is also the column index
+ * of the output table. Steps of equal level do not depend on each other and may be enqueued together.
+ * */
+
+#define PLAN_MAX_COL 8       // columns through scan, shuffle and write of gqeJoin
+#define PLAN_MAX_COND 4      // column slots of one dynamic filter
+#define PLAN_MAX_EVAL 2      // dynamic ALU stages per kernel
+#define PLAN_MAX_STRM 4      // operands of one dynamic ALU
+#define PLAN_JOIN_PLD 6      // payload columns per side through hash join
+#define PLAN_JOIN_OUT 14     // hash join output: 6 probe payload, 6 build payload, 2 key
+#define PLAN_AGGR_OUT_COL 16 // output slots of gqeAggr
+
+enum PlanNodeType { PLAN_SCAN = 0, PLAN_FILTER, PLAN_JOIN, PLAN_PROJECT, PLAN_GROUPBY, PLAN_AGGREGATE };
+
+// one filter predicate, col <lop> lo && col <rop> hi, or col <lop> col2 when col2 is given.
+struct PlanCond {
+    std::string col;
+    int lop;
+    uint32_t lo;
+    int rop;
+    uint32_t hi;
+    std::string col2;
+};
+
+// lo <= col < hi, unsigned as used for dates
+inline PlanCond planRange(const std::string& col, uint32_t lo, uint32_t hi) {
+    using namespace xf::database;
+    PlanCond c = {col, FOP_GEU, lo, FOP_LTU, hi, ""};
+    return c;
+}
+
+// col <op> v, lower bound ops go to the left comparator, upper bound ops to the right one
+inline PlanCond planCmp(const std::string& col, int op, uint32_t v) {
+    using namespace xf::database;
+    PlanCond c = {col, FOP_DC, 0, FOP_DC, 0, ""};
+    if (op == FOP_LT || op == FOP_LE || op == FOP_LTU || op == FOP_LEU) {
+        c.rop = op;
+        c.hi = v;
+    } else {
+        c.lop = op;
+        c.lo = v;
+    }
+    return c;
+}
+
+// col <op> col2
+inline PlanCond planColCmp(const std::string& col, int op, const std::string& col2) {
+    using namespace xf::database;
+    PlanCond c = {col, op, 0, FOP_DC, 0, col2};
+    return c;
+}
+
+// one dynamic ALU expression, strm lists the columns bound to strm1..strm4 of the formula.
+struct PlanExpr {
+    std::string name;
+    std::string formula;
+    std::vector<std::string> strm;
+    uint32_t c[4];
+};
+
+inline PlanExpr planExpr(const std::string& name,
+                         const std::string& formula,
+                         const std::vector<std::string>& strm,
+                         uint32_t c1 = 0,
+                         uint32_t c2 = 0,
+                         uint32_t c3 = 0,
+                         uint32_t c4 = 0) {
+    PlanExpr e;
+    e.name = name;
+    e.formula = formula;
+    e.strm = strm;
+    e.c[0] = c1;
+    e.c[1] = c2;
+    e.c[2] = c3;
+    e.c[3] = c4;
+    return e;
+}
+
+// one group aggregate, op is AOP_MIN to AOP_MEAN, col may be empty for AOP_COUNT.
+struct PlanAggr {
+    std::string name;
+    int op;
+    std::string col;
+};
+
+struct PlanNode {
+    PlanNodeType type;
+    std::vector<int> in;
+    std::string table;
+    // output columns of the node
+    std::vector<std::string> cols;
+    std::vector<PlanCond> conds;
+    std::vector<std::string> keys[2];
+    int join_type;
+    // build a bloom filter from the build keys and drop probe rows before hash join
+    bool bloom;
+    std::vector<PlanExpr> exprs;
+    std::vector<PlanAggr> aggrs;
+};
+
+// an input port, a base table when table is set, otherwise the output of an earlier step, unused if step < 0.
+struct PlanPort {
+    std::string table;
+    int step;
+    PlanPort() : step(-1){};
+};
+
+struct PlanStep {
+    std::string kernel;
+    PlanPort in[2];
+    std::vector<int> deps;
+    int level;
+    // name of the column in each output slot, "" when the slot is not written
+    std::vector<std::string> out_cols;
+    // gqeAggr: slot holding the high 32 bits of a sum or mean, -1 when only the low half is kept
+    std::vector<int> out_hi;
+    // gqeJoin aggregate on, each column is reduced to 6 rows: min, max, sum low, sum high, count, count non-zero
+    bool direct_aggr;
+    ap_uint<512> join_cfg[9];
+    ap_uint<32> aggr_cfg[128];
+
+    PlanStep() : level(0), direct_aggr(false) {
+        for (int i = 0; i < 9; i++) join_cfg[i] = 0;
+        for (int i = 0; i < 128; i++) aggr_cfg[i] = 0;
+    };
+
+    // copy the packed words into cfgCmd::cmd or AggrCfgCmd::cmd
+    void fill(ap_uint<512>* cmd) const {
+        for (int i = 0; i < 9; i++) cmd[i] = join_cfg[i];
+    };
+    void fill(ap_uint<32>* cmd) const {
+        for (int i = 0; i < 128; i++) cmd[i] = aggr_cfg[i];
+    };
+
+    int outCol(const std::string& name) const {
+        for (size_t i = 0; i < out_cols.size(); i++) {
+            if (out_cols[i] == name) return i;
+        }
+        return -1;
+    };
+};
+
+struct PlanSchedule {
+    std::vector<PlanStep> steps;
+
+    int levels() const {
+        int n = 0;
+        for (size_t i = 0; i < steps.size(); i++) {
+            if (steps[i].level + 1 > n) n = steps[i].level + 1;
+        }
+        return n;
+    };
+
+    void print() const {
+        for (size_t i = 0; i < steps.size(); i++) {
+            const PlanStep& s = steps[i];
+            std::cout << "step " << i << " (level " << s.level << "): " << s.kernel;
+            const char* port[2] = {" A=", " B="};
+            for (int p = 0; p < 2; p++) {
+                if (!s.in[p].table.empty()) {
+                    std::cout << port[p] << s.in[p].table;
+                } else if (s.in[p].step >= 0) {
+                    std::cout << port[p] << "step" << s.in[p].step;
+                }
+            }
+            std::cout << (s.direct_aggr ? " aggr ->" : " ->");
+            for (size_t c = 0; c < s.out_cols.size(); c++) {
+                if (!s.out_cols[c].empty()) std::cout << " " << c << ":" << s.out_cols[c];
+            }
+            std::cout << std::endl;
+        }
+    };
+};
+
+/* filter config of one kernel input, slot i holds the column at position i of the filtered stream. */
+class PlanFilterCfg {
+   public:
+    std::vector<std::string> col;
+    uint32_t lo[PLAN_MAX_COND];
+    uint32_t hi[PLAN_MAX_COND];
+    int lop[PLAN_MAX_COND];
+    int rop[PLAN_MAX_COND];
+    // column compare of slot pairs 0-1, 0-2, 0-3, 1-2, 1-3, 2-3
+    int cmp[6];
+
+    PlanFilterCfg() {
+        for (int i = 0; i < PLAN_MAX_COND; i++) {
+            lo[i] = hi[i] = 0;
+            lop[i] = rop[i] = xf::database::FOP_DC;
+        }
+        for (int i = 0; i < 6; i++) cmp[i] = xf::database::FOP_DC;
+    };
+
+    bool add(const PlanCond& c) {
+        using namespace xf::database;
+        if (!c.col2.empty()) return addColCmp(c);
+        if (c.lop != FOP_DC && !isLop(c.lop)) return false;
+        if (c.rop != FOP_DC && !isRop(c.rop)) return false;
+        for (size_t i = 0; i < col.size(); i++) {
+            if (col[i] == c.col && (c.lop == FOP_DC || lop[i] == FOP_DC) && (c.rop == FOP_DC || rop[i] == FOP_DC)) {
+                set(i, c);
+                return true;
+            }
+        }
+        if (col.size() == PLAN_MAX_COND) return false;
+        col.push_back(c.col);
+        set(col.size() - 1, c);
+        return true;
+    };
+
+    // 4 x (lo, hi, op) + compare ops + true table of all conditions and-ed, as gen_fcfg_N()
+    void gen(uint32_t cfg[45]) const {
+        using namespace xf::database;
+        int n = 0;
+        for (int i = 0; i < PLAN_MAX_COND; i++) {
+            cfg[n++] = lo[i];
+            cfg[n++] = hi[i];
+            cfg[n++] = 0UL | (lop[i] << FilterOpWidth) | (rop[i]);
+        }
+        uint32_t r = 0;
+        int sh = 0;
+        for (int i = 0; i < 6; i++) {
+            r |= ((uint32_t)(cmp[i] << sh));
+            sh += FilterOpWidth;
+        }
+        cfg[n++] = r;
+        // DC compares are true, so only the all-true address passes
+        for (int i = 0; i < 31; i++) {
+            cfg[n++] = (uint32_t)0UL;
+        }
+        cfg[n++] = (uint32_t)(1UL << 31);
+    };
+
+   private:
+    static bool isLop(int op) {
+        using namespace xf::database;
+        return op == FOP_EQ || op == FOP_NE || op == FOP_GT || op == FOP_GE || op == FOP_GTU || op == FOP_GEU;
+    };
+    static bool isRop(int op) {
+        using namespace xf::database;
+        return op == FOP_EQ || op == FOP_NE || op == FOP_LT || op == FOP_LE || op == FOP_LTU || op == FOP_LEU;
+    };
+
+    void set(int i, const PlanCond& c) {
+        using namespace xf::database;
+        if (c.lop != FOP_DC) {
+            lop[i] = c.lop;
+            lo[i] = c.lo;
+        }
+        if (c.rop != FOP_DC) {
+            rop[i] = c.rop;
+            hi[i] = c.hi;
+        }
+    };
+
+    int slot(const std::string& name) {
+        for (size_t i = 0; i < col.size(); i++) {
+            if (col[i] == name) return i;
+        }
+        if (col.size() == PLAN_MAX_COND) return -1;
+        col.push_back(name);
+        return col.size() - 1;
+    };
+
+    bool addColCmp(const PlanCond& c) {
+        using namespace xf::database;
+        std::vector<std::string> saved = col;
+        int a = slot(c.col);
+        int b = slot(c.col2);
+        if (a < 0 || b < 0 || a == b) {
+            col = saved;
+            return false;
+        }
+        int op = c.lop;
+        if (op < FOP_DC || op > FOP_LEU) {
+            col = saved;
+            return false;
+        }
+        if (a > b) {
+            int t = a;
+            a = b;
+            b = t;
+            // swap the operands of the compare
+            const int flip[] = {FOP_DC, FOP_EQ, FOP_NE,  FOP_LT,  FOP_GT, FOP_LE,
+                                FOP_GE, FOP_LTU, FOP_GTU, FOP_LEU, FOP_GEU};
+            op = flip[op];
+        }
+        const int pair[PLAN_MAX_COND][PLAN_MAX_COND] = {
+            {-1, 0, 1, 2}, {-1, -1, 3, 4}, {-1, -1, -1, 5}, {-1, -1, -1, -1}};
+        int p = pair[a][b];
+        if (cmp[p] != FOP_DC) {
+            col = saved;
+            return false;
+        }
+        cmp[p] = op;
+        return true;
+    };
+};
+
+class QueryPlan {
+   public:
+    std::vector<PlanNode> nodes;
+
+    int scan(const std::string& table, const std::vector<std::string>& cols) {
+        PlanNode n = node(PLAN_SCAN);
+        n.table = table;
+        n.cols = cols;
+        return push(n);
+    };
+
+    int filter(int in, const std::vector<PlanCond>& conds) {
+        if (!valid(in)) return -1;
+        PlanNode n = node(PLAN_FILTER);
+        n.in.push_back(in);
+        n.cols = nodes[in].cols;
+        n.conds = conds;
+        for (size_t i = 0; i < conds.size(); i++) {
+            if (!has(in, conds[i].col) || (!conds[i].col2.empty() && !has(in, conds[i].col2))) return -1;
+        }
+        return push(n);
+    };
+
+    // build is scanned as table A, probe as table B. cols lists the output, either side may be named,
+    // semi and anti join only return probe columns. JT_LEFT keeps unmatched probe rows, JT_RIGHT unmatched
+    // build rows and JT_FULL both, the missing side reads as zero. bloom pushes a bloom filter of the build
+    // keys into the probe side, worth it when few probe rows match, it is dropped when probe rows are kept.
+    int join(int build,
+             int probe,
+             const std::vector<std::string>& build_keys,
+             const std::vector<std::string>& probe_keys,
+             const std::vector<std::string>& cols,
+             int type = xf::database::JT_INNER,
+             bool bloom = false) {
+        using namespace xf::database;
+        if (!valid(build) || !valid(probe)) return -1;
+        if (build_keys.empty() || build_keys.size() > 2 || build_keys.size() != probe_keys.size()) {
+            std::cerr << "ERROR: join needs 1 or 2 key columns on each side." << std::endl;
+            return -1;
+        }
+        if (type != JT_INNER && type != JT_SEMI && type != JT_ANTI && type != JT_LEFT && type != JT_RIGHT &&
+            type != JT_FULL) {
+            std::cerr << "ERROR: join type " << type << " is not supported by gqeJoin." << std::endl;
+            return -1;
+        }
+        PlanNode n = node(PLAN_JOIN);
+        n.in.push_back(build);
+        n.in.push_back(probe);
+        n.keys[0] = build_keys;
+        n.keys[1] = probe_keys;
+        n.join_type = type;
+        n.bloom = bloom && type != JT_ANTI && type != JT_LEFT && type != JT_FULL;
+        n.cols = cols;
+        for (size_t k = 0; k < build_keys.size(); k++) {
+            if (!has(build, build_keys[k]) || !has(probe, probe_keys[k])) return -1;
+        }
+        for (size_t i = 0; i < cols.size(); i++) {
+            bool in_b = find(nodes[build].cols, cols[i]) >= 0;
+            bool in_p = find(nodes[probe].cols, cols[i]) >= 0;
+            if (!in_b && !in_p) {
+                std::cerr << "ERROR: column " << cols[i] << " is on neither side of the join." << std::endl;
+                return -1;
+            }
+            if (in_b && in_p && keyIndex(n, cols[i]) < 0) {
+                std::cerr << "ERROR: column " << cols[i] << " is ambiguous in the join." << std::endl;
+                return -1;
+            }
+            if ((type == JT_SEMI || type == JT_ANTI) && !in_p) {
+                std::cerr << "ERROR: semi/anti join cannot return build column " << cols[i] << "." << std::endl;
+                return -1;
+            }
+        }
+        return push(n);
+    };
+
+    // output is cols followed by the expression results
+    int project(int in, const std::vector<std::string>& cols, const std::vector<PlanExpr>& exprs) {
+        if (!valid(in)) return -1;
+        PlanNode n = node(PLAN_PROJECT);
+        n.in.push_back(in);
+        n.cols = cols;
+        n.exprs = exprs;
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (!has(in, cols[i])) return -1;
+        }
+        for (size_t e = 0; e < exprs.size(); e++) {
+            if (exprs[e].strm.empty() || exprs[e].strm.size() > PLAN_MAX_STRM) {
+                std::cerr << "ERROR: expression " << exprs[e].name << " needs 1 to " << PLAN_MAX_STRM << " columns."
+                          << std::endl;
+                return -1;
+            }
+            for (size_t s = 0; s < exprs[e].strm.size(); s++) {
+                if (!has(in, exprs[e].strm[s])) return -1;
+            }
+            n.cols.push_back(exprs[e].name);
+        }
+        return push(n);
+    };
+
+    // output is keys followed by the aggregates
+    int groupBy(int in, const std::vector<std::string>& keys, const std::vector<PlanAggr>& aggrs) {
+        using namespace xf::database;
+        if (!valid(in)) return -1;
+        PlanNode n = node(PLAN_GROUPBY);
+        n.in.push_back(in);
+        n.cols = keys;
+        n.aggrs = aggrs;
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (!has(in, keys[i])) return -1;
+        }
+        for (size_t i = 0; i < aggrs.size(); i++) {
+            if (aggrs[i].op < AOP_MIN || aggrs[i].op > AOP_MEAN) {
+                std::cerr << "ERROR: aggregate " << aggrs[i].name << " uses an op hash aggregate does not support."
+                          << std::endl;
+                return -1;
+            }
+            if (!(aggrs[i].op == AOP_COUNT && aggrs[i].col.empty()) && !has(in, aggrs[i].col)) return -1;
+            n.cols.push_back(aggrs[i].name);
+        }
+        return push(n);
+    };
+
+    // reduce each column to min, max, sum and counts without grouping
+    int aggregate(int in, const std::vector<std::string>& cols) {
+        if (!valid(in)) return -1;
+        PlanNode n = node(PLAN_AGGREGATE);
+        n.in.push_back(in);
+        n.cols = cols;
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (!has(in, cols[i])) return -1;
+        }
+        return push(n);
+    };
+
+    /* lower the plan under root into kernel steps, return 0 on success, -1 if a kernel limit is exceeded */
+    int compile(int root, PlanSchedule& sch) {
+        sch.steps.clear();
+        lowered.clear();
+        if (!valid(root)) return -1;
+        PlanSrc src;
+        if (nodes[root].type == PLAN_SCAN) {
+            // a plain scan still needs one kernel pass to come out as a table
+            return lowerJoinStep(root, sch) < 0 ? -1 : 0;
+        }
+        return lowerSource(root, sch, src);
+    };
+
+   private:
+    // a table a kernel can scan, slot i holds column cols[i]
+    struct PlanSrc {
+        PlanPort port;
+        std::vector<std::string> cols;
+    };
+
+    std::map<int, int> lowered;
+
+    static PlanNode node(PlanNodeType t) {
+        PlanNode n;
+        n.type = t;
+        n.join_type = 0;
+        n.bloom = false;
+        return n;
+    };
+
+    int push(const PlanNode& n) {
+        nodes.push_back(n);
+        return nodes.size() - 1;
+    };
+
+    bool valid(int id) const { return id >= 0 && id < (int)nodes.size(); };
+
+    static int find(const std::vector<std::string>& v, const std::string& s) {
+        for (size_t i = 0; i < v.size(); i++) {
+            if (v[i] == s) return i;
+        }
+        return -1;
+    };
+
+    bool has(int id, const std::string& col) const {
+        if (find(nodes[id].cols, col) < 0) {
+            std::cerr << "ERROR: column " << col << " is not produced by plan node " << id << "." << std::endl;
+            return false;
+        }
+        return true;
+    };
+
+    static int keyIndex(const PlanNode& j, const std::string& col) {
+        for (size_t k = 0; k < j.keys[0].size(); k++) {
+            if (j.keys[0][k] == col || j.keys[1][k] == col) return k;
+        }
+        return -1;
+    };
+
+    // front keeps its order and duplicates, then the rest not yet present are appended
+    static bool layout(const std::vector<std::string>& front,
+                       const std::vector<std::string>& rest,
+                       size_t max,
+                       std::vector<std::string>& out) {
+        out = front;
+        for (size_t i = 0; i < rest.size(); i++) {
+            if (!rest[i].empty() && find(out, rest[i]) < 0) out.push_back(rest[i]);
+        }
+        if (out.size() > max) {
+            std::cerr << "ERROR: " << out.size() << " columns are live in one kernel stage, at most " << max
+                      << " fit:";
+            for (size_t i = 0; i < out.size(); i++) std::cerr << " " << out[i];
+            std::cerr << std::endl;
+            return false;
+        }
+        return true;
+    };
+
+    // byte c of the shuffle is the input index of output column c, -1 when unused
+    static bool shuffle(const std::vector<std::string>& in, const std::vector<std::string>& out, ap_uint<64>& cfg) {
+        for (int c = 0; c < PLAN_MAX_COL; c++) {
+            int id = -1;
+            if (c < (int)out.size()) {
+                id = find(in, out[c]);
+                if (id < 0) {
+                    std::cerr << "ERROR: column " << out[c] << " is not available for shuffle." << std::endl;
+                    return false;
+                }
+            }
+            signed char b = id;
+            cfg.range(8 * c + 7, 8 * c) = (unsigned char)b;
+        }
+        return true;
+    };
+
+    static bool scanIds(const PlanSrc& src, const std::vector<std::string>& cols, signed char id[PLAN_MAX_COL]) {
+        for (int c = 0; c < PLAN_MAX_COL; c++) {
+            id[c] = -1;
+            if (c < (int)cols.size()) {
+                int i = find(src.cols, cols[c]);
+                if (i < 0) {
+                    std::cerr << "ERROR: column " << cols[c] << " is not in the scanned table." << std::endl;
+                    return false;
+                }
+                id[c] = i;
+            }
+        }
+        return true;
+    };
+
+    static bool compileAlu(const PlanExpr* e, ap_uint<289>& op) {
+        op = 0;
+        if (!e) return true;
+        bool ok = xf::database::dynamicALUOPCompiler<uint32_t, uint32_t, uint32_t, uint32_t>(
+            e->formula.c_str(), e->c[0], e->c[1], e->c[2], e->c[3], op);
+        if (!ok) {
+            std::cerr << "ERROR: dynamic ALU cannot compile " << e->formula << "." << std::endl;
+        }
+        return ok;
+    };
+
+    /* lay out columns backward through two eval stages.
+     * need is the layout after the second eval, l0 and l1 are the layouts feeding eval1 and eval2,
+     * i.e. the operands of each expression are in front. */
+    static bool evalLayouts(const std::vector<const PlanExpr*>& ev,
+                            const std::vector<std::string>& need,
+                            std::vector<std::string>& l0,
+                            std::vector<std::string>& l1) {
+        std::vector<std::string> rest;
+        std::vector<std::string> front;
+        for (size_t i = 0; i < need.size(); i++) {
+            if (!ev[1] || need[i] != ev[1]->name) rest.push_back(need[i]);
+        }
+        if (ev[1]) front = ev[1]->strm;
+        if (!layout(front, rest, PLAN_MAX_COL, l1)) return false;
+
+        rest.clear();
+        front.clear();
+        for (size_t i = 0; i < l1.size(); i++) {
+            if (!ev[0] || l1[i] != ev[0]->name) rest.push_back(l1[i]);
+        }
+        if (ev[0]) front = ev[0]->strm;
+        return layout(front, rest, PLAN_MAX_COL, l0);
+    };
+
+    // input names of the shuffle after an eval, the result comes in as the 9th column
+    static std::vector<std::string> withEval(const std::vector<std::string>& l, const PlanExpr* e) {
+        std::vector<std::string> r = l;
+        r.resize(PLAN_MAX_COL);
+        r.push_back(e ? e->name : "");
+        return r;
+    };
+
+    // collect up to 2 eval stages from a chain of projects, inner first
+    bool collectEvals(int& n, std::vector<const PlanExpr*>& ev) {
+        std::vector<int> projs;
+        int cnt = 0;
+        while (nodes[n].type == PLAN_PROJECT && cnt + nodes[n].exprs.size() <= PLAN_MAX_EVAL) {
+            cnt += nodes[n].exprs.size();
+            projs.push_back(n);
+            n = nodes[n].in[0];
+        }
+        if (projs.empty() && nodes[n].type == PLAN_PROJECT) {
+            std::cerr << "ERROR: project node " << n << " has " << nodes[n].exprs.size() << " expressions, at most "
+                      << PLAN_MAX_EVAL << " fit in one kernel." << std::endl;
+            return false;
+        }
+        ev.clear();
+        for (int i = projs.size() - 1; i >= 0; i--) {
+            for (size_t e = 0; e < nodes[projs[i]].exprs.size(); e++) ev.push_back(&nodes[projs[i]].exprs[e]);
+        }
+        ev.resize(PLAN_MAX_EVAL, (const PlanExpr*)0);
+        return true;
+    };
+
+    static bool addConds(const PlanNode& flt, PlanFilterCfg& f) {
+        bool ok = true;
+        for (size_t i = 0; ok && i < flt.conds.size(); i++) ok = f.add(flt.conds[i]);
+        return ok;
+    };
+
+    // merge a chain of filters into one config, stops at the first one that does not fit
+    bool collectFilters(int& n, PlanFilterCfg& f) {
+        while (nodes[n].type == PLAN_FILTER) {
+            PlanFilterCfg t = f;
+            if (!addConds(nodes[n], t)) {
+                PlanFilterCfg e;
+                if (!addConds(nodes[n], e)) {
+                    std::cerr << "ERROR: filter node " << n << " needs more than " << PLAN_MAX_COND
+                              << " column slots or an op the comparator does not have." << std::endl;
+                    return false;
+                }
+                break;
+            }
+            f = t;
+            n = nodes[n].in[0];
+        }
+        return true;
+    };
+
+    int addStep(PlanSchedule& sch, PlanStep& s) {
+        s.level = 0;
+        for (size_t i = 0; i < s.deps.size(); i++) {
+            int l = sch.steps[s.deps[i]].level + 1;
+            if (l > s.level) s.level = l;
+        }
+        sch.steps.push_back(s);
+        return sch.steps.size() - 1;
+    };
+
+    static void usePort(PlanStep& s, int p, const PlanSrc& src) {
+        s.in[p] = src.port;
+        if (src.port.step >= 0 && find_dep(s.deps, src.port.step) < 0) s.deps.push_back(src.port.step);
+    };
+
+    static int find_dep(const std::vector<int>& v, int d) {
+        for (size_t i = 0; i < v.size(); i++) {
+            if (v[i] == d) return i;
+        }
+        return -1;
+    };
+
+    // scan a base table directly, anything else becomes a step first
+    int lowerSource(int n, PlanSchedule& sch, PlanSrc& src) {
+        if (nodes[n].type == PLAN_SCAN) {
+            src.port.table = nodes[n].table;
+            src.port.step = -1;
+            src.cols = nodes[n].cols;
+            return 0;
+        }
+        std::map<int, int>::iterator it = lowered.find(n);
+        int s = -1;
+        if (it != lowered.end()) {
+            s = it->second;
+        } else {
+            s = nodes[n].type == PLAN_GROUPBY ? lowerAggrStep(n, sch) : lowerJoinStep(n, sch);
+            if (s < 0) return -1;
+            lowered[n] = s;
+        }
+        src.port.table = "";
+        src.port.step = s;
+        src.cols = sch.steps[s].out_cols;
+        return 0;
+    };
+
+    // one gqeJoin pass: [aggregate] <- [project]x2 <- (join of filtered sides | filter | source)
+    int lowerJoinStep(int root, PlanSchedule& sch) {
+        using namespace xf::database;
+        PlanStep s;
+        s.kernel = "gqeJoin";
+        int n = root;
+        if (nodes[n].type == PLAN_AGGREGATE) {
+            s.direct_aggr = true;
+            n = nodes[n].in[0];
+        }
+        std::vector<const PlanExpr*> ev;
+        if (!collectEvals(n, ev)) return -1;
+
+        // layouts after shuffle4 (out), feeding eval2 (l3) and feeding eval1 (l2)
+        std::vector<std::string> out = nodes[root].cols;
+        if (out.size() > PLAN_MAX_COL) {
+            std::cerr << "ERROR: plan node " << root << " outputs " << out.size() << " columns, gqeJoin writes at most "
+                      << PLAN_MAX_COL << "." << std::endl;
+            return -1;
+        }
+        std::vector<std::string> l2, l3;
+        if (!evalLayouts(ev, out, l2, l3)) return -1;
+
+        bool join_on = nodes[n].type == PLAN_JOIN;
+        const PlanNode* jn = join_on ? &nodes[n] : 0;
+        int nside = join_on ? 2 : 1;
+        int side[2] = {join_on ? jn->in[0] : n, join_on ? jn->in[1] : -1};
+        int nkey = join_on ? jn->keys[0].size() : 0;
+
+        PlanFilterCfg flt[2];
+        PlanSrc src[2];
+        std::vector<std::string> pld[2];
+        std::vector<std::string> jn_out(PLAN_JOIN_OUT);
+        for (int k = 0; k < nkey; k++) jn_out[12 + k] = jn->keys[1][k];
+        for (int i = 0; join_on && i < (int)l2.size(); i++) {
+            if (keyIndex(*jn, l2[i]) >= 0) continue;
+            int p = find(nodes[side[1]].cols, l2[i]) >= 0 ? 1 : 0;
+            pld[p].push_back(l2[i]);
+        }
+
+        signed char id[2][PLAN_MAX_COL];
+        ap_uint<64> sh1[2];
+        sh1[1] = 0;
+        for (int p = 0; p < nside; p++) {
+            if (!collectFilters(side[p], flt[p])) return -1;
+            if (lowerSource(side[p], sch, src[p]) < 0) return -1;
+            usePort(s, p, src[p]);
+
+            // join input: key(s) then payload, without join the eval1 layout itself
+            std::vector<std::string> jin;
+            if (join_on) {
+                if ((int)pld[p].size() > PLAN_JOIN_PLD - (nkey - 1)) {
+                    std::cerr << "ERROR: " << pld[p].size() << " payload columns on the "
+                              << (p ? "probe" : "build") << " side of join node " << n << ", at most "
+                              << PLAN_JOIN_PLD - (nkey - 1) << " fit." << std::endl;
+                    return -1;
+                }
+                if (p == 0 && (jn->join_type == JT_SEMI || jn->join_type == JT_ANTI) && !pld[p].empty()) {
+                    std::cerr << "ERROR: semi/anti join node " << n << " cannot carry build payload." << std::endl;
+                    return -1;
+                }
+                jin = jn->keys[p];
+                jin.insert(jin.end(), pld[p].begin(), pld[p].end());
+                for (size_t c = 0; c < pld[p].size(); c++) jn_out[6 * (1 - p) + c] = pld[p][c];
+            } else {
+                jin = l2;
+            }
+            std::vector<std::string> scan_cols;
+            if (!layout(flt[p].col, jin, PLAN_MAX_COL, scan_cols)) return -1;
+            if (!scanIds(src[p], scan_cols, id[p])) return -1;
+            if (!shuffle(scan_cols, jin, sh1[p])) return -1;
+        }
+        if (!join_on) {
+            for (int c = 0; c < PLAN_MAX_COL; c++) id[1][c] = -1;
+        }
+
+        // both key names leave the join in the key slots
+        std::vector<std::string> l2j = l2;
+        for (size_t i = 0; join_on && i < l2j.size(); i++) {
+            int k = keyIndex(*jn, l2j[i]);
+            if (k >= 0) l2j[i] = jn->keys[1][k];
+        }
+        ap_uint<64> sh2 = 0, sh3, sh4;
+        sh2 = ~sh2;
+        if (join_on && !shuffle(jn_out, l2j, sh2)) return -1;
+        if (!shuffle(withEval(l2, ev[0]), l3, sh3)) return -1;
+        if (!shuffle(withEval(l3, ev[1]), out, sh4)) return -1;
+
+        ap_uint<289> op[PLAN_MAX_EVAL];
+        for (int e = 0; e < PLAN_MAX_EVAL; e++) {
+            if (!compileAlu(ev[e], op[e])) return -1;
+        }
+
+        // 512b word
+        ap_uint<512> t = 0;
+        t.set_bit(0, join_on);
+        t.set_bit(1, s.direct_aggr);
+        t.set_bit(2, nkey == 2);
+        t.range(5, 3) = join_on ? jn->join_type : 0;
+        t.set_bit(7, join_on && jn->bloom);
+        for (int c = 0; c < PLAN_MAX_COL; ++c) {
+            t.range(56 + 8 * c + 7, 56 + 8 * c) = (unsigned char)id[0][c];
+            t.range(120 + 8 * c + 7, 120 + 8 * c) = (unsigned char)id[1][c];
+        }
+        t.range(191, 184) = (1 << out.size()) - 1;
+        t.range(255, 192) = sh1[0];
+        t.range(319, 256) = sh1[1];
+        t.range(383, 320) = sh2;
+        t.range(447, 384) = sh3;
+        t.range(511, 448) = sh4;
+        s.join_cfg[0] = t;
+
+        // alu
+        s.join_cfg[1] = op[0];
+        s.join_cfg[2] = op[1];
+
+        // filter a and b, 45 words each
+        uint32_t cfg[48];
+        memset(cfg, 0, sizeof(cfg));
+        for (int p = 0; p < 2; p++) {
+            flt[p].gen(cfg);
+            for (int w = 0; w < 3; w++) {
+                for (int i = 0; i < 16; i++) {
+                    s.join_cfg[3 + 3 * p + w].range(32 * i + 31, 32 * i) = cfg[16 * w + i];
+                }
+            }
+        }
+
+        s.out_cols = out;
+        s.out_cols.resize(PLAN_MAX_COL);
+        return addStep(sch, s);
+    };
+
+    // one gqeAggr pass: group by <- any chain of [project]x2 and [filter] <- source
+    int lowerAggrStep(int root, PlanSchedule& sch) {
+        using namespace xf::database;
+        PlanStep s;
+        s.kernel = "gqeAggr";
+        const PlanNode& gb = nodes[root];
+        int nkey = gb.cols.size() - gb.aggrs.size();
+        int nagg = gb.aggrs.size();
+        if (nkey > PLAN_MAX_COL || nagg > PLAN_MAX_COL || nkey == 0 || nagg == 0) {
+            std::cerr << "ERROR: group by node " << root << " has " << nkey << " keys and " << nagg
+                      << " aggregates, 1 to " << PLAN_MAX_COL << " of each fit." << std::endl;
+            return -1;
+        }
+
+        // eval runs before filter in gqeAggr, so projects and filters commute within the step
+        int n = gb.in[0];
+        PlanFilterCfg flt;
+        std::vector<int> projs;
+        int cnt = 0;
+        for (;;) {
+            if (nodes[n].type == PLAN_PROJECT && cnt + nodes[n].exprs.size() <= PLAN_MAX_EVAL) {
+                cnt += nodes[n].exprs.size();
+                projs.push_back(n);
+                n = nodes[n].in[0];
+            } else if (nodes[n].type == PLAN_FILTER) {
+                int m = n;
+                if (!collectFilters(m, flt)) return -1;
+                if (m == n) break;
+                n = m;
+            } else {
+                break;
+            }
+        }
+        std::vector<const PlanExpr*> ev;
+        for (int i = projs.size() - 1; i >= 0; i--) {
+            for (size_t e = 0; e < nodes[projs[i]].exprs.size(); e++) ev.push_back(&nodes[projs[i]].exprs[e]);
+        }
+        ev.resize(PLAN_MAX_EVAL, (const PlanExpr*)0);
+
+        PlanSrc src;
+        if (lowerSource(n, sch, src) < 0) return -1;
+        usePort(s, 0, src);
+
+        // count-like results come back in one word and go to the slots whose high half is taken by keys,
+        // sums and means are padded past the keys when there is room, so their high half is written too
+        std::vector<int> order;
+        for (int a = 0; a < nagg; a++) {
+            if (gb.aggrs[a].op != AOP_SUM && gb.aggrs[a].op != AOP_MEAN) order.push_back(a);
+        }
+        int nwide = nagg - order.size();
+        while (nwide > 0 && (int)order.size() < nkey && nagg + (int)order.size() - (nagg - nwide) < PLAN_MAX_COL) {
+            order.push_back(-1);
+        }
+        for (int a = 0; a < nagg; a++) {
+            if (gb.aggrs[a].op == AOP_SUM || gb.aggrs[a].op == AOP_MEAN) order.push_back(a);
+        }
+        int npld = order.size();
+        std::vector<std::string> keys(gb.cols.begin(), gb.cols.begin() + nkey);
+        std::vector<std::string> plds;
+        for (int i = 0; i < npld; i++) {
+            const std::string& col = order[i] < 0 ? "" : gb.aggrs[order[i]].col;
+            plds.push_back(col.empty() ? keys[0] : col);
+        }
+
+        // layouts feeding filter (lf), eval2 (l1) and eval1 (l0)
+        std::vector<std::string> need = keys;
+        need.insert(need.end(), plds.begin(), plds.end());
+        std::vector<std::string> lf, l0, l1;
+        if (!layout(flt.col, need, PLAN_MAX_COL, lf)) return -1;
+        if (!evalLayouts(ev, lf, l0, l1)) return -1;
+
+        signed char id[PLAN_MAX_COL];
+        ap_uint<64> sh1, sh2, sh3, sh4;
+        if (!scanIds(src, l0, id)) return -1;
+        if (!shuffle(withEval(l0, ev[0]), l1, sh1)) return -1;
+        if (!shuffle(withEval(l1, ev[1]), lf, sh2)) return -1;
+        if (!shuffle(lf, keys, sh3)) return -1;
+        if (!shuffle(lf, plds, sh4)) return -1;
+
+        ap_uint<289> op[PLAN_MAX_EVAL];
+        for (int e = 0; e < PLAN_MAX_EVAL; e++) {
+            if (!compileAlu(ev[e], op[e])) return -1;
+        }
+
+        ap_uint<32>* config = s.aggr_cfg;
+        // scan
+        ap_uint<32> t;
+        for (int c = 0; c < 4; ++c) {
+            t.range(8 * c + 7, 8 * c) = (unsigned char)id[c];
+        }
+        config[0] = t;
+        for (int c = 0; c < 4; ++c) {
+            t.range(8 * c + 7, 8 * c) = (unsigned char)id[c + 4];
+        }
+        config[1] = t;
+
+        // alu
+        for (int e = 0; e < PLAN_MAX_EVAL; e++) {
+            for (int i = 0; i < 9; i++) {
+                config[10 * e + i + 2] = op[e].range(32 * (i + 1) - 1, 32 * i);
+            }
+            config[10 * e + 11] = op[e][288];
+        }
+
+        // filter
+        uint32_t fcfg[45];
+        flt.gen(fcfg);
+        for (int i = 0; i < 45; i++) config[22 + i] = fcfg[i];
+
+        // shuffle
+        config[67] = sh1.range(31, 0);
+        config[68] = sh1.range(63, 32);
+        config[69] = sh2.range(31, 0);
+        config[70] = sh2.range(63, 32);
+        config[71] = sh3.range(31, 0);
+        config[72] = sh3.range(63, 32);
+        config[73] = sh4.range(31, 0);
+        config[74] = sh4.range(63, 32);
+
+        // group aggr
+        ap_uint<32> aop = 0;
+        ap_uint<32> narrow = 0;
+        for (int i = 0; i < npld; i++) {
+            int o = order[i] < 0 ? AOP_COUNT : gb.aggrs[order[i]].op;
+            aop.range(4 * i + 3, 4 * i) = o;
+            narrow.set_bit(i, o != AOP_SUM && o != AOP_MEAN);
+        }
+        config[75] = aop;
+        config[76] = nkey;
+        config[77] = npld;
+        config[78] = 0;
+
+        // merge: slot i <- min/max/cnt or sum low of pld i, slot 8+i <- key i, or sum high of pld i
+        ap_uint<32> merge0 = 0;
+        merge0.range(23, 16) = (1 << nkey) - 1;
+        config[79] = merge0;
+        config[80] = narrow;
+
+        // direct aggr off
+        config[81] = 0;
+
+        s.out_cols.resize(PLAN_AGGR_OUT_COL);
+        s.out_hi.resize(PLAN_AGGR_OUT_COL, -1);
+        ap_uint<32> wr = 0;
+        for (int k = 0; k < nkey; k++) {
+            s.out_cols[PLAN_MAX_COL + k] = keys[k];
+            wr.set_bit(PLAN_MAX_COL + k, 1);
+        }
+        for (int i = 0; i < npld; i++) {
+            if (order[i] < 0) continue;
+            s.out_cols[i] = gb.aggrs[order[i]].name;
+            wr.set_bit(i, 1);
+            if (!narrow[i] && i >= nkey) {
+                s.out_hi[i] = PLAN_MAX_COL + i;
+                wr.set_bit(PLAN_MAX_COL + i, 1);
+            }
+        }
+        config[82] = wr;
+        return addStep(sch, s);
+    };
+};
+
+#endif // _GQE_PLAN_H
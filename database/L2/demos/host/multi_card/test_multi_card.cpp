@@ -0,0 +1,183 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "table_dt.hpp"
+#include "utils.hpp"
+#include "gqe_api.hpp"
+
+/* Checks the host side of MultiCard, which needs no card: partition() of fact table slices into the shares of the
+ * cards, and mergeAggr() of partial aggregates.
+ *
+ * Every row has to land in exactly one share, rows of equal key in the same share whatever table or slice they
+ * come from, and each share has to keep the order of the rows. The merge has to give the same groups as a merge
+ * on one thread, whatever the number of threads.
+ * */
+
+typedef std::vector<int32_t> Row;
+
+static void fill(Table& t, const std::vector<Row>& rows) {
+    t.allocateHost();
+    for (size_t r = 0; r < rows.size(); r++) {
+        for (size_t c = 0; c < rows[r].size(); c++) t.setInt32(r, c, rows[r][c]);
+    }
+    t.setNumRow(rows.size());
+}
+
+static std::vector<Row> rowsOf(Table& t) {
+    std::vector<Row> rows(t.getNumRow(), Row(t.ncol));
+    for (size_t r = 0; r < rows.size(); r++) {
+        for (size_t c = 0; c < t.ncol; c++) rows[r][c] = t.getInt32(r, c);
+    }
+    return rows;
+}
+
+// column 2 holds the row number over all slices, the key is column 0, or columns 0 and 1 with dual_key
+static int checkShares(const std::string& name,
+                       std::vector<Table>& shares,
+                       size_t nrow,
+                       bool dual_key,
+                       std::map<int64_t, int>& card_of) {
+    int nerror = 0;
+    std::vector<int> seen(nrow, 0);
+    for (size_t d = 0; d < shares.size(); d++) {
+        std::vector<Row> rows = rowsOf(shares[d]);
+        for (size_t r = 0; r < rows.size(); r++) {
+            int64_t key = dual_key ? ((int64_t)rows[r][1] << 32 | (uint32_t)rows[r][0]) : rows[r][0];
+            std::map<int64_t, int>::iterator it = card_of.insert(std::make_pair(key, (int)d)).first;
+            if (it->second != (int)d && nerror++ < 10)
+                std::cout << name << ": key " << key << " on cards " << it->second << " and " << d << std::endl;
+            if (r > 0 && rows[r][2] <= rows[r - 1][2] && nerror++ < 10)
+                std::cout << name << ": share " << d << " out of order at row " << r << std::endl;
+            seen[rows[r][2]]++;
+        }
+    }
+    for (size_t i = 0; i < nrow; i++) {
+        if (seen[i] != 1 && nerror++ < 10)
+            std::cout << name << ": row " << i << " in " << seen[i] << " shares" << std::endl;
+    }
+    return nerror;
+}
+
+static int checkPartition() {
+    const int n = 3;
+    int nerror = 0;
+    // two slices of a fact table and a table sharing its keys, each row numbered in column 2
+    std::vector<Row> rows[3];
+    int id = 0;
+    for (int i = 0; i < 7000; i++, id++) rows[i < 4000 ? 0 : 1].push_back({i % 997, i % 5, id, i * 3});
+    for (int i = 0; i < 500; i++) rows[2].push_back({i * 2 % 997, 0, i, -i});
+    Table s0("s0", rows[0].size(), 4, ""), s1("s1", rows[1].size(), 4, ""), dim("dim", rows[2].size(), 4, "");
+    fill(s0, rows[0]);
+    fill(s1, rows[1]);
+    fill(dim, rows[2]);
+
+    std::vector<Table*> facts = {&s0, &s1};
+    std::vector<Table> shares, shares1;
+    std::map<int64_t, int> card_of;
+    if (MultiCard::partition(facts, n, false, "fact", shares, 4) != 0) return 1;
+    nerror += checkShares("fact", shares, id, false, card_of);
+    // the other table follows the same keys to the same cards
+    std::vector<Table*> dims = {&dim};
+    std::vector<Table> dim_shares;
+    MultiCard::partition(dims, n, false, "dim", dim_shares, 2);
+    nerror += checkShares("dim", dim_shares, rows[2].size(), false, card_of);
+    for (int d = 0; d < n; d++) std::cout << "share " << d << ": " << shares[d].getNumRow() << " rows" << std::endl;
+
+    // one thread gives the same shares
+    MultiCard::partition(facts, n, false, "fact", shares1, 1);
+    for (int d = 0; d < n; d++) {
+        if (rowsOf(shares[d]) != rowsOf(shares1[d])) {
+            std::cout << "share " << d << " differs on one thread" << std::endl;
+            nerror++;
+        }
+    }
+
+    // dual key
+    std::map<int64_t, int> card_of2;
+    MultiCard::partition(facts, n, true, "fact2", shares, 3);
+    nerror += checkShares("dual key", shares, id, true, card_of2);
+
+    // slices of other columns are refused
+    Table bad("bad", 10, 3, "");
+    bad.allocateHost();
+    bad.setNumRow(0);
+    std::vector<Table*> mixed = {&s0, &bad};
+    if (MultiCard::partition(mixed, n, false, "mixed", shares, 2) == 0) {
+        std::cout << "slices of 4 and 3 columns are partitioned" << std::endl;
+        nerror++;
+    }
+    return nerror;
+}
+
+static int checkMerge() {
+    int nerror = 0;
+    // key0, key1, sum, min, max, high and low word of a 64-bit sum
+    std::vector<MultiCard::MergeOp> ops = {{GQE_MERGE_KEY, 0}, {GQE_MERGE_KEY, 0}, {GQE_MERGE_SUM, 0},
+                                           {GQE_MERGE_MIN, 0}, {GQE_MERGE_MAX, 0}, {GQE_MERGE_SUM64, 6},
+                                           {GQE_MERGE_NONE, 0}};
+    std::map<std::pair<int, int>, std::vector<int64_t> > golden;
+    std::vector<Table> parts(4);
+    std::vector<Table*> pp;
+    for (int p = 0; p < 4; p++) {
+        std::vector<Row> rows;
+        for (int i = 0; i < 3000 + p * 100; i++) {
+            int k0 = (i * 7 + p) % 1500, k1 = i % 3;
+            int v = i * 13 % 1000 - 500;
+            int64_t w = ((int64_t)(i % 7) << 32) + (uint32_t)(i * 2654435761u);
+            rows.push_back({k0, k1, v, v, v, (int32_t)(w >> 32), (int32_t)w});
+            std::vector<int64_t>& g = golden[std::make_pair(k0, k1)];
+            if (g.empty()) g = {0, v, v, 0};
+            g[0] += v;
+            g[1] = std::min(g[1], (int64_t)v);
+            g[2] = std::max(g[2], (int64_t)v);
+            g[3] += w;
+        }
+        parts[p] = Table("part" + std::to_string(p), rows.size(), 7, "");
+        fill(parts[p], rows);
+        pp.push_back(&parts[p]);
+    }
+    for (int nt = 1; nt <= 5; nt += 2) {
+        Table tout("merged", 0, 7, "");
+        MultiCard::mergeAggr(pp, ops, tout, nt);
+        std::vector<Row> rows = rowsOf(tout);
+        if (rows.size() != golden.size()) {
+            std::cout << nt << " threads: " << rows.size() << " groups, " << golden.size() << " expected" << std::endl;
+            nerror++;
+        }
+        for (size_t r = 0; r < rows.size(); r++) {
+            std::map<std::pair<int, int>, std::vector<int64_t> >::iterator it =
+                golden.find(std::make_pair(rows[r][0], rows[r][1]));
+            int64_t sum64 = tout.combineInt64(r, 5, 6);
+            if (it == golden.end() || it->second[0] != rows[r][2] || it->second[1] != rows[r][3] ||
+                it->second[2] != rows[r][4] || it->second[3] != sum64) {
+                if (nerror++ < 10)
+                    std::cout << nt << " threads: group " << rows[r][0] << "," << rows[r][1] << " differs" << std::endl;
+            }
+        }
+    }
+    return nerror;
+}
+
+int main(int argc, const char* argv[]) {
+    std::cout << "\n------------ MultiCard host side -------------\n";
+    int nerror = checkPartition();
+    nerror += checkMerge();
+    std::cout << (nerror ? "FAIL" : "PASS") << ": " << nerror << " errors" << std::endl;
+    return nerror;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "gqe_plan.hpp"
+#include "gqe_cpu.hpp"
+#include "../sf30_fpga/cfg.hpp"
+
+/* Builds the Q5 plan with gqe_plan.hpp and checks its 4 gqeJoin steps against get_cfg_dat_1..4 of sf30_fpga.
+ *
+ * Join flags and the two ALU words must be identical. The planner may scan columns in another order than the
+ * hand-written config, filter columns go first for instance, so scan ids and shuffles are compared by what they
+ * do: every written output column is traced back through shuffle4..shuffle1 to the input column or expression
+ * it comes from, and every filter slot to the input column it tests.
+ *
+ * The same plan, grouped by nation, then runs on CpuEngine over generated tables with 1 and 4 threads, and the
+ * revenue of each nation has to match a row-at-a-time evaluation of Q5.
+ * */
+
+typedef ap_uint<512> Cfg[9];
+
+static int sbyte(const ap_uint<512>& w, int lsb) {
+    return (signed char)(unsigned char)w.range(lsb + 7, lsb).to_uint();
+}
+
+// column feeding slot y of the layout before eval1, as "<side>:<input column>" or "key<k>"
+static std::string srcOf(const Cfg& b, int y) {
+    const ap_uint<512>& t = b[0];
+    bool join_on = t[0];
+    int nkey = t[2] ? 2 : 1;
+    int side = 0;
+    int j = y;
+    if (join_on) {
+        int z = sbyte(t, 320 + 8 * y);
+        if (z < 0) return "-";
+        if (z >= 12) {
+            std::ostringstream os;
+            os << "key" << z - 12;
+            return os.str();
+        }
+        // hash join output: probe payload 0..5, build payload 6..11, after the keys on the join input
+        side = z < 6 ? 1 : 0;
+        j = nkey + z % 6;
+    }
+    int s = sbyte(t, (side ? 256 : 192) + 8 * j);
+    if (s < 0) return "-";
+    int id = sbyte(t, (side ? 120 : 56) + 8 * s);
+    std::ostringstream os;
+    os << (side ? "B:" : "A:") << id;
+    return os.str();
+}
+
+// column written to output slot c, Q5 expressions read strm1 and strm2
+static std::string lineage(const Cfg& b, int c) {
+    const ap_uint<512>& t = b[0];
+    int x = sbyte(t, 448 + 8 * c);
+    if (x == 8) return "eval2";
+    if (x < 0) return "-";
+    int y = sbyte(t, 384 + 8 * x);
+    if (y == 8) return "eval1(" + srcOf(b, 0) + "," + srcOf(b, 1) + ")";
+    if (y < 0) return "-";
+    return srcOf(b, y);
+}
+
+// conditions of filter a (p = 0) or b (p = 1), as "<input column> <lop> <lo> <rop> <hi>"
+static std::set<std::string> conds(const Cfg& b, int p) {
+    std::set<std::string> r;
+    uint32_t cfg[48];
+    for (int w = 0; w < 3; w++) {
+        for (int i = 0; i < 16; i++) cfg[16 * w + i] = b[3 + 3 * p + w].range(32 * i + 31, 32 * i).to_uint();
+    }
+    for (int i = 0; i < 4; i++) {
+        uint32_t ops = cfg[3 * i + 2];
+        uint32_t lop = ops >> xf::database::FilterOpWidth;
+        uint32_t rop = ops & ((1u << xf::database::FilterOpWidth) - 1);
+        if (lop == xf::database::FOP_DC && rop == xf::database::FOP_DC) continue;
+        std::ostringstream os;
+        os << sbyte(b[0], (p ? 120 : 56) + 8 * i) << " " << lop << " " << cfg[3 * i] << " " << rop << " "
+           << cfg[3 * i + 1];
+        r.insert(os.str());
+    }
+    // column compares and the true table
+    for (int i = 12; i < 45; i++) {
+        std::ostringstream os;
+        os << "w" << i << "=" << cfg[i];
+        r.insert(os.str());
+    }
+    return r;
+}
+
+static int check(int step, const Cfg& got, const Cfg& ref) {
+    int nerror = 0;
+    if (got[0].range(5, 0) != ref[0].range(5, 0)) {
+        std::cout << "step " << step << ": join flags " << got[0].range(5, 0) << " != " << ref[0].range(5, 0)
+                  << std::endl;
+        nerror++;
+    }
+    if (got[0].range(191, 184) != ref[0].range(191, 184)) {
+        std::cout << "step " << step << ": write mask " << got[0].range(191, 184) << " != "
+                  << ref[0].range(191, 184) << std::endl;
+        nerror++;
+    }
+    for (int i = 1; i < 3; i++) {
+        if (got[i] != ref[i]) {
+            std::cout << "step " << step << ": ALU word " << i << " differs" << std::endl;
+            nerror++;
+        }
+    }
+    for (int c = 0; c < 8; c++) {
+        if (!ref[0][184 + c]) continue;
+        std::string g = lineage(got, c);
+        std::string r = lineage(ref, c);
+        if (g != r) {
+            std::cout << "step " << step << ": output " << c << " is " << g << ", expected " << r << std::endl;
+            nerror++;
+        }
+    }
+    for (int p = 0; p < 2; p++) {
+        if (conds(got, p) != conds(ref, p)) {
+            std::cout << "step " << step << ": filter " << (p ? "b" : "a") << " differs" << std::endl;
+            nerror++;
+        }
+    }
+    return nerror;
+}
+
+static void genCol(CpuTable& t, const std::string& name, size_t n, int lo, int hi, bool seq = false) {
+    t.nrow = n;
+    t.addCol(name);
+    for (size_t r = 0; r < n; r++) t.data.back()[r] = seq ? lo + (int)r : lo + std::rand() % (hi - lo);
+}
+
+// runs Q5 grouped by nation on CpuEngine and checks revenue, row count and the direct aggregate of each nation
+static int checkCpu(QueryPlan& qp, int j4) {
+    using namespace xf::database;
+    std::srand(5);
+    CpuTable nation, customer, orders, lineitem, supplier;
+    genCol(nation, "n_nationkey", 5, 5, 10, true);
+    genCol(customer, "c_nationkey", 3000, 0, 25);
+    genCol(customer, "c_custkey", 3000, 1, 0, true);
+    genCol(orders, "o_custkey", 30000, 1, 3001);
+    genCol(orders, "o_orderkey", 30000, 1, 0, true);
+    genCol(orders, "o_orderdate", 30000, 19920101, 19981231);
+    genCol(lineitem, "l_orderkey", 120000, 1, 30001);
+    genCol(lineitem, "l_suppkey", 120000, 1, 201);
+    genCol(lineitem, "l_extendedprice", 120000, 100, 100000);
+    genCol(lineitem, "l_discount", 120000, 0, 11);
+    genCol(supplier, "s_suppkey", 200, 1, 0, true);
+    genCol(supplier, "s_nationkey", 200, 0, 25);
+
+    // revenue and rows per nation, one lineitem at a time
+    std::map<uint32_t, std::pair<uint64_t, uint32_t> > ref;
+    for (size_t r = 0; r < lineitem.nrow; r++) {
+        size_t o = lineitem.data[0][r] - 1;
+        int date = orders.data[2][o];
+        if (date < 19940101 || date >= 19950101) continue;
+        int nk = customer.data[0][orders.data[0][o] - 1];
+        if (nk < 5 || nk >= 10 || supplier.data[1][lineitem.data[1][r] - 1] != nk) continue;
+        uint32_t rev = (uint32_t)lineitem.data[2][r] * (uint32_t)(100 - lineitem.data[3][r]);
+        ref[nk].first += rev;
+        ref[nk].second++;
+    }
+
+    int grp = qp.groupBy(j4, {"c_nationkey"},
+                         {{"revenue", AOP_SUM, "revenue"}, {"rows", AOP_COUNT, ""}, {"top", AOP_MAX, "revenue"}});
+    int agg = qp.aggregate(j4, {"revenue"});
+    int nerror = 0;
+    for (int nt = 1; nt <= 4; nt += 3) {
+        CpuEngine eng(nt);
+        eng.addTable("th0", nation);
+        eng.addTable("customer", customer);
+        eng.addTable("orders", orders);
+        eng.addTable("lineitem", lineitem);
+        eng.addTable("supplier", supplier);
+        CpuTable out, all;
+        if (grp < 0 || agg < 0 || eng.run(qp, grp, out) || eng.run(qp, agg, all)) {
+            std::cout << "ERROR: Q5 does not run on " << nt << " CPU threads" << std::endl;
+            return 1;
+        }
+        if (out.nrow != ref.size()) {
+            std::cout << nt << " threads: " << out.nrow << " nations, expected " << ref.size() << std::endl;
+            nerror++;
+        }
+        uint64_t total = 0;
+        uint32_t rows = 0;
+        for (size_t r = 0; r < out.nrow; r++) {
+            uint32_t nk = out.getInt32(r, 0);
+            uint64_t rev = out.getInt64(r, 1);
+            total += rev;
+            rows += out.getInt32(r, 2);
+            if (ref.count(nk) == 0 || ref[nk].first != rev || ref[nk].second != (uint32_t)out.getInt32(r, 2)) {
+                std::cout << nt << " threads: nation " << nk << " has revenue " << rev << " in "
+                          << out.getInt32(r, 2) << " rows" << std::endl;
+                nerror++;
+            }
+        }
+        // revenue is 32-bit unsigned, the direct aggregate takes it as signed
+        if (all.nrow != 6 || (uint32_t)all.getInt32(4, 0) != rows) {
+            std::cout << nt << " threads: direct aggregate of " << all.getInt32(4, 0) << " rows" << std::endl;
+            nerror++;
+        }
+        std::cout << "CPU, " << nt << " threads: " << out.nrow << " nations, revenue " << total << std::endl;
+    }
+    return nerror;
+}
+
+int main() {
+    std::cout << "\n------------ TPC-H Q5 plan -------------\n";
+    using namespace xf::database;
+
+    // same column order as the tables of sf30_fpga/test_q5.cpp, th0 holds the nations of ASIA
+    QueryPlan qp;
+    int nation = qp.scan("th0", {"n_nationkey"});
+    int customer = qp.scan("customer", {"c_nationkey", "c_custkey"});
+    int orders = qp.scan("orders", {"o_custkey", "o_orderkey", "o_orderdate"});
+    int lineitem = qp.scan("lineitem", {"l_orderkey", "l_suppkey", "l_extendedprice", "l_discount"});
+    int supplier = qp.scan("supplier", {"s_suppkey", "s_nationkey"});
+
+    int j1 = qp.join(nation, customer, {"n_nationkey"}, {"c_nationkey"}, {"c_custkey", "c_nationkey"});
+    int fo = qp.filter(orders, {planRange("o_orderdate", 19940101, 19950101)});
+    int j2 = qp.join(j1, fo, {"c_custkey"}, {"o_custkey"}, {"o_orderkey", "c_nationkey"});
+    int j3 = qp.join(j2, lineitem, {"o_orderkey"}, {"l_orderkey"},
+                     {"l_suppkey", "l_extendedprice", "l_discount", "c_nationkey"});
+    int rev = qp.project(j3, {"l_suppkey", "c_nationkey"},
+                         {planExpr("revenue", "strm1*(-strm2+c2)", {"l_extendedprice", "l_discount"}, 0, 100)});
+    int t4 = qp.project(rev, {"l_suppkey", "revenue", "c_nationkey"}, {});
+    int j4 = qp.join(supplier, t4, {"s_suppkey", "s_nationkey"}, {"l_suppkey", "c_nationkey"},
+                     {"revenue", "c_nationkey"});
+
+    PlanSchedule sch;
+    if (j4 < 0 || qp.compile(j4, sch) != 0) {
+        std::cout << "ERROR: Q5 plan does not compile" << std::endl;
+        return 1;
+    }
+    sch.print();
+
+    Cfg ref[4];
+    get_cfg_dat_1(ref[0]);
+    get_cfg_dat_2(ref[1]);
+    get_cfg_dat_3(ref[2]);
+    get_cfg_dat_4(ref[3]);
+
+    int nerror = 0;
+    if (sch.steps.size() != 4) {
+        std::cout << "ERROR: " << sch.steps.size() << " steps, expected 4" << std::endl;
+        nerror++;
+    }
+    for (size_t i = 0; i < sch.steps.size() && i < 4; i++) {
+        const PlanStep& s = sch.steps[i];
+        if (s.kernel != "gqeJoin" || (i > 0 && s.deps != std::vector<int>(1, i - 1))) {
+            std::cout << "step " << i << ": expected gqeJoin after step " << (int)i - 1 << std::endl;
+            nerror++;
+        }
+        Cfg got;
+        s.fill(got);
+        nerror += check(i, got, ref[i]);
+    }
+    nerror += checkCpu(qp, j4);
+
+    std::cout << (nerror ? "FAIL" : "PASS") << ": " << nerror << " mismatches" << std::endl;
+    return nerror;
+}
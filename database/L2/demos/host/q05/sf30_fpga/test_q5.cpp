@@ -30,6 +30,14 @@
 const int PU_NM = 8;
 #include "gqe_api.hpp"
 #include "q5.hpp"
+
+// rows of two int32 columns as a sorted list, the kernels emit them in no particular order
+static std::vector<std::pair<int32_t, int32_t> > sortedRows(Table& t) {
+    std::vector<std::pair<int32_t, int32_t> > rows;
+    for (int i = 0; i < t.getNumRow(); i++) rows.push_back(std::make_pair(t.getInt32(i, 0), t.getInt32(i, 1)));
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
 int main(int argc, const char* argv[]) {
     std::cout << "\n------------ TPC-H GQE (1G) -------------\n";
 
@@ -154,6 +162,11 @@ int main(int argc, const char* argv[]) {
     Table tk0("tk0", 190000 * scale, 8, "");
     Table tk1("tk1", 60000 * scale, 8, "");
     Table tk2("tk2", 7500 * scale, 2, "");
+    // intermediates of the join chain, kept in device memory
+    Table td0("td0", 190000 * scale, 8, "");
+    Table td1("td1", 60000 * scale, 8, "");
+    // host reference of the join chain
+    Table tg("tg", 7500 * scale, 2, "");
     std::cout << "Table Creation done." << std::endl;
     /**
      * 2.allocate CPU
@@ -166,6 +179,7 @@ int main(int argc, const char* argv[]) {
     tk0.allocateHost();
     tk1.allocateHost();
     tk2.allocateHost();
+    tg.allocateHost();
 
     std::cout << "Table allocation CPU done." << std::endl;
 
@@ -191,8 +205,8 @@ int main(int argc, const char* argv[]) {
     for (int i = 0; i < NumTable; i++) {
         tbs[i].allocateDevBuffer(context, 32);
     }
-    tk0.allocateDevBuffer(context, 32);
-    tk1.allocateDevBuffer(context, 32);
+    td0.allocateDevOnly(context, 32);
+    td1.allocateDevOnly(context, 32);
     tk2.allocateDevBuffer(context, 32);
     th0.allocateDevBuffer(context, 32);
 
@@ -206,7 +220,6 @@ int main(int argc, const char* argv[]) {
      * 5.kernels (host and device)
      */
 
-    int kernelInd = 0;
     bufferTmp buftmp(context);
     buftmp.initBuffer(q);
     // kernel Engine
@@ -215,10 +228,10 @@ int main(int argc, const char* argv[]) {
         krnlstep[i] = krnlEngine(program, q, "gqeJoin");
     }
 
-    krnlstep[0].setup(th0, tbs[2], tk0, cfgcmds[0], buftmp);
-    krnlstep[1].setup(tk0, tbs[3], tk1, cfgcmds[1], buftmp);
-    krnlstep[2].setup(tk1, tbs[4], tk0, cfgcmds[2], buftmp);
-    krnlstep[3].setup(tbs[5], tk0, tk2, cfgcmds[3], buftmp);
+    krnlstep[0].setup(th0, tbs[2], td0, cfgcmds[0], buftmp);
+    krnlstep[1].setup(td0, tbs[3], td1, cfgcmds[1], buftmp);
+    krnlstep[2].setup(td1, tbs[4], td0, cfgcmds[2], buftmp);
+    krnlstep[3].setup(tbs[5], td0, tk2, cfgcmds[3], buftmp);
 
     // transfer Engine
     transEngine transin;
@@ -232,8 +245,6 @@ int main(int argc, const char* argv[]) {
     transout.setq(q);
 
     transin.add(&(tbs[2]));
-    //  transin.add(&(tbs[3]));
-    //  transin.add(&(tbs[4]));
     transin.add(&(tbs[5]));
 
     for (int i = 0; i < NumSweep; i++) {
@@ -242,26 +253,27 @@ int main(int argc, const char* argv[]) {
     q.finish();
     std::cout << "Kernel/Transfer have been setup\n";
 
-    // events
-    std::vector<cl::Event> eventsh2d_write[NumSweep];
-    std::vector<cl::Event> eventsd2h_read[NumSweep];
-    std::vector<cl::Event> events[NumSweep];
-    std::vector<cl::Event> events_grp[NumSweep];
-    for (int i = 0; i < NumSweep; i++) {
-        events[i].resize(1);
-    };
-    for (int i = 0; i < NumSweep; i++) {
-        eventsh2d_write[i].resize(1);
-    };
-    for (int i = 0; i < NumSweep; i++) {
-        eventsd2h_read[i].resize(1);
-    };
+    // pipeline: only base tables go in and tk2 comes back, t2/t3/t4 stay in td0/td1
+    PipeGraph pipe;
+    int h2d0 = pipe.h2d(transin, {}, "data trans kernel0");
+    int h2d1 = pipe.h2d(transin1, {h2d0}, "data trans kernel1");
+    int h2d2 = pipe.h2d(transin2, {h2d1}, "data trans kernel2");
+    // step2 :t1 customer-> t2
+    int k0 = pipe.kernel(krnlstep[0], {h2d0}, "kernel0");
+    // step3 : t2 order -> t3
+    int k1 = pipe.kernel(krnlstep[1], {h2d1, k0}, "kernel1");
+    // step4 : t3 line -> t4
+    int k2 = pipe.kernel(krnlstep[2], {h2d2, k1}, "kernel2");
+    // supplier t4-> t5
+    int k3 = pipe.kernel(krnlstep[3], {k2}, "kernel3");
+    int d2h = pipe.d2h(transout, {k3}, "data trans out");
+    if (d2h < 0) return 1;
 
     struct timeval tv_r_s, tv_r_e;
     struct timeval tv_r_0, tv_r_1;
+    td0.initBuffer(q);
+    td1.initBuffer(q);
 #ifdef INI
-    tk0.initBuffer(q);
-    tk1.initBuffer(q);
     tk2.initBuffer(q);
 #endif
     gettimeofday(&tv_r_s, 0);
@@ -269,39 +281,12 @@ int main(int argc, const char* argv[]) {
     q5Join_r_n(tbs[0], tbs[1], th0);
     gettimeofday(&tv_r_0, 0);
 
-    // step2 :t1 customer-> t2
     transin.add(&th0);
-    transin.host2dev(0, nullptr, &(eventsh2d_write[0][0]));
-    //  q5Join_t1_c(th0,tbs[2],tk0);
-    krnlstep[0].run(0, &(eventsh2d_write[0]), &(events[1][0]));
-    kernelInd++;
-
-    // step3 : t2 order -> t3
-    //  q5Join_t2_o(tk0,tbs[3],tk1);
     transin1.add(&tbs[3]);
-    transin1.host2dev(0, &(eventsh2d_write[0]), &(eventsh2d_write[1][0]));
-    events_grp[1].push_back(eventsh2d_write[1][0]);
-    events_grp[1].push_back(events[1][0]);
-    krnlstep[1].run(0, &(events_grp[1]), &(events[2][0]));
-    kernelInd++;
-
-    // step4 : t3 line -> t4
-    //  q5Join_t3_l(tk1,tbs[4],tk0);
     transin2.add(&tbs[4]);
-    transin2.host2dev(0, &(eventsh2d_write[1]), &(eventsh2d_write[2][0]));
-    events_grp[2].push_back(eventsh2d_write[2][0]);
-    events_grp[2].push_back(events[2][0]);
-    krnlstep[2].run(0, &(events_grp[2]), &(events[3][0]));
-    kernelInd++;
-
-    // supplier t4-> t5
-    //  q5Join_s_t4(tbs[5],tk0,tk2);
-    krnlstep[3].run(0, &(events[3]), &(events[4][0]));
-    kernelInd++;
-
     transout.add(&tk2);
-    transout.dev2host(0, &(events[4]), &(eventsd2h_read[0][0]));
-    q.finish();
+    if (pipe.run() != 0) return 1;
+    pipe.wait();
 
     gettimeofday(&tv_r_1, 0);
     q5Join_t5_n(tk2, tbs[1], tk0);
@@ -311,17 +296,28 @@ int main(int argc, const char* argv[]) {
 
     print_h_time(tv_r_s, tv_r_s, tv_r_0, "NationFilter..");
     int64_t offset = tvdiff(&tv_r_s, &tv_r_0) / 1000;
-    cl_ulong kstart;
-    eventsh2d_write[0][0].getProfilingInfo(CL_PROFILING_COMMAND_START, &kstart);
-    print_d_time(eventsh2d_write[0][0], eventsd2h_read[0][0], kstart, "all kernels", offset);
-    print_d_time(eventsh2d_write[0][0], eventsh2d_write[0][0], kstart, "data trans kernel0", offset);
-    print_d_time(events[1][0], events[1][0], kstart, "kernel0", offset);
-    print_d_time(eventsh2d_write[1][0], eventsh2d_write[1][0], kstart, "data trans kernel1", offset);
-    print_d_time(events[2][0], events[2][0], kstart, "kernel1", offset);
-    print_d_time(eventsh2d_write[2][0], eventsh2d_write[2][0], kstart, "data trans kernel2", offset);
-    print_d_time(events[3][0], eventsd2h_read[0][0], kstart, "kernel2/3...", offset);
+    pipe.printTime(offset);
     print_h_time(tv_r_s, tv_r_1, tv_r_e, "Group&Sort..");
     std::cout << "CPU execution time of Host " << tvdiff(&tv_r_s, &tv_r_e) / 1000 << " ms" << std::endl;
 
-    return 0;
+    // check the chain against the host joins: t4 left in device-only td0, and t5 brought back in tk2
+    td0.readHeader(q);
+    q5Join_t1_c(th0, tbs[2], tk0);
+    q5Join_t2_o(tk0, tbs[3], tk1);
+    q5Join_t3_l(tk1, tbs[4], tk0);
+    q5Join_s_t4(tbs[5], tk0, tg);
+    int nerror = 0;
+    if (td0.getNumRow() != tk0.getNumRow()) {
+        std::cout << "ERROR: device-only t4 has " << td0.getNumRow() << " rows, expected " << tk0.getNumRow()
+                  << std::endl;
+        nerror++;
+    }
+    if (sortedRows(tk2) != sortedRows(tg)) {
+        std::cout << "ERROR: t5 differs from host join, " << tk2.getNumRow() << " rows, expected " << tg.getNumRow()
+                  << std::endl;
+        nerror++;
+    }
+    std::cout << (nerror ? "FAIL" : "PASS") << ": pipelined join chain" << std::endl;
+
+    return nerror;
 }
@@ -54,12 +54,6 @@ int main(int argc, const char* argv[]) {
         return 1;
     }
 
-    std::string strPSize;
-    if (!parser.getCmdOption("-p", strPSize)) {
-        std::cout << "ERROR: partition size is not specified.\n";
-    }
-    int psize = std::stoi(strPSize, nullptr);
-
     int num_rep = 1;
 
     std::string num_str;
@@ -144,7 +138,6 @@ int main(int argc, const char* argv[]) {
     tbs[2].addCol("c_custkey", 4);
     tbs[2].addCol("c_name", TPCH_READ_C_NAME_LEN + 1, 0, 0);
     tbs[2].addCol("c_rowid", 4, 1);
-    Table pp0("pp0", lineitem_n, 2, "");
     Table tbs0 = Table("lineitem", lineitem_n, 2, "");
     std::cout << "DEBUG0" << std::endl;
     // tbx is for the empty bufferB in kernel
@@ -159,26 +152,15 @@ int main(int argc, const char* argv[]) {
     /**
      * 2.allocate CPU
      */
-    int hjRow = 1 << psize;
-    int hpTimes = 1 << (int)ceil(log2((float)(tbs[0].nrow / hjRow)));
-    int power_of_hpTimes = log2(hpTimes);
-    std::cout << "Number of partition is: " << hpTimes << std::endl;
-    const int NumSweep_a = 1 + hpTimes;
-
     for (int i = 0; i < NumTable; i++) {
         tbs[i].allocateHost();
     }
-    pp0.allocateHost(1.2, hpTimes);
-    tk0_a.allocateHost(1.2, hpTimes);
-    th0.allocateHost();
     th1.allocateHost();
     th2.allocateHost();
     tk0.allocateHost();
     tk1.allocateHost();
     tbs0.allocateHost();
     tbs0 = tbs[0];
-    // th0.data = tk0_a.data;
-    th0 = tk0_a;
 
     std::cout << "Table allocation CPU done." << std::endl;
 
@@ -194,20 +176,9 @@ int main(int argc, const char* argv[]) {
     get_cfg_dat_2(cfgcmds[1].cmd);
     get_cfg_dat_3(cfgcmds[2].cmd);
 
-    AggrCfgCmd aggrcfgIn[hpTimes];
-    AggrCfgCmd aggrcfgOut[hpTimes];
-    cfgCmd hpcfg;
-
-    for (int i = 0; i < hpTimes; i++) {
-        aggrcfgIn[i].allocateHost();
-        aggrcfgOut[i].allocateHost();
-    }
-    hpcfg.allocateHost();
-
-    for (int i = 0; i < hpTimes; i++) {
-        get_aggr_cfg(aggrcfgIn[i].cmd, 0);
-    }
-    get_partition_cfg(hpcfg.cmd);
+    AggrCfgCmd aggrcfgIn;
+    aggrcfgIn.allocateHost();
+    get_aggr_cfg(aggrcfgIn.cmd, 0);
 
     for (int i = 0; i < NumTable; i++) {
         tbs[i].loadHost();
@@ -217,6 +188,15 @@ int main(int argc, const char* argv[]) {
      * 4.allocate device
      */
     tbs0.allocateDevBuffer(context_a, 33);
+    aggrcfgIn.allocateDevBuffer(context_a, 32);
+
+    // group by l_orderkey, partitioned by the estimated group count so that each partition fits one gqeAggr pass.
+    // One aggregation buffer takes 2GB, so the partitions run one after another on it.
+    GroupSketch sketch;
+    sketch.add(tbs[0], 1);
+    AggrBufferTmp a_buftmp(context_a);
+    AggrSpill spill(context_a, program_a, q_a, tbs0, tk0_a, aggrcfgIn, a_buftmp, sketch.estimate(), false, 1.2, 33);
+    th0 = tk0_a;
     tbs[0].allocateDevBuffer(context_h, 32);
     tbs[1].allocateDevBuffer(context_h, 32);
     tbs[2].allocateDevBuffer(context_h, 32);
@@ -225,23 +205,6 @@ int main(int argc, const char* argv[]) {
     tk1.allocateDevBuffer(context_h, 32);
     th0.allocateDevBuffer(context_h, 32);
     th2.allocateDevBuffer(context_h, 32);
-    tk0_a.allocateDevBuffer(context_a, 33);
-    pp0.allocateDevBuffer(context_a, 32);
-
-    for (int i = 0; i < hpTimes; i++) {
-        aggrcfgIn[i].allocateDevBuffer(context_a, 32);
-        aggrcfgOut[i].allocateDevBuffer(context_a, 33);
-    }
-    hpcfg.allocateDevBuffer(context_a, 32);
-
-    Table tp0[hpTimes];
-    for (int i = 0; i < hpTimes; i++) {
-        tp0[i] = pp0.createSubTable(i);
-    }
-    Table tp1[hpTimes];
-    for (int i = 0; i < hpTimes; i++) {
-        tp1[i] = tk0_a.createSubTable(i);
-    }
 
     for (int i = 0; i < 3; i++) {
         cfgcmds[i].allocateDevBuffer(context_h, 32);
@@ -275,17 +238,7 @@ int main(int argc, const char* argv[]) {
     krnlstep[kernelInd].setup(tk1, tbs[0], th2, cfgcmds[2], buftmp);
     kernelInd++;
 
-    AggrBufferTmp a_buftmp(context_a);
-    AggrKrnlEngine a_krnlstep[NumSweep_a];
     a_buftmp.BufferInitial(q_a);
-    a_krnlstep[0] = AggrKrnlEngine(program_a, q_a, "gqePart");
-    for (int i = 0; i < hpTimes; i++) {
-        a_krnlstep[i + 1] = AggrKrnlEngine(program_a, q_a, "gqeAggr");
-    }
-    a_krnlstep[0].setup_hp(512, 0, power_of_hpTimes, tbs0, pp0, hpcfg);
-    for (int i = 0; i < hpTimes; i++) {
-        a_krnlstep[i + 1].setup(tp0[i], tp1[i], aggrcfgIn[i], aggrcfgOut[i], a_buftmp);
-    }
 
     transEngine transin[2];
     transEngine transout[2];
@@ -302,16 +255,11 @@ int main(int argc, const char* argv[]) {
     q_h.finish();
 
     transEngine a_transin;
-    transEngine a_transout[hpTimes];
     a_transin.setq(q_a);
-    for (int i = 0; i < hpTimes; i++) {
-        a_transout[i].setq(q_a);
-    }
     a_transin.add(&(tbs0));
-    a_transin.add(&(hpcfg));
-    for (int i = 0; i < hpTimes; i++) {
-        a_transin.add(&(aggrcfgIn[i]));
-    }
+    PipeGraph a_pipe;
+    int a_last = spill.add(a_pipe, {a_pipe.h2d(a_transin, {}, "lineitem")});
+    if (a_last < 0) return 1;
     q_a.finish();
     std::cout << "Kernel/Transfer have been setup\n";
 
@@ -328,45 +276,18 @@ int main(int argc, const char* argv[]) {
     for (int i = 0; i < NumSweep; i++) {
         eventsd2h_read[i].resize(1);
     };
-    std::vector<cl::Event> a_eventsh2d_write;
-    std::vector<cl::Event> a_eventsd2h_read[hpTimes];
-    std::vector<cl::Event> a_events[NumSweep_a];
-
-    a_eventsh2d_write.resize(1);
-
-    for (int i = 0; i < NumSweep_a; i++) {
-        a_events[i].resize(1);
-    };
-
-    for (int i = 0; i < hpTimes; i++) {
-        a_eventsd2h_read[i].resize(1);
-    };
     struct timeval tv_r_s, tv_r_0, tv_r_1, tv_r_e;
 #ifdef INI
     tk0.initBuffer(q_h);
     tk1.initBuffer(q_h);
     th2.initBuffer(q_h);
-    pp0.initBuffer(q_a);
-    tk0_a.initBuffer(q_a);
 #endif
+    spill.initBuffer(q_a);
     gettimeofday(&tv_r_s, 0);
-    a_transin.host2dev(0, nullptr, &(a_eventsh2d_write[0]));
-    q_a.finish();
+    if (a_pipe.run() != 0) return 1;
     transin[0].host2dev(0, nullptr, &(eventsh2d_write[0][0]));
-
-    // a_krnlstep[0].run(0, &(a_eventsh2d_write), &(a_events[0][0]));
-    a_krnlstep[0].run(0, nullptr, &(a_events[0][0]));
-
-    for (int i = 0; i < hpTimes; i++) {
-        a_krnlstep[i + 1].run(0, &(a_events[0]), &(a_events[i + 1][0]));
-    }
-
-    for (int i = 0; i < hpTimes; i++) {
-        a_transout[i].add(&tp1[i]);
-        a_transout[i].dev2host(0, &(a_events[i + 1]), &(a_eventsd2h_read[i][0]));
-    }
-    q_a.finish();
-    tk0_a.mergeSubTable(tp1, hpTimes);
+    a_pipe.wait();
+    spill.merge();
     // std::cout<<tk0_a.data[0].range(31,0).to_int()<<std::endl;
     // std::cout<<th0.data[0].range(31,0).to_int()<<std::endl;
     gettimeofday(&tv_r_0, 0);
@@ -0,0 +1,396 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _TPCH_MMAP_READ_H
+#define _TPCH_MMAP_READ_H
+
+#include "tpch_read_2.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* tpch_mmap_read.hpp provides a column loader for '|' separated .tbl files.
+ *
+ * The file is memory-mapped and split on row boundaries into one range per thread.
+ * A first pass counts the rows of each range, so every thread knows the row index it starts at,
+ * a second pass parses the selected fields straight into caller-provided column buffers.
+ * Delimiter search and row counting use SSE2 when available.
+ *
+ * TblCol describes one output column: the 0-based field index in the row, how to convert the text,
+ * the element width in bytes and the destination buffer, e.g. (char*)(table.data + table.size512[i] + 1).
+ * TBL_INT, TBL_DATE, TBL_MONEY and TBL_CHAR produce TPCH_INT with the same encoding as d_long, d_date,
+ * d_money and the first char of d_string, TBL_STR produces '\0' padded char[width] like d_string<width>.
+ *
+ * load_tbl_cached() keeps the parsed columns as <name>.dat files in the format of columngen and load_dat,
+ * next to a stamp of the source file and of each cached column, so repeated runs only read the binary columns.
+ * */
+
+enum TblColType { TBL_INT = 0, TBL_DATE, TBL_MONEY, TBL_CHAR, TBL_STR };
+
+struct TblCol {
+    int field;
+    TblColType type;
+    size_t width;
+    void* dst;
+
+    TblCol(int field_, TblColType type_, void* dst_, size_t width_ = sizeof(TPCH_INT))
+        : field(field_), type(type_), width(width_), dst(dst_) {}
+};
+
+// find first c in [p, end), returns end if not found
+inline const char* tbl_find(const char* p, const char* end, char c) {
+#ifdef __SSE2__
+    const __m128i vc = _mm_set1_epi8(c);
+    for (; p + 16 <= end; p += 16) {
+        int m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), vc));
+        if (m) return p + __builtin_ctz(m);
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == c) return p;
+    }
+    return end;
+}
+
+// count c in [p, end)
+inline size_t tbl_count(const char* p, const char* end, char c) {
+    size_t n = 0;
+#ifdef __SSE2__
+    const __m128i vc = _mm_set1_epi8(c);
+    for (; p + 16 <= end; p += 16) {
+        n += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), vc)));
+    }
+#endif
+    for (; p < end; ++p) {
+        n += (*p == c);
+    }
+    return n;
+}
+
+inline TPCH_INT tbl_parse_int(const char* p, const char* e) {
+    bool neg = (p < e && *p == '-');
+    if (neg) ++p;
+    TPCH_INT v = 0;
+    for (; p < e && *p >= '0' && *p <= '9'; ++p) v = v * 10 + (*p - '0');
+    return neg ? -v : v;
+}
+
+// YYYY-MM-DD to YYYYMMDD
+inline TPCH_INT tbl_parse_date(const char* p, const char* e) {
+    const char* d0 = tbl_find(p, e, '-');
+    const char* d1 = tbl_find(d0 + (d0 < e), e, '-');
+    TPCH_INT year = tbl_parse_int(p, d0);
+    TPCH_INT month = tbl_parse_int(d0 + 1, d1);
+    TPCH_INT day = tbl_parse_int(d1 + 1, e);
+    return year * 10000 + month * 100 + day;
+}
+
+// dollars.cents to cents
+inline TPCH_INT tbl_parse_money(const char* p, const char* e) {
+    bool neg = (p < e && *p == '-');
+    if (neg) ++p;
+    const char* dot = tbl_find(p, e, '.');
+    TPCH_INT v = tbl_parse_int(p, dot) * 100;
+    if (dot < e) v += tbl_parse_int(dot + 1, e);
+    return neg ? -v : v;
+}
+
+class TblReader {
+   public:
+    TblReader(const std::string& path, int nthread = 0) : base(nullptr), size(0), fd(-1), nrow(0), counted(false) {
+        nthr = nthread > 0 ? nthread : (int)std::thread::hardware_concurrency();
+        if (nthr <= 0) nthr = 1;
+
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            printf("ERROR: %s cannot be opened for read.\n", path.c_str());
+            return;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            fd = -1;
+            return;
+        }
+        size = info.st_size;
+        void* m = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m == MAP_FAILED) {
+            printf("ERROR: %s cannot be mapped.\n", path.c_str());
+            close(fd);
+            fd = -1;
+            size = 0;
+            return;
+        }
+        base = (const char*)m;
+        madvise(m, size, MADV_SEQUENTIAL);
+    }
+
+    ~TblReader() {
+        if (base) munmap((void*)base, size);
+        if (fd >= 0) close(fd);
+    }
+
+    bool valid() const { return base != nullptr; }
+
+    //! Number of rows in the file
+    size_t rows() {
+        if (!counted) split();
+        return nrow;
+    }
+
+    //! Parse the given columns of the first max_row rows, returns number of rows parsed
+    size_t parse(const std::vector<TblCol>& cols, size_t max_row = (size_t)-1) {
+        if (!valid()) return 0;
+        if (!counted) split();
+
+        int max_field = -1;
+        for (size_t i = 0; i < cols.size(); ++i) {
+            if (cols[i].field > max_field) max_field = cols[i].field;
+        }
+        std::vector<int> field_col(max_field + 1, -1);
+        for (size_t i = 0; i < cols.size(); ++i) field_col[cols[i].field] = i;
+
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < ranges.size(); ++t) {
+            if (row_begin[t] >= max_row) break;
+            workers.push_back(std::thread(&TblReader::parse_range, this, t, std::cref(cols), std::cref(field_col),
+                                          max_row));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+        return nrow < max_row ? nrow : max_row;
+    }
+
+   private:
+    const char* base;
+    size_t size;
+    int fd;
+    int nthr;
+    size_t nrow;
+    bool counted;
+    std::vector<std::pair<const char*, const char*> > ranges;
+    std::vector<size_t> row_begin;
+
+    // split at row boundaries and count rows of each range in parallel
+    void split() {
+        counted = true;
+        if (!valid()) return;
+        const char* end = base + size;
+        const char* p = base;
+        for (int t = 0; t < nthr && p < end; ++t) {
+            const char* e = (t == nthr - 1) ? end : base + size / nthr * (t + 1);
+            if (e < p) e = p;
+            e = tbl_find(e, end, '\n');
+            if (e < end) ++e;
+            ranges.push_back(std::make_pair(p, e));
+            p = e;
+        }
+
+        std::vector<size_t> cnt(ranges.size(), 0);
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < ranges.size(); ++t) {
+            workers.push_back(std::thread([this, t, &cnt]() {
+                const char* b = ranges[t].first;
+                const char* e = ranges[t].second;
+                cnt[t] = tbl_count(b, e, '\n');
+                // last row without trailing newline
+                if (e > b && e[-1] != '\n') cnt[t]++;
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+
+        row_begin.resize(ranges.size());
+        nrow = 0;
+        for (size_t t = 0; t < ranges.size(); ++t) {
+            row_begin[t] = nrow;
+            nrow += cnt[t];
+        }
+    }
+
+    void parse_range(size_t t, const std::vector<TblCol>& cols, const std::vector<int>& field_col, size_t max_row) {
+        const char* p = ranges[t].first;
+        const char* end = ranges[t].second;
+        int max_field = (int)field_col.size() - 1;
+
+        for (size_t r = row_begin[t]; p < end && r < max_row; ++r) {
+            const char* eol = tbl_find(p, end, '\n');
+            for (int f = 0; f <= max_field && p < eol; ++f) {
+                const char* e = tbl_find(p, eol, '|');
+                int c = field_col[f];
+                if (c >= 0) {
+                    const TblCol& col = cols[c];
+                    if (col.type == TBL_STR) {
+                        char* d = (char*)col.dst + r * col.width;
+                        size_t len = e - p;
+                        if (len > col.width - 1) len = col.width - 1;
+                        memcpy(d, p, len);
+                        memset(d + len, 0, col.width - len);
+                    } else {
+                        TPCH_INT v;
+                        if (col.type == TBL_INT) {
+                            v = tbl_parse_int(p, e);
+                        } else if (col.type == TBL_DATE) {
+                            v = tbl_parse_date(p, e);
+                        } else if (col.type == TBL_MONEY) {
+                            v = tbl_parse_money(p, e);
+                        } else {
+                            v = (p < e) ? *p : 0;
+                        }
+                        memcpy((char*)col.dst + r * col.width, &v, sizeof(TPCH_INT));
+                    }
+                }
+                p = e + 1;
+            }
+            p = eol + 1;
+        }
+    }
+};
+
+// one cached column as recorded in the stamp
+struct TblStampCol {
+    std::string name;
+    int field;
+    int type;
+    size_t width;
+};
+
+/* The stamp of a cached .tbl holds "<size> <mtime> <nrow>" of the source on its first line,
+ * then one "<name> <field> <type> <width>" line per cached column.
+ * Returns false if the stamp is missing or malformed.
+ * */
+inline bool tbl_read_stamp(const std::string& path,
+                           long long& size,
+                           long long& mtime,
+                           long long& nrow,
+                           std::vector<TblStampCol>& cols) {
+    FILE* f = fopen(path.c_str(), "r");
+    if (!f) return false;
+    bool ok = fscanf(f, "%lld %lld %lld", &size, &mtime, &nrow) == 3;
+    char name[256];
+    TblStampCol c;
+    while (ok && fscanf(f, "%255s %d %d %zu", name, &c.field, &c.type, &c.width) == 4) {
+        c.name = name;
+        cols.push_back(c);
+    }
+    fclose(f);
+    return ok;
+}
+
+/* Load columns of a .tbl through the binary column cache in cache_dir.
+ * names[i] is the cache file name of cols[i], without ".dat".
+ * A cached column is used only if the stamp records the same source size and mtime
+ * and the same field, type and width for it, otherwise the .tbl is parsed again.
+ * Returns the number of rows loaded, or -1 on error, including a table with more than max_row rows.
+ * */
+inline long load_tbl_cached(const std::string& tbl_path,
+                            const std::string& cache_dir,
+                            const std::vector<std::string>& names,
+                            const std::vector<TblCol>& cols,
+                            size_t max_row,
+                            int nthread = 0) {
+    struct stat info;
+    if (stat(tbl_path.c_str(), &info) != 0 || names.size() != cols.size()) return -1;
+
+    std::string base = tbl_path.substr(tbl_path.find_last_of('/') + 1);
+    std::string stamp = cache_dir + "/." + base + ".stamp";
+
+    long long s_size = 0, s_mtime = 0, s_nrow = -1;
+    std::vector<TblStampCol> s_cols;
+    bool fresh = tbl_read_stamp(stamp, s_size, s_mtime, s_nrow, s_cols) && s_nrow >= 0 &&
+                 s_size == (long long)info.st_size && s_mtime == (long long)info.st_mtime;
+    if (!fresh) s_cols.clear();
+
+    if (fresh && (size_t)s_nrow > max_row) {
+        printf("ERROR: %s has %lld rows, buffer holds %zu.\n", tbl_path.c_str(), s_nrow, max_row);
+        return -1;
+    }
+
+    if (fresh) {
+        size_t n = s_nrow;
+        bool hit = true;
+        for (size_t i = 0; i < cols.size() && hit; ++i) {
+            bool same = false;
+            for (size_t j = 0; j < s_cols.size() && !same; ++j) {
+                same = s_cols[j].name == names[i] && s_cols[j].field == cols[i].field &&
+                       s_cols[j].type == (int)cols[i].type && s_cols[j].width == cols[i].width;
+            }
+            if (!same) {
+                hit = false;
+                break;
+            }
+            std::string fn = cache_dir + "/" + names[i] + ".dat";
+            FILE* fc = fopen(fn.c_str(), "rb");
+            if (!fc) {
+                hit = false;
+                break;
+            }
+            if (fread(cols[i].dst, cols[i].width, n, fc) != n) hit = false;
+            fclose(fc);
+        }
+        if (hit) return n;
+    }
+
+    TblReader reader(tbl_path, nthread);
+    if (!reader.valid()) return -1;
+    size_t nrow = reader.rows();
+    if (nrow > max_row) {
+        printf("ERROR: %s has %zu rows, buffer holds %zu.\n", tbl_path.c_str(), nrow, max_row);
+        return -1;
+    }
+    reader.parse(cols, max_row);
+
+    // keep the entries of other cached columns of the same source
+    std::vector<TblStampCol> out_cols;
+    for (size_t j = 0; j < s_cols.size(); ++j) {
+        bool rewritten = false;
+        for (size_t i = 0; i < names.size() && !rewritten; ++i) rewritten = s_cols[j].name == names[i];
+        if (!rewritten) out_cols.push_back(s_cols[j]);
+    }
+    for (size_t i = 0; i < cols.size(); ++i) {
+        std::string fn = cache_dir + "/" + names[i] + ".dat";
+        FILE* fc = fopen(fn.c_str(), "wb");
+        if (!fc) {
+            printf("WARNING: %s cannot be opened for write, cache disabled.\n", fn.c_str());
+            return nrow;
+        }
+        fwrite(cols[i].dst, cols[i].width, nrow, fc);
+        fclose(fc);
+        TblStampCol c = {names[i], cols[i].field, (int)cols[i].type, cols[i].width};
+        out_cols.push_back(c);
+    }
+    FILE* f = fopen(stamp.c_str(), "w");
+    if (f) {
+        fprintf(f, "%lld %lld %lld\n", (long long)info.st_size, (long long)info.st_mtime, (long long)nrow);
+        for (size_t j = 0; j < out_cols.size(); ++j) {
+            fprintf(f, "%s %d %d %zu\n", out_cols[j].name.c_str(), out_cols[j].field, out_cols[j].type,
+                    out_cols[j].width);
+        }
+        fclose(f);
+    }
+    return nrow;
+}
+
+#endif
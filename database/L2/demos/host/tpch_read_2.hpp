@@ -65,6 +65,24 @@ typedef int32_t TPCH_INT;
 #define SF30_REGION 5
 #define SF30_CUSTOMER 4500000
 #define SF30_SUPPLIER 300000
+
+#define SF300_LINEITEM 1799989091
+#define SF300_ORDERS 450000000
+#define SF300_NATION 25
+#define SF300_PART 60000000
+#define SF300_PARTSUPP 240000000
+#define SF300_REGION 5
+#define SF300_CUSTOMER 45000000
+#define SF300_SUPPLIER 3000000
+
+#define SF1000_LINEITEM 5999989709LL
+#define SF1000_ORDERS 1500000000
+#define SF1000_NATION 25
+#define SF1000_PART 200000000
+#define SF1000_PARTSUPP 800000000
+#define SF1000_REGION 5
+#define SF1000_CUSTOMER 150000000
+#define SF1000_SUPPLIER 10000000
 /* tpch_read.h provide read interface to access .tbl of TPC-H.
  * There're 8 kinds of .tbl files and tpch_read.h offers Read Row and Read Column.
  *
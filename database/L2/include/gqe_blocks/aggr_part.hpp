@@ -174,6 +174,97 @@ void aggregate(hls::stream<ap_uint<_Wp> >& in_strm,
     out_e_strm.write(true);
 }
 
+// aggregate 2 columns, as 2 aggregate when wide is off, and as one signed 2 * _Wp value with the lower half in
+// the 1st column and a 4 * _Wp sum when wide is on, then the 1st column gets the lower halves of min and max and
+// the lower half of sum, and the 2nd column gets the upper halves
+template <int _Wp>
+void aggregate_pair(bool wide,
+                    hls::stream<ap_uint<_Wp> >& in0_strm,
+                    hls::stream<ap_uint<_Wp> >& in1_strm,
+                    hls::stream<bool>& in_e_strm,
+                    hls::stream<ap_uint<_Wp> >& out0_strm,
+                    hls::stream<ap_uint<_Wp> >& out1_strm,
+                    hls::stream<bool>& out_e_strm) {
+    ap_int<_Wp> min[2];
+    ap_int<_Wp> max[2];
+    ap_int<_Wp * 2> sum[2];
+    ap_uint<_Wp> cnt_nz[2];
+#pragma HLS array_partition variable = min complete
+#pragma HLS array_partition variable = max complete
+#pragma HLS array_partition variable = sum complete
+#pragma HLS array_partition variable = cnt_nz complete
+    for (int i = 0; i < 2; ++i) {
+#pragma HLS unroll
+        min[i] = 0;
+        min[i] = ~min[i];
+        min[i][_Wp - 1] = 0;
+        max[i] = 0;
+        max[i][_Wp - 1] = 1;
+        sum[i] = 0;
+        cnt_nz[i] = 0;
+    }
+    ap_int<_Wp * 2> min_w = 0;
+    min_w = ~min_w;
+    min_w[_Wp * 2 - 1] = 0;
+    ap_int<_Wp * 2> max_w = 0;
+    max_w[_Wp * 2 - 1] = 1;
+    ap_int<_Wp * 4> sum_w = 0;
+    ap_uint<_Wp> cnt = 0;
+    ap_uint<_Wp> cnt_nz_w = 0;
+
+    bool e = in_e_strm.read();
+    if (!e) {
+        while (!e) {
+#pragma HLS pipeline
+            e = in_e_strm.read();
+            ap_uint<_Wp> t[2];
+#pragma HLS array_partition variable = t complete
+            t[0] = in0_strm.read();
+            t[1] = in1_strm.read();
+            for (int i = 0; i < 2; ++i) {
+#pragma HLS unroll
+                ap_int<_Wp> v = t[i];
+                min[i] = (v < min[i]) ? v : min[i];
+                max[i] = (v > max[i]) ? v : max[i];
+                sum[i] += v;
+                cnt_nz[i] = v == 0 ? cnt_nz[i] : (ap_uint<_Wp>)(cnt_nz[i] + 1);
+            }
+            ap_int<_Wp * 2> w = (t[1], t[0]);
+            min_w = (w < min_w) ? w : min_w;
+            max_w = (w > max_w) ? w : max_w;
+            sum_w += w;
+            ++cnt;
+            cnt_nz_w = w == 0 ? cnt_nz_w : (ap_uint<_Wp>)(cnt_nz_w + 1);
+        }
+        ap_uint<_Wp> res[2][6];
+#pragma HLS array_partition variable = res complete dim = 0
+        for (int i = 0; i < 2; ++i) {
+#pragma HLS unroll
+            if (wide) {
+                res[i][0] = min_w.range(_Wp * (i + 1) - 1, _Wp * i);
+                res[i][1] = max_w.range(_Wp * (i + 1) - 1, _Wp * i);
+                res[i][2] = sum_w.range(_Wp * (2 * i + 1) - 1, _Wp * 2 * i);
+                res[i][3] = sum_w.range(_Wp * (2 * i + 2) - 1, _Wp * (2 * i + 1));
+                res[i][5] = cnt_nz_w;
+            } else {
+                res[i][0] = min[i];
+                res[i][1] = max[i];
+                res[i][2] = sum[i].range(_Wp - 1, 0);
+                res[i][3] = sum[i].range(_Wp * 2 - 1, _Wp);
+                res[i][5] = cnt_nz[i];
+            }
+            res[i][4] = cnt;
+        }
+        for (int r = 0; r < 6; ++r) {
+#pragma HLS pipeline II = 1
+            out0_strm.write(res[0][r]);
+            out1_strm.write(res[1][r]);
+            out_e_strm.write(false);
+        }
+    }
+    out_e_strm.write(true);
+}
+
 template <int N>
 void multi_agg(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[N],
                hls::stream<bool>& e_in_strm,
@@ -195,66 +286,126 @@ void multi_agg(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[N],
     e_sink<N>(e_strm, e_out_strm);
 }
 
+// as multi_agg, with bit k of pair set when columns 2k and 2k + 1 hold one 64-bit value
+template <int N>
+void multi_agg(ap_uint<N / 2> pair,
+               hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[N],
+               hls::stream<bool>& e_in_strm,
+               hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[N],
+               hls::stream<bool>& e_out_strm) {
+#pragma HLS dataflow
+
+    hls::stream<bool> mid_e_strm[N / 2];
+#pragma HLS stream variable = mid_e_strm depth = 2
+#pragma HLS array_partition variable = mid_e_strm dim = 0
+    hls::stream<bool> e_strm[N / 2];
+#pragma HLS stream variable = e_strm depth = 2
+#pragma HLS array_partition variable = e_strm dim = 0
+    e_dup<N / 2>(e_in_strm, mid_e_strm);
+    for (int k = 0; k < N / 2; ++k) {
+#pragma HLS unroll
+        aggregate_pair(pair[k], in_strm[2 * k], in_strm[2 * k + 1], mid_e_strm[k], out_strm[2 * k],
+                       out_strm[2 * k + 1], e_strm[k]);
+    }
+    e_sink<N / 2>(e_strm, e_out_strm);
+}
+
+// pass rows through
+template <int N>
+void agg_bypass(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[N],
+                hls::stream<bool>& e_in_strm,
+                hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[N],
+                hls::stream<bool>& e_out_strm) {
+    ap_uint<8 * TPCH_INT_SZ> temp[N];
+    bool e = e_in_strm.read();
+
+#ifndef __SYNTHESIS__
+    int cnt = 0;
+    std::cout << "Column number:" << N << std::endl;
+#endif
+
+    while (!e) {
+        for (int i = 0; i < N; i++) {
+#pragma HLS unroll
+            temp[i] = in_strm[i].read();
+            out_strm[i].write(temp[i]);
+        }
+
+#ifndef __SYNTHESIS__
+        if (cnt < 10) {
+            for (int i = 0; i < 8; i++) {
+                std::cout << "col" << i << ": " << temp[i] << " ";
+            }
+            std::cout << std::endl;
+            for (int i = 8; i < N; i++) {
+                std::cout << "col" << i << ": " << temp[i] << " ";
+            }
+            std::cout << std::endl;
+        }
+        cnt++;
+#endif
+
+        e = e_in_strm.read();
+        e_out_strm.write(false);
+    };
+    e_out_strm.write(true);
+}
+
 template <int N>
 void agg_wrapper(hls::stream<bool>& agg_on_strm,
                  hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[N],
                  hls::stream<bool>& e_in_strm,
                  hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[N],
                  hls::stream<bool>& e_out_strm) {
-    ap_uint<8 * TPCH_INT_SZ> temp[N];
     bool agg_on = agg_on_strm.read();
     if (agg_on) {
         multi_agg<N>(in_strm, e_in_strm, out_strm, e_out_strm);
     } else {
-        // bypass
-        bool e = e_in_strm.read();
-
-#ifndef __SYNTHESIS__
-        int cnt = 0;
-        std::cout << "Column number:" << N << std::endl;
-#endif
-
-        while (!e) {
-            for (int i = 0; i < N; i++) {
-#pragma HLS unroll
-                temp[i] = in_strm[i].read();
-                out_strm[i].write(temp[i]);
-            }
+        agg_bypass<N>(in_strm, e_in_strm, out_strm, e_out_strm);
+    }
+}
 
+// as agg_wrapper, with pairs of columns holding 64-bit values aggregated into 128-bit sums, EN_PAIR false leaves
+// out the 128-bit adders and takes every column as 32-bit
+template <int N, bool EN_PAIR>
+void agg_wrapper(hls::stream<bool>& agg_on_strm,
+                 hls::stream<ap_uint<32> >& agg_pair_strm,
+                 hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[N],
+                 hls::stream<bool>& e_in_strm,
+                 hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[N],
+                 hls::stream<bool>& e_out_strm) {
+    bool agg_on = agg_on_strm.read();
+    ap_uint<N / 2> pair = agg_pair_strm.read().range(N / 2 - 1, 0);
+    if (agg_on && EN_PAIR) {
+        multi_agg<N>(pair, in_strm, e_in_strm, out_strm, e_out_strm);
+    } else if (agg_on) {
 #ifndef __SYNTHESIS__
-            if (cnt < 10) {
-                for (int i = 0; i < 8; i++) {
-                    std::cout << "col" << i << ": " << temp[i] << " ";
-                }
-                std::cout << std::endl;
-                for (int i = 8; i < N; i++) {
-                    std::cout << "col" << i << ": " << temp[i] << " ";
-                }
-                std::cout << std::endl;
-            }
-            cnt++;
+        if (pair != 0) {
+            std::cout << "WARNING: 128-bit sums requested, but the kernel is built without them" << std::endl;
+        }
 #endif
-
-            e = e_in_strm.read();
-            e_out_strm.write(false);
-        };
-        e_out_strm.write(true);
+        multi_agg<N>(in_strm, e_in_strm, out_strm, e_out_strm);
+    } else {
+        agg_bypass<N>(in_strm, e_in_strm, out_strm, e_out_strm);
     }
 }
 
 static void eval_wrapper(hls::stream<ap_uint<289> >& alu_cfg_strm,
+                         hls::stream<ap_uint<32> >& dec_cfg_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key0_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key1_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key2_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key3_strm,
                          hls::stream<bool>& e_keys_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_strm,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_hi_strm,
                          hls::stream<bool>& e_out_strm);
 static void dynamic_eval_stage(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[4],
                                hls::stream<bool>& e_in_strm,
-                               hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[5],
+                               hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[6],
                                hls::stream<bool>& e_out_strm,
-                               hls::stream<ap_uint<289> >& alu_cfg_strm);
+                               hls::stream<ap_uint<289> >& alu_cfg_strm,
+                               hls::stream<ap_uint<32> >& dec_cfg_strm);
 static void aggregate(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[5],
                       hls::stream<bool>& e_in_strm,
                       hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[5],
@@ -0,0 +1,256 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GQE_BLOOM_FILTER_PART_HPP
+#define GQE_BLOOM_FILTER_PART_HPP
+
+#ifndef __SYNTHESIS__
+#include <stdio.h>
+#include <iostream>
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "xf_database/hash_lookup3.hpp"
+
+#include "gqe_blocks/gqe_types.hpp"
+
+namespace xf {
+namespace database {
+namespace gqe {
+
+// blocked bloom filter: all hash bits of one key fall into the same 64-bit word,
+// so each row costs one read (probe) or one read-modify-write (build).
+template <int BF_W>
+inline void bloom_filter_pos(ap_uint<8 * TPCH_INT_SZ> k0,
+                             ap_uint<8 * TPCH_INT_SZ> k1,
+                             bool dual_key,
+                             ap_uint<BF_W - 6>& addr,
+                             ap_uint<6> bit[3]) {
+#pragma HLS inline
+    ap_uint<8 * TPCH_INT_SZ * 2> key;
+    key.range(8 * TPCH_INT_SZ - 1, 0) = k0;
+    key.range(8 * TPCH_INT_SZ * 2 - 1, 8 * TPCH_INT_SZ) = dual_key ? k1 : (ap_uint<8 * TPCH_INT_SZ>)0;
+    ap_uint<64> hash;
+    xf::database::details::hashlookup3_core<8 * TPCH_INT_SZ * 2>(key, hash);
+    addr = hash.range(BF_W - 7, 0);
+    bit[0] = hash.range(37, 32);
+    bit[1] = hash.range(43, 38);
+    bit[2] = hash.range(49, 44);
+}
+
+/// @brief one pass over the channels, each channel is served on its own every cycle and keeps its own copy of the
+/// bit vector, so the stage moves CH_NM rows per cycle in every mode.
+/// mode 0 passes rows through, mode 1 inserts keys into the bit vector, mode 2 drops rows whose key misses.
+template <int COL_NM, int CH_NM, int BF_W>
+void bloom_filter_round(int mode,
+                        bool dual_key,
+                        ap_uint<64> bit_vector[CH_NM][1 << (BF_W - 6)],
+                        hls::stream<ap_uint<8 * TPCH_INT_SZ> > istrm[CH_NM][COL_NM],
+                        hls::stream<bool> e_istrm[CH_NM],
+                        hls::stream<ap_uint<8 * TPCH_INT_SZ> > ostrm[CH_NM][COL_NM],
+                        hls::stream<bool> e_ostrm[CH_NM],
+                        ap_uint<32>& row_nm,
+                        ap_uint<32>& drop_nm) {
+    const int MAX = (1 << CH_NM) - 1;
+    ap_uint<CH_NM> last = 0;
+
+    ap_uint<32> row_ch[CH_NM];
+#pragma HLS array_partition variable = row_ch complete
+    ap_uint<32> drop_ch[CH_NM];
+#pragma HLS array_partition variable = drop_ch complete
+    // last three updates of each channel, their words may not be written back yet
+    ap_uint<BF_W - 6> addr_r0[CH_NM], addr_r1[CH_NM], addr_r2[CH_NM];
+#pragma HLS array_partition variable = addr_r0 complete
+#pragma HLS array_partition variable = addr_r1 complete
+#pragma HLS array_partition variable = addr_r2 complete
+    ap_uint<64> word_r0[CH_NM], word_r1[CH_NM], word_r2[CH_NM];
+#pragma HLS array_partition variable = word_r0 complete
+#pragma HLS array_partition variable = word_r1 complete
+#pragma HLS array_partition variable = word_r2 complete
+    for (int i = 0; i < CH_NM; i++) {
+#pragma HLS unroll
+        row_ch[i] = 0;
+        drop_ch[i] = 0;
+        addr_r0[i] = ~(ap_uint<BF_W - 6>)0; // holds 0 like the cleared word at that address
+        addr_r1[i] = ~(ap_uint<BF_W - 6>)0;
+        addr_r2[i] = ~(ap_uint<BF_W - 6>)0;
+        word_r0[i] = 0;
+        word_r1[i] = 0;
+        word_r2[i] = 0;
+    }
+
+    do {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = bit_vector inter false
+        for (int i = 0; i < CH_NM; i++) {
+#pragma HLS unroll
+            if (!last[i] && !e_istrm[i].empty()) {
+                bool e = e_istrm[i].read();
+                last[i] = e;
+                if (!e) {
+                    ap_uint<8 * TPCH_INT_SZ> row[COL_NM];
+#pragma HLS array_partition variable = row complete
+                    for (int c = 0; c < COL_NM; ++c) {
+#pragma HLS unroll
+                        row[c] = istrm[i][c].read();
+                    }
+
+                    bool pass = true;
+                    if (mode != 0) {
+                        ap_uint<BF_W - 6> addr;
+                        ap_uint<6> bit[3];
+#pragma HLS array_partition variable = bit complete
+                        bloom_filter_pos<BF_W>(row[0], row[1], dual_key, addr, bit);
+
+                        // the probe round writes nothing, and a fresh register may alias the last word
+                        ap_uint<64> word;
+                        if (mode == 1 && addr == addr_r0[i])
+                            word = word_r0[i];
+                        else if (mode == 1 && addr == addr_r1[i])
+                            word = word_r1[i];
+                        else if (mode == 1 && addr == addr_r2[i])
+                            word = word_r2[i];
+                        else
+                            word = bit_vector[i][addr];
+
+                        if (mode == 1) {
+                            for (int k = 0; k < 3; ++k) {
+#pragma HLS unroll
+                                word[bit[k]] = 1;
+                            }
+                            bit_vector[i][addr] = word;
+
+                            word_r2[i] = word_r1[i];
+                            word_r1[i] = word_r0[i];
+                            word_r0[i] = word;
+                            addr_r2[i] = addr_r1[i];
+                            addr_r1[i] = addr_r0[i];
+                            addr_r0[i] = addr;
+                        } else {
+                            pass = word[bit[0]] && word[bit[1]] && word[bit[2]];
+                            row_ch[i]++;
+                            if (!pass) drop_ch[i]++;
+                        }
+                    }
+
+                    if (pass) {
+                        for (int c = 0; c < COL_NM; ++c) {
+#pragma HLS unroll
+                            ostrm[i][c].write(row[c]);
+                        }
+                        e_ostrm[i].write(false);
+                    }
+                }
+            }
+        }
+    } while (last != MAX);
+
+    for (int i = 0; i < CH_NM; i++) {
+#pragma HLS unroll
+        e_ostrm[i].write(true);
+        row_nm += row_ch[i];
+        drop_nm += drop_ch[i];
+    }
+}
+
+/// @brief runtime bloom-filter pushdown between the build and probe side of gqeJoin.
+///
+/// The build round fills the bit vector with the join key(s) of table A, the probe round drops rows of table B
+/// that cannot find a match before they reach hash-join. Each channel inserts into its own copy of the bit vector,
+/// the copies are OR-ed together between the rounds, so neither round merges the channels. When the filter is off,
+/// the clear and merge passes are skipped and every channel passes its rows straight through.
+/// Statistics are emitted for the table header: set bits, total bits, probe rows and dropped probe rows.
+///
+/// @tparam COL_NM number of columns per channel, key at column 0 and second key at column 1.
+/// @tparam CH_NM number of channels.
+/// @tparam BF_W log2 of the bit-vector size in bits.
+template <int COL_NM, int CH_NM, int BF_W>
+void bloom_filter_wrapper(hls::stream<bool>& join_on_strm,
+                          hls::stream<ap_uint<2> >& bf_cfg_strm,
+                          hls::stream<ap_uint<8 * TPCH_INT_SZ> > istrm[CH_NM][COL_NM],
+                          hls::stream<bool> e_istrm[CH_NM],
+                          hls::stream<ap_uint<8 * TPCH_INT_SZ> > ostrm[CH_NM][COL_NM],
+                          hls::stream<bool> e_ostrm[CH_NM],
+                          hls::stream<ap_uint<32> >& bf_stat_strm) {
+    ap_uint<64> bit_vector[CH_NM][1 << (BF_W - 6)];
+#pragma HLS array_partition variable = bit_vector dim = 1
+#pragma HLS resource variable = bit_vector core = XPM_MEMORY uram
+
+    bool join_on = join_on_strm.read();
+    ap_uint<2> bf_cfg = bf_cfg_strm.read();
+    bool bf_on = bf_cfg[0];
+    bool dual_key = bf_cfg[1];
+
+    ap_uint<32> set_nm = 0;
+    ap_uint<32> row_nm = 0;
+    ap_uint<32> drop_nm = 0;
+
+    if (bf_on) {
+    BF_CLEAR:
+        for (int a = 0; a < (1 << (BF_W - 6)); ++a) {
+#pragma HLS pipeline II = 1
+            for (int i = 0; i < CH_NM; i++) {
+#pragma HLS unroll
+                bit_vector[i][a] = 0;
+            }
+        }
+        bloom_filter_round<COL_NM, CH_NM, BF_W>(1, dual_key, bit_vector, istrm, e_istrm, ostrm, e_ostrm, row_nm,
+                                                drop_nm);
+    BF_MERGE:
+        for (int a = 0; a < (1 << (BF_W - 6)); ++a) {
+#pragma HLS pipeline II = 1
+            ap_uint<64> word = 0;
+            for (int i = 0; i < CH_NM; i++) {
+#pragma HLS unroll
+                word |= bit_vector[i][a];
+            }
+            for (int i = 0; i < CH_NM; i++) {
+#pragma HLS unroll
+                bit_vector[i][a] = word;
+            }
+            ap_uint<7> cnt = 0;
+            for (int b = 0; b < 64; b++) {
+#pragma HLS unroll
+                cnt += word[b];
+            }
+            set_nm += cnt;
+        }
+        bloom_filter_round<COL_NM, CH_NM, BF_W>(2, dual_key, bit_vector, istrm, e_istrm, ostrm, e_ostrm, row_nm,
+                                                drop_nm);
+#ifndef __SYNTHESIS__
+        std::cout << "Bloom filter: set " << set_nm << " of " << (1 << BF_W) << " bits, dropped " << drop_nm
+                  << " of " << row_nm << " probe rows" << std::endl;
+#endif
+    } else {
+        int lp_nm = join_on ? 2 : 1;
+        for (int r = 0; r < lp_nm; ++r) {
+            bloom_filter_round<COL_NM, CH_NM, BF_W>(0, dual_key, bit_vector, istrm, e_istrm, ostrm, e_ostrm, row_nm,
+                                                    drop_nm);
+        }
+    }
+
+    bf_stat_strm.write(set_nm);
+    bf_stat_strm.write(bf_on ? (ap_uint<32>)(1 << BF_W) : (ap_uint<32>)0);
+    bf_stat_strm.write(row_nm);
+    bf_stat_strm.write(drop_nm);
+}
+
+} // namespace gqe
+} // namespace database
+} // namespace xf
+
+#endif
@@ -40,8 +40,35 @@ typedef int32_t KEY_T;
 #define HASHJOIN_MAX_ROW (1 << 20)
 #define AGGREGATE_MAX_ROW (1 << 20)
 
+// bit-vector of the join bloom filter holds (1 << BLOOM_FILTER_W) bits
+#define BLOOM_FILTER_W 22
+// its statistics take four 32-bit fields of the output table header from this bit on, clear of the fields
+// for row count, block size, hp_size and column encodings
+#define BLOOM_STAT_LSB 384
+
+// rows kept by the top-k stage of gqeJoin and gqeAggr, 0 builds the kernels without the stage
+#ifndef GQE_TOP_K_MAX
+#define GQE_TOP_K_MAX 128
+#endif
+
+// decimal eval of gqeJoin, with its 64-bit divider, and the 128-bit sums of column pairs, 0 builds the kernel
+// without them
+#ifndef GQE_DECIMAL
+#define GQE_DECIMAL 1
+#endif
+
 #define BURST_LEN 32
 
+// encoding of a column, one nibble per column id in bits 287:256 of the table header
+#define COL_PLAIN 0
+#define COL_DICT 1
+#define COL_RLE 2
+#define COL_FOR 3
+// set in the nibble of a dictionary column to scan out the codes instead of the values
+#define COL_KEEP_CODE 8
+// max entries of a dictionary decoded on chip
+#define SCAN_DICT_SZ 256
+
 } // namespace gqe
 } // namespace database
 } // namespace xf
@@ -31,6 +31,13 @@
 #include <iostream>
 #endif
 
+// hash join scans its hash counters and appends overflow rows and longest chain to end status when profiled
+#ifdef GQE_PROFILE
+#define GQE_HT_STAT true
+#else
+#define GQE_HT_STAT false
+#endif
+
 namespace xf {
 namespace database {
 namespace gqe {
@@ -164,8 +171,8 @@ void hash_join_plus_adapter(bool jn_on,
     }
 #endif
 
-    // <int HASH_MODE, int KEYW, int PW, int S_PW, int B_PW, int HASHWH, int HASHWL, int ARW, int CH_NM>
-    xf::database::hashMultiJoin<1, 64, 192, 192, 192, 3, 17, 24, 4>(
+    // <int HASH_MODE, int KEYW, int PW, int S_PW, int B_PW, int HASHWH, int HASHWL, int ARW, int CH_NM, bool EN_STAT>
+    xf::database::hashMultiJoin<1, 64, 192, 192, 192, 3, 17, 24, 4, GQE_HT_STAT>(
         join_flag_strm, key_strm, pld_strm, e_join_pld_strm, htb_buf0, htb_buf1, htb_buf2, htb_buf3, htb_buf4, htb_buf5,
         htb_buf6, htb_buf7, stb_buf0, stb_buf1, stb_buf2, stb_buf3, stb_buf4, stb_buf5, stb_buf6, stb_buf7,
         pu_b_status_strm, pu_e_status_strm, joined_strm, e_joined_strm);
@@ -179,12 +186,16 @@ void hash_join_plus_adapter(bool jn_on,
 
 template <int COL_IN_NM, int CH_NM, int COL_OUT_NM, int ROUND_NM>
 void hash_join_wrapper(hls::stream<ap_uint<3> >& join_flag_strm,
+                       hls::stream<ap_uint<32> >& ht_cfg_strm,
                        hls::stream<bool>& jn_on_strm,
                        hls::stream<bool>& mk_on_strm,
                        hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[CH_NM][COL_IN_NM],
                        hls::stream<bool> e_in_strm[CH_NM],
                        hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[COL_OUT_NM],
                        hls::stream<bool>& e_out_strm,
+#ifdef GQE_PROFILE
+                       hls::stream<ap_uint<32> >& jn_stat_strm,
+#endif
                        ap_uint<64>* htb_buf0,
                        ap_uint<64>* htb_buf1,
                        ap_uint<64>* htb_buf2,
@@ -206,11 +217,12 @@ void hash_join_wrapper(hls::stream<ap_uint<3> >& join_flag_strm,
     hls::stream<ap_uint<32> > pu_begin_status_strm;
 #pragma HLS stream variable = pu_begin_status_strm depth = 2
     hls::stream<ap_uint<32> > pu_end_status_strm;
-#pragma HLS stream variable = pu_end_status_strm depth = 2
+#pragma HLS stream variable = pu_end_status_strm depth = 4
 
     if (jn_on) {
         pu_begin_status_strm.write(31);
-        pu_begin_status_strm.write(0);
+        // probe-only flag and address of the hash table kept in htb buffers
+        pu_begin_status_strm.write(ht_cfg_strm.read());
         hash_join_plus_adapter<COL_IN_NM, CH_NM, COL_OUT_NM, ROUND_NM>(
             jn_on, mk_on, join_flag_strm, in_strm, e_in_strm, out_strm, e_out_strm, pu_begin_status_strm,
             pu_end_status_strm, htb_buf0, htb_buf1, htb_buf2, htb_buf3, htb_buf4, htb_buf5, htb_buf6, htb_buf7,
@@ -219,6 +231,17 @@ void hash_join_wrapper(hls::stream<ap_uint<3> >& join_flag_strm,
         int pu2 = pu_end_status_strm.read();
 #ifndef __SYNTHESIS__
         printf("Hash join finished pu1 = %d, pu2 = %d", pu1, pu2);
+        // bit 31 of join number, a PU has more build rows than outer join tracks
+        if (pu2 < 0) printf("\nERROR: build rows without match are not emitted by outer join\n");
+        // bit 30, the hash table asked for is not saved
+        if (pu2 & (1 << 30)) printf("\nERROR: hash table is not saved, overflow rows reach its address\n");
+#endif
+#ifdef GQE_PROFILE
+        jn_stat_strm.write(pu_end_status_strm.read());
+        jn_stat_strm.write(pu_end_status_strm.read());
+    } else {
+        jn_stat_strm.write(0);
+        jn_stat_strm.write(0);
 #endif
     }
 }
@@ -24,6 +24,8 @@
 #include <ap_int.h>
 #include <hls_stream.h>
 
+#include "xf_database/enums.hpp"
+
 #include "gqe_blocks/gqe_types.hpp"
 
 namespace xf {
@@ -50,17 +52,23 @@ void load_config(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> ptr[9],
                  hls::stream<bool> join_on_strm[JN_NM],
                  hls::stream<bool>& join_dual_key_on_strm,
                  hls::stream<bool>& agg_on_strm,
+                 hls::stream<ap_uint<32> >& agg_pair_strm,
                  hls::stream<ap_uint<3> >& join_flag_strm,
+                 hls::stream<ap_uint<2> >& bloom_cfg_strm,
                  hls::stream<int8_t>& col_id_A_strm,
                  hls::stream<int8_t>& col_id_B_strm,
                  hls::stream<ap_uint<32> >& write_out_cfg_strm,
                  hls::stream<ap_uint<289> >& alu1_cfg_strm,
                  hls::stream<ap_uint<289> >& alu2_cfg_strm,
+                 hls::stream<ap_uint<32> >& dec1_cfg_strm,
+                 hls::stream<ap_uint<32> >& dec2_cfg_strm,
                  hls::stream<ap_uint<32> >& filter_cfg_strm,
                  hls::stream<ap_uint<8 * 8> > shuffle1_cfg_strm[4],
                  hls::stream<ap_uint<8 * 8> >& shuffle2_cfg_strm,
                  hls::stream<ap_uint<8 * 8> >& shuffle3_cfg_strm,
-                 hls::stream<ap_uint<8 * 8> >& shuffle4_cfg_strm) {
+                 hls::stream<ap_uint<8 * 8> >& shuffle4_cfg_strm,
+                 hls::stream<ap_uint<32> >& topk_cfg_strm,
+                 hls::stream<ap_uint<32> >& ht_cfg_strm) {
     const int filter_cfg_depth = 45;
 
     ap_uint<8 * TPCH_INT_SZ * VEC_LEN> config[9];
@@ -104,6 +112,17 @@ void load_config(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> ptr[9],
 
     join_flag = config[0].range(5, 3);
 
+    // hash table reuse, bit 31 for probe-only and bits 30:0 for the save address, in the spare word behind filter B
+    ap_uint<32> ht_cfg = config[8].range(447, 416);
+
+    // bloom-filter pushdown, anti-join and probe side outer join need every probe row so they never filter,
+    // nor does probe-only join, whose build table is not scanned
+    ap_uint<2> bloom_cfg;
+    bloom_cfg[0] = join_on && config[0][7] == 1 && join_flag != xf::database::enums::JT_ANTI &&
+                   join_flag != xf::database::enums::JT_LEFT && join_flag != xf::database::enums::JT_FULL &&
+                   ht_cfg[31] == 0;
+    bloom_cfg[1] = join_dual_key_on;
+
     for (int i = 0; i < 8; i++) {
         col_id_A[i] = config[0].range(56 + 8 * i + 7, 56 + 8 * i);
     }
@@ -123,6 +142,12 @@ void load_config(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> ptr[9],
     alu_cfg1.range(288, 0) = config[1].range(288, 0);
     alu_cfg2.range(288, 0) = config[2].range(288, 0);
 
+    // decimal eval in the spare bits behind each alu config, exponent of 10 in bits 7:0, division in bit 8 and
+    // enable in bit 9, and the pairs of aggregate columns holding 64-bit values behind the 2nd one
+    ap_uint<32> dec_cfg1 = config[1].range(351, 320);
+    ap_uint<32> dec_cfg2 = config[2].range(351, 320);
+    ap_uint<32> agg_pair = config[2].range(383, 352);
+
     for (int i = 0; i < filter_cfg_depth; i++) {
         filter_cfg_a[i] = config[3 + i / 16].range(32 * ((i % 16) + 1) - 1, 32 * (i % 16));
     }
@@ -146,11 +171,18 @@ void load_config(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> ptr[9],
         join_on_strm[i].write(join_on);
     }
     join_dual_key_on_strm.write(join_dual_key_on);
+    bloom_cfg_strm.write(bloom_cfg);
     agg_on_strm.write(agg_on);
+    agg_pair_strm.write(agg_pair);
 
     alu1_cfg_strm.write(alu_cfg1);
     alu2_cfg_strm.write(alu_cfg2);
+    dec1_cfg_strm.write(dec_cfg1);
+    dec2_cfg_strm.write(dec_cfg2);
     write_out_cfg_strm.write(write_out_cfg);
+    // top-k uses the spare bits behind filter B
+    topk_cfg_strm.write(config[8].range(479, 448));
+    topk_cfg_strm.write(config[8].range(511, 480));
 
     if (join_on) {
         shuffle1_cfg_strm[0].write(shuffle_cfg1a);
@@ -186,6 +218,7 @@ void load_config(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> ptr[9],
         }
 
         join_flag_strm.write(join_flag);
+        ht_cfg_strm.write(ht_cfg);
 
     } else {
         shuffle1_cfg_strm[0].write(shuffle_cfg1a);
@@ -217,7 +250,8 @@ void load_config(ap_uint<8 * TPCH_INT_SZ>* ptr,
                  hls::stream<ap_uint<32> >& merge_column_cfg_strm,
                  hls::stream<ap_uint<32> >& group_aggr_cfg_strm,
                  hls::stream<bool>& direct_aggr_cfg_strm,
-                 hls::stream<ap_uint<32> >& write_out_cfg_strm) {
+                 hls::stream<ap_uint<32> >& write_out_cfg_strm,
+                 hls::stream<ap_uint<32> >& topk_cfg_strm) {
     ap_uint<8 * TPCH_INT_SZ> config[128];
 #pragma HLS resource variable = config core = RAM_1P_BRAM
 
@@ -337,6 +371,8 @@ void load_config(ap_uint<8 * TPCH_INT_SZ>* ptr,
     merge_column_cfg_strm.write(merge_column_cfg[1]);
     direct_aggr_cfg_strm.write(direct_aggr_cfg);
     write_out_cfg_strm.write(write_out_cfg);
+    topk_cfg_strm.write(config[83]);
+    topk_cfg_strm.write(config[84]);
 }
 
 } // namespace gqe
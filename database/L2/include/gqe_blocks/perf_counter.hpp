@@ -0,0 +1,197 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file perf_counter.hpp
+ * @brief per-operator counters of GQE kernels, only built with GQE_PROFILE.
+ *
+ * A tap is put on the boundary after each operator. It passes rows through with one row of buffering and
+ * counts, for each round, the rows passed, the cycles its input was empty, the cycles its output was full
+ * and the cycles it ran. Counters of all taps and the hash join stats are written to the profile buffer,
+ * line 0 holds the number of taps in word 0, small table rows beyond hash depth in word 1 and the longest
+ * hash chain in word 2, line 1 + t holds the counters of tap t, as
+ * rows, input stall, output stall and cycles of round 0 in words 0 to 3, and of round 1 in words 4 to 7.
+ * Round 1 is only used by taps before hash join with join on, for the big table.
+ *
+ * This file is part of Vitis Database Library
+ */
+
+#ifndef GQE_PERF_COUNTER_HPP
+#define GQE_PERF_COUNTER_HPP
+
+#ifdef GQE_PROFILE
+
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "gqe_blocks/gqe_types.hpp"
+
+namespace xf {
+namespace database {
+namespace gqe {
+
+/// operators followed by a tap in gqeJoin.
+enum ProfileTap { PROF_SCAN = 0, PROF_FILTER, PROF_BLOOM, PROF_JOIN, PROF_EVAL, PROF_AGGR, PROF_TOPK, PROF_TAP_NM };
+
+// one round of a tap over all channels, counters are summed over channels
+template <int COL_NM, int CH_NM>
+void _prof_tap_round(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[CH_NM][COL_NM],
+                     hls::stream<bool> e_in_strm[CH_NM],
+                     hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[CH_NM][COL_NM],
+                     hls::stream<bool> e_out_strm[CH_NM],
+                     hls::stream<ap_uint<32> >& cnt_strm) {
+    ap_uint<32> rows[CH_NM];
+    ap_uint<32> in_stall[CH_NM];
+    ap_uint<32> out_stall[CH_NM];
+#pragma HLS array_partition variable = rows complete
+#pragma HLS array_partition variable = in_stall complete
+#pragma HLS array_partition variable = out_stall complete
+    for (int ch = 0; ch < CH_NM; ++ch) {
+#pragma HLS unroll
+        rows[ch] = 0;
+        in_stall[ch] = 0;
+        out_stall[ch] = 0;
+    }
+    ap_uint<32> cycles = 0;
+    ap_uint<CH_NM> last = 0;
+PROF_TAP_LOOP:
+    while (last != (ap_uint<CH_NM>)(-1)) {
+#pragma HLS pipeline II = 1
+        for (int ch = 0; ch < CH_NM; ++ch) {
+#pragma HLS unroll
+            if (!last[ch]) {
+                if (e_in_strm[ch].empty()) {
+                    in_stall[ch]++;
+                } else if (e_out_strm[ch].full() || out_strm[ch][0].full()) {
+                    out_stall[ch]++;
+                } else {
+                    bool e = e_in_strm[ch].read();
+                    if (!e) {
+                        for (int c = 0; c < COL_NM; ++c) {
+#pragma HLS unroll
+                            out_strm[ch][c].write(in_strm[ch][c].read());
+                        }
+                        rows[ch]++;
+                    }
+                    e_out_strm[ch].write(e);
+                    last[ch] = e;
+                }
+            }
+        }
+        cycles++;
+    }
+    ap_uint<32> sum[3] = {0, 0, 0};
+    for (int ch = 0; ch < CH_NM; ++ch) {
+        sum[0] += rows[ch];
+        sum[1] += in_stall[ch];
+        sum[2] += out_stall[ch];
+    }
+    cnt_strm.write(sum[0]);
+    cnt_strm.write(sum[1]);
+    cnt_strm.write(sum[2]);
+    cnt_strm.write(cycles);
+}
+
+/// @brief counts rows and stalls on a boundary of CH_NM channels, two rounds when join is on.
+template <int COL_NM, int CH_NM>
+void prof_tap(hls::stream<bool>& join_on_strm,
+              hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[CH_NM][COL_NM],
+              hls::stream<bool> e_in_strm[CH_NM],
+              hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[CH_NM][COL_NM],
+              hls::stream<bool> e_out_strm[CH_NM],
+              hls::stream<ap_uint<32> >& cnt_strm) {
+    bool join_on = join_on_strm.read();
+    _prof_tap_round<COL_NM, CH_NM>(in_strm, e_in_strm, out_strm, e_out_strm, cnt_strm);
+    if (join_on) {
+        _prof_tap_round<COL_NM, CH_NM>(in_strm, e_in_strm, out_strm, e_out_strm, cnt_strm);
+    } else {
+        for (int i = 0; i < 4; ++i) cnt_strm.write(0);
+    }
+}
+
+/// @brief counts rows and stalls on a boundary of one channel, one round.
+template <int COL_NM>
+void prof_tap(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[COL_NM],
+              hls::stream<bool>& e_in_strm,
+              hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[COL_NM],
+              hls::stream<bool>& e_out_strm,
+              hls::stream<ap_uint<32> >& cnt_strm) {
+    ap_uint<32> rows = 0;
+    ap_uint<32> in_stall = 0;
+    ap_uint<32> out_stall = 0;
+    ap_uint<32> cycles = 0;
+    bool last = false;
+PROF_TAP_LOOP:
+    while (!last) {
+#pragma HLS pipeline II = 1
+        if (e_in_strm.empty()) {
+            in_stall++;
+        } else if (e_out_strm.full() || out_strm[0].full()) {
+            out_stall++;
+        } else {
+            last = e_in_strm.read();
+            if (!last) {
+                for (int c = 0; c < COL_NM; ++c) {
+#pragma HLS unroll
+                    out_strm[c].write(in_strm[c].read());
+                }
+                rows++;
+            }
+            e_out_strm.write(last);
+        }
+        cycles++;
+    }
+    cnt_strm.write(rows);
+    cnt_strm.write(in_stall);
+    cnt_strm.write(out_stall);
+    cnt_strm.write(cycles);
+    for (int i = 0; i < 4; ++i) cnt_strm.write(0);
+}
+
+/// @brief writes counters of all taps and hash join stats to the profile buffer.
+template <int TAP_NM>
+void write_profile(hls::stream<ap_uint<32> > cnt_strms[TAP_NM],
+                   hls::stream<ap_uint<32> >& jn_stat_strm,
+                   ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_P) {
+    ap_uint<8 * TPCH_INT_SZ * VEC_LEN> head = 0;
+    head.range(31, 0) = TAP_NM;
+    head.range(63, 32) = jn_stat_strm.read();
+    head.range(95, 64) = jn_stat_strm.read();
+    buf_P[0] = head;
+    for (int t = 0; t < TAP_NM; ++t) {
+        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> line = 0;
+        for (int w = 0; w < 8; ++w) {
+#pragma HLS pipeline II = 1
+            line.range(32 * w + 31, 32 * w) = cnt_strms[t].read();
+        }
+        buf_P[1 + t] = line;
+#ifndef __SYNTHESIS__
+        std::cout << "profile tap " << t << ": rows " << line.range(31, 0) << " / " << line.range(159, 128)
+                  << ", cycles " << line.range(127, 96) << " / " << line.range(255, 224) << std::endl;
+#endif
+    }
+}
+
+} // namespace gqe
+} // namespace database
+} // namespace xf
+
+#endif // GQE_PROFILE
+#endif // GQE_PERF_COUNTER_HPP
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scan_decode.hpp
+ * @brief decoders of dictionary, run-length and frame-of-reference encoded columns, used by the scanners.
+ *
+ * The encoding of each column is given by its nibble in bits 287:256 of the table header, a plain column
+ * keeps its raw data. When any column is encoded, the columns no longer share one stride: the word after the
+ * table header holds the first word of each column id, 32 bits each, and the columns follow it back to back.
+ * An encoded column starts with one descriptor word, which holds the bit width of packed values in bits 7:0,
+ * the base of frame-of-reference in bits 63:32, the number of dictionary entries in bits 95:64 and the number
+ * of runs in bits 127:96.
+ *
+ * A dictionary column is followed by its entries, 16 in a word, and then the packed codes, at most
+ * SCAN_DICT_SZ entries and 8-bit codes.
+ * A frame-of-reference column is followed by the packed offsets from base.
+ * Packed values are 1, 2, 4, 8, 16 or 32 bits wide, and row r lies in word r / (512 / w).
+ * A descriptor out of these bounds makes the scanner read no row.
+ * A run-length column is followed by its runs, 8 in a word, each with the value in the lower 32 bits and
+ * the number of rows in the higher 32 bits.
+ *
+ * This file is part of Vitis Database Library
+ */
+
+#ifndef GQE_SCAN_DECODE_HPP
+#define GQE_SCAN_DECODE_HPP
+
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "gqe_blocks/gqe_types.hpp"
+
+namespace xf {
+namespace database {
+namespace gqe {
+
+/// @brief state of the decoders of all columns in one scan.
+template <int COL_NM>
+struct ScanDecoder {
+    ap_uint<4> enc[COL_NM];
+    int data_off[COL_NM];
+    int lg_w[COL_NM];
+    int base[COL_NM];
+    int nrun[COL_NM];
+    // run-length state carried from one burst to the next
+    int run_idx[COL_NM];
+    int run_val[COL_NM];
+    int run_rem[COL_NM];
+    ap_uint<512> run_word[COL_NM];
+    // dictionary of slot c in entries c * SCAN_DICT_SZ on, copied VEC_LEN times for the lookups of one vector
+    ap_uint<32> dict[VEC_LEN][COL_NM * SCAN_DICT_SZ];
+};
+
+// offset of the first word of column cid, after its header in a plain table
+inline int _col_start(ap_uint<512>* ptr, ap_uint<512> head, int col_naxi, int cid) {
+    if (head.range(287, 256) == 0) return col_naxi * cid + 1;
+    ap_uint<512> offs = ptr[1];
+    return offs.range(32 * cid + 31, 32 * cid).to_int();
+}
+
+// reads the descriptor of column cid into slot c, offset points to the first word of the column,
+// returns false when the descriptor cannot be decoded
+template <int COL_NM>
+bool _init_col_decode(ap_uint<512>* ptr, ap_uint<512> head, int cid, int c, int offset, ScanDecoder<COL_NM>& dec) {
+    ap_uint<4> enc = (cid < 0) ? (ap_uint<4>)COL_PLAIN : (ap_uint<4>)head.range(256 + 4 * cid + 3, 256 + 4 * cid);
+    dec.enc[c] = enc;
+    dec.run_idx[c] = 0;
+    dec.run_rem[c] = 0;
+    if (enc.range(2, 0) == COL_PLAIN) {
+        dec.data_off[c] = offset;
+        return true;
+    }
+    ap_uint<512> desc = ptr[offset];
+    int w = desc.range(7, 0).to_int();
+    int lg = -1;
+    for (int k = 0; k < 6; ++k) {
+        if (w == (1 << k)) lg = k;
+    }
+    dec.lg_w[c] = lg;
+    dec.base[c] = desc.range(63, 32).to_int();
+    dec.nrun[c] = desc.range(127, 96).to_int();
+    int ndict = desc.range(95, 64).to_int();
+    if (enc.range(2, 0) != COL_DICT) ndict = 0;
+    bool ok = enc.range(2, 0) == COL_RLE ||
+              (enc.range(2, 0) == COL_FOR && lg >= 0) ||
+              (enc.range(2, 0) == COL_DICT && lg >= 0 && lg <= 3 && ndict <= SCAN_DICT_SZ);
+#ifndef __SYNTHESIS__
+    std::cout << "col " << cid << " encoding " << enc << ", width " << w << ", base " << dec.base[c] << ", dict "
+              << ndict << ", runs " << dec.nrun[c] << std::endl;
+    if (!ok) std::cout << "ERROR: col " << cid << " has a descriptor the scanner cannot decode" << std::endl;
+#endif
+    if (!ok) return false;
+    dec.data_off[c] = offset + 1 + (ndict + VEC_LEN - 1) / VEC_LEN;
+    ap_uint<512> word;
+LOAD_DICT_LOOP:
+    for (int e = 0; e < ndict; ++e) {
+#pragma HLS pipeline II = 1
+        if (e % VEC_LEN == 0) word = ptr[offset + 1 + e / VEC_LEN];
+        ap_uint<32> v = word.range(32 * (e % VEC_LEN) + 31, 32 * (e % VEC_LEN));
+        for (int k = 0; k < VEC_LEN; ++k) {
+#pragma HLS unroll
+            dec.dict[k][c * SCAN_DICT_SZ + e] = v;
+        }
+    }
+    return true;
+}
+
+// picks the VEC_LEN fields of width W of vector sub in one word, zero-extended to 32 bits
+template <int W>
+ap_uint<512> _unpack_vec(ap_uint<512> word, int sub) {
+#pragma HLS inline
+    ap_uint<16 * W> bits = word >> (sub * 16 * W);
+    ap_uint<512> vec;
+    for (int k = 0; k < VEC_LEN; ++k) {
+#pragma HLS unroll
+        vec.range(32 * k + 31, 32 * k) = bits.range(W * k + W - 1, W * k);
+    }
+    return vec;
+}
+
+template <int COL_NM>
+void _read_packed(ap_uint<512>* ptr,
+                  int c,
+                  int i,
+                  int len,
+                  ScanDecoder<COL_NM>& dec,
+                  hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> >& out_strm) {
+    const int lg_w = dec.lg_w[c];
+    // vectors in one word
+    const int lg_per = 5 - lg_w;
+    const int off = dec.data_off[c];
+    const ap_uint<3> enc = dec.enc[c].range(2, 0);
+    const bool keep_code = dec.enc[c][3];
+    const int base = dec.base[c];
+    ap_uint<512> word;
+PACKED_DECODE_LOOP:
+    for (int j = 0; j < len; ++j) {
+#pragma HLS pipeline II = 1
+        int v = i + j;
+        int sub = v & ((1 << lg_per) - 1);
+        if (j == 0 || sub == 0) word = ptr[off + (v >> lg_per)];
+        ap_uint<512> code;
+        switch (lg_w) {
+            case 0:
+                code = _unpack_vec<1>(word, sub);
+                break;
+            case 1:
+                code = _unpack_vec<2>(word, sub);
+                break;
+            case 2:
+                code = _unpack_vec<4>(word, sub);
+                break;
+            case 3:
+                code = _unpack_vec<8>(word, sub);
+                break;
+            case 4:
+                code = _unpack_vec<16>(word, sub);
+                break;
+            default:
+                code = word;
+        }
+        ap_uint<512> out;
+        for (int k = 0; k < VEC_LEN; ++k) {
+#pragma HLS unroll
+            ap_uint<32> t = code.range(32 * k + 31, 32 * k);
+            if (enc == COL_DICT && !keep_code)
+                t = dec.dict[k][c * SCAN_DICT_SZ + t.range(7, 0).to_int()];
+            else if (enc == COL_FOR)
+                t = t + base;
+            out.range(32 * k + 31, 32 * k) = t;
+        }
+        out_strm.write(out);
+    }
+}
+
+template <int COL_NM>
+void _read_rle(ap_uint<512>* ptr,
+               int c,
+               int len,
+               ScanDecoder<COL_NM>& dec,
+               hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> >& out_strm) {
+    const int off = dec.data_off[c];
+    const int nrun = dec.nrun[c];
+    int idx = dec.run_idx[c];
+    int val = dec.run_val[c];
+    int rem = dec.run_rem[c];
+    ap_uint<512> word = dec.run_word[c];
+    ap_uint<512> vec = 0;
+    int fill = 0;
+    int n = 0;
+RLE_DECODE_LOOP:
+    while (n < len) {
+#pragma HLS pipeline II = 1
+        if (rem == 0) {
+            if (idx < nrun) {
+                if (idx % 8 == 0) word = ptr[off + idx / 8];
+                ap_uint<64> run = word.range(64 * (idx % 8) + 63, 64 * (idx % 8));
+                val = run.range(31, 0).to_int();
+                rem = run.range(63, 32).to_int();
+                idx++;
+            } else {
+                // pad the last vector after all runs
+                val = 0;
+                rem = VEC_LEN;
+            }
+        }
+        int take = (rem < VEC_LEN - fill) ? rem : (VEC_LEN - fill);
+        for (int k = 0; k < VEC_LEN; ++k) {
+#pragma HLS unroll
+            if (k >= fill && k < fill + take) vec.range(32 * k + 31, 32 * k) = val;
+        }
+        fill += take;
+        rem -= take;
+        if (fill == VEC_LEN) {
+            out_strm.write(vec);
+            fill = 0;
+            n++;
+        }
+    }
+    dec.run_idx[c] = idx;
+    dec.run_val[c] = val;
+    dec.run_rem[c] = rem;
+    dec.run_word[c] = word;
+}
+
+/// @brief reads vectors i to i + len - 1 of the column in slot c, decoding it when encoded.
+template <int COL_NM>
+void _read_col_burst(ap_uint<512>* ptr,
+                     int c,
+                     int i,
+                     int len,
+                     ScanDecoder<COL_NM>& dec,
+                     hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> >& out_strm) {
+    ap_uint<3> enc = dec.enc[c].range(2, 0);
+    if (enc == COL_PLAIN) {
+        const int offset = dec.data_off[c];
+        for (int j = 0; j < len; ++j) {
+#pragma HLS pipeline II = 1
+            ap_uint<512> t = ptr[offset + i + j];
+            out_strm.write(t);
+        }
+    } else if (enc == COL_RLE) {
+        _read_rle<COL_NM>(ptr, c, len, dec, out_strm);
+    } else {
+        _read_packed<COL_NM>(ptr, c, i, len, dec, out_strm);
+    }
+}
+
+} // namespace gqe
+} // namespace database
+} // namespace xf
+
+#endif // GQE_SCAN_DECODE_HPP
@@ -26,6 +26,7 @@
 
 #include "xf_database/utils.hpp"
 #include "xf_database/types.hpp"
+#include "gqe_blocks/scan_decode.hpp"
 
 namespace xf {
 namespace database {
@@ -43,7 +44,6 @@ void _read_to_colvec(const int bit_num,
 
     // number of row in each col.
     int nrow = bw.range(31, 0);
-    nrow_strm.write(nrow); // tells splitter
 
     // size of buffer space for 1 col.
     // int col_naxi = (bw.range(63,32) + 63) / 64;
@@ -59,6 +59,10 @@ void _read_to_colvec(const int bit_num,
     // offset of col data
     int col_offset[col_num];
 #pragma HLS array_partition variable = col_offset complete
+    // decoders of encoded cols
+    ScanDecoder<col_num> dec;
+#pragma HLS array_partition variable = dec.dict complete dim = 1
+    bool bad = false;
     for (int i = 0; i < col_num; ++i) {
         int cid = col_id_strm.read();
         if (cid == -1) {
@@ -66,11 +70,15 @@ void _read_to_colvec(const int bit_num,
         } else if (cid == -2) {
             col_offset[i] = -2;
         } else {
-            // +1 to skip col header to data offset
-            col_offset[i] = col_naxi * cid + 1;
+            col_offset[i] = _col_start(ptr, bw, col_naxi, cid);
+            if (!_init_col_decode<col_num>(ptr, bw, cid, i, col_offset[i], dec)) bad = true;
         }
     }
 
+    // nothing is read from a table that cannot be decoded
+    if (bad) nrow = 0;
+    nrow_strm.write(nrow); // tells splitter
+
     // AXI read for each col
     int nread = (nrow + vec_len - 1) / vec_len;
 
@@ -115,12 +123,8 @@ void _read_to_colvec(const int bit_num,
                     }
                 }
             } else {
-                // burst read for col
-                for (int j = 0; j < len; ++j) {
-#pragma HLS pipeline II = 1
-                    ap_uint<512> t = ptr[offset + i + j];
-                    out_strm[c].write(t);
-                }
+                // burst read for col, decoded when it is encoded
+                _read_col_burst<col_num>(ptr, c, i, len, dec, out_strm[c]);
             }
         }
         for (int i = 0; i < vec_len; i++) {
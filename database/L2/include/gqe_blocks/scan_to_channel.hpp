@@ -25,6 +25,7 @@
 
 #include "xf_database/utils.hpp"
 #include "xf_database/types.hpp"
+#include "gqe_blocks/scan_decode.hpp"
 #include <iostream>
 
 namespace xf {
@@ -40,7 +41,6 @@ void _read_to_colvec(ap_uint<8 * size0 * vec_len>* ptr,
 
     // number of row in each col.
     int nrow = bw.range(31, 0);
-    nrow_strm.write(nrow); // tells splitter
 
     // size of buffer space for 1 col.
     // int col_naxi = (bw.range(63,32) + 63) / 64;
@@ -49,6 +49,10 @@ void _read_to_colvec(ap_uint<8 * size0 * vec_len>* ptr,
     // offset of col data
     int col_offset[col_num];
 #pragma HLS array_partition variable = col_offset complete
+    // decoders of encoded cols
+    ScanDecoder<col_num> dec;
+#pragma HLS array_partition variable = dec.dict complete dim = 1
+    bool bad = false;
     std::cout << "+++++++++++ IN SCAN :" << std::endl;
     for (int i = 0; i < col_num; ++i) {
         int cid = col_id_strm.read();
@@ -57,14 +61,18 @@ void _read_to_colvec(ap_uint<8 * size0 * vec_len>* ptr,
         } else if (cid == -2) {
             col_offset[i] = -2;
         } else {
-            // +1 to skip col header to data offset
-            col_offset[i] = col_naxi * cid + 1;
+            col_offset[i] = _col_start(ptr, bw, col_naxi, cid);
+            if (!_init_col_decode<col_num>(ptr, bw, cid, i, col_offset[i], dec)) bad = true;
         }
         std::cout << std::dec << "nrow: " << nrow << " col_offset_" << i << ": " << col_offset[i]
                   << " col_naxi: " << col_naxi << " cid: " << cid << std::endl;
     }
     std::cout << "+++++++++++++++" << std::endl;
 
+    // nothing is read from a table that cannot be decoded
+    if (bad) nrow = 0;
+    nrow_strm.write(nrow); // tells splitter
+
     // AXI read for each col
     int nread = (nrow + vec_len - 1) / vec_len;
 
@@ -109,12 +117,8 @@ void _read_to_colvec(ap_uint<8 * size0 * vec_len>* ptr,
                     }
                 }
             } else {
-                // burst read for col
-                for (int j = 0; j < len; ++j) {
-#pragma HLS pipeline II = 1
-                    ap_uint<512> t = ptr[offset + i + j];
-                    out_strm[c].write(t);
-                }
+                // burst read for col, decoded when it is encoded
+                _read_col_burst<col_num>(ptr, c, i, len, dec, out_strm[c]);
             }
         }
         for (int i = 0; i < vec_len; i++) {
@@ -176,7 +180,7 @@ SPLIT_COL_VEC:
                             std::cout << std::endl;
                             cnt++;
                         }
-                    } else if (ct[5] == 35) {
+                    } else if (col_num > 5 && ct[5] == 35) {
                         std::cout << "scan error data:" << std::endl;
                         for (int c = 0; c < col_num; c++) {
                             std::cout << "col" << c << "= " << ct[c] << " ";
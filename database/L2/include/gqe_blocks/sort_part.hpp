@@ -0,0 +1,342 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GQE_SORT_PART_HPP
+#define GQE_SORT_PART_HPP
+
+#ifndef __SYNTHESIS__
+#include <stdio.h>
+#include <iostream>
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "xf_database/enums.hpp"
+#include "xf_database/insert_sort.hpp"
+
+#include "gqe_blocks/gqe_types.hpp"
+#include "gqe_blocks/scan_to_channel.hpp"
+
+namespace xf {
+namespace database {
+namespace gqe {
+
+// scanned columns: key0, key1, payload and row id
+#define SORT_COL_NM 4
+
+void sort_load_cid(const int sort_cfg, hls::stream<int8_t>& cid_strm) {
+    ap_uint<32> cfg = sort_cfg;
+    cid_strm.write(cfg.range(7, 0));
+    cid_strm.write(cfg.range(15, 8));
+    cid_strm.write(cfg.range(23, 16));
+    // row id
+    cid_strm.write(-2);
+}
+
+// maps a signed column to an unsigned word whose ascending order is the requested order
+inline ap_uint<8 * TPCH_INT_SZ> sort_norm_col(ap_uint<8 * TPCH_INT_SZ> v, bool asc) {
+#pragma HLS inline
+    v[8 * TPCH_INT_SZ - 1] = !v[8 * TPCH_INT_SZ - 1];
+    return asc ? v : (ap_uint<8 * TPCH_INT_SZ>)~v;
+}
+
+void sort_pack_key(const int sort_cfg,
+                   hls::stream<ap_uint<8 * TPCH_INT_SZ> > col_strm[SORT_COL_NM],
+                   hls::stream<bool>& e_col_strm,
+                   hls::stream<ap_uint<64> >& key_strm,
+                   hls::stream<ap_uint<64> >& pld_strm,
+                   hls::stream<bool>& e_strm) {
+    ap_uint<32> cfg = sort_cfg;
+    bool asc0 = cfg[24] == SORT_ASCENDING;
+    bool asc1 = cfg[25] == SORT_ASCENDING;
+    bool e = e_col_strm.read();
+    while (!e) {
+#pragma HLS pipeline II = 1
+        ap_uint<64> key;
+        ap_uint<64> pld;
+        key.range(63, 32) = sort_norm_col(col_strm[0].read(), asc0);
+        key.range(31, 0) = sort_norm_col(col_strm[1].read(), asc1);
+        pld.range(63, 32) = col_strm[2].read();
+        pld.range(31, 0) = col_strm[3].read();
+        key_strm.write(key);
+        pld_strm.write(pld);
+        e_strm.write(false);
+        e = e_col_strm.read();
+    }
+    e_strm.write(true);
+}
+
+void sort_join_record(hls::stream<ap_uint<64> >& key_strm,
+                      hls::stream<ap_uint<64> >& pld_strm,
+                      hls::stream<bool>& e_strm,
+                      hls::stream<ap_uint<128> >& rec_strm,
+                      hls::stream<bool>& e_rec_strm) {
+    bool e = e_strm.read();
+    while (!e) {
+#pragma HLS pipeline II = 1
+        ap_uint<128> rec;
+        rec.range(63, 0) = key_strm.read();
+        rec.range(127, 64) = pld_strm.read();
+        rec_strm.write(rec);
+        e_rec_strm.write(false);
+        e = e_strm.read();
+    }
+    e_rec_strm.write(true);
+}
+
+// reads the records of the idx-th run from start, in bursts, the run is empty when it is beyond nrow
+void sort_read_run(ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* ptr,
+                   const int start,
+                   const int idx,
+                   const int run_len,
+                   const int nrow,
+                   hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> >& vec_strm,
+                   hls::stream<int>& len_strm) {
+    const int run_start = start + idx * run_len;
+    const int left = nrow - run_start;
+    const int len = left <= 0 ? 0 : (left < run_len ? left : run_len);
+    // runs start at a multiple of SORT_REC_PER_VEC
+    const int offset = run_start / SORT_REC_PER_VEC;
+    const int nread = (len + SORT_REC_PER_VEC - 1) / SORT_REC_PER_VEC;
+    len_strm.write(len);
+    for (int i = 0; i < nread; i += BURST_LEN) {
+        const int blen = ((i + BURST_LEN) > nread) ? (nread - i) : BURST_LEN;
+        for (int j = 0; j < blen; ++j) {
+#pragma HLS pipeline II = 1
+            vec_strm.write(ptr[offset + i + j]);
+        }
+    }
+}
+
+void sort_split_record(hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> >& vec_strm,
+                       hls::stream<int>& len_strm,
+                       hls::stream<ap_uint<128> >& rec_strm,
+                       hls::stream<bool>& e_rec_strm) {
+    const int len = len_strm.read();
+    ap_uint<8 * TPCH_INT_SZ* VEC_LEN> vec;
+    for (int i = 0; i < len; ++i) {
+#pragma HLS pipeline II = 1
+        const int k = i % SORT_REC_PER_VEC;
+        if (k == 0) vec = vec_strm.read();
+        rec_strm.write(vec.range(128 * k + 127, 128 * k));
+        e_rec_strm.write(false);
+    }
+    e_rec_strm.write(true);
+}
+
+// merges two ascending runs, taking the left one first on equal keys, either input may be empty
+void sort_merge2(hls::stream<ap_uint<128> >& l_strm,
+                 hls::stream<bool>& e_l_strm,
+                 hls::stream<ap_uint<128> >& r_strm,
+                 hls::stream<bool>& e_r_strm,
+                 hls::stream<ap_uint<128> >& o_strm,
+                 hls::stream<bool>& e_o_strm) {
+    ap_uint<128> l = 0;
+    ap_uint<128> r = 0;
+    bool l_end = e_l_strm.read();
+    if (!l_end) l = l_strm.read();
+    bool r_end = e_r_strm.read();
+    if (!r_end) r = r_strm.read();
+SORT_MERGE_LOOP:
+    while (!l_end || !r_end) {
+#pragma HLS pipeline II = 1
+        bool take_l = !l_end && (r_end || l.range(63, 0) <= r.range(63, 0));
+        if (take_l) {
+            o_strm.write(l);
+            l_end = e_l_strm.read();
+            if (!l_end) l = l_strm.read();
+        } else {
+            o_strm.write(r);
+            r_end = e_r_strm.read();
+            if (!r_end) r = r_strm.read();
+        }
+        e_o_strm.write(false);
+    }
+    e_o_strm.write(true);
+}
+
+// 8-to-1 merge tree
+void sort_merge_tree(hls::stream<ap_uint<128> > rec_strm[SORT_MERGE_WAY],
+                     hls::stream<bool> e_rec_strm[SORT_MERGE_WAY],
+                     hls::stream<ap_uint<128> >& o_strm,
+                     hls::stream<bool>& e_o_strm) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<128> > lv1_strm[4];
+#pragma HLS stream variable = lv1_strm depth = 8
+    hls::stream<bool> e_lv1_strm[4];
+#pragma HLS stream variable = e_lv1_strm depth = 8
+    hls::stream<ap_uint<128> > lv2_strm[2];
+#pragma HLS stream variable = lv2_strm depth = 8
+    hls::stream<bool> e_lv2_strm[2];
+#pragma HLS stream variable = e_lv2_strm depth = 8
+
+    sort_merge2(rec_strm[0], e_rec_strm[0], rec_strm[1], e_rec_strm[1], lv1_strm[0], e_lv1_strm[0]);
+    sort_merge2(rec_strm[2], e_rec_strm[2], rec_strm[3], e_rec_strm[3], lv1_strm[1], e_lv1_strm[1]);
+    sort_merge2(rec_strm[4], e_rec_strm[4], rec_strm[5], e_rec_strm[5], lv1_strm[2], e_lv1_strm[2]);
+    sort_merge2(rec_strm[6], e_rec_strm[6], rec_strm[7], e_rec_strm[7], lv1_strm[3], e_lv1_strm[3]);
+
+    sort_merge2(lv1_strm[0], e_lv1_strm[0], lv1_strm[1], e_lv1_strm[1], lv2_strm[0], e_lv2_strm[0]);
+    sort_merge2(lv1_strm[2], e_lv1_strm[2], lv1_strm[3], e_lv1_strm[3], lv2_strm[1], e_lv2_strm[1]);
+
+    sort_merge2(lv2_strm[0], e_lv2_strm[0], lv2_strm[1], e_lv2_strm[1], o_strm, e_o_strm);
+}
+
+// packs records into vectors and tells the writer the size of each burst, 0 ends
+void sort_count_burst(hls::stream<ap_uint<128> >& rec_strm,
+                      hls::stream<bool>& e_rec_strm,
+                      hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> >& vec_strm,
+                      hls::stream<int>& nm_strm) {
+    ap_uint<8 * TPCH_INT_SZ* VEC_LEN> vec = 0;
+    int k = 0;
+    int nm = 0;
+    bool e = e_rec_strm.read();
+    while (!e) {
+#pragma HLS pipeline II = 1
+        vec.range(128 * k + 127, 128 * k) = rec_strm.read();
+        e = e_rec_strm.read();
+        if (k == SORT_REC_PER_VEC - 1 || e) {
+            vec_strm.write(vec);
+            k = 0;
+            if (nm == BURST_LEN - 1 || e) {
+                nm_strm.write(nm + 1);
+                nm = 0;
+            } else {
+                nm++;
+            }
+        } else {
+            k++;
+        }
+    }
+    nm_strm.write(0);
+}
+
+void sort_burst_write(hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> >& vec_strm,
+                      hls::stream<int>& nm_strm,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* ptr,
+                      const int start) {
+    int offset = start / SORT_REC_PER_VEC;
+    int nm = nm_strm.read();
+    while (nm) {
+    SORT_BURST_WRITE_LOOP:
+        for (int n = 0; n < nm; ++n) {
+#pragma HLS pipeline II = 1
+            ptr[offset + n] = vec_strm.read();
+        }
+        offset += nm;
+        nm = nm_strm.read();
+    }
+}
+
+/// @brief cuts a GQE table into runs of SORT_RUN_LEN records sorted by insert sort.
+void sort_gen_run(const int sort_cfg,
+                  ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in,
+                  ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_out) {
+#pragma HLS dataflow
+    hls::stream<int8_t> cid_strm;
+#pragma HLS stream variable = cid_strm depth = 4
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > col_strm[1][SORT_COL_NM];
+#pragma HLS stream variable = col_strm depth = 32
+    hls::stream<bool> e_col_strm[1];
+#pragma HLS stream variable = e_col_strm depth = 32
+    hls::stream<ap_uint<64> > key_strm;
+#pragma HLS stream variable = key_strm depth = 8
+    hls::stream<ap_uint<64> > pld_strm;
+#pragma HLS stream variable = pld_strm depth = 8
+    hls::stream<bool> e_strm;
+#pragma HLS stream variable = e_strm depth = 8
+    hls::stream<ap_uint<64> > sorted_key_strm;
+#pragma HLS stream variable = sorted_key_strm depth = 8
+    hls::stream<ap_uint<64> > sorted_pld_strm;
+#pragma HLS stream variable = sorted_pld_strm depth = 8
+    hls::stream<bool> e_sorted_strm;
+#pragma HLS stream variable = e_sorted_strm depth = 8
+    hls::stream<ap_uint<128> > rec_strm;
+#pragma HLS stream variable = rec_strm depth = 8
+    hls::stream<bool> e_rec_strm;
+#pragma HLS stream variable = e_rec_strm depth = 8
+    hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> > vec_strm;
+#pragma HLS stream variable = vec_strm depth = 64
+    hls::stream<int> nm_strm;
+#pragma HLS stream variable = nm_strm depth = 4
+
+    sort_load_cid(sort_cfg, cid_strm);
+    scan_to_channel<SORT_COL_NM, 1>(buf_in, cid_strm, col_strm, e_col_strm);
+    sort_pack_key(sort_cfg, col_strm[0], e_col_strm[0], key_strm, pld_strm, e_strm);
+    // keys are normalized, so runs are always ascending
+    xf::database::insertSort<ap_uint<64>, ap_uint<64>, SORT_RUN_LEN>(pld_strm, key_strm, e_strm, sorted_pld_strm,
+                                                                      sorted_key_strm, e_sorted_strm, true);
+    sort_join_record(sorted_key_strm, sorted_pld_strm, e_sorted_strm, rec_strm, e_rec_strm);
+    sort_count_burst(rec_strm, e_rec_strm, vec_strm, nm_strm);
+    sort_burst_write(vec_strm, nm_strm, buf_out, 0);
+}
+
+/// @brief merges SORT_MERGE_WAY runs starting from record start into one run.
+void sort_merge_group(ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in0,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in1,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in2,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in3,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in4,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in5,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in6,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_in7,
+                      ap_uint<8 * TPCH_INT_SZ * VEC_LEN>* buf_out,
+                      const int start,
+                      const int run_len,
+                      const int nrow) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> > in_vec_strm[SORT_MERGE_WAY];
+#pragma HLS stream variable = in_vec_strm depth = 64
+#pragma HLS resource variable = in_vec_strm core = FIFO_BRAM
+    hls::stream<int> len_strm[SORT_MERGE_WAY];
+#pragma HLS stream variable = len_strm depth = 2
+    hls::stream<ap_uint<128> > rec_strm[SORT_MERGE_WAY];
+#pragma HLS stream variable = rec_strm depth = 8
+    hls::stream<bool> e_rec_strm[SORT_MERGE_WAY];
+#pragma HLS stream variable = e_rec_strm depth = 8
+    hls::stream<ap_uint<128> > mrg_strm;
+#pragma HLS stream variable = mrg_strm depth = 8
+    hls::stream<bool> e_mrg_strm;
+#pragma HLS stream variable = e_mrg_strm depth = 8
+    hls::stream<ap_uint<8 * TPCH_INT_SZ * VEC_LEN> > out_vec_strm;
+#pragma HLS stream variable = out_vec_strm depth = 64
+    hls::stream<int> nm_strm;
+#pragma HLS stream variable = nm_strm depth = 4
+
+    // every run has its own AXI port, bound to the same buffer by host
+    sort_read_run(buf_in0, start, 0, run_len, nrow, in_vec_strm[0], len_strm[0]);
+    sort_read_run(buf_in1, start, 1, run_len, nrow, in_vec_strm[1], len_strm[1]);
+    sort_read_run(buf_in2, start, 2, run_len, nrow, in_vec_strm[2], len_strm[2]);
+    sort_read_run(buf_in3, start, 3, run_len, nrow, in_vec_strm[3], len_strm[3]);
+    sort_read_run(buf_in4, start, 4, run_len, nrow, in_vec_strm[4], len_strm[4]);
+    sort_read_run(buf_in5, start, 5, run_len, nrow, in_vec_strm[5], len_strm[5]);
+    sort_read_run(buf_in6, start, 6, run_len, nrow, in_vec_strm[6], len_strm[6]);
+    sort_read_run(buf_in7, start, 7, run_len, nrow, in_vec_strm[7], len_strm[7]);
+
+    for (int i = 0; i < SORT_MERGE_WAY; ++i) {
+#pragma HLS unroll
+        sort_split_record(in_vec_strm[i], len_strm[i], rec_strm[i], e_rec_strm[i]);
+    }
+
+    sort_merge_tree(rec_strm, e_rec_strm, mrg_strm, e_mrg_strm);
+    sort_count_burst(mrg_strm, e_mrg_strm, out_vec_strm, nm_strm);
+    sort_burst_write(out_vec_strm, nm_strm, buf_out, start);
+}
+
+} // namespace gqe
+} // namespace database
+} // namespace xf
+
+#endif
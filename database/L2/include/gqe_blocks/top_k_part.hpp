@@ -0,0 +1,179 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GQE_TOP_K_PART_HPP
+#define GQE_TOP_K_PART_HPP
+
+#ifndef __SYNTHESIS__
+#include <stdio.h>
+#include <iostream>
+#endif
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "xf_database/top_k.hpp"
+
+#include "gqe_blocks/gqe_types.hpp"
+
+namespace xf {
+namespace database {
+namespace gqe {
+
+template <int COL_NM>
+void top_k_pack(ap_uint<32> cfg,
+                hls::stream<ap_uint<8 * TPCH_INT_SZ> > istrm[COL_NM],
+                hls::stream<bool>& e_istrm,
+                hls::stream<ap_uint<8 * TPCH_INT_SZ> > key_strm[2],
+                hls::stream<ap_uint<8 * TPCH_INT_SZ * COL_NM> >& row_strm,
+                hls::stream<bool>& e_strm) {
+    ap_uint<4> key0 = cfg.range(3, 0);
+    ap_uint<4> key1 = cfg.range(7, 4);
+    bool dual_key = cfg[8];
+    bool e = e_istrm.read();
+    while (!e) {
+#pragma HLS pipeline II = 1
+        ap_uint<8 * TPCH_INT_SZ * COL_NM> row;
+        for (int c = 0; c < COL_NM; ++c) {
+#pragma HLS unroll
+            row.range(8 * TPCH_INT_SZ * (c + 1) - 1, 8 * TPCH_INT_SZ * c) = istrm[c].read();
+        }
+        key_strm[0].write(row.range(8 * TPCH_INT_SZ * (key0 + 1) - 1, 8 * TPCH_INT_SZ * key0));
+        key_strm[1].write(dual_key ? (ap_uint<8 * TPCH_INT_SZ>)row.range(8 * TPCH_INT_SZ * (key1 + 1) - 1,
+                                                                         8 * TPCH_INT_SZ * key1)
+                                   : (ap_uint<8 * TPCH_INT_SZ>)0);
+        row_strm.write(row);
+        e_strm.write(false);
+        e = e_istrm.read();
+    }
+    e_strm.write(true);
+}
+
+template <int COL_NM>
+void top_k_unpack(hls::stream<ap_uint<8 * TPCH_INT_SZ> > key_strm[2],
+                  hls::stream<ap_uint<8 * TPCH_INT_SZ * COL_NM> >& row_strm,
+                  hls::stream<bool>& e_strm,
+                  hls::stream<ap_uint<8 * TPCH_INT_SZ> > ostrm[COL_NM],
+                  hls::stream<bool>& e_ostrm) {
+    bool e = e_strm.read();
+    while (!e) {
+#pragma HLS pipeline II = 1
+        key_strm[0].read();
+        key_strm[1].read();
+        ap_uint<8 * TPCH_INT_SZ * COL_NM> row = row_strm.read();
+        for (int c = 0; c < COL_NM; ++c) {
+#pragma HLS unroll
+            ostrm[c].write(row.range(8 * TPCH_INT_SZ * (c + 1) - 1, 8 * TPCH_INT_SZ * c));
+        }
+        e_ostrm.write(false);
+        e = e_strm.read();
+    }
+    e_ostrm.write(true);
+}
+
+template <int COL_NM, int MAX_K>
+void top_k_dataflow(ap_uint<32> cfg0,
+                    ap_uint<32> cfg1,
+                    hls::stream<ap_uint<8 * TPCH_INT_SZ> > istrm[COL_NM],
+                    hls::stream<bool>& e_istrm,
+                    hls::stream<ap_uint<8 * TPCH_INT_SZ> > ostrm[COL_NM],
+                    hls::stream<bool>& e_ostrm) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > key_in[2];
+#pragma HLS stream variable = key_in depth = 8
+    hls::stream<ap_uint<8 * TPCH_INT_SZ * COL_NM> > row_in;
+#pragma HLS stream variable = row_in depth = 8
+    hls::stream<bool> e_in;
+#pragma HLS stream variable = e_in depth = 8
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > key_out[2];
+#pragma HLS stream variable = key_out depth = 8
+    hls::stream<ap_uint<8 * TPCH_INT_SZ * COL_NM> > row_out;
+#pragma HLS stream variable = row_out depth = 8
+    hls::stream<bool> e_out;
+#pragma HLS stream variable = e_out depth = 8
+
+    top_k_pack<COL_NM>(cfg1, istrm, e_istrm, key_in, row_in, e_in);
+    xf::database::topK<8 * TPCH_INT_SZ, 2, 8 * TPCH_INT_SZ * COL_NM, MAX_K>(
+        key_in, row_in, e_in, key_out, row_out, e_out, cfg1.range(10, 9), cfg0.range(15, 0));
+    top_k_unpack<COL_NM>(key_out, row_out, e_out, ostrm, e_ostrm);
+}
+
+template <int COL_NM>
+void top_k_pass(hls::stream<ap_uint<8 * TPCH_INT_SZ> > istrm[COL_NM],
+                hls::stream<bool>& e_istrm,
+                hls::stream<ap_uint<8 * TPCH_INT_SZ> > ostrm[COL_NM],
+                hls::stream<bool>& e_ostrm) {
+    bool e = e_istrm.read();
+    while (!e) {
+#pragma HLS pipeline II = 1
+        for (int c = 0; c < COL_NM; ++c) {
+#pragma HLS unroll
+            ostrm[c].write(istrm[c].read());
+        }
+        e_ostrm.write(false);
+        e = e_istrm.read();
+    }
+    e_ostrm.write(true);
+}
+
+/// @brief stands in for top_k_wrapper in kernels built with GQE_TOP_K_MAX 0, consumes the two config words and
+/// passes every row through.
+template <int COL_NM>
+void top_k_bypass(hls::stream<ap_uint<32> >& topk_cfg_strm,
+                  hls::stream<ap_uint<8 * TPCH_INT_SZ> > istrm[COL_NM],
+                  hls::stream<bool>& e_istrm,
+                  hls::stream<ap_uint<8 * TPCH_INT_SZ> > ostrm[COL_NM],
+                  hls::stream<bool>& e_ostrm) {
+    ap_uint<32> cfg0 = topk_cfg_strm.read();
+    topk_cfg_strm.read();
+#ifndef __SYNTHESIS__
+    if (cfg0[31]) std::cout << "WARNING: top-k requested, but the kernel is built without it" << std::endl;
+#endif
+    top_k_pass<COL_NM>(istrm, e_istrm, ostrm, e_ostrm);
+}
+
+/// @brief optional ORDER BY ... LIMIT stage in front of write-out, rows pass through when it is off.
+///
+/// Two config words are read: word 0 has k in bits 15:0 and the on flag in bit 31, word 1 has the column of the
+/// first key in bits 3:0, of the second key in bits 7:4, the dual-key flag in bit 8 and the SortOrder of the two
+/// keys in bits 9 and 10. Keys are compared as signed integers.
+///
+/// @tparam COL_NM number of columns of a row.
+/// @tparam MAX_K max number of rows kept, k is clipped to it.
+template <int COL_NM, int MAX_K>
+void top_k_wrapper(hls::stream<ap_uint<32> >& topk_cfg_strm,
+                   hls::stream<ap_uint<8 * TPCH_INT_SZ> > istrm[COL_NM],
+                   hls::stream<bool>& e_istrm,
+                   hls::stream<ap_uint<8 * TPCH_INT_SZ> > ostrm[COL_NM],
+                   hls::stream<bool>& e_ostrm) {
+    ap_uint<32> cfg0 = topk_cfg_strm.read();
+    ap_uint<32> cfg1 = topk_cfg_strm.read();
+    if (cfg0[31]) {
+#ifndef __SYNTHESIS__
+        std::cout << "Top-k: k=" << cfg0.range(15, 0) << " key col " << cfg1.range(3, 0);
+        if (cfg1[8]) std::cout << ", " << cfg1.range(7, 4);
+        std::cout << std::endl;
+#endif
+        top_k_dataflow<COL_NM, MAX_K>(cfg0, cfg1, istrm, e_istrm, ostrm, e_ostrm);
+    } else {
+        top_k_pass<COL_NM>(istrm, e_istrm, ostrm, e_ostrm);
+    }
+}
+
+} // namespace gqe
+} // namespace database
+} // namespace xf
+
+#endif
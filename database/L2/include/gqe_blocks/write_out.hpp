@@ -23,6 +23,8 @@
 #include <ap_int.h>
 #include "hls_stream.h"
 
+#include "gqe_blocks/gqe_types.hpp"
+
 namespace xf {
 namespace database {
 namespace gqe {
@@ -166,6 +168,8 @@ void burstWrite(hls::stream<ap_uint<elem_size * vec_len> > i_strm[col_num],
     std::cout << std::dec << "write out row=" << rnm.to_int() << " col_nm=" << wcol << std::endl;
 #endif
     first_r(elem_size - 1, 0) = rnm;
+    // written cols are plain
+    first_r(287, 256) = 0;
     ptr[0] = first_r;
 }
 
@@ -323,7 +327,8 @@ void burstWriteV2(hls::stream<ap_uint<elem_size * vec_len> > i_strm[col_num],
                   ap_uint<elem_size * vec_len>* ptr,
                   hls::stream<ap_uint<8> >& nm_strm,
                   hls::stream<ap_uint<32> >& rnm_strm,
-                  hls::stream<ap_uint<32> >& write_out_cfg_strm) {
+                  hls::stream<ap_uint<32> >& write_out_cfg_strm,
+                  hls::stream<ap_uint<32> >& bf_stat_strm) {
     // record the burst nubmer
     unsigned bnm = 0;
     // read out the block size
@@ -387,6 +392,10 @@ void burstWriteV2(hls::stream<ap_uint<elem_size * vec_len> > i_strm[col_num],
     else
         first_r(31, 0) = rnm;
     first_r(63, 32) = BLOCK_SIZE;
+    // bloom filter: set bits, total bits, probe rows, dropped probe rows
+    for (int i = 0; i < 4; ++i) {
+        first_r(32 * i + BLOOM_STAT_LSB + 31, 32 * i + BLOOM_STAT_LSB) = bf_stat_strm.read();
+    }
     ptr[0] = first_r;
 }
 
@@ -396,7 +405,8 @@ void writeDataflow(hls::stream<ap_uint<elem_size> > bfr_strm[col_num],
                    hls::stream<ap_uint<elem_size> > post_Agg[col_num],
                    hls::stream<bool>& e_post_Agg,
                    ap_uint<elem_size * vec_len>* ptr,
-                   hls::stream<ap_uint<32> >& write_out_cfg_strm) {
+                   hls::stream<ap_uint<32> >& write_out_cfg_strm,
+                   hls::stream<ap_uint<32> >& bf_stat_strm) {
     const int k_fifo_buf = burst_len * 2;
 
     hls::stream<ap_uint<elem_size> > agg_strm[col_num];
@@ -429,7 +439,8 @@ void writeDataflow(hls::stream<ap_uint<elem_size> > bfr_strm[col_num],
            e_post_Agg.size(), m_post_Agg[0].size(), nm_strm.size(), rnm_strm.size());
 #endif
 
-    burstWriteV2<burst_len, elem_size, vec_len, col_num>(m_post_Agg, ptr, nm_strm, rnm_strm, mid_wr_cfg_strm);
+    burstWriteV2<burst_len, elem_size, vec_len, col_num>(m_post_Agg, ptr, nm_strm, rnm_strm, mid_wr_cfg_strm,
+                                                         bf_stat_strm);
 }
 
 template <int elem_size, int vec_len, int col_num>
@@ -480,7 +491,8 @@ template <int burst_len, int elem_size, int vec_len, int col_num>
 void writeTableV2(hls::stream<ap_uint<elem_size> > post_Agg[col_num],
                   hls::stream<bool>& e_post_Agg,
                   ap_uint<elem_size * vec_len>* ptr,
-                  hls::stream<ap_uint<32> >& write_out_cfg_strm) {
+                  hls::stream<ap_uint<32> >& write_out_cfg_strm,
+                  hls::stream<ap_uint<32> >& bf_stat_strm) {
     hls::stream<ap_uint<elem_size> > bfr_strm[col_num];
 #pragma HLS array_partition variable = bfr_strm dim = 0
 #pragma HLS stream variable = bfr_strm depth = 32
@@ -494,7 +506,8 @@ void writeTableV2(hls::stream<ap_uint<elem_size> > post_Agg[col_num],
 
     writePrepare<elem_size, vec_len, col_num>(ptr, bfr_strm, e_bfr_strm, write_out_cfg_strm, cfg_strm);
 
-    writeDataflow<burst_len, elem_size, vec_len, col_num>(bfr_strm, e_bfr_strm, post_Agg, e_post_Agg, ptr, cfg_strm);
+    writeDataflow<burst_len, elem_size, vec_len, col_num>(bfr_strm, e_bfr_strm, post_Agg, e_post_Agg, ptr, cfg_strm,
+                                                          bf_stat_strm);
 }
 
 } // namespace gqe
@@ -58,6 +58,8 @@
  * @param stb_buf6 gqeJoin's temporal buffer for storing small table.
  * @param stb_buf7 gqeJoin's temporal buffer for storing small table.
  *
+ * @param buf_P per-operator counters, only with ``GQE_PROFILE`` defined, see ``gqe_blocks/perf_counter.hpp``.
+ *
  */
 extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[],
                         ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_B[],
@@ -78,7 +80,12 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[],
                         ap_uint<8 * TPCH_INT_SZ * 2> stb_buf4[],
                         ap_uint<8 * TPCH_INT_SZ * 2> stb_buf5[],
                         ap_uint<8 * TPCH_INT_SZ * 2> stb_buf6[],
-                        ap_uint<8 * TPCH_INT_SZ * 2> stb_buf7[]);
+                        ap_uint<8 * TPCH_INT_SZ * 2> stb_buf7[]
+#ifdef GQE_PROFILE
+                        ,
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_P[]
+#endif
+                        );
 
 extern "C" void gqeJoinHJ(bool join_on,
                           bool join_dual_key_on,
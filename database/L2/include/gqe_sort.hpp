@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _XF_DB_GQE_SORT_H_
+#define _XF_DB_GQE_SORT_H_
+
+/**
+ * @file gqe_sort.hpp
+ * @brief interface of GQE sort kernel.
+ */
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "gqe_blocks/gqe_types.hpp"
+
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+// rows in one run sorted on chip, every run but the last one has this length
+#define SORT_RUN_LEN 512
+// runs merged into one by a merge pass
+#define SORT_MERGE_WAY 8
+// sort records of 128 bit in one 512-bit word
+#define SORT_REC_PER_VEC 4
+
+/**
+ * @brief GQE Sort Kernel
+ *
+ * Rows are sorted as 128-bit records, with the normalized key in bits 63:0, the row id in bits 95:64 and
+ * the payload in bits 127:96. A table is sorted by one run generation pass followed by merge passes,
+ * each of them is one call of this kernel and the host swaps the input and output buffers between calls.
+ *
+ * The sort config holds the id of the first key column in bits 7:0, of the second key column in bits 15:8
+ * and of the payload column in bits 23:16, -1 when not used. Bits 24 and 25 are the ``SortOrder`` of the two
+ * key columns. Key columns are compared as signed integers.
+ *
+ * @param mode 0 to cut the table into sorted runs of SORT_RUN_LEN rows, 1 to merge every SORT_MERGE_WAY runs.
+ * @param nrow number of records, used in merge pass.
+ * @param run_len length of input runs, used in merge pass.
+ * @param sort_cfg sort config, used in run generation.
+ *
+ * @param buf_in0 input table in run generation, input records in merge pass.
+ * @param buf_in1 input records in merge pass, same buffer as buf_in0.
+ * @param buf_in2 input records in merge pass, same buffer as buf_in0.
+ * @param buf_in3 input records in merge pass, same buffer as buf_in0.
+ * @param buf_in4 input records in merge pass, same buffer as buf_in0.
+ * @param buf_in5 input records in merge pass, same buffer as buf_in0.
+ * @param buf_in6 input records in merge pass, same buffer as buf_in0.
+ * @param buf_in7 input records in merge pass, same buffer as buf_in0.
+ * @param buf_out output records.
+ *
+ */
+extern "C" void gqeSort(const int mode,
+                        const int nrow,
+                        const int run_len,
+                        const int sort_cfg,
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in0[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in1[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in2[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in3[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in4[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in5[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in6[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in7[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_out[]);
+
+#endif // _XF_DB_GQE_SORT_H_
@@ -26,6 +26,7 @@
 #include "gqe_blocks/filter_part.hpp"
 #include "gqe_blocks/group_aggregate_part.hpp"
 #include "gqe_blocks/aggr_part.hpp"
+#include "gqe_blocks/top_k_part.hpp"
 #include "gqe_blocks/write_info.hpp"
 #include "gqe_blocks/write_out.hpp"
 
@@ -165,6 +166,10 @@ extern "C" void gqeAggr(                                        //
 #pragma HLS stream variable = write_cfg_strm depth = 4
 #pragma HLS resource variable = write_cfg_strm core = FIFO_SRL
 
+    hls::stream<ap_uint<32> > topk_cfg_strm;
+#pragma HLS stream variable = topk_cfg_strm depth = 2
+#pragma HLS resource variable = topk_cfg_strm core = FIFO_SRL
+
     hls::stream<ap_uint<8 * TPCH_INT_SZ> > scan_strms[n_channel][n_column];
 #pragma HLS stream variable = scan_strms depth = 8
 #pragma HLS array_partition variable = scan_strms complete
@@ -183,7 +188,8 @@ extern "C" void gqeAggr(                                        //
 
     load_config<n_channel, n_column>(buf_cfg, cid_strm, alu0_cfg_strm, alu1_cfg_strm, filter_cfg_strm,
                                      shuffle1_cfg_strm, shuffle2_cfg_strm, shuffle3_cfg_strm, shuffle4_cfg_strm,
-                                     merge_column_cfg_strm, group_aggr_cfg_strm, direct_aggr_cfg_strm, write_cfg_strm);
+                                     merge_column_cfg_strm, group_aggr_cfg_strm, direct_aggr_cfg_strm, write_cfg_strm,
+                                     topk_cfg_strm);
 
 #ifndef __SYNTHESIS__
     printf("******************************\n");
@@ -394,6 +400,27 @@ extern "C" void gqeAggr(                                        //
     }
 #endif
 
+//------------------------top k------------------------------
+
+#ifndef __SYNTHESIS__
+    printf("******************************\n");
+    printf("          Top k\n");
+    printf("******************************\n");
+#endif
+
+    hls::stream<ap_uint<32> > topk_strm[2 * n_column];
+#pragma HLS stream variable = topk_strm depth = 8
+#pragma HLS resource variable = topk_strm core = FIFO_SRL
+    hls::stream<bool> e_topk_strm;
+#pragma HLS stream variable = e_topk_strm depth = 8
+
+#if GQE_TOP_K_MAX > 0
+    top_k_wrapper<2 * n_column, GQE_TOP_K_MAX>(topk_cfg_strm, direct_aggr_strm, e_direct_aggr_strm, topk_strm,
+                                               e_topk_strm);
+#else
+    top_k_bypass<2 * n_column>(topk_cfg_strm, direct_aggr_strm, e_direct_aggr_strm, topk_strm, e_topk_strm);
+#endif
+
 //------------------------write out--------------------------
 
 #ifndef __SYNTHESIS__
@@ -402,8 +429,7 @@ extern "C" void gqeAggr(                                        //
     printf("******************************\n");
 #endif
 
-    writeTable<BURST_LEN, 8 * TPCH_INT_SZ, VEC_LEN, 2 * n_column>(direct_aggr_strm, e_direct_aggr_strm, buf_out,
-                                                                  write_cfg_strm);
+    writeTable<BURST_LEN, 8 * TPCH_INT_SZ, VEC_LEN, 2 * n_column>(topk_strm, e_topk_strm, buf_out, write_cfg_strm);
 
 #ifndef __SYNTHESIS__
 
@@ -23,9 +23,12 @@
 #include "gqe_blocks/load_config.hpp"
 #include "gqe_blocks/scan_to_channel.hpp"
 #include "gqe_blocks/filter_part.hpp"
+#include "gqe_blocks/bloom_filter_part.hpp"
 #include "gqe_blocks/hash_join_part.hpp"
 #include "gqe_blocks/aggr_part.hpp"
+#include "gqe_blocks/top_k_part.hpp"
 #include "gqe_blocks/write_out.hpp"
+#include "gqe_blocks/perf_counter.hpp"
 
 #include "xf_utils_hw/stream_shuffle.hpp"
 
@@ -36,25 +39,101 @@ namespace xf {
 namespace database {
 namespace gqe {
 
+// write the lower 32 bits of eval result to out_strm and the upper 32 bits to out_hi_strm
+template <typename T>
+static void eval_split(hls::stream<T>& in_strm,
+                       hls::stream<bool>& e_in_strm,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_strm,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_hi_strm,
+                       hls::stream<bool>& e_out_strm) {
+    bool e = e_in_strm.read();
+    while (!e) {
+#pragma HLS pipeline II = 1
+        ap_uint<2 * 8 * TPCH_INT_SZ> v = in_strm.read();
+        out_strm.write(v.range(8 * TPCH_INT_SZ - 1, 0));
+        out_hi_strm.write(v.range(2 * 8 * TPCH_INT_SZ - 1, 8 * TPCH_INT_SZ));
+        e_out_strm.write(false);
+        e = e_in_strm.read();
+    }
+    e_out_strm.write(true);
+}
+// 32-bit unsigned eval, the upper word is 0
+static void eval_plain(ap_uint<289> alu_cfg,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key0_strm,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key1_strm,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key2_strm,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key3_strm,
+                       hls::stream<bool>& e_keys_strm,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_strm,
+                       hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_hi_strm,
+                       hls::stream<bool>& e_out_strm) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > res_strm;
+#pragma HLS stream variable = res_strm depth = 4
+    hls::stream<bool> e_res_strm;
+#pragma HLS stream variable = e_res_strm depth = 4
+    xf::database::dynamicEval<ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>,
+                              ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>,
+                              ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ> >(
+        alu_cfg, key0_strm, key1_strm, key2_strm, key3_strm, e_keys_strm, res_strm, e_res_strm);
+    eval_split(res_strm, e_res_strm, out_strm, out_hi_strm, e_out_strm);
+}
+#if GQE_DECIMAL
+// signed decimal eval into 64 bits, rescaled by dec_cfg
+static void eval_decimal(ap_uint<289> alu_cfg,
+                         ap_uint<32> dec_cfg,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key0_strm,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key1_strm,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key2_strm,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key3_strm,
+                         hls::stream<bool>& e_keys_strm,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_strm,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_hi_strm,
+                         hls::stream<bool>& e_out_strm) {
+#pragma HLS dataflow
+    hls::stream<ap_int<2 * 8 * TPCH_INT_SZ> > res_strm;
+#pragma HLS stream variable = res_strm depth = 4
+    hls::stream<bool> e_res_strm;
+#pragma HLS stream variable = e_res_strm depth = 4
+    xf::database::dynamicEval<ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>,
+                              ap_uint<8 * TPCH_INT_SZ>, ap_int<2 * 8 * TPCH_INT_SZ> >(
+        alu_cfg, dec_cfg, key0_strm, key1_strm, key2_strm, key3_strm, e_keys_strm, res_strm, e_res_strm);
+    eval_split(res_strm, e_res_strm, out_strm, out_hi_strm, e_out_strm);
+}
+#endif
 static void eval_wrapper(hls::stream<ap_uint<289> >& alu_cfg_strm,
+                         hls::stream<ap_uint<32> >& dec_cfg_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key0_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key1_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key2_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& key3_strm,
                          hls::stream<bool>& e_keys_strm,
                          hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_strm,
+                         hls::stream<ap_uint<8 * TPCH_INT_SZ> >& out_hi_strm,
                          hls::stream<bool>& e_out_strm) {
     ap_uint<289> alu_cfg = alu_cfg_strm.read();
-    xf::database::dynamicEval<ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>,
-                              ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>,
-                              ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ>, ap_uint<8 * TPCH_INT_SZ> >(
-        alu_cfg, key0_strm, key1_strm, key2_strm, key3_strm, e_keys_strm, out_strm, e_out_strm);
+    ap_uint<32> dec_cfg = dec_cfg_strm.read();
+#if GQE_DECIMAL
+    if (dec_cfg[9]) {
+        eval_decimal(alu_cfg, dec_cfg, key0_strm, key1_strm, key2_strm, key3_strm, e_keys_strm, out_strm,
+                     out_hi_strm, e_out_strm);
+    } else {
+        eval_plain(alu_cfg, key0_strm, key1_strm, key2_strm, key3_strm, e_keys_strm, out_strm, out_hi_strm,
+                   e_out_strm);
+    }
+#else
+#ifndef __SYNTHESIS__
+    if (dec_cfg[9]) std::cout << "WARNING: decimal eval requested, but the kernel is built without it" << std::endl;
+#endif
+    eval_plain(alu_cfg, key0_strm, key1_strm, key2_strm, key3_strm, e_keys_strm, out_strm, out_hi_strm, e_out_strm);
+#endif
 }
 static void dynamic_eval_stage(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[4],
                                hls::stream<bool>& e_in_strm,
-                               hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[5],
+                               hls::stream<ap_uint<8 * TPCH_INT_SZ> > out_strm[6],
                                hls::stream<bool>& e_out_strm,
-                               hls::stream<ap_uint<289> >& alu_cfg_strm) {
+                               hls::stream<ap_uint<289> >& alu_cfg_strm,
+                               hls::stream<ap_uint<32> >& dec_cfg_strm) {
 #pragma HLS dataflow
 
     hls::stream<bool> e_dummy_strm[1];
@@ -72,10 +151,10 @@ static void dynamic_eval_stage(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[4]
     // discard extra flags
     e_sink<1>(e_dummy_strm);
 
-    // evaluate into 5th col stream
-    eval_wrapper(alu_cfg_strm,                                                   //
+    // evaluate into 5th col stream, and its upper word into 6th
+    eval_wrapper(alu_cfg_strm, dec_cfg_strm,                                     //
                  mid_strm[0], mid_strm[1], mid_strm[2], mid_strm[3], e_mid_strm, //
-                 out_strm[4], e_out_strm);
+                 out_strm[4], out_strm[5], e_out_strm);
 
 #ifndef __SYNTHESIS__
     for (int c = 0; c < 4; ++c) {
@@ -105,11 +184,12 @@ static void merge(hls::stream<ap_uint<8 * TPCH_INT_SZ> > in_strm[4],
     e_out_strm.write(true);
 }
 
-void combine(hls::stream<ap_uint<32> > in_strm0[5],
+// 4 eval inputs, 4 bypassed columns, eval result and its upper word
+void combine(hls::stream<ap_uint<32> > in_strm0[6],
              hls::stream<bool>& e_in_strm0,
              hls::stream<ap_uint<32> > in_strm1[4],
              hls::stream<bool>& e_in_strm1,
-             hls::stream<ap_uint<32> > out_strm[9],
+             hls::stream<ap_uint<32> > out_strm[10],
              hls::stream<bool>& e_out_strm) {
     bool e = e_in_strm0.read();
     e_in_strm1.read();
@@ -121,6 +201,7 @@ void combine(hls::stream<ap_uint<32> > in_strm0[5],
             out_strm[i + 4].write(in_strm1[i].read());
         }
         out_strm[8].write(in_strm0[4].read());
+        out_strm[9].write(in_strm0[5].read());
 
         e = e_in_strm0.read();
         e_in_strm1.read();
@@ -233,7 +314,12 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
                         ap_uint<8 * TPCH_INT_SZ * 2> stb_buf4[TEST_BUF_DEPTH],
                         ap_uint<8 * TPCH_INT_SZ * 2> stb_buf5[TEST_BUF_DEPTH],
                         ap_uint<8 * TPCH_INT_SZ * 2> stb_buf6[TEST_BUF_DEPTH],
-                        ap_uint<8 * TPCH_INT_SZ * 2> stb_buf7[TEST_BUF_DEPTH]) {
+                        ap_uint<8 * TPCH_INT_SZ * 2> stb_buf7[TEST_BUF_DEPTH]
+#ifdef GQE_PROFILE
+                        ,
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_P[TEST_BUF_DEPTH]
+#endif
+                        ) {
 #pragma HLS INTERFACE m_axi offset = slave latency = 64 num_write_outstanding = 1 num_read_outstanding = \
     16 max_write_burst_length = 2 max_read_burst_length = 64 bundle = gmem0_0 port = buf_A
 #pragma HLS INTERFACE s_axilite port = buf_A bundle = control
@@ -314,13 +400,24 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     16 max_write_burst_length = 8 max_read_burst_length = 8 bundle = gmem2_7 port = stb_buf7
 #pragma HLS INTERFACE s_axilite port = stb_buf7 bundle = control
 
+#ifdef GQE_PROFILE
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 num_write_outstanding = 1 num_read_outstanding = \
+    1 max_write_burst_length = 2 max_read_burst_length = 2 bundle = gmem0_4 port = buf_P
+#pragma HLS INTERFACE s_axilite port = buf_P bundle = control
+#endif
+
 #pragma HLS INTERFACE s_axilite port = return bundle = control
 
     // clang-format on
     using namespace xf::database::gqe;
 
 #pragma HLS dataflow
-    const int jn_on_nm = 8;
+#ifdef GQE_PROFILE
+    // 3 more for the taps before hash join
+    const int jn_on_nm = 12;
+#else
+    const int jn_on_nm = 9;
+#endif
     const int agg_on_nm = 3;
 
     hls::stream<int8_t> cid_A_strm;
@@ -347,12 +444,24 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
 #pragma HLS stream variable = alu2_cfg_strm depth = 32
 #pragma HLS resource variable = alu2_cfg_strm core = FIFO_LUTRAM
 
+    hls::stream<ap_uint<32> > dec1_cfg_strm;
+#pragma HLS stream variable = dec1_cfg_strm depth = 32
+
+    hls::stream<ap_uint<32> > dec2_cfg_strm;
+#pragma HLS stream variable = dec2_cfg_strm depth = 32
+
     hls::stream<bool> agg_on_strm;
 #pragma HLS stream variable = agg_on_strm depth = 32
 
+    hls::stream<ap_uint<32> > agg_pair_strm;
+#pragma HLS stream variable = agg_pair_strm depth = 32
+
     hls::stream<ap_uint<32> > write_cfg_strm;
 #pragma HLS stream variable = write_cfg_strm depth = 32
 
+    hls::stream<ap_uint<32> > topk_cfg_strm;
+#pragma HLS stream variable = topk_cfg_strm depth = 2
+
     hls::stream<ap_uint<8 * 8> > shuffle1_cfg[4];
 #pragma HLS stream variable = shuffle1_cfg depth = 32
 #pragma HLS array_partition variable = shuffle1_cfg dim = 0
@@ -381,15 +490,33 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
 #pragma HLS stream variable = join_flag_strm depth = 32
 #pragma HLS resource variable = join_flag_strm core = FIFO_LUTRAM
 
+    hls::stream<ap_uint<2> > bloom_cfg_strm;
+#pragma HLS stream variable = bloom_cfg_strm depth = 2
+
+    hls::stream<ap_uint<32> > bloom_stat_strm;
+#pragma HLS stream variable = bloom_stat_strm depth = 4
+
+    hls::stream<ap_uint<32> > ht_cfg_strm;
+#pragma HLS stream variable = ht_cfg_strm depth = 2
+
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<32> > prof_cnt_strms[PROF_TAP_NM];
+#pragma HLS stream variable = prof_cnt_strms depth = 8
+#pragma HLS array_partition variable = prof_cnt_strms dim = 0
+    hls::stream<ap_uint<32> > jn_stat_strm;
+#pragma HLS stream variable = jn_stat_strm depth = 2
+#endif
+
 #ifndef __SYNTHESIS__
     printf("************************************************************\n");
     printf("             General Query Egnine Kernel\n");
     printf("************************************************************\n");
 #endif
 
-    load_config<jn_on_nm>(buf_D, join_on_strm, join_dual_key_on_strm, agg_on_strm, join_flag_strm, cid_A_strm,
-                          cid_B_strm, write_cfg_strm, alu1_cfg_strm, alu2_cfg_strm, fcfg, shuffle1_cfg, shuffle2_cfg,
-                          shuffle3_cfg, shuffle4_cfg);
+    load_config<jn_on_nm>(buf_D, join_on_strm, join_dual_key_on_strm, agg_on_strm, agg_pair_strm, join_flag_strm,
+                          bloom_cfg_strm, cid_A_strm, cid_B_strm, write_cfg_strm, alu1_cfg_strm, alu2_cfg_strm,
+                          dec1_cfg_strm, dec2_cfg_strm, fcfg, shuffle1_cfg, shuffle2_cfg, shuffle3_cfg, shuffle4_cfg,
+                          topk_cfg_strm, ht_cfg_strm);
     /*
         int size512=buf_B[0].range(63,32);
         int rowNum=buf_B[0].range(31,0);
@@ -410,9 +537,23 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
         std::cout<<std::endl;
     */
 
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<32> > scan_tap[nch][8];
+#pragma HLS stream variable = scan_tap depth = 32
+#pragma HLS array_partition variable = scan_tap dim = 1
+#pragma HLS resource variable = scan_tap core = FIFO_LUTRAM
+    hls::stream<bool> e_scan_tap[nch];
+#pragma HLS stream variable = e_scan_tap depth = 32
+
+    scan_wrapper<8, nch>(buf_A, buf_B, cid_A_strm, cid_B_strm, //
+                         join_on_strm[0],                      //
+                         scan_tap, e_scan_tap);
+    prof_tap<8, nch>(join_on_strm[9], scan_tap, e_scan_tap, ch_strms, e_ch_strms, prof_cnt_strms[PROF_SCAN]);
+#else
     scan_wrapper<8, nch>(buf_A, buf_B, cid_A_strm, cid_B_strm, //
                          join_on_strm[0],                      //
                          ch_strms, e_ch_strms);
+#endif
 
 #ifndef __SYNTHESIS__
     {
@@ -447,9 +588,23 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     hls::stream<bool> e_flt_strms[4];
 #pragma HLS stream variable = e_flt_strms depth = 32
 
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > filter_tap[nch][8];
+#pragma HLS stream variable = filter_tap depth = 32
+#pragma HLS array_partition variable = filter_tap dim = 1
+#pragma HLS resource variable = filter_tap core = FIFO_LUTRAM
+    hls::stream<bool> e_filter_tap[nch];
+#pragma HLS stream variable = e_filter_tap depth = 32
+
+    filter_wrapper<8, 8, 4, scan_num>(fcfg, join_on_strm[1], //
+                                      ch_strms, e_ch_strms,  //
+                                      filter_tap, e_filter_tap);
+    prof_tap<8, nch>(join_on_strm[10], filter_tap, e_filter_tap, flt_strms, e_flt_strms, prof_cnt_strms[PROF_FILTER]);
+#else
     filter_wrapper<8, 8, 4, scan_num>(fcfg, join_on_strm[1], //
                                       ch_strms, e_ch_strms,  //
                                       flt_strms, e_flt_strms);
+#endif
 
 #ifndef __SYNTHESIS__
     {
@@ -494,6 +649,30 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
 #pragma HLS stream variable = e_hj_in depth = 32
 
     shuffle1_wrapper(join_on_strm[6], shuffle1_cfg, flt_strms, e_flt_strms, hj_in, e_hj_in);
+
+    // bloom filter built from table A keys drops table B rows before hash-join
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > bf_out[4][8];
+#pragma HLS stream variable = bf_out depth = 32
+#pragma HLS array_partition variable = bf_out dim = 1
+#pragma HLS resource variable = bf_out core = FIFO_LUTRAM
+    hls::stream<bool> e_bf_out[4];
+#pragma HLS stream variable = e_bf_out depth = 32
+
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > bloom_tap[nch][8];
+#pragma HLS stream variable = bloom_tap depth = 32
+#pragma HLS array_partition variable = bloom_tap dim = 1
+#pragma HLS resource variable = bloom_tap core = FIFO_LUTRAM
+    hls::stream<bool> e_bloom_tap[nch];
+#pragma HLS stream variable = e_bloom_tap depth = 32
+
+    bloom_filter_wrapper<8, nch, BLOOM_FILTER_W>(join_on_strm[8], bloom_cfg_strm, hj_in, e_hj_in, bloom_tap,
+                                                 e_bloom_tap, bloom_stat_strm);
+    prof_tap<8, nch>(join_on_strm[11], bloom_tap, e_bloom_tap, bf_out, e_bf_out, prof_cnt_strms[PROF_BLOOM]);
+#else
+    bloom_filter_wrapper<8, nch, BLOOM_FILTER_W>(join_on_strm[8], bloom_cfg_strm, hj_in, e_hj_in, bf_out, e_bf_out,
+                                                 bloom_stat_strm);
+#endif
     // printf("shuffle done\n");
     // add demux 1-way data after filter to 2-way data
     // one for hash join, another one bypass
@@ -511,7 +690,7 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     hls::stream<bool> e_flt_dm_strms_1[4];
 #pragma HLS stream variable = e_flt_dm_strms_1 depth = 32
 
-    demux_wrapper<8, nch, scan_num>(join_on_strm[2], hj_in, e_hj_in, flt_dm_strms_0, flt_dm_strms_1, e_flt_dm_strms_0,
+    demux_wrapper<8, nch, scan_num>(join_on_strm[2], bf_out, e_bf_out, flt_dm_strms_0, flt_dm_strms_1, e_flt_dm_strms_0,
                                     e_flt_dm_strms_1);
     // printf("Demux done\n");
 
@@ -523,7 +702,11 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
 #pragma HLS stream variable = e_jn_strm depth = 32 //
 
     hash_join_wrapper<8, nch, 14, scan_num>(
-        join_flag_strm, join_on_strm[3], join_dual_key_on_strm, flt_dm_strms_1, e_flt_dm_strms_1, jn_strm, e_jn_strm, //
+        join_flag_strm, ht_cfg_strm, join_on_strm[3], join_dual_key_on_strm, flt_dm_strms_1, e_flt_dm_strms_1, jn_strm,
+        e_jn_strm, //
+#ifdef GQE_PROFILE
+        jn_stat_strm,
+#endif
         htb_buf0, htb_buf1, htb_buf2, htb_buf3, htb_buf4, htb_buf5, htb_buf6, htb_buf7, stb_buf0, stb_buf1, stb_buf2,
         stb_buf3, stb_buf4, stb_buf5, stb_buf6, stb_buf7);
 
@@ -557,8 +740,21 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     hls::stream<bool> e_jn_mx_strm;
 #pragma HLS stream variable = e_jn_mx_strm depth = 32
 
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<32> > join_tap[8];
+#pragma HLS stream variable = join_tap depth = 32
+#pragma HLS array_partition variable = join_tap complete
+#pragma HLS resource variable = join_tap core = FIFO_LUTRAM
+    hls::stream<bool> e_join_tap;
+#pragma HLS stream variable = e_join_tap depth = 32
+
+    stream1D_mux2To1<8 * TPCH_INT_SZ, 8>(join_on_strm[5], jn_bp_strm, hj_out, e_jn_bp_strm, e_hj_out, join_tap,
+                                         e_join_tap);
+    prof_tap<8>(join_tap, e_join_tap, jn_mx_strm, e_jn_mx_strm, prof_cnt_strms[PROF_JOIN]);
+#else
     stream1D_mux2To1<8 * TPCH_INT_SZ, 8>(join_on_strm[5], jn_bp_strm, hj_out, e_jn_bp_strm, e_hj_out, jn_mx_strm,
                                          e_jn_mx_strm);
+#endif
 
     hls::stream<ap_uint<32> > eval1_in[4];
 #pragma HLS stream variable = eval1_in depth = 32
@@ -604,16 +800,16 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
 
     // Flaten Eval and Aggregate
     // Evalaution
-    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval1_strm[5];
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval1_strm[6];
 #pragma HLS array_partition variable = eval1_strm dim = 0
 #pragma HLS stream variable = eval1_strm depth = 32
 #pragma HLS resource variable = eval1_strm core = FIFO_LUTRAM
 
     hls::stream<bool> e_eval1_strm;
 #pragma HLS stream variable = e_eval1_strm depth = 32
-    dynamic_eval_stage(eval1_in, e_eval1_in, eval1_strm, e_eval1_strm, alu1_cfg_strm);
+    dynamic_eval_stage(eval1_in, e_eval1_in, eval1_strm, e_eval1_strm, alu1_cfg_strm, dec1_cfg_strm);
 
-    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval1[9];
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval1[10];
 #pragma HLS array_partition variable = eval1 dim = 0
 #pragma HLS stream variable = eval1 depth = 32
 #pragma HLS resource variable = eval1 core = FIFO_LUTRAM
@@ -628,7 +824,7 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     hls::stream<bool> e_eval1_res;
 #pragma HLS stream variable = e_eval1_res depth = 32
 
-    xf::common::utils_hw::streamShuffle<9, 8>(shuffle3_cfg, eval1, e_eval1, eval1_res, e_eval1_res);
+    xf::common::utils_hw::streamShuffle<10, 8>(shuffle3_cfg, eval1, e_eval1, eval1_res, e_eval1_res);
     hls::stream<ap_uint<32> > eval2_in[4];
 #pragma HLS stream variable = eval2_in depth = 32
 #pragma HLS array_partition variable = eval2_in complete
@@ -644,7 +840,7 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
 #pragma HLS stream variable = e_eval2_bp depth = 32
 
     split(eval1_res, e_eval1_res, eval2_in, e_eval2_in, eval2_bp, e_eval2_bp);
-    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval2_strm[5];
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval2_strm[6];
 #pragma HLS array_partition variable = eval2_strm dim = 0
 #pragma HLS stream variable = eval2_strm depth = 32
 #pragma HLS resource variable = eval2_strm core = FIFO_LUTRAM
@@ -652,8 +848,8 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     hls::stream<bool> e_eval2_strm;
 #pragma HLS stream variable = e_eval2_strm depth = 32
 
-    dynamic_eval_stage(eval2_in, e_eval2_in, eval2_strm, e_eval2_strm, alu2_cfg_strm);
-    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval2[9];
+    dynamic_eval_stage(eval2_in, e_eval2_in, eval2_strm, e_eval2_strm, alu2_cfg_strm, dec2_cfg_strm);
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval2[10];
 #pragma HLS array_partition variable = eval2 dim = 0
 #pragma HLS stream variable = eval2 depth = 32
 #pragma HLS resource variable = eval2 core = FIFO_LUTRAM
@@ -668,7 +864,19 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     hls::stream<bool> e_eval2_res;
 #pragma HLS stream variable = e_eval2_res depth = 32
 
-    xf::common::utils_hw::streamShuffle<9, 8>(shuffle4_cfg, eval2, e_eval2, eval2_res, e_eval2_res);
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<8 * TPCH_INT_SZ> > eval_tap[8];
+#pragma HLS array_partition variable = eval_tap dim = 0
+#pragma HLS stream variable = eval_tap depth = 32
+#pragma HLS resource variable = eval_tap core = FIFO_LUTRAM
+    hls::stream<bool> e_eval_tap;
+#pragma HLS stream variable = e_eval_tap depth = 32
+
+    xf::common::utils_hw::streamShuffle<10, 8>(shuffle4_cfg, eval2, e_eval2, eval_tap, e_eval_tap);
+    prof_tap<8>(eval_tap, e_eval_tap, eval2_res, e_eval2_res, prof_cnt_strms[PROF_EVAL]);
+#else
+    xf::common::utils_hw::streamShuffle<10, 8>(shuffle4_cfg, eval2, e_eval2, eval2_res, e_eval2_res);
+#endif
     // Demux the output of eval to 2 flow, one for agg and another by pass.
 
     // Aggregate
@@ -680,7 +888,18 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
 
     // one flow through aggr
     // Agg_Wrapper(eval_strm, e_eval_strm, agg_strm, e_agg_strm, agg_on_strm);
-    agg_wrapper<8>(agg_on_strm, eval2_res, e_eval2_res, agg_strm, e_agg_strm);
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<32> > aggr_tap[8];
+#pragma HLS stream variable = aggr_tap depth = 32
+#pragma HLS resource variable = aggr_tap core = FIFO_LUTRAM
+    hls::stream<bool> e_aggr_tap;
+#pragma HLS stream variable = e_aggr_tap depth = 32
+
+    agg_wrapper<8, GQE_DECIMAL>(agg_on_strm, agg_pair_strm, eval2_res, e_eval2_res, aggr_tap, e_aggr_tap);
+    prof_tap<8>(aggr_tap, e_aggr_tap, agg_strm, e_agg_strm, prof_cnt_strms[PROF_AGGR]);
+#else
+    agg_wrapper<8, GQE_DECIMAL>(agg_on_strm, agg_pair_strm, eval2_res, e_eval2_res, agg_strm, e_agg_strm);
+#endif
 
 #ifndef __SYNTHESIS__
     {
@@ -704,16 +923,48 @@ extern "C" void gqeJoin(ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_A[TEST_BUF_DEPTH]
     }
 #endif
 
+    // optional ORDER BY ... LIMIT
+    hls::stream<ap_uint<32> > topk_strm[8];
+#pragma HLS stream variable = topk_strm depth = 32
+#pragma HLS resource variable = topk_strm core = FIFO_LUTRAM
+    hls::stream<bool> e_topk_strm;
+#pragma HLS stream variable = e_topk_strm depth = 32
+
+#ifdef GQE_PROFILE
+    hls::stream<ap_uint<32> > topk_tap[8];
+#pragma HLS stream variable = topk_tap depth = 32
+#pragma HLS resource variable = topk_tap core = FIFO_LUTRAM
+    hls::stream<bool> e_topk_tap;
+#pragma HLS stream variable = e_topk_tap depth = 32
+
+#if GQE_TOP_K_MAX > 0
+    top_k_wrapper<8, GQE_TOP_K_MAX>(topk_cfg_strm, agg_strm, e_agg_strm, topk_tap, e_topk_tap);
+#else
+    top_k_bypass<8>(topk_cfg_strm, agg_strm, e_agg_strm, topk_tap, e_topk_tap);
+#endif
+    prof_tap<8>(topk_tap, e_topk_tap, topk_strm, e_topk_strm, prof_cnt_strms[PROF_TOPK]);
+#else
+#if GQE_TOP_K_MAX > 0
+    top_k_wrapper<8, GQE_TOP_K_MAX>(topk_cfg_strm, agg_strm, e_agg_strm, topk_strm, e_topk_strm);
+#else
+    top_k_bypass<8>(topk_cfg_strm, agg_strm, e_agg_strm, topk_strm, e_topk_strm);
+#endif
+#endif
+
     writeTableV2<BURST_LEN, 8 * TPCH_INT_SZ, VEC_LEN, 8>(
 
-        agg_strm, e_agg_strm, //
-        buf_C, write_cfg_strm);
+        topk_strm, e_topk_strm, //
+        buf_C, write_cfg_strm, bloom_stat_strm);
+
+#ifdef GQE_PROFILE
+    write_profile<PROF_TAP_NM>(prof_cnt_strms, jn_stat_strm, buf_P);
+#endif
 
 #ifndef __SYNTHESIS__
     for (int c = 0; c < 4; ++c) {
-        size_t s = agg_strm[c].size();
+        size_t s = topk_strm[c].size();
         if (s != 0) {
-            printf("##### agg_strm[%d] has %ld data left after write-out.\n", c, s);
+            printf("##### topk_strm[%d] has %ld data left after write-out.\n", c, s);
         }
     }
 #endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SYNTHESIS__
+#include <stdio.h>
+#include <iostream>
+#endif
+
+#include "gqe_sort.hpp"
+#include "gqe_blocks/sort_part.hpp"
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+extern "C" void gqeSort(const int mode,
+                        const int nrow,
+                        const int run_len,
+                        const int sort_cfg,
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in0[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in1[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in2[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in3[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in4[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in5[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in6[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_in7[],
+                        ap_uint<8 * TPCH_INT_SZ * VEC_LEN> buf_out[]) {
+// clang-format off
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_0 port = buf_in0
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_1 port = buf_in1
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_2 port = buf_in2
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_3 port = buf_in3
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_4 port = buf_in4
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_5 port = buf_in5
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_6 port = buf_in6
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_7 port = buf_in7
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_8 port = buf_out
+
+#pragma HLS INTERFACE s_axilite port = mode bundle = control
+#pragma HLS INTERFACE s_axilite port = nrow bundle = control
+#pragma HLS INTERFACE s_axilite port = run_len bundle = control
+#pragma HLS INTERFACE s_axilite port = sort_cfg bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in0 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in1 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in2 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in3 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in4 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in5 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in6 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_in7 bundle = control
+#pragma HLS INTERFACE s_axilite port = buf_out bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    // clang-format on
+    using namespace xf::database::gqe;
+
+    if (mode == 0) {
+#ifndef __SYNTHESIS__
+        printf("******************************\n");
+        printf("        Run generation\n");
+        printf("******************************\n");
+#endif
+        sort_gen_run(sort_cfg, buf_in0, buf_out);
+    } else {
+#ifndef __SYNTHESIS__
+        printf("******************************\n");
+        printf("   Merge pass, run_len=%d\n", run_len);
+        printf("******************************\n");
+#endif
+        const int group_len = SORT_MERGE_WAY * run_len;
+    SORT_MERGE_GROUP_LOOP:
+        for (int start = 0; start < nrow; start += group_len) {
+            sort_merge_group(buf_in0, buf_in1, buf_in2, buf_in3, buf_in4, buf_in5, buf_in6, buf_in7, buf_out, start,
+                             run_len, nrow);
+        }
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils.hpp"
+#include "gqe_sort.hpp"
+#include "xf_database/enums.hpp"
+
+#include <sys/time.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <ap_int.h>
+
+#ifndef HLS_TEST
+#include <CL/cl_ext_xilinx.h>
+#include <xcl2.hpp>
+
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+#endif // HLS_TEST
+
+// ORDER BY key0 DESC, key1 ASC, with the payload column carried along
+const int sort_cfg = 0 | (1 << 8) | (2 << 16) | (xf::database::SORT_DESCENDING << 24) |
+                     (xf::database::SORT_ASCENDING << 25);
+
+int check_result(ap_uint<512>* rec, std::vector<int>* col, int nrow) {
+    int nerror = 0;
+    std::vector<char> seen(nrow, 0);
+    int prev = -1;
+    for (int i = 0; i < nrow; i++) {
+        ap_uint<128> r = rec[i / SORT_REC_PER_VEC].range(128 * (i % SORT_REC_PER_VEC) + 127,
+                                                         128 * (i % SORT_REC_PER_VEC));
+        int rid = r.range(95, 64).to_int();
+        if (rid < 0 || rid >= nrow || seen[rid]) {
+            if (nerror < 10) std::cout << "record " << i << ": bad row id " << rid << std::endl;
+            nerror++;
+            continue;
+        }
+        seen[rid] = 1;
+        if (r.range(127, 96).to_int() != col[2][rid]) {
+            if (nerror < 10) std::cout << "record " << i << ": payload does not match row " << rid << std::endl;
+            nerror++;
+        }
+        if (prev >= 0) {
+            bool ordered = col[0][prev] > col[0][rid] || (col[0][prev] == col[0][rid] && col[1][prev] <= col[1][rid]);
+            if (!ordered) {
+                if (nerror < 10) std::cout << "record " << i << ": row " << rid << " out of order" << std::endl;
+                nerror++;
+            }
+        }
+        prev = rid;
+    }
+    return nerror;
+}
+
+int main(int argc, const char* argv[]) {
+    std::cout << "\n------------ GQE Sort Test -------------\n";
+
+    // cmd arg parser.
+    ArgParser parser(argc, argv);
+
+#ifndef HLS_TEST
+    std::string xclbin_path;
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR: xclbin path is not set!\n";
+        return 1;
+    }
+#endif
+
+    int nrow = 100000;
+    std::string nrow_str;
+    if (parser.getCmdOption("-n", nrow_str)) {
+        try {
+            nrow = std::stoi(nrow_str);
+        } catch (...) {
+            nrow = 100000;
+        }
+    }
+    if (nrow < SORT_RUN_LEN) {
+        nrow = SORT_RUN_LEN;
+        std::cout << "WARNING: raised row number to one run of " << nrow << " rows\n";
+    }
+
+    // table of 3 columns: key0 with many ties, key1 and payload
+    std::vector<int> col[3];
+    srand(1);
+    for (int i = 0; i < nrow; i++) {
+        col[0].push_back(rand() % 1000 - 500);
+        col[1].push_back(rand() % 20000 - 10000);
+        col[2].push_back(rand());
+    }
+    const size_t col_depth = (sizeof(int) * (nrow + VEC_LEN) + 63) / 64;
+    const size_t table_size = 1 + 3 * col_depth;
+    ap_uint<512>* table_in = aligned_alloc<ap_uint<512> >(table_size);
+    table_in[0] = 0;
+    table_in[0].range(31, 0) = nrow;
+    table_in[0].range(63, 32) = col_depth;
+    for (int c = 0; c < 3; c++) {
+        memcpy(table_in + 1 + c * col_depth, col[c].data(), sizeof(int) * nrow);
+    }
+
+    const size_t rec_size = (nrow + SORT_REC_PER_VEC - 1) / SORT_REC_PER_VEC;
+    ap_uint<512>* rec_out = aligned_alloc<ap_uint<512> >(rec_size);
+
+    int pass = 0;
+#ifdef HLS_TEST
+    ap_uint<512>* rec[2] = {aligned_alloc<ap_uint<512> >(rec_size), aligned_alloc<ap_uint<512> >(rec_size)};
+    gqeSort(0, nrow, 0, sort_cfg, table_in, table_in, table_in, table_in, table_in, table_in, table_in, table_in,
+            rec[0]);
+    for (int run_len = SORT_RUN_LEN; run_len < nrow; run_len *= SORT_MERGE_WAY) {
+        ap_uint<512>* in = rec[pass % 2];
+        gqeSort(1, nrow, run_len, sort_cfg, in, in, in, in, in, in, in, in, rec[(pass + 1) % 2]);
+        pass++;
+    }
+    memcpy(rec_out, rec[pass % 2], sizeof(ap_uint<512>) * rec_size);
+    free(rec[0]);
+    free(rec[1]);
+#else
+    // Get CL devices.
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Create context and command queue for selected device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    std::cout << "Selected Device " << devName << "\n";
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+
+    // input table in HBM 2, records go back and forth between HBM 0 and 1
+    cl_mem_ext_ptr_t mext_table_in = {XCL_BANK(2), table_in, 0};
+    cl_mem_ext_ptr_t mext_ping = {XCL_BANK(0), nullptr, 0};
+    cl_mem_ext_ptr_t mext_pong = {XCL_BANK(1), nullptr, 0};
+    cl::Buffer buf_table_in(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                            sizeof(ap_uint<512>) * table_size, &mext_table_in);
+    cl::Buffer buf_rec[2] = {cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_READ_WRITE,
+                                        sizeof(ap_uint<512>) * rec_size, &mext_ping),
+                             cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_READ_WRITE,
+                                        sizeof(ap_uint<512>) * rec_size, &mext_pong)};
+
+    std::vector<cl::Memory> ibtable;
+    ibtable.push_back(buf_table_in);
+    std::vector<cl::Event> events(1);
+    q.enqueueMigrateMemObjects(ibtable, 0, nullptr, &events[0]);
+
+    struct timeval tv0, tv1;
+    gettimeofday(&tv0, 0);
+    // one kernel object per pass, all passes are in flight
+    std::vector<cl::Kernel> kernels;
+    for (int run_len = 0; run_len < nrow; run_len = run_len ? run_len * SORT_MERGE_WAY : SORT_RUN_LEN) {
+        cl::Kernel kernel(program, "gqeSort");
+        cl::Buffer& in = run_len ? buf_rec[(pass + 1) % 2] : buf_table_in;
+        int j = 0;
+        kernel.setArg(j++, run_len ? 1 : 0);
+        kernel.setArg(j++, nrow);
+        kernel.setArg(j++, run_len);
+        kernel.setArg(j++, sort_cfg);
+        for (int w = 0; w < SORT_MERGE_WAY; w++) {
+            kernel.setArg(j++, in);
+        }
+        kernel.setArg(j++, buf_rec[pass % 2]);
+        kernels.push_back(kernel);
+        std::vector<cl::Event> wait(1, events.back());
+        events.push_back(cl::Event());
+        q.enqueueTask(kernel, &wait, &events.back());
+        pass++;
+    }
+    // the run generation pass is not a merge pass
+    pass--;
+    std::vector<cl::Event> wait(1, events.back());
+    q.enqueueReadBuffer(buf_rec[pass % 2], CL_TRUE, 0, sizeof(ap_uint<512>) * rec_size, rec_out, &wait, nullptr);
+    q.finish();
+    gettimeofday(&tv1, 0);
+    std::cout << "FPGA execution time of run generation and " << pass
+              << " merge passes: " << tvdiff(&tv0, &tv1) / 1000 << " ms\n";
+#endif
+
+    std::cout << "------------------------Result Checking-------------------------\n";
+    int nerror = check_result(rec_out, col, nrow);
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found in " << nrow << " sorted rows after " << pass
+                  << " merge passes.\n";
+    } else {
+        std::cout << "PASS: " << nrow << " rows sorted after " << pass << " merge passes.\n";
+    }
+    free(table_in);
+    free(rec_out);
+    return nerror;
+}
@@ -993,6 +993,45 @@ bool dynamicALUOPCompiler(const char expr_str[Formula_Max_Length],
     return success;
 }
 
+/**
+ * @brief Generate the decimal config word of dynamicEval.
+ *
+ * The expression is evaluated on unscaled values, so its scale is the sum of the scales of multiplied
+ * operands, and dividing by Stream4 takes the scale of Stream4 off. For example ``a * (c - b)`` on
+ * ``DECIMAL(15,2)`` columns has scale 4, and brought back to 2 by ``dynamicALUDecimalConfig(4, 2, dec_cfg)``.
+ *
+ * @param expr_scale scale of the expression as evaluated.
+ * @param out_scale scale of the result.
+ * @param div_scale scale of Stream4 when dividing the result by it, -1 for no division.
+ * @param dec_cfg output config word, exponent of 10 in bits 7:0 and division in bit 8.
+ *
+ * @return true on success, false when the exponent is out of the range of [-38, 38] and dec_cfg is left as is.
+ */
+inline bool dynamicALUDecimalConfig(int expr_scale, int out_scale, int div_scale, ap_uint<32>& dec_cfg) {
+    int e = out_scale - expr_scale + (div_scale < 0 ? 0 : div_scale);
+    if (e < -38 || e > 38) {
+        printf("ERROR: decimal rescale by 10^%d out of range\n", e);
+        return false;
+    }
+    dec_cfg = 0;
+    dec_cfg.range(7, 0) = (ap_uint<8>)(e & 0xff);
+    dec_cfg[8] = div_scale >= 0;
+    return true;
+}
+
+/**
+ * @brief Generate the decimal config word of dynamicEval without division by Stream4.
+ *
+ * @param expr_scale scale of the expression as evaluated.
+ * @param out_scale scale of the result.
+ * @param dec_cfg output config word.
+ *
+ * @return true on success, false when the exponent is out of range.
+ */
+inline bool dynamicALUDecimalConfig(int expr_scale, int out_scale, ap_uint<32>& dec_cfg) {
+    return dynamicALUDecimalConfig(expr_scale, out_scale, -1, dec_cfg);
+}
+
 } // namespace database
 } // namespace xf
 
@@ -81,6 +81,15 @@ int main(int argc, const char* argv[]) {
         }
     }
 
+    // decimal rescale, scale 4 to 2, and scale 2 divided by scale 2 to 2
+    ap_uint<32> dec_cfg = 0;
+    test_pass &= xf::database::dynamicALUDecimalConfig(4, 2, dec_cfg) && dec_cfg == 0xfe;
+    test_pass &= xf::database::dynamicALUDecimalConfig(2, 2, 2, dec_cfg) && dec_cfg == 0x102;
+    // 10^-40 is out of range and leaves the word as is
+    test_pass &= !xf::database::dynamicALUDecimalConfig(42, 2, dec_cfg) && dec_cfg == 0x102;
+    std::cout << "\n"
+              << "Decimal: " << (test_pass ? "pass" : "failed") << std::endl;
+
     if (test_pass)
         std::cout << "\n"
                   << "TEST PASS!" << std::endl;
@@ -154,7 +154,8 @@ void MultipleMonteCarloModel(ap_uint<16> steps,
                              PathPricerT pathPriInst[UnrollNm][1],
                              RNGSeqT rngSeqInst[UnrollNm][1],
                              DT& sum,
-                             DT& squareSum) {
+                             DT& squareSum,
+                             DT laneSum[UnrollNm]) {
     hls::stream<DT> sumStrm[UnrollNm];
 #pragma HLS stream variable = sumStrm depth = 8
 #pragma HLS array_partition variable = sumStrm dim = 0
@@ -173,6 +174,217 @@ void MultipleMonteCarloModel(ap_uint<16> steps,
         DT squareTemp = squareSumStrm[i].read();
         sum = FPTwoAdd(sum, sumTemp);
         squareSum = FPTwoAdd(squareSum, squareTemp);
+        laneSum[i] = FPTwoAdd(laneSum[i], sumTemp);
+    }
+}
+
+template <typename DT, typename RNG, typename PathGeneratorT, typename PathPricerT, typename RNGSeqT, int VariateNum>
+void monteCarloMultiModel(ap_uint<16> steps,
+                          ap_uint<16> paths,
+                          RNG rngInst[VariateNum],
+                          PathGeneratorT pathGenInst[1],
+                          PathPricerT pathPriInst[1],
+                          RNGSeqT rngSeqInst[1],
+                          hls::stream<DT>& sumStrm,
+                          hls::stream<DT>& squareSumStrm) {
+#pragma HLS inline off
+#pragma HLS DATAFLOW
+    const static unsigned int RN = RNGSeqT::OutN;
+    const static unsigned int PN = PathPricerT::InN;
+
+    hls::stream<DT> rdNmStrm[RN];
+#pragma HLS stream variable = rdNmStrm depth = 8
+    hls::stream<DT> pathStrm[PN];
+#pragma HLS stream variable = pathStrm depth = 8
+    // Generate random number
+    rngSeqInst[0].NextSeq(steps, paths, rngInst, rdNmStrm);
+    pathGenInst[0].NextPath(steps, paths, rdNmStrm, pathStrm);
+    // Price and accumulate every payoff of the path
+    pathPriInst[0].Pricing(steps, paths, pathStrm, sumStrm, squareSumStrm);
+}
+
+template <typename DT,
+          typename RNG,
+          int UnrollNm,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int VariateNum>
+void MultipleMonteCarloMultiModel(ap_uint<16> steps,
+                                  ap_uint<16> paths,
+                                  RNG rngInst[UnrollNm][VariateNum],
+                                  PathGeneratorT pathGenInst[UnrollNm][1],
+                                  PathPricerT pathPriInst[UnrollNm][1],
+                                  RNGSeqT rngSeqInst[UnrollNm][1],
+                                  DT sum[PathPricerT::OutN],
+                                  DT squareSum[PathPricerT::OutN],
+                                  DT laneSum[UnrollNm][PathPricerT::OutN]) {
+    const static unsigned int KN = PathPricerT::OutN;
+    hls::stream<DT> sumStrm[UnrollNm];
+#pragma HLS stream variable = sumStrm depth = KN
+#pragma HLS array_partition variable = sumStrm dim = 0
+    hls::stream<DT> squareSumStrm[UnrollNm];
+#pragma HLS stream variable = squareSumStrm depth = KN
+#pragma HLS array_partition variable = squareSumStrm dim = 0
+
+    for (int i = 0; i < UnrollNm; ++i) {
+#pragma HLS unroll
+        monteCarloMultiModel<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            steps, paths, rngInst[i], pathGenInst[i], pathPriInst[i], rngSeqInst[i], sumStrm[i], squareSumStrm[i]);
+    }
+    for (int i = 0; i < UnrollNm; ++i) {
+        for (int k = 0; k < KN; ++k) {
+#pragma HLS pipeline
+            DT sumTemp = sumStrm[i].read();
+            DT squareTemp = squareSumStrm[i].read();
+            sum[k] = FPTwoAdd(sum[k], sumTemp);
+            squareSum[k] = FPTwoAdd(squareSum[k], squareTemp);
+            laneSum[i][k] = FPTwoAdd(laneSum[i][k], sumTemp);
+        }
+    }
+}
+
+// accumulates the price and the control of each path, with the cross sum for
+// the covariance. The sums of the price and of the control are written in turn.
+template <typename DT>
+void cvAccumulator(ap_uint<16> paths,
+                   hls::stream<DT> priceStrmIn[1],
+                   hls::stream<DT> ctrlStrmIn[1],
+                   hls::stream<DT>& sumStrm,
+                   hls::stream<DT>& squareSumStrm,
+                   hls::stream<DT>& crossSumStrm) {
+#pragma HLS inline off
+    const unsigned int DEP = 16;
+    DT sumBuffer[2][DEP]; // because the latency of ACC_LOOP is 14
+#pragma HLS array_partition variable = sumBuffer dim = 1
+    DT squareSumBuffer[2][DEP];
+#pragma HLS array_partition variable = squareSumBuffer dim = 1
+    DT crossSumBuffer[DEP];
+BUFF_INIT_LOOP:
+    for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 1
+        for (int k = 0; k < 2; ++k) {
+#pragma HLS unroll
+            sumBuffer[k][i] = 0;
+            squareSumBuffer[k][i] = 0;
+        }
+        crossSumBuffer[i] = 0;
+    }
+    ap_uint<4> cnt = 0;
+ACC_LOOP:
+    for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        DT in[2];
+        in[0] = priceStrmIn[0].read();
+        in[1] = ctrlStrmIn[0].read();
+        for (int k = 0; k < 2; ++k) {
+#pragma HLS unroll
+            sumBuffer[k][cnt] = FPTwoAdd(sumBuffer[k][cnt], in[k]);
+            squareSumBuffer[k][cnt] = FPTwoAdd(squareSumBuffer[k][cnt], FPTwoMul(in[k], in[k]));
+        }
+        crossSumBuffer[cnt] = FPTwoAdd(crossSumBuffer[cnt], FPTwoMul(in[0], in[1]));
+        cnt++;
+    }
+    DT crossSum = 0;
+POST_ACC_LOOP:
+    for (int k = 0; k < 2; ++k) {
+        DT sum = 0;
+        DT squareSum = 0;
+        for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 8
+            sum += sumBuffer[k][i];
+            squareSum += squareSumBuffer[k][i];
+            if (k == 0) crossSum += crossSumBuffer[i];
+        }
+        sumStrm.write(sum);
+        squareSumStrm.write(squareSum);
+    }
+    crossSumStrm.write(crossSum);
+}
+
+template <typename DT, typename RNG, typename PathGeneratorT, typename PathPricerT, typename RNGSeqT, int VariateNum>
+void monteCarloCVModel(ap_uint<16> steps,
+                       ap_uint<16> paths,
+                       RNG rngInst[VariateNum],
+                       PathGeneratorT pathGenInst[1],
+                       PathPricerT pathPriInst[1],
+                       RNGSeqT rngSeqInst[1],
+                       hls::stream<DT>& sumStrm,
+                       hls::stream<DT>& squareSumStrm,
+                       hls::stream<DT>& crossSumStrm) {
+#pragma HLS inline off
+#pragma HLS DATAFLOW
+    const static unsigned int RN = RNGSeqT::OutN;
+    const static unsigned int PN = PathPricerT::InN;
+
+    hls::stream<DT> rdNmStrm[RN];
+#pragma HLS stream variable = rdNmStrm depth = 8
+    hls::stream<DT> pathStrm[PN];
+#pragma HLS stream variable = pathStrm depth = 8
+    hls::stream<DT> priceStrm[PN];
+#pragma HLS stream variable = priceStrm depth = 8
+    hls::stream<DT> ctrlStrm[PN];
+#pragma HLS stream variable = ctrlStrm depth = 8
+    hls::stream<DT> avgPriStrm[1];
+#pragma HLS stream variable = avgPriStrm depth = 8
+    hls::stream<DT> avgCtrlStrm[1];
+#pragma HLS stream variable = avgCtrlStrm depth = 8
+    // Generate random number
+    rngSeqInst[0].NextSeq(steps, paths, rngInst, rdNmStrm);
+    pathGenInst[0].NextPath(steps, paths, rdNmStrm, pathStrm);
+    pathPriInst[0].Pricing(steps, paths, pathStrm, priceStrm, ctrlStrm);
+    if (PN == 2) {
+        antithetic<DT>(paths, priceStrm, avgPriStrm);
+        antithetic<DT>(paths, ctrlStrm, avgCtrlStrm);
+        cvAccumulator<DT>(paths, avgPriStrm, avgCtrlStrm, sumStrm, squareSumStrm, crossSumStrm);
+    } else {
+        cvAccumulator<DT>(paths, priceStrm, ctrlStrm, sumStrm, squareSumStrm, crossSumStrm);
+    }
+}
+
+template <typename DT,
+          typename RNG,
+          int UnrollNm,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int VariateNum>
+void MultipleMonteCarloCVModel(ap_uint<16> steps,
+                               ap_uint<16> paths,
+                               RNG rngInst[UnrollNm][VariateNum],
+                               PathGeneratorT pathGenInst[UnrollNm][1],
+                               PathPricerT pathPriInst[UnrollNm][1],
+                               RNGSeqT rngSeqInst[UnrollNm][1],
+                               DT sum[2],
+                               DT squareSum[2],
+                               DT& crossSum,
+                               DT laneSum[UnrollNm][2]) {
+    hls::stream<DT> sumStrm[UnrollNm];
+#pragma HLS stream variable = sumStrm depth = 8
+#pragma HLS array_partition variable = sumStrm dim = 0
+    hls::stream<DT> squareSumStrm[UnrollNm];
+#pragma HLS stream variable = squareSumStrm depth = 8
+#pragma HLS array_partition variable = squareSumStrm dim = 0
+    hls::stream<DT> crossSumStrm[UnrollNm];
+#pragma HLS stream variable = crossSumStrm depth = 8
+#pragma HLS array_partition variable = crossSumStrm dim = 0
+
+    for (int i = 0; i < UnrollNm; ++i) {
+#pragma HLS unroll
+        monteCarloCVModel<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            steps, paths, rngInst[i], pathGenInst[i], pathPriInst[i], rngSeqInst[i], sumStrm[i], squareSumStrm[i],
+            crossSumStrm[i]);
+    }
+    for (int i = 0; i < UnrollNm; ++i) {
+        for (int k = 0; k < 2; ++k) {
+#pragma HLS pipeline
+            DT sumTemp = sumStrm[i].read();
+            sum[k] = FPTwoAdd(sum[k], sumTemp);
+            squareSum[k] = FPTwoAdd(squareSum[k], squareSumStrm[i].read());
+            laneSum[i][k] = FPTwoAdd(laneSum[i][k], sumTemp);
+        }
+        crossSum = FPTwoAdd(crossSum, crossSumStrm[i].read());
     }
 }
 
@@ -189,12 +401,70 @@ inline DT SampleErrorEstimate(DT mean, DT sum, DT squareSum, ap_uint<27> samples
     return hls::sqrt(variance / samplesNumbers);
 }
 
+// error estimate from the spread of the means of UN independent replicas,
+// each of laneSamples samples, for randomized quasi-Monte Carlo where the
+// samples of a lane are not independent.
+template <typename DT, int UN>
+DT LaneErrorEstimate(DT mean, DT laneSum[UN], ap_uint<27> laneSamples) {
+    DT squareDev = 0;
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS pipeline
+        DT dev = FPTwoSub(laneSum[i] / laneSamples, mean);
+        squareDev = FPTwoAdd(squareDev, FPTwoMul(dev, dev));
+    }
+    return hls::sqrt(squareDev / (UN * (UN - 1)));
+}
+
+// the spread of the lanes when they are replicas, the sample variance otherwise
+template <typename RNGSeqT, typename DT, int UN>
+DT ErrorEstimate(DT mean, DT sum, DT squareSum, DT laneSum[UN], ap_uint<27> samplesNumbers) {
+    if (LaneReplicas<RNGSeqT>::value && UN > 1)
+        return LaneErrorEstimate<DT, UN>(mean, laneSum, samplesNumbers / UN);
+    else
+        return SampleErrorEstimate(mean, sum, squareSum, samplesNumbers);
+}
+
+// control variate estimate: the optimal beta is Cov(price, control) / Var(control)
+// from the samples so far, and the variance of the adjusted price is
+// Var(price) - beta * Cov(price, control).
+template <typename RNGSeqT, typename DT, int UN>
+void cvEstimate(DT sum[2],
+                DT squareSum[2],
+                DT crossSum,
+                DT laneSum[UN][2],
+                DT controlMean,
+                ap_uint<27> samplesNumbers,
+                DT& mean,
+                DT& error) {
+    DT meanY = SampleMean(sum[0], samplesNumbers);
+    DT meanC = SampleMean(sum[1], samplesNumbers);
+    DT varY = FPTwoSub(squareSum[0] / samplesNumbers, FPTwoMul(meanY, meanY));
+    DT varC = FPTwoSub(squareSum[1] / samplesNumbers, FPTwoMul(meanC, meanC));
+    DT cov = FPTwoSub(crossSum / samplesNumbers, FPTwoMul(meanY, meanC));
+    DT beta = varC > 0 ? cov / varC : (DT)0;
+    mean = FPTwoSub(meanY, FPTwoMul(beta, FPTwoSub(meanC, controlMean)));
+    DT variance = FPTwoSub(varY, FPTwoMul(beta, cov));
+    if (variance < 0) variance = 0;
+    error = hls::sqrt(variance / samplesNumbers);
+    if (LaneReplicas<RNGSeqT>::value && UN > 1) {
+        // the same beta adjusts the estimate of each lane
+        DT laneAdj[UN];
+        ap_uint<27> laneSamples = samplesNumbers / UN;
+        for (int i = 0; i < UN; ++i) {
+#pragma HLS pipeline
+            DT laneC = FPTwoSub(laneSum[i][1] / laneSamples, controlMean);
+            laneAdj[i] = FPTwoSub(laneSum[i][0], FPTwoMul(beta, laneC) * laneSamples);
+        }
+        error = LaneErrorEstimate<DT, UN>(mean, laneAdj, laneSamples);
+    }
+}
+
 template <typename RNG, typename RNGSeqT, int UnrollNm, int VariateNum>
 void InitWrap(RNG rngInst[UnrollNm][VariateNum], RNGSeqT rngSeqInst[UnrollNm][1]) {
     //#pragma HLS dataflow
     for (int i = 0; i < UnrollNm; ++i) {
 #pragma HLS unroll
-        rngSeqInst[i][0].Init(rngInst[i]);
+        initLane(rngSeqInst[i][0], rngInst[i], i, UnrollNm);
     }
 }
 } // namespace internal
@@ -218,7 +488,9 @@ void InitWrap(RNG rngInst[UnrollNm][VariateNum], RNGSeqT rngSeqInst[UnrollNm][1]
  * @param maxSamples the maximum sample number. When reaching it, the simulation
  * will stop.
  * @param requiredTolerance the tolerance required. If requiredSamples is not
- * set, when reaching the required tolerance, simulation will stop.
+ * set, when reaching the required tolerance, simulation will stop. With a
+ * randomized Sobol sequence, the error is estimated from the spread of the
+ * means of the UN lanes, see SobolBridgeSequence.
  * @param requiredSamples the samples number required. When reaching the
  * required number, simulation will stop.
  * @param pathGenInst instance of path generator.
@@ -259,6 +531,12 @@ DT mcSimulation(ap_uint<16> timeSteps,
     DT squareSum = 0;
     // mean of all samples
     DT mean = 0;
+    // sum of the samples of each lane
+    DT laneSum[UN];
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        laneSum[i] = 0;
+    }
 
     // simulation times
     ap_uint<17> loopNum = 0;
@@ -281,10 +559,10 @@ Req_Samples_Loop:
     for (int i = 0; i < loopNum; ++i) {
 #pragma HLS loop_tripcount min = 1 max = 1
         internal::MultipleMonteCarloModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
-            timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum);
+            timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum, laneSum);
     }
     mean = internal::SampleMean(sum, totalSamples);
-    DT error = internal::SampleErrorEstimate(mean, sum, squareSum, totalSamples);
+    DT error = internal::ErrorEstimate<RNGSeqT, DT, UN>(mean, sum, squareSum, laneSum, totalSamples);
     if (requiredSamples == 0) {
     Req_Tolerance_Loop:
         while ((requiredTolerance < error) && ((maxSamples > 0 && totalSamples < maxSamples) || maxSamples == 0)) {
@@ -297,9 +575,9 @@ Req_Samples_Loop:
             totalSamples += Batch;
             // Monte Carlo Module
             internal::MultipleMonteCarloModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
-                timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum);
+                timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum, laneSum);
             mean = internal::SampleMean(sum, totalSamples);
-            error = internal::SampleErrorEstimate(mean, sum, squareSum, totalSamples);
+            error = internal::ErrorEstimate<RNGSeqT, DT, UN>(mean, sum, squareSum, laneSum, totalSamples);
         }
     }
 #ifndef __SYNTHESIS__
@@ -310,6 +588,243 @@ Req_Samples_Loop:
 #endif
     return mean; // SampleMean(sum, totalSamples);
 }
+
+/**
+ * @brief Monte Carlo Framework for a grid of payoffs priced on the same
+ * paths. The path pricer accumulates the statistics of each payoff itself, see
+ * MultiPayoffPathPricer. With requiredSamples unset, the simulation runs until
+ * the largest error estimate among the payoffs reaches the tolerance.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type which simulates the dynamics of
+ * the asset price.
+ * @tparam PathPricerT multi-payoff path pricer type, its OutN is the maximum
+ * number of payoffs.
+ * @tparam RNGSeqT random number sequence generator type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the total samples are divided into several steps, SampNum is
+ * the number for each step.
+ * @param timeSteps number of the steps for each path.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop.
+ * @param requiredTolerance the tolerance required. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop.
+ * @param payoffNum number of valid payoffs, at most PathPricerT::OutN.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ * @param price price of each payoff.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum>
+void mcSimulationMultiPayoff(ap_uint<16> timeSteps,
+                             ap_uint<27> maxSamples,
+                             ap_uint<27> requiredSamples,
+                             DT requiredTolerance,
+                             ap_uint<16> payoffNum,
+                             PathGeneratorT pathGenInst[UN][1],
+                             PathPricerT pathPriInst[UN][1],
+                             RNGSeqT rngSeqInst[UN][1],
+                             DT price[PathPricerT::OutN]) {
+    const static unsigned int KN = PathPricerT::OutN;
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // RNG Instance
+    RNG rngInst[UN][VariateNum];
+#pragma HLS array_partition variable = rngInst dim = 0
+
+    // Initialize RNG
+    internal::InitWrap<RNG, RNGSeqT, UN, VariateNum>(rngInst, rngSeqInst);
+
+    // record the total number of samples
+    ap_uint<27> totalSamples = 0;
+
+    // sum and square sum of all samples for each payoff
+    DT sum[KN];
+    DT squareSum[KN];
+    DT laneSum[UN][KN];
+    DT laneSumK[UN];
+    for (int k = 0; k < KN; ++k) {
+#pragma HLS pipeline
+        sum[k] = 0;
+        squareSum[k] = 0;
+        for (int i = 0; i < UN; ++i) {
+            laneSum[i][k] = 0;
+        }
+    }
+
+    // simulation times
+    ap_uint<17> loopNum = 0;
+
+    if (requiredSamples > 0) {
+        loopNum = (requiredSamples + Batch - 1) / Batch;
+        totalSamples = loopNum * Batch;
+    } else {
+        loopNum = 1;
+        totalSamples = Batch;
+    }
+
+Req_Samples_Loop:
+    for (int i = 0; i < loopNum; ++i) {
+#pragma HLS loop_tripcount min = 1 max = 1
+        internal::MultipleMonteCarloMultiModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum, laneSum);
+    }
+    DT error = 0;
+    for (int k = 0; k < payoffNum; ++k) {
+#pragma HLS loop_tripcount min = KN max = KN
+        for (int i = 0; i < UN; ++i) laneSumK[i] = laneSum[i][k];
+        DT mean = internal::SampleMean(sum[k], totalSamples);
+        DT e = internal::ErrorEstimate<RNGSeqT, DT, UN>(mean, sum[k], squareSum[k], laneSumK, totalSamples);
+        if (e > error) error = e;
+    }
+    if (requiredSamples == 0) {
+    Req_Tolerance_Loop:
+        while ((requiredTolerance < error) && ((maxSamples > 0 && totalSamples < maxSamples) || maxSamples == 0)) {
+#pragma HLS loop_tripcount min = 5 max = 5
+            totalSamples += Batch;
+            // Monte Carlo Module
+            internal::MultipleMonteCarloMultiModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+                timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum, laneSum);
+            error = 0;
+            for (int k = 0; k < payoffNum; ++k) {
+#pragma HLS loop_tripcount min = KN max = KN
+                for (int i = 0; i < UN; ++i) laneSumK[i] = laneSum[i][k];
+                DT mean = internal::SampleMean(sum[k], totalSamples);
+                DT e = internal::ErrorEstimate<RNGSeqT, DT, UN>(mean, sum[k], squareSum[k], laneSumK, totalSamples);
+                if (e > error) error = e;
+            }
+        }
+    }
+    for (int k = 0; k < KN; ++k) {
+#pragma HLS pipeline
+        price[k] = internal::SampleMean(sum[k], totalSamples);
+    }
+}
+
+/**
+ * @brief Monte Carlo Framework with a control variate. The path pricer writes
+ * the price and a control with a known expectation for each path, see
+ * ControlVariatePathPricer. The price is adjusted by beta times the error of
+ * the control, where beta is estimated from the same samples, and the
+ * tolerance applies to the error estimate of the adjusted price.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type which simulates the dynamics of
+ * the asset price.
+ * @tparam PathPricerT control variate path pricer type.
+ * @tparam RNGSeqT random number sequence generator type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the total samples are divided into several steps, SampNum is
+ * the number for each step.
+ * @param timeSteps number of the steps for each path.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop.
+ * @param requiredTolerance the tolerance required. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop.
+ * @param controlMean the expectation of the control.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum>
+DT mcSimulationControlVariate(ap_uint<16> timeSteps,
+                              ap_uint<27> maxSamples,
+                              ap_uint<27> requiredSamples,
+                              DT requiredTolerance,
+                              DT controlMean,
+                              PathGeneratorT pathGenInst[UN][1],
+                              PathPricerT pathPriInst[UN][1],
+                              RNGSeqT rngSeqInst[UN][1]) {
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // RNG Instance
+    RNG rngInst[UN][VariateNum];
+#pragma HLS array_partition variable = rngInst dim = 0
+
+    // Initialize RNG
+    internal::InitWrap<RNG, RNGSeqT, UN, VariateNum>(rngInst, rngSeqInst);
+
+    // record the total number of samples
+    ap_uint<27> totalSamples = 0;
+
+    // sums of the price and of the control, and their cross sum
+    DT sum[2] = {0, 0};
+    DT squareSum[2] = {0, 0};
+    DT crossSum = 0;
+    // sums of the price and of the control of each lane
+    DT laneSum[UN][2];
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        laneSum[i][0] = 0;
+        laneSum[i][1] = 0;
+    }
+
+    // simulation times
+    ap_uint<17> loopNum = 0;
+
+    if (requiredSamples > 0) {
+        loopNum = (requiredSamples + Batch - 1) / Batch;
+        totalSamples = loopNum * Batch;
+    } else {
+        loopNum = 1;
+        totalSamples = Batch;
+    }
+
+Req_Samples_Loop:
+    for (int i = 0; i < loopNum; ++i) {
+#pragma HLS loop_tripcount min = 1 max = 1
+        internal::MultipleMonteCarloCVModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum, crossSum, laneSum);
+    }
+    DT mean, error;
+    internal::cvEstimate<RNGSeqT, DT, UN>(sum, squareSum, crossSum, laneSum, controlMean, totalSamples, mean, error);
+    if (requiredSamples == 0) {
+    Req_Tolerance_Loop:
+        while ((requiredTolerance < error) && ((maxSamples > 0 && totalSamples < maxSamples) || maxSamples == 0)) {
+#pragma HLS loop_tripcount min = 5 max = 5
+            totalSamples += Batch;
+            // Monte Carlo Module
+            internal::MultipleMonteCarloCVModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+                timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum, crossSum, laneSum);
+            internal::cvEstimate<RNGSeqT, DT, UN>(sum, squareSum, crossSum, laneSum, controlMean, totalSamples, mean,
+                                                  error);
+        }
+    }
+#ifndef __SYNTHESIS__
+#ifdef HLS_DEBUG
+    std::cout << "totalSamples=" << totalSamples << std::endl;
+#endif
+#endif
+    return mean;
+}
 } // namespace fintech
 } // namespace xf
 #endif
@@ -1656,6 +1656,471 @@ class CapFloorPathPricer {
     }
 };
 
+/**
+ * @brief European pricer of a grid of payoffs on the same underlying. Each
+ * path from the path generator is priced against every (strike, maturity,
+ * type) of the grid, and the per-payoff sum and square sum are accumulated
+ * here, so that one simulation serves all of them.
+ *
+ * @tparam DT supported data type including double and float.
+ * @tparam SampNum number of paths of one call, paths are read step by step.
+ * @tparam MaxK maximum number of payoffs.
+ * @tparam WithAntithetic antithetic paths are read on a second stream.
+ */
+template <typename DT, int SampNum, int MaxK, bool WithAntithetic>
+class MultiPayoffPathPricer {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+    const static unsigned int OutN = MaxK;
+    const static bool byPassGen = false;
+
+    DT underlying;
+    // payoffs of the grid, only the first payoffNum are valid
+    ap_uint<16> payoffNum;
+    DT strike[MaxK];
+    // time step of the maturity, from 1 to steps
+    ap_uint<16> maturityStep[MaxK];
+    DT discount[MaxK];
+    bool optionType[MaxK];
+
+    MultiPayoffPathPricer() {
+#pragma HLS array_partition variable = strike dim = 0
+#pragma HLS array_partition variable = maturityStep dim = 0
+#pragma HLS array_partition variable = discount dim = 0
+#pragma HLS array_partition variable = optionType dim = 0
+    }
+
+    DT payoff(int k, DT s) {
+        DT op1, op2;
+        if (optionType[k]) {
+            op1 = strike[k];
+            op2 = s;
+        } else {
+            op1 = s;
+            op2 = strike[k];
+        }
+        DT p1 = FPTwoSub(op1, op2);
+        return FPTwoMul(discount[k], MAX(p1, 0));
+    }
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT>& sumStrm,
+                 hls::stream<DT>& squareSumStrm) {
+#pragma HLS inline off
+        const unsigned int DEP = 16;
+        DT logS[InN][SampNum];
+#pragma HLS array_partition variable = logS dim = 1
+        // because the latency of ACC_LOOP is 14
+        DT sumBuffer[MaxK][DEP];
+#pragma HLS array_partition variable = sumBuffer dim = 1
+        DT squareSumBuffer[MaxK][DEP];
+#pragma HLS array_partition variable = squareSumBuffer dim = 1
+    BUFF_INIT_LOOP:
+        for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 1
+            for (int k = 0; k < MaxK; ++k) {
+#pragma HLS unroll
+                sumBuffer[k][i] = 0;
+                squareSumBuffer[k][i] = 0;
+            }
+        }
+        ap_uint<4> cnt = 0;
+    ACC_LOOP:
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT s[InN];
+                for (int a = 0; a < InN; ++a) {
+#pragma HLS unroll
+                    DT dlogS = pathStrmIn[a].read();
+                    DT tmplogS = (i == 0) ? dlogS : FPTwoAdd(logS[a][j], dlogS);
+                    logS[a][j] = tmplogS;
+                    s[a] = FPTwoMul(underlying, FPExp(tmplogS));
+                }
+                for (int k = 0; k < MaxK; ++k) {
+#pragma HLS unroll
+                    if (k < payoffNum && maturityStep[k] == i + 1) {
+                        DT price = payoff(k, s[0]);
+                        if (WithAntithetic) {
+                            DT price2 = payoff(k, s[InN - 1]);
+                            price = FPTwoMul((DT)0.5, FPTwoAdd(price, price2));
+                        }
+                        DT mulTemp = FPTwoMul(price, price);
+                        sumBuffer[k][cnt] = FPTwoAdd(sumBuffer[k][cnt], price);
+                        squareSumBuffer[k][cnt] = FPTwoAdd(squareSumBuffer[k][cnt], mulTemp);
+                    }
+                }
+                cnt++;
+            }
+        }
+    POST_ACC_LOOP:
+        for (int k = 0; k < MaxK; ++k) {
+            DT sum = 0;
+            DT squareSum = 0;
+            for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 8
+                sum += sumBuffer[k][i];
+                squareSum += squareSumBuffer[k][i];
+            }
+            sumStrm.write(sum);
+            squareSumStrm.write(squareSum);
+        }
+    }
+};
+
+/**
+ * @brief Black-Scholes pricer of the price and Greeks of one option in the same
+ * pass. Delta, vega, rho and theta are pathwise derivatives for the European
+ * and the arithmetic Asian (Asian_AP) payoff, and likelihood ratio (LRM)
+ * weights for the Digital payoff, whose pathwise derivatives are zero. Gamma is
+ * always LRM, on the whole horizon for European and Digital and on the first
+ * step for Asian_AP. Digital here is cash-or-nothing at expiry. The results are
+ * accumulated as the payoffs of MultiPayoffPathPricer, in the order price,
+ * theta, rho, delta, gamma, vega, where theta is the derivative to the time to
+ * maturity.
+ *
+ * @tparam style option style, European, Digital or Asian_AP.
+ * @tparam DT supported data type including double and float.
+ * @tparam SampNum number of paths of one call, paths are read step by step.
+ * @tparam WithAntithetic antithetic paths are read on a second stream.
+ */
+template <OptionStyle style, typename DT, int SampNum, bool WithAntithetic>
+class GreeksPathPricer {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+    const static unsigned int OutN = 6;
+    const static bool byPassGen = false;
+
+    DT underlying;
+    DT strike;
+    DT cashPayoff;
+    bool optionType;
+    DT volatility;
+    DT riskFreeRate;
+    DT timeLength;
+    // drift of log price per unit time
+    DT mu;
+    // time step
+    DT dt;
+    DT discount;
+
+    GreeksPathPricer() {}
+
+    void init(DT input_underlying,
+              DT input_strike,
+              DT input_cash,
+              bool input_type,
+              DT input_volatility,
+              DT input_riskFreeRate,
+              DT input_dividendYield,
+              DT input_timeLength,
+              ap_uint<16> steps) {
+        underlying = input_underlying;
+        strike = input_strike;
+        cashPayoff = input_cash;
+        optionType = input_type;
+        volatility = input_volatility;
+        riskFreeRate = input_riskFreeRate;
+        timeLength = input_timeLength;
+        mu = input_riskFreeRate - input_dividendYield - 0.5 * input_volatility * input_volatility;
+        dt = input_timeLength / steps;
+        discount = FPExp(-FPTwoMul(input_riskFreeRate, input_timeLength));
+    }
+
+    // price and Greeks of one path, given the terminal (or average) price s, the
+    // normal behind the LRM weights z over time tz, and for Asian_AP the sums of
+    // s_i * log(s_i / s_0) and s_i * t_i over the n fixings and the first price s1
+    void greeks(DT s, DT z, DT tz, DT sumSx, DT sumSt, DT n, DT s1, DT out[OutN]) {
+#pragma HLS inline
+        DT diff = optionType ? FPTwoSub(strike, s) : FPTwoSub(s, strike);
+        DT sign = optionType ? (DT)-1 : (DT)1;
+        bool itm = diff > 0;
+        DT sigma = volatility;
+        DT sqrtTz = hls::sqrt(tz);
+        DT s0 = underlying;
+        DT price, dS0, dSigma, dR, dT;
+        if (style == Digital) {
+            price = itm ? FPTwoMul(discount, cashPayoff) : (DT)0;
+            DT zw = z / (sigma * sqrtTz);
+            dS0 = price * zw / s0;
+            dSigma = price * ((z * z - 1) / sigma - z * sqrtTz);
+            dR = price * (z * sqrtTz / sigma - timeLength);
+            dT = price * (mu * zw + (z * z - 1) / (2 * tz) - riskFreeRate);
+        } else {
+            // pathwise derivatives of s, scaled by the discounted indicator
+            DT w = itm ? FPTwoMul(discount, sign) : (DT)0;
+            price = itm ? FPTwoMul(discount, diff) : (DT)0;
+            dS0 = w * s / s0;
+            dSigma = w * (sumSx - (mu + sigma * sigma) * sumSt) / (sigma * n);
+            dR = w * sumSt / n - timeLength * price;
+            dT = w * (sumSx + mu * sumSt) / (2 * timeLength * n) - riskFreeRate * price;
+        }
+        out[0] = price;
+        out[1] = dT;
+        out[2] = dR;
+        out[3] = dS0;
+        DT gamma = price * ((z * z - 1) / (sigma * sigma * tz) - z / (sigma * sqrtTz)) / (s0 * s0);
+        if (style == Asian_AP) {
+            // s0 is also a fixing of the average, which adds the cross term of its
+            // explicit derivative with the LRM weight, and the density of the average
+            // at the strike, conditioned on the path after the first step
+            DT w = itm ? FPTwoMul(discount, sign) : (DT)0;
+            gamma += 2 * w * z / (n * s0 * sigma * sqrtTz);
+            DT nK = n * strike - s0;
+            if (nK > 0) {
+                DT b = nK * s1 / (n * s - s0);
+                DT zb = (hls::log(b / s0) - mu * tz) / (sigma * sqrtTz);
+                gamma += discount * FPExp(-0.5 * zb * zb) / (2.5066282746310002 * n * nK * sigma * sqrtTz);
+            }
+        }
+        out[4] = gamma;
+        out[5] = dSigma;
+    }
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT>& sumStrm,
+                 hls::stream<DT>& squareSumStrm) {
+#pragma HLS inline off
+        const unsigned int DEP = 16;
+        DT logS[InN][SampNum];
+#pragma HLS array_partition variable = logS dim = 1
+        // sums over the fixings of Asian_AP
+        DT sumS[InN][SampNum];
+#pragma HLS array_partition variable = sumS dim = 1
+        DT sumSx[InN][SampNum];
+#pragma HLS array_partition variable = sumSx dim = 1
+        DT sumSt[InN][SampNum];
+#pragma HLS array_partition variable = sumSt dim = 1
+        DT z1[InN][SampNum];
+#pragma HLS array_partition variable = z1 dim = 1
+        DT s1[InN][SampNum];
+#pragma HLS array_partition variable = s1 dim = 1
+        // because the latency of ACC_LOOP is 14
+        DT sumBuffer[OutN][DEP];
+#pragma HLS array_partition variable = sumBuffer dim = 1
+        DT squareSumBuffer[OutN][DEP];
+#pragma HLS array_partition variable = squareSumBuffer dim = 1
+    BUFF_INIT_LOOP:
+        for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 1
+            for (int k = 0; k < OutN; ++k) {
+#pragma HLS unroll
+                sumBuffer[k][i] = 0;
+                squareSumBuffer[k][i] = 0;
+            }
+        }
+        ap_uint<4> cnt = 0;
+    ACC_LOOP:
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            DT t = (i + 1) * dt;
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT out[InN][OutN];
+                for (int a = 0; a < InN; ++a) {
+#pragma HLS unroll
+                    DT dlogS = pathStrmIn[a].read();
+                    DT x = (i == 0) ? dlogS : FPTwoAdd(logS[a][j], dlogS);
+                    logS[a][j] = x;
+                    DT s = FPTwoMul(underlying, FPExp(x));
+                    if (style == Asian_AP) {
+                        // the average includes the initial price, as PathPricer<Asian_AP>
+                        DT preS = (i == 0) ? underlying : sumS[a][j];
+                        DT preSx = (i == 0) ? (DT)0 : sumSx[a][j];
+                        DT preSt = (i == 0) ? (DT)0 : sumSt[a][j];
+                        sumS[a][j] = FPTwoAdd(preS, s);
+                        sumSx[a][j] = FPTwoAdd(preSx, FPTwoMul(s, x));
+                        sumSt[a][j] = FPTwoAdd(preSt, FPTwoMul(s, t));
+                        if (i == 0) {
+                            z1[a][j] = (x - mu * dt) / (volatility * hls::sqrt(dt));
+                            s1[a][j] = s;
+                        }
+                        if (i == steps - 1) {
+                            DT n = steps + 1;
+                            greeks(sumS[a][j] / n, z1[a][j], dt, sumSx[a][j], sumSt[a][j], n, s1[a][j], out[a]);
+                        }
+                    } else if (i == steps - 1) {
+                        DT z = (x - mu * t) / (volatility * hls::sqrt(t));
+                        greeks(s, z, t, FPTwoMul(s, x), FPTwoMul(s, t), 1, s, out[a]);
+                    }
+                }
+                if (i == steps - 1) {
+                    for (int k = 0; k < OutN; ++k) {
+#pragma HLS unroll
+                        DT v = out[0][k];
+                        if (WithAntithetic) v = FPTwoMul((DT)0.5, FPTwoAdd(v, out[InN - 1][k]));
+                        DT mulTemp = FPTwoMul(v, v);
+                        sumBuffer[k][cnt] = FPTwoAdd(sumBuffer[k][cnt], v);
+                        squareSumBuffer[k][cnt] = FPTwoAdd(squareSumBuffer[k][cnt], mulTemp);
+                    }
+                    cnt++;
+                }
+            }
+        }
+    POST_ACC_LOOP:
+        for (int k = 0; k < OutN; ++k) {
+            DT sum = 0;
+            DT squareSum = 0;
+            for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 8
+                sum += sumBuffer[k][i];
+                squareSum += squareSumBuffer[k][i];
+            }
+            sumStrm.write(sum);
+            squareSumStrm.write(squareSum);
+        }
+    }
+};
+
+/**
+ * @brief Path pricer for control variates, which writes the price of the option
+ * and the price of a control with a known expectation for each path. It is
+ * used by mcSimulationControlVariate, with Samples First path generators.
+ *
+ * @tparam style option style, European or Asian_AP.
+ * @tparam DT supported data type including double and float data type.
+ * @tparam SampNum number of samples per batch.
+ * @tparam WithAntithetic antithetic is used for variance reduction.
+ */
+template <OptionStyle style, typename DT, int SampNum, bool WithAntithetic>
+class ControlVariatePathPricer {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+
+    ControlVariatePathPricer() {}
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT> priceStrmOut[InN],
+                 hls::stream<DT> ctrlStrmOut[InN]) {
+#ifndef __SYNTHESIS__
+        printf("Option Style is not supported now!\n");
+#endif
+    }
+};
+
+// the control is the discounted price of the underlying at expiry, its
+// expectation is underlying * exp(-dividendYield * timeLength)
+template <typename DT, int SampNum, bool WithAntithetic>
+class ControlVariatePathPricer<European, DT, SampNum, WithAntithetic> {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+
+    DT strike;
+    DT underlying;
+    DT discount;
+    bool optionType;
+
+    ControlVariatePathPricer() {}
+
+    void PE(ap_uint<16> steps,
+            ap_uint<16> paths,
+            hls::stream<DT>& pathStrmIn,
+            hls::stream<DT>& priceStrmOut,
+            hls::stream<DT>& ctrlStrmOut) {
+#pragma HLS inline off
+        DT logS[SampNum];
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+                DT dlogS = pathStrmIn.read();
+                DT x = (i == 0) ? dlogS : FPTwoAdd(logS[j], dlogS);
+                logS[j] = x;
+                if (i == steps - 1) {
+                    DT s = FPTwoMul(underlying, FPExp(x));
+                    DT p1 = optionType ? FPTwoSub(strike, s) : FPTwoSub(s, strike);
+                    priceStrmOut.write(FPTwoMul(discount, MAX(p1, 0)));
+                    ctrlStrmOut.write(FPTwoMul(discount, s));
+                }
+            }
+        }
+    }
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT> priceStrmOut[InN],
+                 hls::stream<DT> ctrlStrmOut[InN]) {
+        for (int i = 0; i < InN; ++i) {
+#pragma HLS unroll
+            PE(steps, paths, pathStrmIn[i], priceStrmOut[i], ctrlStrmOut[i]);
+        }
+    }
+};
+
+// the control is the geometric average price option on the same fixings
+template <typename DT, int SampNum, bool WithAntithetic>
+class ControlVariatePathPricer<Asian_AP, DT, SampNum, WithAntithetic> {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+
+    DT strike;
+    DT underlying;
+    DT discount;
+    bool optionType;
+
+    ControlVariatePathPricer() {}
+
+    void PE(ap_uint<16> steps,
+            ap_uint<16> paths,
+            hls::stream<DT>& pathStrmIn,
+            hls::stream<DT>& priceStrmOut,
+            hls::stream<DT>& ctrlStrmOut) {
+#pragma HLS inline off
+        DT prelogS[SampNum];
+        DT sumlogS[SampNum];
+        DT sumS[SampNum];
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+                DT dlogS = pathStrmIn.read();
+
+                // the average includes the initial price, as PathPricer<Asian_AP>
+                DT tmpprelogS = (i == 0) ? (DT)0 : prelogS[j];
+                DT tmpsumlogS = (i == 0) ? (DT)0 : sumlogS[j];
+                DT tmpsumS = (i == 0) ? (DT)1 : sumS[j];
+
+                DT tmplogS = FPTwoAdd(tmpprelogS, dlogS);
+                prelogS[j] = tmplogS;
+                sumlogS[j] = FPTwoAdd(tmpsumlogS, tmplogS);
+                sumS[j] = FPTwoAdd(tmpsumS, FPExp(tmplogS));
+
+                if (i == steps - 1) {
+                    DT sAP = sumS[j] / (steps + 1) * underlying;
+                    DT sGP = FPExp(sumlogS[j] / (steps + 1)) * underlying;
+                    DT p1 = optionType ? FPTwoSub(strike, sAP) : FPTwoSub(sAP, strike);
+                    DT p2 = optionType ? FPTwoSub(strike, sGP) : FPTwoSub(sGP, strike);
+                    priceStrmOut.write(FPTwoMul(discount, MAX(p1, 0)));
+                    ctrlStrmOut.write(FPTwoMul(discount, MAX(p2, 0)));
+                }
+            }
+        }
+    }
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT> priceStrmOut[InN],
+                 hls::stream<DT> ctrlStrmOut[InN]) {
+        for (int i = 0; i < InN; ++i) {
+#pragma HLS unroll
+            PE(steps, paths, pathStrmIn[i], priceStrmOut[i], ctrlStrmOut[i]);
+        }
+    }
+};
+
 } // namespace internal
 } // namespace fintech
 } // namespace xf
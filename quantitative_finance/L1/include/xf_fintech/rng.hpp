@@ -1556,6 +1556,336 @@ class MT2203IcnRng<float> {
     }
 };
 
+/**
+ * @brief Philox4x32-10 counter-based generator of uniform random numbers.
+ *
+ * Each 128-bit counter is encrypted under a 64-bit key by 10 rounds of multiply and xor, which gives 4 random
+ * numbers. The whole state is the key and the counter, so initialization takes no loop and any position of the
+ * sequence is reached in O(1). Bits 127:64 of the counter select a substream and bits 63:0 the block in it, so
+ * lanes, CUs and cards given distinct substreams never share a random number.
+ *
+ * Reference: Parallel Random Numbers: As Easy as 1, 2, 3, by J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw.
+ */
+class Philox4x32 {
+   private:
+    /// Key of the cipher
+    ap_uint<64> key;
+    /// Substream, bits 127:64 of the counter
+    ap_uint<64> subStream;
+    /// Number of random numbers taken from the substream
+    ap_uint<66> pos;
+    /// Random numbers of block pos / 4
+    ap_uint<32> buff[4];
+
+    void fill() {
+#pragma HLS inline
+        ap_uint<128> ctr;
+        ctr(63, 0) = pos(65, 2);
+        ctr(127, 64) = subStream;
+        ap_uint<128> r = block(ctr, key);
+        for (int i = 0; i < 4; i++) {
+#pragma HLS unroll
+            buff[i] = r(32 * i + 31, 32 * i);
+        }
+    }
+
+   public:
+    /**
+     * @brief encrypt one counter, word i of the result is the i-th random number of the block.
+     *
+     * @param ctr 128-bit counter
+     * @param k 64-bit key
+     * @return 4 random numbers
+     */
+    static ap_uint<128> block(ap_uint<128> ctr, ap_uint<64> k) {
+#pragma HLS inline
+        const ap_uint<32> M0 = 0xD2511F53;
+        const ap_uint<32> M1 = 0xCD9E8D57;
+        const ap_uint<32> W0 = 0x9E3779B9;
+        const ap_uint<32> W1 = 0xBB67AE85;
+        ap_uint<32> c[4];
+#pragma HLS array_partition variable = c complete
+        for (int i = 0; i < 4; i++) {
+#pragma HLS unroll
+            c[i] = ctr(32 * i + 31, 32 * i);
+        }
+        ap_uint<32> k0 = k(31, 0);
+        ap_uint<32> k1 = k(63, 32);
+    PHILOX_ROUND_LOOP:
+        for (int r = 0; r < 10; r++) {
+#pragma HLS unroll
+            ap_uint<64> p0 = M0 * c[0];
+            ap_uint<64> p1 = M1 * c[2];
+            ap_uint<32> n0 = p1(63, 32) ^ c[1] ^ k0;
+            ap_uint<32> n2 = p0(63, 32) ^ c[3] ^ k1;
+            c[0] = n0;
+            c[1] = p1(31, 0);
+            c[2] = n2;
+            c[3] = p0(31, 0);
+            k0 += W0;
+            k1 += W1;
+        }
+        ap_uint<128> out;
+        for (int i = 0; i < 4; i++) {
+#pragma HLS unroll
+            out(32 * i + 31, 32 * i) = c[i];
+        }
+        return out;
+    }
+
+    Philox4x32() { init(0, 0, 0); }
+
+    /**
+     * @brief Constructor with seed
+     *
+     * @param seed substream id
+     */
+    Philox4x32(ap_uint<32> seed) { seedInitialization(seed); }
+
+    /**
+     * @brief initialize with the seed as substream, under key 0, from its start
+     *
+     * @param seed substream id
+     */
+    void seedInitialization(ap_uint<32> seed) { init(0, seed, 0); }
+
+    /**
+     * @brief initialize key, substream and position
+     *
+     * @param k key, generators of different keys are statistically independent
+     * @param stream substream id, each substream holds 2^66 random numbers
+     * @param offset number of random numbers to skip in the substream
+     */
+    void init(ap_uint<64> k, ap_uint<64> stream, ap_uint<64> offset) {
+#pragma HLS inline
+        key = k;
+        subStream = stream;
+        pos = offset;
+        fill();
+    }
+
+    /**
+     * @brief skip the next n random numbers in O(1)
+     *
+     * @param n number of random numbers to skip
+     */
+    void skip(ap_uint<64> n) {
+#pragma HLS inline
+        pos += n;
+        fill();
+    }
+
+    /**
+     * @brief each call of next() generate a uniformly distributed random number
+     *
+     * @return a uniformly distributed random number
+     */
+    ap_ufixed<32, 0> next() {
+#pragma HLS inline
+        if (pos(1, 0) == 0) {
+            fill();
+        }
+        ap_ufixed<32, 0> result;
+        result(31, 0) = buff[pos(1, 0)];
+        pos++;
+        return result;
+    }
+
+    /**
+     * @brief each call of nextTwo() generate two uniformly distributed random numbers
+     * @param result_l first random number
+     * @param result_r second random number
+     */
+    void nextTwo(ap_ufixed<32, 0>& result_l, ap_ufixed<32, 0>& result_r) {
+#pragma HLS inline
+        result_l = next();
+        result_r = next();
+    }
+};
+
+namespace internal {
+// 32-bit uniform moved strictly inside (0, 1), the midpoint of its 2^-32 interval
+inline ap_ufixed<33, 0> openUniform(ap_ufixed<32, 0> u) {
+#pragma HLS inline
+    ap_ufixed<33, 0> tmp = u;
+    tmp[0] = 1;
+    return tmp;
+}
+// the inverse cumulative normal MT19937IcnRng uses for each type
+inline double inverseCumulativeNormal(double u) {
+    return inverseCumulativeNormalAcklam<double>(u);
+}
+inline float inverseCumulativeNormal(float u) {
+    return inverseCumulativeNormalPPND7<float>(u);
+}
+} // namespace internal
+
+/**
+ * @brief Normally distributed random number generator based on Philox4x32-10 and InverseCumulative
+ * function, drop-in for MT19937IcnRng.
+ *
+ * The seed selects a substream. Taking seed lane + UN * (cu + CU_NUM * card) for every lane of every CU and card
+ * makes all random numbers of a run distinct draws of one Philox sequence, reproducible on any number of cards.
+ *
+ * @tparam mType data type supported including float and double
+ */
+template <typename mType>
+class PhiloxIcnRng {
+   public:
+    Philox4x32 uniformRNG;
+
+    PhiloxIcnRng() {}
+
+    /**
+     * @brief Constructor with seed
+     *
+     * @param seed substream id
+     */
+    PhiloxIcnRng(ap_uint<32> seed) : uniformRNG(seed) {}
+
+    /**
+     * @brief Initialization using seed
+     *
+     * @param seed substream id
+     */
+    void seedInitialization(ap_uint<32> seed) { uniformRNG.seedInitialization(seed); }
+
+    /**
+     * @brief Initialization of key, substream and position
+     *
+     * @param key key of the cipher
+     * @param stream substream id
+     * @param offset number of random numbers to skip in the substream
+     */
+    void init(ap_uint<64> key, ap_uint<64> stream, ap_uint<64> offset) { uniformRNG.init(key, stream, offset); }
+
+    /**
+     * @brief skip the next n random numbers in O(1)
+     *
+     * @param n number of random numbers to skip
+     */
+    void skip(ap_uint<64> n) { uniformRNG.skip(n); }
+
+    /**
+     * @brief Get next normally distributed random number
+     *
+     * @return a normally distributed random number
+     */
+    mType next() {
+#pragma HLS inline
+        mType tmp_uniform = internal::openUniform(uniformRNG.next());
+        return internal::inverseCumulativeNormal(tmp_uniform);
+    }
+
+    /**
+     * @brief Get next uniformly distributed random number
+     *
+     * @param uniformR return uniformly distributed random number
+     */
+    void next(mType& uniformR) {
+#pragma HLS inline
+        uniformR = internal::openUniform(uniformRNG.next());
+    }
+
+    /**
+     * @brief Get next normally distributed random number and its corresponding
+     * uniformly distributed random number
+     *
+     * @param uniformR return uniformly distributed random number that
+     * corrresponding to gaussianR
+     * @param gaussianR return normally distributed random number
+     */
+    void next(mType& uniformR, mType& gaussianR) {
+#pragma HLS inline
+        mType tmp_uniform = internal::openUniform(uniformRNG.next());
+        uniformR = tmp_uniform;
+        gaussianR = internal::inverseCumulativeNormal(tmp_uniform);
+    }
+
+    /**
+     * @brief Get next two normally distributed random numbers
+     *
+     * @param gaussR return first normally distributed random number.
+     * @param gaussL return second normally distributed random number.
+     */
+    void nextTwo(mType& gaussR, mType& gaussL) {
+#pragma HLS inline
+        ap_ufixed<32, 0> unifR, unifL;
+        uniformRNG.nextTwo(unifR, unifL);
+        mType tmpR = internal::openUniform(unifR);
+        mType tmpL = internal::openUniform(unifL);
+        gaussR = internal::inverseCumulativeNormal(tmpR);
+        gaussL = internal::inverseCumulativeNormal(tmpL);
+    }
+};
+
+/**
+ * @brief Normally distributed random number generator based on Philox4x32-10 and Box-Muller
+ * Transformation, each pair of uniforms gives two normals.
+ *
+ * @tparam mType data type supported including float and double
+ */
+template <typename mType>
+class PhiloxBoxMullerNormalRng {
+   public:
+    Philox4x32 uniformRNG;
+    mType z1, z2;
+    ap_uint<1> is_odd;
+
+    PhiloxBoxMullerNormalRng() { is_odd = 0; }
+
+    /**
+     * @brief Constructor with seed
+     *
+     * @param seed substream id
+     */
+    PhiloxBoxMullerNormalRng(ap_uint<32> seed) : uniformRNG(seed) { is_odd = 0; }
+
+    /**
+     * @brief Initialization using seed
+     *
+     * @param seed substream id
+     */
+    void seedInitialization(ap_uint<32> seed) {
+        uniformRNG.seedInitialization(seed);
+        is_odd = 0;
+    }
+
+    /**
+     * @brief Initialization of key, substream and position
+     *
+     * @param key key of the cipher
+     * @param stream substream id
+     * @param offset number of uniforms to skip in the substream, two per pair of normals
+     */
+    void init(ap_uint<64> key, ap_uint<64> stream, ap_uint<64> offset) {
+        uniformRNG.init(key, stream, offset);
+        is_odd = 0;
+    }
+
+    /**
+     * @brief Get next normally distributed random number
+     * @return a normally distributed random number
+     */
+    mType next() {
+#pragma HLS inline
+        mType ztmp;
+        if (is_odd) {
+            is_odd = 0;
+            ztmp = z2;
+        } else {
+            ap_ufixed<32, 0> unifR, unifL;
+            uniformRNG.nextTwo(unifR, unifL);
+            mType u1 = internal::openUniform(unifR);
+            mType u2 = internal::openUniform(unifL);
+            boxMullerTransform(u1, u2, z1, z2);
+            is_odd = 1;
+            ztmp = z1;
+        }
+        return ztmp;
+    }
+};
+
 /**
  * @brief Multi-variate normal distribution RNG.
  *
@@ -22,7 +22,10 @@
 #define XF_FINTECH_RNG_SEQ_H
 #include "ap_int.h"
 #include "hls_stream.h"
+#include "xf_fintech/brownian_bridge.hpp"
 #include "xf_fintech/corrand.hpp"
+#include "xf_fintech/rng.hpp"
+#include "xf_fintech/sobol_rsg.hpp"
 #ifndef __SYNTHESIS__
 #include <assert.h>
 #endif
@@ -176,6 +179,192 @@ class RNGSequence_Heston_QuadraticExponential {
     }
 };
 
+/**
+ * @brief Quasi-random sequence. Each path is one Sobol point; its dimensions
+ * are turned to normals and assembled by one Brownian bridge per factor, so
+ * the first and best dimensions decide the coarse shape of the paths.
+ *
+ * With Randomized, every dimension is XORed with a 32-bit digital shift drawn
+ * from Philox4x32 on substream seed[0], so the lanes are independent
+ * randomizations of the same point set and the spread of their means is the
+ * error estimate, see mcSimulation. Otherwise seed is not used: lane i of
+ * laneNum takes every laneNum-th block of SampNum points starting with block
+ * i, so the lanes together use the first points of the sequence, none twice.
+ *
+ * Without StepFirst, the points of a whole call are buffered, DIM * SampNum
+ * values, so keep SampNum small for large DIM.
+ *
+ * @tparam DT supported data type including double and float.
+ * @tparam DIM dimension of Sobol points, at least steps * FN, maximum is 128.
+ * @tparam SampNum number of paths of one call, the block of points of a lane.
+ * @tparam FN number of normal factors per time step.
+ * @tparam StepFirst output order of the path generator, true for all steps of a path first.
+ * @tparam Randomized digital shift enabled or not.
+ * @tparam WithUniform append a stream with the uniform of the last factor, for Heston QE scheme.
+ */
+template <typename DT, int DIM, int SampNum, int FN, bool StepFirst, bool Randomized, bool WithUniform = false>
+class SobolBridgeSequence {
+   public:
+    const static unsigned int OutN = WithUniform ? FN + 1 : FN;
+    const static int MaxSteps = DIM / FN;
+    ap_uint<32> seed[FN];
+    // Constructor
+    SobolBridgeSequence(){};
+
+    void Init(SobolRsg<DIM> rngInst[1]) { Init(rngInst, 0, 1); }
+
+    /**
+     * @brief initialization as one of laneNum lanes, see the class
+     * description for the points each lane takes.
+     */
+    void Init(SobolRsg<DIM> rngInst[1], ap_uint<16> lane, ap_uint<16> laneNum) {
+#pragma HLS array_partition variable = shift dim = 0
+        rngInst[0].initialization();
+        laneId = lane;
+        laneCnt = laneNum;
+        block = 0;
+        if (Randomized) {
+            Philox4x32 shiftRng(seed[0]);
+            for (int d = 0; d < DIM; d++) {
+#pragma HLS pipeline II = 1
+                ap_ufixed<32, 0> u = shiftRng.next();
+                shift[d] = u(31, 0);
+            }
+        } else {
+            for (int d = 0; d < DIM; d++) {
+#pragma HLS unroll
+                shift[d] = 0;
+            }
+        }
+    }
+
+    void NextSeq(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 SobolRsg<DIM> rngInst[1],
+                 hls::stream<DT> randNumberStrmOut[OutN]) {
+#pragma HLS inline off
+#ifndef __SYNTHESIS__
+        assert(steps * FN <= DIM);
+#endif
+        if (!Randomized) {
+            // the origin maps to -inf, blocks start after it
+            rngInst[0].skipTo(1 + (block * laneCnt + laneId) * SampNum);
+            block++;
+        }
+        bridge.initialize(steps);
+        DT z[FN][MaxSteps];
+#pragma HLS array_partition variable = z dim = 1
+        if (StepFirst) {
+            for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+                nextPath(steps, rngInst[0], z);
+                for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+                    write(z, j, randNumberStrmOut);
+                }
+            }
+        } else {
+            // step-major output needs the whole batch
+            DT buff[FN][MaxSteps][SampNum];
+#pragma HLS array_partition variable = buff dim = 1
+            for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+                nextPath(steps, rngInst[0], z);
+                for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+                    for (int f = 0; f < FN; f++) {
+#pragma HLS unroll
+                        buff[f][j][i] = z[f][j];
+                    }
+                }
+            }
+            for (int j = 0; j < steps; ++j) {
+#pragma HLS loop_tripcount min = 8 max = 8
+                for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+                    DT zs[FN][1];
+                    for (int f = 0; f < FN; f++) {
+#pragma HLS unroll
+                        zs[f][0] = buff[f][j][i];
+                    }
+                    write(zs, 0, randNumberStrmOut);
+                }
+            }
+        }
+    }
+
+   private:
+    ap_uint<32> shift[DIM];
+    ap_uint<16> laneId;
+    ap_uint<16> laneCnt;
+    ap_uint<32> block;
+    BrownianBridge<DT, MaxSteps> bridge;
+
+    // dimension j * FN + f drives the j-th bridge point of factor f
+    void nextPath(ap_uint<16> steps, SobolRsg<DIM>& rng, DT z[FN][MaxSteps]) {
+        ap_ufixed<32, 0> pt[DIM];
+#pragma HLS array_partition variable = pt dim = 0
+        rng.next(pt);
+        for (int f = 0; f < FN; f++) {
+            hls::stream<DT> inStrm;
+#pragma HLS stream variable = inStrm depth = MaxSteps
+            hls::stream<DT> outStrm;
+#pragma HLS stream variable = outStrm depth = MaxSteps
+            for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+                int d = j * FN + f;
+                ap_ufixed<32, 0> u;
+                u(31, 0) = pt[d](31, 0) ^ shift[d];
+                DT uniform = internal::openUniform(u);
+                inStrm.write(internal::inverseCumulativeNormal(uniform));
+            }
+            bridge.transform(inStrm, outStrm);
+            for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+                z[f][j] = outStrm.read();
+            }
+        }
+    }
+
+    template <int N>
+    void write(DT z[FN][N], int j, hls::stream<DT> randNumberStrmOut[OutN]) {
+#pragma HLS inline
+        for (int f = 0; f < FN; f++) {
+#pragma HLS unroll
+            randNumberStrmOut[f].write(z[f][j]);
+        }
+        if (WithUniform) randNumberStrmOut[FN].write(CumulativeNormal(z[FN - 1][j]));
+    }
+};
+
+// initializes the sequence of one of laneNum lanes, only the Sobol sequence needs to know which
+template <typename RNGSeqT, typename RNG>
+void initLane(RNGSeqT& rngSeq, RNG* rngInst, ap_uint<16> lane, ap_uint<16> laneNum) {
+    rngSeq.Init(rngInst);
+}
+template <typename DT, int DIM, int SampNum, int FN, bool StepFirst, bool Randomized, bool WithUniform>
+void initLane(SobolBridgeSequence<DT, DIM, SampNum, FN, StepFirst, Randomized, WithUniform>& rngSeq,
+              SobolRsg<DIM>* rngInst,
+              ap_uint<16> lane,
+              ap_uint<16> laneNum) {
+    rngSeq.Init(rngInst, lane, laneNum);
+}
+
+// lanes are independent replicas of the same estimator, only for randomized Sobol points
+template <typename RNGSeqT>
+struct LaneReplicas {
+    const static bool value = false;
+};
+template <typename DT, int DIM, int SampNum, int FN, bool StepFirst, bool WithUniform>
+struct LaneReplicas<SobolBridgeSequence<DT, DIM, SampNum, FN, StepFirst, true, WithUniform> > {
+    const static bool value = true;
+};
+
 template <typename DT, typename RNG, int SampleNum, int ASSETS, bool Antithetic>
 class CORRAND_2_Sequence;
 
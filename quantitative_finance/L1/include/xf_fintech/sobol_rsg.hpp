@@ -310,6 +310,46 @@ class SobolRsg {
         }
         addr++;
     }
+
+    /**
+     * @brief move to the n-th point, so the next call of next() outputs it.
+     * All direction numbers are completed here, so the jump costs W steps
+     * whatever n is.
+     *
+     * @param n index of the next point, 0 is the origin
+     */
+    void skipTo(ap_uint<W> n) {
+        ap_uint<8> id;
+        ap_uint<6> j;
+    DIRECTION_LOOP:
+        for (j = 1; j < W; j++) {
+#pragma HLS pipeline
+            v[0][j] = (ap_uint<W>)1 << (W - j - 1);
+            for (id = 1; id < DIM; id++) {
+#pragma HLS unroll
+                if (j > c_init[id]) {
+                    ap_uint<W> v_now = v[id][j - s[id]];
+                    v_now ^= v_now >> s[id];
+                    for (ap_uint<4> i = 1; i < s[id]; i++) {
+                        if ((a[id] >> (s[id] - 1 - i)) & 1) v_now ^= v[id][j - i];
+                    }
+                    v[id][j] = v_now;
+                }
+            }
+        }
+        // point n - 1 is the XOR of direction numbers picked by its gray code
+        ap_uint<W> gray = n == 0 ? (ap_uint<W>)0 : (ap_uint<W>)((n - 1) ^ ((n - 1) >> 1));
+        for (id = 0; id < DIM; id++) {
+#pragma HLS unroll
+            ap_uint<W> x = 0;
+            for (j = 0; j < W; j++) {
+#pragma HLS unroll
+                if (gray[j]) x ^= v[id][j];
+            }
+            last_seqOut[id] = x;
+        }
+        addr = n;
+    }
 };
 
 /**
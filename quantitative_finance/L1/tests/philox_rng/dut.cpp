@@ -0,0 +1,65 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file dut.cpp
+ *
+ * @brief This file contains top function of test case.
+ */
+
+#include <ap_int.h>
+#include "xf_fintech/rng.hpp"
+#include "dut.hpp"
+
+/**
+ * @brief test function for Philox RNG
+ *
+ * @param num number of samples
+ * @param seed substream of the generators
+ * @param offset position the skipped generator jumps to
+ * @param outputIcn normal samples of PhiloxIcnRng
+ * @param outputBoxMuller normal samples of PhiloxBoxMullerNormalRng
+ * @param outputSkip uniform samples of Philox4x32 from offset
+ */
+extern "C" void dut(const int num,
+                    ap_uint<32> seed,
+                    ap_uint<32> offset,
+                    double outputIcn[SAMPLE_NUM],
+                    double outputBoxMuller[SAMPLE_NUM],
+                    ap_uint<32> outputSkip[SAMPLE_NUM]) {
+    xf::fintech::PhiloxIcnRng<double> rngIcn;
+    xf::fintech::PhiloxBoxMullerNormalRng<double> rngBoxMuller;
+    xf::fintech::Philox4x32 rngSkip;
+
+    rngIcn.seedInitialization(seed);
+    rngBoxMuller.seedInitialization(seed);
+    rngSkip.seedInitialization(seed);
+    rngSkip.skip(offset);
+
+    for (int i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        outputIcn[i] = rngIcn.next();
+    }
+    for (int i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        outputBoxMuller[i] = rngBoxMuller.next();
+    }
+    for (int i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        ap_ufixed<32, 0> u = rngSkip.next();
+        outputSkip[i] = u(31, 0);
+    }
+}
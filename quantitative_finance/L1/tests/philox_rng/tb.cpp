@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ap_int.h>
+#include <math.h>
+#include <iostream>
+#include "xf_fintech/rng.hpp"
+#include "dut.hpp"
+
+extern "C" void dut(const int num,
+                    ap_uint<32> seed,
+                    ap_uint<32> offset,
+                    double outputIcn[SAMPLE_NUM],
+                    double outputBoxMuller[SAMPLE_NUM],
+                    ap_uint<32> outputSkip[SAMPLE_NUM]);
+
+// known answers of Philox4x32-10 from Random123: counter, key, result, lowest word first
+const unsigned int kat[3][10] = {
+    {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+     0x9b00dbd8},
+    {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+     0x6d5451fd},
+    {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0, 0xd16cfe09, 0x94fdcceb, 0x5001e420,
+     0x24126ea1}};
+
+int check(const char* name, double* data, int sampleNum) {
+    double avg = 0;
+    double sd = 0;
+    for (int i = 0; i < sampleNum; i++) {
+        avg += data[i];
+    }
+    avg /= sampleNum;
+    for (int i = 0; i < sampleNum; i++) {
+        sd += (data[i] - avg) * (data[i] - avg);
+    }
+    sd = sqrt(sd / (sampleNum - 1));
+    std::cout << "Average of " << sampleNum << " " << name << " samples: " << avg << std::endl;
+    std::cout << "Standard Deviation of " << sampleNum << " " << name << " samples: " << sd << std::endl;
+    // three sigma of the sample mean, and of the sample standard deviation
+    if (fabs(avg) > 3 * sqrt(1.0 / sampleNum) || fabs(sd - 1) > 3 * sqrt(0.5 / sampleNum)) {
+        std::cout << name << " samples are out of three sigma" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    const int sampleNum = SAMPLE_NUM;
+    const ap_uint<32> seed = 42;
+    const ap_uint<32> offset = 1001;
+    int nerror = 0;
+
+    for (int t = 0; t < 3; t++) {
+        ap_uint<128> ctr;
+        ap_uint<64> key;
+        for (int i = 0; i < 4; i++) ctr(32 * i + 31, 32 * i) = kat[t][i];
+        key(31, 0) = kat[t][4];
+        key(63, 32) = kat[t][5];
+        ap_uint<128> r = xf::fintech::Philox4x32::block(ctr, key);
+        for (int i = 0; i < 4; i++) {
+            if (r(32 * i + 31, 32 * i) != kat[t][6 + i]) {
+                std::cout << "Known answer " << t << " word " << i << " mismatch" << std::endl;
+                nerror++;
+            }
+        }
+    }
+
+    double resultIcn[sampleNum];
+    double resultBoxMuller[sampleNum];
+    ap_uint<32> resultSkip[sampleNum];
+
+    dut(sampleNum, seed, offset, resultIcn, resultBoxMuller, resultSkip);
+
+    // skip-ahead must land on the same numbers as stepping
+    xf::fintech::Philox4x32 golden(seed);
+    for (int i = 0; i < offset; i++) golden.next();
+    for (int i = 0; i < sampleNum; i++) {
+        ap_ufixed<32, 0> u = golden.next();
+        if (resultSkip[i] != u(31, 0)) {
+            if (nerror < 10) std::cout << "Skip sample " << i << " mismatch" << std::endl;
+            nerror++;
+        }
+    }
+
+    nerror += check("PhiloxIcnRng", resultIcn, sampleNum);
+    nerror += check("PhiloxBoxMullerNormalRng", resultBoxMuller, sampleNum);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS" << std::endl;
+    }
+    return nerror;
+}
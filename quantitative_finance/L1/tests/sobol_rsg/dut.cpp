@@ -74,3 +74,24 @@ Copy_Loop_nd:
         out_strm.write(b);
     }
 }
+
+/**
+ * @brief test function of sobol sequence generator jumping to a point.
+ *
+ * @param num_of_rand is number of random number skipped, plus one.
+ * @param out_strm the stream of output result.
+ *
+ **/
+void dut_skip(const int num_of_rand, hls::stream<ap_ufixed<32, 0> >& out_strm) {
+    ap_ufixed<32, 0> result[NDIM];
+
+    xf::fintech::SobolRsg<NDIM> ssg_nd;
+    ssg_nd.initialization();
+    ssg_nd.skipTo(num_of_rand - 1);
+    ssg_nd.next(result);
+Copy_Loop_skip:
+    for (int j = 0; j < NDIM; j++) {
+#pragma HLS pipeline II = 1
+        out_strm.write(result[j]);
+    }
+}
@@ -58,15 +58,40 @@ DT phi(DT xin) {
     DT a5 = 1.061405429f;
     DT p = 0.3275911f;
 
-    // Save the sign of x
-    DT sign = (xin < 0.0f) ? -1.0f : 1.0f;
     DT x = SQRT2_RECIP * hls::fabsf(xin);
 
-    // A&S formula
+    // A&S formula, evaluated as the tail 0.5 * erfc(|x|) so that negative
+    // arguments do not lose precision to cancellation
     DT t = 1.0f / (1.0f + p * x);
-    DT y = 1.0f - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * hls::expf(-x * x);
+    DT tail = 0.5f * (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * hls::expf(-x * x);
 
-    return 0.5f * (1.0f + sign * y);
+    return (xin < 0.0f) ? tail : 1.0f - tail;
+}
+
+/// @brief Normalised Black call price and its first two derivatives
+///
+/// Evaluates b(x, w) = exp(x/2) N(x/w + w/2) - exp(-x/2) N(x/w - w/2), the
+/// undiscounted call price divided by sqrt(F K), as a function of the total
+/// volatility w = v * sqrt(t) for log-moneyness x = log(F / K).
+///
+/// @tparam DT Data Type used for this function
+/// @param[in]  x   log-moneyness
+/// @param[in]  w   total volatility
+/// @param[out] b   normalised price
+/// @param[out] db  first derivative with respect to w (normalised vega)
+/// @param[out] d2b second derivative with respect to w (normalised vomma)
+template <typename DT>
+void blackNormalised(DT x, DT w, DT* b, DT* db, DT* d2b) {
+    DT h = x / w;
+    DT d1 = h + 0.5f * w;
+    DT d2 = h - 0.5f * w;
+    DT exp_x2 = hls::expf(0.5f * x);
+    DT exp_x2n = 1.0f / exp_x2;
+    DT vega = exp_x2 * SQRT_2PI_RECIP * hls::expf(-0.5f * d1 * d1);
+
+    *b = exp_x2 * phi<DT>(d1) - exp_x2n * phi<DT>(d2);
+    *db = vega;
+    *d2b = vega * d1 * d2 / w;
 }
 }
 /// @brief Single option price plus associated Greeks
@@ -161,6 +186,132 @@ void cfBSMEngine(DT s,
     *gamma = gamma_temp;
     *vega = vega_temp;
 }
+
+/// @brief Implied volatility of a single option
+///
+/// Inverts the BSM formula of cfBSMEngine for the volatility.  The problem is
+/// reduced to the normalised Black price of the out-of-the-money option, split
+/// at the inflection point w = sqrt(2|x|) of the price as a function of total
+/// volatility (as in Jaeckel's "Let's be rational").  Each branch starts from a
+/// closed-form guess: below the inflection point log(price) is modelled as
+/// linear in 1/w^2 with value and slope matched at the inflection point, above
+/// it the Corrado-Miller formula is used.  A fixed number of Halley steps then
+/// polishes the guess, on the logarithm of the price for the lower branch and
+/// on the price itself for the upper branch.  The fixed iteration count keeps
+/// the function free of data-dependent loops so that it can be fully unrolled
+/// and pipelined at II=1.
+///
+/// Black-76 options on a forward f are priced by passing s = f and q = r.
+///
+/// @tparam DT Data Type used for this function
+/// @tparam ITERATIONS Number of Halley steps applied to the initial guess
+/// @param[in]  price call/put premium
+/// @param[in]  s     underlying
+/// @param[in]  r     risk-free rate (decimal form)
+/// @param[in]  t     time to maturity
+/// @param[in]  k     strike price
+/// @param[in]  q     continuous dividend yield rate
+/// @param[in]  call  control whether price is a call or put premium
+/// @return implied volatility (decimal form), 0 if price is not above the
+/// intrinsic value
+template <typename DT, unsigned int ITERATIONS = 3>
+DT cfBSMImpliedVolEngine(DT price, DT s, DT r, DT t, DT k, DT q, unsigned int call) {
+    const DT w_min = 1.0e-4f;
+    const DT w_max = 8.0f;
+
+    // Move to forward terms and normalise by sqrt(F K)
+    DT sqrt_t = hls::sqrtf(t);
+    DT fwd = s * hls::expf((r - q) * t);
+    DT sqrt_fk = hls::sqrtf(fwd * k);
+    DT x = hls::logf(fwd / k);
+    DT exp_x2 = hls::expf(0.5f * x);
+    DT exp_x2n = 1.0f / exp_x2;
+    DT beta = price * hls::expf(r * t) / sqrt_fk;
+
+    // Use put-call parity to work on the out-of-the-money option, which by
+    // symmetry is the call with x = -|x|
+    DT parity = exp_x2 - exp_x2n;
+    bool itm = call ? (x > 0.0f) : (x < 0.0f);
+    if (itm) {
+        beta = call ? beta - parity : beta + parity;
+    }
+    x = -hls::fabsf(x);
+    DT exp_x2_otm = (exp_x2 < exp_x2n) ? exp_x2 : exp_x2n;
+    exp_x2n = (exp_x2 < exp_x2n) ? exp_x2n : exp_x2;
+    exp_x2 = exp_x2_otm;
+
+    // Split the domain at the inflection point of b(w)
+    DT w_c = hls::sqrtf(-2.0f * x);
+    w_c = (w_c > w_min) ? w_c : w_min;
+    DT b_c, db_c, d2b_c;
+    internal::blackNormalised<DT>(x, w_c, &b_c, &db_c, &d2b_c);
+    bool lower = beta < b_c;
+
+    // Lower branch: model log(b) as linear in 1/w^2, matching value and slope
+    // at the inflection point
+    DT log_beta = hls::logf(beta);
+    DT kappa = db_c * w_c * w_c * w_c / (b_c * x * x);
+    DT w_l_sq_recip = 1.0f / (w_c * w_c) - 2.0f * (log_beta - hls::logf(b_c)) / (kappa * x * x);
+    DT w_l = 1.0f / hls::sqrtf(w_l_sq_recip);
+
+    // Upper branch: Corrado-Miller
+    DT half_diff = 0.5f * (exp_x2 - exp_x2n);
+    DT c_adj = beta - half_diff;
+    DT disc = c_adj * c_adj - 4.0f * half_diff * half_diff / PI;
+    disc = (disc > 0.0f) ? disc : 0.0f;
+    DT w_u = SQRT_2PI / (exp_x2 + exp_x2n) * (c_adj + hls::sqrtf(disc));
+    w_u = (w_u > w_c) ? w_u : w_c;
+
+    DT w = lower ? w_l : w_u;
+
+// Halley refinement
+halley_loop:
+    for (unsigned int i = 0; i < ITERATIONS; i++) {
+#pragma HLS UNROLL
+        DT b, db, d2b;
+        internal::blackNormalised<DT>(x, w, &b, &db, &d2b);
+
+        // g(w) = log(b) - log(beta) on the lower branch, b - beta above
+        DT g, dg, d2g;
+        if (lower) {
+            DT db_b = db / b;
+            g = hls::logf(b) - log_beta;
+            dg = db_b;
+            d2g = d2b / b - db_b * db_b;
+        } else {
+            g = b - beta;
+            dg = db;
+            d2g = d2b;
+        }
+
+        DT newton = g / dg;
+        w = w - newton / (1.0f - 0.5f * newton * d2g / dg);
+        w = (w < w_min) ? w_min : ((w > w_max) ? w_max : w);
+    }
+
+    DT vol = w / sqrt_t;
+    return (beta > 0.0f) ? vol : 0.0f;
+}
+
+/// @brief Implied volatility of a single Black-76 option
+///
+/// Convenience wrapper around cfBSMImpliedVolEngine for options on a forward
+/// or future, discounted at the risk-free rate.
+///
+/// @tparam DT Data Type used for this function
+/// @tparam ITERATIONS Number of Halley steps applied to the initial guess
+/// @param[in]  price call/put premium
+/// @param[in]  f     forward price
+/// @param[in]  r     risk-free rate (decimal form)
+/// @param[in]  t     time to maturity
+/// @param[in]  k     strike price
+/// @param[in]  call  control whether price is a call or put premium
+/// @return implied volatility (decimal form), 0 if price is not above the
+/// intrinsic value
+template <typename DT, unsigned int ITERATIONS = 3>
+DT cfB76ImpliedVolEngine(DT price, DT f, DT r, DT t, DT k, unsigned int call) {
+    return cfBSMImpliedVolEngine<DT, ITERATIONS>(price, f, r, t, k, r, call);
+}
 }
 } // xf::fintech
 
@@ -31,6 +31,125 @@ namespace fintech {
 
 using namespace internal;
 #define MAX_SAMPLE 134217727
+/**
+ * @brief Normal RNG used by the Monte Carlo engines below. MT19937 by default,
+ * Philox4x32-10 when XF_FINTECH_MC_PHILOX is defined. With Philox, the seed of
+ * each RNG is its substream id, so giving lane i of CU c on card k the seed
+ * (k * CU_NUM + c) * UN + i keeps all lanes of all cards non-overlapping.
+ *
+ * @tparam DT supported data type including double and float.
+ */
+template <typename DT>
+struct MCEngineRng {
+#ifdef XF_FINTECH_MC_PHILOX
+    typedef PhiloxIcnRng<DT> type;
+#else
+    typedef MT19937IcnRng<DT> type;
+#endif
+};
+
+/**
+ * @brief RNG and random sequence of an engine. Pseudo-random numbers by
+ * default; with QmcDim > 0, Sobol points of QmcDim dimensions assembled into
+ * paths by Brownian bridges, see SobolBridgeSequence.
+ *
+ * @tparam DT supported data type including double and float.
+ * @tparam FN number of normal factors per time step, 1 or 2.
+ * @tparam SN number of paths of one call.
+ * @tparam SF step first or not, the order the path generator reads.
+ * @tparam QmcDim dimension of Sobol points, 0 for pseudo-random numbers.
+ * @tparam QmcShift digital shift of Sobol points enabled or not.
+ * @tparam WithUniform uniform of the second factor output too, for Heston QE scheme.
+ */
+template <typename DT, int FN, int SN, bool SF, int QmcDim, bool QmcShift, bool WithUniform = false>
+struct MCEngineSequence {
+    typedef SobolRsg<QmcDim> RNG;
+    typedef SobolBridgeSequence<DT, QmcDim, SN, FN, SF, QmcShift, WithUniform> type;
+};
+template <typename DT, int SN, bool SF, bool QmcShift>
+struct MCEngineSequence<DT, 1, SN, SF, 0, QmcShift, false> {
+    typedef typename MCEngineRng<DT>::type RNG;
+    typedef RNGSequence<DT, RNG> type;
+};
+template <typename DT, int SN, bool SF, bool QmcShift>
+struct MCEngineSequence<DT, 2, SN, SF, 0, QmcShift, false> {
+    typedef typename MCEngineRng<DT>::type RNG;
+    typedef RNGSequence_2<DT, RNG> type;
+};
+template <typename DT, int SN, bool SF, bool QmcShift>
+struct MCEngineSequence<DT, 2, SN, SF, 0, QmcShift, true> {
+    typedef typename MCEngineRng<DT>::type RNG;
+    typedef RNGSequence_Heston_QuadraticExponential<DT, RNG> type;
+};
+
+#ifndef XF_FINTECH_MC_QMC_BUFF
+#define XF_FINTECH_MC_QMC_BUFF 8192
+#endif
+/**
+ * @brief Number of paths of one call of an engine. The Sobol sequence buffers
+ * all QmcDim values of every path of a call when the path generator reads
+ * sample first, so SN is cut until that buffer holds at most
+ * XF_FINTECH_MC_QMC_BUFF values per lane.
+ *
+ * @tparam SN number of paths of one call without the cut.
+ * @tparam SF step first or not, the order the path generator reads.
+ * @tparam QmcDim dimension of Sobol points, 0 for pseudo-random numbers.
+ */
+template <int SN, bool SF, int QmcDim>
+struct MCEngineSampNum {
+    const static int value =
+        (SF || QmcDim == 0 || QmcDim * SN <= XF_FINTECH_MC_QMC_BUFF) ? SN : XF_FINTECH_MC_QMC_BUFF / QmcDim;
+};
+/**
+ * @brief Path pricer and simulation of MCEuropeanEngine, the payoff alone,
+ * step first, or with the discounted price of the underlying at expiry as
+ * control variate, sample first.
+ *
+ * @tparam DT supported data type including double and float.
+ * @tparam SN number of paths of one call.
+ * @tparam Antithetic antithetic paths enabled or not.
+ * @tparam ControlVariate control variate enabled or not.
+ */
+template <typename DT, int SN, bool Antithetic, bool ControlVariate>
+struct MCEuropeanSimulation {
+    const static bool SF = true;
+    typedef BSPathGenerator<DT, SF, SN, Antithetic> PathGeneratorT;
+    typedef PathPricer<European, DT, SF, SN, Antithetic> PathPricerT;
+
+    // controlMean is not used without control variate
+    template <typename RNG, typename RNGSeqT, int UN>
+    static DT run(unsigned int timeSteps,
+                  unsigned int maxSamples,
+                  unsigned int requiredSamples,
+                  DT requiredTolerance,
+                  DT controlMean,
+                  PathGeneratorT pathGenInst[UN][1],
+                  PathPricerT pathPriInst[UN][1],
+                  RNGSeqT rngSeqInst[UN][1]) {
+        return mcSimulation<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, UN, 1, SN>(
+            timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst, pathPriInst, rngSeqInst);
+    }
+};
+template <typename DT, int SN, bool Antithetic>
+struct MCEuropeanSimulation<DT, SN, Antithetic, true> {
+    const static bool SF = false;
+    typedef BSPathGenerator<DT, SF, SN, Antithetic> PathGeneratorT;
+    typedef ControlVariatePathPricer<European, DT, SN, Antithetic> PathPricerT;
+
+    template <typename RNG, typename RNGSeqT, int UN>
+    static DT run(unsigned int timeSteps,
+                  unsigned int maxSamples,
+                  unsigned int requiredSamples,
+                  DT requiredTolerance,
+                  DT controlMean,
+                  PathGeneratorT pathGenInst[UN][1],
+                  PathPricerT pathPriInst[UN][1],
+                  RNGSeqT rngSeqInst[UN][1]) {
+        return mcSimulationControlVariate<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, UN, 1, SN>(
+            timeSteps, maxSamples, requiredSamples, requiredTolerance, controlMean, pathGenInst, pathPriInst,
+            rngSeqInst);
+    }
+};
 /**
  * @brief European Option Pricing Engine using Monte Carlo Method. This
  * implementation uses Black-Scholes valuation model.
@@ -41,6 +160,12 @@ using namespace internal;
  * latency and resources utilization, default 10.
  * @tparam Antithetic antithetic is used  for variance reduction, default this
  * feature is disabled.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
+ * @tparam ControlVariate the discounted price of the underlying at expiry is
+ * used as control variate, with an estimated beta, default disabled.
  * @param underlying intial value of underlying asset at time 0.
  * @param volatility fixed volatility of underlying asset.
  * @param dividendYield the constant dividend rate for continuous dividends.
@@ -61,7 +186,12 @@ using namespace internal;
  * @param maxSamples the maximum sample number. When reaching it, the simulation
  * will stop, default 2,147,483,648.
  */
-template <typename DT = double, int UN = 10, bool Antithetic = false>
+template <typename DT = double,
+          int UN = 10,
+          bool Antithetic = false,
+          int QmcDim = 0,
+          bool QmcShift = true,
+          bool ControlVariate = false>
 void MCEuropeanEngine(DT underlying,
                       DT volatility,
                       DT dividendYield,
@@ -75,36 +205,35 @@ void MCEuropeanEngine(DT underlying,
                       unsigned int requiredSamples = 1024,
                       unsigned int timeSteps = 100,
                       unsigned int maxSamples = MAX_SAMPLE) {
-    // number of samples per simulation
-    const static int SN = 1024;
+    // Step first or sample first for each simulation, the control variate
+    // path pricer works on samples first
+    const static bool SF = !ControlVariate;
 
-    // number of variate
-    const static int VN = 1;
-
-    // Step first or sample first for each simulation
-    const static bool SF = true;
+    // number of samples per simulation
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value;
 
-    // option style
-    const OptionStyle sty = European;
+    // path generator, path pricer and simulation, with or without control variate
+    typedef MCEuropeanSimulation<DT, SN, Antithetic, ControlVariate> SimT;
 
     // antithetic enable or not
     // const static bool Antithetic = false;
 
-    // RNG alias name
-    typedef MT19937IcnRng<DT> RNG;
+    // RNG and RNG sequence alias
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::RNG RNG;
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
 
     BSModel<DT> BSInst;
 
     // path generator instance
-    BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
+    typename SimT::PathGeneratorT pathGenInst[UN][1];
 #pragma HLS array_partition variable = pathGenInst dim = 1
 
     // path pricer instance
-    PathPricer<sty, DT, SF, SN, Antithetic> pathPriInst[UN][1];
+    typename SimT::PathPricerT pathPriInst[UN][1];
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
     // RNG sequence instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+    RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
 
     // pre-process for "cold" logic.
@@ -134,14 +263,431 @@ void MCEuropeanEngine(DT underlying,
         rngSeqInst[i][0].seed[0] = seed[i];
     }
 
+    // expectation of the discounted underlying at expiry
+    DT controlMean = 0;
+    if (ControlVariate) {
+        controlMean = underlying * internal::FPExp(-internal::FPTwoMul(dividendYield, timeLength));
+    }
+
     // call monter carlo simulation
-    DT price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
-                            RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
-                                                              pathGenInst, pathPriInst, rngSeqInst);
+    DT price = SimT::template run<RNG, RNGSeqT, UN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                    controlMean, pathGenInst, pathPriInst, rngSeqInst);
 
     // output the price of option
     output[0] = price;
 }
+
+/**
+ * @brief European Option Grid Pricing Engine using Monte Carlo Method based on
+ * Black-Scholes model. A grid of options on the same underlying, differing in
+ * strike, maturity and type, is priced from one set of simulated paths, so a
+ * smile of payoffNum strikes costs about one simulation. Paths run to
+ * timeLength in timeSteps steps, each maturity is snapped to the nearest step.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @tparam MaxK maximum number of options of the grid, default 64.
+ * @tparam Antithetic antithetic is used  for variance reduction, default this
+ * feature is disabled.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of the simulated paths, no less than the
+ * longest maturity.
+ * @param strike strike of each option.
+ * @param maturity maturity of each option.
+ * @param optionType type of each option. 1: put option, 0: call option.
+ * @param payoffNum number of options of the grid, at most MaxK.
+ * @param seed array to store the inital seed for each RNG.
+ * @param output price of each option.
+ * @param requiredTolerance the tolerance required. If requiredSamples is not
+ * set, simulation will stop when the largest error of the grid reaches it,
+ * default 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to timeLength, default
+ * 100.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 2, int MaxK = 64, bool Antithetic = false, int QmcDim = 0, bool QmcShift = true>
+void MCEuropeanGridEngine(DT underlying,
+                          DT volatility,
+                          DT dividendYield,
+                          DT riskFreeRate, // model parameter
+                          DT timeLength,
+                          DT* strike,
+                          DT* maturity,
+                          bool* optionType,
+                          unsigned int payoffNum, // option parameter
+                          ap_uint<32>* seed,
+                          DT* output,
+                          DT requiredTolerance = 0.02,
+                          unsigned int requiredSamples = 1024,
+                          unsigned int timeSteps = 100,
+                          unsigned int maxSamples = MAX_SAMPLE) {
+    // number of variate
+    const static int VN = 1;
+
+    // Step first or sample first for each simulation
+    const static bool SF = false;
+
+    // number of samples per simulation
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value;
+
+    // RNG and RNG sequence alias
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::RNG RNG;
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    MultiPayoffPathPricer<DT, SN, MaxK, Antithetic> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSeqT rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic.
+    DT dt = timeLength / timeSteps;
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+
+    // snap each maturity to its time step, and discount from there
+    DT strikeBuff[MaxK];
+    ap_uint<16> stepBuff[MaxK];
+    DT discountBuff[MaxK];
+    bool typeBuff[MaxK];
+    for (int k = 0; k < MaxK; ++k) {
+#pragma HLS pipeline
+        if (k < payoffNum) {
+            int step = (int)(maturity[k] / dt + (DT)0.5);
+            if (step < 1) step = 1;
+            if (step > (int)timeSteps) step = timeSteps;
+            DT f_1 = internal::FPTwoMul(riskFreeRate, internal::FPTwoMul((DT)step, dt));
+            strikeBuff[k] = strike[k];
+            stepBuff[k] = step;
+            discountBuff[k] = internal::FPExp(-f_1);
+            typeBuff[k] = optionType[k];
+        } else {
+            strikeBuff[k] = 0;
+            stepBuff[k] = 0;
+            discountBuff[k] = 0;
+            typeBuff[k] = false;
+        }
+    }
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].payoffNum = payoffNum;
+        for (int k = 0; k < MaxK; ++k) {
+#pragma HLS unroll
+            pathPriInst[i][0].strike[k] = strikeBuff[k];
+            pathPriInst[i][0].maturityStep[k] = stepBuff[k];
+            pathPriInst[i][0].discount[k] = discountBuff[k];
+            pathPriInst[i][0].optionType[k] = typeBuff[k];
+        }
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNGSequnce
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+
+    // call monter carlo simulation
+    DT price[MaxK];
+    mcSimulationMultiPayoff<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>,
+                            MultiPayoffPathPricer<DT, SN, MaxK, Antithetic>, RNGSeqT, UN, VN, SN>(
+        timeSteps, maxSamples, requiredSamples, requiredTolerance, payoffNum, pathGenInst, pathPriInst, rngSeqInst,
+        price);
+
+    // output the price of each option
+    for (int k = 0; k < payoffNum; ++k) {
+#pragma HLS pipeline
+#pragma HLS loop_tripcount min = MaxK max = MaxK
+        output[k] = price[k];
+    }
+}
+
+namespace internal {
+// Price and Greeks of one Black-Scholes option in one simulation, see GreeksPathPricer.
+template <OptionStyle sty, typename DT, int UN, bool Antithetic, int QmcDim, bool QmcShift>
+void mcGreeksEngine(DT underlying,
+                    DT volatility,
+                    DT dividendYield,
+                    DT riskFreeRate,
+                    DT timeLength,
+                    DT strike,
+                    DT cashPayoff,
+                    bool optionType,
+                    ap_uint<32>* seed,
+                    DT* output,
+                    DT* greeks,
+                    DT requiredTolerance,
+                    unsigned int requiredSamples,
+                    unsigned int timeSteps,
+                    unsigned int maxSamples) {
+    // number of variate
+    const static int VN = 1;
+
+    // Step first or sample first for each simulation
+    const static bool SF = false;
+
+    // number of samples per simulation
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value;
+
+    // RNG and RNG sequence alias
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::RNG RNG;
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
+    typedef GreeksPathPricer<sty, DT, SN, Antithetic> PathPricerT;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    PathPricerT pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSeqT rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic.
+    DT dt = timeLength / timeSteps;
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path pricer
+        pathPriInst[i][0].init(underlying, strike, cashPayoff, optionType, volatility, riskFreeRate, dividendYield,
+                               timeLength, timeSteps);
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNGSequnce
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+
+    // the tolerance applies to the price only, the Greeks are accumulated alongside
+    DT result[PathPricerT::OutN];
+    mcSimulationMultiPayoff<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricerT, RNGSeqT, UN, VN, SN>(
+        timeSteps, maxSamples, requiredSamples, requiredTolerance, 1, pathGenInst, pathPriInst, rngSeqInst, result);
+
+    output[0] = result[0];
+    for (int k = 1; k < PathPricerT::OutN; ++k) {
+#pragma HLS pipeline
+        greeks[k - 1] = result[k];
+    }
+}
+} // namespace internal
+
+/**
+ * @brief European Option Pricing Engine with Greeks using Monte Carlo Method
+ * based on Black-Scholes model. Delta, rho, vega and theta are pathwise
+ * derivatives and gamma is a likelihood ratio estimate, all accumulated in
+ * the same simulation as the price, on the same paths.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @tparam Antithetic antithetic is used  for variance reduction, default this
+ * feature is disabled.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param output price of the option.
+ * @param greeks Greeks of the option, theta (derivative to timeLength), rho,
+ * delta, gamma and vega.
+ * @param requiredTolerance the tolerance of the price required. If
+ * requiredSamples is not set, when reaching the required tolerance, simulation
+ * will stop, default 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 2, bool Antithetic = false, int QmcDim = 0, bool QmcShift = true>
+void MCEuropeanGreeksEngine(DT underlying,
+                            DT volatility,
+                            DT dividendYield,
+                            DT riskFreeRate, // model parameter
+                            DT timeLength,
+                            DT strike,
+                            bool optionType, // option parameter
+                            ap_uint<32>* seed,
+                            DT* output,
+                            DT* greeks,
+                            DT requiredTolerance = 0.02,
+                            unsigned int requiredSamples = 1024,
+                            unsigned int timeSteps = 100,
+                            unsigned int maxSamples = MAX_SAMPLE) {
+    internal::mcGreeksEngine<European, DT, UN, Antithetic, QmcDim, QmcShift>(
+        underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, (DT)0, optionType, seed, output,
+        greeks, requiredTolerance, requiredSamples, timeSteps, maxSamples);
+}
+
+/**
+ * @brief Cash-or-nothing Digital Option Pricing Engine with Greeks using Monte
+ * Carlo Method based on Black-Scholes model. The option pays cashPayoff at
+ * expiry when it ends in the money. All Greeks are likelihood ratio estimates,
+ * accumulated in the same simulation as the price, on the same paths.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @tparam Antithetic antithetic is used  for variance reduction, default this
+ * feature is disabled.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param cashPayoff the amount paid when the option ends in the money.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param output price of the option.
+ * @param greeks Greeks of the option, theta (derivative to timeLength), rho,
+ * delta, gamma and vega.
+ * @param requiredTolerance the tolerance of the price required. If
+ * requiredSamples is not set, when reaching the required tolerance, simulation
+ * will stop, default 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 2, bool Antithetic = false, int QmcDim = 0, bool QmcShift = true>
+void MCDigitalGreeksEngine(DT underlying,
+                           DT volatility,
+                           DT dividendYield,
+                           DT riskFreeRate, // model parameter
+                           DT timeLength,
+                           DT strike,
+                           DT cashPayoff,
+                           bool optionType, // option parameter
+                           ap_uint<32>* seed,
+                           DT* output,
+                           DT* greeks,
+                           DT requiredTolerance = 0.02,
+                           unsigned int requiredSamples = 1024,
+                           unsigned int timeSteps = 100,
+                           unsigned int maxSamples = MAX_SAMPLE) {
+    internal::mcGreeksEngine<Digital, DT, UN, Antithetic, QmcDim, QmcShift>(
+        underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, cashPayoff, optionType, seed, output,
+        greeks, requiredTolerance, requiredSamples, timeSteps, maxSamples);
+}
+
+/**
+ * @brief Asian Arithmetic Average Price Engine with Greeks using Monte Carlo
+ * Method based on Black-Scholes model. The average includes the initial price
+ * and the price after each of timeSteps steps, as MCAsianArithmeticAPEngine,
+ * but without its geometric control variate. Delta, rho, vega and theta are
+ * pathwise derivatives and gamma is a likelihood ratio estimate on the first
+ * step, all accumulated in the same simulation as the price.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @tparam Antithetic antithetic is used  for variance reduction, default this
+ * feature is disabled.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param output price of the option.
+ * @param greeks Greeks of the option, theta (derivative to timeLength), rho,
+ * delta, gamma and vega.
+ * @param requiredTolerance the tolerance of the price required. If
+ * requiredSamples is not set, when reaching the required tolerance, simulation
+ * will stop, default 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 2, bool Antithetic = false, int QmcDim = 0, bool QmcShift = true>
+void MCAsianArithmeticAPGreeksEngine(DT underlying,
+                                     DT volatility,
+                                     DT dividendYield,
+                                     DT riskFreeRate, // model parameter
+                                     DT timeLength,
+                                     DT strike,
+                                     bool optionType, // option parameter
+                                     ap_uint<32>* seed,
+                                     DT* output,
+                                     DT* greeks,
+                                     DT requiredTolerance = 0.02,
+                                     unsigned int requiredSamples = 1024,
+                                     unsigned int timeSteps = 100,
+                                     unsigned int maxSamples = MAX_SAMPLE) {
+    internal::mcGreeksEngine<Asian_AP, DT, UN, Antithetic, QmcDim, QmcShift>(
+        underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, (DT)0, optionType, seed, output,
+        greeks, requiredTolerance, requiredSamples, timeSteps, maxSamples);
+}
 /**
  * @brief path pricer bypass variant (interface compatible with standard MCEuropeanEngine)
  *
@@ -199,7 +745,7 @@ void MCEuropeanPriBypassEngine(DT underlying,
     const static bool Antithetic = false;
 
     // RNG alias name
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
 
     BSModel<DT> BSInst;
 
@@ -267,6 +813,11 @@ void MCEuropeanPriBypassEngine(DT underlying,
  * @tparam Antithetic antithetic is used  for variance reduction, default this
  * feature is disabled.
  *
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * 2 * timeSteps, 0 for pseudo-random numbers, default 0. Only seed[i][0] is
+ * used then.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
  * @param underlying the initial price of underlying asset at time 0.
  * @param riskFreeRate risk-free interest rate.
  * @param sigma the volatility of volatility
@@ -296,7 +847,9 @@ void MCEuropeanPriBypassEngine(DT underlying,
 template <typename DT = double,
           int UN = 8,
           DiscreType discretization = kDTQuadraticExponential,
-          bool Antithetic = false>
+          bool Antithetic = false,
+          int QmcDim = 0,
+          bool QmcShift = true>
 void MCEuropeanHestonEngine(DT underlying,
                             DT riskFreeRate,
                             DT sigma,
@@ -314,10 +867,9 @@ void MCEuropeanHestonEngine(DT underlying,
                             unsigned int requiredSamples = 1024,
                             unsigned int timeSteps = 100,
                             unsigned int maxSamples = MAX_SAMPLE) {
-    typedef MT19937IcnRng<DT> RNG;
-    const static int SN = 1024;   // SampNum
-    const static int VN = 2;      // VariateNum
-    const static bool SF = false; // StepFirst
+    const static int VN = 2;                                        // VariateNum
+    const static bool SF = false;                                   // StepFirst
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value; // SampNum
     const OptionStyle sty = European;
     // const static bool Antithetic = false;
 
@@ -394,7 +946,9 @@ void MCEuropeanHestonEngine(DT underlying,
     // call mcSimulation
     DT price;
     if (discretization == kDTQuadraticExponential || discretization == kDTQuadraticExponentialMartingale) {
-        RNGSequence_Heston_QuadraticExponential<DT, RNG> rngSeqInst_1[UN][1];
+        typedef typename MCEngineSequence<DT, 2, SN, SF, QmcDim, QmcShift, true>::RNG RNG;
+        typedef typename MCEngineSequence<DT, 2, SN, SF, QmcDim, QmcShift, true>::type RNGSeqT;
+        RNGSeqT rngSeqInst_1[UN][1];
 #pragma HLS array_partition variable = rngSeqInst_1 dim = 1
         for (int i = 0; i < UN; i++) {
 #pragma HLS unroll
@@ -403,11 +957,12 @@ void MCEuropeanHestonEngine(DT underlying,
         }
 
         price = mcSimulation<DT, RNG, HestonPathGenerator<discretization, DT, SN, Antithetic>,
-                             PathPricer<sty, DT, SF, SN, Antithetic>, RNGSequence_Heston_QuadraticExponential<DT, RNG>,
-                             UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst,
-                                         pathPriInst, rngSeqInst_1);
+                             PathPricer<sty, DT, SF, SN, Antithetic>, RNGSeqT, UN, VN, SN>(
+            timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst, pathPriInst, rngSeqInst_1);
     } else {
-        RNGSequence_2<DT, RNG> rngSeqInst[UN][1];
+        typedef typename MCEngineSequence<DT, 2, SN, SF, QmcDim, QmcShift>::RNG RNG;
+        typedef typename MCEngineSequence<DT, 2, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
+        RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
         for (int i = 0; i < UN; i++) {
 #pragma HLS unroll
@@ -415,7 +970,7 @@ void MCEuropeanHestonEngine(DT underlying,
             rngSeqInst[i][0].seed[1] = seed[i][1];
         }
         price = mcSimulation<DT, RNG, HestonPathGenerator<discretization, DT, SN, Antithetic>,
-                             PathPricer<European, DT, SF, SN, Antithetic>, RNGSequence_2<DT, RNG>, UN, VN, SN>(
+                             PathPricer<European, DT, SF, SN, Antithetic>, RNGSeqT, UN, VN, SN>(
             timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst, pathPriInst, rngSeqInst);
     }
     outputs[0] = price;
@@ -482,7 +1037,7 @@ void MCMultiAssetEuropeanHestonEngine(DT underlying[ASSETS],
                                       ap_uint<32> requiredSamples = 0,
                                       ap_uint<32> timeSteps = 100,
                                       ap_uint<32> maxSamples = MAX_SAMPLE) {
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
     const static int SN = 512; // SampNum
     const static int VN = 2;
     const static bool SF = false;
@@ -596,7 +1151,7 @@ void MCAmericanEnginePreSamples(DT underlying,
     const static bool Antithetic = false;
 
     // RNG alias name
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
 
     // path generator instance
     BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
@@ -840,7 +1395,7 @@ void MCAmericanEnginePricing(DT underlying,
     const static bool Antithetic = false;
 
     // RNG alias name
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
     // B-S model instance
     BSModel<DT> BSInst;
 
@@ -998,7 +1553,7 @@ void MCAmericanEngine(DT underlying,
     const static bool Antithetic = false;
 
     // RNG alias name
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
 
     // For the instances that used/shared in both calibration and pricing process,
     // the instance number of unroll equals max(UN_PATH, UN_PRICING)
@@ -1122,6 +1677,10 @@ void MCAmericanEngine(DT underlying,
  * precision of output.
  * @tparam UN The number of Monte Carlo Module in parallel, which affects the
  * latency and resources utilization.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
  * @param underlying The initial price of underlying asset.
  * @param volatility The market's price volatility.
  * @param dividendYield The dividend yield is the company's total annual
@@ -1146,7 +1705,7 @@ void MCAmericanEngine(DT underlying,
  * simulation will stop, default 2147483648.
  *
  */
-template <typename DT = double, int UN = 16>
+template <typename DT = double, int UN = 16, int QmcDim = 0, bool QmcShift = true>
 void MCAsianGeometricAPEngine(DT underlying,
                               DT volatility,
                               DT dividendYield,
@@ -1160,17 +1719,18 @@ void MCAsianGeometricAPEngine(DT underlying,
                               unsigned int requiredSamples = 1024,
                               unsigned int timeSteps = 100,
                               unsigned int maxSamples = MAX_SAMPLE) {
-    // Number of Samples per simulation
-    const static int SN = 1024; // SampNum
-
     // Number of Variate
     const static int VN = 1; // VariateNum
 
     // Step first or Sample first
     const static bool SF = false; // StepFirst
 
-    // RNG alias
-    typedef MT19937IcnRng<DT> RNG;
+    // Number of Samples per simulation
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value; // SampNum
+
+    // RNG and RNG sequence alias
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::RNG RNG;
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
 
     // Enable Antithetic or not
     // const static bool Antithetic = false;
@@ -1191,7 +1751,7 @@ void MCAsianGeometricAPEngine(DT underlying,
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
     // RNG sequence Instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+    RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
 
     // Pre-process of "cold" logic
@@ -1222,8 +1782,8 @@ void MCAsianGeometricAPEngine(DT underlying,
         rngSeqInst[i][0].seed[0] = seed[i];
     }
     DT price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
-                            RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
-                                                              pathGenInst, pathPriInst, rngSeqInst);
+                            RNGSeqT, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                 pathGenInst, pathPriInst, rngSeqInst);
 
     output[0] = price;
 }
@@ -1232,11 +1792,18 @@ void MCAsianGeometricAPEngine(DT underlying,
  * @brief Asian Arithmetic Average Price Engine using Monte Carlo Method Based
  * on Black-Scholes Model.
  * The settlement price of the underlying asset at expiry time is the arithmetic
- * average of asset price during the option lifetime.
+ * average of asset price during the option lifetime. The geometric average
+ * price option, priced in closed form, is the control variate, with a beta
+ * estimated from the paths rather than fixed to 1, so prices differ from
+ * earlier releases within the tolerance.
  * @tparam DT Supported data type including double and float, which decides the
  * precision of output.
  * @tparam UN The number of Monte Carlo Module in parallel, which affects the
  * latency and resources utilization.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
  * @param underlying The initial price of underlying asset.
  * @param volatility The market's price volatility.
  * @param dividendYield The dividend yield is the company's total annual
@@ -1262,7 +1829,7 @@ void MCAsianGeometricAPEngine(DT underlying,
  *
  */
 
-template <typename DT = double, int UN = 16>
+template <typename DT = double, int UN = 16, int QmcDim = 0, bool QmcShift = true>
 void MCAsianArithmeticAPEngine(DT underlying,
                                DT volatility,
                                DT dividendYield,
@@ -1276,17 +1843,18 @@ void MCAsianArithmeticAPEngine(DT underlying,
                                unsigned int requiredSamples = 1024,
                                unsigned int timeSteps = 100,
                                unsigned int maxSamples = MAX_SAMPLE) {
-    // Number of Samples per simulation
-    const static int SN = 1024; // SampNum
-
     // Number of Variate
     const static int VN = 1; // VariateNum
 
     // Step first or Sample first
     const static bool SF = false; // StepFirst
 
-    // RNG alias
-    typedef MT19937IcnRng<DT> RNG;
+    // Number of Samples per simulation
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value; // SampNum
+
+    // RNG and RNG sequence alias
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::RNG RNG;
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
 
     // Enable Antithetic or not
     const static bool Antithetic = false;
@@ -1301,12 +1869,12 @@ void MCAsianArithmeticAPEngine(DT underlying,
     BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
 #pragma HLS array_partition variable = pathGenInst dim = 1
 
-    // Path pricer instance
-    PathPricer<sty, DT, SF, SN, Antithetic> pathPriInst[UN][1];
+    // Path pricer instance, with the geometric average price option as control
+    ControlVariatePathPricer<sty, DT, SN, Antithetic> pathPriInst[UN][1];
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
     // RNG sequence Instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+    RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
 
     // Pre-process of "cold" logic
@@ -1334,7 +1902,6 @@ void MCAsianArithmeticAPEngine(DT underlying,
         pathPriInst[i][0].underlying = underlying;
         pathPriInst[i][0].strike = strike;
         pathPriInst[i][0].discount = discount;
-        pathPriInst[i][0].dt = dt;
 
         // Path Generator
         pathGenInst[i][0].BSInst = BSInst;
@@ -1343,11 +1910,6 @@ void MCAsianArithmeticAPEngine(DT underlying,
         rngSeqInst[i][0].seed[0] = seed[i];
     }
 
-    DT price = mcSimulation<DT, xf::fintech::MT19937IcnRng<DT>, BSPathGenerator<DT, SF, SN, Antithetic>,
-                            PathPricer<sty, DT, SF, SN, Antithetic>, RNGSequence<DT, xf::fintech::MT19937IcnRng<DT> >,
-                            UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst,
-                                        pathPriInst, rngSeqInst);
-
     // Control variate price ref
     DT fixings = timeSteps + 1;
     DT timeSum = (timeSteps + 1) * timeLength * 0.5;
@@ -1375,8 +1937,13 @@ void MCAsianArithmeticAPEngine(DT underlying,
         beta = -cum_d2;
     }
     DT priceRef = discount * (forwardPrice * alpha + strike * beta);
+
+    DT price = mcSimulationControlVariate<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>,
+                                          ControlVariatePathPricer<sty, DT, SN, Antithetic>, RNGSeqT, UN, VN, SN>(
+        timeSteps, maxSamples, requiredSamples, requiredTolerance, priceRef, pathGenInst, pathPriInst, rngSeqInst);
+
     // output result
-    output[0] = price + priceRef;
+    output[0] = price;
 }
 
 /**
@@ -1389,6 +1956,10 @@ void MCAsianArithmeticAPEngine(DT underlying,
  * precision of output.
  * @tparam UN The number of Monte Carlo Module in parallel, which affects the
  * latency and resources utilization.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
  * @param underlying The initial price of underlying asset.
  * @param volatility The market's price volatility.
  * @param dividendYield The dividend yield is the company's total annual
@@ -1414,7 +1985,7 @@ void MCAsianArithmeticAPEngine(DT underlying,
  * simulation will stop, default 2,147,483,648.
  *
  */
-template <typename DT = double, int UN = 16>
+template <typename DT = double, int UN = 16, int QmcDim = 0, bool QmcShift = true>
 void MCAsianArithmeticASEngine(DT underlying,
                                DT volatility,
                                DT dividendYield,
@@ -1428,17 +1999,18 @@ void MCAsianArithmeticASEngine(DT underlying,
                                unsigned int requiredSamples = 1024,
                                unsigned int timeSteps = 100,
                                unsigned int maxSamples = MAX_SAMPLE) {
-    // Number of Samples per simulation
-    const static int SN = 1024; // SampNum
-
     // Number of Variate
     const static int VN = 1; // VariateNum
 
     // Step first or Sample first
     const static bool SF = false; // StepFirst
 
-    // RNG alias
-    typedef MT19937IcnRng<DT> RNG;
+    // Number of Samples per simulation
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value; // SampNum
+
+    // RNG and RNG sequence alias
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::RNG RNG;
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
 
     // Enable Antithetic or not
     const static bool Antithetic = true;
@@ -1458,7 +2030,7 @@ void MCAsianArithmeticASEngine(DT underlying,
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
     // RNG sequence Instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+    RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
 
     // Pre-process of "cold" logic
@@ -1491,8 +2063,8 @@ void MCAsianArithmeticASEngine(DT underlying,
     }
 
     DT price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
-                            RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
-                                                              pathGenInst, pathPriInst, rngSeqInst);
+                            RNGSeqT, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                 pathGenInst, pathPriInst, rngSeqInst);
 
     // Output the option price
     output[0] = price;
@@ -1558,7 +2130,7 @@ void MCBarrierNoBiasEngine(DT underlying,
     const static bool SF = false; // StepFirst
 
     // RNG alias
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
 
     // Enable Antithetic or not
     const static bool Antithetic = true;
@@ -1621,6 +2193,10 @@ void MCBarrierNoBiasEngine(DT underlying,
  * decides the precision of result, default double-precision data type.
  * @tparam UN number of Monte Carlo Module in parallel, which affects the
  * latency and resources utilization, default 10.
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, at least
+ * timeSteps, 0 for pseudo-random numbers, default 0.
+ * @tparam QmcShift digital shift of Sobol points, which makes each lane an
+ * independent randomization, default enabled.
  * @param underlying intial value of underlying asset at time 0.
  * @param volatility fixed volatility of underlying asset.
  * @param dividendYield the constant dividend rate for continuous dividends.
@@ -1646,7 +2222,7 @@ void MCBarrierNoBiasEngine(DT underlying,
  * @param maxSamples the maximum sample number. When reaching it, the
  * simulation will stop, default 2,147,483,648.
  */
-template <typename DT = double, int UN = 10>
+template <typename DT = double, int UN = 10, int QmcDim = 0, bool QmcShift = true>
 void MCBarrierEngine(DT underlying,
                      DT volatility,
                      DT dividendYield,
@@ -1663,20 +2239,21 @@ void MCBarrierEngine(DT underlying,
                      unsigned int requiredSamples = 1024,
                      unsigned int timeSteps = 100,
                      unsigned int maxSamples = MAX_SAMPLE) {
-    // number of samples per simulation
-    const static int SN = 1024; // SampNum
-
     // number of variate
     const static int VN = 1; // VariateNum
 
     // step first or sample first
     const static bool SF = false; // StepFirst
 
+    // number of samples per simulation
+    const static int SN = MCEngineSampNum<1024, SF, QmcDim>::value; // SampNum
+
     // Antithetic enable or not.
     const static bool Antithetic = false;
 
-    // RNG alias.
-    typedef MT19937IcnRng<DT> RNG;
+    // RNG and RNG sequence alias
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::RNG RNG;
+    typedef typename MCEngineSequence<DT, 1, SN, SF, QmcDim, QmcShift>::type RNGSeqT;
 
     // B-S model instance
     BSModel<DT> BSInst;
@@ -1690,7 +2267,7 @@ void MCBarrierEngine(DT underlying,
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
     // RGn sequence generator instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+    RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
 
     // pre-process for "cold" logic
@@ -1722,7 +2299,7 @@ void MCBarrierEngine(DT underlying,
     }
     // Monte Carlo simulation
     DT price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>,
-                            PathPricer<BarrierBiased, DT, SF, SN, Antithetic>, RNGSequence<DT, RNG>, UN, VN, SN>(
+                            PathPricer<BarrierBiased, DT, SF, SN, Antithetic>, RNGSeqT, UN, VN, SN>(
         timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst, pathPriInst, rngSeqInst);
     // output the option price
     output[0] = price;
@@ -1785,7 +2362,7 @@ void MCCliquetEngine(DT underlying,
     const static bool Antithetic = false;
 
     // RNG alias
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
     // path generator instance
     BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
 #pragma HLS array_partition variable = pathGenInst dim = 1
@@ -1884,7 +2461,7 @@ void MCDigitalEngine(DT underlying,
     // Antithetic enable or not
     const static bool Antithetic = true;
     // RNG aliase
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
     // path generator instance
     BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
 #pragma HLS array_partition variable = pathGenInst dim = 1
@@ -1944,6 +2521,9 @@ void MCDigitalEngine(DT underlying,
  * kDTQuadraticExponentialMartingale, are supported, default
  * kDTQuadraticExponential.
  *
+ * @tparam QmcDim dimension of Sobol points for quasi-Monte Carlo, 0 for
+ * pseudo-random numbers, default 0, see MCEuropeanHestonEngine.
+ * @tparam QmcShift digital shift of Sobol points, default enabled.
  * @param underlying the initial price of underlying asset at time 0.
  * @param riskFreeRate risk-free interest rate.
  * @param sigma the volatility of volatility
@@ -1970,7 +2550,11 @@ void MCDigitalEngine(DT underlying,
  *
  */
 
-template <typename DT = double, int UN = 1, DiscreType discretization = kDTQuadraticExponential>
+template <typename DT = double,
+          int UN = 1,
+          DiscreType discretization = kDTQuadraticExponential,
+          int QmcDim = 0,
+          bool QmcShift = true>
 void MCEuropeanHestonGreeksEngine(DT underlying,
                                   DT riskFreeRate,
                                   DT sigma,
@@ -2000,55 +2584,77 @@ void MCEuropeanHestonGreeksEngine(DT underlying,
     DT priceBuff[11];
 
     // calculate base
-    MCEuropeanHestonEngine<DT, UN, discretization>(underlying, riskFreeRate, sigma, v0, theta, kappa, rho,
-                                                   dividendYield, optionType, strike, timeLength, seed, priceBuff,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(underlying, riskFreeRate, sigma, v0, theta,
+                                                                            kappa, rho, dividendYield, optionType,
+                                                                            strike, timeLength, seed, priceBuff,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
     // calculate theta
     DT T = timeLength - d_T;
-    MCEuropeanHestonEngine<DT, UN, discretization>(underlying, riskFreeRate, sigma, v0, theta, kappa, rho,
-                                                   dividendYield, optionType, strike, T, seed, priceBuff + 1,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(underlying, riskFreeRate, sigma, v0, theta,
+                                                                            kappa, rho, dividendYield, optionType,
+                                                                            strike, T, seed, priceBuff + 1,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
     // calculate rho
     DT r = riskFreeRate + d_r;
-    MCEuropeanHestonEngine<DT, UN, discretization>(underlying, r, sigma, v0, theta, kappa, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 2,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(underlying, r, sigma, v0, theta, kappa, rho,
+                                                                            dividendYield, optionType, strike,
+                                                                            timeLength, seed, priceBuff + 2,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
     // calculate delta
     DT S0_0 = underlying + d_S;
     DT S0_1 = underlying - d_S;
-    MCEuropeanHestonEngine<DT, UN, discretization>(S0_0, riskFreeRate, sigma, v0, theta, kappa, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 3,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
-    MCEuropeanHestonEngine<DT, UN, discretization>(S0_1, riskFreeRate, sigma, v0, theta, kappa, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 4,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(S0_0, riskFreeRate, sigma, v0, theta, kappa,
+                                                                            rho, dividendYield, optionType, strike,
+                                                                            timeLength, seed, priceBuff + 3,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(S0_1, riskFreeRate, sigma, v0, theta, kappa,
+                                                                            rho, dividendYield, optionType, strike,
+                                                                            timeLength, seed, priceBuff + 4,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
     // calcuate gamma
     DT S0_2 = underlying + d2_S;
     DT S0_3 = underlying - d2_S;
-    MCEuropeanHestonEngine<DT, UN, discretization>(S0_2, riskFreeRate, sigma, v0, theta, kappa, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 5,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
-    MCEuropeanHestonEngine<DT, UN, discretization>(S0_3, riskFreeRate, sigma, v0, theta, kappa, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 6,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(S0_2, riskFreeRate, sigma, v0, theta, kappa,
+                                                                            rho, dividendYield, optionType, strike,
+                                                                            timeLength, seed, priceBuff + 5,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(S0_3, riskFreeRate, sigma, v0, theta, kappa,
+                                                                            rho, dividendYield, optionType, strike,
+                                                                            timeLength, seed, priceBuff + 6,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
     // calcuate modelvega
     DT kap = kappa + d_kap;
-    MCEuropeanHestonEngine<DT, UN, discretization>(underlying, riskFreeRate, sigma, v0, theta, kap, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 7,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(underlying, riskFreeRate, sigma, v0, theta,
+                                                                            kap, rho, dividendYield, optionType, strike,
+                                                                            timeLength, seed, priceBuff + 7,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
     DT tha = theta + d_the;
-    MCEuropeanHestonEngine<DT, UN, discretization>(underlying, riskFreeRate, sigma, v0, tha, kappa, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 8,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(underlying, riskFreeRate, sigma, v0, tha,
+                                                                            kappa, rho, dividendYield, optionType,
+                                                                            strike, timeLength, seed, priceBuff + 8,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
 
     DT xi = sigma + d_xi;
-    MCEuropeanHestonEngine<DT, UN, discretization>(underlying, riskFreeRate, xi, v0, theta, kappa, rho, dividendYield,
-                                                   optionType, strike, timeLength, seed, priceBuff + 9,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(underlying, riskFreeRate, xi, v0, theta,
+                                                                            kappa, rho, dividendYield, optionType,
+                                                                            strike, timeLength, seed, priceBuff + 9,
+                                                                            requiredTolerance, requiredSamples,
+                                                                            timeSteps, maxSamples);
     DT v0_0 = v0 + d_v0;
-    MCEuropeanHestonEngine<DT, UN, discretization>(underlying, riskFreeRate, sigma, v0_0, theta, kappa, rho,
-                                                   dividendYield, optionType, strike, timeLength, seed, priceBuff + 10,
-                                                   requiredTolerance, requiredSamples, timeSteps, maxSamples);
+    MCEuropeanHestonEngine<DT, UN, discretization, false, QmcDim, QmcShift>(underlying, riskFreeRate, sigma, v0_0,
+                                                                            theta, kappa, rho, dividendYield,
+                                                                            optionType, strike, timeLength, seed,
+                                                                            priceBuff + 10, requiredTolerance,
+                                                                            requiredSamples, timeSteps, maxSamples);
 
     // calculate thetha
     greeks[0] = (priceBuff[1] - priceBuff[0]) / d_T;
@@ -2112,7 +2718,7 @@ void MCHullWhiteCapFloorEngine(DT nomial,
     const static bool SF = false;
 
     // RNG alias name
-    typedef MT19937IcnRng<DT> RNG;
+    typedef typename MCEngineRng<DT>::type RNG;
 
     // path generator instance
     HullWhitePathGen<DT, SN> pathGenInst[UN][1];
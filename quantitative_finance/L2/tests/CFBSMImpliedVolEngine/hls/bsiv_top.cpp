@@ -0,0 +1,42 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bsiv_top.hpp"
+void cfBSMImpliedVolEngine_top(TEST_DT price[TEST_NUM],
+                               TEST_DT underlying[TEST_NUM],
+                               TEST_DT riskFreeRate[TEST_NUM],
+                               TEST_DT timeLength[TEST_NUM],
+                               TEST_DT strike[TEST_NUM],
+                               TEST_DT dividendYield[TEST_NUM],
+                               unsigned int call,
+                               TEST_DT impliedVol[TEST_NUM]) {
+#pragma HLS ARRAY_PARTITION variable = price cyclic factor = TEST_PARALLEL
+#pragma HLS ARRAY_PARTITION variable = underlying cyclic factor = TEST_PARALLEL
+#pragma HLS ARRAY_PARTITION variable = riskFreeRate cyclic factor = TEST_PARALLEL
+#pragma HLS ARRAY_PARTITION variable = timeLength cyclic factor = TEST_PARALLEL
+#pragma HLS ARRAY_PARTITION variable = strike cyclic factor = TEST_PARALLEL
+#pragma HLS ARRAY_PARTITION variable = dividendYield cyclic factor = TEST_PARALLEL
+#pragma HLS ARRAY_PARTITION variable = impliedVol cyclic factor = TEST_PARALLEL
+    for (unsigned int i = 0; i < TEST_NUM; i += TEST_PARALLEL) {
+#pragma HLS PIPELINE II = 1
+        for (unsigned int j = 0; j < TEST_PARALLEL; ++j) {
+#pragma HLS UNROLL
+            impliedVol[i + j] = xf::fintech::cfBSMImpliedVolEngine<TEST_DT>(
+                price[i + j], underlying[i + j], riskFreeRate[i + j], timeLength[i + j], strike[i + j],
+                dividendYield[i + j], call);
+        }
+    }
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _XF_FINTECH_BSIV_TOP_HPP_
+#define _XF_FINTECH_BSIV_TOP_HPP_
+
+#include "xf_fintech/cf_bsm.hpp"
+#define TEST_NUM 256
+#define TEST_PARALLEL 16
+typedef float TEST_DT;
+void cfBSMImpliedVolEngine_top(TEST_DT price[TEST_NUM],
+                               TEST_DT underlying[TEST_NUM],
+                               TEST_DT riskFreeRate[TEST_NUM],
+                               TEST_DT timeLength[TEST_NUM],
+                               TEST_DT strike[TEST_NUM],
+                               TEST_DT dividendYield[TEST_NUM],
+                               unsigned int call,
+                               TEST_DT impliedVol[TEST_NUM]);
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "bsiv_top.hpp"
+
+// Black-Scholes-Merton premium in double precision as golden
+double blackScholes(double s, double k, double r, double q, double v, double t, bool call) {
+    double sd = v * std::sqrt(t);
+    double d1 = (std::log(s / k) + (r - q) * t) / sd + 0.5 * sd;
+    double d2 = d1 - sd;
+    double w = call ? 1.0 : -1.0;
+    double nd1 = 0.5 * std::erfc(-w * d1 / std::sqrt(2.0));
+    double nd2 = 0.5 * std::erfc(-w * d2 / std::sqrt(2.0));
+    return w * (s * std::exp(-q * t) * nd1 - k * std::exp(-r * t) * nd2);
+}
+
+double randomRange(double range_min, double range_max) {
+    return range_min + (range_max - range_min) * (rand() / (double)RAND_MAX);
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    // Volatility error allowed, the round trip is limited by float precision
+    TEST_DT tolerance = 1e-3;
+    // Options whose time value is below this are too close to intrinsic value
+    // to be inverted in float
+    double minTimeValue = 1e-2;
+
+    TEST_DT price[TEST_NUM];
+    TEST_DT underlying[TEST_NUM];
+    TEST_DT riskFreeRate[TEST_NUM];
+    TEST_DT timeLength[TEST_NUM];
+    TEST_DT strike[TEST_NUM];
+    TEST_DT dividendYield[TEST_NUM];
+    TEST_DT impliedVol[TEST_NUM];
+    double volatility[TEST_NUM];
+    double timeValue[TEST_NUM];
+
+    srand(1);
+    for (int p = 0; p < 2; ++p) {
+        bool call = (p == 0);
+        for (int i = 0; i < TEST_NUM; ++i) {
+            underlying[i] = randomRange(60, 160);
+            strike[i] = 100;
+            riskFreeRate[i] = randomRange(0.0, 0.1);
+            dividendYield[i] = randomRange(0.0, 0.05);
+            timeLength[i] = randomRange(0.1, 3);
+            volatility[i] = randomRange(0.05, 1.0);
+            // Black-76 on a forward for the second half of the options
+            if (i >= TEST_NUM / 2) dividendYield[i] = riskFreeRate[i];
+            double s = underlying[i], k = strike[i], r = riskFreeRate[i], q = dividendYield[i], t = timeLength[i];
+            double premium = blackScholes(s, k, r, q, volatility[i], t, call);
+            double intrinsic = s * std::exp(-q * t) - k * std::exp(-r * t);
+            if (!call) intrinsic = -intrinsic;
+            timeValue[i] = premium - std::fmax(intrinsic, 0.0);
+            price[i] = premium;
+        }
+
+        cfBSMImpliedVolEngine_top(price, underlying, riskFreeRate, timeLength, strike, dividendYield, call,
+                                  impliedVol);
+
+        for (int i = 0; i < TEST_NUM; ++i) {
+            if (timeValue[i] < minTimeValue) continue;
+            TEST_DT diff = std::fabs(impliedVol[i] - volatility[i]);
+            // compare with golden result
+            if (diff > tolerance) {
+                std::cout << "Output is wrong!" << std::endl;
+                std::cout << (call ? "Call option " : "Put option ") << i << ":\n";
+                std::cout << "Acutal value: " << impliedVol[i] << ", Expected value: " << volatility[i] << std::endl;
+                std::cout << "error: " << diff << ", tolerance: " << tolerance << std::endl;
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <iostream>
+#include "mcengine_top.hpp"
+
+// price of the engine on the paths of seeds, the same normals whatever the parameters
+TEST_DT price(TEST_DT underlying,
+              TEST_DT volatility,
+              TEST_DT dividendYield,
+              TEST_DT riskFreeRate,
+              TEST_DT timeLength,
+              TEST_DT strike,
+              bool optionType,
+              ap_uint<32> seeds[2],
+              unsigned int requiredSamples,
+              unsigned int timeSteps) {
+    TEST_DT outputs[6];
+    MCAsianAPGreeksEngine_top(underlying, volatility, dividendYield,
+                              riskFreeRate, // model parameter
+                              timeLength, strike,
+                              optionType, // option parameter
+                              seeds, outputs, outputs + 1, 0, requiredSamples, timeSteps);
+    return outputs[0];
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    TEST_DT underlying = 100;
+    TEST_DT volatility = 0.3;
+    TEST_DT dividendYield = 0.02;
+    TEST_DT riskFreeRate = 0.05;
+    TEST_DT timeLength = 1;
+    TEST_DT strike = 100;
+    unsigned int timeSteps = 12;
+    unsigned int requiredSamples = run_csim ? (1 << 19) : 2048;
+    // bumps of underlying, volatility, rate and time
+    TEST_DT hs = 1;
+    TEST_DT hv = 0.01;
+    TEST_DT hr = 0.01;
+    TEST_DT ht = 0.01;
+    // price, theta, rho, delta, gamma and vega, relative to their scale
+    TEST_DT scale[6] = {underlying, underlying, underlying, 1, 1 / underlying, underlying};
+    // on the same paths the pathwise Greeks and the differences agree to the bumps, the likelihood ratio gamma and
+    // the second difference do not, 0.2 is about 4 standard errors of their gap with 2^19 paths
+    TEST_DT relative_err[6] = {0, 0.001, 0.001, 0.001, 0.2, 0.001};
+    TEST_DT relax = run_csim ? 1 : 10;
+    const char* names[6] = {"price", "theta", "rho", "delta", "gamma", "vega"};
+
+    ap_uint<32> seeds[2];
+    seeds[0] = 1;
+    seeds[1] = 10001;
+
+    for (int p = 0; p < 2; ++p) {
+        bool optionType = p;
+        TEST_DT outputs[6];
+        MCAsianAPGreeksEngine_top(underlying, volatility, dividendYield,
+                                  riskFreeRate, // model parameter
+                                  timeLength, strike,
+                                  optionType, // option parameter
+                                  seeds, outputs, outputs + 1, 0, requiredSamples, timeSteps);
+        // central differences of the price on the same paths
+        TEST_DT s[2], v[2], r[2], t[2];
+        for (int b = 0; b < 2; ++b) {
+            TEST_DT sign = b ? 1 : -1;
+            s[b] = price(underlying + sign * hs, volatility, dividendYield, riskFreeRate, timeLength, strike,
+                         optionType, seeds, requiredSamples, timeSteps);
+            v[b] = price(underlying, volatility + sign * hv, dividendYield, riskFreeRate, timeLength, strike,
+                         optionType, seeds, requiredSamples, timeSteps);
+            r[b] = price(underlying, volatility, dividendYield, riskFreeRate + sign * hr, timeLength, strike,
+                         optionType, seeds, requiredSamples, timeSteps);
+            t[b] = price(underlying, volatility, dividendYield, riskFreeRate, timeLength + sign * ht, strike,
+                         optionType, seeds, requiredSamples, timeSteps);
+        }
+        TEST_DT golden[6];
+        golden[0] = outputs[0];
+        golden[1] = (t[1] - t[0]) / (2 * ht);
+        golden[2] = (r[1] - r[0]) / (2 * hr);
+        golden[3] = (s[1] - s[0]) / (2 * hs);
+        golden[4] = (s[1] - 2 * outputs[0] + s[0]) / (hs * hs);
+        golden[5] = (v[1] - v[0]) / (2 * hv);
+        for (int k = 1; k < 6; ++k) {
+            TEST_DT diff = std::fabs(outputs[k] - golden[k]) / scale[k];
+            // compare with bump and revalue
+            if (diff > relax * relative_err[k]) {
+                std::cout << "Output is wrong!" << std::endl;
+                std::cout << (optionType ? "Put option " : "Call option ") << names[k] << ":\n";
+                std::cout << "Acutal value: " << outputs[k] << ", Expected value: " << golden[k] << std::endl;
+                std::cout << "error: " << diff << ", tolerance: " << relax * relative_err[k] << std::endl;
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include "math.h"
+#include "xf_fintech/rng.hpp"
+#include "mcengine_top.hpp"
+
+void Analytical_GP_Engine(unsigned int timeSteps,
+                          TEST_DT timeLength,
+                          TEST_DT volatility,
+                          TEST_DT riskFreeRate,
+                          TEST_DT dividendYield,
+                          TEST_DT underlying,
+                          TEST_DT strike,
+                          bool optionType,
+                          TEST_DT& priceRef) {
+    TEST_DT fixings = timeSteps + 1;
+    TEST_DT timeSum = (timeSteps + 1) * timeLength * 0.5;
+    TEST_DT temp = timeSum * (timeSteps - 1) / 3.0;
+    TEST_DT tempFC = 2 * temp + timeSum;
+    TEST_DT tempvf = volatility / fixings;
+
+    TEST_DT variance = tempvf * tempvf * tempFC;
+    TEST_DT nu = riskFreeRate - dividendYield - 0.5 * volatility * volatility;
+    TEST_DT muG = std::log(underlying) + nu * timeLength * 0.5;
+    TEST_DT forwardPrice = std::exp(muG + variance * 0.5);
+    TEST_DT stDev = std::sqrt(variance);
+    TEST_DT d1 = std::log(forwardPrice / strike) / stDev + 0.5 * stDev;
+    TEST_DT d2 = d1 - stDev;
+    TEST_DT cum_d1 = xf::fintech::internal::CumulativeNormal<TEST_DT>(d1);
+    TEST_DT cum_d2 = xf::fintech::internal::CumulativeNormal<TEST_DT>(d2);
+    TEST_DT alpha, beta;
+    if (optionType) {
+        alpha = -1 + cum_d1;
+        beta = 1 - cum_d2;
+    } else {
+        alpha = cum_d1;
+        beta = -cum_d2;
+    }
+    TEST_DT discount = std::exp(-riskFreeRate * timeLength);
+    priceRef = discount * (forwardPrice * alpha + strike * beta);
+};
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    TEST_DT strike = 100;
+    TEST_DT underlying = 100;
+    TEST_DT riskFreeRate = 0.06;
+    TEST_DT volatility = 0.2;
+    TEST_DT dividendYield = 0.03;
+    TEST_DT timeLength = 1.0;
+    unsigned int maxSamples = 0;
+    // the error estimate comes from the spread of the means of the lanes, the
+    // price has to be within a few of them of the analytical one
+    TEST_DT tolerances[] = {0.02, 0.002};
+    // plain Sobol points, the lanes share out the first points of the sequence
+    unsigned int qmcSamples = 16384;
+    TEST_DT qmcErr = 0.005;
+
+    TEST_DT outputs[1];
+    ap_uint<32> seed[UN];
+    for (int i = 0; i < UN; ++i) {
+        seed[i] = i;
+    }
+
+    int fixings[] = {2, 8, 26};
+    int runNm = run_csim ? 3 : 1;
+    int tolNm = run_csim ? 2 : 1;
+    int nerror = 0;
+    for (int i = 0; i < runNm; ++i) {
+        unsigned int timeSteps = fixings[i] - 1;
+        for (int optionType = 0; optionType < 2; ++optionType) {
+            TEST_DT golden;
+            Analytical_GP_Engine(timeSteps, timeLength, volatility, riskFreeRate, dividendYield, underlying, strike,
+                                 optionType, golden);
+            for (int t = 0; t < tolNm; ++t) {
+                MCAsianGPQmcEngine_top(timeSteps, timeLength, strike, volatility, underlying, riskFreeRate,
+                                       dividendYield, 0, maxSamples, tolerances[t], optionType, seed, outputs);
+                std::cout << "fixings = " << fixings[i] << "\ttype = " << optionType
+                          << "\ttolerance = " << tolerances[t] << "\tcalculated value is " << outputs[0]
+                          << "\ttheoretical value is " << golden << std::endl;
+                if (std::fabs(outputs[0] - golden) > 3 * tolerances[t]) {
+                    std::cout << "Output is wrong!" << std::endl;
+                    nerror++;
+                }
+            }
+            if (!run_csim) continue;
+            xf::fintech::MCAsianGeometricAPEngine<TEST_DT, UN, QMC_DIM, false>(
+                underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, optionType, seed, outputs, 0,
+                qmcSamples, timeSteps, maxSamples);
+            std::cout << "fixings = " << fixings[i] << "\ttype = " << optionType << "\tplain Sobol value is "
+                      << outputs[0] << "\ttheoretical value is " << golden << std::endl;
+            if (std::fabs(outputs[0] - golden) > qmcErr) {
+                std::cout << "Output of plain Sobol points is wrong!" << std::endl;
+                nerror++;
+            }
+        }
+    }
+    return nerror;
+}
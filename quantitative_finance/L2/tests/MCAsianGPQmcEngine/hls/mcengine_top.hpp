@@ -0,0 +1,40 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _XF_FINTECH_MCENGINE_TOP_HPP_
+#define _XF_FINTECH_MCENGINE_TOP_HPP_
+
+#include "xf_fintech/enums.hpp"
+#include "xf_fintech/mc_engine.hpp"
+typedef double TEST_DT;
+// lanes, each one a randomization of the Sobol points
+#define UN 4
+// dimension of Sobol points, at least the time steps
+#define QMC_DIM 32
+void MCAsianGPQmcEngine_top(unsigned int timeSteps,
+                            TEST_DT timeLength,
+                            TEST_DT strike,
+                            TEST_DT volatility,
+                            TEST_DT underlying,
+                            TEST_DT riskFreeRate,
+                            TEST_DT dividendYield,
+                            unsigned int requiredSamples,
+                            unsigned int maxSamples,
+                            TEST_DT requiredTolerance,
+                            bool optionType,
+                            ap_uint<32> seed[UN],
+                            TEST_DT outputs[1]);
+
+#endif
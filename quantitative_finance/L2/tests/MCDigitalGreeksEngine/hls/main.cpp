@@ -0,0 +1,99 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <iostream>
+#include "mcengine_top.hpp"
+
+// Black-Scholes price and Greeks of the cash-or-nothing option as golden, theta is the derivative to t
+void digitalBlackScholes(TEST_DT s,
+                         TEST_DT k,
+                         TEST_DT r,
+                         TEST_DT q,
+                         TEST_DT v,
+                         TEST_DT t,
+                         TEST_DT cash,
+                         bool optionType,
+                         TEST_DT golden[6]) {
+    TEST_DT sd = v * std::sqrt(t);
+    TEST_DT d2 = (std::log(s / k) + (r - q) * t) / sd - 0.5 * sd;
+    TEST_DT d1 = d2 + sd;
+    // put: N(-d2) and the density term changes its sign
+    TEST_DT sign = optionType ? -1 : 1;
+    TEST_DT nd2 = 0.5 * std::erfc(-sign * d2 / std::sqrt(2.0));
+    TEST_DT pdf = sign * std::exp(-0.5 * d2 * d2) / std::sqrt(2 * M_PI);
+    TEST_DT df = cash * std::exp(-r * t);
+    golden[0] = df * nd2;
+    golden[1] = df * (-r * nd2 + pdf * ((r - q - 0.5 * v * v) / sd - d2 / (2 * t)));
+    golden[2] = df * (-t * nd2 + pdf * std::sqrt(t) / v);
+    golden[3] = df * pdf / (s * sd);
+    golden[4] = -df * pdf * d1 / (s * s * sd * sd);
+    golden[5] = -df * pdf * d1 / v;
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    TEST_DT underlying = 100;
+    TEST_DT volatility = 0.25;
+    TEST_DT dividendYield = 0.02;
+    TEST_DT riskFreeRate = 0.05;
+    TEST_DT timeLength = 1;
+    TEST_DT strike = 105;
+    TEST_DT cashPayoff = 10;
+    unsigned int timeSteps = 1;
+    TEST_DT requiredTolerance = 0.02;
+    unsigned int requiredSamples = run_csim ? (1 << 22) : 2048;
+    // price, theta, rho, delta, gamma and vega, relative to their scale
+    TEST_DT scale[6] = {cashPayoff, cashPayoff, cashPayoff, cashPayoff / underlying,
+                        cashPayoff / (underlying * underlying), cashPayoff};
+    // about 4 standard errors of 2^22 paths, gamma has the widest spread of the likelihood ratio estimates
+    TEST_DT relative_err[6] = {0.001, 0.001, 0.004, 0.004, 0.03, 0.008};
+    TEST_DT relax = run_csim ? 1 : 50;
+    const char* names[6] = {"price", "theta", "rho", "delta", "gamma", "vega"};
+
+    ap_uint<32> seeds[2];
+    seeds[0] = 1;
+    seeds[1] = 10001;
+
+    for (int p = 0; p < 2; ++p) {
+        bool optionType = p;
+        TEST_DT outputs[6];
+        MCDigitalGreeksEngine_top(underlying, volatility, dividendYield,
+                                  riskFreeRate, // model parameter
+                                  timeLength, strike, cashPayoff,
+                                  optionType, // option parameter
+                                  seeds, outputs, outputs + 1, requiredTolerance, requiredSamples, timeSteps);
+        TEST_DT golden[6];
+        digitalBlackScholes(underlying, strike, riskFreeRate, dividendYield, volatility, timeLength, cashPayoff,
+                            optionType, golden);
+        for (int k = 0; k < 6; ++k) {
+            TEST_DT diff = std::fabs(outputs[k] - golden[k]) / scale[k];
+            // compare with golden result
+            if (diff > relax * relative_err[k]) {
+                std::cout << "Output is wrong!" << std::endl;
+                std::cout << (optionType ? "Put option " : "Call option ") << names[k] << ":\n";
+                std::cout << "Acutal value: " << outputs[k] << ", Expected value: " << golden[k] << std::endl;
+                std::cout << "error: " << diff << ", tolerance: " << relax * relative_err[k] << std::endl;
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mc_euro_k.hpp"
+#include "mc_euro_k.hpp"
+
+extern "C" void mc_euro_grid_k(TEST_DT underlying,
+                               TEST_DT volatility,
+                               TEST_DT dividendYield,
+                               TEST_DT riskFreeRate, // model parameter
+                               TEST_DT timeLength,
+                               TEST_DT strike[MAX_GRID_PAYOFF],
+                               TEST_DT maturity[MAX_GRID_PAYOFF],
+                               unsigned int optionType[MAX_GRID_PAYOFF],
+                               unsigned int payoffNum, // option parameter
+                               ap_uint<32> seed[2],
+                               TEST_DT output[MAX_GRID_PAYOFF],
+                               TEST_DT requiredTolerance,
+                               unsigned int requiredSamples,
+                               unsigned int timeSteps) {
+#pragma HLS INTERFACE m_axi port = output bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = seed bundle = gmem1 offset = slave
+#pragma HLS INTERFACE m_axi port = strike bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = maturity bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = optionType bundle = gmem2 offset = slave
+
+#pragma HLS INTERFACE s_axilite port = underlying bundle = control
+#pragma HLS INTERFACE s_axilite port = volatility bundle = control
+#pragma HLS INTERFACE s_axilite port = dividendYield bundle = control
+#pragma HLS INTERFACE s_axilite port = riskFreeRate bundle = control
+#pragma HLS INTERFACE s_axilite port = timeLength bundle = control
+#pragma HLS INTERFACE s_axilite port = strike bundle = control
+#pragma HLS INTERFACE s_axilite port = maturity bundle = control
+#pragma HLS INTERFACE s_axilite port = optionType bundle = control
+#pragma HLS INTERFACE s_axilite port = payoffNum bundle = control
+#pragma HLS INTERFACE s_axilite port = seed bundle = control
+#pragma HLS INTERFACE s_axilite port = output bundle = control
+#pragma HLS INTERFACE s_axilite port = requiredTolerance bundle = control
+#pragma HLS INTERFACE s_axilite port = requiredSamples bundle = control
+#pragma HLS INTERFACE s_axilite port = timeSteps bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    // the grid is read once into local memory, the engine reads it per option
+    TEST_DT strikeBuff[MAX_GRID_PAYOFF];
+    TEST_DT maturityBuff[MAX_GRID_PAYOFF];
+    bool typeBuff[MAX_GRID_PAYOFF];
+    TEST_DT price[MAX_GRID_PAYOFF];
+    for (int k = 0; k < MAX_GRID_PAYOFF; ++k) {
+#pragma HLS pipeline
+        if (k < payoffNum) {
+            strikeBuff[k] = strike[k];
+            maturityBuff[k] = maturity[k];
+            typeBuff[k] = optionType[k];
+        }
+    }
+    xf::fintech::MCEuropeanGridEngine<TEST_DT, 2, MAX_GRID_PAYOFF>(underlying, volatility, dividendYield,
+                                                                  riskFreeRate, // model parameter
+                                                                  timeLength, strikeBuff, maturityBuff, typeBuff,
+                                                                  payoffNum, // option parameter
+                                                                  seed, price, requiredTolerance, requiredSamples,
+                                                                  timeSteps);
+    for (int k = 0; k < MAX_GRID_PAYOFF; ++k) {
+#pragma HLS pipeline
+        if (k < payoffNum) {
+            output[k] = price[k];
+        }
+    }
+}
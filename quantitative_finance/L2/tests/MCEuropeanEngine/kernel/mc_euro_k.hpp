@@ -20,6 +20,8 @@
 #include "xf_fintech/mc_engine.hpp"
 #include "xf_fintech/rng.hpp"
 typedef float TEST_DT;
+// the most options mc_euro_grid_k prices from one set of paths
+#define MAX_GRID_PAYOFF 64
 
 extern "C" void mc_euro_k(TEST_DT underlying,
                           TEST_DT volatility,
@@ -33,4 +35,32 @@ extern "C" void mc_euro_k(TEST_DT underlying,
                           TEST_DT requiredTolerance,
                           unsigned int requiredSamples,
                           unsigned int timeSteps);
+
+extern "C" void mc_euro_greeks_k(TEST_DT underlying,
+                                 TEST_DT volatility,
+                                 TEST_DT dividendYield,
+                                 TEST_DT riskFreeRate, // model parameter
+                                 TEST_DT timeLength,
+                                 TEST_DT strike,
+                                 unsigned int optionType, // option parameter
+                                 ap_uint<32> seed[2],
+                                 TEST_DT output[6],
+                                 TEST_DT requiredTolerance,
+                                 unsigned int requiredSamples,
+                                 unsigned int timeSteps);
+
+extern "C" void mc_euro_grid_k(TEST_DT underlying,
+                               TEST_DT volatility,
+                               TEST_DT dividendYield,
+                               TEST_DT riskFreeRate, // model parameter
+                               TEST_DT timeLength,
+                               TEST_DT strike[MAX_GRID_PAYOFF],
+                               TEST_DT maturity[MAX_GRID_PAYOFF],
+                               unsigned int optionType[MAX_GRID_PAYOFF],
+                               unsigned int payoffNum, // option parameter
+                               ap_uint<32> seed[2],
+                               TEST_DT output[MAX_GRID_PAYOFF],
+                               TEST_DT requiredTolerance,
+                               unsigned int requiredSamples,
+                               unsigned int timeSteps);
 #endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <iostream>
+#include "mcengine_top.hpp"
+
+// Black-Scholes price and Greeks as golden, theta is the derivative to t
+void blackScholes(
+    TEST_DT s, TEST_DT k, TEST_DT r, TEST_DT q, TEST_DT v, TEST_DT t, bool optionType, TEST_DT golden[6]) {
+    TEST_DT sd = v * std::sqrt(t);
+    TEST_DT d1 = (std::log(s / k) + (r - q) * t) / sd + 0.5 * sd;
+    TEST_DT d2 = d1 - sd;
+    TEST_DT nd1 = 0.5 * std::erfc(-d1 / std::sqrt(2.0));
+    TEST_DT nd2 = 0.5 * std::erfc(-d2 / std::sqrt(2.0));
+    TEST_DT pdf = std::exp(-0.5 * d1 * d1) / std::sqrt(2 * M_PI);
+    TEST_DT sq = s * std::exp(-q * t);
+    TEST_DT kr = k * std::exp(-r * t);
+    if (optionType) {
+        nd1 -= 1;
+        nd2 -= 1;
+    }
+    golden[0] = sq * nd1 - kr * nd2;
+    golden[1] = -q * sq * nd1 + r * kr * nd2 + 0.5 * sq * pdf * v / std::sqrt(t);
+    golden[2] = kr * t * nd2;
+    golden[3] = std::exp(-q * t) * nd1;
+    golden[4] = std::exp(-q * t) * pdf / (s * sd);
+    golden[5] = sq * pdf * std::sqrt(t);
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    TEST_DT underlying = 36;
+    TEST_DT volatility = 0.2;
+    TEST_DT dividendYield = 0.0;
+    TEST_DT riskFreeRate = 0.06;
+    TEST_DT timeLength = 1;
+    TEST_DT strike = 40;
+    unsigned int timeSteps = 1;
+    TEST_DT requiredTolerance = 0.02;
+    unsigned int requiredSamples = run_csim ? 65536 : 2048;
+    // price, theta, rho, delta, gamma and vega, relative to their scale
+    TEST_DT scale[6] = {underlying, underlying, underlying, 1, 1, underlying};
+    TEST_DT relative_err = run_csim ? 0.005 : 0.05;
+    const char* names[6] = {"price", "theta", "rho", "delta", "gamma", "vega"};
+
+    ap_uint<32> seeds[2];
+    seeds[0] = 1;
+    seeds[1] = 10001;
+
+    for (int p = 0; p < 2; ++p) {
+        bool optionType = p;
+        TEST_DT outputs[6];
+        MCEuropeanGreeksEngine_top(underlying, volatility, dividendYield,
+                                   riskFreeRate, // model parameter
+                                   timeLength, strike,
+                                   optionType, // option parameter
+                                   seeds, outputs, outputs + 1, requiredTolerance, requiredSamples, timeSteps);
+        TEST_DT golden[6];
+        blackScholes(underlying, strike, riskFreeRate, dividendYield, volatility, timeLength, optionType, golden);
+        for (int k = 0; k < 6; ++k) {
+            TEST_DT diff = std::fabs(outputs[k] - golden[k]) / scale[k];
+            // compare with golden result
+            if (diff > relative_err) {
+                std::cout << "Output is wrong!" << std::endl;
+                std::cout << (optionType ? "Put option " : "Call option ") << names[k] << ":\n";
+                std::cout << "Acutal value: " << outputs[k] << ", Expected value: " << golden[k] << std::endl;
+                std::cout << "error: " << diff << ", tolerance: " << relative_err << std::endl;
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
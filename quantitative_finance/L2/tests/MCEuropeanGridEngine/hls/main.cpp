@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <iostream>
+#include "mcengine_top.hpp"
+
+// Black-Scholes price as golden
+TEST_DT blackScholes(TEST_DT s, TEST_DT k, TEST_DT r, TEST_DT q, TEST_DT v, TEST_DT t, bool optionType) {
+    TEST_DT sd = v * std::sqrt(t);
+    TEST_DT d1 = (std::log(s / k) + (r - q) * t) / sd + 0.5 * sd;
+    TEST_DT d2 = d1 - sd;
+    TEST_DT nd1 = 0.5 * std::erfc(-d1 / std::sqrt(2.0));
+    TEST_DT nd2 = 0.5 * std::erfc(-d2 / std::sqrt(2.0));
+    TEST_DT call = s * std::exp(-q * t) * nd1 - k * std::exp(-r * t) * nd2;
+    if (optionType) return call - s * std::exp(-q * t) + k * std::exp(-r * t);
+    return call;
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    TEST_DT underlying = 100;
+    TEST_DT volatility = 0.2;
+    TEST_DT dividendYield = 0.02;
+    TEST_DT riskFreeRate = 0.05;
+    // paths run to the longest maturity, every maturity is a multiple of dt
+    TEST_DT timeLength = 1;
+    unsigned int timeSteps = 4;
+    TEST_DT maturities[] = {0.25, 0.5, 1.0};
+    TEST_DT requiredTolerance = 0.02;
+    unsigned int requiredSamples = run_csim ? 32768 : 2048;
+    TEST_DT relative_err = 0.01;
+
+    // smile of 5 strikes, call and put, at 3 maturities from the same paths
+    TEST_DT strikes[MAX_PAYOFF];
+    TEST_DT maturity[MAX_PAYOFF];
+    bool optionTypes[MAX_PAYOFF];
+    unsigned int payoffNum = 0;
+    for (int t = 0; t < 3; ++t) {
+        for (int i = 0; i < 5; ++i) {
+            for (int p = 0; p < 2; ++p) {
+                strikes[payoffNum] = 80 + 10 * i;
+                maturity[payoffNum] = maturities[t];
+                optionTypes[payoffNum] = p;
+                payoffNum++;
+            }
+        }
+    }
+
+    TEST_DT outputs[MAX_PAYOFF];
+    ap_uint<32> seeds[2];
+    seeds[0] = 1;
+    seeds[1] = 10001;
+
+    MCEuropeanGridEngine_top(underlying, volatility, dividendYield,
+                             riskFreeRate, // model parameter
+                             timeLength, strikes, maturity, optionTypes,
+                             payoffNum, // option parameter
+                             seeds, outputs, requiredTolerance, requiredSamples, timeSteps);
+
+    for (int k = 0; k < payoffNum; ++k) {
+        TEST_DT golden = blackScholes(underlying, strikes[k], riskFreeRate, dividendYield, volatility, maturity[k],
+                                      optionTypes[k]);
+        TEST_DT diff = std::fabs(outputs[k] - golden) / underlying;
+        // compare with golden result
+        if (diff > relative_err) {
+            std::cout << "Output is wrong!" << std::endl;
+            if (optionTypes[k])
+                std::cout << "Put option:\n";
+            else
+                std::cout << "Call option:\n";
+            std::cout << "   strike:              " << strikes[k] << "\n"
+                      << "   maturity:            " << maturity[k] << "\n";
+            std::cout << "Acutal value: " << outputs[k] << ", Expected value: " << golden << std::endl;
+            std::cout << "error: " << diff << ", tolerance: " << relative_err << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <iostream>
+#include "mcengine_top.hpp"
+
+#define LENGTH(a) (sizeof(a) / sizeof(a[0]))
+
+// Black-Scholes price of the European option
+TEST_DT bsPrice(bool optionType,
+                TEST_DT underlying,
+                TEST_DT strike,
+                TEST_DT riskFreeRate,
+                TEST_DT dividendYield,
+                TEST_DT volatility,
+                TEST_DT timeLength) {
+    TEST_DT sd = volatility * std::sqrt(timeLength);
+    TEST_DT d1 = (std::log(underlying / strike) + (riskFreeRate - dividendYield) * timeLength) / sd + sd / 2;
+    TEST_DT d2 = d1 - sd;
+    TEST_DT fwd = underlying * std::exp(-dividendYield * timeLength);
+    TEST_DT df = strike * std::exp(-riskFreeRate * timeLength);
+    if (optionType) {
+        return df * std::erfc(d2 / std::sqrt(2.0)) / 2 - fwd * std::erfc(d1 / std::sqrt(2.0)) / 2;
+    } else {
+        return fwd * std::erfc(-d1 / std::sqrt(2.0)) / 2 - df * std::erfc(-d2 / std::sqrt(2.0)) / 2;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    bool optionTypes[] = {false, true};
+    TEST_DT strikes[] = {75.0, 100.0, 125.0};
+    TEST_DT underlyings[] = {100};
+    TEST_DT riskFreeRates[] = {0.05};
+    TEST_DT volatilitys[] = {0.11, 0.30};
+    TEST_DT dividendYields[] = {0.02};
+
+    TEST_DT timeLength = 1;
+    // run to the tolerance, the standard error of the price
+    TEST_DT requiredTolerance = 0.05;
+    unsigned int requiredSamples = 0;
+    unsigned int timeSteps = 1;
+    // 4 standard errors
+    TEST_DT maxErr = 4 * requiredTolerance;
+
+    TEST_DT outputs[1];
+    // Philox seeds are substreams, adjacent ones do not overlap
+    ap_uint<32> seeds[2];
+    seeds[0] = 0;
+    seeds[1] = 1;
+
+    int opt_len, st_len, unly_len, r_len, d_len, vol_len;
+    if (run_csim) {
+        opt_len = LENGTH(optionTypes);
+        st_len = LENGTH(strikes);
+        unly_len = LENGTH(underlyings);
+        r_len = LENGTH(riskFreeRates);
+        d_len = LENGTH(dividendYields);
+        vol_len = LENGTH(volatilitys);
+    } else {
+        opt_len = 1;
+        st_len = 1;
+        unly_len = 1;
+        r_len = 1;
+        d_len = 1;
+        vol_len = 1;
+    }
+    int nerror = 0;
+    for (int i = 0; i < opt_len; ++i) {
+        for (int j = 0; j < st_len; ++j) {
+            for (int l = 0; l < unly_len; ++l) {
+                for (int m = 0; m < d_len; ++m) {
+                    for (int n = 0; n < r_len; ++n) {
+                        for (int p = 0; p < vol_len; ++p) {
+                            bool optionType = optionTypes[i];
+                            TEST_DT strike = strikes[j];
+                            TEST_DT underlying = underlyings[l];
+                            TEST_DT dividendYield = dividendYields[m];
+                            TEST_DT riskFreeRate = riskFreeRates[n];
+                            TEST_DT volatility = volatilitys[p];
+
+                            MCEuropeanPhiloxEngine_top(underlying, volatility, dividendYield,
+                                                       riskFreeRate, // model parameter
+                                                       timeLength, strike,
+                                                       optionType, // option parameter
+                                                       seeds, outputs, requiredTolerance, requiredSamples, timeSteps);
+
+                            TEST_DT golden = bsPrice(optionType, underlying, strike, riskFreeRate, dividendYield,
+                                                     volatility, timeLength);
+                            TEST_DT diff = std::fabs(outputs[0] - golden);
+                            if (diff > maxErr) {
+                                std::cout << "Output is wrong!" << std::endl;
+                                std::cout << (optionType ? "Put option:\n" : "Call option:\n")
+                                          << "   strike:              " << strike << "\n"
+                                          << "   underlying:          " << underlying << "\n"
+                                          << "   risk-free rate:      " << riskFreeRate << "\n"
+                                          << "   volatility:          " << volatility << "\n"
+                                          << "   dividend yield:      " << dividendYield << "\n"
+                                          << "   maturity:            " << timeLength << "\n"
+                                          << "   tolerance:           " << requiredTolerance << "\n";
+                                std::cout << "Acutal value: " << outputs[0] << ", Expected value: " << golden
+                                          << std::endl;
+                                std::cout << "error: " << diff << ", tolerance: " << maxErr << std::endl;
+                                nerror++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::cout << (nerror ? "FAIL" : "PASS") << ": " << nerror << " errors" << std::endl;
+    return nerror;
+}
@@ -89,6 +89,64 @@ class MCAmerican : public OCLController {
             unsigned int requiredSamples,
             double* pOptionPrice);
 
+    /*
+     * The number of assets in flight, each with its own set of buffers, so
+     * that one asset is pre-sampled while the previous one is priced...
+     */
+    static const int NUM_BUFFER_SETS = 2;
+
+    /**
+     * Process arrays of asset data until required TOLERANCE is met
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param requiredTolerance the required tolerance
+     * @param outputOptionPrice the option price
+     * @param numAssets the number of assets
+     *
+     */
+    int run(OptionType* optionType,
+            double* stockPrice,
+            double* strikePrice,
+            double* riskFreeRate,
+            double* dividendYield,
+            double* volatility,
+            double* timeToMaturity,
+            double* requiredTolerance,
+            double* outputOptionPrice,
+            unsigned int numAssets);
+
+    /**
+     * Process arrays of asset data for the REQUIRED NUMBER OF SAMPLES
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param requiredSamples the number of samples
+     * @param outputOptionPrice the option price
+     * @param numAssets the number of assets
+     *
+     */
+    int run(OptionType* optionType,
+            double* stockPrice,
+            double* strikePrice,
+            double* riskFreeRate,
+            double* dividendYield,
+            double* volatility,
+            double* timeToMaturity,
+            unsigned int* requiredSamples,
+            double* outputOptionPrice,
+            unsigned int numAssets);
+
    public:
     /**
      * This method returns the time the execution of the last call to run() took
@@ -114,6 +172,20 @@ class MCAmerican : public OCLController {
                     unsigned int requiredSamples,
                     double* pOptionPrice);
 
+    // Run multiple asset values, pipelined over the buffer sets...
+    // A null requiredTolerance or requiredSamples array means 0 for every asset.
+    int runInternal(OptionType* optionType,
+                    double* stockPrice,
+                    double* strikePrice,
+                    double* riskFreeRate,
+                    double* dividendYield,
+                    double* volatility,
+                    double* timeToMaturity,
+                    double* requiredTolerance,
+                    unsigned int* requiredSamples,
+                    double* outputOptionPrice,
+                    unsigned int numAssets);
+
    private:
     std::string getXCLBINName(Device* device);
 
@@ -125,28 +197,28 @@ class MCAmerican : public OCLController {
 
     cl::Program* m_pProgram;
 
-    uint8_t* m_hostOutputPricesBuffer;
-    uint8_t* m_hostOutputMatrixBuffer;
-    uint8_t* m_hostCoeffBuffer;
-    void* m_hostOutputBuffer1;
-    void* m_hostOutputBuffer2;
+    uint8_t* m_hostOutputPricesBuffer[NUM_BUFFER_SETS];
+    uint8_t* m_hostOutputMatrixBuffer[NUM_BUFFER_SETS];
+    uint8_t* m_hostCoeffBuffer[NUM_BUFFER_SETS];
+    void* m_hostOutputBuffer1[NUM_BUFFER_SETS];
+    void* m_hostOutputBuffer2[NUM_BUFFER_SETS];
 
     cl::Kernel* m_pPreSampleKernel;
     cl::Kernel* m_pCalibrationKernel;
     cl::Kernel* m_pPricingKernel1;
     cl::Kernel* m_pPricingKernel2;
 
-    cl_mem_ext_ptr_t m_outputPriceBufferOptions;
-    cl_mem_ext_ptr_t m_outputMatrixBufferOptions;
-    cl_mem_ext_ptr_t m_coeffBufferOptions;
-    cl_mem_ext_ptr_t m_outputBufferOptions1;
-    cl_mem_ext_ptr_t m_outputBufferOptions2;
-
-    cl::Buffer* m_pHWOutputPriceBuffer;
-    cl::Buffer* m_pHWOutputMatrixBuffer;
-    cl::Buffer* m_pHWCoeffBuffer;
-    cl::Buffer* m_pHWOutputBuffer1;
-    cl::Buffer* m_pHWOutputBuffer2;
+    cl_mem_ext_ptr_t m_outputPriceBufferOptions[NUM_BUFFER_SETS];
+    cl_mem_ext_ptr_t m_outputMatrixBufferOptions[NUM_BUFFER_SETS];
+    cl_mem_ext_ptr_t m_coeffBufferOptions[NUM_BUFFER_SETS];
+    cl_mem_ext_ptr_t m_outputBufferOptions1[NUM_BUFFER_SETS];
+    cl_mem_ext_ptr_t m_outputBufferOptions2[NUM_BUFFER_SETS];
+
+    cl::Buffer* m_pHWOutputPriceBuffer[NUM_BUFFER_SETS];
+    cl::Buffer* m_pHWOutputMatrixBuffer[NUM_BUFFER_SETS];
+    cl::Buffer* m_pHWCoeffBuffer[NUM_BUFFER_SETS];
+    cl::Buffer* m_pHWOutputBuffer1[NUM_BUFFER_SETS];
+    cl::Buffer* m_pHWOutputBuffer2[NUM_BUFFER_SETS];
 
    private:
     std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
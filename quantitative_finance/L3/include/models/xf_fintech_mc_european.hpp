@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include "xf_fintech_ocl_controller.hpp"
 #include "xf_fintech_types.hpp"
@@ -84,14 +85,88 @@ class MCEuropean : public OCLController {
             unsigned int requiredSamples,
             double* pOptionPrice);
 
+    /**
+     * Runs a single asset until the specified TOLERANCE is met, and returns the
+     * Greeks estimated on the same paths as the price. Needs the mc_euro_greeks_k
+     * kernel in the XCLBIN.
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param requiredTolerance the tolerance of the price
+     * @param pOptionPrice the returned option price
+     * @param pDelta the returned greek Delta
+     * @param pGamma the returned greek Gamma
+     * @param pVega the returned greek Vega
+     * @param pRho the returned greek Rho
+     * @param pTheta the returned greek Theta, the derivative to timeToMaturity
+     *
+     */
+    int run(OptionType optionType,
+            double stockPrice,
+            double strikePrice,
+            double riskFreeRate,
+            double dividendYield,
+            double volatility,
+            double timeToMaturity,
+            double requiredTolerance,
+            double* pOptionPrice,
+            double* pDelta,
+            double* pGamma,
+            double* pVega,
+            double* pRho,
+            double* pTheta);
+
+    /**
+     * Runs a single asset for the REQUIRED NUMBER OF SAMPLES, and returns the
+     * Greeks estimated on the same paths as the price. Needs the mc_euro_greeks_k
+     * kernel in the XCLBIN.
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param requiredSamples the number of samples
+     * @param pOptionPrice the returned option price
+     * @param pDelta the returned greek Delta
+     * @param pGamma the returned greek Gamma
+     * @param pVega the returned greek Vega
+     * @param pRho the returned greek Rho
+     * @param pTheta the returned greek Theta, the derivative to timeToMaturity
+     */
+    int run(OptionType optionType,
+            double stockPrice,
+            double strikePrice,
+            double riskFreeRate,
+            double dividendYield,
+            double volatility,
+            double timeToMaturity,
+            unsigned int requiredSamples,
+            double* pOptionPrice,
+            double* pDelta,
+            double* pGamma,
+            double* pVega,
+            double* pRho,
+            double* pTheta);
+
     /*
-     * The following constant defines the number of KERNELS that have been built
-     * in the HW...
+     * The number of assets kept in flight on each kernel, each with its own
+     * output buffer, so one is computed while the other is read back...
      */
-    static const int NUM_KERNELS = 1;
+    static const int NUM_BUFFERS_PER_KERNEL = 2;
 
     /**
-     * Process arrays of asset data until required TOLERANCE is met
+     * Process arrays of asset data until required TOLERANCE is met. When every
+     * asset has the same stock price, rates, volatility, maturity and tolerance,
+     * e.g. a smile of strikes, and the XCLBIN has the mc_euro_grid_k kernel, up
+     * to 64 of them are priced at once from one set of paths.
      *
      * @param optionType either American/European Call or Put
      * @param stockPrice the stock price
@@ -117,7 +192,11 @@ class MCEuropean : public OCLController {
             unsigned int numAssets);
 
     /**
-     * Process arrays of asset data for the REQUIRED NUMBER OF SAMPLES
+     * Process arrays of asset data for the REQUIRED NUMBER OF SAMPLES. When
+     * every asset has the same stock price, rates, volatility, maturity and
+     * number of samples, e.g. a smile of strikes, and the XCLBIN has the
+     * mc_euro_grid_k kernel, up to 64 of them are priced at once from
+     * one set of paths.
      *
      * @param optionType either American/European Call or Put
      * @param stockPrice the stock price
@@ -150,6 +229,13 @@ class MCEuropean : public OCLController {
      */
     long long int getLastRunTime(void);
 
+    /**
+     * This method returns the number of kernels found in the XCLBIN
+     *
+     * @returns Number of kernels the assets are spread over
+     */
+    int getNumKernels(void);
+
    private:
     // OCLController interface
     int createOCLObjects(Device* device);
@@ -168,7 +254,8 @@ class MCEuropean : public OCLController {
                     unsigned int requiredSamples,
                     double* pOptionPrice);
 
-    // Run multiple asset values...
+    // Run multiple asset values, pipelined over all kernels...
+    // A null requiredTolerance or requiredSamples array means 0 for every asset.
     int runInternal(OptionType* optionType,
                     double* stockPrice,
                     double* strikePrice,
@@ -181,6 +268,38 @@ class MCEuropean : public OCLController {
                     double* outputOptionPrice,
                     unsigned int numAssets);
 
+    // Run assets differing only in strike and type on the grid kernel, if any...
+    // Returns false, with nothing run, when they cannot share their paths.
+    bool runGridInternal(OptionType* optionType,
+                         double* stockPrice,
+                         double* strikePrice,
+                         double* riskFreeRate,
+                         double* dividendYield,
+                         double* volatility,
+                         double* timeToMaturity,
+                         double* requiredTolerance,
+                         unsigned int* requiredSamples,
+                         double* outputOptionPrice,
+                         unsigned int numAssets,
+                         int* pRetval);
+
+    // Run single asset values on the Greeks kernel...
+    int runGreeksInternal(OptionType optionType,
+                          double stockPrice,
+                          double strikePrice,
+                          double riskFreeRate,
+                          double dividendYield,
+                          double volatility,
+                          double timeToMaturity,
+                          double requiredTolerance,
+                          unsigned int requiredSamples,
+                          double* pOptionPrice,
+                          double* pDelta,
+                          double* pGamma,
+                          double* pVega,
+                          double* pRho,
+                          double* pTheta);
+
    private:
     std::string getXCLBINName(Device* device);
 
@@ -190,18 +309,39 @@ class MCEuropean : public OCLController {
     cl::Program::Binaries m_binaries;
     cl::Program* m_pProgram;
 
-    static const char* KERNEL_NAMES[NUM_KERNELS];
+    static const char* KERNEL_NAME;
+    static const char* GREEKS_KERNEL_NAME;
+    static const char* GRID_KERNEL_NAME;
 
-    cl::Kernel* m_pKernels[NUM_KERNELS];
+    // one per compute unit of mc_euro_k found when the device is claimed
+    std::vector<cl::Kernel*> m_pKernels;
 
-    void* m_hostOutputBuffers[NUM_KERNELS];
+    // one output buffer per slot, slot = buffer * number of kernels + kernel
+    std::vector<void*> m_hostOutputBuffers;
     unsigned int* m_hostSeed;
 
-    cl_mem_ext_ptr_t m_hwBufferOptions[NUM_KERNELS];
-    cl_mem_ext_ptr_t m_hwSeed;
+    std::vector<cl_mem_ext_ptr_t> m_hwBufferOptions;
+    std::vector<cl_mem_ext_ptr_t> m_hwSeed;
+
+    std::vector<cl::Buffer*> m_pHWBuffers;
+    std::vector<cl::Buffer*> m_pSeedBuf;
+
+    // null when the XCLBIN has no Greeks kernel
+    cl::Kernel* m_pGreeksKernel;
+    void* m_hostGreeksBuffer;
+    cl_mem_ext_ptr_t m_hwGreeksBufferOptions;
+    cl_mem_ext_ptr_t m_hwGreeksSeed;
+    cl::Buffer* m_pHWGreeksBuffer;
+    cl::Buffer* m_pGreeksSeedBuf;
 
-    cl::Buffer* m_pHWBuffers[NUM_KERNELS];
-    cl::Buffer* m_pSeedBuf;
+    // null when the XCLBIN has no grid kernel
+    cl::Kernel* m_pGridKernel;
+    void* m_hostGridStrike;
+    void* m_hostGridMaturity;
+    unsigned int* m_hostGridType;
+    void* m_hostGridOutput;
+    std::vector<cl_mem_ext_ptr_t> m_hwGridBufferOptions;
+    std::vector<cl::Buffer*> m_pHWGridBuffers;
 
    private:
     std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
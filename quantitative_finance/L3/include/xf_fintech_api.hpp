@@ -30,6 +30,7 @@
 
 #include "models/xf_fintech_cf_black_scholes.hpp"
 #include "models/xf_fintech_cf_black_scholes_merton.hpp"
+#include "models/xf_fintech_cf_black_scholes_implied_vol.hpp"
 #include "models/xf_fintech_cf_garman_kohlhagen.hpp"
 #include "models/xf_fintech_quanto.hpp"
 #include "models/xf_fintech_fd_heston.hpp"
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+# Ensure environmental variables i.e. paths are set to the named the modules
+from xf_fintech_python import DeviceManager, CFBlackScholesImpliedVol, OptionType
+
+# State test financial model
+print("\nThe CFBlack Scholes implied volatility solver\n==================================================\n")
+
+# Declaring Variables
+deviceList = DeviceManager.getDeviceList("u250")
+lastruntime = 0
+# Example financial data to test the module as used in the C++ example script
+# Inputs - a strip of put strikes, priced at 10% volatility
+optionPriceList = [0.4229, 1.2337, 2.8264, 5.3531, 8.7552]
+stockPriceList = [100.0] * 5
+strikePriceList = [90.0, 95.0, 100.0, 105.0, 110.0]
+riskFreeRateList = [0.025] * 5
+timeToMaturityList = [1.0] * 5
+dividendYieldList = [0.0] * 5
+numOptions = len(optionPriceList)
+# Outputs - declaring them as empty lists
+impliedVolatilityList = []
+
+
+# Identify which cards are installed and choose the first available U250 card, as defined in deviceList above
+print("Found these {0} device(s):".format(len(deviceList)))
+for x in deviceList:
+    print(x.getName())
+print("Choosing the first suitable card\n")
+chosenDevice = deviceList[0]
+
+# Selecting and loading into FPGA on chosen card the financial model to be used
+CFBlackScholesImpliedVol = CFBlackScholesImpliedVol(numOptions)   # warning the lower levels to accomodate at least this figure
+CFBlackScholesImpliedVol.claimDevice(chosenDevice)
+#Feed in the data and request the result
+print("\nRunning...")
+result = CFBlackScholesImpliedVol.run(optionPriceList, stockPriceList, strikePriceList, riskFreeRateList,
+                                      timeToMaturityList, dividendYieldList, impliedVolatilityList, OptionType.Put,
+                                      numOptions)
+print("Done")
+runtime = CFBlackScholesImpliedVol.lastruntime()
+
+#Format output to match the example in C++, simply to aid comparison of results
+print("+-------+-----------+-----------+---------------+")
+print("| Index | Strike    | Price     | Implied Vol   |")
+print("+-------+-----------+-----------+---------------+")
+for loop in range(0, numOptions) :
+    print(loop,"\t%9.5f"%strikePriceList[loop],"\t%9.5f"%optionPriceList[loop],"\t%9.5f"%impliedVolatilityList[loop])
+
+
+
+print("\nThis run took", str(runtime), "microseconds")
+
+#Relinquish ownership of the card
+CFBlackScholesImpliedVol.releaseDevice()
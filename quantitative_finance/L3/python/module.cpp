@@ -91,6 +91,36 @@ PYBIND11_MODULE(xf_fintech_python, m) {
                  return std::make_tuple(retval, optionPrice);
              })
 
+        .def("runGreeks",
+             [](MCEuropean& self, OptionType optionType, double stockPrice, double strikePrice, double riskFreeRate,
+                double dividendYield, double volatility, double timeToMaturity, double requiredTolerance) {
+                 int retval;
+                 double optionPrice, delta, gamma, vega, rho, theta;
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+
+                 retval = self.run(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                                   timeToMaturity, requiredTolerance, &optionPrice, &delta, &gamma, &vega, &rho,
+                                   &theta);
+
+                 return std::make_tuple(retval, optionPrice, delta, gamma, vega, rho, theta);
+             })
+
+        .def("runGreeks",
+             [](MCEuropean& self, OptionType optionType, double stockPrice, double strikePrice, double riskFreeRate,
+                double dividendYield, double volatility, double timeToMaturity, unsigned int requiredNumSamples) {
+                 int retval;
+                 double optionPrice, delta, gamma, vega, rho, theta;
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+
+                 retval = self.run(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                                   timeToMaturity, requiredNumSamples, &optionPrice, &delta, &gamma, &vega, &rho,
+                                   &theta);
+
+                 return std::make_tuple(retval, optionPrice, delta, gamma, vega, rho, theta);
+             })
+
         .def("run",
              [](MCEuropean& self, std::vector<OptionType> optionTypeList, std::vector<double> stockPriceList,
                 std::vector<double> strikePriceList, std::vector<double> riskFreeRateList,
@@ -166,6 +196,26 @@ PYBIND11_MODULE(xf_fintech_python, m) {
                                    timeToMaturity, requiredNumSamples, &optionPrice);
 
                  return std::make_tuple(retval, optionPrice);
+             })
+
+        .def("run",
+             [](MCAmerican& self, std::vector<OptionType> optionTypeList, std::vector<double> stockPriceList,
+                std::vector<double> strikePriceList, std::vector<double> riskFreeRateList,
+                std::vector<double> dividendYieldList, std::vector<double> volatilityList,
+                std::vector<double> timeToMaturityList, std::vector<double> requiredToleranceList) {
+                 int retval;
+                 unsigned int numAssets = stockPriceList.size(); // use the length of the stock price list to determine
+                                                                 // how many assets we are dealing with...
+                 std::vector<double> optionPriceVector(numAssets);
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+
+                 retval = self.run(optionTypeList.data(), stockPriceList.data(), strikePriceList.data(),
+                                   riskFreeRateList.data(), dividendYieldList.data(), volatilityList.data(),
+                                   timeToMaturityList.data(), requiredToleranceList.data(), optionPriceVector.data(),
+                                   numAssets);
+
+                 return std::make_tuple(retval, optionPriceVector);
              });
 
     py::class_<MCEuropeanDJE>(m, "MCEuropeanDJE")
@@ -436,6 +486,46 @@ PYBIND11_MODULE(xf_fintech_python, m) {
                  return retval;
              });
 
+    py::class_<CFBlackScholesImpliedVol>(m, "CFBlackScholesImpliedVol")
+        .def(py::init<unsigned int>())
+
+        .def("claimDevice", &CFBlackScholesImpliedVol::claimDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("releaseDevice", &CFBlackScholesImpliedVol::releaseDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("deviceIsPrepared", &CFBlackScholesImpliedVol::deviceIsPrepared,
+             py::call_guard<py::scoped_ostream_redirect>())
+        .def("lastruntime", &CFBlackScholesImpliedVol::getLastRunTime)
+
+        .def("run",
+             [](CFBlackScholesImpliedVol& self, std::vector<float> optionPriceList, std::vector<float> stockPriceList,
+                std::vector<float> strikePriceList, std::vector<float> riskFreeRateList,
+                std::vector<float> timeToMaturityList, std::vector<float> dividendYieldList,
+                // Above are Input Buffers   - Below is the Output Buffer
+                py::list impliedVolatilityList,
+                // Underneath is just the format chosen, as using the C++ example
+                OptionType optionType, unsigned int numOptions)
+
+             {
+                 int retval;
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+                 for (unsigned int i = 0; i < numOptions; i++) {
+                     self.optionPrice[i] = optionPriceList[i];
+                     self.stockPrice[i] = stockPriceList[i];
+                     self.strikePrice[i] = strikePriceList[i];
+                     self.riskFreeRate[i] = riskFreeRateList[i];
+                     self.timeToMaturity[i] = timeToMaturityList[i];
+                     self.dividendYield[i] = dividendYieldList[i];
+                 }
+                 retval = self.run(optionType, numOptions);
+
+                 // so after the execution these should be filled with results -> transfer to python lists
+                 for (unsigned int i = 0; i < numOptions; i++) {
+                     impliedVolatilityList.append(self.impliedVolatility[i]);
+                 }
+
+                 return retval;
+             });
+
     py::class_<CFQuanto>(m, "Quanto")
         .def(py::init<unsigned int>())
 
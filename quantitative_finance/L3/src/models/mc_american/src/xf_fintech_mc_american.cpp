@@ -51,22 +51,24 @@ MCAmerican::MCAmerican() {
     m_pCommandQueue = nullptr;
     m_pProgram = nullptr;
 
-    m_hostOutputPricesBuffer = nullptr;
-    m_hostOutputMatrixBuffer = nullptr;
-    m_hostCoeffBuffer = nullptr;
-    m_hostOutputBuffer1 = nullptr;
-    m_hostOutputBuffer2 = nullptr;
-
     m_pPreSampleKernel = nullptr;
     m_pCalibrationKernel = nullptr;
     m_pPricingKernel1 = nullptr;
     m_pPricingKernel2 = nullptr;
 
-    m_pHWOutputPriceBuffer = nullptr;
-    m_pHWOutputMatrixBuffer = nullptr;
-    m_pHWCoeffBuffer = nullptr;
-    m_pHWOutputBuffer1 = nullptr;
-    m_pHWOutputBuffer2 = nullptr;
+    for (int i = 0; i < NUM_BUFFER_SETS; i++) {
+        m_hostOutputPricesBuffer[i] = nullptr;
+        m_hostOutputMatrixBuffer[i] = nullptr;
+        m_hostCoeffBuffer[i] = nullptr;
+        m_hostOutputBuffer1[i] = nullptr;
+        m_hostOutputBuffer2[i] = nullptr;
+
+        m_pHWOutputPriceBuffer[i] = nullptr;
+        m_pHWOutputMatrixBuffer[i] = nullptr;
+        m_pHWCoeffBuffer[i] = nullptr;
+        m_pHWOutputBuffer1[i] = nullptr;
+        m_pHWOutputBuffer2[i] = nullptr;
+    }
 }
 
 MCAmerican::~MCAmerican() {
@@ -112,7 +114,8 @@ int MCAmerican::createOCLObjects(Device* device) {
     m_pContext = new cl::Context(clDevice, nullptr, nullptr, nullptr, &cl_retval);
 
     if (cl_retval == CL_SUCCESS) {
-        m_pCommandQueue = new cl::CommandQueue(*m_pContext, clDevice, CL_QUEUE_PROFILING_ENABLE, &cl_retval);
+        m_pCommandQueue = new cl::CommandQueue(
+            *m_pContext, clDevice, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE, &cl_retval);
     }
 
     if (cl_retval == CL_SUCCESS) {
@@ -168,37 +171,16 @@ int MCAmerican::createOCLObjects(Device* device) {
     //////////////////////////
     // Allocate HOST BUFFERS
     //////////////////////////
-    if (cl_retval == CL_SUCCESS) {
-        m_hostOutputPricesBuffer = u8_allocator.allocate(PRICE_ELEMENT_SIZE * PRICE_NUM_ELEMENTS);
-        if (m_hostOutputPricesBuffer == nullptr) {
-            cl_retval = CL_OUT_OF_HOST_MEMORY;
-        }
-    }
-
-    if (cl_retval == CL_SUCCESS) {
-        m_hostOutputMatrixBuffer = u8_allocator.allocate(MATRIX_ELEMENT_SIZE * MATRIX_NUM_ELEMENTS);
-        if (m_hostOutputMatrixBuffer == nullptr) {
-            cl_retval = CL_OUT_OF_HOST_MEMORY;
-        }
-    }
-
-    if (cl_retval == CL_SUCCESS) {
-        m_hostCoeffBuffer = u8_allocator.allocate(COEFF_ELEMENT_SIZE * COEFF_NUM_ELEMENTS);
-        if (m_hostCoeffBuffer == nullptr) {
-            cl_retval = CL_OUT_OF_HOST_MEMORY;
-        }
-    }
-
-    if (cl_retval == CL_SUCCESS) {
-        m_hostOutputBuffer1 = kdatatype_allocator.allocate(1);
-        if (m_hostOutputBuffer1 == nullptr) {
-            cl_retval = CL_OUT_OF_HOST_MEMORY;
-        }
-    }
-
-    if (cl_retval == CL_SUCCESS) {
-        m_hostOutputBuffer2 = kdatatype_allocator.allocate(1);
-        if (m_hostOutputBuffer2 == nullptr) {
+    for (int i = 0; i < NUM_BUFFER_SETS && cl_retval == CL_SUCCESS; i++) {
+        m_hostOutputPricesBuffer[i] = u8_allocator.allocate(PRICE_ELEMENT_SIZE * PRICE_NUM_ELEMENTS);
+        m_hostOutputMatrixBuffer[i] = u8_allocator.allocate(MATRIX_ELEMENT_SIZE * MATRIX_NUM_ELEMENTS);
+        m_hostCoeffBuffer[i] = u8_allocator.allocate(COEFF_ELEMENT_SIZE * COEFF_NUM_ELEMENTS);
+        m_hostOutputBuffer1[i] = kdatatype_allocator.allocate(1);
+        m_hostOutputBuffer2[i] = kdatatype_allocator.allocate(1);
+
+        if (m_hostOutputPricesBuffer[i] == nullptr || m_hostOutputMatrixBuffer[i] == nullptr ||
+            m_hostCoeffBuffer[i] == nullptr || m_hostOutputBuffer1[i] == nullptr ||
+            m_hostOutputBuffer2[i] == nullptr) {
             cl_retval = CL_OUT_OF_HOST_MEMORY;
         }
     }
@@ -207,44 +189,47 @@ int MCAmerican::createOCLObjects(Device* device) {
     // Setup HW BUFFER OPTIONS
     ////////////////////////////
     if (cl_retval == CL_SUCCESS) {
-        m_outputPriceBufferOptions = {XCL_MEM_DDR_BANK0, m_hostOutputPricesBuffer, 0};
-        m_outputMatrixBufferOptions = {XCL_MEM_DDR_BANK1, m_hostOutputMatrixBuffer, 0};
-        m_coeffBufferOptions = {XCL_MEM_DDR_BANK2, m_hostCoeffBuffer, 0};
-        m_outputBufferOptions1 = {XCL_MEM_DDR_BANK3, m_hostOutputBuffer1, 0};
-        m_outputBufferOptions2 = {XCL_MEM_DDR_BANK3, m_hostOutputBuffer2, 0};
+        for (int i = 0; i < NUM_BUFFER_SETS; i++) {
+            m_outputPriceBufferOptions[i] = {XCL_MEM_DDR_BANK0, m_hostOutputPricesBuffer[i], 0};
+            m_outputMatrixBufferOptions[i] = {XCL_MEM_DDR_BANK1, m_hostOutputMatrixBuffer[i], 0};
+            m_coeffBufferOptions[i] = {XCL_MEM_DDR_BANK2, m_hostCoeffBuffer[i], 0};
+            m_outputBufferOptions1[i] = {XCL_MEM_DDR_BANK3, m_hostOutputBuffer1[i], 0};
+            m_outputBufferOptions2[i] = {XCL_MEM_DDR_BANK3, m_hostOutputBuffer2[i], 0};
+        }
     }
 
     ////////////////////////////////
     // Allocate HW BUFFER Objects
     ////////////////////////////////
-    if (cl_retval == CL_SUCCESS) {
-        m_pHWOutputPriceBuffer =
+    for (int i = 0; i < NUM_BUFFER_SETS && cl_retval == CL_SUCCESS; i++) {
+        m_pHWOutputPriceBuffer[i] =
             new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
-                           (PRICE_ELEMENT_SIZE * PRICE_NUM_ELEMENTS), &m_outputPriceBufferOptions, &cl_retval);
-    }
+                           (PRICE_ELEMENT_SIZE * PRICE_NUM_ELEMENTS), &m_outputPriceBufferOptions[i], &cl_retval);
 
-    if (cl_retval == CL_SUCCESS) {
-        m_pHWOutputMatrixBuffer =
-            new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
-                           (MATRIX_ELEMENT_SIZE * MATRIX_NUM_ELEMENTS), &m_outputMatrixBufferOptions, &cl_retval);
-    }
+        if (cl_retval == CL_SUCCESS) {
+            m_pHWOutputMatrixBuffer[i] =
+                new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
+                               (MATRIX_ELEMENT_SIZE * MATRIX_NUM_ELEMENTS), &m_outputMatrixBufferOptions[i],
+                               &cl_retval);
+        }
 
-    if (cl_retval == CL_SUCCESS) {
-        m_pHWCoeffBuffer =
-            new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
-                           (COEFF_ELEMENT_SIZE * COEFF_NUM_ELEMENTS), &m_coeffBufferOptions, &cl_retval);
-    }
+        if (cl_retval == CL_SUCCESS) {
+            m_pHWCoeffBuffer[i] =
+                new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
+                               (COEFF_ELEMENT_SIZE * COEFF_NUM_ELEMENTS), &m_coeffBufferOptions[i], &cl_retval);
+        }
 
-    if (cl_retval == CL_SUCCESS) {
-        m_pHWOutputBuffer1 =
-            new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
-                           sizeof(KDataType), &m_outputBufferOptions1, &cl_retval);
-    }
+        if (cl_retval == CL_SUCCESS) {
+            m_pHWOutputBuffer1[i] =
+                new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
+                               sizeof(KDataType), &m_outputBufferOptions1[i], &cl_retval);
+        }
 
-    if (cl_retval == CL_SUCCESS) {
-        m_pHWOutputBuffer2 =
-            new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
-                           sizeof(KDataType), &m_outputBufferOptions2, &cl_retval);
+        if (cl_retval == CL_SUCCESS) {
+            m_pHWOutputBuffer2[i] =
+                new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
+                               sizeof(KDataType), &m_outputBufferOptions2[i], &cl_retval);
+        }
     }
 
     if (cl_retval != CL_SUCCESS) {
@@ -261,54 +246,56 @@ int MCAmerican::releaseOCLObjects(void) {
     aligned_allocator<uint8_t> u8_allocator;
     aligned_allocator<KDataType> kdatatype_allocator;
 
-    if (m_pHWOutputPriceBuffer != nullptr) {
-        delete (m_pHWOutputPriceBuffer);
-        m_pHWOutputPriceBuffer = nullptr;
-    }
+    for (i = 0; i < NUM_BUFFER_SETS; i++) {
+        if (m_pHWOutputPriceBuffer[i] != nullptr) {
+            delete (m_pHWOutputPriceBuffer[i]);
+            m_pHWOutputPriceBuffer[i] = nullptr;
+        }
 
-    if (m_pHWOutputMatrixBuffer != nullptr) {
-        delete (m_pHWOutputMatrixBuffer);
-        m_pHWOutputMatrixBuffer = nullptr;
-    }
+        if (m_pHWOutputMatrixBuffer[i] != nullptr) {
+            delete (m_pHWOutputMatrixBuffer[i]);
+            m_pHWOutputMatrixBuffer[i] = nullptr;
+        }
 
-    if (m_pHWCoeffBuffer != nullptr) {
-        delete (m_pHWCoeffBuffer);
-        m_pHWCoeffBuffer = nullptr;
-    }
+        if (m_pHWCoeffBuffer[i] != nullptr) {
+            delete (m_pHWCoeffBuffer[i]);
+            m_pHWCoeffBuffer[i] = nullptr;
+        }
 
-    if (m_pHWOutputBuffer1 != nullptr) {
-        delete (m_pHWOutputBuffer1);
-        m_pHWOutputBuffer1 = nullptr;
-    }
+        if (m_pHWOutputBuffer1[i] != nullptr) {
+            delete (m_pHWOutputBuffer1[i]);
+            m_pHWOutputBuffer1[i] = nullptr;
+        }
 
-    if (m_pHWOutputBuffer2 != nullptr) {
-        delete (m_pHWOutputBuffer2);
-        m_pHWOutputBuffer2 = nullptr;
-    }
+        if (m_pHWOutputBuffer2[i] != nullptr) {
+            delete (m_pHWOutputBuffer2[i]);
+            m_pHWOutputBuffer2[i] = nullptr;
+        }
 
-    if (m_hostOutputPricesBuffer != nullptr) {
-        u8_allocator.deallocate(m_hostOutputPricesBuffer, PRICE_ELEMENT_SIZE * PRICE_NUM_ELEMENTS);
-        m_hostOutputPricesBuffer = nullptr;
-    }
+        if (m_hostOutputPricesBuffer[i] != nullptr) {
+            u8_allocator.deallocate(m_hostOutputPricesBuffer[i], PRICE_ELEMENT_SIZE * PRICE_NUM_ELEMENTS);
+            m_hostOutputPricesBuffer[i] = nullptr;
+        }
 
-    if (m_hostOutputMatrixBuffer != nullptr) {
-        u8_allocator.deallocate(m_hostOutputMatrixBuffer, MATRIX_ELEMENT_SIZE * MATRIX_NUM_ELEMENTS);
-        m_hostOutputMatrixBuffer = nullptr;
-    }
+        if (m_hostOutputMatrixBuffer[i] != nullptr) {
+            u8_allocator.deallocate(m_hostOutputMatrixBuffer[i], MATRIX_ELEMENT_SIZE * MATRIX_NUM_ELEMENTS);
+            m_hostOutputMatrixBuffer[i] = nullptr;
+        }
 
-    if (m_hostCoeffBuffer != nullptr) {
-        u8_allocator.deallocate(m_hostCoeffBuffer, COEFF_ELEMENT_SIZE * COEFF_NUM_ELEMENTS);
-        m_hostCoeffBuffer = nullptr;
-    }
+        if (m_hostCoeffBuffer[i] != nullptr) {
+            u8_allocator.deallocate(m_hostCoeffBuffer[i], COEFF_ELEMENT_SIZE * COEFF_NUM_ELEMENTS);
+            m_hostCoeffBuffer[i] = nullptr;
+        }
 
-    if (m_hostOutputBuffer1 != nullptr) {
-        kdatatype_allocator.deallocate((KDataType*)m_hostOutputBuffer1, 1);
-        m_hostOutputBuffer1 = nullptr;
-    }
+        if (m_hostOutputBuffer1[i] != nullptr) {
+            kdatatype_allocator.deallocate((KDataType*)m_hostOutputBuffer1[i], 1);
+            m_hostOutputBuffer1[i] = nullptr;
+        }
 
-    if (m_hostOutputBuffer2 != nullptr) {
-        kdatatype_allocator.deallocate((KDataType*)m_hostOutputBuffer2, 1);
-        m_hostOutputBuffer2 = nullptr;
+        if (m_hostOutputBuffer2[i] != nullptr) {
+            kdatatype_allocator.deallocate((KDataType*)m_hostOutputBuffer2[i], 1);
+            m_hostOutputBuffer2[i] = nullptr;
+        }
     }
 
     if (m_pPreSampleKernel != nullptr) {
@@ -411,6 +398,38 @@ int MCAmerican::run(OptionType optionType,
     return retval = XLNX_OK;
 }
 
+int MCAmerican::run(OptionType* optionType,
+                    double* stockPrice,
+                    double* strikePrice,
+                    double* riskFreeRate,
+                    double* dividendYield,
+                    double* volatility,
+                    double* timeToMaturity,
+                    double* requiredTolerance,
+                    double* outputOptionPrice,
+                    unsigned int numAssets) {
+    // since this method only exposes requiredTolerance, requiredSamples is null,
+    // i.e. 0 for every asset
+    return runInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                       requiredTolerance, nullptr, outputOptionPrice, numAssets);
+}
+
+int MCAmerican::run(OptionType* optionType,
+                    double* stockPrice,
+                    double* strikePrice,
+                    double* riskFreeRate,
+                    double* dividendYield,
+                    double* volatility,
+                    double* timeToMaturity,
+                    unsigned int* requiredSamples,
+                    double* outputOptionPrice,
+                    unsigned int numAssets) {
+    // since this method only exposes requiredSamples, requiredTolerance is null,
+    // i.e. 0.0 for every asset
+    return runInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                       nullptr, requiredSamples, outputOptionPrice, numAssets);
+}
+
 int MCAmerican::runInternal(OptionType optionType,
                             double stockPrice,
                             double strikePrice,
@@ -421,106 +440,169 @@ int MCAmerican::runInternal(OptionType optionType,
                             double requiredTolerance,
                             unsigned int requiredSamples,
                             double* pOptionPrice) {
+    return runInternal(&optionType, &stockPrice, &strikePrice, &riskFreeRate, &dividendYield, &volatility,
+                       &timeToMaturity, &requiredTolerance, &requiredSamples, pOptionPrice, 1);
+}
+
+int MCAmerican::runInternal(OptionType* optionType,
+                            double* stockPrice,
+                            double* strikePrice,
+                            double* riskFreeRate,
+                            double* dividendYield,
+                            double* volatility,
+                            double* timeToMaturity,
+                            double* requiredTolerance,
+                            unsigned int* requiredSamples,
+                            double* outputOptionPrice,
+                            unsigned int numAssets) {
     int retval = XLNX_OK;
-    std::vector<cl::Memory> outputObjects;
+    cl_int cl_retval = CL_SUCCESS;
+    unsigned int i;
 
     unsigned int timeSteps = TIMESTEPS;
 
     unsigned int calibrateSamples = 4096;
 
+    // Asset i uses buffer set i % NUM_BUFFER_SETS. Its kernels are chained by
+    // events rather than finish(), so the PRESAMPLE and CALIBRATION kernels of
+    // one asset run while the PRICING kernels of the previous one do.
+    cl::Event preSampleEvents[NUM_BUFFER_SETS];
+    cl::Event calibrationEvents[NUM_BUFFER_SETS];
+    cl::Event pricingEvents[NUM_BUFFER_SETS][2];
+    cl::Event readEvents[NUM_BUFFER_SETS];
+
     m_runStartTime = std::chrono::high_resolution_clock::now();
 
     if (deviceIsPrepared()) {
-        // --------------------
-        // Run PRESAMPLE kernel
-        // --------------------
-        m_pPreSampleKernel->setArg(0, (KDataType)stockPrice);
-        m_pPreSampleKernel->setArg(1, (KDataType)volatility);
-        m_pPreSampleKernel->setArg(2, (KDataType)riskFreeRate);
-        m_pPreSampleKernel->setArg(3, (KDataType)dividendYield);
-        m_pPreSampleKernel->setArg(4, (KDataType)timeToMaturity);
-        m_pPreSampleKernel->setArg(5, (KDataType)strikePrice);
-        m_pPreSampleKernel->setArg(6, optionType);
-        m_pPreSampleKernel->setArg(7, *m_pHWOutputPriceBuffer);
-        m_pPreSampleKernel->setArg(8, *m_pHWOutputMatrixBuffer);
-        m_pPreSampleKernel->setArg(9, calibrateSamples);
-        m_pPreSampleKernel->setArg(10, timeSteps);
-
-        m_pCommandQueue->enqueueTask(*m_pPreSampleKernel, nullptr, nullptr);
-
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
-
-        // ----------------------
-        // Run CALIBRATION kernel
-        // ----------------------
-        m_pCalibrationKernel->setArg(0, (KDataType)timeToMaturity);
-        m_pCalibrationKernel->setArg(1, (KDataType)riskFreeRate);
-        m_pCalibrationKernel->setArg(2, (KDataType)strikePrice);
-        m_pCalibrationKernel->setArg(3, optionType);
-        m_pCalibrationKernel->setArg(4, *m_pHWOutputPriceBuffer);
-        m_pCalibrationKernel->setArg(5, *m_pHWOutputMatrixBuffer);
-        m_pCalibrationKernel->setArg(6, *m_pHWCoeffBuffer);
-        m_pCalibrationKernel->setArg(7, calibrateSamples);
-        m_pCalibrationKernel->setArg(8, timeSteps);
-
-        m_pCommandQueue->enqueueTask(*m_pCalibrationKernel, nullptr, nullptr);
-
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
-
-        // -------------------
-        // Run PRICING kernels
-        // -------------------
-        m_pPricingKernel1->setArg(0, (KDataType)stockPrice);
-        m_pPricingKernel1->setArg(1, (KDataType)volatility);
-        m_pPricingKernel1->setArg(2, (KDataType)dividendYield);
-        m_pPricingKernel1->setArg(3, (KDataType)riskFreeRate);
-        m_pPricingKernel1->setArg(4, (KDataType)timeToMaturity);
-        m_pPricingKernel1->setArg(5, (KDataType)strikePrice);
-        m_pPricingKernel1->setArg(6, optionType);
-        m_pPricingKernel1->setArg(7, *m_pHWCoeffBuffer);
-        m_pPricingKernel1->setArg(8, *m_pHWOutputBuffer1);
-        m_pPricingKernel1->setArg(9, (KDataType)requiredTolerance);
-        m_pPricingKernel1->setArg(10, requiredSamples);
-        m_pPricingKernel1->setArg(11, timeSteps);
-
-        m_pCommandQueue->enqueueTask(*m_pPricingKernel1, nullptr, nullptr);
-
-        m_pPricingKernel2->setArg(0, (KDataType)stockPrice);
-        m_pPricingKernel2->setArg(1, (KDataType)volatility);
-        m_pPricingKernel2->setArg(2, (KDataType)dividendYield);
-        m_pPricingKernel2->setArg(3, (KDataType)riskFreeRate);
-        m_pPricingKernel2->setArg(4, (KDataType)timeToMaturity);
-        m_pPricingKernel2->setArg(5, (KDataType)strikePrice);
-        m_pPricingKernel2->setArg(6, optionType);
-        m_pPricingKernel2->setArg(7, *m_pHWCoeffBuffer);
-        m_pPricingKernel2->setArg(8, *m_pHWOutputBuffer2);
-        m_pPricingKernel2->setArg(9, (KDataType)requiredTolerance);
-        m_pPricingKernel2->setArg(10, requiredSamples);
-        m_pPricingKernel2->setArg(11, timeSteps);
-
-        m_pCommandQueue->enqueueTask(*m_pPricingKernel2, nullptr, nullptr);
-
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
-
-        // ----------------------------
-        // Migrate results back to host
-        // ----------------------------
-        outputObjects.clear();
-        outputObjects.push_back(*m_pHWOutputBuffer1);
-        outputObjects.push_back(*m_pHWOutputBuffer2);
-        m_pCommandQueue->enqueueMigrateMemObjects(outputObjects, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
-
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
-
-        // ----------------------------------------------------------------------------------------
-        // Average the outputs from the two pricing kernels, and give the result
-        // back to the caller
-        // ----------------------------------------------------------------------------------------
-        *pOptionPrice = (((KDataType*)m_hostOutputBuffer1)[0] + ((KDataType*)m_hostOutputBuffer2)[0]) / 2.0;
+        // NUM_BUFFER_SETS more passes than assets, the last ones only collect results
+        for (i = 0; i < numAssets + NUM_BUFFER_SETS && cl_retval == CL_SUCCESS; i++) {
+            unsigned int set = i % NUM_BUFFER_SETS;
+
+            // ----------------------------------------------------------------------------------------
+            // The asset that used this buffer set before has to be read back first. Average the
+            // outputs from the two pricing kernels, and give the result back to the caller
+            // ----------------------------------------------------------------------------------------
+            if (i >= NUM_BUFFER_SETS) {
+                unsigned int asset = i - NUM_BUFFER_SETS;
+
+                if (asset >= numAssets) {
+                    continue;
+                }
+
+                cl_retval = readEvents[set].wait();
+                if (cl_retval != CL_SUCCESS) {
+                    break; // out of loop
+                }
+
+                outputOptionPrice[asset] =
+                    (((KDataType*)m_hostOutputBuffer1[set])[0] + ((KDataType*)m_hostOutputBuffer2[set])[0]) / 2.0;
+            }
+
+            if (i >= numAssets) {
+                continue;
+            }
+
+            KDataType tolerance = (KDataType)(requiredTolerance != nullptr ? requiredTolerance[i] : 0.0);
+            unsigned int samples = requiredSamples != nullptr ? requiredSamples[i] : 0;
+
+            // --------------------
+            // Run PRESAMPLE kernel
+            // --------------------
+            m_pPreSampleKernel->setArg(0, (KDataType)stockPrice[i]);
+            m_pPreSampleKernel->setArg(1, (KDataType)volatility[i]);
+            m_pPreSampleKernel->setArg(2, (KDataType)riskFreeRate[i]);
+            m_pPreSampleKernel->setArg(3, (KDataType)dividendYield[i]);
+            m_pPreSampleKernel->setArg(4, (KDataType)timeToMaturity[i]);
+            m_pPreSampleKernel->setArg(5, (KDataType)strikePrice[i]);
+            m_pPreSampleKernel->setArg(6, optionType[i]);
+            m_pPreSampleKernel->setArg(7, *m_pHWOutputPriceBuffer[set]);
+            m_pPreSampleKernel->setArg(8, *m_pHWOutputMatrixBuffer[set]);
+            m_pPreSampleKernel->setArg(9, calibrateSamples);
+            m_pPreSampleKernel->setArg(10, timeSteps);
+
+            cl_retval = m_pCommandQueue->enqueueTask(*m_pPreSampleKernel, nullptr, &preSampleEvents[set]);
+
+            // ----------------------
+            // Run CALIBRATION kernel
+            // ----------------------
+            if (cl_retval == CL_SUCCESS) {
+                std::vector<cl::Event> waitEvents = {preSampleEvents[set]};
+
+                m_pCalibrationKernel->setArg(0, (KDataType)timeToMaturity[i]);
+                m_pCalibrationKernel->setArg(1, (KDataType)riskFreeRate[i]);
+                m_pCalibrationKernel->setArg(2, (KDataType)strikePrice[i]);
+                m_pCalibrationKernel->setArg(3, optionType[i]);
+                m_pCalibrationKernel->setArg(4, *m_pHWOutputPriceBuffer[set]);
+                m_pCalibrationKernel->setArg(5, *m_pHWOutputMatrixBuffer[set]);
+                m_pCalibrationKernel->setArg(6, *m_pHWCoeffBuffer[set]);
+                m_pCalibrationKernel->setArg(7, calibrateSamples);
+                m_pCalibrationKernel->setArg(8, timeSteps);
+
+                cl_retval = m_pCommandQueue->enqueueTask(*m_pCalibrationKernel, &waitEvents, &calibrationEvents[set]);
+            }
+
+            // -------------------
+            // Run PRICING kernels
+            // -------------------
+            if (cl_retval == CL_SUCCESS) {
+                std::vector<cl::Event> waitEvents = {calibrationEvents[set]};
+
+                m_pPricingKernel1->setArg(0, (KDataType)stockPrice[i]);
+                m_pPricingKernel1->setArg(1, (KDataType)volatility[i]);
+                m_pPricingKernel1->setArg(2, (KDataType)dividendYield[i]);
+                m_pPricingKernel1->setArg(3, (KDataType)riskFreeRate[i]);
+                m_pPricingKernel1->setArg(4, (KDataType)timeToMaturity[i]);
+                m_pPricingKernel1->setArg(5, (KDataType)strikePrice[i]);
+                m_pPricingKernel1->setArg(6, optionType[i]);
+                m_pPricingKernel1->setArg(7, *m_pHWCoeffBuffer[set]);
+                m_pPricingKernel1->setArg(8, *m_pHWOutputBuffer1[set]);
+                m_pPricingKernel1->setArg(9, tolerance);
+                m_pPricingKernel1->setArg(10, samples);
+                m_pPricingKernel1->setArg(11, timeSteps);
+
+                cl_retval = m_pCommandQueue->enqueueTask(*m_pPricingKernel1, &waitEvents, &pricingEvents[set][0]);
+
+                if (cl_retval == CL_SUCCESS) {
+                    m_pPricingKernel2->setArg(0, (KDataType)stockPrice[i]);
+                    m_pPricingKernel2->setArg(1, (KDataType)volatility[i]);
+                    m_pPricingKernel2->setArg(2, (KDataType)dividendYield[i]);
+                    m_pPricingKernel2->setArg(3, (KDataType)riskFreeRate[i]);
+                    m_pPricingKernel2->setArg(4, (KDataType)timeToMaturity[i]);
+                    m_pPricingKernel2->setArg(5, (KDataType)strikePrice[i]);
+                    m_pPricingKernel2->setArg(6, optionType[i]);
+                    m_pPricingKernel2->setArg(7, *m_pHWCoeffBuffer[set]);
+                    m_pPricingKernel2->setArg(8, *m_pHWOutputBuffer2[set]);
+                    m_pPricingKernel2->setArg(9, tolerance);
+                    m_pPricingKernel2->setArg(10, samples);
+                    m_pPricingKernel2->setArg(11, timeSteps);
+
+                    cl_retval =
+                        m_pCommandQueue->enqueueTask(*m_pPricingKernel2, &waitEvents, &pricingEvents[set][1]);
+                }
+            }
+
+            // ----------------------------
+            // Migrate results back to host
+            // ----------------------------
+            if (cl_retval == CL_SUCCESS) {
+                std::vector<cl::Memory> outputObjects = {*m_pHWOutputBuffer1[set], *m_pHWOutputBuffer2[set]};
+                std::vector<cl::Event> waitEvents = {pricingEvents[set][0], pricingEvents[set][1]};
+
+                cl_retval = m_pCommandQueue->enqueueMigrateMemObjects(outputObjects, CL_MIGRATE_MEM_OBJECT_HOST,
+                                                                      &waitEvents, &readEvents[set]);
+            }
+
+            if (cl_retval == CL_SUCCESS) {
+                cl_retval = m_pCommandQueue->flush();
+            }
+        }
+
+        if (cl_retval != CL_SUCCESS) {
+            m_pCommandQueue->finish();
+            setCLError(cl_retval);
+            Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
+            retval = XLNX_ERROR_OPENCL_CALL_ERROR;
+        }
     } else {
         retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
     }
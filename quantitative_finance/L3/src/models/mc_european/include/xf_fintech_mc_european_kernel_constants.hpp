@@ -21,5 +21,9 @@
 typedef float KDataType;
 #define MCM_NM (8)
 #define OUTDEP (1)
+// the price, then theta, rho, delta, gamma and vega
+#define GREEKS_OUTDEP (6)
+// the most options mc_euro_grid_k prices from one set of paths
+#define GRID_OUTDEP (64)
 
 #endif //_XF_FINTECH_MC_EUROPEAN_KERNEL_CONSTANTS_H_
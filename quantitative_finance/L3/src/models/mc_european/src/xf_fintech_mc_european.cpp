@@ -15,6 +15,7 @@
  */
 
 #include <limits.h>
+#include <algorithm>
 
 #include "xf_fintech_error_codes.hpp"
 #include "xf_fintech_trace.hpp"
@@ -25,8 +26,20 @@
 
 using namespace xf::fintech;
 
-// const char* MCEuropean::KERNEL_NAMES[] = {"kernel_mc_0", "kernel_mc_1", "kernel_mc_2", "kernel_mc_3"};
-const char* MCEuropean::KERNEL_NAMES[] = {"mc_euro_k"};
+// compute units are named mc_euro_k_1, mc_euro_k_2... when the XCLBIN has more than one
+const char* MCEuropean::KERNEL_NAME = "mc_euro_k";
+const char* MCEuropean::GREEKS_KERNEL_NAME = "mc_euro_greeks_k";
+const char* MCEuropean::GRID_KERNEL_NAME = "mc_euro_grid_k";
+
+// arguments of mc_euro_k and mc_euro_greeks_k the buffers are bound to, so that
+// each buffer is placed in the memory bank its compute unit is connected to
+static const unsigned int SEED_ARG_INDEX = 7;
+static const unsigned int OUTPUT_ARG_INDEX = 8;
+
+// arguments of mc_euro_grid_k the grid buffers are bound to, in the order of
+// m_pHWGridBuffers: strike, maturity, type, seed and output
+static const unsigned int GRID_ARG_INDEX[] = {5, 6, 7, 9, 10};
+static const unsigned int NUM_GRID_BUFFERS = sizeof(GRID_ARG_INDEX) / sizeof(GRID_ARG_INDEX[0]);
 
 typedef struct _XCLBINLookupElement {
     Device::DeviceType deviceType;
@@ -46,13 +59,18 @@ MCEuropean::MCEuropean() {
     m_pContext = nullptr;
     m_pCommandQueue = nullptr;
     m_pProgram = nullptr;
-
-    for (int i = 0; i < NUM_KERNELS; i++) {
-        m_pKernels[i] = nullptr;
-        m_hostOutputBuffers[i] = nullptr;
-        m_pHWBuffers[i] = nullptr;
-    }
-    m_pSeedBuf = nullptr;
+    m_hostSeed = nullptr;
+
+    m_pGreeksKernel = nullptr;
+    m_hostGreeksBuffer = nullptr;
+    m_pHWGreeksBuffer = nullptr;
+    m_pGreeksSeedBuf = nullptr;
+
+    m_pGridKernel = nullptr;
+    m_hostGridStrike = nullptr;
+    m_hostGridMaturity = nullptr;
+    m_hostGridType = nullptr;
+    m_hostGridOutput = nullptr;
 }
 
 MCEuropean::~MCEuropean() {
@@ -84,12 +102,15 @@ std::string MCEuropean::getXCLBINName(Device* device) {
 int MCEuropean::createOCLObjects(Device* device) {
     int retval = XLNX_OK;
     unsigned int i;
+    unsigned int numKernels = 0;
+    unsigned int numSlots = 0;
     cl_int cl_retval = CL_SUCCESS;
     std::chrono::time_point<std::chrono::high_resolution_clock> start;
     std::chrono::time_point<std::chrono::high_resolution_clock> end;
     aligned_allocator<KDataType> allocator;
     aligned_allocator<unsigned int> allocator_seed;
     std::string xclbinName;
+    std::vector<cl::Memory> seedVector;
 
     cl::Device clDevice;
 
@@ -143,12 +164,49 @@ int MCEuropean::createOCLObjects(Device* device) {
     // Create KERNEL Objects
     /////////////////////////
     if (cl_retval == CL_SUCCESS) {
-        for (i = 0; i < NUM_KERNELS; i++) {
-            m_pKernels[i] = new cl::Kernel(*m_pProgram, KERNEL_NAMES[i], &cl_retval);
-
-            if (cl_retval != CL_SUCCESS) {
+        // one kernel object per compute unit, as many as the XCLBIN has...
+        for (i = 1;; i++) {
+            std::string kernelName = std::string(KERNEL_NAME) + ":{" + KERNEL_NAME + "_" + std::to_string(i) + "}";
+            cl_int cu_retval = CL_SUCCESS;
+            cl::Kernel* pKernel = new cl::Kernel(*m_pProgram, kernelName.c_str(), &cu_retval);
+
+            if (cu_retval != CL_SUCCESS) {
+                delete (pKernel);
                 break; // out of loop
             }
+            m_pKernels.push_back(pKernel);
+        }
+
+        //...or the single compute unit named after the kernel
+        if (m_pKernels.empty()) {
+            m_pKernels.push_back(new cl::Kernel(*m_pProgram, KERNEL_NAME, &cl_retval));
+        }
+
+        numKernels = m_pKernels.size();
+        numSlots = numKernels * NUM_BUFFERS_PER_KERNEL;
+
+        Trace::printInfo("[XLNX] Number of Kernels = %u\n", numKernels);
+    }
+
+    // the Greeks kernel is optional, only the Greeks run() methods need it
+    if (cl_retval == CL_SUCCESS) {
+        cl_int greeks_retval = CL_SUCCESS;
+        m_pGreeksKernel = new cl::Kernel(*m_pProgram, GREEKS_KERNEL_NAME, &greeks_retval);
+
+        if (greeks_retval != CL_SUCCESS) {
+            delete (m_pGreeksKernel);
+            m_pGreeksKernel = nullptr;
+        }
+    }
+
+    // so is the grid kernel, the array run() methods fall back to mc_euro_k
+    if (cl_retval == CL_SUCCESS) {
+        cl_int grid_retval = CL_SUCCESS;
+        m_pGridKernel = new cl::Kernel(*m_pProgram, GRID_KERNEL_NAME, &grid_retval);
+
+        if (grid_retval != CL_SUCCESS) {
+            delete (m_pGridKernel);
+            m_pGridKernel = nullptr;
         }
     }
 
@@ -156,7 +214,9 @@ int MCEuropean::createOCLObjects(Device* device) {
     // Allocate HOST BUFFERS
     //////////////////////////
     if (cl_retval == CL_SUCCESS) {
-        for (i = 0; i < NUM_KERNELS; i++) {
+        m_hostOutputBuffers.assign(numSlots, nullptr);
+
+        for (i = 0; i < numSlots; i++) {
             m_hostOutputBuffers[i] = allocator.allocate(OUTDEP);
 
             if (m_hostOutputBuffers[i] == nullptr) {
@@ -172,29 +232,56 @@ int MCEuropean::createOCLObjects(Device* device) {
         m_hostSeed[1] = 10001;
     }
 
+    if (cl_retval == CL_SUCCESS && m_pGreeksKernel != nullptr) {
+        m_hostGreeksBuffer = allocator.allocate(GREEKS_OUTDEP);
+
+        if (m_hostGreeksBuffer == nullptr) {
+            cl_retval = CL_OUT_OF_HOST_MEMORY;
+        }
+    }
+
+    if (cl_retval == CL_SUCCESS && m_pGridKernel != nullptr) {
+        m_hostGridStrike = allocator.allocate(GRID_OUTDEP);
+        m_hostGridMaturity = allocator.allocate(GRID_OUTDEP);
+        m_hostGridType = allocator_seed.allocate(GRID_OUTDEP);
+        m_hostGridOutput = allocator.allocate(GRID_OUTDEP);
+
+        if (m_hostGridStrike == nullptr || m_hostGridMaturity == nullptr || m_hostGridType == nullptr ||
+            m_hostGridOutput == nullptr) {
+            cl_retval = CL_OUT_OF_HOST_MEMORY;
+        }
+    }
+
     ////////////////////////////
     // Setup HW BUFFER OPTIONS
     ////////////////////////////
+    // each buffer is bound to the argument of the kernel that uses it, and the
+    // runtime places it in the bank that compute unit is connected to
     if (cl_retval == CL_SUCCESS) {
-        if (NUM_KERNELS >= 1) {
-            m_hwBufferOptions[0] = {XCL_MEM_DDR_BANK0, m_hostOutputBuffers[0], 0};
-        }
+        m_hwBufferOptions.resize(numSlots);
+        m_hwSeed.resize(numKernels);
 
-        if (NUM_KERNELS >= 2) {
-            m_hwBufferOptions[1] = {XCL_MEM_DDR_BANK1, m_hostOutputBuffers[1], 0};
+        for (i = 0; i < numSlots; i++) {
+            m_hwBufferOptions[i] = {OUTPUT_ARG_INDEX, m_hostOutputBuffers[i], (*m_pKernels[i % numKernels])()};
         }
-
-        if (NUM_KERNELS >= 3) {
-            m_hwBufferOptions[2] = {XCL_MEM_DDR_BANK2, m_hostOutputBuffers[2], 0};
+        for (i = 0; i < numKernels; i++) {
+            m_hwSeed[i] = {SEED_ARG_INDEX, m_hostSeed, (*m_pKernels[i])()};
         }
 
-        if (NUM_KERNELS >= 4) {
-            m_hwBufferOptions[3] = {XCL_MEM_DDR_BANK3, m_hostOutputBuffers[3], 0};
+        if (m_pGreeksKernel != nullptr) {
+            m_hwGreeksBufferOptions = {OUTPUT_ARG_INDEX, m_hostGreeksBuffer, (*m_pGreeksKernel)()};
+            m_hwGreeksSeed = {SEED_ARG_INDEX, m_hostSeed, (*m_pGreeksKernel)()};
         }
-    }
 
-    if (cl_retval == CL_SUCCESS) {
-        m_hwSeed = {XCL_MEM_DDR_BANK0, m_hostSeed, 0};
+        if (m_pGridKernel != nullptr) {
+            void* hostGridBuffers[NUM_GRID_BUFFERS] = {m_hostGridStrike, m_hostGridMaturity, m_hostGridType,
+                                                       m_hostSeed, m_hostGridOutput};
+
+            m_hwGridBufferOptions.resize(NUM_GRID_BUFFERS);
+            for (i = 0; i < NUM_GRID_BUFFERS; i++) {
+                m_hwGridBufferOptions[i] = {GRID_ARG_INDEX[i], hostGridBuffers[i], (*m_pGridKernel)()};
+            }
+        }
     }
 
     ////////////////////////////////
@@ -202,7 +289,9 @@ int MCEuropean::createOCLObjects(Device* device) {
     ////////////////////////////////
 
     if (cl_retval == CL_SUCCESS) {
-        for (i = 0; i < NUM_KERNELS; i++) {
+        m_pHWBuffers.assign(numSlots, nullptr);
+
+        for (i = 0; i < numSlots; i++) {
             m_pHWBuffers[i] =
                 new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
                                (size_t)(OUTDEP * sizeof(KDataType)), &m_hwBufferOptions[i], &cl_retval);
@@ -214,8 +303,64 @@ int MCEuropean::createOCLObjects(Device* device) {
     }
 
     if (cl_retval == CL_SUCCESS) {
-        m_pSeedBuf = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
-                                    sizeof(unsigned int), &m_hwSeed, &cl_retval);
+        m_pSeedBuf.assign(numKernels, nullptr);
+
+        for (i = 0; i < numKernels; i++) {
+            m_pSeedBuf[i] = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                           2 * sizeof(unsigned int), &m_hwSeed[i], &cl_retval);
+
+            if (cl_retval != CL_SUCCESS) {
+                break; // out of loop
+            }
+            seedVector.push_back(*(m_pSeedBuf[i]));
+        }
+    }
+
+    if (cl_retval == CL_SUCCESS && m_pGreeksKernel != nullptr) {
+        m_pHWGreeksBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                           (size_t)(GREEKS_OUTDEP * sizeof(KDataType)), &m_hwGreeksBufferOptions, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS && m_pGreeksKernel != nullptr) {
+        m_pGreeksSeedBuf = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                          2 * sizeof(unsigned int), &m_hwGreeksSeed, &cl_retval);
+
+        if (cl_retval == CL_SUCCESS) {
+            seedVector.push_back(*m_pGreeksSeedBuf);
+        }
+    }
+
+    if (cl_retval == CL_SUCCESS && m_pGridKernel != nullptr) {
+        // GRID_OUTDEP values each, but the seed
+        size_t gridBufferSizes[NUM_GRID_BUFFERS] = {GRID_OUTDEP * sizeof(KDataType), GRID_OUTDEP * sizeof(KDataType),
+                                                    GRID_OUTDEP * sizeof(unsigned int), 2 * sizeof(unsigned int),
+                                                    GRID_OUTDEP * sizeof(KDataType)};
+
+        m_pHWGridBuffers.assign(NUM_GRID_BUFFERS, nullptr);
+
+        for (i = 0; i < NUM_GRID_BUFFERS; i++) {
+            m_pHWGridBuffers[i] =
+                new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                               gridBufferSizes[i], &m_hwGridBufferOptions[i], &cl_retval);
+
+            if (cl_retval != CL_SUCCESS) {
+                break; // out of loop
+            }
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            seedVector.push_back(*m_pHWGridBuffers[3]);
+        }
+    }
+
+    // the seeds are the same for every run, so they are sent once here
+    if (cl_retval == CL_SUCCESS) {
+        cl_retval = m_pCommandQueue->enqueueMigrateMemObjects(seedVector, 0, nullptr, nullptr);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        cl_retval = m_pCommandQueue->finish();
     }
 
     if (cl_retval != CL_SUCCESS) {
@@ -233,32 +378,93 @@ int MCEuropean::releaseOCLObjects(void) {
     aligned_allocator<KDataType> allocator;
     aligned_allocator<unsigned int> allocator_seed;
 
-    for (i = 0; i < NUM_KERNELS; i++) {
+    for (i = 0; i < m_pHWBuffers.size(); i++) {
         if (m_pHWBuffers[i] != nullptr) {
             delete (m_pHWBuffers[i]);
-            m_pHWBuffers[i] = nullptr;
-        }
-
-        if (m_pSeedBuf != nullptr) {
-            delete (m_pSeedBuf);
-            m_pSeedBuf = nullptr;
         }
+    }
+    m_pHWBuffers.clear();
+    m_hwBufferOptions.clear();
 
+    for (i = 0; i < m_hostOutputBuffers.size(); i++) {
         if (m_hostOutputBuffers[i] != nullptr) {
             allocator.deallocate((KDataType*)(m_hostOutputBuffers[i]), OUTDEP);
-            m_hostOutputBuffers[i] = nullptr;
         }
+    }
+    m_hostOutputBuffers.clear();
 
-        if (m_hostSeed != nullptr) {
-            allocator_seed.deallocate((unsigned int*)(m_hostSeed), 2);
-            m_hostSeed = nullptr;
+    for (i = 0; i < m_pSeedBuf.size(); i++) {
+        if (m_pSeedBuf[i] != nullptr) {
+            delete (m_pSeedBuf[i]);
         }
+    }
+    m_pSeedBuf.clear();
+    m_hwSeed.clear();
 
+    for (i = 0; i < m_pKernels.size(); i++) {
         if (m_pKernels[i] != nullptr) {
             delete (m_pKernels[i]);
-            m_pKernels[i] = nullptr;
         }
     }
+    m_pKernels.clear();
+
+    if (m_pHWGreeksBuffer != nullptr) {
+        delete (m_pHWGreeksBuffer);
+        m_pHWGreeksBuffer = nullptr;
+    }
+
+    if (m_pGreeksSeedBuf != nullptr) {
+        delete (m_pGreeksSeedBuf);
+        m_pGreeksSeedBuf = nullptr;
+    }
+
+    if (m_hostGreeksBuffer != nullptr) {
+        allocator.deallocate((KDataType*)(m_hostGreeksBuffer), GREEKS_OUTDEP);
+        m_hostGreeksBuffer = nullptr;
+    }
+
+    if (m_pGreeksKernel != nullptr) {
+        delete (m_pGreeksKernel);
+        m_pGreeksKernel = nullptr;
+    }
+
+    for (i = 0; i < m_pHWGridBuffers.size(); i++) {
+        if (m_pHWGridBuffers[i] != nullptr) {
+            delete (m_pHWGridBuffers[i]);
+        }
+    }
+    m_pHWGridBuffers.clear();
+    m_hwGridBufferOptions.clear();
+
+    if (m_hostGridStrike != nullptr) {
+        allocator.deallocate((KDataType*)(m_hostGridStrike), GRID_OUTDEP);
+        m_hostGridStrike = nullptr;
+    }
+
+    if (m_hostGridMaturity != nullptr) {
+        allocator.deallocate((KDataType*)(m_hostGridMaturity), GRID_OUTDEP);
+        m_hostGridMaturity = nullptr;
+    }
+
+    if (m_hostGridType != nullptr) {
+        allocator_seed.deallocate(m_hostGridType, GRID_OUTDEP);
+        m_hostGridType = nullptr;
+    }
+
+    if (m_hostGridOutput != nullptr) {
+        allocator.deallocate((KDataType*)(m_hostGridOutput), GRID_OUTDEP);
+        m_hostGridOutput = nullptr;
+    }
+
+    if (m_pGridKernel != nullptr) {
+        delete (m_pGridKernel);
+        m_pGridKernel = nullptr;
+    }
+
+    if (m_hostSeed != nullptr) {
+        allocator_seed.deallocate((unsigned int*)(m_hostSeed), 2);
+        m_hostSeed = nullptr;
+    }
 
     if (m_pProgram != nullptr) {
         delete (m_pProgram);
@@ -340,6 +546,48 @@ int MCEuropean::run(OptionType optionType,
     return retval;
 }
 
+// SINGLE asset with GREEKS, run to TOLERANCE
+int MCEuropean::run(OptionType optionType,
+                    double stockPrice,
+                    double strikePrice,
+                    double riskFreeRate,
+                    double dividendYield,
+                    double volatility,
+                    double timeToMaturity,
+                    double requiredTolerance,
+                    double* pOptionPrice,
+                    double* pDelta,
+                    double* pGamma,
+                    double* pVega,
+                    double* pRho,
+                    double* pTheta) {
+    // since this method only exposes requiredTolerance, we must set
+    // requiredSamples = 0
+    return runGreeksInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                             timeToMaturity, requiredTolerance, 0, pOptionPrice, pDelta, pGamma, pVega, pRho, pTheta);
+}
+
+// SINGLE asset with GREEKS, run to REQUIRED NUM SAMPLES
+int MCEuropean::run(OptionType optionType,
+                    double stockPrice,
+                    double strikePrice,
+                    double riskFreeRate,
+                    double dividendYield,
+                    double volatility,
+                    double timeToMaturity,
+                    unsigned int requiredSamples,
+                    double* pOptionPrice,
+                    double* pDelta,
+                    double* pGamma,
+                    double* pVega,
+                    double* pRho,
+                    double* pTheta) {
+    // since this method only exposes requiredSamples, we must set
+    // requiredTolerance = 0.0
+    return runGreeksInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                             timeToMaturity, 0.0, requiredSamples, pOptionPrice, pDelta, pGamma, pVega, pRho, pTheta);
+}
+
 // MULTI asset, run to TOLERANCE
 int MCEuropean::run(OptionType* optionType,
                     double* stockPrice,
@@ -352,8 +600,6 @@ int MCEuropean::run(OptionType* optionType,
                     double* outputOptionPrice,
                     unsigned int numAssets) {
     int retval = XLNX_OK;
-    unsigned int requiredSamples[NUM_KERNELS] = {0};
-    unsigned int numKernelsToRun;
 
     // The kernels take in BOTH requiredTolerance AND requiredSamples.
     // However only ONE is used during processing...
@@ -361,20 +607,10 @@ int MCEuropean::run(OptionType* optionType,
     // If requiredSamples == 0, the model will run for as long as necessary to
     // meet requiredTolerance
 
-    // We will process the asset data in NUM_KERNELS sized chunks...
-    for (unsigned int i = 0; i < numAssets; i += NUM_KERNELS) {
-        numKernelsToRun = numAssets - i;
-
-        // need to limit each run to the number of kernels that are present...
-        if (numKernelsToRun > NUM_KERNELS) {
-            numKernelsToRun = NUM_KERNELS;
-        }
-
-        retval = runInternal(&optionType[i], &stockPrice[i], &strikePrice[i], &riskFreeRate[i], &dividendYield[i],
-                             &volatility[i], &timeToMaturity[i], &requiredTolerance[i],
-                             requiredSamples, // <-- remember this is a LOCAL variable
-                             &outputOptionPrice[i], numKernelsToRun);
-    }
+    // since this method only exposes requiredTolerance, requiredSamples is null,
+    // i.e. 0 for every asset
+    retval = runInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                         requiredTolerance, nullptr, outputOptionPrice, numAssets);
 
     return retval;
 }
@@ -391,8 +627,6 @@ int MCEuropean::run(OptionType* optionType,
                     double* outputOptionPrice,
                     unsigned int numAssets) {
     int retval = XLNX_OK;
-    double requiredTolerance[NUM_KERNELS] = {0.0};
-    unsigned int numKernelsToRun;
 
     // The kernels take in BOTH requiredTolerance AND requiredSamples.
     // However only ONE is used during processing...
@@ -400,20 +634,10 @@ int MCEuropean::run(OptionType* optionType,
     // If requiredSamples == 0, the model will run for as long as necessary to
     // meet requiredTolerance
 
-    // We will process the asset data in NUM_KERNELS sized chunks...
-    for (unsigned int i = 0; i < numAssets; i += NUM_KERNELS) {
-        numKernelsToRun = numAssets - i;
-
-        // need to limit each run to the number of kernels that are present...
-        if (numKernelsToRun > NUM_KERNELS) {
-            numKernelsToRun = NUM_KERNELS;
-        }
-
-        retval = runInternal(&optionType[i], &stockPrice[i], &strikePrice[i], &riskFreeRate[i], &dividendYield[i],
-                             &volatility[i], &timeToMaturity[i],
-                             requiredTolerance, // <-- remember this is a LOCAL variable
-                             &requiredSamples[i], &outputOptionPrice[i], numKernelsToRun);
-    }
+    // since this method only exposes requiredSamples, requiredTolerance is null,
+    // i.e. 0.0 for every asset
+    retval = runInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                         nullptr, requiredSamples, outputOptionPrice, numAssets);
 
     return retval;
 }
@@ -428,62 +652,123 @@ int MCEuropean::runInternal(OptionType optionType,
                             double requiredTolerance,
                             unsigned int requiredSamples,
                             double* pOptionPrice) {
+    // All kernels are seeded the same, so a single asset runs on one kernel only.
+    return runInternal(&optionType, &stockPrice, &strikePrice, &riskFreeRate, &dividendYield, &volatility,
+                       &timeToMaturity, &requiredTolerance, &requiredSamples, pOptionPrice, 1);
+}
+
+int MCEuropean::runInternal(OptionType* optionType,
+                            double* stockPrice,
+                            double* strikePrice,
+                            double* riskFreeRate,
+                            double* dividendYield,
+                            double* volatility,
+                            double* timeToMaturity,
+                            double* requiredTolerance,
+                            unsigned int* requiredSamples,
+                            double* outputOptionPrice,
+                            unsigned int numAssets) {
     int retval = XLNX_OK;
+    cl_int cl_retval = CL_SUCCESS;
+    unsigned int timeSteps = 1;
+    unsigned int loop_nm = 1;
     KDataType totalOutput = 0.0;
-    unsigned int i;
+    unsigned int i, j;
 
-    OptionType multipleOptionType[NUM_KERNELS];
-    double multipleStockPrice[NUM_KERNELS];
-    double multipleStrikePrice[NUM_KERNELS];
-    double multipleRiskFreeRate[NUM_KERNELS];
-    double multipleDividendYield[NUM_KERNELS];
-    double multipleVolatility[NUM_KERNELS];
-    double multipleTimeToMaturity[NUM_KERNELS];
-    double multipleRequiredTolerance[NUM_KERNELS];
-    unsigned int multipleRequiredSamples[NUM_KERNELS];
-    double multipleOptionPrice[NUM_KERNELS];
+    // Each (kernel, buffer) pair is a slot, asset i uses slot i % numSlots.
+    // Slots are spread over the kernels first, so consecutive assets go to
+    // different kernels, and every kernel has its next asset queued while it
+    // computes the current one.
+    unsigned int numKernels = m_pKernels.size();
+    unsigned int numSlots = numKernels * NUM_BUFFERS_PER_KERNEL;
+    std::vector<cl::Event> kernelEvents(numSlots);
+    std::vector<cl::Event> readEvents(numSlots);
+
+    // a smile, or any assets differing only in strike and type, shares one set of paths
+    if (runGridInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                        requiredTolerance, requiredSamples, outputOptionPrice, numAssets, &retval)) {
+        return retval;
+    }
 
     m_runStartTime = std::chrono::high_resolution_clock::now();
 
     if (deviceIsPrepared()) {
-        // Here we are setting up the arrays that represent the data we will pass to
-        // the kernels.
-        // The i'th element of each array will be passed to the i'th kernel.
-        //
-        // Since we are running with a SINGLE ASSET DATA here, we pass the SAME DATA
-        // TO ALL KERNELS,
-        // then at the end, we sum the output and take an average.
-
-        for (i = 0; i < NUM_KERNELS; i++) {
-            multipleOptionType[i] = optionType;
-            multipleStockPrice[i] = (KDataType)stockPrice;
-            multipleStrikePrice[i] = (KDataType)strikePrice;
-            multipleRiskFreeRate[i] = (KDataType)riskFreeRate;
-            multipleDividendYield[i] = (KDataType)dividendYield;
-            multipleVolatility[i] = (KDataType)volatility;
-            multipleTimeToMaturity[i] = (KDataType)timeToMaturity;
-            multipleRequiredTolerance[i] = (KDataType)requiredTolerance;
-            multipleRequiredSamples[i] = requiredSamples;
-        }
-
-        retval = runInternal(multipleOptionType, multipleStockPrice, multipleStrikePrice, multipleRiskFreeRate,
-                             multipleDividendYield, multipleVolatility, multipleTimeToMaturity,
-                             multipleRequiredTolerance, multipleRequiredSamples, multipleOptionPrice, NUM_KERNELS);
-
-        // ---------------
-        // Post-Processing
-        // ---------------
-
-        if (retval == XLNX_OK) {
-            totalOutput = 0.0;
-
-            // sum the option price output from each kernel...
-            for (i = 0; i < NUM_KERNELS; i++) {
-                totalOutput += multipleOptionPrice[i];
+        // numSlots more passes than assets, the last ones only collect results
+        for (i = 0; i < numAssets + numSlots && cl_retval == CL_SUCCESS; i++) {
+            unsigned int slot = i % numSlots;
+            unsigned int kernel = slot % numKernels;
+
+            // ---------------
+            // Post-Processing
+            // ---------------
+
+            // the asset that used this slot before has to be read back first
+            if (i >= numSlots) {
+                unsigned int asset = i - numSlots;
+
+                if (asset >= numAssets) {
+                    continue;
+                }
+
+                cl_retval = readEvents[slot].wait();
+                if (cl_retval != CL_SUCCESS) {
+                    break; // out of loop
+                }
+
+                KDataType* pBuffer = (KDataType*)(m_hostOutputBuffers[slot]);
+
+                totalOutput = (KDataType)0.0;
+
+                // sum the outputs...
+                for (j = 0; j < loop_nm; j++) {
+                    totalOutput += pBuffer[j];
+                }
+
+                outputOptionPrice[asset] = (double)(totalOutput / (KDataType)loop_nm);
             }
 
-            //...and take the average....
-            *pOptionPrice = (double)(totalOutput / (KDataType)NUM_KERNELS);
+            if (i >= numAssets) {
+                continue;
+            }
+
+            // ---------------------------------
+            // Queue the asset and its read back
+            // ---------------------------------
+            cl::Kernel* pKernel = m_pKernels[kernel];
+
+            pKernel->setArg(0, (KDataType)stockPrice[i]);
+            pKernel->setArg(1, (KDataType)volatility[i]);
+            pKernel->setArg(2, (KDataType)dividendYield[i]);
+            pKernel->setArg(3, (KDataType)riskFreeRate[i]);
+            pKernel->setArg(4, (KDataType)timeToMaturity[i]);
+            pKernel->setArg(5, (KDataType)strikePrice[i]);
+            pKernel->setArg(6, (unsigned int)optionType[i]);
+            pKernel->setArg(SEED_ARG_INDEX, *m_pSeedBuf[kernel]);
+            pKernel->setArg(OUTPUT_ARG_INDEX, *m_pHWBuffers[slot]);
+            pKernel->setArg(9, (KDataType)(requiredTolerance != nullptr ? requiredTolerance[i] : 0.0));
+            pKernel->setArg(10, requiredSamples != nullptr ? requiredSamples[i] : 0u);
+            pKernel->setArg(11, timeSteps);
+
+            cl_retval = m_pCommandQueue->enqueueTask(*pKernel, nullptr, &kernelEvents[slot]);
+
+            if (cl_retval == CL_SUCCESS) {
+                std::vector<cl::Memory> outVector = {*(m_pHWBuffers[slot])};
+                std::vector<cl::Event> waitEvents = {kernelEvents[slot]};
+
+                cl_retval = m_pCommandQueue->enqueueMigrateMemObjects(outVector, CL_MIGRATE_MEM_OBJECT_HOST,
+                                                                      &waitEvents, &readEvents[slot]);
+            }
+
+            if (cl_retval == CL_SUCCESS) {
+                cl_retval = m_pCommandQueue->flush();
+            }
+        }
+
+        if (cl_retval != CL_SUCCESS) {
+            m_pCommandQueue->finish();
+            setCLError(cl_retval);
+            Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
+            retval = XLNX_ERROR_OPENCL_CALL_ERROR;
         }
 
     } else {
@@ -495,76 +780,180 @@ int MCEuropean::runInternal(OptionType optionType,
     return retval;
 }
 
-int MCEuropean::runInternal(OptionType* optionType,
-                            double* stockPrice,
-                            double* strikePrice,
-                            double* riskFreeRate,
-                            double* dividendYield,
-                            double* volatility,
-                            double* timeToMaturity,
-                            double* requiredTolerance,
-                            unsigned int* requiredSamples,
-                            double* outputOptionPrice,
-                            unsigned int numAssets) {
-    int retval = XLNX_OK;
+bool MCEuropean::runGridInternal(OptionType* optionType,
+                                 double* stockPrice,
+                                 double* strikePrice,
+                                 double* riskFreeRate,
+                                 double* dividendYield,
+                                 double* volatility,
+                                 double* timeToMaturity,
+                                 double* requiredTolerance,
+                                 unsigned int* requiredSamples,
+                                 double* outputOptionPrice,
+                                 unsigned int numAssets,
+                                 int* pRetval) {
+    cl_int cl_retval = CL_SUCCESS;
     unsigned int timeSteps = 1;
-    unsigned int loop_nm = 1;
-    KDataType totalOutput = 0.0;
-    unsigned int i, j;
-    std::vector<cl::Memory> outVector;
+    unsigned int first, i;
+
+    if (!deviceIsPrepared() || m_pGridKernel == nullptr || numAssets < 2) {
+        return false;
+    }
+
+    // the grid kernel simulates a single underlying, and stops on a single
+    // tolerance or number of samples for all its options
+    for (i = 1; i < numAssets; i++) {
+        if (stockPrice[i] != stockPrice[0] || riskFreeRate[i] != riskFreeRate[0] ||
+            dividendYield[i] != dividendYield[0] || volatility[i] != volatility[0] ||
+            timeToMaturity[i] != timeToMaturity[0] ||
+            (requiredTolerance != nullptr && requiredTolerance[i] != requiredTolerance[0]) ||
+            (requiredSamples != nullptr && requiredSamples[i] != requiredSamples[0])) {
+            return false;
+        }
+    }
 
     m_runStartTime = std::chrono::high_resolution_clock::now();
 
-    if (deviceIsPrepared()) {
-        for (i = 0; i < numAssets; i++) {
-            m_pKernels[i]->setArg(0, (KDataType)stockPrice[i]);
-            m_pKernels[i]->setArg(1, (KDataType)volatility[i]);
-            m_pKernels[i]->setArg(2, (KDataType)dividendYield[i]);
-            m_pKernels[i]->setArg(3, (KDataType)riskFreeRate[i]);
-            m_pKernels[i]->setArg(4, (KDataType)timeToMaturity[i]);
-            m_pKernels[i]->setArg(5, (KDataType)strikePrice[i]);
-            m_pKernels[i]->setArg(6, (unsigned int)optionType[i]);
-            m_pKernels[i]->setArg(7, *m_pSeedBuf);
-            m_pKernels[i]->setArg(8, *m_pHWBuffers[i]);
-            m_pKernels[i]->setArg(9, (KDataType)requiredTolerance[i]);
-            m_pKernels[i]->setArg(10, requiredSamples[i]);
-            m_pKernels[i]->setArg(11, timeSteps);
-
-            m_pCommandQueue->enqueueTask(*(m_pKernels[i]), nullptr, nullptr);
-        }
-
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
+    KDataType* pStrike = (KDataType*)m_hostGridStrike;
+    KDataType* pMaturity = (KDataType*)m_hostGridMaturity;
+    KDataType* pOutput = (KDataType*)m_hostGridOutput;
+    std::vector<cl::Memory> inVector = {*m_pHWGridBuffers[0], *m_pHWGridBuffers[1], *m_pHWGridBuffers[2]};
+    std::vector<cl::Memory> outVector = {*m_pHWGridBuffers[4]};
+
+    // GRID_OUTDEP assets at a time, each batch on its own set of paths
+    for (first = 0; first < numAssets && cl_retval == CL_SUCCESS; first += GRID_OUTDEP) {
+        unsigned int payoffNum = std::min(numAssets - first, (unsigned int)GRID_OUTDEP);
+        cl::Event writeEvent;
+        cl::Event kernelEvent;
+        cl::Event readEvent;
+
+        for (i = 0; i < payoffNum; i++) {
+            pStrike[i] = (KDataType)strikePrice[first + i];
+            pMaturity[i] = (KDataType)timeToMaturity[0];
+            m_hostGridType[i] = (unsigned int)optionType[first + i];
+        }
+
+        m_pGridKernel->setArg(0, (KDataType)stockPrice[0]);
+        m_pGridKernel->setArg(1, (KDataType)volatility[0]);
+        m_pGridKernel->setArg(2, (KDataType)dividendYield[0]);
+        m_pGridKernel->setArg(3, (KDataType)riskFreeRate[0]);
+        m_pGridKernel->setArg(4, (KDataType)timeToMaturity[0]);
+        for (i = 0; i < NUM_GRID_BUFFERS; i++) {
+            m_pGridKernel->setArg(GRID_ARG_INDEX[i], *m_pHWGridBuffers[i]);
+        }
+        m_pGridKernel->setArg(8, payoffNum);
+        m_pGridKernel->setArg(11, (KDataType)(requiredTolerance != nullptr ? requiredTolerance[0] : 0.0));
+        m_pGridKernel->setArg(12, requiredSamples != nullptr ? requiredSamples[0] : 0u);
+        m_pGridKernel->setArg(13, timeSteps);
+
+        cl_retval = m_pCommandQueue->enqueueMigrateMemObjects(inVector, 0, nullptr, &writeEvent);
 
-        for (i = 0; i < numAssets; i++) {
-            outVector.push_back(*(m_pHWBuffers[i]));
+        if (cl_retval == CL_SUCCESS) {
+            std::vector<cl::Event> waitEvents = {writeEvent};
+            cl_retval = m_pCommandQueue->enqueueTask(*m_pGridKernel, &waitEvents, &kernelEvent);
         }
 
-        m_pCommandQueue->enqueueMigrateMemObjects(outVector, CL_MIGRATE_MEM_OBJECT_HOST, nullptr /*&kernel_events[i]*/,
-                                                  nullptr);
+        if (cl_retval == CL_SUCCESS) {
+            std::vector<cl::Event> waitEvents = {kernelEvent};
+            cl_retval = m_pCommandQueue->enqueueMigrateMemObjects(outVector, CL_MIGRATE_MEM_OBJECT_HOST, &waitEvents,
+                                                                  &readEvent);
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            cl_retval = readEvent.wait();
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            for (i = 0; i < payoffNum; i++) {
+                outputOptionPrice[first + i] = (double)pOutput[i];
+            }
+        }
+    }
 
-        m_pCommandQueue->flush();
+    *pRetval = XLNX_OK;
+    if (cl_retval != CL_SUCCESS) {
         m_pCommandQueue->finish();
+        setCLError(cl_retval);
+        Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
+        *pRetval = XLNX_ERROR_OPENCL_CALL_ERROR;
+    }
 
-        // ---------------
-        // Post-Processing
-        // ---------------
+    m_runEndTime = std::chrono::high_resolution_clock::now();
 
-        for (i = 0; i < numAssets; i++) {
-            KDataType* pBuffer = (KDataType*)(m_hostOutputBuffers[i]);
+    return true;
+}
 
-            totalOutput = (KDataType)0.0;
+int MCEuropean::runGreeksInternal(OptionType optionType,
+                                  double stockPrice,
+                                  double strikePrice,
+                                  double riskFreeRate,
+                                  double dividendYield,
+                                  double volatility,
+                                  double timeToMaturity,
+                                  double requiredTolerance,
+                                  unsigned int requiredSamples,
+                                  double* pOptionPrice,
+                                  double* pDelta,
+                                  double* pGamma,
+                                  double* pVega,
+                                  double* pRho,
+                                  double* pTheta) {
+    int retval = XLNX_OK;
+    cl_int cl_retval = CL_SUCCESS;
+    unsigned int timeSteps = 1;
+    cl::Event readEvent;
 
-            // sum the outputs...
-            for (j = 0; j < loop_nm; j++) {
-                totalOutput += pBuffer[j];
-            }
+    m_runStartTime = std::chrono::high_resolution_clock::now();
 
-            outputOptionPrice[i] = (double)(totalOutput / (KDataType)loop_nm);
+    if (!deviceIsPrepared()) {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    } else if (m_pGreeksKernel == nullptr) {
+        Trace::printError("[XLNX] %s kernel not found in the XCLBIN\n", GREEKS_KERNEL_NAME);
+        retval = XLNX_ERROR_NOT_SUPPORTED;
+    } else {
+        m_pGreeksKernel->setArg(0, (KDataType)stockPrice);
+        m_pGreeksKernel->setArg(1, (KDataType)volatility);
+        m_pGreeksKernel->setArg(2, (KDataType)dividendYield);
+        m_pGreeksKernel->setArg(3, (KDataType)riskFreeRate);
+        m_pGreeksKernel->setArg(4, (KDataType)timeToMaturity);
+        m_pGreeksKernel->setArg(5, (KDataType)strikePrice);
+        m_pGreeksKernel->setArg(6, (unsigned int)optionType);
+        m_pGreeksKernel->setArg(SEED_ARG_INDEX, *m_pGreeksSeedBuf);
+        m_pGreeksKernel->setArg(OUTPUT_ARG_INDEX, *m_pHWGreeksBuffer);
+        m_pGreeksKernel->setArg(9, (KDataType)requiredTolerance);
+        m_pGreeksKernel->setArg(10, requiredSamples);
+        m_pGreeksKernel->setArg(11, timeSteps);
+
+        cl::Event kernelEvent;
+        cl_retval = m_pCommandQueue->enqueueTask(*m_pGreeksKernel, nullptr, &kernelEvent);
+
+        if (cl_retval == CL_SUCCESS) {
+            std::vector<cl::Memory> outVector = {*m_pHWGreeksBuffer};
+            std::vector<cl::Event> waitEvents = {kernelEvent};
+
+            cl_retval = m_pCommandQueue->enqueueMigrateMemObjects(outVector, CL_MIGRATE_MEM_OBJECT_HOST, &waitEvents,
+                                                                  &readEvent);
         }
 
-    } else {
-        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+        if (cl_retval == CL_SUCCESS) {
+            cl_retval = readEvent.wait();
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            KDataType* pBuffer = (KDataType*)m_hostGreeksBuffer;
+
+            *pOptionPrice = (double)pBuffer[0];
+            *pTheta = (double)pBuffer[1];
+            *pRho = (double)pBuffer[2];
+            *pDelta = (double)pBuffer[3];
+            *pGamma = (double)pBuffer[4];
+            *pVega = (double)pBuffer[5];
+        } else {
+            m_pCommandQueue->finish();
+            setCLError(cl_retval);
+            Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
+            retval = XLNX_ERROR_OPENCL_CALL_ERROR;
+        }
     }
 
     m_runEndTime = std::chrono::high_resolution_clock::now();
@@ -580,3 +969,7 @@ long long int MCEuropean::getLastRunTime(void) {
 
     return duration;
 }
+
+int MCEuropean::getNumKernels(void) {
+    return (int)m_pKernels.size();
+}
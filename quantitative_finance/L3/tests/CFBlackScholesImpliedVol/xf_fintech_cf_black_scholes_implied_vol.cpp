@@ -0,0 +1,116 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+static const unsigned int numOptions = 1048576;
+static const unsigned int numPrintedOptions = 16;
+
+CFBlackScholesImpliedVol cfBlackScholesImpliedVol(numOptions);
+
+// Reference Black Scholes Merton put premium used to generate the test prices
+static float putPrice(float s, float k, float v, float r, float q, float t) {
+    double sd = v * sqrt(t);
+    double d1 = (log(s / k) + (r - q) * t) / sd + 0.5 * sd;
+    double d2 = d1 - sd;
+    return (float)(k * exp(-r * t) * 0.5 * erfc(d2 / sqrt(2.0)) - s * exp(-q * t) * 0.5 * erfc(d1 / sqrt(2.0)));
+}
+
+int main() {
+    int retval = XLNX_OK;
+
+    std::vector<Device*> deviceList;
+    Device* pChosenDevice;
+    std::vector<float> volatility(numOptions);
+
+    // Get a list of U250s available on the system (just because our current
+    // bitstreams are built for U250s)
+    deviceList = DeviceManager::getDeviceList("u250");
+
+    if (deviceList.size() == 0) {
+        printf("[XLNX] No matching devices found\n");
+        exit(0);
+    }
+
+    printf("[XLNX] Found %zu matching devices\n", deviceList.size());
+
+    // we'll just pick the first device in the...
+    pChosenDevice = deviceList[0];
+
+    retval = cfBlackScholesImpliedVol.claimDevice(pChosenDevice);
+
+    if (retval == XLNX_OK) {
+        // Populate an options chain with a volatility smile across the strikes
+        for (unsigned int i = 0; i < numOptions; i++) {
+            float strike = 60.0f + 80.0f * (i % 256) / 256.0f;
+            float moneyness = logf(strike / 100.0f);
+
+            volatility[i] = 0.2f + 0.5f * moneyness * moneyness;
+
+            cfBlackScholesImpliedVol.stockPrice[i] = 100.0f;
+            cfBlackScholesImpliedVol.strikePrice[i] = strike;
+            cfBlackScholesImpliedVol.riskFreeRate[i] = 0.025f;
+            cfBlackScholesImpliedVol.dividendYield[i] = 0.01f;
+            cfBlackScholesImpliedVol.timeToMaturity[i] = 0.25f + (i / 256) % 8 * 0.25f;
+            cfBlackScholesImpliedVol.optionPrice[i] = putPrice(100.0f, strike, volatility[i], 0.025f, 0.01f,
+                                                               cfBlackScholesImpliedVol.timeToMaturity[i]);
+        }
+
+        ///////////////////
+        // Run the model...
+        ///////////////////
+        retval = cfBlackScholesImpliedVol.run(OptionType::Put, numOptions);
+    }
+
+    if (retval == XLNX_OK) {
+        float maxError = 0.0f;
+
+        for (unsigned int i = 0; i < numOptions; i++) {
+            float error = fabsf(cfBlackScholesImpliedVol.impliedVolatility[i] - volatility[i]);
+            if (error > maxError) {
+                maxError = error;
+            }
+        }
+
+        printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+        printf("[XLNX] | Index |  Strike  |  Price   |  Vol     | Impl Vol |\n");
+        printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+
+        for (unsigned int i = 0; i < numPrintedOptions; i++) {
+            unsigned int j = i * 16;
+            printf("[XLNX] | %5u | %8.4f | %8.5f | %8.5f | %8.5f |\n", j, cfBlackScholesImpliedVol.strikePrice[j],
+                   cfBlackScholesImpliedVol.optionPrice[j], volatility[j],
+                   cfBlackScholesImpliedVol.impliedVolatility[j]);
+        }
+
+        printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+        printf("[XLNX] Worst case implied volatility error is %f\n", maxError);
+        printf("[XLNX] Processed %u options in %lld us\n", numOptions, cfBlackScholesImpliedVol.getLastRunTime());
+    }
+
+    cfBlackScholesImpliedVol.releaseDevice();
+
+    return 0;
+}
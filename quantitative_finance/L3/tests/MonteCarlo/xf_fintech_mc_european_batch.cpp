@@ -0,0 +1,148 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <math.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "xf_fintech_mc_example.hpp"
+
+// The array run() spreads the assets over every kernel of the XCLBIN, with
+// NUM_BUFFERS_PER_KERNEL assets in flight on each of them.
+//
+// In this example, we pass more assets than there are (kernel, buffer) slots,
+// so every slot is used more than once, and check that each asset comes back
+// with the same price as when it is run on its own. All kernels are seeded the
+// same, so for a given number of samples the prices have to match.
+
+static OptionType baseOptionType = Put;
+
+static const double baseStockPrice = 36.0;
+static const double baseStrikePrice = 40.0;
+static const double baseRiskFreeRate = 0.06;
+static const double baseDividendYield = 0.0;
+static const double baseVolatility = 0.20;
+static const double baseTimeToMaturity = 1.0; /* in years */
+
+static const unsigned int baseRequiredNumSamples = 16383;
+
+/* The following variable is used to give each asset different data....*/
+static const double varianceFactor = 0.01;
+
+/* Largest difference allowed between the batch and the single asset price...*/
+static const double maxPriceDifference = 1.0e-9;
+
+int MCDemoRunEuropeanBatch(Device* pChosenDevice, MCEuropean* pMCEuropean) {
+    int retval = XLNX_OK;
+    unsigned int i;
+    unsigned int numAssets;
+    unsigned int numMismatches = 0;
+
+    printf("\n\n\n");
+
+    printf(
+        "[XLNX] "
+        "***************************************************************\n");
+    printf("[XLNX] Running MC EUROPEAN BATCH...\n");
+    printf(
+        "[XLNX] "
+        "***************************************************************\n");
+
+    printf("[XLNX] mcEuropean trying to claim device...\n");
+
+    retval = pMCEuropean->claimDevice(pChosenDevice);
+
+    if (retval != XLNX_OK) {
+        printf("[XLNX] ERROR- Failed to claim device - error = %d\n", retval);
+        return retval;
+    }
+
+    // every slot is used twice, and the first one three times
+    numAssets = 2 * pMCEuropean->getNumKernels() * MCEuropean::NUM_BUFFERS_PER_KERNEL + 1;
+
+    std::vector<OptionType> optionType(numAssets);
+    std::vector<double> stockPrice(numAssets);
+    std::vector<double> strikePrice(numAssets);
+    std::vector<double> riskFreeRate(numAssets);
+    std::vector<double> dividendYield(numAssets);
+    std::vector<double> volatility(numAssets);
+    std::vector<double> timeToMaturity(numAssets);
+    std::vector<unsigned int> requiredNumSamples(numAssets);
+    std::vector<double> batchOptionPrice(numAssets);
+
+    for (i = 0; i < numAssets; i++) {
+        double variance = (1.0 + (varianceFactor * i));
+
+        optionType[i] = (i % 2) ? Call : baseOptionType;
+        stockPrice[i] = baseStockPrice * variance;
+        strikePrice[i] = baseStrikePrice;
+        riskFreeRate[i] = baseRiskFreeRate;
+        dividendYield[i] = baseDividendYield;
+        volatility[i] = baseVolatility * variance;
+        timeToMaturity[i] = baseTimeToMaturity;
+        requiredNumSamples[i] = baseRequiredNumSamples;
+    }
+
+    printf("[XLNX] %u assets over %d kernels\n", numAssets, pMCEuropean->getNumKernels());
+
+    retval = pMCEuropean->run(optionType.data(), stockPrice.data(), strikePrice.data(), riskFreeRate.data(),
+                              dividendYield.data(), volatility.data(), timeToMaturity.data(),
+                              requiredNumSamples.data(), batchOptionPrice.data(), numAssets);
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] +-------+--------------+--------------+\n");
+        printf("[XLNX] | Asset |  Batch Price | Single Price |\n");
+        printf("[XLNX] +-------+--------------+--------------+\n");
+
+        for (i = 0; i < numAssets && retval == XLNX_OK; i++) {
+            double singleOptionPrice;
+
+            retval = pMCEuropean->run(optionType[i], stockPrice[i], strikePrice[i], riskFreeRate[i], dividendYield[i],
+                                      volatility[i], timeToMaturity[i], requiredNumSamples[i], &singleOptionPrice);
+
+            if (retval == XLNX_OK) {
+                bool mismatch = fabs(batchOptionPrice[i] - singleOptionPrice) > maxPriceDifference;
+
+                printf("[XLNX] | %5u | %12.6f | %12.6f |%s\n", i, batchOptionPrice[i], singleOptionPrice,
+                       mismatch ? " MISMATCH" : "");
+                if (mismatch) {
+                    numMismatches++;
+                }
+            }
+        }
+
+        printf("[XLNX] +-------+--------------+--------------+\n");
+    }
+
+    if (retval == XLNX_OK && numMismatches > 0) {
+        printf("[XLNX] ERROR - %u of %u batch prices differ from the single asset prices\n", numMismatches,
+               numAssets);
+        retval = XLNX_ERROR_MODEL_INTERNAL_ERROR;
+    }
+
+    //
+    // Release the device so another object can claim it...
+    //
+    // ...keeping the first error
+    printf("[XLNX] mcEuropean releasing device...\n");
+    int releaseRetval = pMCEuropean->releaseDevice();
+
+    if (retval == XLNX_OK) {
+        retval = releaseRetval;
+    }
+
+    return retval;
+}
@@ -54,30 +54,33 @@ static const double baseRequiredNumSamples = 16383;
 /* The following variable is used to vary our input data for each run....*/
 static const double varianceFactor = 0.001;
 
-static double initialStockPrice[MCEuropean::NUM_KERNELS];
-static double initialStrikePrice[MCEuropean::NUM_KERNELS];
-static double initialRiskFreeRate[MCEuropean::NUM_KERNELS];
-static double initialDividendYield[MCEuropean::NUM_KERNELS];
-static double initialVolatility[MCEuropean::NUM_KERNELS];
-
-static OptionType optionType[MCEuropean::NUM_KERNELS];
-static double stockPrice[MCEuropean::NUM_KERNELS];
-static double strikePrice[MCEuropean::NUM_KERNELS];
-static double riskFreeRate[MCEuropean::NUM_KERNELS];
-static double dividendYield[MCEuropean::NUM_KERNELS];
-static double volatility[MCEuropean::NUM_KERNELS];
-static double timeToMaturity[MCEuropean::NUM_KERNELS];
-static double requiredTolerance[MCEuropean::NUM_KERNELS];
-static double requiredNumSamples[MCEuropean::NUM_KERNELS];
-
-static double optionPrice[MCEuropean::NUM_KERNELS];
+/* One asset for each of the 4 kernels...*/
+static const int NUM_ASSETS = 4;
+
+static double initialStockPrice[NUM_ASSETS];
+static double initialStrikePrice[NUM_ASSETS];
+static double initialRiskFreeRate[NUM_ASSETS];
+static double initialDividendYield[NUM_ASSETS];
+static double initialVolatility[NUM_ASSETS];
+
+static OptionType optionType[NUM_ASSETS];
+static double stockPrice[NUM_ASSETS];
+static double strikePrice[NUM_ASSETS];
+static double riskFreeRate[NUM_ASSETS];
+static double dividendYield[NUM_ASSETS];
+static double volatility[NUM_ASSETS];
+static double timeToMaturity[NUM_ASSETS];
+static double requiredTolerance[NUM_ASSETS];
+static double requiredNumSamples[NUM_ASSETS];
+
+static double optionPrice[NUM_ASSETS];
 
 static const unsigned int NUM_ITERATIONS = 250;
 
 static void SetupParameters(void) {
     int i;
 
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         optionType[i] = baseOptionType;
         initialStockPrice[i] = baseStockPrice + (i * 2);
         initialStrikePrice[i] = baseStrikePrice + (i * 2);
@@ -111,49 +114,49 @@ static void PrintParameters(void) {
         "\n");
 
     printf("[XLNX] | Option Type      |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-5s     |", Trace::optionTypeToString(optionType[i]));
     }
     printf("\n");
 
     printf("[XLNX] | Stock Price      |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-8.4f  |", initialStockPrice[i]);
     }
     printf("\n");
 
     printf("[XLNX] | Strike Price     |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-8.4f  |", initialStrikePrice[i]);
     }
     printf("\n");
 
     printf("[XLNX] | Risk Free Rate   |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-8.4f  |", initialRiskFreeRate[i]);
     }
     printf("\n");
 
     printf("[XLNX] | Dividend Yield   |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-8.4f  |", initialDividendYield[i]);
     }
     printf("\n");
 
     printf("[XLNX] | Volatility       |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-8.4f  |", initialVolatility[i]);
     }
     printf("\n");
 
     printf("[XLNX] | Time To Maturity |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-8.4f  |", timeToMaturity[i]);
     }
     printf("\n");
 
     printf("[XLNX] | Req. Tolerance   |");
-    for (i = 0; i < MCEuropean::NUM_KERNELS; i++) {
+    for (i = 0; i < NUM_ASSETS; i++) {
         printf("  %-8.4f  |", requiredTolerance[i]);
     }
     printf("\n");
@@ -226,7 +229,7 @@ int MCDemoRunEuropeanMultiple1(Device* pChosenDevice, MCEuropean* pMCEuropean) {
              * values... */
             double variance = (1.0 + (varianceFactor * i));
 
-            for (j = 0; j < MCEuropean::NUM_KERNELS; j++) {
+            for (j = 0; j < NUM_ASSETS; j++) {
                 stockPrice[j] = initialStockPrice[j] * variance;
                 strikePrice[j] = initialStrikePrice[j] * variance;
                 riskFreeRate[j] = initialRiskFreeRate[j] * variance;
@@ -238,10 +241,10 @@ int MCDemoRunEuropeanMultiple1(Device* pChosenDevice, MCEuropean* pMCEuropean) {
             }
 
             retval = pMCEuropean->run(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
-                                      timeToMaturity, requiredTolerance, optionPrice, MCEuropean::NUM_KERNELS);
+                                      timeToMaturity, requiredTolerance, optionPrice, NUM_ASSETS);
 
             duration = pMCEuropean->getLastRunTime();
-            durationPerAsset = (double)duration / (double)MCEuropean::NUM_KERNELS;
+            durationPerAsset = (double)duration / (double)NUM_ASSETS;
 
             printf("[XLNX] | %9d | %9.4f  | %11lld us | %16.3f us |\n", i, optionPrice[0], duration, durationPerAsset);
         }
@@ -71,6 +71,10 @@ int main() {
         retval = MCDemoRunEuropeanMultiple2(pChosenDevice, &mcEuropean);
     }
 
+    if (retval == XLNX_OK) {
+        retval = MCDemoRunEuropeanBatch(pChosenDevice, &mcEuropean);
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////////
     // Now switch to MC American...
     //////////////////////////////////////////////////////////////////////////////////////////
@@ -79,5 +83,9 @@ int main() {
         retval = MCDemoRunAmericanSingle(pChosenDevice, &mcAmerican);
     }
 
-    return 0;
+    if (retval == XLNX_OK) {
+        retval = MCDemoRunAmericanBatch(pChosenDevice, &mcAmerican);
+    }
+
+    return (retval == XLNX_OK) ? 0 : 1;
 }
@@ -27,6 +27,10 @@ int MCDemoRunEuropeanMultiple1(Device* pChosenDevice, MCEuropean* pMCEuropean);
 
 int MCDemoRunEuropeanMultiple2(Device* pChosenDevice, MCEuropean* pMCEuropean);
 
+int MCDemoRunEuropeanBatch(Device* pChosenDevice, MCEuropean* pMCEuropean);
+
 int MCDemoRunAmericanSingle(Device* pChosenDevice, MCAmerican* pMCAmerican);
 
+int MCDemoRunAmericanBatch(Device* pChosenDevice, MCAmerican* pMCAmerican);
+
 #endif /* _XF_FINTECH_MC_EXAMPLE_H_ */